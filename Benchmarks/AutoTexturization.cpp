@@ -6,6 +6,7 @@
 
 #include <GameCore/ImageData.h>
 #include <GameCore/GameTypes.h>
+#include <GameCore/ThreadManager.h>
 
 #include <benchmark/benchmark.h>
 
@@ -141,3 +142,101 @@ static void AutoTexturization_RenderShipInto(benchmark::State & state)
     }
 }
 BENCHMARK(AutoTexturization_RenderShipInto);
+
+static StructuralLayerData MakeParallelBenchmarkStructuralLayer(MaterialDatabase const & materialDatabase)
+{
+    // Like a ship: materials in runs, and a hull within empty space
+    StructuralLayerData structuralLayer(StructureSize);
+    auto const & materialCategories = materialDatabase.GetStructuralMaterialPalette().Categories;
+    for (int y = 0; y < structuralLayer.Buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < structuralLayer.Buffer.Size.width; ++x)
+        {
+            bool const isHull = (y < StructureSize.height * 3 / 4) && (x > y / 4) && (x < StructureSize.width - y / 4);
+
+            size_t const category = static_cast<size_t>(x / 16 + y / 8) % materialCategories.size();
+
+            structuralLayer.Buffer[{x, y}].Material = isHull
+                ? &materialCategories[category].SubCategories[0].Materials[0].get()
+                : nullptr;
+        }
+    }
+
+    return structuralLayer;
+}
+
+static void AutoTexturization_AutoTexturizeInto_Parallel(benchmark::State & state)
+{
+    ResourceLocator const resourceLocator = ResourceLocator(std::filesystem::current_path());
+    MaterialDatabase const materialDatabase = MaterialDatabase::Load(resourceLocator.GetMaterialDatabaseRootFilePath());
+    ShipTexturizer texturizer(materialDatabase, resourceLocator);
+
+    ThreadManager threadManager(false, static_cast<size_t>(state.range(0)));
+
+    StructuralLayerData const structuralLayer = MakeParallelBenchmarkStructuralLayer(materialDatabase);
+
+    // Create target texture
+    int const magnificationFactor = ShipTexturizer::CalculateHighDefinitionTextureMagnificationFactor(StructureSize);
+    ImageSize const textureSize = ImageSize(
+        StructureSize.width * magnificationFactor,
+        StructureSize.height * magnificationFactor);
+    RgbaImageData targetTextureImage = RgbaImageData(textureSize);
+
+    // Create settings
+    ShipAutoTexturizationSettings settings;
+    settings.Mode = ShipAutoTexturizationModeType::MaterialTextures;
+
+    // Test
+    for (auto _ : state)
+    {
+        texturizer.AutoTexturizeInto(
+            structuralLayer,
+            ShipSpaceRect({ 0, 0 }, StructureSize),
+            targetTextureImage,
+            magnificationFactor,
+            settings,
+            threadManager.GetSimulationThreadPool());
+
+        benchmark::DoNotOptimize(targetTextureImage.Data.get());
+    }
+}
+BENCHMARK(AutoTexturization_AutoTexturizeInto_Parallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+static void AutoTexturization_RenderShipInto_Parallel(benchmark::State & state)
+{
+    ResourceLocator const resourceLocator = ResourceLocator(std::filesystem::current_path());
+    MaterialDatabase const materialDatabase = MaterialDatabase::Load(resourceLocator.GetMaterialDatabaseRootFilePath());
+    ShipTexturizer texturizer(materialDatabase, resourceLocator);
+
+    ThreadManager threadManager(false, static_cast<size_t>(state.range(0)));
+
+    StructuralLayerData const structuralLayer = MakeParallelBenchmarkStructuralLayer(materialDatabase);
+
+    // Create source texture
+    ImageSize const sourceTextureSize = ImageSize(
+        StructureSize.width * 18,
+        StructureSize.height * 18);
+    RgbaImageData sourceTextureImage = RgbaImageData(sourceTextureSize);
+
+    // Create target texture
+    int const magnificationFactor = ShipTexturizer::CalculateHighDefinitionTextureMagnificationFactor(StructureSize);
+    ImageSize const targetTextureSize = ImageSize(
+        StructureSize.width * magnificationFactor,
+        StructureSize.height * magnificationFactor);
+    RgbaImageData targetTextureImage = RgbaImageData(targetTextureSize);
+
+    // Test
+    for (auto _ : state)
+    {
+        texturizer.RenderShipInto(
+            structuralLayer,
+            ShipSpaceRect({ 0, 0 }, StructureSize),
+            sourceTextureImage,
+            targetTextureImage,
+            magnificationFactor,
+            threadManager.GetSimulationThreadPool());
+
+        benchmark::DoNotOptimize(targetTextureImage.Data.get());
+    }
+}
+BENCHMARK(AutoTexturization_RenderShipInto_Parallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
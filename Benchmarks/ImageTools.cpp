@@ -0,0 +1,228 @@
+#include <GameCore/ImageTools.h>
+
+#include <GameCore/ImageData.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <random>
+
+static constexpr ImageSize Size = ImageSize(1920, 1080);
+
+static RgbaImageData MakeImage(unsigned int seed)
+{
+    std::mt19937 randomEngine(seed);
+
+    RgbaImageData image(Size);
+    for (size_t i = 0; i < Size.GetLinearSize(); ++i)
+    {
+        std::uint32_t const v = randomEngine();
+        image.Data[i] = rgbaColor(
+            static_cast<std::uint8_t>(v),
+            static_cast<std::uint8_t>(v >> 8),
+            static_cast<std::uint8_t>(v >> 16),
+            static_cast<std::uint8_t>(v >> 24));
+    }
+
+    return image;
+}
+
+//
+// Scalar baselines: the plain per-pixel loops
+//
+
+static void ImageTools_AlphaPreMultiply_Scalar(benchmark::State & state)
+{
+    RgbaImageData const image = MakeImage(1);
+    RgbaImageData target = image.Clone();
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::memcpy(target.Data.get(), image.Data.get(), image.Size.GetLinearSize() * sizeof(rgbaColor));
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < target.Size.GetLinearSize(); ++i)
+        {
+            target.Data[i].alpha_multiply();
+        }
+
+        benchmark::DoNotOptimize(target.Data.get());
+    }
+}
+BENCHMARK(ImageTools_AlphaPreMultiply_Scalar);
+
+static void ImageTools_AlphaPreMultiply(benchmark::State & state)
+{
+    RgbaImageData const image = MakeImage(1);
+    RgbaImageData target = image.Clone();
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::memcpy(target.Data.get(), image.Data.get(), image.Size.GetLinearSize() * sizeof(rgbaColor));
+        state.ResumeTiming();
+
+        ImageTools::AlphaPreMultiply(target);
+
+        benchmark::DoNotOptimize(target.Data.get());
+    }
+}
+BENCHMARK(ImageTools_AlphaPreMultiply);
+
+static void ImageTools_Overlay_Scalar(benchmark::State & state)
+{
+    RgbaImageData const overlay = MakeImage(2);
+    RgbaImageData target = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < target.Size.GetLinearSize(); ++i)
+        {
+            target.Data[i] = target.Data[i].blend(overlay.Data[i]);
+        }
+
+        benchmark::DoNotOptimize(target.Data.get());
+    }
+}
+BENCHMARK(ImageTools_Overlay_Scalar);
+
+static void ImageTools_Overlay(benchmark::State & state)
+{
+    RgbaImageData const overlay = MakeImage(2);
+    RgbaImageData target = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        ImageTools::Overlay(target, overlay, 0, 0);
+
+        benchmark::DoNotOptimize(target.Data.get());
+    }
+}
+BENCHMARK(ImageTools_Overlay);
+
+static void ImageTools_BlendWithColor_Scalar(benchmark::State & state)
+{
+    RgbaImageData target = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < target.Size.GetLinearSize(); ++i)
+        {
+            target.Data[i] = target.Data[i].mix(rgbColor(12, 200, 99), 0.3f);
+        }
+
+        benchmark::DoNotOptimize(target.Data.get());
+    }
+}
+BENCHMARK(ImageTools_BlendWithColor_Scalar);
+
+static void ImageTools_BlendWithColor(benchmark::State & state)
+{
+    RgbaImageData target = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        ImageTools::BlendWithColor(target, rgbColor(12, 200, 99), 0.3f);
+
+        benchmark::DoNotOptimize(target.Data.get());
+    }
+}
+BENCHMARK(ImageTools_BlendWithColor);
+
+static void ImageTools_ToRgb_Scalar(benchmark::State & state)
+{
+    RgbaImageData const image = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        RgbImageData rgb(image.Size);
+        for (size_t i = 0; i < image.Size.GetLinearSize(); ++i)
+        {
+            rgb.Data[i] = image.Data[i].toRgbColor();
+        }
+
+        benchmark::DoNotOptimize(rgb.Data.get());
+    }
+}
+BENCHMARK(ImageTools_ToRgb_Scalar);
+
+static void ImageTools_ToRgb(benchmark::State & state)
+{
+    RgbaImageData const image = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        auto rgb = ImageTools::ToRgb(image);
+
+        benchmark::DoNotOptimize(rgb.Data.get());
+    }
+}
+BENCHMARK(ImageTools_ToRgb);
+
+static void ImageTools_DownscaleBox2x_Scalar(benchmark::State & state)
+{
+    RgbaImageData const image = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        RgbaImageData result(ImageSize(image.Size.width / 2, image.Size.height / 2));
+        for (int y = 0; y < result.Size.height; ++y)
+        {
+            for (int x = 0; x < result.Size.width; ++x)
+            {
+                rgbaColorAccumulation sum(image[{x * 2, y * 2}]);
+                sum += image[{x * 2 + 1, y * 2}];
+                sum += image[{x * 2, y * 2 + 1}];
+                sum += image[{x * 2 + 1, y * 2 + 1}];
+                result[{x, y}] = sum.toRgbaColor();
+            }
+        }
+
+        benchmark::DoNotOptimize(result.Data.get());
+    }
+}
+BENCHMARK(ImageTools_DownscaleBox2x_Scalar);
+
+static void ImageTools_DownscaleBox2x(benchmark::State & state)
+{
+    RgbaImageData const image = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        auto result = ImageTools::DownscaleBox2x(image);
+
+        benchmark::DoNotOptimize(result.Data.get());
+    }
+}
+BENCHMARK(ImageTools_DownscaleBox2x);
+
+//
+// Resize, e.g. for previews
+//
+
+static void ImageTools_Resize_Shrink(benchmark::State & state)
+{
+    RgbaImageData const image = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        auto result = ImageTools::Resize(image.Clone(), ImageSize(200, 113));
+
+        benchmark::DoNotOptimize(result.Data.get());
+    }
+}
+BENCHMARK(ImageTools_Resize_Shrink);
+
+static void ImageTools_Resize_Enlarge(benchmark::State & state)
+{
+    RgbaImageData const image = MakeImage(1);
+
+    for (auto _ : state)
+    {
+        auto result = ImageTools::Resize(image.Clone(), ImageSize(2560, 1440));
+
+        benchmark::DoNotOptimize(result.Data.get());
+    }
+}
+BENCHMARK(ImageTools_Resize_Enlarge);
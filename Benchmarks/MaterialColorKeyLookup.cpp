@@ -0,0 +1,138 @@
+#include <Game/MaterialColorKeyTable.h>
+#include <Game/Materials.h>
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+static constexpr size_t MaterialCount = 300;
+static constexpr int ImageWidth = 1000;
+static constexpr int ImageHeight = 400;
+
+static std::map<MaterialColorKey, StructuralMaterial> MakeMaterialMap()
+{
+    std::mt19937 randomEngine(1);
+    std::uniform_int_distribution<int> componentDistribution(0, 254);
+
+    std::map<MaterialColorKey, StructuralMaterial> materialMap;
+    while (materialMap.size() < MaterialCount)
+    {
+        MaterialColorKey const colorKey(
+            static_cast<rgbColor::data_type>(componentDistribution(randomEngine)),
+            static_cast<rgbColor::data_type>(componentDistribution(randomEngine)),
+            static_cast<rgbColor::data_type>(componentDistribution(randomEngine)));
+
+        materialMap.emplace(
+            colorKey,
+            StructuralMaterial(colorKey, "Material" + std::to_string(materialMap.size()), rgbaColor(colorKey, 255)));
+    }
+
+    return materialMap;
+}
+
+// Mimics a ship image: runs of the same material, separated by background
+static std::vector<MaterialColorKey> MakeImage(std::map<MaterialColorKey, StructuralMaterial> const & materialMap)
+{
+    std::vector<MaterialColorKey> colorKeys;
+    for (auto const & entry : materialMap)
+    {
+        colorKeys.push_back(entry.first);
+    }
+
+    std::mt19937 randomEngine(2);
+    std::uniform_int_distribution<size_t> materialDistribution(0, colorKeys.size() - 1);
+    std::uniform_int_distribution<int> runLengthDistribution(1, 24);
+    std::bernoulli_distribution isBackgroundDistribution(0.4);
+
+    std::vector<MaterialColorKey> image;
+    image.reserve(static_cast<size_t>(ImageWidth) * static_cast<size_t>(ImageHeight));
+    while (image.size() < static_cast<size_t>(ImageWidth) * static_cast<size_t>(ImageHeight))
+    {
+        MaterialColorKey const colorKey = isBackgroundDistribution(randomEngine)
+            ? EmptyMaterialColorKey
+            : colorKeys[materialDistribution(randomEngine)];
+
+        for (int r = runLengthDistribution(randomEngine); r > 0 && image.size() < image.capacity(); --r)
+        {
+            image.push_back(colorKey);
+        }
+    }
+
+    return image;
+}
+
+static void MaterialColorKeyLookup_Map(benchmark::State& state)
+{
+    auto const materialMap = MakeMaterialMap();
+    auto const image = MakeImage(materialMap);
+
+    std::vector<StructuralMaterial const *> materials(ImageWidth);
+
+    for (auto _ : state)
+    {
+        for (int y = 0; y < ImageHeight; ++y)
+        {
+            MaterialColorKey const * const row = image.data() + static_cast<size_t>(y) * ImageWidth;
+            for (int x = 0; x < ImageWidth; ++x)
+            {
+                auto const it = materialMap.find(row[x]);
+                materials[x] = (it != materialMap.end()) ? &(it->second) : nullptr;
+            }
+
+            benchmark::DoNotOptimize(materials.data());
+        }
+    }
+}
+BENCHMARK(MaterialColorKeyLookup_Map);
+
+static void MaterialColorKeyLookup_Table(benchmark::State& state)
+{
+    auto const materialMap = MakeMaterialMap();
+    auto const image = MakeImage(materialMap);
+
+    MaterialColorKeyTable<StructuralMaterial> const table(materialMap);
+
+    std::vector<StructuralMaterial const *> materials(ImageWidth);
+
+    for (auto _ : state)
+    {
+        for (int y = 0; y < ImageHeight; ++y)
+        {
+            MaterialColorKey const * const row = image.data() + static_cast<size_t>(y) * ImageWidth;
+            for (int x = 0; x < ImageWidth; ++x)
+            {
+                materials[x] = table.Find(row[x]);
+            }
+
+            benchmark::DoNotOptimize(materials.data());
+        }
+    }
+}
+BENCHMARK(MaterialColorKeyLookup_Table);
+
+static void MaterialColorKeyLookup_Table_Batch(benchmark::State& state)
+{
+    auto const materialMap = MakeMaterialMap();
+    auto const image = MakeImage(materialMap);
+
+    MaterialColorKeyTable<StructuralMaterial> const table(materialMap);
+
+    std::vector<StructuralMaterial const *> materials(ImageWidth);
+
+    for (auto _ : state)
+    {
+        for (int y = 0; y < ImageHeight; ++y)
+        {
+            table.Find(
+                image.data() + static_cast<size_t>(y) * ImageWidth,
+                ImageWidth,
+                materials.data());
+
+            benchmark::DoNotOptimize(materials.data());
+        }
+    }
+}
+BENCHMARK(MaterialColorKeyLookup_Table_Batch);
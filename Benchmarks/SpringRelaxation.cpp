@@ -0,0 +1,213 @@
+#include "Utils.h"
+
+#include <Game/SpringRelaxationBlockSchedule.h>
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <vector>
+
+//
+// Compares the two-phase spring relaxation iteration - all springs, then all points -
+// with the fused, cache-blocked one, on a ship-like lattice that is much larger than
+// the caches
+//
+
+static constexpr int LatticeWidth = 1000;
+static constexpr int LatticeHeight = 500;
+
+static constexpr size_t Iterations = 4;
+
+struct SpringRelaxationData
+{
+    std::vector<vec2f> Position;
+    std::vector<vec2f> Velocity;
+    std::vector<vec2f> StaticForce;
+    std::vector<vec2f> IntegrationFactor;
+    std::vector<vec2f> DynamicForce;
+
+    std::vector<SpringEndpoints> Endpoints;
+    std::vector<float> RestLength;
+    std::vector<float> StiffnessCoefficient;
+    std::vector<float> DampingCoefficient;
+};
+
+// Lays out springs and points like the ship factory does: one perfect square at a time,
+// in checkerboard order, with points in order of first appearance
+static SpringRelaxationData MakeLattice()
+{
+    SpringRelaxationData data;
+
+    std::vector<ElementIndex> latticePointIndices(LatticeWidth * LatticeHeight, NoneElementIndex);
+    auto const getPoint = [&](int x, int y)
+    {
+        ElementIndex & p = latticePointIndices[y * LatticeWidth + x];
+        if (p == NoneElementIndex)
+        {
+            p = static_cast<ElementIndex>(data.Position.size());
+            data.Position.emplace_back(static_cast<float>(x), static_cast<float>(y));
+            data.Velocity.emplace_back(0.0f, 0.0f);
+            data.StaticForce.emplace_back(0.0f, -9.8f);
+            data.IntegrationFactor.emplace_back(0.0001f, 0.0001f);
+            data.DynamicForce.emplace_back(0.0f, 0.0f);
+        }
+
+        return p;
+    };
+
+    std::map<std::pair<ElementIndex, ElementIndex>, bool> existingSprings;
+    auto const addSpring = [&](ElementIndex a, ElementIndex b, float restLength)
+    {
+        if (existingSprings.emplace(std::make_pair(std::min(a, b), std::max(a, b)), true).second)
+        {
+            data.Endpoints.push_back({ a, b });
+            data.RestLength.push_back(restLength * 0.99f);
+            data.StiffnessCoefficient.push_back(0.5f);
+            data.DampingCoefficient.push_back(0.01f);
+        }
+    };
+
+    for (int y = 0; y < LatticeHeight - 1; ++y)
+    {
+        for (int x = 0; x < LatticeWidth - 1; ++x)
+        {
+            ElementIndex const a = getPoint(x, y);
+            ElementIndex const b = getPoint(x + 1, y);
+            ElementIndex const c = getPoint(x + 1, y + 1);
+            ElementIndex const d = getPoint(x, y + 1);
+
+            addSpring(a, c, 1.414f);
+            addSpring(b, d, 1.414f);
+
+            if ((x + y) % 2 == 0)
+            {
+                addSpring(a, d, 1.0f);
+                addSpring(b, c, 1.0f);
+            }
+            else
+            {
+                addSpring(a, b, 1.0f);
+                addSpring(d, c, 1.0f);
+            }
+        }
+    }
+
+    return data;
+}
+
+static void ApplySpringsForces(
+    SpringRelaxationData & data,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex)
+{
+    vec2f const * restrict const positionBuffer = data.Position.data();
+    vec2f const * restrict const velocityBuffer = data.Velocity.data();
+    vec2f * restrict const dynamicForceBuffer = data.DynamicForce.data();
+
+    for (ElementIndex s = startSpringIndex; s < endSpringIndex; ++s)
+    {
+        auto const pointAIndex = data.Endpoints[s].PointAIndex;
+        auto const pointBIndex = data.Endpoints[s].PointBIndex;
+
+        vec2f const displacement = positionBuffer[pointBIndex] - positionBuffer[pointAIndex];
+        float const displacementLength = displacement.length();
+        vec2f const springDir = displacement.normalise(displacementLength);
+
+        float const fSpring =
+            (displacementLength - data.RestLength[s])
+            * data.StiffnessCoefficient[s];
+
+        vec2f const relVelocity = velocityBuffer[pointBIndex] - velocityBuffer[pointAIndex];
+        float const fDamp =
+            relVelocity.dot(springDir)
+            * data.DampingCoefficient[s];
+
+        vec2f const forceA = springDir * (fSpring + fDamp);
+        dynamicForceBuffer[pointAIndex] += forceA;
+        dynamicForceBuffer[pointBIndex] -= forceA;
+    }
+}
+
+static void IntegrateAndResetDynamicForces(
+    SpringRelaxationData & data,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+    float constexpr dt = 0.02f / 40.0f;
+    float constexpr velocityFactor = 0.9999f / dt;
+
+    float * restrict const positionBuffer = reinterpret_cast<float *>(data.Position.data()) + startPointIndex * 2;
+    float * restrict const velocityBuffer = reinterpret_cast<float *>(data.Velocity.data()) + startPointIndex * 2;
+    float const * const restrict staticForceBuffer = reinterpret_cast<float const *>(data.StaticForce.data()) + startPointIndex * 2;
+    float const * const restrict integrationFactorBuffer = reinterpret_cast<float const *>(data.IntegrationFactor.data()) + startPointIndex * 2;
+    float * const restrict dynamicForceBuffer = reinterpret_cast<float *>(data.DynamicForce.data()) + startPointIndex * 2;
+
+    size_t const count = (endPointIndex - startPointIndex) * 2;
+    for (size_t i = 0; i < count; ++i)
+    {
+        float const deltaPos =
+            velocityBuffer[i] * dt
+            + (dynamicForceBuffer[i] + staticForceBuffer[i]) * integrationFactorBuffer[i];
+
+        positionBuffer[i] += deltaPos;
+        velocityBuffer[i] = deltaPos * velocityFactor;
+        dynamicForceBuffer[i] = 0.0f;
+    }
+}
+
+static void SpringRelaxation_TwoPhase(benchmark::State & state)
+{
+    auto data = MakeLattice();
+
+    ElementCount const springCount = static_cast<ElementCount>(data.Endpoints.size());
+    ElementCount const pointCount = static_cast<ElementCount>(data.Position.size());
+
+    for (auto _ : state)
+    {
+        for (size_t iter = 0; iter < Iterations; ++iter)
+        {
+            ApplySpringsForces(data, 0, springCount);
+            IntegrateAndResetDynamicForces(data, 0, pointCount);
+        }
+    }
+
+    benchmark::DoNotOptimize(data.Position.data());
+}
+BENCHMARK(SpringRelaxation_TwoPhase);
+
+// Argument is block size, in springs
+static void SpringRelaxation_Fused(benchmark::State & state)
+{
+    auto data = MakeLattice();
+
+    auto const schedule = SpringRelaxationBlockSchedule::Make(
+        data.Endpoints.data(),
+        static_cast<ElementCount>(data.Endpoints.size()),
+        static_cast<ElementCount>(data.Position.size()),
+        static_cast<ElementCount>(state.range(0)));
+
+    auto const & pointRuns = schedule.GetPointRuns();
+
+    for (auto _ : state)
+    {
+        for (size_t iter = 0; iter < Iterations; ++iter)
+        {
+            for (auto const & block : schedule.GetBlocks())
+            {
+                ApplySpringsForces(data, block.StartSpringIndex, block.EndSpringIndex);
+
+                for (size_t r = block.StartPointRunIndex; r < block.EndPointRunIndex; ++r)
+                {
+                    IntegrateAndResetDynamicForces(data, pointRuns[r].StartPointIndex, pointRuns[r].EndPointIndex);
+                }
+            }
+        }
+    }
+
+    benchmark::DoNotOptimize(data.Position.data());
+}
+BENCHMARK(SpringRelaxation_Fused)->Arg(1024)->Arg(4096)->Arg(16384)->Arg(65536);
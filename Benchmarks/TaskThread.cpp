@@ -0,0 +1,193 @@
+#include <GameCore/TaskThread.h>
+
+#include <benchmark/benchmark.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+//
+// Compares the task thread with the mutex-guarded queue of std::function's
+// it replaced, both for the latency of a single round-trip and for a frame's
+// worth of upload tasks
+//
+
+static constexpr size_t TasksPerFrame = 64;
+
+// The baseline: a mutex-guarded deque of std::function's, and a completion
+// flag per task
+class MutexTaskThread
+{
+public:
+
+    MutexTaskThread()
+        : mIsStop(false)
+    {
+        mThread = std::thread(
+            [this]()
+            {
+                while (true)
+                {
+                    std::function<void()> task;
+
+                    {
+                        std::unique_lock<std::mutex> lock(mLock);
+
+                        mSignal.wait(lock, [this] { return mIsStop || !mTasks.empty(); });
+                        if (mIsStop)
+                            break;
+
+                        task = std::move(mTasks.front());
+                        mTasks.pop_front();
+                    }
+
+                    task();
+                }
+            });
+    }
+
+    ~MutexTaskThread()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            mIsStop = true;
+            mSignal.notify_all();
+        }
+
+        mThread.join();
+    }
+
+    std::shared_ptr<bool> QueueTask(std::function<void()> && task)
+    {
+        auto isCompleted = std::make_shared<bool>(false);
+
+        std::unique_lock<std::mutex> lock(mLock);
+
+        mTasks.emplace_back(
+            [this, task = std::move(task), isCompleted]()
+            {
+                task();
+
+                std::unique_lock<std::mutex> lock(mLock);
+                *isCompleted = true;
+                mSignal.notify_all();
+            });
+
+        mSignal.notify_all();
+
+        return isCompleted;
+    }
+
+    void Wait(std::shared_ptr<bool> const & isCompleted)
+    {
+        std::unique_lock<std::mutex> lock(mLock);
+        mSignal.wait(lock, [&isCompleted] { return *isCompleted; });
+    }
+
+private:
+
+    std::thread mThread;
+    std::mutex mLock;
+    std::condition_variable mSignal;
+    std::deque<std::function<void()>> mTasks;
+    bool mIsStop;
+};
+
+// Simulates an upload
+static void Upload(
+    std::uint64_t * target,
+    size_t value)
+{
+    *target += value;
+}
+
+static void TaskThread_RoundTrip_Mutex(benchmark::State & state)
+{
+    MutexTaskThread t;
+    std::uint64_t target = 0;
+
+    for (auto _ : state)
+    {
+        t.Wait(t.QueueTask([&target]() { Upload(&target, 1); }));
+    }
+
+    benchmark::DoNotOptimize(target);
+}
+BENCHMARK(TaskThread_RoundTrip_Mutex)->UseRealTime();
+
+static void TaskThread_RoundTrip(benchmark::State & state)
+{
+    TaskThread t(true);
+    std::uint64_t target = 0;
+
+    for (auto _ : state)
+    {
+        t.QueueTask([&target]() { Upload(&target, 1); })->Wait();
+    }
+
+    benchmark::DoNotOptimize(target);
+}
+BENCHMARK(TaskThread_RoundTrip)->UseRealTime();
+
+static void TaskThread_Frame_Mutex(benchmark::State & state)
+{
+    MutexTaskThread t;
+    std::uint64_t target = 0;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < TasksPerFrame; ++i)
+        {
+            std::uint64_t * const targetPtr = &target;
+            t.QueueTask([targetPtr, i]() { Upload(targetPtr, i); });
+        }
+
+        t.Wait(t.QueueTask([]() {}));
+    }
+
+    benchmark::DoNotOptimize(target);
+}
+BENCHMARK(TaskThread_Frame_Mutex)->UseRealTime();
+
+static void TaskThread_Frame(benchmark::State & state)
+{
+    TaskThread t(true);
+    std::uint64_t target = 0;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < TasksPerFrame; ++i)
+        {
+            std::uint64_t * const targetPtr = &target;
+            t.QueueTask([targetPtr, i]() { Upload(targetPtr, i); });
+        }
+
+        t.QueueSynchronizationPoint()->Wait();
+    }
+
+    benchmark::DoNotOptimize(target);
+}
+BENCHMARK(TaskThread_Frame)->UseRealTime();
+
+static void TaskThread_Frame_Batched(benchmark::State & state)
+{
+    TaskThread t(true);
+    std::uint64_t target = 0;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < TasksPerFrame; ++i)
+        {
+            std::uint64_t * const targetPtr = &target;
+            t.QueueBatchedTask([targetPtr, i]() { Upload(targetPtr, i); });
+        }
+
+        t.QueueSynchronizationPoint()->Wait();
+    }
+
+    benchmark::DoNotOptimize(target);
+}
+BENCHMARK(TaskThread_Frame_Batched)->UseRealTime();
@@ -294,7 +294,7 @@ static void VectorNormalization_Algorithm(benchmark::State & state)
 
     for (auto _ : state)
     {
-        Algorithms::CalculateVectorDirsAndReciprocalLengths_SSE(
+        Algorithms::CalculateVectorDirsAndReciprocalLengths_SIMD(
             pointData,
             springData,
             resultData,
@@ -87,6 +87,7 @@ public:
 
     virtual bool OnInit() override;
     virtual void OnInitCmdLine(wxCmdLineParser & parser) override;
+    virtual bool OnCmdLineParsed(wxCmdLineParser & parser) override;
     virtual int OnExit() override;
 
     virtual int FilterEvent(wxEvent & event) override;
@@ -101,6 +102,9 @@ private:
     std::unique_ptr<ResourceLocator> mResourceLocator;
     std::unique_ptr<LocalizationManager> mLocalizationManager;
 
+    // From the command line
+    std::optional<std::string> mInitialFilePathArg;
+    std::optional<std::filesystem::path> mTelemetryFilePath;
 
     //
     // Secret typing state machine
@@ -119,6 +123,8 @@ IMPLEMENT_APP(MainApp);
 MainApp::MainApp()
     : mMainFrame(nullptr)
     , mLocalizationManager()
+    , mInitialFilePathArg()
+    , mTelemetryFilePath()
 {
 
 #if FS_IS_OS_LINUX()
@@ -233,11 +239,11 @@ bool MainApp::OnInit()
         //
 
         std::optional<std::filesystem::path> initialFilePath;
-        if (argc > 1)
+        if (mInitialFilePathArg.has_value())
         {
             try
             {
-                std::filesystem::path const tmp = std::filesystem::path(std::string(argv[1]));
+                std::filesystem::path const tmp = std::filesystem::path(*mInitialFilePathArg);
                 if (std::filesystem::exists(tmp)
                     && std::filesystem::is_regular_file(tmp))
                 {
@@ -253,7 +259,7 @@ bool MainApp::OnInit()
         // Create frame
         //
 
-        mMainFrame = new MainFrame(this, initialFilePath, *mResourceLocator , *mLocalizationManager);
+        mMainFrame = new MainFrame(this, initialFilePath, mTelemetryFilePath, *mResourceLocator , *mLocalizationManager);
 
         SetTopWindow(mMainFrame);
 
@@ -290,10 +296,31 @@ void MainApp::OnInitCmdLine(wxCmdLineParser & parser)
     // Allow just one argument
     parser.AddParam(wxEmptyString, wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
 
+    // Streams per-step telemetry to the specified file - CSV if its extension is .csv, binary otherwise
+    parser.AddOption(wxEmptyString, "telemetry", "Telemetry file path", wxCMD_LINE_VAL_STRING);
+
     // Put back the base "verbose" or else we get asserts in debug
     parser.AddSwitch("v", "verbose");
 }
 
+bool MainApp::OnCmdLineParsed(wxCmdLineParser & parser)
+{
+    if (parser.GetParamCount() > 0)
+    {
+        mInitialFilePathArg = parser.GetParam(0).ToStdString();
+    }
+
+    wxString telemetryFilePath;
+    if (parser.Found("telemetry", &telemetryFilePath))
+    {
+        mTelemetryFilePath = std::filesystem::path(telemetryFilePath.ToStdString());
+
+        LogMessage("Telemetry file path: \"", mTelemetryFilePath->string(), "\"");
+    }
+
+    return wxApp::OnCmdLineParsed(parser);
+}
+
 int MainApp::OnExit()
 {
     // Flush log
@@ -65,6 +65,8 @@ long const ID_TIME_OF_DAY_DOWN_MENUITEM = wxNewId();
 long const ID_FULL_TIME_OF_DAY_MENUITEM = wxNewId();
 long const ID_PAUSE_MENUITEM = wxNewId();
 long const ID_STEP_MENUITEM = wxNewId();
+long const ID_FAST_FORWARD_MENUITEM = wxNewId();
+long const ID_SIMULATION_THREAD_MENUITEM = wxNewId();
 
 long const ID_RCBOMBDETONATE_MENUITEM = wxNewId();
 long const ID_ANTIMATTERBOMBDETONATE_MENUITEM = wxNewId();
@@ -104,6 +106,7 @@ long const ID_CHECK_UPDATES_TIMER = wxNewId();
 MainFrame::MainFrame(
     wxApp * mainApp,
     std::optional<std::filesystem::path> initialShipFilePath,
+    std::optional<std::filesystem::path> telemetryFilePath,
     ResourceLocator const & resourceLocator,
     LocalizationManager & localizationManager)
     : mMainApp(mainApp)
@@ -123,8 +126,10 @@ MainFrame::MainFrame(
     , mCurrentOpenGLCanvas(nullptr)
     // State
     , mInitialShipFilePath(initialShipFilePath)
+    , mTelemetryFilePath(telemetryFilePath)
     , mCurrentShipLoadSpecs()
     , mPreviousShipLoadSpecs()
+    , mPendingShipLoad()
     , mHasWindowBeenShown(false)
     , mHasStartupTipBeenChecked(false)
     , mIsGameFrozen(false)
@@ -302,6 +307,16 @@ MainFrame::MainFrame(
             Connect(ID_STEP_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnStepMenuItemSelected);
             mStepMenuItem->Enable(false);
 
+            mFastForwardMenuItem = new wxMenuItem(controlsMenu, ID_FAST_FORWARD_MENUITEM, _("Fast Forward") + wxS("\tF3"), _("Simulate faster than real time, as fast as the computer allows"), wxITEM_CHECK);
+            controlsMenu->Append(mFastForwardMenuItem);
+            Connect(ID_FAST_FORWARD_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnFastForwardMenuItemSelected);
+            mFastForwardMenuItem->Check(false);
+
+            mSimulationThreadMenuItem = new wxMenuItem(controlsMenu, ID_SIMULATION_THREAD_MENUITEM, _("Simulate on Separate Thread"), _("Run the simulation on its own thread, independently of the user interface"), wxITEM_CHECK);
+            controlsMenu->Append(mSimulationThreadMenuItem);
+            Connect(ID_SIMULATION_THREAD_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnSimulationThreadMenuItemSelected);
+            mSimulationThreadMenuItem->Check(false);
+
             mainMenuBar->Append(controlsMenu, _("&Controls"));
         }
 
@@ -1202,6 +1217,26 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
     }
 
 
+    //
+    // Start telemetry, if requested
+    //
+
+    if (mTelemetryFilePath.has_value())
+    {
+        try
+        {
+            mGameController->StartTelemetry(
+                *mTelemetryFilePath,
+                mTelemetryFilePath->extension() == ".csv" ? TelemetrySink::FormatType::Csv : TelemetrySink::FormatType::Binary);
+        }
+        catch (std::exception const & exc)
+        {
+            // Not a reason to quit the game
+            OnError("Error starting telemetry: " + std::string(exc.what()), false);
+        }
+    }
+
+
     //
     // Start check update timer
     //
@@ -1746,6 +1781,20 @@ void MainFrame::OnStepMenuItemSelected(wxCommandEvent & /*event*/)
     mGameController->PulseUpdateAtNextGameIteration();
 }
 
+void MainFrame::OnFastForwardMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    assert(!!mGameController);
+
+    mGameController->SetFastForward(mFastForwardMenuItem->IsChecked());
+}
+
+void MainFrame::OnSimulationThreadMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    assert(!!mGameController);
+
+    mGameController->SetSimulationThreaded(mSimulationThreadMenuItem->IsChecked());
+}
+
 void MainFrame::OnMoveMenuItemSelected(wxCommandEvent & /*event*/)
 {
     assert(!!mToolController);
@@ -2216,6 +2265,13 @@ void MainFrame::RunGameIteration()
     // Run a game step
     //
 
+    // Complete pending ship load, if it's ready - at this frame boundary
+    if (mPendingShipLoad.has_value()
+        && mGameController->PollShipLoad())
+    {
+        CompleteShipLoad();
+    }
+
     try
     {
         // Update tool controller
@@ -2338,6 +2394,13 @@ void MainFrame::UpdateFrameTitle()
             << Utils::Join(mCurrentShipTitles, " + ");
     }
 
+    if (mPendingShipLoad.has_value())
+    {
+        ss << " - "
+            << _("Loading ship...").ToStdString()
+            << " " << static_cast<int>(mPendingShipLoad->Progress * 100.0f) << "%";
+    }
+
     SetTitle(ss.str());
 }
 
@@ -2553,6 +2616,44 @@ void MainFrame::LoadShip(
     ShipLoadSpecifications const & loadSpecs,
     bool isFromUser)
 {
+    //
+    // Start loading the ship in the background; the current world keeps running
+    // until the load completes, at which moment we swap the new ship in - see CompleteShipLoad()
+    //
+
+    try
+    {
+        mPendingShipLoad.emplace(loadSpecs, isFromUser);
+
+        assert(mGameController);
+        mGameController->BeginResetAndLoadShip(
+            loadSpecs,
+            [this](float progress, ProgressMessageType /*message*/)
+            {
+                assert(mPendingShipLoad.has_value());
+                mPendingShipLoad->Progress = progress;
+
+                UpdateFrameTitle();
+            });
+
+        UpdateFrameTitle();
+    }
+    catch (std::exception const & ex)
+    {
+        mPendingShipLoad.reset();
+
+        OnError(ex.what(), false);
+    }
+}
+
+void MainFrame::CompleteShipLoad()
+{
+    assert(mPendingShipLoad.has_value());
+    PendingShipLoad const pendingShipLoad = *mPendingShipLoad;
+    mPendingShipLoad.reset();
+
+    UpdateFrameTitle();
+
     //
     // Reset
     //
@@ -2567,25 +2668,26 @@ void MainFrame::LoadShip(
     mMusicController->Reset();
 
     ResetShipUIState();
-    
+
     //
-    // Load ship
+    // Swap in loaded ship
     //
 
     try
     {
-        // Load
         assert(mGameController);
-        auto const shipMetadata = mGameController->ResetAndLoadShip(loadSpecs);
+        auto const shipMetadata = mGameController->EndResetAndLoadShip();
 
         // Succeeded
-        OnShipLoaded(loadSpecs);
+        OnShipLoaded(pendingShipLoad.LoadSpecs);
 
         // Open description, if a description exists and the user allows
-        if (isFromUser
+        if (pendingShipLoad.IsFromUser
             && shipMetadata.Description.has_value()
             && mUIPreferencesManager->GetShowShipDescriptionsAtShipLoad())
         {
+            SetPaused(true);
+
             ShipDescriptionDialog shipDescriptionDialog(
                 this,
                 shipMetadata,
@@ -2594,6 +2696,8 @@ void MainFrame::LoadShip(
 
             shipDescriptionDialog.ShowModal();
 
+            SetPaused(false);
+
             // Store user preference, in case they made a choice
             auto const showDescriptionsUserPreference = shipDescriptionDialog.GetShowDescriptionsUserPreference();
             if (showDescriptionsUserPreference.has_value())
@@ -61,6 +61,7 @@ public:
     MainFrame(
         wxApp * mainApp,
         std::optional<std::filesystem::path> initialShipFilePath,
+        std::optional<std::filesystem::path> telemetryFilePath,
         ResourceLocator const & resourceLocator,
         LocalizationManager & localizationManager);
 
@@ -121,6 +122,8 @@ private:
     wxMenuItem * mContinuousAutoFocusMenuItem;
     wxMenuItem * mPauseMenuItem;
     wxMenuItem * mStepMenuItem;
+    wxMenuItem * mFastForwardMenuItem;
+    wxMenuItem * mSimulationThreadMenuItem;
     wxMenu * mToolsMenu;
     wxMenuItem * mSmashMenuItem;
     wxMenuItem * mScareFishMenuItem;
@@ -200,6 +203,8 @@ private:
     void OnFullTimeOfDayMenuItemSelected(wxCommandEvent & event);
     void OnPauseMenuItemSelected(wxCommandEvent & event);
     void OnStepMenuItemSelected(wxCommandEvent & event);
+    void OnFastForwardMenuItemSelected(wxCommandEvent & event);
+    void OnSimulationThreadMenuItemSelected(wxCommandEvent & event);
     void OnLoadShipMenuItemSelected(wxCommandEvent & event);
     void OnReloadCurrentShipMenuItemSelected(wxCommandEvent & event);
     void OnReloadPreviousShipMenuItemSelected(wxCommandEvent & event);
@@ -404,6 +409,8 @@ private:
         ShipLoadSpecifications const & loadSpecs,
         bool isFromUser);
 
+    void CompleteShipLoad();
+
     void OnShipLoaded(ShipLoadSpecifications loadSpecs); // By val to have own copy vs current/prev
 
     wxAcceleratorEntry MakePlainAcceleratorKey(int key, wxMenuItem * menuItem);
@@ -421,9 +428,27 @@ private:
     //
 
     std::optional<std::filesystem::path> const mInitialShipFilePath;
+    std::optional<std::filesystem::path> const mTelemetryFilePath;
     std::optional<ShipLoadSpecifications> mCurrentShipLoadSpecs;
     std::optional<ShipLoadSpecifications> mPreviousShipLoadSpecs;
 
+    struct PendingShipLoad
+    {
+        ShipLoadSpecifications LoadSpecs;
+        bool IsFromUser;
+        float Progress;
+
+        PendingShipLoad(
+            ShipLoadSpecifications const & loadSpecs,
+            bool isFromUser)
+            : LoadSpecs(loadSpecs)
+            , IsFromUser(isFromUser)
+            , Progress(0.0f)
+        {}
+    };
+
+    std::optional<PendingShipLoad> mPendingShipLoad;
+
     bool mHasWindowBeenShown;
     bool mHasStartupTipBeenChecked;
     bool mIsGameFrozen;
@@ -958,6 +958,46 @@ void SettingsDialog::PopulateMechanicsAndThermodynamicsPanel(
                     CellBorderInner);
             }
 
+            // Adapt Spring Iterations
+            {
+                mDoAdaptMechanicalDynamicsIterationsCheckBox = new wxCheckBox(performanceBoxSizer->GetStaticBox(), wxID_ANY, _("Adaptive Spring Algo"));
+                mDoAdaptMechanicalDynamicsIterationsCheckBox->SetToolTip(_("Enables or disables lowering the spring algorithm effort on ships that are at rest. Saves computation time, at the expense of a slight softening of structures at rest."));
+                mDoAdaptMechanicalDynamicsIterationsCheckBox->Bind(
+                    wxEVT_COMMAND_CHECKBOX_CLICKED,
+                    [this](wxCommandEvent & event)
+                    {
+                        mLiveSettings.SetValue<bool>(GameSettings::DoAdaptMechanicalDynamicsIterations, event.IsChecked());
+                        OnLiveSettingsChanged();
+                    });
+
+                performanceSizer->Add(
+                    mDoAdaptMechanicalDynamicsIterationsCheckBox,
+                    wxGBPosition(1, 0),
+                    wxGBSpan(1, 2),
+                    wxLEFT | wxRIGHT | wxALIGN_CENTER_VERTICAL,
+                    CellBorderInner);
+            }
+
+            // Fuse Spring Algo
+            {
+                mDoFuseSpringRelaxationCheckBox = new wxCheckBox(performanceBoxSizer->GetStaticBox(), wxID_ANY, _("Cache-Blocked Spring Algo"));
+                mDoFuseSpringRelaxationCheckBox->SetToolTip(_("Enables or disables running the spring algorithm of large ships in cache-sized blocks, when it runs on a single thread. Only saves computation time on computers with slow memory."));
+                mDoFuseSpringRelaxationCheckBox->Bind(
+                    wxEVT_COMMAND_CHECKBOX_CLICKED,
+                    [this](wxCommandEvent & event)
+                    {
+                        mLiveSettings.SetValue<bool>(GameSettings::DoFuseSpringRelaxation, event.IsChecked());
+                        OnLiveSettingsChanged();
+                    });
+
+                performanceSizer->Add(
+                    mDoFuseSpringRelaxationCheckBox,
+                    wxGBPosition(2, 0),
+                    wxGBSpan(1, 2),
+                    wxLEFT | wxRIGHT | wxALIGN_CENTER_VERTICAL,
+                    CellBorderInner);
+            }
+
             performanceBoxSizer->Add(performanceSizer, 1, wxALL, StaticBoxInsetMargin);
         }
 
@@ -5545,6 +5585,8 @@ void SettingsDialog::SyncControlsWithSettings(Settings<GameSettings> const & set
     mUltraViolentToggleButton->SetValue(settings.GetValue<bool>(GameSettings::UltraViolentMode));
     mMaxNumSimulationThreadsSlider->SetValue(settings.GetValue<unsigned int>(GameSettings::MaxNumSimulationThreads));
     mNumMechanicalIterationsAdjustmentSlider->SetValue(settings.GetValue<float>(GameSettings::NumMechanicalDynamicsIterationsAdjustment));
+    mDoAdaptMechanicalDynamicsIterationsCheckBox->SetValue(settings.GetValue<bool>(GameSettings::DoAdaptMechanicalDynamicsIterations));
+    mDoFuseSpringRelaxationCheckBox->SetValue(settings.GetValue<bool>(GameSettings::DoFuseSpringRelaxation));
 
     //
     // Water and Ocean
@@ -74,6 +74,8 @@ private:
     BitmapToggleButton * mUltraViolentToggleButton;
     SliderControl<unsigned int> * mMaxNumSimulationThreadsSlider;
     SliderControl<float> * mNumMechanicalIterationsAdjustmentSlider;
+    wxCheckBox * mDoAdaptMechanicalDynamicsIterationsCheckBox;
+    wxCheckBox * mDoFuseSpringRelaxationCheckBox;
 
     // Ocean and Water
     SliderControl<float> * mWaterDensityAdjustmentSlider;
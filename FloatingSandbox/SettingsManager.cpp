@@ -42,6 +42,8 @@ BaseSettingsManager<GameSettings>::BaseSettingsManagerFactory SettingsManager::M
 
     ADD_GC_SETTING(unsigned int, MaxNumSimulationThreads);
     ADD_GC_SETTING(float, NumMechanicalDynamicsIterationsAdjustment);
+    ADD_GC_SETTING(bool, DoAdaptMechanicalDynamicsIterations);
+    ADD_GC_SETTING(bool, DoFuseSpringRelaxation);
     ADD_GC_SETTING(float, SpringStiffnessAdjustment);
     ADD_GC_SETTING(float, SpringDampingAdjustment);
     ADD_GC_SETTING(float, SpringStrengthAdjustment);
@@ -15,6 +15,8 @@ enum class GameSettings : size_t
 {
     MaxNumSimulationThreads = 0,
     NumMechanicalDynamicsIterationsAdjustment,
+    DoAdaptMechanicalDynamicsIterations,
+    DoFuseSpringRelaxation,
     SpringStiffnessAdjustment,
     SpringDampingAdjustment,
     SpringStrengthAdjustment,
@@ -0,0 +1,250 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-04
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "AsyncShipLoader.h"
+
+#include "ShipDeSerializer.h"
+#include "ShipFactory.h"
+
+#include <GameCore/GameRandomEngine.h>
+#include <GameCore/Log.h>
+
+#include <algorithm>
+#include <cassert>
+
+AsyncShipLoader::AsyncShipLoader(
+    MaterialDatabase const & materialDatabase,
+    ResourceLocator const & resourceLocator)
+    : mShipTexturizer(materialDatabase, resourceLocator)
+    , mTexturizationThreadManager()
+    , mMaterialDatabase(materialDatabase)
+    , mCurrentLoad()
+    , mLoaderThread(true)
+{
+}
+
+AsyncShipLoader::~AsyncShipLoader()
+{
+    // Have the load in progress, if any, stop at its next cancellation point;
+    // the loader thread is then stopped before our state goes
+    Cancel();
+}
+
+AsyncShipLoader::LoadedShip AsyncShipLoader::LoadShip(
+    ShipLoadSpecifications const & loadSpecs,
+    std::unique_ptr<Physics::World> world,
+    MaterialDatabase const & materialDatabase,
+    ShipTexturizer const & shipTexturizer,
+    ThreadPool & texturizationThreadPool,
+    ShipStrengthRandomizer const & shipStrengthRandomizer,
+    std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+    GameParameters const & gameParameters,
+    ProgressCallback const & progressCallback)
+{
+    // Fraction of the progress we attribute to the definition load
+    float constexpr DefinitionLoadProgress = 0.3f;
+
+    //
+    // Load ship definition
+    //
+
+    progressCallback(DefinitionLoadProgress, ProgressMessageType::LoadingShip);
+
+    auto shipDefinition = ShipDeSerializer::LoadShip(loadSpecs.DefinitionFilepath, materialDatabase);
+
+    // Save metadata
+    ShipMetadata shipMetadata(shipDefinition.Metadata);
+
+    //
+    // Produce ship
+    //
+
+    auto const shipId = world->GetNextShipId();
+
+    auto [ship, textureImage] = ShipFactory::Create(
+        shipId,
+        *world,
+        std::move(shipDefinition),
+        loadSpecs.LoadOptions,
+        materialDatabase,
+        shipTexturizer,
+        texturizationThreadPool,
+        shipStrengthRandomizer,
+        std::move(gameEventDispatcher),
+        gameParameters,
+        [&progressCallback](float progress, ProgressMessageType message)
+        {
+            progressCallback(DefinitionLoadProgress + progress * (1.0f - DefinitionLoadProgress), message);
+        });
+
+    return LoadedShip(
+        std::move(world),
+        std::move(ship),
+        std::move(textureImage),
+        shipMetadata);
+}
+
+void AsyncShipLoader::Start(
+    ShipLoadSpecifications const & loadSpecs,
+    std::unique_ptr<Physics::World> world,
+    std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+    GameParameters const & gameParameters,
+    ShipStrengthRandomizer const & shipStrengthRandomizer,
+    ShipAutoTexturizationSettings const & autoTexturizationSharedSettings,
+    bool doForceAutoTexturizationSharedSettingsOntoShipSettings,
+    ProgressCallback const & progressCallback)
+{
+    // Only one load at a time
+    Cancel();
+
+    assert(!mCurrentLoad);
+
+    mCurrentLoad = std::make_shared<CurrentLoad>(progressCallback);
+
+    LogMessage("AsyncShipLoader::Start(): starting load of \"", loadSpecs.DefinitionFilepath.string(), "\"");
+
+    // The loader thread draws from an engine of its own, seeded from the calling thread's
+    // sequence - so that each load differs, deterministically
+    std::uint32_t const randomSeed = GameRandomEngine::GetInstance().GenerateSeed();
+
+    auto loadRequest = std::make_unique<LoadRequest>(
+        loadSpecs,
+        std::move(world),
+        std::move(gameEventDispatcher),
+        gameParameters, // Copy, as the main thread keeps changing its own
+        shipStrengthRandomizer,
+        autoTexturizationSharedSettings,
+        doForceAutoTexturizationSharedSettingsOntoShipSettings,
+        randomSeed);
+
+    // Fire-and-forget: we learn about completion via the load's state, which
+    // the loader thread keeps alive for as long as it works on it
+    mLoaderThread.QueueTask(
+        [this, currentLoad = mCurrentLoad, loadRequest = std::move(loadRequest)]()
+        {
+            RunLoad(*currentLoad, std::move(*loadRequest));
+        });
+}
+
+bool AsyncShipLoader::Poll()
+{
+    if (!mCurrentLoad)
+    {
+        return false;
+    }
+
+    // Report progress, if it has changed
+    float const progress = mCurrentLoad->Progress.load(std::memory_order_acquire);
+    if (progress != mCurrentLoad->LastReportedProgress)
+    {
+        mCurrentLoad->LastReportedProgress = progress;
+
+        if (mCurrentLoad->Callback)
+        {
+            mCurrentLoad->Callback(progress, mCurrentLoad->ProgressMessage.load(std::memory_order_relaxed));
+        }
+    }
+
+    return mCurrentLoad->IsCompleted.load(std::memory_order_acquire);
+}
+
+AsyncShipLoader::LoadedShip AsyncShipLoader::TakeResult()
+{
+    assert(!!mCurrentLoad);
+    assert(mCurrentLoad->IsCompleted.load(std::memory_order_acquire));
+
+    auto const currentLoad = std::move(mCurrentLoad);
+
+    // Throw if the load has failed
+    if (currentLoad->Exception)
+    {
+        std::rethrow_exception(currentLoad->Exception);
+    }
+
+    assert(currentLoad->Result.has_value());
+    return std::move(*(currentLoad->Result));
+}
+
+void AsyncShipLoader::Cancel()
+{
+    if (mCurrentLoad)
+    {
+        LogMessage("AsyncShipLoader::Cancel(): cancelling load in progress");
+
+        // The loader thread notices at its next cancellation point, and then discards
+        // whatever it has produced
+        mCurrentLoad->IsCancelled.store(true, std::memory_order_relaxed);
+
+        mCurrentLoad.reset();
+    }
+}
+
+void AsyncShipLoader::RunLoad(
+    CurrentLoad & currentLoad,
+    LoadRequest && loadRequest)
+{
+    try
+    {
+        if (currentLoad.IsCancelled.load(std::memory_order_relaxed))
+        {
+            // Cancelled before we even started
+            throw LoadCancelledException();
+        }
+
+        // We're the only user of the texturizer, hence it's safe to update it
+        mShipTexturizer.SetSharedSettings(loadRequest.AutoTexturizationSharedSettings);
+        mShipTexturizer.SetDoForceSharedSettingsOntoShipSettings(loadRequest.DoForceAutoTexturizationSharedSettingsOntoShipSettings);
+
+        GameRandomEngine::ThreadEngine const randomEngine(loadRequest.RandomSeed);
+
+        currentLoad.Result.emplace(
+            LoadShip(
+                loadRequest.LoadSpecs,
+                std::move(loadRequest.World),
+                mMaterialDatabase,
+                mShipTexturizer,
+                GetTexturizationThreadPool(),
+                loadRequest.StrengthRandomizer,
+                std::move(loadRequest.EventDispatcher),
+                loadRequest.Parameters,
+                [&currentLoad](float progress, ProgressMessageType message)
+                {
+                    // Each progress report is also a cancellation point
+                    if (currentLoad.IsCancelled.load(std::memory_order_relaxed))
+                    {
+                        throw LoadCancelledException();
+                    }
+
+                    currentLoad.ProgressMessage.store(message, std::memory_order_relaxed);
+                    currentLoad.Progress.store(progress, std::memory_order_release);
+                }));
+    }
+    catch (LoadCancelledException const &)
+    {
+        LogMessage("AsyncShipLoader::RunLoad(): load cancelled");
+
+        currentLoad.Exception = std::current_exception();
+    }
+    catch (...)
+    {
+        currentLoad.Exception = std::current_exception();
+    }
+
+    currentLoad.IsCompleted.store(true, std::memory_order_release);
+}
+
+ThreadPool & AsyncShipLoader::GetTexturizationThreadPool()
+{
+    if (!mTexturizationThreadManager)
+    {
+        // We share the CPU with the world that keeps running while we load, hence we
+        // only take half of it
+        mTexturizationThreadManager = std::make_unique<ThreadManager>(
+            false,
+            std::max(ThreadManager::GetNumberOfProcessors() / 2, size_t(1)));
+    }
+
+    return mTexturizationThreadManager->GetSimulationThreadPool();
+}
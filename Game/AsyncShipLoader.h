@@ -0,0 +1,223 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-04
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameEventDispatcher.h"
+#include "GameParameters.h"
+#include "MaterialDatabase.h"
+#include "Physics.h"
+#include "ResourceLocator.h"
+#include "ShipAutoTexturizationSettings.h"
+#include "ShipLoadSpecifications.h"
+#include "ShipMetadata.h"
+#include "ShipStrengthRandomizer.h"
+#include "ShipTexturizer.h"
+
+#include <GameCore/ImageData.h>
+#include <GameCore/ProgressCallback.h>
+#include <GameCore/TaskThread.h>
+#include <GameCore/ThreadManager.h>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+
+/*
+ * Loads ships on a background thread - parsing their definition, building them,
+ * and texturizing them - so that the current world may keep running meanwhile.
+ *
+ * A ship is loaded into its own, new world, which is only touched by the loader
+ * thread until the load has completed; the main thread then takes the loaded world
+ * and swaps it in at a frame boundary.
+ *
+ * At most one load is in progress at any moment; all methods are to be invoked
+ * on the main thread. Cancelled loads are left to the loader thread to wind down,
+ * hence cancelling never blocks the main thread.
+ */
+class AsyncShipLoader final
+{
+public:
+
+    struct LoadedShip
+    {
+        std::unique_ptr<Physics::World> World;
+        std::unique_ptr<Physics::Ship> Ship;
+        RgbaImageData TextureImage;
+        ShipMetadata Metadata;
+
+        LoadedShip(
+            std::unique_ptr<Physics::World> world,
+            std::unique_ptr<Physics::Ship> ship,
+            RgbaImageData && textureImage,
+            ShipMetadata const & metadata)
+            : World(std::move(world))
+            , Ship(std::move(ship))
+            , TextureImage(std::move(textureImage))
+            , Metadata(metadata)
+        {}
+    };
+
+public:
+
+    AsyncShipLoader(
+        MaterialDatabase const & materialDatabase,
+        ResourceLocator const & resourceLocator);
+
+    ~AsyncShipLoader();
+
+    AsyncShipLoader(AsyncShipLoader const & other) = delete;
+    AsyncShipLoader & operator=(AsyncShipLoader const & other) = delete;
+
+    /*
+     * Loads and builds a ship into the specified world, on the calling thread.
+     *
+     * The progress callback is invoked on the calling thread, and it may abort
+     * the load by throwing.
+     */
+    static LoadedShip LoadShip(
+        ShipLoadSpecifications const & loadSpecs,
+        std::unique_ptr<Physics::World> world,
+        MaterialDatabase const & materialDatabase,
+        ShipTexturizer const & shipTexturizer,
+        ThreadPool & texturizationThreadPool,
+        ShipStrengthRandomizer const & shipStrengthRandomizer,
+        std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+        GameParameters const & gameParameters,
+        ProgressCallback const & progressCallback);
+
+    /*
+     * Starts loading a ship in the background, cancelling the load in progress, if any;
+     * the new load starts once the loader thread has dropped the cancelled one.
+     *
+     * The settings are captured at this moment; the progress callback is only invoked
+     * from within Poll().
+     */
+    void Start(
+        ShipLoadSpecifications const & loadSpecs,
+        std::unique_ptr<Physics::World> world,
+        std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+        GameParameters const & gameParameters,
+        ShipStrengthRandomizer const & shipStrengthRandomizer,
+        ShipAutoTexturizationSettings const & autoTexturizationSharedSettings,
+        bool doForceAutoTexturizationSharedSettingsOntoShipSettings,
+        ProgressCallback const & progressCallback);
+
+    bool IsInProgress() const
+    {
+        return mCurrentLoad != nullptr;
+    }
+
+    /*
+     * Reports the progress made by the load in progress, and returns whether the load
+     * has completed - either successfully or not, in which case TakeResult() is to be
+     * invoked next.
+     */
+    bool Poll();
+
+    /*
+     * Returns the loaded ship, or re-throws the exception that caused the load to fail;
+     * to be invoked once Poll() has returned true.
+     */
+    LoadedShip TakeResult();
+
+    /*
+     * Cancels the load in progress, if any, without waiting for the loader thread:
+     * the loader thread drops the load at its next cancellation point.
+     */
+    void Cancel();
+
+private:
+
+    struct LoadCancelledException
+    {};
+
+    struct CurrentLoad
+    {
+        // Shared with the loader thread
+        std::atomic<bool> IsCancelled;
+        std::atomic<float> Progress;
+        std::atomic<ProgressMessageType> ProgressMessage;
+        std::atomic<bool> IsCompleted;
+
+        // Set by the loader thread before it sets IsCompleted
+        std::optional<LoadedShip> Result;
+        std::exception_ptr Exception;
+
+        // Only used by the main thread
+        ProgressCallback Callback;
+        float LastReportedProgress;
+
+        explicit CurrentLoad(ProgressCallback const & callback)
+            : IsCancelled(false)
+            , Progress(0.0f)
+            , ProgressMessage(ProgressMessageType::None)
+            , IsCompleted(false)
+            , Result()
+            , Exception()
+            , Callback(callback)
+            , LastReportedProgress(-1.0f)
+        {}
+    };
+
+    // What a load needs, captured when the load is started
+    struct LoadRequest
+    {
+        ShipLoadSpecifications LoadSpecs;
+        std::unique_ptr<Physics::World> World;
+        std::shared_ptr<GameEventDispatcher> EventDispatcher;
+        GameParameters Parameters;
+        ShipStrengthRandomizer StrengthRandomizer;
+        ShipAutoTexturizationSettings AutoTexturizationSharedSettings;
+        bool DoForceAutoTexturizationSharedSettingsOntoShipSettings;
+        std::uint32_t RandomSeed;
+
+        LoadRequest(
+            ShipLoadSpecifications const & loadSpecs,
+            std::unique_ptr<Physics::World> world,
+            std::shared_ptr<GameEventDispatcher> eventDispatcher,
+            GameParameters const & parameters,
+            ShipStrengthRandomizer const & strengthRandomizer,
+            ShipAutoTexturizationSettings const & autoTexturizationSharedSettings,
+            bool doForceAutoTexturizationSharedSettingsOntoShipSettings,
+            std::uint32_t randomSeed)
+            : LoadSpecs(loadSpecs)
+            , World(std::move(world))
+            , EventDispatcher(std::move(eventDispatcher))
+            , Parameters(parameters)
+            , StrengthRandomizer(strengthRandomizer)
+            , AutoTexturizationSharedSettings(autoTexturizationSharedSettings)
+            , DoForceAutoTexturizationSharedSettingsOntoShipSettings(doForceAutoTexturizationSharedSettingsOntoShipSettings)
+            , RandomSeed(randomSeed)
+        {}
+    };
+
+private:
+
+    // Runs on the loader thread
+    void RunLoad(
+        CurrentLoad & currentLoad,
+        LoadRequest && loadRequest);
+
+    ThreadPool & GetTexturizationThreadPool();
+
+private:
+
+    // Only used by the loader thread
+    ShipTexturizer mShipTexturizer;
+
+    // Lazily created; its pool is only used by the loader thread
+    std::unique_ptr<ThreadManager> mTexturizationThreadManager;
+
+    MaterialDatabase const & mMaterialDatabase;
+
+    // Shared with the loader thread, which keeps it alive for as long as it works on it
+    std::shared_ptr<CurrentLoad> mCurrentLoad;
+
+    // Runs loads one at a time; last, as it has to stop before everything else goes
+    TaskThread mLoaderThread;
+};
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <array>
 #include <limits>
+#include <numeric>
 #include <set>
 #include <utility>
 
@@ -101,7 +102,7 @@ void Frontiers::HandleTriangleDestroy(
     for (int eOrd = 0; eOrd < static_cast<int>(triangles.GetSubSprings(triangleElementIndex).SpringIndices.size()); ++eOrd)
     {
         ElementIndex edgeIndex = triangles.GetSubSprings(triangleElementIndex).SpringIndices[eOrd];
-        if (mEdges[edgeIndex].FrontierIndex != NoneFrontierId)
+        if (GetEdgeFrontierId(edgeIndex) != NoneFrontierId)
         {
             ++edgesWithFrontierCount;
             lastEdgeWithFrontier = edgeIndex;
@@ -173,7 +174,7 @@ void Frontiers::HandleTriangleDestroy(
         //                     Z
         //
 
-        FrontierId const frontierId = mEdges[lastEdgeWithFrontier].FrontierIndex;
+        FrontierId const frontierId = GetEdgeFrontierId(lastEdgeWithFrontier);
 
         int const edgeOrdXZ = PreviousEdgeOrdinal(lastEdgeOrdinalWithFrontier);
         ElementIndex const edgeXZ = triangles.GetSubSprings(triangleElementIndex).SpringIndices[edgeOrdXZ];
@@ -276,10 +277,10 @@ void Frontiers::HandleTriangleDestroy(
             assert(cuspCount == 3);
 
             // All the edges of the triangle have a frontier, and it's the same
-            FrontierId const frontierId = mEdges[edgeAIndex].FrontierIndex;
+            FrontierId const frontierId = GetEdgeFrontierId(edgeAIndex);
             assert(frontierId != NoneFrontierId);
-            assert(mEdges[edgeBIndex].FrontierIndex == frontierId);
-            assert(mEdges[edgeCIndex].FrontierIndex == frontierId);
+            assert(GetEdgeFrontierId(edgeBIndex) == frontierId);
+            assert(GetEdgeFrontierId(edgeCIndex) == frontierId);
 
             // Destroy this frontier
             mEdges[edgeAIndex].FrontierIndex = NoneFrontierId;
@@ -317,7 +318,7 @@ void Frontiers::HandleTriangleRestore(
     for (int eOrd = 0; eOrd < static_cast<int>(triangles.GetSubSprings(triangleElementIndex).SpringIndices.size()); ++eOrd)
     {
         ElementIndex const edgeIndex = triangles.GetSubSprings(triangleElementIndex).SpringIndices[eOrd];
-        if (mEdges[edgeIndex].FrontierIndex != NoneFrontierId)
+        if (GetEdgeFrontierId(edgeIndex) != NoneFrontierId)
         {
             // If there's a frontier here, it's because of another triangle
             assert(springs.GetSuperTriangles(edgeIndex).size() == 1 && springs.GetSuperTriangles(edgeIndex)[0] != triangleElementIndex);
@@ -345,9 +346,9 @@ void Frontiers::HandleTriangleRestore(
         //
 
         // ...if there are 3 edges with frontiers, then it's the same frontier
-        FrontierId const frontierId = mEdges[edgeAIndex].FrontierIndex;
-        assert(mEdges[edgeBIndex].FrontierIndex == frontierId);
-        assert(mEdges[edgeCIndex].FrontierIndex == frontierId);
+        FrontierId const frontierId = GetEdgeFrontierId(edgeAIndex);
+        assert(GetEdgeFrontierId(edgeBIndex) == frontierId);
+        assert(GetEdgeFrontierId(edgeCIndex) == frontierId);
 
         // ...if there are 3 edges with frontiers, then it's an internal frontier
         assert(mFrontiers[frontierId].has_value()
@@ -394,7 +395,7 @@ void Frontiers::HandleTriangleRestore(
         //                     Z
         //
 
-        FrontierId const frontierId = mEdges[lastEdgeWithFrontier].FrontierIndex;
+        FrontierId const frontierId = GetEdgeFrontierId(lastEdgeWithFrontier);
 
         int const edgeOrdXZ = PreviousEdgeOrdinal(lastEdgeOrdinalWithoutFrontier);
         ElementIndex const edgeXZ = triangles.GetSubSprings(triangleElementIndex).SpringIndices[edgeOrdXZ];
@@ -403,9 +404,9 @@ void Frontiers::HandleTriangleRestore(
         ElementIndex const edgeZY = triangles.GetSubSprings(triangleElementIndex).SpringIndices[edgeOrdZY];
 
         // XZ and ZY are connected
-        assert(mEdges[edgeXZ].FrontierIndex == frontierId
+        assert(GetEdgeFrontierId(edgeXZ) == frontierId
             && mFrontierEdges[edgeXZ].NextEdgeIndex == edgeZY);
-        assert(mEdges[edgeZY].FrontierIndex == frontierId
+        assert(GetEdgeFrontierId(edgeZY) == frontierId
             && mFrontierEdges[edgeZY].PrevEdgeIndex == edgeXZ);
 
         // X->Y
@@ -460,7 +461,7 @@ void Frontiers::HandleTriangleRestore(
             // ...replace Y->X (which runs along another, old triangle) with Y->Z and Z->X (which will run along this new triangle)
             //
 
-            FrontierId const frontierId = mEdges[lastEdgeWithFrontier].FrontierIndex;
+            FrontierId const frontierId = GetEdgeFrontierId(lastEdgeWithFrontier);
 
             int const edgeOrdYZ = NextEdgeOrdinal(lastEdgeOrdinalWithFrontier);
             ElementIndex const edgeYZ = triangles.GetSubSprings(triangleElementIndex).SpringIndices[edgeOrdYZ];
@@ -590,6 +591,58 @@ void Frontiers::HandleTriangleRestore(
     mIsDirtyForRendering = true;
 }
 
+void Frontiers::Compact()
+{
+    if (mFrontierIds.size() == mFrontiers.size())
+    {
+        // No holes, hence no merged frontiers either
+        return;
+    }
+
+    //
+    // Renumber frontiers in the order of their current IDs - which is not
+    // the order of the frontier IDs vector, as removals swap IDs around -
+    // relabeling all of their edges, including those still carrying the ID
+    // of a frontier that has been merged
+    //
+
+    mCompactedFrontiers.clear();
+
+    for (auto const & frontier : mFrontiers)
+    {
+        if (!frontier.has_value())
+        {
+            continue;
+        }
+
+        FrontierId const newFrontierId = static_cast<FrontierId>(mCompactedFrontiers.size());
+
+        ElementIndex const startingEdgeIndex = frontier->StartingEdgeIndex;
+        ElementIndex edgeIndex = startingEdgeIndex;
+
+        do
+        {
+            mEdges[edgeIndex].FrontierIndex = newFrontierId;
+
+            edgeIndex = mFrontierEdges[edgeIndex].NextEdgeIndex;
+
+        } while (edgeIndex != startingEdgeIndex);
+
+        mCompactedFrontiers.emplace_back(frontier);
+    }
+
+    assert(mCompactedFrontiers.size() == mFrontierIds.size());
+
+    std::swap(mFrontiers, mCompactedFrontiers);
+
+    mMergedIntoFrontierIds.assign(mFrontiers.size(), NoneFrontierId);
+
+    std::iota(mFrontierIds.begin(), mFrontierIds.end(), FrontierId(0));
+
+    mFrontierIdPositions.resize(mFrontiers.size());
+    std::iota(mFrontierIdPositions.begin(), mFrontierIdPositions.end(), size_t(0));
+}
+
 void Frontiers::Upload(
     ShipId shipId,
     Render::RenderContext & renderContext)
@@ -614,39 +667,38 @@ void Frontiers::Upload(
         auto & shipRenderContext = renderContext.GetShipRenderContext(shipId);
 
         size_t const totalSize = std::accumulate(
-            mFrontiers.cbegin(),
-            mFrontiers.cend(),
+            mFrontierIds.cbegin(),
+            mFrontierIds.cend(),
             size_t(0),
-            [](size_t total, auto const & f)
+            [this](size_t total, FrontierId frontierId)
             {
-                return total + (f.has_value() ? f->Size : 0);
+                return total + mFrontiers[frontierId]->Size;
             });
 
         shipRenderContext.UploadElementFrontierEdgesStart(totalSize);
 
-        for (auto const & frontier : mFrontiers)
+        for (FrontierId const frontierId : mFrontierIds)
         {
-            if (frontier.has_value())
-            {
-                assert(frontier->Size > 0);
+            auto const & frontier = *mFrontiers[frontierId];
 
-                ElementIndex const startingEdgeIndex = frontier->StartingEdgeIndex;
-                ElementIndex edgeIndex = startingEdgeIndex;
+            assert(frontier.Size > 0);
 
-                do
-                {
-                    auto const nextEdgeIndex = mFrontierEdges[edgeIndex].NextEdgeIndex;
+            ElementIndex const startingEdgeIndex = frontier.StartingEdgeIndex;
+            ElementIndex edgeIndex = startingEdgeIndex;
 
-                    // Upload
-                    shipRenderContext.UploadElementFrontierEdge(
-                        mFrontierEdges[edgeIndex].PointAIndex,
-                        mFrontierEdges[nextEdgeIndex].PointAIndex);
+            do
+            {
+                auto const nextEdgeIndex = mFrontierEdges[edgeIndex].NextEdgeIndex;
 
-                    // Advance
-                    edgeIndex = nextEdgeIndex;
+                // Upload
+                shipRenderContext.UploadElementFrontierEdge(
+                    mFrontierEdges[edgeIndex].PointAIndex,
+                    mFrontierEdges[nextEdgeIndex].PointAIndex);
 
-                } while (edgeIndex != startingEdgeIndex);
-            }
+                // Advance
+                edgeIndex = nextEdgeIndex;
+
+            } while (edgeIndex != startingEdgeIndex);
         }
 
         shipRenderContext.UploadElementFrontierEdgesEnd();
@@ -663,24 +715,20 @@ FrontierId Frontiers::CreateNewFrontier(
     ElementIndex startingEdgeIndex,
     ElementCount size)
 {
-    // Check if we may find an unused slot
-    FrontierId newFrontierId;
-    for (newFrontierId = 0; newFrontierId < mFrontiers.size() && mFrontiers[newFrontierId].has_value(); ++newFrontierId);
+    // Always create a new slot; unused slots are only recycled
+    // at compaction, as edges might still refer to them
+    FrontierId const newFrontierId = static_cast<FrontierId>(mFrontiers.size());
 
-    if (newFrontierId == mFrontiers.size())
-    {
-        // Create new slot
-        mFrontiers.emplace_back();
-    }
-
-    assert(newFrontierId < mFrontiers.size());
-
-    mFrontiers[newFrontierId].emplace(
+    mFrontiers.emplace_back(
+        std::in_place,
         type,
         startingEdgeIndex,
         size);
 
+    mMergedIntoFrontierIds.emplace_back(NoneFrontierId);
+
     // Add to frontier indices
+    mFrontierIdPositions.emplace_back(mFrontierIds.size());
     mFrontierIds.emplace_back(newFrontierId);
 
     return newFrontierId;
@@ -694,16 +742,59 @@ void Frontiers::DestroyFrontier(
 
     mFrontiers[frontierId].reset();
 
-    // Remove from frontier indices
+    // Remove from frontier indices, moving the last one in its place
+
+    size_t const position = mFrontierIdPositions[frontierId];
+    assert(position < mFrontierIds.size() && mFrontierIds[position] == frontierId);
+
+    mFrontierIds[position] = mFrontierIds.back();
+    mFrontierIdPositions[mFrontierIds[position]] = position;
+    mFrontierIds.pop_back();
+}
+
+FrontierId Frontiers::SplitShorterIntoNewFrontier(
+    ElementIndex const regionStartEdgeIndex,
+    ElementIndex const regionEndEdgeIndex,
+    FrontierId const oldFrontierId,
+    FrontierType const newFrontierType,
+    ElementIndex const cutEdgeIn,
+    ElementIndex const cutEdgeOut)
+{
+    //
+    // The frontier consists of the region (start->end) and of the rest of the
+    // frontier (cutOut->cutIn); we split off whichever of the two is shorter,
+    // finding out which one by walking both of them at the same time
+    //
 
-    auto const indexIt = std::find(
-        mFrontierIds.cbegin(),
-        mFrontierIds.cend(),
-        frontierId);
+    for (ElementIndex regionEdgeIndex = regionStartEdgeIndex, restEdgeIndex = cutEdgeOut; ;)
+    {
+        if (regionEdgeIndex == regionEndEdgeIndex)
+        {
+            // The region is shorter
+            return SplitIntoNewFrontier(
+                regionStartEdgeIndex,
+                regionEndEdgeIndex,
+                oldFrontierId,
+                newFrontierType,
+                cutEdgeIn,
+                cutEdgeOut);
+        }
 
-    assert(indexIt != mFrontierIds.cend());
+        if (restEdgeIndex == cutEdgeIn)
+        {
+            // The rest is shorter
+            return SplitIntoNewFrontier(
+                cutEdgeOut,
+                cutEdgeIn,
+                oldFrontierId,
+                newFrontierType,
+                regionEndEdgeIndex,
+                regionStartEdgeIndex);
+        }
 
-    mFrontierIds.erase(indexIt);
+        regionEdgeIndex = mFrontierEdges[regionEdgeIndex].NextEdgeIndex;
+        restEdgeIndex = mFrontierEdges[restEdgeIndex].NextEdgeIndex;
+    }
 }
 
 FrontierId Frontiers::SplitIntoNewFrontier(
@@ -715,8 +806,8 @@ FrontierId Frontiers::SplitIntoNewFrontier(
     ElementIndex const cutEdgeOut)
 {
     // Start and end currently belong to the old frontier
-    assert(mEdges[newFrontierStartEdgeIndex].FrontierIndex == oldFrontierId);
-    assert(mEdges[newFrontierEndEdgeIndex].FrontierIndex == oldFrontierId);
+    assert(GetEdgeFrontierId(newFrontierStartEdgeIndex) == oldFrontierId);
+    assert(GetEdgeFrontierId(newFrontierEndEdgeIndex) == oldFrontierId);
 
     //
     // New frontier
@@ -769,19 +860,16 @@ void Frontiers::ReplaceAndCutFrontier(
     assert(oldFrontierId != newFrontierId);
 
     // Start and end currently belong to the old frontier
-    assert(mEdges[startEdgeIndex].FrontierIndex == oldFrontierId);
-    assert(mEdges[endEdgeIndex].FrontierIndex == oldFrontierId);
+    assert(GetEdgeFrontierId(startEdgeIndex) == oldFrontierId);
+    assert(GetEdgeFrontierId(endEdgeIndex) == oldFrontierId);
+
+    (void)startEdgeIndex;
+    (void)endEdgeIndex;
 
     // Edges on the opposite (non-triangle) side of cusp
     ElementIndex const afterEdgeIn = mFrontierEdges[cutEdgeIn].NextEdgeIndex;
     ElementIndex const beforeEdgeOut = mFrontierEdges[cutEdgeOut].PrevEdgeIndex;
 
-    // Propagate new frontier along the old frontier
-    ElementCount const oldFrontierSize = PropagateFrontier(
-        startEdgeIndex,
-        endEdgeIndex,
-        newFrontierId);
-
     // Cut: connect edges at triangle's side of cusp among themselves
     mFrontierEdges[cutEdgeIn].NextEdgeIndex = cutEdgeOut;
     mFrontierEdges[cutEdgeOut].PrevEdgeIndex = cutEdgeIn;
@@ -790,13 +878,8 @@ void Frontiers::ReplaceAndCutFrontier(
     mFrontierEdges[afterEdgeIn].PrevEdgeIndex = beforeEdgeOut;
     mFrontierEdges[beforeEdgeOut].NextEdgeIndex = afterEdgeIn;
 
-    // Update new frontier
-    mFrontiers[newFrontierId]->Size += oldFrontierSize;
-
-    // Destroy old frontier
-    assert(oldFrontierSize == mFrontiers[oldFrontierId]->Size);
-    mFrontiers[oldFrontierId]->Size -= oldFrontierSize;
-    DestroyFrontier(oldFrontierId);
+    // Merge old frontier into new frontier
+    MergeFrontier(oldFrontierId, newFrontierId);
 }
 
 void Frontiers::ReplaceAndJoinFrontier(
@@ -811,19 +894,13 @@ void Frontiers::ReplaceAndJoinFrontier(
     assert(oldFrontierId != newFrontierId);
 
     // Start and end currently belong to the old frontier
-    assert(mEdges[edgeInOpposite].FrontierIndex == oldFrontierId);
-    assert(mEdges[edgeOutOpposite].FrontierIndex == oldFrontierId);
+    assert(GetEdgeFrontierId(edgeInOpposite) == oldFrontierId);
+    assert(GetEdgeFrontierId(edgeOutOpposite) == oldFrontierId);
 
     // EdgeIn and EdgeOut are currently connected to each other
     assert(mFrontierEdges[edgeIn].NextEdgeIndex == edgeOut);
     assert(mFrontierEdges[edgeOut].PrevEdgeIndex == edgeIn);
 
-    // Propagate new frontier along the old frontier
-    ElementCount const oldFrontierSize = PropagateFrontier(
-        edgeInOpposite,
-        edgeOutOpposite,
-        newFrontierId);
-
     // Connect EdgeIn->EdgeInOpposite
     mFrontierEdges[edgeIn].NextEdgeIndex = edgeInOpposite;
     mFrontierEdges[edgeInOpposite].PrevEdgeIndex = edgeIn;
@@ -832,13 +909,28 @@ void Frontiers::ReplaceAndJoinFrontier(
     mFrontierEdges[edgeOutOpposite].NextEdgeIndex = edgeOut;
     mFrontierEdges[edgeOut].PrevEdgeIndex = edgeOutOpposite;
 
+    // Merge old frontier into new frontier
+    MergeFrontier(oldFrontierId, newFrontierId);
+}
+
+void Frontiers::MergeFrontier(
+    FrontierId const oldFrontierId,
+    FrontierId const newFrontierId)
+{
+    //
+    // Rather than relabeling the old frontier's edges now, we forward
+    // the old frontier's ID to the new frontier; edges are relabeled
+    // when visited, or at the latest at compaction
+    //
+
     // Update new frontier
-    mFrontiers[newFrontierId]->Size += oldFrontierSize;
+    mFrontiers[newFrontierId]->Size += mFrontiers[oldFrontierId]->Size;
 
     // Destroy old frontier
-    assert(oldFrontierSize == mFrontiers[oldFrontierId]->Size);
-    mFrontiers[oldFrontierId]->Size -= oldFrontierSize;
+    mFrontiers[oldFrontierId]->Size = 0;
     DestroyFrontier(oldFrontierId);
+
+    mMergedIntoFrontierIds[oldFrontierId] = newFrontierId;
 }
 
 ElementCount Frontiers::PropagateFrontier(
@@ -884,11 +976,11 @@ inline bool Frontiers::ProcessTriangleCuspDestroy(
     // We only care about cusps - i.e. with frontiers on both edges
     //
 
-    FrontierId const frontierInId = mEdges[edgeIn].FrontierIndex;
+    FrontierId const frontierInId = GetEdgeFrontierId(edgeIn);
     if (frontierInId == NoneFrontierId)
         return false;
 
-    FrontierId const frontierOutId = mEdges[edgeOut].FrontierIndex;
+    FrontierId const frontierOutId = GetEdgeFrontierId(edgeOut);
     if (frontierOutId == NoneFrontierId)
         return false;
 
@@ -939,12 +1031,12 @@ inline bool Frontiers::ProcessTriangleCuspDestroy(
                 // After coming into the cusp from edge1, the external frontier travels around
                 // a region before returning back to the cusp and then away through edge2...
                 //
-                // ...quite arbitrarily, we decide that that region's frontier then becomes a
-                // new external frontier (we could have chosen instead that that region's frontier
-                // stays and the other portion becomes the new frontier)
+                // ...it's arbitrary whether that region's frontier becomes a new external frontier
+                // or stays while the other portion becomes the new frontier, so for performance
+                // we split off the shorter of the two
                 //
 
-                SplitIntoNewFrontier(
+                SplitShorterIntoNewFrontier(
                     mFrontierEdges[edgeIn].NextEdgeIndex,
                     mFrontierEdges[edgeOut].PrevEdgeIndex,
                     frontierInId,
@@ -1045,21 +1137,20 @@ inline bool Frontiers::ProcessTriangleCuspDestroy(
                 // a clockwise frontier.
                 //
 
-                // Start by splitting here, arbitrarily making the other one an internal frontier for the moment
-                auto const newRegionStartEdgeIndex = mFrontierEdges[edgeIn].NextEdgeIndex;
-                auto const newRegionEndEdgeIndex = mFrontierEdges[edgeOut].PrevEdgeIndex;
-                FrontierId const newFrontierId = SplitIntoNewFrontier(
-                    newRegionStartEdgeIndex,
-                    newRegionEndEdgeIndex,
+                // Start by splitting off the shorter of the two, arbitrarily making it an internal frontier for the moment
+                FrontierId const newFrontierId = SplitShorterIntoNewFrontier(
+                    mFrontierEdges[edgeIn].NextEdgeIndex,
+                    mFrontierEdges[edgeOut].PrevEdgeIndex,
                     frontierInId,
                     FrontierType::Internal,
                     edgeIn,
                     edgeOut);
 
                 // Now check whether the new region is counter-clockwise
+                ElementIndex const newRegionStartEdgeIndex = mFrontiers[newFrontierId]->StartingEdgeIndex;
                 if (IsCounterClockwiseFrontier(
                     newRegionStartEdgeIndex,
-                    newRegionEndEdgeIndex,
+                    mFrontierEdges[newRegionStartEdgeIndex].PrevEdgeIndex,
                     points))
                 {
                     // The new frontier is counter-clockwise,
@@ -1088,7 +1179,8 @@ inline bool Frontiers::ProcessTriangleCuspDestroy(
             // Here we have two lobes inside a ship which will become one single, internal lobe
             //
             // It really is arbitrary which of the two frontiers takes over the other, so
-            // for performance we let the longer take over the shorter
+            // for performance we let the longer take over the shorter - leaving fewer edges
+            // with the ID of a merged frontier
             //
 
             if (mFrontiers[frontierInId]->Size >= mFrontiers[frontierOutId]->Size)
@@ -1126,7 +1218,7 @@ inline void Frontiers::ProcessTriangleOppositeCuspEdgeDestroy(
     ElementIndex const cuspEdgeIn,
     ElementIndex const cuspEdgeOut)
 {
-    assert(mEdges[edge].FrontierIndex == NoneFrontierId);
+    assert(GetEdgeFrontierId(edge) == NoneFrontierId);
     assert(mFrontierEdges[cuspEdgeIn].NextEdgeIndex == cuspEdgeOut); // In is connected to Out
     assert(mFrontierEdges[cuspEdgeOut].PrevEdgeIndex == cuspEdgeIn); // In is connected to Out
 
@@ -1137,8 +1229,8 @@ inline void Frontiers::ProcessTriangleOppositeCuspEdgeDestroy(
     mFrontierEdges[edge].NextEdgeIndex = mFrontierEdges[cuspEdgeOut].NextEdgeIndex;
     mFrontierEdges[mFrontierEdges[cuspEdgeOut].NextEdgeIndex].PrevEdgeIndex = edge;
 
-    assert(mEdges[cuspEdgeIn].FrontierIndex == mEdges[cuspEdgeOut].FrontierIndex); // Cusp edges' frontier is the same, by now
-    auto const frontierId = mEdges[cuspEdgeIn].FrontierIndex;
+    assert(GetEdgeFrontierId(cuspEdgeIn) == GetEdgeFrontierId(cuspEdgeOut)); // Cusp edges' frontier is the same, by now
+    auto const frontierId = GetEdgeFrontierId(cuspEdgeIn);
     mEdges[edge].FrontierIndex = frontierId;
 
     // Clear cusp edges
@@ -1192,7 +1284,7 @@ inline std::tuple<ElementIndex, ElementIndex> Frontiers::FindTriangleCuspOpposit
     {
         if (cs.SpringIndex != edgeIn
             && cs.SpringIndex != edgeOut
-            && mEdges[cs.SpringIndex].FrontierIndex != NoneFrontierId)
+            && GetEdgeFrontierId(cs.SpringIndex) != NoneFrontierId)
         {
             Octant octant = springs.GetFactoryEndpointOctant(cs.SpringIndex, cuspPointIndex);
             if (octant < edgeOutOctant)
@@ -1245,7 +1337,7 @@ inline bool Frontiers::ProcessTriangleCuspRestore(
     // Either the cusp edges have no frontier, or they already have a frontier
     // (propagated because of an edge or a preceding cusp), in which case it's the same
     // frontier
-    assert(mEdges[edgeIn].FrontierIndex == mEdges[edgeOut].FrontierIndex);
+    assert(GetEdgeFrontierId(edgeIn) == GetEdgeFrontierId(edgeOut));
 
     //
     // Here we pretend to attach the cusp to an (eventual) frontier in front of it,
@@ -1282,12 +1374,12 @@ inline bool Frontiers::ProcessTriangleCuspRestore(
     // 2) Propagate frontiers
     //
 
-    FrontierId const triangleFrontierId = mEdges[edgeIn].FrontierIndex;
-    assert(mEdges[edgeOut].FrontierIndex == triangleFrontierId);
+    FrontierId const triangleFrontierId = GetEdgeFrontierId(edgeIn);
+    assert(GetEdgeFrontierId(edgeOut) == triangleFrontierId);
 
-    FrontierId const oppositeFrontierId = mEdges[edgeInOpposite].FrontierIndex;
+    FrontierId const oppositeFrontierId = GetEdgeFrontierId(edgeInOpposite);
     assert(oppositeFrontierId != NoneElementIndex);
-    assert(mEdges[edgeOutOpposite].FrontierIndex == oppositeFrontierId);
+    assert(GetEdgeFrontierId(edgeOutOpposite) == oppositeFrontierId);
 
     if (triangleFrontierId == NoneElementIndex)
     {
@@ -1342,7 +1434,7 @@ inline bool Frontiers::ProcessTriangleCuspRestore(
         assert(mFrontierEdges[edgeIn].NextEdgeIndex == edgeOut && mFrontierEdges[edgeOut].PrevEdgeIndex == edgeIn);
 
         // ...and obviously the same ID along the edges...
-        assert(mEdges[edgeIn].FrontierIndex == mEdges[edgeOut].FrontierIndex);
+        assert(GetEdgeFrontierId(edgeIn) == GetEdgeFrontierId(edgeOut));
 
         //
         // ...check all cases
@@ -1359,10 +1451,11 @@ inline bool Frontiers::ProcessTriangleCuspRestore(
             {
                 //
                 // Triangle and cusp belong to same internal frontier...
-                // ...the cusp joining separates that into *two* internal frontiers
+                // ...the cusp joining separates that into *two* internal frontiers,
+                // the shorter of which becomes the new one
                 //
 
-                SplitIntoNewFrontier(
+                SplitShorterIntoNewFrontier(
                     edgeInOpposite,
                     edgeIn,
                     triangleFrontierId,
@@ -1505,7 +1598,7 @@ bool Frontiers::IsCounterClockwiseFrontier(
     // (but are *not* necessarily connected)
     assert(mEdges[startEdgeIndex].FrontierIndex != NoneFrontierId
         && mEdges[endEdgeIndex].FrontierIndex != NoneFrontierId
-        && mEdges[startEdgeIndex].FrontierIndex == mEdges[endEdgeIndex].FrontierIndex);
+        && ResolveFrontierId(mEdges[startEdgeIndex].FrontierIndex) == ResolveFrontierId(mEdges[endEdgeIndex].FrontierIndex));
 
     //
     // Sum (x2 − x1) * (y2 + y1) over the edges;
@@ -1564,34 +1657,33 @@ void Frontiers::RegeneratePointColors()
     size_t externalUsed = 0;
     size_t internalUsed = 0;
 
-    for (auto & frontier : mFrontiers)
+    for (FrontierId const frontierId : mFrontierIds)
     {
-        if (frontier.has_value())
-        {
-            //
-            // Propagate color and positional progress for this frontier
-            //
+        auto const & frontier = *mFrontiers[frontierId];
 
-            vec3f const baseColor = (frontier->Type == FrontierType::External)
-                ? ExternalColors[(externalUsed++) % ExternalColors.size()].toVec3f()
-                : InternalColors[(internalUsed++) % InternalColors.size()].toVec3f();
+        //
+        // Propagate color and positional progress for this frontier
+        //
 
-            ElementIndex const startingEdgeIndex = frontier->StartingEdgeIndex;
-            ElementIndex edgeIndex = startingEdgeIndex;
+        vec3f const baseColor = (frontier.Type == FrontierType::External)
+            ? ExternalColors[(externalUsed++) % ExternalColors.size()].toVec3f()
+            : InternalColors[(internalUsed++) % InternalColors.size()].toVec3f();
 
-            float positionalProgress = 0.0f;
+        ElementIndex const startingEdgeIndex = frontier.StartingEdgeIndex;
+        ElementIndex edgeIndex = startingEdgeIndex;
 
-            do
-            {
-                mPointColors[mFrontierEdges[edgeIndex].PointAIndex].frontierBaseColor = baseColor;
-                mPointColors[mFrontierEdges[edgeIndex].PointAIndex].positionalProgress = positionalProgress;
+        float positionalProgress = 0.0f;
 
-                // Advance
-                edgeIndex = mFrontierEdges[edgeIndex].NextEdgeIndex;
-                positionalProgress += 1.0f;
+        do
+        {
+            mPointColors[mFrontierEdges[edgeIndex].PointAIndex].frontierBaseColor = baseColor;
+            mPointColors[mFrontierEdges[edgeIndex].PointAIndex].positionalProgress = positionalProgress;
 
-            } while (edgeIndex != startingEdgeIndex);
-        }
+            // Advance
+            edgeIndex = mFrontierEdges[edgeIndex].NextEdgeIndex;
+            positionalProgress += 1.0f;
+
+        } while (edgeIndex != startingEdgeIndex);
     }
 }
 
@@ -1633,8 +1725,8 @@ void Frontiers::VerifyInvariants(
                         mFrontierEdges[edgeIndex].PointAIndex,
                         mFrontierEdges[mFrontierEdges[edgeIndex].NextEdgeIndex].PointAIndex));
 
-                // Edges know about their frontier
-                Verify(mEdges[edgeIndex].FrontierIndex == frontierIndex);
+                // Edges know about their frontier, eventually via merged frontiers
+                Verify(ResolveFrontierId(mEdges[edgeIndex].FrontierIndex) == frontierIndex);
 
                 // This edge only belongs to one frontier
                 auto const [_, isInserted] = edgesWithFrontiers.insert(edgeIndex);
@@ -1652,11 +1744,9 @@ void Frontiers::VerifyInvariants(
 
             Verify(frontierLen == frontier->Size);
 
-            Verify(
-                std::find(
-                    mFrontierIds.cbegin(),
-                    mFrontierIds.cend(),
-                    frontierIndex) != mFrontierIds.cend());
+            Verify(mMergedIntoFrontierIds[frontierIndex] == NoneFrontierId);
+
+            Verify(mFrontierIds[mFrontierIdPositions[frontierIndex]] == frontierIndex);
 
             if (frontier->Type == FrontierType::External)
             {
@@ -1691,6 +1781,9 @@ void Frontiers::VerifyInvariants(
     // Frontier IDs
     //
 
+    Verify(mMergedIntoFrontierIds.size() == mFrontiers.size());
+    Verify(mFrontierIdPositions.size() == mFrontiers.size());
+
     for (auto frontierId : mFrontierIds)
     {
         Verify(frontierId < mFrontiers.size());
@@ -12,6 +12,7 @@
 #include <GameCore/AABB.h>
 #include <GameCore/Buffer.h>
 
+#include <algorithm>
 #include <array>
 #include <optional>
 #include <vector>
@@ -25,6 +26,12 @@ namespace Physics
  * This class is initialized with external and internal frontiers detected during the ship
  * load process. After that, it maintains frontiers each time a triangle is destructed or
  * restored.
+ *
+ * When a frontier gets merged into another one, its edges are not relabeled right away;
+ * rather, the merged frontier's ID is forwarded to the ID of the frontier it has been merged
+ * into. Edges are relabeled - and frontier slots compacted - in one pass at Compact(), which
+ * the ship invokes after a simulation step's triangle changes, once enough slots have been
+ * freed to make the pass worth it.
  */
 class Frontiers
 {
@@ -75,7 +82,10 @@ public:
         , mEdges(mEdgeCount, 0, Edge())
         , mFrontierEdges(mEdgeCount, 0, FrontierEdge())
         , mFrontiers()
+        , mMergedIntoFrontierIds()
         , mFrontierIds()
+        , mFrontierIdPositions()
+        , mCompactedFrontiers()
         , mPointColors(pointCount, 0, Render::FrontierColor(vec3f::zero(), 0.0f))
         , mCurrentVisitSequenceNumber()
         , mIsDirtyForRendering(true)
@@ -106,6 +116,26 @@ public:
         Springs const & springs,
         Triangles const & triangles);
 
+    /*
+     * Relabels the edges of the frontiers that have been merged into other frontiers,
+     * and renumbers frontiers so that they occupy contiguous slots, keeping their order.
+     *
+     * Frontier IDs are not stable across invocations of this method.
+     */
+    void Compact();
+
+    /*
+     * Whether merges and removals have freed enough frontier slots to make it worth to
+     * Compact(); until then, the cost of holes is in longer walks of the slot vector
+     * and of the chains of merged frontier IDs.
+     */
+    inline bool IsCompactionWorthwhile() const
+    {
+        assert(mFrontiers.size() >= mFrontierIds.size());
+        size_t const freeSlotCount = mFrontiers.size() - mFrontierIds.size();
+        return freeSlotCount >= std::max(mFrontierIds.size(), MinFreeSlotsForCompaction);
+    }
+
     void Upload(
         ShipId shipId,
         Render::RenderContext & renderContext);
@@ -200,7 +230,41 @@ private:
     void DestroyFrontier(
         FrontierId frontierId);
 
-    inline FrontierId SplitIntoNewFrontier(
+    // The ID of the frontier that the edge belongs to, resolving - and remembering -
+    // eventual merges
+    inline FrontierId GetEdgeFrontierId(ElementIndex edgeIndex)
+    {
+        FrontierId frontierId = mEdges[edgeIndex].FrontierIndex;
+        if (frontierId != NoneFrontierId
+            && mMergedIntoFrontierIds[frontierId] != NoneFrontierId)
+        {
+            frontierId = ResolveFrontierId(frontierId);
+            mEdges[edgeIndex].FrontierIndex = frontierId;
+        }
+
+        return frontierId;
+    }
+
+    inline FrontierId ResolveFrontierId(FrontierId frontierId) const
+    {
+        while (frontierId != NoneFrontierId
+            && mMergedIntoFrontierIds[frontierId] != NoneFrontierId)
+        {
+            frontierId = mMergedIntoFrontierIds[frontierId];
+        }
+
+        return frontierId;
+    }
+
+    FrontierId SplitShorterIntoNewFrontier(
+        ElementIndex const regionStartEdgeIndex,
+        ElementIndex const regionEndEdgeIndex,
+        FrontierId const oldFrontierId,
+        FrontierType const newFrontierType,
+        ElementIndex const edgeIn,
+        ElementIndex const edgeOut);
+
+    FrontierId SplitIntoNewFrontier(
         ElementIndex const newFrontierStartEdgeIndex,
         ElementIndex const newFrontierEndEdgeIndex,
         FrontierId const oldFrontierId,
@@ -216,7 +280,7 @@ private:
         ElementIndex const edgeIn,
         ElementIndex const edgeOut);
 
-    inline void ReplaceAndJoinFrontier(
+    void ReplaceAndJoinFrontier(
         ElementIndex const edgeIn,
         ElementIndex const edgeInOpposite,
         ElementIndex const edgeOutOpposite,
@@ -224,6 +288,10 @@ private:
         FrontierId const oldFrontierId,
         FrontierId const newFrontierId);
 
+    inline void MergeFrontier(
+        FrontierId const oldFrontierId,
+        FrontierId const newFrontierId);
+
     inline ElementCount PropagateFrontier(
         ElementIndex const startEdgeIndex,
         ElementIndex const endEdgeIndex,
@@ -266,6 +334,9 @@ private:
 
 private:
 
+    // The number of free frontier slots below which we do not bother compacting
+    static size_t constexpr MinFreeSlotsForCompaction = 64;
+
     // The total number of edges (elements, not buffer)
     size_t const mEdgeCount;
 
@@ -279,15 +350,29 @@ private:
     Buffer<FrontierEdge> mFrontierEdges;
 
     // The frontiers, indexed by frontier indices.
-    // Elements in this vector do not move around, hence
-    // elements are not contiguous.
+    // Elements in this vector only move around at Compact(),
+    // hence between compactions elements are not contiguous.
     // Cardinality: any.
     std::vector<std::optional<Frontier>> mFrontiers;
 
+    // For each slot in the Frontiers vector, the ID of the frontier
+    // that the slot's frontier has been merged into, if any.
+    // Slots of merged frontiers are only re-used after Compact().
+    // Cardinality: same as Frontiers vector
+    std::vector<FrontierId> mMergedIntoFrontierIds;
+
     // The indices in the Frontiers vector, all
     // contiguous and compact
     std::vector<FrontierId> mFrontierIds;
 
+    // For each slot in the Frontiers vector, the position of the
+    // slot's frontier in the Frontier IDs vector.
+    // Cardinality: same as Frontiers vector
+    std::vector<size_t> mFrontierIdPositions;
+
+    // Scratch buffer for compaction
+    std::vector<std::optional<Frontier>> mCompactedFrontiers;
+
     // Frontier coloring info.
     // Cardinality: points
     Buffer<Render::FrontierColor> mPointColors;
@@ -297,6 +382,10 @@ private:
     SequenceNumber mCurrentVisitSequenceNumber;
 
     bool mIsDirtyForRendering; // When true, a change has occurred and thus all frontiers need to be re-uploaded
+
+private:
+
+    friend class FrontiersTests;
 };
 
 }
@@ -8,6 +8,7 @@
 #include "ComputerCalibration.h"
 #include "ShipDeSerializer.h"
 
+#include <GameCore/GameException.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
 
@@ -76,12 +77,31 @@ GameController::GameController(
     // Ship factory
     , mShipStrengthRandomizer()
     , mShipTexturizer(mMaterialDatabase, resourceLocator)
+    , mAsyncShipLoader(mMaterialDatabase, resourceLocator)
     // State
     , mGameParameters()
     , mIsFrozen(false)
     , mIsPaused(false)
     , mIsPulseUpdateSet(false)
     , mIsMoveToolEngaged(false)
+    , mIsFastForward(false)
+    // Simulation thread
+    , mSimulationThread()
+    , mMainThreadRandomEngine()
+    , mWorldLock()
+    , mWorldCommandsLock()
+    , mWorldCommands()
+    , mRunningWorldCommands()
+    , mSimulationGameParameters()
+    , mSimulationVisibleWorld()
+    , mSimulationStressRenderMode(StressRenderModeType::None)
+    , mSimulationDoUpdate(false)
+    , mSimulationIsPulseUpdateSet(false)
+    , mSimulationIsFastForward(false)
+    , mSimulationThreadError()
+    , mSimulationThreadStopLock()
+    , mSimulationThreadStopSignal()
+    , mIsSimulationThreadStop(false)
     // Parameters that we own
     , mTimeOfDay(0.0f) // We'll set it later
     , mDoShowTsunamiNotifications(true)
@@ -105,12 +125,19 @@ GameController::GameController(
     // Stats
     , mStatsOriginTimestampReal(std::chrono::steady_clock::time_point::min())
     , mStatsLastTimestampReal(std::chrono::steady_clock::time_point::min())
+    , mStatsLastSimulationTime(0.0f)
     , mOriginTimestampGame(GameWallClock::GetInstance().Now())
     , mTotalPerfStats(std::move(perfStats))
     , mLastPublishedTotalPerfStats()
     , mTotalFrameCount(0u)
     , mLastPublishedTotalFrameCount(0u)
     , mSkippedFirstStatPublishes(0)
+    // Telemetry
+    , mTelemetrySink()
+    , mTelemetryStepIndex(0u)
+    , mTelemetryStepStartTime()
+    , mTelemetryStepStartPerfStats()
+    , mTelemetryStepStartThreadPoolIdleDuration(GameChronometer::duration::zero())
 {
     // Initialize time-of-day
     SetTimeOfDay(1.0f);
@@ -253,6 +280,11 @@ GameController::GameController(
 GameController::~GameController()
 {
     LogMessage("GameController::~GameController()");
+
+    if (mSimulationThread.joinable())
+    {
+        StopSimulationThread();
+    }
 }
 
 void GameController::RebindOpenGLContext()
@@ -273,6 +305,8 @@ ShipMetadata GameController::ResetAndReloadShip(ShipLoadSpecifications const & l
 
 ShipMetadata GameController::AddShip(ShipLoadSpecifications const & loadSpecs)
 {
+    auto const worldLock = LockWorldForInteraction();
+
     // Load ship definition
     auto shipDefinition = ShipDeSerializer::LoadShip(loadSpecs.DefinitionFilepath, mMaterialDatabase);
 
@@ -296,9 +330,11 @@ ShipMetadata GameController::AddShip(ShipLoadSpecifications const & loadSpecs)
         loadSpecs.LoadOptions,
         mMaterialDatabase,
         mShipTexturizer,
+        mThreadManager.GetSimulationThreadPool(),
         mShipStrengthRandomizer,
         mGameEventDispatcher,
-        mGameParameters);
+        mGameParameters,
+        [](float, ProgressMessageType) {});
 
     //
     // No errors, so we may continue
@@ -312,6 +348,39 @@ ShipMetadata GameController::AddShip(ShipLoadSpecifications const & loadSpecs)
     return shipMetadata;
 }
 
+void GameController::BeginResetAndLoadShip(
+    ShipLoadSpecifications const & loadSpecs,
+    ProgressCallback const & progressCallback)
+{
+    mAsyncShipLoader.Start(
+        loadSpecs,
+        MakeNewWorld(),
+        mGameEventDispatcher,
+        mGameParameters,
+        mShipStrengthRandomizer,
+        mShipTexturizer.GetSharedSettings(),
+        mShipTexturizer.GetDoForceSharedSettingsOntoShipSettings(),
+        progressCallback);
+}
+
+bool GameController::PollShipLoad()
+{
+    return mAsyncShipLoader.Poll();
+}
+
+ShipMetadata GameController::EndResetAndLoadShip()
+{
+    // Throws if the load has failed
+    auto loadedShip = mAsyncShipLoader.TakeResult();
+
+    return InternalResetAndAddShip(std::move(loadedShip));
+}
+
+void GameController::CancelShipLoad()
+{
+    mAsyncShipLoader.Cancel();
+}
+
 RgbImageData GameController::TakeScreenshot()
 {
     return mRenderContext->TakeScreenshot();
@@ -329,10 +398,13 @@ void GameController::RunGameIteration()
     {
         assert(mStatsLastTimestampReal == std::chrono::steady_clock::time_point::min());
 
+        auto const worldLock = LockWorld();
+
         std::chrono::steady_clock::time_point const nowReal = std::chrono::steady_clock::now();
 
         mStatsOriginTimestampReal = nowReal;
         mStatsLastTimestampReal = nowReal;
+        mStatsLastSimulationTime = mWorld->GetCurrentSimulationTime();
 
         // In order to start from zero at first render, take global origin here
         mOriginTimestampGame = GameWallClock::GetInstance().Now();
@@ -349,9 +421,72 @@ void GameController::RunGameIteration()
     bool const doUpdate = ((!mIsPaused || mIsPulseUpdateSet) && !mIsMoveToolEngaged);
 
     // Clear pulse
+    bool const isPulseUpdateSet = mIsPulseUpdateSet;
     mIsPulseUpdateSet = false;
 
-    if (doUpdate)
+    // When the simulation is threaded, we hold the world lock until the world has been
+    // uploaded, so that what we upload is a completed step
+    std::unique_lock<std::recursive_mutex> worldLock;
+
+    if (mSimulationThread.joinable())
+    {
+        worldLock = LockWorld();
+
+        if (mSimulationThreadError.has_value())
+        {
+            std::string const errorMessage = *mSimulationThreadError;
+            mSimulationThreadError.reset();
+
+            throw GameException(errorMessage);
+        }
+
+        // Tell RenderContext we're starting an update
+        mRenderContext->UpdateStart();
+
+        float const nowGame = GameWallClock::GetInstance().NowAsFloat();
+
+        //
+        // Update parameter smoothers
+        //
+
+        std::for_each(
+            mFloatParameterSmoothers.begin(),
+            mFloatParameterSmoothers.end(),
+            [](auto & ps)
+            {
+                ps.Update();
+            });
+
+        //
+        // Publish what the simulation thread steps with
+        //
+
+        mSimulationGameParameters = mGameParameters;
+        mSimulationVisibleWorld = mRenderContext->GetVisibleWorld();
+        mSimulationStressRenderMode = mRenderContext->GetStressRenderMode();
+        mSimulationDoUpdate = (!mIsPaused && !mIsMoveToolEngaged);
+        mSimulationIsPulseUpdateSet = mSimulationIsPulseUpdateSet || (isPulseUpdateSet && !mIsMoveToolEngaged);
+        mSimulationIsFastForward = mIsFastForward;
+
+        // Update state machines - at our pace, as they drive rendering and notifications
+        UpdateAllStateMachines(mWorld->GetCurrentSimulationTime());
+
+        // Flush events - those of all the steps completed since the last frame
+        mGameEventDispatcher->Flush();
+
+        //
+        // Update misc
+        //
+
+        // Update notification layer
+        mNotificationLayer.Update(nowGame);
+
+        // Tell RenderContext we've finished an update
+        mRenderContext->UpdateEnd();
+
+        // Note: the simulation thread measures the update durations
+    }
+    else if (doUpdate)
     {
         auto const startTime = GameChronometer::now();
 
@@ -376,27 +511,53 @@ void GameController::RunGameIteration()
             });
 
         //
-        // Update world
+        // Update world - once, or, when fast-forwarding, for as many steps as
+        // we estimate to fit in the frame's update budget
         //
 
+        size_t const maxStepCount = (mIsFastForward && !mIsPaused)
+            ? MaxFastForwardStepsPerFrame
+            : 1;
+
+        auto const updateBudgetEndTime = netStartTime + std::chrono::duration_cast<GameChronometer::duration>(
+            std::chrono::duration<float>(GameParameters::SimulationStepTimeDuration<float> * FastForwardUpdateBudgetFraction));
+
         assert(!!mWorld);
-        mWorld->Update(
-            mGameParameters,
-            mRenderContext->GetVisibleWorld(),
-            mRenderContext->GetStressRenderMode(),
-            mThreadManager,
-            *mTotalPerfStats);
 
-        // Flush events
+        for (size_t step = 1; ; ++step)
+        {
+            auto const stepStartTime = GameChronometer::now();
+
+            BeginTelemetryStep();
+
+            mWorld->Update(
+                mGameParameters,
+                mRenderContext->GetVisibleWorld(),
+                mRenderContext->GetStressRenderMode(),
+                mThreadManager,
+                *mTotalPerfStats);
+
+            EndTelemetryStep();
+
+            // Update state machines
+            UpdateAllStateMachines(mWorld->GetCurrentSimulationTime());
+
+            // Stop if another step - assuming it takes as long as this one - would exceed the budget
+            auto const stepEndTime = GameChronometer::now();
+            if (step >= maxStepCount
+                || stepEndTime + (stepEndTime - stepStartTime) > updateBudgetEndTime)
+            {
+                break;
+            }
+        }
+
+        // Flush events - once per frame, with the events of all of the frame's steps
         mGameEventDispatcher->Flush();
 
         //
         // Update misc
         //
 
-        // Update state machines
-        UpdateAllStateMachines(mWorld->GetCurrentSimulationTime());
-
         // Update notification layer
         mNotificationLayer.Update(nowGame);
 
@@ -442,6 +603,15 @@ void GameController::RunGameIteration()
 
         mRenderContext->UploadEnd();
 
+        if (worldLock.owns_lock())
+        {
+            // Wait for the upload to complete before letting the simulation
+            // thread touch the buffers we've uploaded from
+            mRenderContext->UpdateStart();
+
+            worldLock.unlock();
+        }
+
         mTotalPerfStats->TotalNetRenderUploadDuration.Update(GameChronometer::now() - netStartTime);
     }
 
@@ -470,6 +640,9 @@ void GameController::RunGameIteration()
 
 void GameController::LowFrequencyUpdate()
 {
+    // The simulation thread updates the perf stats
+    auto const worldLock = LockWorld();
+
     std::chrono::steady_clock::time_point const nowReal = std::chrono::steady_clock::now();
 
     if (mSkippedFirstStatPublishes >= 1)
@@ -495,6 +668,7 @@ void GameController::LowFrequencyUpdate()
     }
 
     mStatsLastTimestampReal = nowReal;
+    mStatsLastSimulationTime = mWorld->GetCurrentSimulationTime();
 
     mLastPublishedTotalPerfStats = *mTotalPerfStats;
     mLastPublishedTotalFrameCount = mTotalFrameCount;
@@ -502,6 +676,8 @@ void GameController::LowFrequencyUpdate()
 
 void GameController::StartRecordingEvents(std::function<void(uint32_t, RecordedEvent const &)> onEventCallback)
 {
+    auto const worldLock = LockWorldForInteraction();
+
     mEventRecorder = std::make_unique<EventRecorder>(onEventCallback);
 
     mWorld->SetEventRecorder(mEventRecorder.get());
@@ -511,6 +687,8 @@ RecordedEvents GameController::StopRecordingEvents()
 {
     assert(!!mEventRecorder);
 
+    auto const worldLock = LockWorldForInteraction();
+
     mWorld->SetEventRecorder(nullptr);
 
     auto recordedEvents = mEventRecorder->StopRecording();
@@ -521,11 +699,30 @@ RecordedEvents GameController::StopRecordingEvents()
 
 void GameController::ReplayRecordedEvent(RecordedEvent const & event)
 {
+    auto const worldLock = LockWorldForInteraction();
+
     mWorld->ReplayRecordedEvent(
         event,
         mGameParameters); // NOTE: using now's game parameters...but we don't want to capture these in the recorded event (at least at this moment)
 }
 
+void GameController::StartTelemetry(
+    std::filesystem::path const & outputFilePath,
+    TelemetrySink::FormatType format)
+{
+    // Open the new sink before touching the current one, so that on
+    // error we stay as we are
+    auto newTelemetrySink = std::make_unique<TelemetrySink>(outputFilePath, format);
+
+    auto const worldLock = LockWorld();
+
+    mTelemetrySink = std::move(newTelemetrySink);
+    mTelemetryStepIndex = 0;
+
+    // The pool only measures its idle time for us
+    mThreadManager.GetSimulationThreadPool().SetDoTrackIdleDuration(true);
+}
+
 /////////////////////////////////////////////////////////////
 // Interactions
 /////////////////////////////////////////////////////////////
@@ -537,6 +734,15 @@ void GameController::Freeze()
     // Wait for pending render tasks
     mRenderContext->WaitForPendingTasks();
 
+    if (mSimulationThread.joinable())
+    {
+        // Stop stepping until we're thawed and run again
+        auto const worldLock = LockWorld();
+
+        mSimulationDoUpdate = false;
+        mSimulationIsPulseUpdateSet = false;
+    }
+
     // Pause time
     GameWallClock::GetInstance().SetPaused(true);
 
@@ -564,6 +770,32 @@ void GameController::SetPaused(bool isPaused)
     mIsPaused = isPaused;
 }
 
+void GameController::SetFastForward(bool isFastForward)
+{
+    mIsFastForward = isFastForward;
+
+    mNotificationLayer.AddEphemeralTextLine(isFastForward ? "FAST FORWARD ON" : "FAST FORWARD OFF");
+}
+
+void GameController::SetSimulationThreaded(bool isSimulationThreaded)
+{
+    if (isSimulationThreaded == mSimulationThread.joinable())
+    {
+        return;
+    }
+
+    if (isSimulationThreaded)
+    {
+        StartSimulationThread();
+    }
+    else
+    {
+        StopSimulationThread();
+    }
+
+    mNotificationLayer.AddEphemeralTextLine(isSimulationThreaded ? "SIMULATION THREAD ON" : "SIMULATION THREAD OFF");
+}
+
 void GameController::SetMoveToolEngaged(bool isEngaged)
 {
     mIsMoveToolEngaged = isEngaged;
@@ -615,11 +847,15 @@ void GameController::ScareFish(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->ScareFish(
-        worldCoordinates,
-        radius,
-        delay);
+    RunOnWorld(
+        [this, worldCoordinates, radius, delay](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->ScareFish(
+                worldCoordinates,
+                radius,
+                delay);
+        });
 }
 
 void GameController::AttractFish(
@@ -630,11 +866,15 @@ void GameController::AttractFish(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->AttractFish(
-        worldCoordinates,
-        radius,
-        delay);
+    RunOnWorld(
+        [this, worldCoordinates, radius, delay](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->AttractFish(
+                worldCoordinates,
+                radius,
+                delay);
+        });
 }
 
 void GameController::PickObjectToMove(
@@ -643,6 +883,8 @@ void GameController::PickObjectToMove(
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     mWorld->PickPointToMove(
@@ -655,6 +897,8 @@ std::optional<ElementId> GameController::PickObjectForPickAndPull(DisplayLogical
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     return mWorld->PickObjectForPickAndPull(
@@ -669,11 +913,15 @@ void GameController::Pull(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenTarget);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->Pull(
-        elementId,
-        worldCoordinates,
-        mGameParameters);
+    RunOnWorld(
+        [this, elementId, worldCoordinates](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->Pull(
+                elementId,
+                worldCoordinates,
+                gameParameters);
+        });
 }
 
 void GameController::PickObjectToMove(
@@ -682,6 +930,8 @@ void GameController::PickObjectToMove(
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     auto const elementIndex = mWorld->GetNearestPointAt(worldCoordinates, 1.0f);
@@ -700,12 +950,16 @@ void GameController::MoveBy(
     vec2f const inertialVelocity = mRenderContext->ScreenOffsetToWorldOffset(inertialScreenOffset);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->MoveBy(
-        elementId,
-        worldOffset,
-        inertialVelocity,
-        mGameParameters);
+    RunOnWorld(
+        [this, elementId, worldOffset, inertialVelocity](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->MoveBy(
+                elementId,
+                worldOffset,
+                inertialVelocity,
+                gameParameters);
+        });
 }
 
 void GameController::MoveBy(
@@ -717,12 +971,16 @@ void GameController::MoveBy(
     vec2f const inertialVelocity = mRenderContext->ScreenOffsetToWorldOffset(inertialScreenOffset);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->MoveBy(
-        shipId,
-        worldOffset,
-        inertialVelocity,
-        mGameParameters);
+    RunOnWorld(
+        [this, shipId, worldOffset, inertialVelocity](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->MoveBy(
+                shipId,
+                worldOffset,
+                inertialVelocity,
+                gameParameters);
+        });
 }
 
 void GameController::RotateBy(
@@ -745,13 +1003,17 @@ void GameController::RotateBy(
         * inertialScreenDeltaY;
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->RotateBy(
-        elementId,
-        angle,
-        worldCenter,
-        inertialAngle,
-        mGameParameters);
+    RunOnWorld(
+        [this, elementId, angle, worldCenter, inertialAngle](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->RotateBy(
+                elementId,
+                angle,
+                worldCenter,
+                inertialAngle,
+                gameParameters);
+        });
 }
 
 void GameController::RotateBy(
@@ -773,13 +1035,17 @@ void GameController::RotateBy(
         * inertialScreenDeltaY;
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->RotateBy(
-        shipId,
-        angle,
-        worldCenter,
-        inertialAngle,
-        mGameParameters);
+    RunOnWorld(
+        [this, shipId, angle, worldCenter, inertialAngle](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->RotateBy(
+                shipId,
+                angle,
+                worldCenter,
+                inertialAngle,
+                gameParameters);
+        });
 }
 
 void GameController::DestroyAt(
@@ -789,11 +1055,15 @@ void GameController::DestroyAt(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->DestroyAt(
-        worldCoordinates,
-        radiusMultiplier,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates, radiusMultiplier](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->DestroyAt(
+                worldCoordinates,
+                radiusMultiplier,
+                gameParameters);
+        });
 }
 
 void GameController::RepairAt(
@@ -804,12 +1074,16 @@ void GameController::RepairAt(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->RepairAt(
-        worldCoordinates,
-        radiusMultiplier,
-        repairStepId,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates, radiusMultiplier, repairStepId](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->RepairAt(
+                worldCoordinates,
+                radiusMultiplier,
+                repairStepId,
+                gameParameters);
+        });
 }
 
 bool GameController::SawThrough(
@@ -820,6 +1094,8 @@ bool GameController::SawThrough(
     vec2f const startWorldCoordinates = mRenderContext->ScreenToWorld(startScreenCoordinates);
     vec2f const endWorldCoordinates = mRenderContext->ScreenToWorld(endScreenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     return mWorld->SawThrough(
@@ -842,6 +1118,8 @@ bool GameController::ApplyHeatBlasterAt(
         radius *= 5.0f;
     }
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     bool isApplied = mWorld->ApplyHeatBlasterAt(
@@ -876,6 +1154,8 @@ bool GameController::ExtinguishFireAt(DisplayLogicalCoordinates const & screenCo
         radius *= 5.0f;
     }
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     bool isApplied = mWorld->ExtinguishFireAt(
@@ -910,12 +1190,16 @@ void GameController::ApplyBlastAt(
         * (mGameParameters.IsUltraViolentMode ? 2.5f : 1.0f);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->ApplyBlastAt(
-        worldCoordinates,
-        radius,
-        forceMultiplier,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates, radius, forceMultiplier](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->ApplyBlastAt(
+                worldCoordinates,
+                radius,
+                forceMultiplier,
+                gameParameters);
+        });
 
     // Draw notification (one frame only)
     mNotificationLayer.SetBlastToolHalo(
@@ -933,6 +1217,8 @@ bool GameController::ApplyElectricSparkAt(
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     return mWorld->ApplyElectricSparkAt(
@@ -964,14 +1250,18 @@ void GameController::ApplyRadialWindFrom(
     float mainFrontRadius = mainFrontWindSpeed * mainFrontSimulationTimeElapsed;
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->ApplyRadialWindFrom(
-        sourceWorldCoordinates,
-        preFrontRadius,
-        preFrontWindSpeed,
-        mainFrontRadius,
-        mainFrontWindSpeed,
-        mGameParameters);
+    RunOnWorld(
+        [this, sourceWorldCoordinates, preFrontRadius, preFrontWindSpeed, mainFrontRadius, mainFrontWindSpeed](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->ApplyRadialWindFrom(
+                sourceWorldCoordinates,
+                preFrontRadius,
+                preFrontWindSpeed,
+                mainFrontRadius,
+                mainFrontWindSpeed,
+                gameParameters);
+        });
 
     // Draw notification (one frame only)
     mNotificationLayer.SetWindSphere(
@@ -994,6 +1284,8 @@ bool GameController::ApplyLaserCannonThrough(
 
     if (strength)
     {
+        auto const worldLock = LockWorldForInteraction();
+
         // Apply action
         assert(!!mWorld);
         hasCut = mWorld->ApplyLaserCannonThrough(
@@ -1018,11 +1310,15 @@ void GameController::DrawTo(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->DrawTo(
-        worldCoordinates,
-        strengthFraction,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates, strengthFraction](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->DrawTo(
+                worldCoordinates,
+                strengthFraction,
+                gameParameters);
+        });
 }
 
 void GameController::SwirlAt(
@@ -1032,11 +1328,15 @@ void GameController::SwirlAt(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->SwirlAt(
-        worldCoordinates,
-        strengthFraction,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates, strengthFraction](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->SwirlAt(
+                worldCoordinates,
+                strengthFraction,
+                gameParameters);
+        });
 }
 
 void GameController::TogglePinAt(DisplayLogicalCoordinates const & screenCoordinates)
@@ -1044,17 +1344,25 @@ void GameController::TogglePinAt(DisplayLogicalCoordinates const & screenCoordin
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->TogglePinAt(
-        worldCoordinates,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->TogglePinAt(
+                worldCoordinates,
+                gameParameters);
+        });
 }
 
 void GameController::RemoveAllPins()
 {
     // Apply action
-    assert(!!mWorld);
-    mWorld->RemoveAllPins();
+    RunOnWorld(
+        [this](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->RemoveAllPins();
+        });
 }
 
 std::optional<ToolApplicationLocus> GameController::InjectPressureAt(
@@ -1063,6 +1371,8 @@ std::optional<ToolApplicationLocus> GameController::InjectPressureAt(
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     auto const applicationLocus = mWorld->InjectPressureAt(
@@ -1088,6 +1398,8 @@ bool GameController::FloodAt(
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     return mWorld->FloodAt(
@@ -1101,10 +1413,14 @@ void GameController::ToggleAntiMatterBombAt(DisplayLogicalCoordinates const & sc
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->ToggleAntiMatterBombAt(
-        worldCoordinates,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->ToggleAntiMatterBombAt(
+                worldCoordinates,
+                gameParameters);
+        });
 }
 
 void GameController::ToggleImpactBombAt(DisplayLogicalCoordinates const & screenCoordinates)
@@ -1112,16 +1428,22 @@ void GameController::ToggleImpactBombAt(DisplayLogicalCoordinates const & screen
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->ToggleImpactBombAt(
-        worldCoordinates,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->ToggleImpactBombAt(
+                worldCoordinates,
+                gameParameters);
+        });
 }
 
 void GameController::TogglePhysicsProbeAt(DisplayLogicalCoordinates const & screenCoordinates)
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     auto const toggleResult = mWorld->TogglePhysicsProbeAt(
@@ -1140,10 +1462,14 @@ void GameController::ToggleRCBombAt(DisplayLogicalCoordinates const & screenCoor
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->ToggleRCBombAt(
-        worldCoordinates,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->ToggleRCBombAt(
+                worldCoordinates,
+                gameParameters);
+        });
 }
 
 void GameController::ToggleTimerBombAt(DisplayLogicalCoordinates const & screenCoordinates)
@@ -1151,24 +1477,36 @@ void GameController::ToggleTimerBombAt(DisplayLogicalCoordinates const & screenC
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
-    assert(!!mWorld);
-    mWorld->ToggleTimerBombAt(
-        worldCoordinates,
-        mGameParameters);
+    RunOnWorld(
+        [this, worldCoordinates](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->ToggleTimerBombAt(
+                worldCoordinates,
+                gameParameters);
+        });
 }
 
 void GameController::DetonateRCBombs()
 {
     // Apply action
-    assert(!!mWorld);
-    mWorld->DetonateRCBombs();
+    RunOnWorld(
+        [this](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->DetonateRCBombs();
+        });
 }
 
 void GameController::DetonateAntiMatterBombs()
 {
     // Apply action
-    assert(!!mWorld);
-    mWorld->DetonateAntiMatterBombs();
+    RunOnWorld(
+        [this](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->DetonateAntiMatterBombs();
+        });
 }
 
 void GameController::AdjustOceanSurfaceTo(
@@ -1179,14 +1517,20 @@ void GameController::AdjustOceanSurfaceTo(
     float const worldRadius = mRenderContext->ScreenOffsetToWorldOffset(screenRadius);
 
     // Apply action
-    assert(mWorld);
-    mWorld->AdjustOceanSurfaceTo(worldCoordinates, worldRadius);
+    RunOnWorld(
+        [this, worldCoordinates, worldRadius](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->AdjustOceanSurfaceTo(worldCoordinates, worldRadius);
+        });
 }
 
 std::optional<bool> GameController::AdjustOceanFloorTo(
     vec2f const & startWorldPosition, 
     vec2f const & endWorldPosition)
 {
+    auto const worldLock = LockWorldForInteraction();
+
     assert(!!mWorld);
     return mWorld->AdjustOceanFloorTo(
         startWorldPosition.x,
@@ -1202,6 +1546,8 @@ bool GameController::ScrubThrough(
     vec2f const startWorldCoordinates = mRenderContext->ScreenToWorld(startScreenCoordinates);
     vec2f const endWorldCoordinates = mRenderContext->ScreenToWorld(endScreenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     return mWorld->ScrubThrough(
@@ -1217,6 +1563,8 @@ bool GameController::RotThrough(
     vec2f const startWorldCoordinates = mRenderContext->ScreenToWorld(startScreenCoordinates);
     vec2f const endWorldCoordinates = mRenderContext->ScreenToWorld(endScreenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     // Apply action
     assert(!!mWorld);
     return mWorld->RotThrough(
@@ -1231,6 +1579,8 @@ void GameController::ApplyThanosSnapAt(
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorldForInteraction();
+
     StartThanosSnapStateMachine(worldCoordinates.x, isSparseMode, mWorld->GetCurrentSimulationTime());
 }
 
@@ -1238,6 +1588,8 @@ std::optional<ElementId> GameController::GetNearestPointAt(DisplayLogicalCoordin
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorld();
+
     assert(!!mWorld);
     return mWorld->GetNearestPointAt(worldCoordinates, 1.0f);
 }
@@ -1246,70 +1598,104 @@ void GameController::QueryNearestPointAt(DisplayLogicalCoordinates const & scree
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    auto const worldLock = LockWorld();
+
     assert(!!mWorld);
     mWorld->QueryNearestPointAt(worldCoordinates, 1.0f);
 }
 
 void GameController::TriggerTsunami()
 {
-    assert(!!mWorld);
-    mWorld->TriggerTsunami();
+    RunOnWorld(
+        [this](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->TriggerTsunami();
+        });
 }
 
 void GameController::TriggerRogueWave()
 {
-    assert(!!mWorld);
-    mWorld->TriggerRogueWave();
+    RunOnWorld(
+        [this](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->TriggerRogueWave();
+        });
 }
 
 void GameController::TriggerStorm()
 {
-    assert(!!mWorld);
-    mWorld->TriggerStorm();
+    RunOnWorld(
+        [this](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->TriggerStorm();
+        });
 }
 
 void GameController::TriggerLightning()
 {
-    assert(!!mWorld);
-    mWorld->TriggerLightning(mGameParameters);
+    RunOnWorld(
+        [this](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->TriggerLightning(gameParameters);
+        });
 }
 
 void GameController::HighlightElectricalElement(ElectricalElementId electricalElementId)
 {
-    assert(!!mWorld);
-    mWorld->HighlightElectricalElement(electricalElementId);
+    RunOnWorld(
+        [this, electricalElementId](GameParameters const &)
+        {
+            assert(!!mWorld);
+            mWorld->HighlightElectricalElement(electricalElementId);
+        });
 }
 
 void GameController::SetSwitchState(
     ElectricalElementId electricalElementId,
     ElectricalState switchState)
 {
-    assert(!!mWorld);
-    mWorld->SetSwitchState(
-        electricalElementId,
-        switchState,
-        mGameParameters);
+    RunOnWorld(
+        [this, electricalElementId, switchState](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->SetSwitchState(
+                electricalElementId,
+                switchState,
+                gameParameters);
+        });
 }
 
 void GameController::SetEngineControllerState(
     ElectricalElementId electricalElementId,
     float controllerValue)
 {
-    assert(!!mWorld);
-    mWorld->SetEngineControllerState(
-        electricalElementId,
-        controllerValue,
-        mGameParameters);
+    RunOnWorld(
+        [this, electricalElementId, controllerValue](GameParameters const & gameParameters)
+        {
+            assert(!!mWorld);
+            mWorld->SetEngineControllerState(
+                electricalElementId,
+                controllerValue,
+                gameParameters);
+        });
 }
 
 bool GameController::DestroyTriangle(ElementId triangleId)
 {
+    auto const worldLock = LockWorldForInteraction();
+
     assert(!!mWorld);
     return mWorld->DestroyTriangle(triangleId);
 }
 
 bool GameController::RestoreTriangle(ElementId triangleId)
 {
+    auto const worldLock = LockWorldForInteraction();
+
     assert(!!mWorld);
     return mWorld->RestoreTriangle(triangleId);
 }
@@ -1347,6 +1733,8 @@ void GameController::AdjustZoom(float amount)
 
 void GameController::ResetView()
 {
+    auto const worldLock = LockWorld();
+
     if (mWorld)
     {
         mViewManager.ResetView(mWorld->GetAllAABBs());
@@ -1355,6 +1743,8 @@ void GameController::ResetView()
 
 void GameController::FocusOnShip()
 {
+    auto const worldLock = LockWorld();
+
     if (mWorld)
     {
         mViewManager.FocusOnShip(mWorld->GetAllAABBs());
@@ -1409,7 +1799,13 @@ void GameController::SetDoDayLightCycle(bool value)
 void GameController::SetOceanRenderDetail(OceanRenderDetailType oceanRenderDetail)
 { 
     mRenderContext->SetOceanRenderDetail(oceanRenderDetail); 
-    mWorld->SetAreCloudShadowsEnabled(CalculateAreCloudShadowsEnabled(oceanRenderDetail));
+
+    bool const areCloudShadowsEnabled = CalculateAreCloudShadowsEnabled(oceanRenderDetail);
+    RunOnWorld(
+        [this, areCloudShadowsEnabled](GameParameters const &)
+        {
+            mWorld->SetAreCloudShadowsEnabled(areCloudShadowsEnabled);
+        });
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -1434,52 +1830,66 @@ void GameController::OnShipRepaired(ShipId /*shipId*/)
 
 ShipMetadata GameController::InternalResetAndLoadShip(ShipLoadSpecifications const & loadSpecs)
 {
+    // We also use the simulation thread pool
+    auto const worldLock = LockWorldForInteraction();
+
     assert(!!mWorld);
 
-    // Load ship definition
-    auto shipDefinition = ShipDeSerializer::LoadShip(loadSpecs.DefinitionFilepath, mMaterialDatabase);
+    // We supersede any load in progress
+    mAsyncShipLoader.Cancel();
 
-    // Pre-validate ship's texture
-    if (shipDefinition.Layers.TextureLayer)
-        mRenderContext->ValidateShipTexture(shipDefinition.Layers.TextureLayer->Buffer);
+    auto loadedShip = AsyncShipLoader::LoadShip(
+        loadSpecs,
+        MakeNewWorld(),
+        mMaterialDatabase,
+        mShipTexturizer,
+        mThreadManager.GetSimulationThreadPool(),
+        mShipStrengthRandomizer,
+        mGameEventDispatcher,
+        mGameParameters,
+        [](float, ProgressMessageType) {});
 
-    // Save metadata
-    ShipMetadata shipMetadata(shipDefinition.Metadata);
+    return InternalResetAndAddShip(std::move(loadedShip));
+}
+
+std::unique_ptr<Physics::World> GameController::MakeNewWorld() const
+{
+    auto const worldLock = LockWorld();
+
+    assert(!!mWorld);
 
-    // Create a new world
-    auto newWorld = std::make_unique<Physics::World>(
+    return std::make_unique<Physics::World>(
         OceanFloorTerrain(mWorld->GetOceanFloorTerrain()),
         CalculateAreCloudShadowsEnabled(mRenderContext->GetOceanRenderDetail()),
         mFishSpeciesDatabase,
         mGameEventDispatcher,
         mGameParameters,
         mRenderContext->GetVisibleWorld());
+}
 
-    // Produce ship
-    auto const shipId = newWorld->GetNextShipId();
-    auto [ship, textureImage] = ShipFactory::Create(
-        shipId,
-        *newWorld,
-        std::move(shipDefinition),
-        loadSpecs.LoadOptions,
-        mMaterialDatabase,
-        mShipTexturizer,
-        mShipStrengthRandomizer,
-        mGameEventDispatcher,
-        mGameParameters);
+ShipMetadata GameController::InternalResetAndAddShip(AsyncShipLoader::LoadedShip && loadedShip)
+{
+    auto const worldLock = LockWorldForInteraction();
+
+    // Validate ship's texture before committing to the new world
+    mRenderContext->ValidateShipTexture(loadedShip.TextureImage);
 
     //
     // No errors, so we may continue
     //
 
-    Reset(std::move(newWorld));
+    // The new world got a copy of the ocean floor when the load started; take
+    // the current one, so that the edits made meanwhile are not lost
+    loadedShip.World->SetOceanFloorTerrain(mWorld->GetOceanFloorTerrain());
+
+    Reset(std::move(loadedShip.World));
 
     InternalAddShip(
-        std::move(ship),
-        std::move(textureImage),
-        shipMetadata);
+        std::move(loadedShip.Ship),
+        std::move(loadedShip.TextureImage),
+        loadedShip.Metadata);
 
-    return shipMetadata;
+    return loadedShip.Metadata;
 }
 
 void GameController::Reset(std::unique_ptr<Physics::World> newWorld)
@@ -1570,6 +1980,16 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
         ? static_cast<float>(lastDeltaFrameCount) / lastElapsedReal.count()
         : 0.0f;
 
+    // Calculate simulated seconds per real second; the simulation time goes
+    // back to zero when a new world is created
+
+    float const lastElapsedSimulation = std::max(mWorld->GetCurrentSimulationTime() - mStatsLastSimulationTime, 0.0f);
+
+    float const lastSimulationSpeed =
+        lastElapsedReal.count() != 0.0f
+        ? lastElapsedSimulation / lastElapsedReal.count()
+        : 0.0f;
+
     // Publish frame rate
     assert(!!mGameEventDispatcher);
     mGameEventDispatcher->OnFrameRateUpdated(lastFps, totalFps);
@@ -1586,11 +2006,243 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
         *mTotalPerfStats,
         std::chrono::duration<float>(GameWallClock::GetInstance().Now() - mOriginTimestampGame),
         mIsPaused,
+        mIsFastForward ? std::optional<float>(lastSimulationSpeed) : std::nullopt,
         mRenderContext->GetZoom(),
         mRenderContext->GetCameraWorldPosition(),
         mRenderContext->GetStatistics());
 }
 
+void GameController::RunWorldCommands(GameParameters const & gameParameters)
+{
+    // Take the commands queued so far - leaving the queue to the main thread
+    {
+        std::lock_guard const lock{ mWorldCommandsLock };
+
+        assert(mRunningWorldCommands.empty());
+        std::swap(mRunningWorldCommands, mWorldCommands);
+    }
+
+    for (auto const & command : mRunningWorldCommands)
+    {
+        command(gameParameters);
+    }
+
+    mRunningWorldCommands.clear();
+}
+
+void GameController::StartSimulationThread()
+{
+    assert(!mSimulationThread.joinable());
+
+    LogMessage("GameController::StartSimulationThread()");
+
+    auto const worldLock = LockWorldForInteraction();
+
+    // Step with what we'd step with now, but only once the next frame tells us to
+    mSimulationGameParameters = mGameParameters;
+    mSimulationVisibleWorld = mRenderContext->GetVisibleWorld();
+    mSimulationStressRenderMode = mRenderContext->GetStressRenderMode();
+    mSimulationDoUpdate = false;
+    mSimulationIsPulseUpdateSet = false;
+    mSimulationIsFastForward = mIsFastForward;
+    mSimulationThreadError.reset();
+
+    mIsSimulationThreadStop = false;
+
+    mMainThreadRandomEngine.emplace(GameRandomEngine::GetInstance().GenerateSeed());
+
+    mSimulationThread = std::thread(&GameController::SimulationThreadLoop, this);
+
+    // The events fired while stepping - by the thread or by its pool workers - reach
+    // the sinks when we flush; the thread can't fire any before we're done, as we hold
+    // the world lock
+    mGameEventDispatcher->SetDispatchingThread(std::this_thread::get_id());
+}
+
+void GameController::StopSimulationThread()
+{
+    assert(mSimulationThread.joinable());
+
+    LogMessage("GameController::StopSimulationThread(): signaling stop...");
+
+    {
+        std::lock_guard const lock{ mSimulationThreadStopLock };
+
+        mIsSimulationThreadStop = true;
+        mSimulationThreadStopSignal.notify_one();
+    }
+
+    mSimulationThread.join();
+
+    LogMessage("GameController::StopSimulationThread(): ...thread stopped.");
+
+    // Back to the shared random engine
+    mMainThreadRandomEngine.reset();
+
+    // Events left behind by the thread are dispatched at the next flush
+    mGameEventDispatcher->SetDispatchingThread(std::thread::id());
+
+    // Run the commands left behind by the thread
+    auto const worldLock = LockWorldForInteraction();
+}
+
+void GameController::SimulationThreadLoop()
+{
+    ThreadManager::InitializeThisThread();
+
+    auto const stepDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(GameParameters::SimulationStepTimeDuration<float>));
+
+    auto nextStepTime = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        //
+        // Wait until the next step is due, or until we're told to stop
+        //
+
+        {
+            std::unique_lock lock{ mSimulationThreadStopLock };
+
+            mSimulationThreadStopSignal.wait_until(
+                lock,
+                nextStepTime,
+                [this]
+                {
+                    return mIsSimulationThreadStop;
+                });
+
+            if (mIsSimulationThreadStop)
+            {
+                break;
+            }
+        }
+
+        //
+        // Run the steps that are due, catching up with the wall clock - but only up to
+        // a point, as otherwise a slow simulation would only fall further behind
+        //
+
+        auto const now = std::chrono::steady_clock::now();
+
+        for (size_t step = 0; step < MaxSimulationThreadCatchUpSteps && nextStepTime <= now; ++step)
+        {
+            if (RunSimulationThreadStep())
+            {
+                // Fast-forwarding: step as fast as we can, giving the main thread a
+                // chance to grab the world lock in-between
+                nextStepTime = std::chrono::steady_clock::now();
+                std::this_thread::yield();
+                break;
+            }
+
+            nextStepTime += stepDuration;
+        }
+
+        if (nextStepTime + stepDuration < now)
+        {
+            // Drop the time we're behind of
+            nextStepTime = now;
+        }
+    }
+
+    LogMessage("GameController::SimulationThreadLoop(): exiting");
+}
+
+bool GameController::RunSimulationThreadStep()
+{
+    auto const worldLock = LockWorld();
+
+    if (mSimulationThreadError.has_value())
+    {
+        // Wait for the main thread to report the error
+        return false;
+    }
+
+    try
+    {
+        // Run the interactions requested since the last step
+        RunWorldCommands(mSimulationGameParameters);
+
+        if (mSimulationDoUpdate || mSimulationIsPulseUpdateSet)
+        {
+            mSimulationIsPulseUpdateSet = false;
+
+            auto const startTime = GameChronometer::now();
+
+            BeginTelemetryStep();
+
+            assert(!!mWorld);
+            mWorld->Update(
+                mSimulationGameParameters,
+                mSimulationVisibleWorld,
+                mSimulationStressRenderMode,
+                mThreadManager,
+                *mTotalPerfStats);
+
+            EndTelemetryStep();
+
+            mTotalPerfStats->TotalNetUpdateDuration.Update(GameChronometer::now() - startTime);
+            mTotalPerfStats->TotalUpdateDuration.Update(GameChronometer::now() - startTime);
+        }
+    }
+    catch (std::exception const & exc)
+    {
+        LogMessage("GameController::RunSimulationThreadStep(): error: ", exc.what());
+
+        mSimulationThreadError = std::string(exc.what());
+
+        return false;
+    }
+
+    return mSimulationIsFastForward && mSimulationDoUpdate;
+}
+
+void GameController::BeginTelemetryStep()
+{
+    if (!mTelemetrySink)
+    {
+        return;
+    }
+
+    mTelemetryStepStartTime = GameChronometer::now();
+    mTelemetryStepStartPerfStats = *mTotalPerfStats;
+    mTelemetryStepStartThreadPoolIdleDuration = mThreadManager.GetSimulationThreadPool().GetTotalIdleDuration();
+}
+
+void GameController::EndTelemetryStep()
+{
+    if (!mTelemetrySink)
+    {
+        return;
+    }
+
+    auto const now = GameChronometer::now();
+
+    PerfStats const stepPerfStats = *mTotalPerfStats - mTelemetryStepStartPerfStats;
+
+    TelemetryFrame frame;
+
+    frame.StepIndex = mTelemetryStepIndex++;
+    frame.Timestamp = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - mTelemetrySink->GetStartTime()).count());
+    frame.SimulationTime = mWorld->GetCurrentSimulationTime();
+
+    frame.StepDuration = std::chrono::duration<float, std::micro>(now - mTelemetryStepStartTime).count();
+    frame.OceanSurfaceDuration = stepPerfStats.TotalOceanSurfaceUpdateDuration.ToDuration<std::chrono::microseconds>();
+    frame.ShipsDuration = stepPerfStats.TotalShipsUpdateDuration.ToDuration<std::chrono::microseconds>();
+    frame.ShipsSpringsDuration = stepPerfStats.TotalShipsSpringsUpdateDuration.ToDuration<std::chrono::microseconds>();
+    frame.FishDuration = stepPerfStats.TotalFishUpdateDuration.ToDuration<std::chrono::microseconds>();
+    frame.ThreadPoolIdleDuration = std::chrono::duration<float, std::micro>(
+        mThreadManager.GetSimulationThreadPool().GetTotalIdleDuration() - mTelemetryStepStartThreadPoolIdleDuration).count();
+
+    mWorld->PopulateTelemetryFrame(frame);
+
+    frame.HeapBufferByteCount = static_cast<std::uint64_t>(AlignedBufferStats::HeapByteCount.load(std::memory_order_relaxed));
+    frame.HugePagesBufferByteCount = static_cast<std::uint64_t>(AlignedBufferStats::HugePagesByteCount.load(std::memory_order_relaxed));
+
+    mTelemetrySink->Push(frame);
+}
+
 bool GameController::CalculateAreCloudShadowsEnabled(OceanRenderDetailType oceanRenderDetail)
 {
     // Note: also RenderContext infers applicability of shadows via detail, independently
@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "AsyncShipLoader.h"
 #include "FishSpeciesDatabase.h"
 #include "GameEventDispatcher.h"
 #include "GameParameters.h"
@@ -26,6 +27,7 @@
 
 #include <GameCore/Colors.h>
 #include <GameCore/GameChronometer.h>
+#include <GameCore/GameRandomEngine.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/GameWallClock.h>
 #include <GameCore/ImageData.h>
@@ -37,16 +39,25 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 /*
  * This class is responsible for managing the game, from its lifetime to the user
  * interactions.
+ *
+ * The simulation normally runs in RunGameIteration(), one step per frame. When the
+ * simulation is threaded, it runs instead on its own thread at a fixed time step,
+ * and RunGameIteration() only uploads the latest completed step; interactions that
+ * do not return anything are queued to the simulation thread as commands, while
+ * the others run on the calling thread, holding the world lock.
  */
 class GameController final
     : public IGameController
@@ -139,6 +150,14 @@ public:
     ShipMetadata ResetAndReloadShip(ShipLoadSpecifications const & loadSpecs) override;
     ShipMetadata AddShip(ShipLoadSpecifications const & loadSpecs) override;
 
+    void BeginResetAndLoadShip(
+        ShipLoadSpecifications const & loadSpecs,
+        ProgressCallback const & progressCallback) override;
+    bool PollShipLoad() override;
+    ShipMetadata EndResetAndLoadShip() override;
+    void CancelShipLoad() override;
+    bool IsShipLoadInProgress() const override { return mAsyncShipLoader.IsInProgress(); }
+
     RgbImageData TakeScreenshot() override;
 
     void RunGameIteration() override;
@@ -153,6 +172,10 @@ public:
     RecordedEvents StopRecordingEvents() override;
     void ReplayRecordedEvent(RecordedEvent const & event) override;
 
+    void StartTelemetry(
+        std::filesystem::path const & outputFilePath,
+        TelemetrySink::FormatType format) override;
+
     //
     // Game Control and notifications
     //
@@ -160,6 +183,9 @@ public:
     void Freeze() override;
     void Thaw() override;
     void SetPaused(bool isPaused) override;
+    void SetFastForward(bool isFastForward) override;
+    bool GetSimulationThreaded() const override { return mSimulationThread.joinable(); }
+    void SetSimulationThreaded(bool isSimulationThreaded) override;
     void SetMoveToolEngaged(bool isEngaged) override;
     void DisplaySettingsLoadedNotification() override;
 
@@ -174,11 +200,11 @@ public:
     // World probing
     //
 
-    float GetCurrentSimulationTime() const override { return mWorld->GetCurrentSimulationTime(); }
+    float GetCurrentSimulationTime() const override { auto const worldLock = LockWorld(); return mWorld->GetCurrentSimulationTime(); }
     void ToggleToFullDayOrNight() override;
     float GetEffectiveAmbientLightIntensity() const override { return mRenderContext->GetEffectiveAmbientLightIntensity(); }
-    bool IsUnderwater(DisplayLogicalCoordinates const & screenCoordinates) const override { return mWorld->GetOceanSurface().IsUnderwater(ScreenToWorld(screenCoordinates)); }
-    bool IsUnderwater(ElementId elementId) const override { return mWorld->IsUnderwater(elementId); }
+    bool IsUnderwater(DisplayLogicalCoordinates const & screenCoordinates) const override { auto const worldLock = LockWorld(); return mWorld->GetOceanSurface().IsUnderwater(ScreenToWorld(screenCoordinates)); }
+    bool IsUnderwater(ElementId elementId) const override { auto const worldLock = LockWorld(); return mWorld->IsUnderwater(elementId); }
 
     //
     // Interactions
@@ -302,12 +328,17 @@ public:
     float GetSimulationStepTimeDuration() const override { return GameParameters::SimulationStepTimeDuration<float>; }
 
     unsigned int GetMaxNumSimulationThreads() const override { return static_cast<unsigned int>(mThreadManager.GetSimulationParallelism()); }
-    void SetMaxNumSimulationThreads(unsigned int value) override { mThreadManager.SetSimulationParallelism(static_cast<size_t>(value)); }
+    void SetMaxNumSimulationThreads(unsigned int value) override { auto const worldLock = LockWorld(); mThreadManager.SetSimulationParallelism(static_cast<size_t>(value)); }
     unsigned int GetMinMaxNumSimulationThreads() const override { return 1; }
     unsigned int GetMaxMaxNumSimulationThreads() const override { return static_cast<unsigned int>(mThreadManager.GetMaxSimulationParallelism()); }
 
     float GetNumMechanicalDynamicsIterationsAdjustment() const override { return mGameParameters.NumMechanicalDynamicsIterationsAdjustment; }
     void SetNumMechanicalDynamicsIterationsAdjustment(float value) override { mGameParameters.NumMechanicalDynamicsIterationsAdjustment = value; }
+    bool GetDoAdaptMechanicalDynamicsIterations() const override { return mGameParameters.DoAdaptMechanicalDynamicsIterations; }
+    void SetDoAdaptMechanicalDynamicsIterations(bool value) override { mGameParameters.DoAdaptMechanicalDynamicsIterations = value; }
+    bool GetDoFuseSpringRelaxation() const override { return mGameParameters.DoFuseSpringRelaxation; }
+    void SetDoFuseSpringRelaxation(bool value) override { mGameParameters.DoFuseSpringRelaxation = value; }
+
     float GetMinNumMechanicalDynamicsIterationsAdjustment() const override { return GameParameters::MinNumMechanicalDynamicsIterationsAdjustment; }
     float GetMaxNumMechanicalDynamicsIterationsAdjustment() const override { return GameParameters::MaxNumMechanicalDynamicsIterationsAdjustment; }
 
@@ -596,8 +627,9 @@ public:
 
     // Misc
 
-    OceanFloorTerrain const & GetOceanFloorTerrain() const override { return mWorld->GetOceanFloorTerrain(); }
-    void SetOceanFloorTerrain(OceanFloorTerrain const & value) override { mWorld->SetOceanFloorTerrain(value); }
+    // Returns a copy, taken while we hold the world lock, as the simulation thread may change the terrain
+    OceanFloorTerrain GetOceanFloorTerrain() const override { auto const worldLock = LockWorld(); return mWorld->GetOceanFloorTerrain(); }
+    void SetOceanFloorTerrain(OceanFloorTerrain const & value) override { auto const worldLock = LockWorldForInteraction(); mWorld->SetOceanFloorTerrain(value); }
 
     float GetSeaDepth() const override { return mFloatParameterSmoothers[SeaDepthParameterSmoother].GetValue(); }
     void SetSeaDepth(float value) override { mFloatParameterSmoothers[SeaDepthParameterSmoother].SetValue(value); }
@@ -895,6 +927,10 @@ private:
 
     ShipMetadata InternalResetAndLoadShip(ShipLoadSpecifications const & loadSpecs);
 
+    std::unique_ptr<Physics::World> MakeNewWorld() const;
+
+    ShipMetadata InternalResetAndAddShip(AsyncShipLoader::LoadedShip && loadedShip);
+
     void Reset(std::unique_ptr<Physics::World> newWorld);
 
     void InternalAddShip(
@@ -908,6 +944,65 @@ private:
 
     static bool CalculateAreCloudShadowsEnabled(OceanRenderDetailType oceanRenderDetail);
 
+    //
+    // Simulation thread
+    //
+
+    using WorldCommand = std::function<void(GameParameters const & gameParameters)>;
+
+    // Runs the command right away, or - when the simulation is threaded - queues it
+    // for the simulation thread to run before its next step
+    template<typename TCommand>
+    void RunOnWorld(TCommand && command)
+    {
+        if (mSimulationThread.joinable())
+        {
+            std::lock_guard const lock{ mWorldCommandsLock };
+
+            mWorldCommands.emplace_back(std::forward<TCommand>(command));
+        }
+        else
+        {
+            command(mGameParameters);
+        }
+    }
+
+    // Locks the world for the calling thread
+    std::unique_lock<std::recursive_mutex> LockWorld() const
+    {
+        return std::unique_lock<std::recursive_mutex>(mWorldLock);
+    }
+
+    // Locks the world for the calling thread, after running the commands queued so far,
+    // so that interactions apply in the order in which they've been requested
+    std::unique_lock<std::recursive_mutex> LockWorldForInteraction()
+    {
+        auto worldLock = LockWorld();
+
+        RunWorldCommands(mGameParameters);
+
+        return worldLock;
+    }
+
+    void RunWorldCommands(GameParameters const & gameParameters);
+
+    void StartSimulationThread();
+
+    void StopSimulationThread();
+
+    void SimulationThreadLoop();
+
+    // Returns whether the next step is due right away
+    bool RunSimulationThreadStep();
+
+    //
+    // Telemetry
+    //
+
+    // Invoked around each world update; no-ops unless telemetry is on
+    void BeginTelemetryStep();
+    void EndTelemetryStep();
+
 private:
 
     //
@@ -955,6 +1050,7 @@ private:
 
     ShipStrengthRandomizer mShipStrengthRandomizer;
     ShipTexturizer mShipTexturizer;
+    AsyncShipLoader mAsyncShipLoader;
 
 
     //
@@ -966,6 +1062,57 @@ private:
     bool mIsPaused;
     bool mIsPulseUpdateSet;
     bool mIsMoveToolEngaged;
+    bool mIsFastForward; // When set, we run as many simulation steps per frame as fit in the frame's budget
+
+    // The max number of simulation steps we run in a frame when fast-forwarding
+    static size_t constexpr MaxFastForwardStepsPerFrame = 16;
+
+    // The fraction of a frame's duration that we may spend updating when
+    // fast-forwarding; the rest is left for uploading and rendering
+    static float constexpr FastForwardUpdateBudgetFraction = 0.75f;
+
+
+    //
+    // Simulation thread
+    //
+
+    std::thread mSimulationThread;
+
+    // While the simulation is threaded, the main thread draws - e.g. for sounds and tools -
+    // from a random engine of its own, as the shared one is the simulation's
+    std::optional<GameRandomEngine::ThreadEngine> mMainThreadRandomEngine;
+
+    // Guards the world - and whatever the simulation thread touches while stepping - while
+    // the simulation is threaded; recursive, as the event handlers we invoke on the main
+    // thread while holding it may call back into us
+    mutable std::recursive_mutex mWorldLock;
+
+    // The commands queued for the simulation thread, in order
+    std::mutex mWorldCommandsLock;
+    std::vector<WorldCommand> mWorldCommands;
+    std::vector<WorldCommand> mRunningWorldCommands; // Only touched while holding the world lock
+
+    // What the simulation thread steps with; published by the main thread at each
+    // frame, while holding the world lock
+    GameParameters mSimulationGameParameters;
+    VisibleWorld mSimulationVisibleWorld;
+    StressRenderModeType mSimulationStressRenderMode;
+    bool mSimulationDoUpdate;
+    bool mSimulationIsPulseUpdateSet;
+    bool mSimulationIsFastForward;
+
+    // The error that has stopped the simulation thread from stepping, if any;
+    // re-thrown by the main thread at the next frame
+    std::optional<std::string> mSimulationThreadError;
+
+    // Stopping
+    std::mutex mSimulationThreadStopLock;
+    std::condition_variable mSimulationThreadStopSignal;
+    bool mIsSimulationThreadStop;
+
+    // The max number of steps the simulation thread runs back-to-back to catch up
+    // with the wall clock; beyond this, it drops the time it's behind of
+    static size_t constexpr MaxSimulationThreadCatchUpSteps = 4;
 
 
     //
@@ -1010,10 +1157,24 @@ private:
 
     std::chrono::steady_clock::time_point mStatsOriginTimestampReal;
     std::chrono::steady_clock::time_point mStatsLastTimestampReal;
+    float mStatsLastSimulationTime;
     GameWallClock::time_point mOriginTimestampGame;
     std::unique_ptr<PerfStats> mTotalPerfStats;
     PerfStats mLastPublishedTotalPerfStats;
     uint64_t mTotalFrameCount;
     uint64_t mLastPublishedTotalFrameCount;
     int mSkippedFirstStatPublishes;
+
+
+    //
+    // Telemetry
+    //
+
+    std::unique_ptr<TelemetrySink> mTelemetrySink;
+    std::uint64_t mTelemetryStepIndex;
+
+    // Snapshots taken at the beginning of the current step
+    GameChronometer::time_point mTelemetryStepStartTime;
+    PerfStats mTelemetryStepStartPerfStats;
+    GameChronometer::duration mTelemetryStepStartThreadPoolIdleDuration;
 };
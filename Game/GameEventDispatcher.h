@@ -11,11 +11,21 @@
 #include <GameCore/TupleKeys.h>
 
 #include <algorithm>
+#include <functional>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 /*
  * Dispatches events to multiple sinks, aggregating some events in the process.
+ *
+ * When a dispatching thread is set, events fired on any other thread - e.g. the
+ * simulation's own thread, or its pool workers - are not dispatched right away, but
+ * rather at the next Flush(), on the dispatching thread; this is how events fired by
+ * a simulation running on its own thread reach sinks that may only be invoked on the
+ * main thread. Firing and flushing must not happen concurrently.
  */
 class GameEventDispatcher final
     : public ILifecycleGameEventHandler
@@ -48,6 +58,9 @@ public:
         , mTimerBombDefusedEvents()
         , mWatertightDoorOpenedEvents()
         , mWatertightDoorClosedEvents()
+        , mDeferredEvents()
+        , mDeferredEventsLock()
+        , mDispatchingThreadId()
         // Sinks
         , mLifecycleSinks()
         , mStructuralSinks()
@@ -68,44 +81,29 @@ public:
 
     void OnGameReset() override
     {
-        for (auto sink : mLifecycleSinks)
-        {
-            sink->OnGameReset();
-        }
+        Dispatch(mLifecycleSinks, &ILifecycleGameEventHandler::OnGameReset);
     }
 
     void OnShipLoaded(
         ShipId id,
         ShipMetadata const & shipMetadata) override
     {
-        for (auto sink : mLifecycleSinks)
-        {
-            sink->OnShipLoaded(id, shipMetadata);
-        }
+        Dispatch(mLifecycleSinks, &ILifecycleGameEventHandler::OnShipLoaded, id, shipMetadata);
     }
 
     void OnSinkingBegin(ShipId shipId) override
     {
-        for (auto sink : mLifecycleSinks)
-        {
-            sink->OnSinkingBegin(shipId);
-        }
+        Dispatch(mLifecycleSinks, &ILifecycleGameEventHandler::OnSinkingBegin, shipId);
     }
 
     void OnSinkingEnd(ShipId shipId) override
     {
-        for (auto sink : mLifecycleSinks)
-        {
-            sink->OnSinkingEnd(shipId);
-        }
+        Dispatch(mLifecycleSinks, &ILifecycleGameEventHandler::OnSinkingEnd, shipId);
     }
 
     void OnShipRepaired(ShipId shipId) override
     {
-        for (auto sink : mLifecycleSinks)
-        {
-            sink->OnShipRepaired(shipId);
-        }
+        Dispatch(mLifecycleSinks, &ILifecycleGameEventHandler::OnShipRepaired, shipId);
     }
 
     //
@@ -155,18 +153,12 @@ public:
 
     void OnTsunami(float x) override
     {
-        for (auto sink : mWavePhenomenaSinks)
-        {
-            sink->OnTsunami(x);
-        }
+        Dispatch(mWavePhenomenaSinks, &IWavePhenomenaGameEventHandler::OnTsunami, x);
     }
 
     void OnTsunamiNotification(float x) override
     {
-        for (auto sink : mWavePhenomenaSinks)
-        {
-            sink->OnTsunamiNotification(x);
-        }
+        Dispatch(mWavePhenomenaSinks, &IWavePhenomenaGameEventHandler::OnTsunamiNotification, x);
     }
 
     //
@@ -175,26 +167,17 @@ public:
 
     void OnPointCombustionBegin() override
     {
-        for (auto sink : mCombustionSinks)
-        {
-            sink->OnPointCombustionBegin();
-        }
+        Dispatch(mCombustionSinks, &ICombustionGameEventHandler::OnPointCombustionBegin);
     }
 
     void OnPointCombustionEnd() override
     {
-        for (auto sink : mCombustionSinks)
-        {
-            sink->OnPointCombustionEnd();
-        }
+        Dispatch(mCombustionSinks, &ICombustionGameEventHandler::OnPointCombustionEnd);
     }
 
     void OnCombustionSmothered() override
     {
-        for (auto sink : mCombustionSinks)
-        {
-            sink->OnCombustionSmothered();
-        }
+        Dispatch(mCombustionSinks, &ICombustionGameEventHandler::OnCombustionSmothered);
     }
 
     void OnCombustionExplosion(
@@ -212,32 +195,27 @@ public:
         float immediateFps,
         float averageFps) override
     {
-        for (auto sink : mStatisticsSinks)
-        {
-            sink->OnFrameRateUpdated(
-                immediateFps,
-                averageFps);
-        }
+        Dispatch(
+            mStatisticsSinks,
+            &IStatisticsGameEventHandler::OnFrameRateUpdated,
+            immediateFps,
+            averageFps);
     }
 
     void OnCurrentUpdateDurationUpdated(float currentUpdateDuration) override
     {
-        for (auto sink : mStatisticsSinks)
-        {
-            sink->OnCurrentUpdateDurationUpdated(currentUpdateDuration);
-        }
+        Dispatch(mStatisticsSinks, &IStatisticsGameEventHandler::OnCurrentUpdateDurationUpdated, currentUpdateDuration);
     }
 
     void OnStaticPressureUpdated(
         float netForce,
         float complexity) override
     {
-        for (auto sink : mStatisticsSinks)
-        {
-            sink->OnStaticPressureUpdated(
-                netForce,
-                complexity);
-        }
+        Dispatch(
+            mStatisticsSinks,
+            &IStatisticsGameEventHandler::OnStaticPressureUpdated,
+            netForce,
+            complexity);
     }
 
     //
@@ -246,18 +224,12 @@ public:
 
     void OnStormBegin() override
     {
-        for (auto sink : mAtmosphereSinks)
-        {
-            sink->OnStormBegin();
-        }
+        Dispatch(mAtmosphereSinks, &IAtmosphereGameEventHandler::OnStormBegin);
     }
 
     void OnStormEnd() override
     {
-        for (auto sink : mAtmosphereSinks)
-        {
-            sink->OnStormEnd();
-        }
+        Dispatch(mAtmosphereSinks, &IAtmosphereGameEventHandler::OnStormEnd);
     }
 
     void OnWindSpeedUpdated(
@@ -268,40 +240,30 @@ public:
         float const maxSpeedMagnitude,
         vec2f const & windSpeed) override
     {
-        for (auto sink : mAtmosphereSinks)
-        {
-            sink->OnWindSpeedUpdated(
-                zeroSpeedMagnitude,
-                baseSpeedMagnitude,
-                baseAndStormSpeedMagnitude,
-                preMaxSpeedMagnitude,
-                maxSpeedMagnitude,
-                windSpeed);
-        }
+        Dispatch(
+            mAtmosphereSinks,
+            &IAtmosphereGameEventHandler::OnWindSpeedUpdated,
+            zeroSpeedMagnitude,
+            baseSpeedMagnitude,
+            baseAndStormSpeedMagnitude,
+            preMaxSpeedMagnitude,
+            maxSpeedMagnitude,
+            windSpeed);
     }
 
     void OnRainUpdated(float const density) override
     {
-        for (auto sink : mAtmosphereSinks)
-        {
-            sink->OnRainUpdated(density);
-        }
+        Dispatch(mAtmosphereSinks, &IAtmosphereGameEventHandler::OnRainUpdated, density);
     }
 
     void OnThunder() override
     {
-        for (auto sink : mAtmosphereSinks)
-        {
-            sink->OnThunder();
-        }
+        Dispatch(mAtmosphereSinks, &IAtmosphereGameEventHandler::OnThunder);
     }
 
     void OnLightning() override
     {
-        for (auto sink : mAtmosphereSinks)
-        {
-            sink->OnLightning();
-        }
+        Dispatch(mAtmosphereSinks, &IAtmosphereGameEventHandler::OnLightning);
     }
 
     void OnLightningHit(StructuralMaterial const & structuralMaterial) override
@@ -323,10 +285,7 @@ public:
 
     void OnElectricalElementAnnouncementsBegin() override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnElectricalElementAnnouncementsBegin();
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnElectricalElementAnnouncementsBegin);
     }
 
     void OnSwitchCreated(
@@ -339,10 +298,7 @@ public:
     {
         LogMessage("OnSwitchCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), "): State=", static_cast<bool>(state));
 
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnSwitchCreated(electricalElementId, instanceIndex, type, state, electricalMaterial, panelElementMetadata);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnSwitchCreated, electricalElementId, instanceIndex, type, state, electricalMaterial, panelElementMetadata);
     }
 
     void OnPowerProbeCreated(
@@ -355,10 +311,7 @@ public:
     {
         LogMessage("OnPowerProbeCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), "): State=", static_cast<bool>(state));
 
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnPowerProbeCreated(electricalElementId, instanceIndex, type, state, electricalMaterial, panelElementMetadata);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnPowerProbeCreated, electricalElementId, instanceIndex, type, state, electricalMaterial, panelElementMetadata);
     }
 
     void OnEngineControllerCreated(
@@ -369,10 +322,7 @@ public:
     {
         LogMessage("OnEngineControllerCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), ")");
 
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnEngineControllerCreated(electricalElementId, instanceIndex, electricalMaterial, panelElementMetadata);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnEngineControllerCreated, electricalElementId, instanceIndex, electricalMaterial, panelElementMetadata);
     }
 
     void OnEngineMonitorCreated(
@@ -385,10 +335,7 @@ public:
     {
         LogMessage("OnEngineMonitorCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), "): Thrust=", thrustMagnitude, " RPM=", rpm);
 
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnEngineMonitorCreated(electricalElementId, instanceIndex, thrustMagnitude, rpm, electricalMaterial, panelElementMetadata);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnEngineMonitorCreated, electricalElementId, instanceIndex, thrustMagnitude, rpm, electricalMaterial, panelElementMetadata);
     }
 
     void OnWaterPumpCreated(
@@ -400,10 +347,7 @@ public:
     {
         LogMessage("OnWaterPumpCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), ")");
 
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnWaterPumpCreated(electricalElementId, instanceIndex, normalizedForce, electricalMaterial, panelElementMetadata);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnWaterPumpCreated, electricalElementId, instanceIndex, normalizedForce, electricalMaterial, panelElementMetadata);
     }
 
     void OnWatertightDoorCreated(
@@ -415,58 +359,40 @@ public:
     {
         LogMessage("OnWatertightDoorCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), ")");
 
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnWatertightDoorCreated(electricalElementId, instanceIndex, isOpen, electricalMaterial, panelElementMetadata);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnWatertightDoorCreated, electricalElementId, instanceIndex, isOpen, electricalMaterial, panelElementMetadata);
     }
 
     void OnElectricalElementAnnouncementsEnd() override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnElectricalElementAnnouncementsEnd();
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnElectricalElementAnnouncementsEnd);
     }
 
     void OnSwitchEnabled(
         ElectricalElementId electricalElementId,
         bool isEnabled) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnSwitchEnabled(electricalElementId, isEnabled);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnSwitchEnabled, electricalElementId, isEnabled);
     }
 
     void OnSwitchToggled(
         ElectricalElementId electricalElementId,
         ElectricalState newState) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnSwitchToggled(electricalElementId, newState);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnSwitchToggled, electricalElementId, newState);
     }
 
     void OnPowerProbeToggled(
         ElectricalElementId electricalElementId,
         ElectricalState newState) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnPowerProbeToggled(electricalElementId, newState);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnPowerProbeToggled, electricalElementId, newState);
     }
 
     void OnEngineControllerEnabled(
         ElectricalElementId electricalElementId,
         bool isEnabled) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnEngineControllerEnabled(electricalElementId, isEnabled);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnEngineControllerEnabled, electricalElementId, isEnabled);
     }
 
     void OnEngineControllerUpdated(
@@ -475,10 +401,7 @@ public:
         float oldControllerValue,
         float newControllerValue) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnEngineControllerUpdated(electricalElementId, electricalMaterial, oldControllerValue, newControllerValue);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnEngineControllerUpdated, electricalElementId, electricalMaterial, oldControllerValue, newControllerValue);
     }
 
     void OnEngineMonitorUpdated(
@@ -486,10 +409,7 @@ public:
         float thrustMagnitude,
         float rpm) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnEngineMonitorUpdated(electricalElementId, thrustMagnitude, rpm);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnEngineMonitorUpdated, electricalElementId, thrustMagnitude, rpm);
     }
 
     void OnShipSoundUpdated(
@@ -498,50 +418,35 @@ public:
         bool isPlaying,
         bool isUnderwater) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnShipSoundUpdated(electricalElementId, electricalMaterial, isPlaying, isUnderwater);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnShipSoundUpdated, electricalElementId, electricalMaterial, isPlaying, isUnderwater);
     }
 
     void OnWaterPumpEnabled(
         ElectricalElementId electricalElementId,
         bool isEnabled) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnWaterPumpEnabled(electricalElementId, isEnabled);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnWaterPumpEnabled, electricalElementId, isEnabled);
     }
 
     void OnWaterPumpUpdated(
         ElectricalElementId electricalElementId,
         float normalizedForce) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnWaterPumpUpdated(electricalElementId, normalizedForce);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnWaterPumpUpdated, electricalElementId, normalizedForce);
     }
 
     void OnWatertightDoorEnabled(
         ElectricalElementId electricalElementId,
         bool isEnabled) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnWatertightDoorEnabled(electricalElementId, isEnabled);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnWatertightDoorEnabled, electricalElementId, isEnabled);
     }
 
     void OnWatertightDoorUpdated(
         ElectricalElementId electricalElementId,
         bool isOpen) override
     {
-        for (auto sink : mElectricalElementSinks)
-        {
-            sink->OnWatertightDoorUpdated(electricalElementId, isOpen);
-        }
+        Dispatch(mElectricalElementSinks, &IElectricalElementGameEventHandler::OnWatertightDoorUpdated, electricalElementId, isOpen);
     }
 
     //
@@ -553,10 +458,7 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnDestroy(structuralMaterial, isUnderwater, size);
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnDestroy, structuralMaterial, isUnderwater, size);
     }
 
     void OnSpringRepaired(
@@ -579,18 +481,12 @@ public:
         bool isMetal,
         unsigned int size) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnSawed(isMetal, size);
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnSawed, isMetal, size);
     }
 
     virtual void OnLaserCut(unsigned int size) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnLaserCut(size);
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnLaserCut, size);
     }
 
     void OnPinToggled(
@@ -602,18 +498,12 @@ public:
 
     void OnWaterTaken(float waterTaken) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnWaterTaken(waterTaken);
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnWaterTaken, waterTaken);
     }
 
     void OnWaterSplashed(float waterSplashed) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnWaterSplashed(waterSplashed);
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnWaterSplashed, waterSplashed);
     }
 
     void OnWaterDisplaced(float waterDisplacedMagnitude) override
@@ -630,36 +520,24 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnWaterReaction(isUnderwater, size);
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnWaterReaction, isUnderwater, size);
     }
 
     void OnWaterReactionExplosion(
         bool isUnderwater,
         unsigned int size) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnWaterReactionExplosion(isUnderwater, size);
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnWaterReactionExplosion, isUnderwater, size);
     }
 
     void OnSilenceStarted() override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnSilenceStarted();
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnSilenceStarted);
     }
 
     void OnSilenceLifted() override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnSilenceLifted();
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnSilenceLifted);
     }
 
     void OnPhysicsProbeReading(
@@ -668,26 +546,24 @@ public:
         float depth,
         float pressure) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnPhysicsProbeReading(
-                velocity,
-                temperature,
-                depth,
-                pressure);
-        }
+        Dispatch(
+            mGenericSinks,
+            &IGenericGameEventHandler::OnPhysicsProbeReading,
+            velocity,
+            temperature,
+            depth,
+            pressure);
     }
 
     void OnCustomProbe(
         std::string const & name,
         float value) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnCustomProbe(
-                name,
-                value);
-        }
+        Dispatch(
+            mGenericSinks,
+            &IGenericGameEventHandler::OnCustomProbe,
+            name,
+            value);
     }
 
     void OnGadgetPlaced(
@@ -695,13 +571,12 @@ public:
         GadgetType gadgetType,
         bool isUnderwater) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnGadgetPlaced(
-                gadgetId,
-                gadgetType,
-                isUnderwater);
-        }
+        Dispatch(
+            mGenericSinks,
+            &IGenericGameEventHandler::OnGadgetPlaced,
+            gadgetId,
+            gadgetType,
+            isUnderwater);
     }
 
     void OnGadgetRemoved(
@@ -709,13 +584,12 @@ public:
         GadgetType gadgetType,
         std::optional<bool> isUnderwater) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnGadgetRemoved(
-                gadgetId,
-                gadgetType,
-                isUnderwater);
-        }
+        Dispatch(
+            mGenericSinks,
+            &IGenericGameEventHandler::OnGadgetRemoved,
+            gadgetId,
+            gadgetType,
+            isUnderwater);
     }
 
     void OnBombExplosion(
@@ -737,12 +611,11 @@ public:
         GadgetId gadgetId,
         std::optional<bool> isFast) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnTimerBombFuse(
-                gadgetId,
-                isFast);
-        }
+        Dispatch(
+            mGenericSinks,
+            &IGenericGameEventHandler::OnTimerBombFuse,
+            gadgetId,
+            isFast);
     }
 
     void OnTimerBombDefused(
@@ -756,28 +629,21 @@ public:
         GadgetId gadgetId,
         bool isContained) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnAntiMatterBombContained(
-                gadgetId,
-                isContained);
-        }
+        Dispatch(
+            mGenericSinks,
+            &IGenericGameEventHandler::OnAntiMatterBombContained,
+            gadgetId,
+            isContained);
     }
 
     void OnAntiMatterBombPreImploding() override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnAntiMatterBombPreImploding();
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnAntiMatterBombPreImploding);
     }
 
     void OnAntiMatterBombImploding() override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnAntiMatterBombImploding();
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnAntiMatterBombImploding);
     }
 
     void OnWatertightDoorOpened(
@@ -796,26 +662,17 @@ public:
 
     void OnFishCountUpdated(size_t count) override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnFishCountUpdated(count);
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnFishCountUpdated, count);
     }
 
     void OnPhysicsProbePanelOpened() override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnPhysicsProbePanelOpened();
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnPhysicsProbePanelOpened);
     }
 
     void OnPhysicsProbePanelClosed() override
     {
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnPhysicsProbePanelClosed();
-        }
+        Dispatch(mGenericSinks, &IGenericGameEventHandler::OnPhysicsProbePanelClosed);
     }
 
 public:
@@ -825,6 +682,23 @@ public:
      */
     void Flush()
     {
+        //
+        // Publish deferred events
+        //
+
+        std::vector<std::function<void()>> deferredEvents;
+
+        {
+            std::lock_guard const lock{ mDeferredEventsLock };
+
+            deferredEvents.swap(mDeferredEvents);
+        }
+
+        for (auto const & deferredEvent : deferredEvents)
+        {
+            deferredEvent();
+        }
+
         //
         // Publish aggregations
         //
@@ -958,6 +832,17 @@ public:
         mWatertightDoorClosedEvents.clear();
     }
 
+    /*
+     * Sets the only thread on which events are dispatched right away - the one flushing;
+     * the events fired on any other thread are deferred until the next Flush(). A
+     * default-constructed id stops deferring. Must not be invoked while events are being
+     * fired.
+     */
+    void SetDispatchingThread(std::thread::id threadId)
+    {
+        mDispatchingThreadId = threadId;
+    }
+
     void RegisterLifecycleEventHandler(ILifecycleGameEventHandler * sink)
     {
         mLifecycleSinks.push_back(sink);
@@ -998,6 +883,44 @@ public:
         mGenericSinks.push_back(sink);
     }
 
+private:
+
+    template<typename TSink, typename... TParameters, typename... TArgs>
+    void Dispatch(
+        std::vector<TSink *> const & sinks,
+        void (TSink:: * handler)(TParameters...),
+        TArgs const &... args)
+    {
+        if (mDispatchingThreadId != std::thread::id()
+            && std::this_thread::get_id() != mDispatchingThreadId)
+        {
+            // Several threads might be firing
+            std::lock_guard const lock{ mDeferredEventsLock };
+
+            // Capture copies of the arguments, as references might not outlive the flush
+            mDeferredEvents.emplace_back(
+                [&sinks, handler, capturedArgs = std::make_tuple(args...)]()
+                {
+                    std::apply(
+                        [&sinks, handler](auto const &... capturedArgs)
+                        {
+                            for (auto * sink : sinks)
+                            {
+                                (sink->*handler)(capturedArgs...);
+                            }
+                        },
+                        capturedArgs);
+                });
+        }
+        else
+        {
+            for (auto * sink : sinks)
+            {
+                (sink->*handler)(args...);
+            }
+        }
+    }
+
 private:
 
     // The current events being aggregated
@@ -1020,6 +943,11 @@ private:
     unordered_tuple_map<std::tuple<bool>, unsigned int> mWatertightDoorOpenedEvents;
     unordered_tuple_map<std::tuple<bool>, unsigned int> mWatertightDoorClosedEvents;
 
+    // The events fired on threads other than the dispatching thread, in order
+    std::vector<std::function<void()>> mDeferredEvents;
+    std::mutex mDeferredEventsLock;
+    std::thread::id mDispatchingThreadId;
+
     // The registered sinks
     std::vector<ILifecycleGameEventHandler *> mLifecycleSinks;
     std::vector<IStructuralGameEventHandler *> mStructuralSinks;
@@ -8,6 +8,8 @@
 GameParameters::GameParameters()
     // Dynamics
     : NumMechanicalDynamicsIterationsAdjustment(1.0f)
+    , DoAdaptMechanicalDynamicsIterations(false)
+    , DoFuseSpringRelaxation(false)
     , SpringStiffnessAdjustment(1.0f)
     , SpringDampingAdjustment(1.0f)
     , SpringStrengthAdjustment(1.0f)
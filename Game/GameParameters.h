@@ -101,6 +101,31 @@ struct GameParameters
             * NumMechanicalDynamicsIterationsAdjustment);
     }
 
+    //
+    // When enabled, each ship lowers its own number of mechanical iterations - down to
+    // a fraction of the configured one - while its structure stays calm, and goes back
+    // to the configured number as soon as it's not calm anymore. Calmness is measured via
+    // the RMS of the deviations of the particle accelerations from their mean, as seen
+    // at the end of the spring relaxation.
+    //
+
+    bool DoAdaptMechanicalDynamicsIterations;
+
+    static float constexpr MinAdaptiveMechanicalDynamicsIterationsFraction = 0.5f;
+    static float constexpr AdaptiveMechanicalDynamicsIterationsFractionStep = 0.25f;
+    static float constexpr AdaptiveMechanicalDynamicsIterationsCalmResidual = 0.5f; // m/s^2
+    static float constexpr AdaptiveMechanicalDynamicsIterationsAgitatedResidual = 2.0f; // m/s^2
+    static int constexpr AdaptiveMechanicalDynamicsIterationsCalmSteps = 64; // Before lowering the number of iterations by one step; 1 simulated second
+
+    //
+    // When enabled, large ships whose spring relaxation runs on a single thread run the
+    // spring forces and the integration in one cache-blocked pass, rather than in two
+    // passes over all springs and all points; this only pays off where the spring
+    // relaxation is bound by memory bandwidth.
+    //
+
+    bool DoFuseSpringRelaxation;
+
     float SpringStiffnessAdjustment;
     static float constexpr MinSpringStiffnessAdjustment = 0.001f;
     static float constexpr MaxSpringStiffnessAdjustment = 2.0f;
@@ -561,6 +586,12 @@ struct GameParameters
 
     static_assert(HalfMaxWorldHeight >= MaxSeaDepth); // Make sure deepest bottom of the ocean is visible
 
+    // Ship point positions are stored relative to an origin that follows the ship, and
+    // which we move once the ship has drifted this far away from it. When off, the
+    // origin stays at the center of the world, i.e. positions are absolute
+    static bool constexpr DoUseShipRelativePointPositions = true;
+    static float constexpr MaxShipPointPositionOriginDrift = 64.0f; // m
+
 
     static size_t constexpr MaxGadgets = 64u;
     static size_t constexpr MaxPinnedPoints = 64u;
@@ -11,10 +11,12 @@
 #include "ShipAutoTexturizationSettings.h"
 #include "ShipLoadSpecifications.h"
 #include "ShipMetadata.h"
+#include "TelemetrySink.h"
 
 #include <GameCore/Colors.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
+#include <GameCore/ProgressCallback.h>
 #include <GameCore/UniqueBuffer.h>
 #include <GameCore/Vectors.h>
 
@@ -45,6 +47,17 @@ struct IGameController
     virtual ShipMetadata ResetAndReloadShip(ShipLoadSpecifications const & loadSpecs) = 0;
     virtual ShipMetadata AddShip(ShipLoadSpecifications const & loadSpecs) = 0;
 
+    /*
+     * Asynchronous ship loading: the ship is loaded in the background while the current
+     * world keeps running; once PollShipLoad() - which also reports progress - returns true,
+     * EndResetAndLoadShip() swaps the new world in, or throws if the load has failed.
+     */
+    virtual void BeginResetAndLoadShip(ShipLoadSpecifications const & loadSpecs, ProgressCallback const & progressCallback) = 0;
+    virtual bool PollShipLoad() = 0;
+    virtual ShipMetadata EndResetAndLoadShip() = 0;
+    virtual void CancelShipLoad() = 0;
+    virtual bool IsShipLoadInProgress() const = 0;
+
     virtual RgbImageData TakeScreenshot() = 0;
 
     virtual void RunGameIteration() = 0;
@@ -56,6 +69,10 @@ struct IGameController
     virtual RecordedEvents StopRecordingEvents() = 0;
     virtual void ReplayRecordedEvent(RecordedEvent const & event) = 0;
 
+    virtual void StartTelemetry(
+        std::filesystem::path const & outputFilePath,
+        TelemetrySink::FormatType format) = 0;
+
 
     //
     // Game Control and notifications
@@ -64,6 +81,9 @@ struct IGameController
     virtual void Freeze() = 0;
     virtual void Thaw() = 0;
     virtual void SetPaused(bool isPaused) = 0;
+    virtual void SetFastForward(bool isFastForward) = 0;
+    virtual bool GetSimulationThreaded() const = 0;
+    virtual void SetSimulationThreaded(bool isSimulationThreaded) = 0;
     virtual void SetMoveToolEngaged(bool isEngaged) = 0;
     virtual void DisplaySettingsLoadedNotification() = 0;
 
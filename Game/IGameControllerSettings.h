@@ -33,6 +33,12 @@ struct IGameControllerSettings
     virtual float GetNumMechanicalDynamicsIterationsAdjustment() const = 0;
     virtual void SetNumMechanicalDynamicsIterationsAdjustment(float value) = 0;
 
+    virtual bool GetDoAdaptMechanicalDynamicsIterations() const = 0;
+    virtual void SetDoAdaptMechanicalDynamicsIterations(bool value) = 0;
+
+    virtual bool GetDoFuseSpringRelaxation() const = 0;
+    virtual void SetDoFuseSpringRelaxation(bool value) = 0;
+
     virtual float GetSpringStiffnessAdjustment() const = 0;
     virtual void SetSpringStiffnessAdjustment(float value) = 0;
 
@@ -230,7 +236,7 @@ struct IGameControllerSettings
 
     // Misc
 
-    virtual OceanFloorTerrain const & GetOceanFloorTerrain() const = 0;
+    virtual OceanFloorTerrain GetOceanFloorTerrain() const = 0;
     virtual void SetOceanFloorTerrain(OceanFloorTerrain const & value) = 0;
 
     virtual float GetSeaDepth() const = 0;
@@ -5,7 +5,9 @@
 ***************************************************************************************/
 #include "ImageFileTools.h"
 
+#include <GameCore/Finalizer.h>
 #include <GameCore/GameException.h>
+#include <GameCore/ImageTools.h>
 
 #include <IL/il.h>
 #include <IL/ilu.h>
@@ -17,8 +19,12 @@
 
 bool ImageFileTools::mIsInitialized = false;
 
+std::mutex ImageFileTools::mLibraryLock;
+
 ImageSize ImageFileTools::GetImageSize(std::filesystem::path const & filepath)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     //
     // Load image
     //
@@ -54,6 +60,8 @@ ImageSize ImageFileTools::GetImageSize(std::filesystem::path const & filepath)
 
 RgbaImageData ImageFileTools::LoadImageRgba(std::filesystem::path const & filepath)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     return InternalLoadImage<rgbaColor>(
         InternalOpenImage(filepath),
         IL_RGBA,
@@ -63,6 +71,8 @@ RgbaImageData ImageFileTools::LoadImageRgba(std::filesystem::path const & filepa
 
 RgbImageData ImageFileTools::LoadImageRgb(std::filesystem::path const & filepath)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     return InternalLoadImage<rgbColor>(
         InternalOpenImage(filepath),
         IL_RGB,
@@ -70,10 +80,66 @@ RgbImageData ImageFileTools::LoadImageRgb(std::filesystem::path const & filepath
         std::nullopt);
 }
 
+void ImageFileTools::VisitImageRgb(
+    std::filesystem::path const & filepath,
+    std::function<void(DecodedImageView<rgbColor> const &)> const & visitor)
+{
+    //
+    // Decode image
+    //
+
+    ILuint imageHandle;
+    ImageSize imageSize(0, 0);
+    rgbColor const * imageData;
+    bool isTopDown;
+
+    {
+        std::lock_guard const lock(mLibraryLock);
+
+        imageHandle = InternalOpenImage(filepath);
+
+        try
+        {
+            InternalConvertImage(IL_RGB);
+        }
+        catch (...)
+        {
+            ilDeleteImage(imageHandle);
+            throw;
+        }
+
+        imageSize = ImageSize(
+            ilGetInteger(IL_IMAGE_WIDTH),
+            ilGetInteger(IL_IMAGE_HEIGHT));
+
+        assert(ilGetInteger(IL_IMAGE_BYTES_PER_PIXEL) == sizeof(rgbColor));
+
+        imageData = reinterpret_cast<rgbColor const *>(ilGetData());
+        isTopDown = (ilGetInteger(IL_IMAGE_ORIGIN) != IL_ORIGIN_LOWER_LEFT);
+    }
+
+    // Delete image at the end of the visit, whatever happens during it
+    Finalizer const deleteImage(
+        [imageHandle]()
+        {
+            std::lock_guard const lock(mLibraryLock);
+
+            ilDeleteImage(imageHandle);
+        });
+
+    //
+    // Visit image - outside of the lock, as nothing else touches this image's buffer
+    //
+
+    visitor(DecodedImageView<rgbColor>(imageSize, imageData, isTopDown));
+}
+
 RgbaImageData ImageFileTools::LoadImageRgbaAndMagnify(
     std::filesystem::path const & filepath,
     int magnificationFactor)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     return InternalLoadImage<rgbaColor>(
         InternalOpenImage(filepath),
         IL_RGBA,
@@ -92,38 +158,38 @@ RgbaImageData ImageFileTools::LoadImageRgbaAndResize(
     std::filesystem::path const & filepath,
     int resizedWidth)
 {
-    return InternalLoadImage<rgbaColor>(
-        InternalOpenImage(filepath),
-        IL_RGBA,
-        IL_ORIGIN_LOWER_LEFT,
-        ResizeInfo(
-            [resizedWidth](ImageSize const & originalImageSize)
-            {
-                return ImageSize(
-                    resizedWidth,
-                    static_cast<int>(
-                        round(
-                            static_cast<float>(originalImageSize.height)
-                            / static_cast<float>(originalImageSize.width)
-                            * static_cast<float>(resizedWidth))));
-            },
-            ILU_BILINEAR));
+    // Decode under the lock, but resize outside of it - we do it ourselves
+    RgbaImageData image = LoadImageRgba(filepath);
+
+    ImageSize const newImageSize(
+        resizedWidth,
+        static_cast<int>(
+            round(
+                static_cast<float>(image.Size.height)
+                / static_cast<float>(image.Size.width)
+                * static_cast<float>(resizedWidth))));
+
+    return ImageTools::Resize(std::move(image), newImageSize);
 }
 
 RgbaImageData ImageFileTools::LoadImageRgbaAndResize(
     std::filesystem::path const & filepath,
     ImageSize const & maxSize)
 {
-    return InternalLoadImageAndResize<rgbaColor>(
-        InternalOpenImage(filepath),
-        IL_RGBA,
-        maxSize);
+    // Decode under the lock, but resize outside of it - we do it ourselves
+    RgbaImageData image = LoadImageRgba(filepath);
+
+    ImageSize const newImageSize = CalculateShrunkSize(image.Size, maxSize);
+
+    return ImageTools::Resize(std::move(image), newImageSize);
 }
 
 RgbImageData ImageFileTools::LoadImageRgbAndResize(
     std::filesystem::path const & filepath,
     ImageSize const & maxSize)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     return InternalLoadImageAndResize<rgbColor>(
         InternalOpenImage(filepath),
         IL_RGB,
@@ -134,6 +200,8 @@ void ImageFileTools::SavePngImage(
     RgbaImageData const & image,
     std::filesystem::path filepath)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     InternalSavePngImage(
         image.Size,
         image.Data.get(),
@@ -146,6 +214,8 @@ void ImageFileTools::SavePngImage(
     RgbImageData const & image,
     std::filesystem::path filepath)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     InternalSavePngImage(
         image.Size,
         image.Data.get(),
@@ -156,6 +226,8 @@ void ImageFileTools::SavePngImage(
 
 RgbaImageData ImageFileTools::DecodePngImage(DeSerializationBuffer<BigEndianess> const & buffer)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     return InternalLoadImage<rgbaColor>(
         InternalOpenImage(buffer, IL_PNG),
         IL_RGBA,
@@ -167,16 +239,20 @@ RgbaImageData ImageFileTools::DecodePngImageAndResize(
     DeSerializationBuffer<BigEndianess> const & buffer,
     ImageSize const & maxSize)
 {
-    return InternalLoadImageAndResize<rgbaColor>(
-        InternalOpenImage(buffer, IL_PNG),
-        IL_RGBA,
-        maxSize);
+    // Decode under the lock, but resize outside of it - we do it ourselves
+    RgbaImageData image = DecodePngImage(buffer);
+
+    ImageSize const newImageSize = CalculateShrunkSize(image.Size, maxSize);
+
+    return ImageTools::Resize(std::move(image), newImageSize);
 }
 
 size_t ImageFileTools::EncodePngImage(
     RgbaImageData const & image,
     DeSerializationBuffer<BigEndianess> & buffer)
 {
+    std::lock_guard const lock(mLibraryLock);
+
     CheckInitialized();
 
     ILuint imageHandle;
@@ -283,6 +359,36 @@ unsigned int ImageFileTools::InternalOpenImage(
     return static_cast<unsigned int>(imghandle);
 }
 
+void ImageFileTools::InternalConvertImage(int targetFormat)
+{
+    int const imageFormat = ilGetInteger(IL_IMAGE_FORMAT);
+    int const imageType = ilGetInteger(IL_IMAGE_TYPE);
+    if (targetFormat != imageFormat || IL_UNSIGNED_BYTE != imageType)
+    {
+        if (!ilConvertImage(targetFormat, IL_UNSIGNED_BYTE))
+        {
+            ILint devilError = ilGetError();
+            std::string devilErrorMessage(iluErrorString(devilError));
+            throw GameException("Could not convert image: " + devilErrorMessage);
+        }
+    }
+}
+
+ImageSize ImageFileTools::CalculateShrunkSize(
+    ImageSize const & originalImageSize,
+    ImageSize const & maxSize)
+{
+    float wShrinkFactor = static_cast<float>(maxSize.width) / static_cast<float>(originalImageSize.width);
+    float hShrinkFactor = static_cast<float>(maxSize.height) / static_cast<float>(originalImageSize.height);
+    float shrinkFactor = std::min(
+        std::min(wShrinkFactor, hShrinkFactor),
+        1.0f);
+
+    return ImageSize(
+        static_cast<int>(round(static_cast<float>(originalImageSize.width) * shrinkFactor)),
+        static_cast<int>(round(static_cast<float>(originalImageSize.height) * shrinkFactor)));
+}
+
 template <typename TColor>
 ImageData<TColor> ImageFileTools::InternalLoadImageAndResize(
     unsigned int imageHandle,
@@ -296,15 +402,7 @@ ImageData<TColor> ImageFileTools::InternalLoadImageAndResize(
         ResizeInfo(
             [maxSize](ImageSize const & originalImageSize)
             {
-                float wShrinkFactor = static_cast<float>(maxSize.width) / static_cast<float>(originalImageSize.width);
-                float hShrinkFactor = static_cast<float>(maxSize.height) / static_cast<float>(originalImageSize.height);
-                float shrinkFactor = std::min(
-                    std::min(wShrinkFactor, hShrinkFactor),
-                    1.0f);
-
-                return ImageSize(
-                    static_cast<int>(round(static_cast<float>(originalImageSize.width) * shrinkFactor)),
-                    static_cast<int>(round(static_cast<float>(originalImageSize.height) * shrinkFactor)));
+                return CalculateShrunkSize(originalImageSize, maxSize);
             },
             ILU_BILINEAR));
 }
@@ -320,20 +418,13 @@ ImageData<TColor> ImageFileTools::InternalLoadImage(
     // Check if we need to convert it
     //
 
-    int imageFormat = ilGetInteger(IL_IMAGE_FORMAT);
-    int imageType = ilGetInteger(IL_IMAGE_TYPE);
-    if (targetFormat != imageFormat || IL_UNSIGNED_BYTE != imageType)
-    {
-        if (!ilConvertImage(targetFormat, IL_UNSIGNED_BYTE))
-        {
-            ILint devilError = ilGetError();
-            std::string devilErrorMessage(iluErrorString(devilError));
-            throw GameException("Could not convert image: " + devilErrorMessage);
-        }
-    }
+    InternalConvertImage(targetFormat);
 
+    // When we're not resizing, we flip while copying the data out, rather than
+    // making an extra pass over the image
     int imageOrigin = ilGetInteger(IL_IMAGE_ORIGIN);
-    if (targetOrigin != imageOrigin)
+    bool const doFlipWhileCopying = (targetOrigin != imageOrigin) && !resizeInfo;
+    if (targetOrigin != imageOrigin && !doFlipWhileCopying)
     {
         iluFlipImage();
     }
@@ -376,7 +467,21 @@ ImageData<TColor> ImageFileTools::InternalLoadImage(
 
     ILubyte const * imageData = ilGetData();
     auto data = std::make_unique<TColor[]>(imageSize.width * imageSize.height);
-    std::memcpy(static_cast<void *>(data.get()), imageData, imageSize.width * imageSize.height * bpp);
+    if (doFlipWhileCopying)
+    {
+        size_t const rowByteSize = static_cast<size_t>(imageSize.width) * bpp;
+        for (int y = 0; y < imageSize.height; ++y)
+        {
+            std::memcpy(
+                static_cast<void *>(data.get() + static_cast<size_t>(imageSize.height - 1 - y) * imageSize.width),
+                imageData + static_cast<size_t>(y) * rowByteSize,
+                rowByteSize);
+        }
+    }
+    else
+    {
+        std::memcpy(static_cast<void *>(data.get()), imageData, imageSize.width * imageSize.height * bpp);
+    }
 
     //
     // Delete image
@@ -8,8 +8,10 @@
 #include <GameCore/DeSerializationBuffer.h>
 #include <GameCore/ImageData.h>
 
+#include <cassert>
 #include <filesystem>
 #include <functional>
+#include <mutex>
 #include <optional>
 
 /*
@@ -20,8 +22,55 @@ class ImageFileTools
 {
 public:
 
+    /*
+     * A read-only view of an image as decoded by the image library, in the library's
+     * own buffer; rows are addressed bottom-to-top, as in ImageData.
+     */
+    template <typename TColor>
+    struct DecodedImageView
+    {
+    public:
+
+        ImageSize const Size;
+
+        TColor const * GetRow(int y) const
+        {
+            assert(y >= 0 && y < Size.height);
+
+            int const dataY = mIsTopDown ? (Size.height - 1 - y) : y;
+            return mData + static_cast<size_t>(dataY) * static_cast<size_t>(Size.width);
+        }
+
+    private:
+
+        DecodedImageView(
+            ImageSize const & size,
+            TColor const * data,
+            bool isTopDown)
+            : Size(size)
+            , mData(data)
+            , mIsTopDown(isTopDown)
+        {}
+
+        TColor const * const mData;
+        bool const mIsTopDown;
+
+        friend class ImageFileTools;
+    };
+
     static ImageSize GetImageSize(std::filesystem::path const & filepath);
 
+    /*
+     * Decodes an image and hands it to the visitor directly out of the image library's
+     * buffer, saving the copy into an ImageData; the view is only valid during the visit.
+     *
+     * The visit itself does not hold the image library's lock, hence multiple images
+     * may be visited concurrently.
+     */
+    static void VisitImageRgb(
+        std::filesystem::path const & filepath,
+        std::function<void(DecodedImageView<rgbColor> const &)> const & visitor);
+
     static RgbaImageData LoadImageRgba(std::filesystem::path const & filepath);
     static RgbImageData LoadImageRgb(std::filesystem::path const & filepath);
     static RgbaImageData LoadImageRgbaAndMagnify(std::filesystem::path const & filepath, int magnificationFactor);
@@ -57,6 +106,8 @@ private:
         DeSerializationBuffer<BigEndianess> const & buffer,
         unsigned int imageType);
 
+    static void InternalConvertImage(int targetFormat);
+
     struct ResizeInfo
     {
         std::function<ImageSize(ImageSize const &)> ResizeHandler;
@@ -70,6 +121,10 @@ private:
         {}
     };
 
+    static ImageSize CalculateShrunkSize(
+        ImageSize const & originalImageSize,
+        ImageSize const & maxSize);
+
     template <typename TColor>
     static ImageData<TColor> InternalLoadImageAndResize(
         unsigned int imageHandle,
@@ -93,4 +148,7 @@ private:
 private:
 
     static bool mIsInitialized;
+
+    // The image library is not thread-safe
+    static std::mutex mLibraryLock;
 };
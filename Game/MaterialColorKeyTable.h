@@ -0,0 +1,192 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-02
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/Colors.h>
+#include <GameCore/GameTypes.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+ * Flat, open-addressing hash table from material color keys to materials.
+ *
+ * Built once and never modified; lookups probe a small, contiguous array of packed
+ * 24-bit color keys - rather than chasing the nodes of a std::map - and only touch
+ * the parallel array of material pointers on a hit.
+ */
+template<typename TMaterial>
+class MaterialColorKeyTable
+{
+public:
+
+    MaterialColorKeyTable()
+        : MaterialColorKeyTable(std::vector<std::pair<MaterialColorKey, TMaterial const *>>())
+    {}
+
+    explicit MaterialColorKeyTable(std::map<MaterialColorKey, TMaterial> const & materialMap)
+        : MaterialColorKeyTable(MakeEntries(materialMap))
+    {}
+
+    /*
+     * In case of duplicate color keys, the first entry wins.
+     */
+    explicit MaterialColorKeyTable(std::vector<std::pair<MaterialColorKey, TMaterial const *>> const & entries)
+        : mCapacityMask(CalculateCapacity(entries.size()) - 1)
+        , mHashShift(CalculateHashShift(mCapacityMask + 1))
+        , mKeys(new std::uint32_t[mCapacityMask + 1])
+        , mMaterials(new TMaterial const *[mCapacityMask + 1])
+        , mSize(0)
+    {
+        std::fill(mKeys.get(), mKeys.get() + mCapacityMask + 1, EmptySlotKey);
+        std::fill(mMaterials.get(), mMaterials.get() + mCapacityMask + 1, nullptr);
+
+        for (auto const & entry : entries)
+        {
+            std::uint32_t const key = PackKey(entry.first);
+
+            size_t slot = GetHomeSlot(key);
+            while (mKeys[slot] != EmptySlotKey && mKeys[slot] != key)
+            {
+                slot = (slot + 1) & mCapacityMask;
+            }
+
+            if (mKeys[slot] == EmptySlotKey)
+            {
+                mKeys[slot] = key;
+                mMaterials[slot] = entry.second;
+                ++mSize;
+            }
+        }
+    }
+
+    MaterialColorKeyTable(MaterialColorKeyTable && other) = default;
+    MaterialColorKeyTable & operator=(MaterialColorKeyTable && other) = default;
+
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+    inline TMaterial const * Find(MaterialColorKey const & colorKey) const
+    {
+        std::uint32_t const key = PackKey(colorKey);
+
+        // Load factor is at most 0.5, hence there's always an empty slot to stop at
+        for (size_t slot = GetHomeSlot(key); ; slot = (slot + 1) & mCapacityMask)
+        {
+            std::uint32_t const slotKey = mKeys[slot];
+            if (slotKey == key)
+            {
+                return mMaterials[slot];
+            }
+            else if (slotKey == EmptySlotKey)
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    /*
+     * Resolves a whole run of color keys at once - e.g. a row of an image - storing
+     * nullptr for keys that are not found. Repeated keys - very common in
+     * ship images - are only looked up once.
+     */
+    void Find(
+        MaterialColorKey const * colorKeys,
+        size_t count,
+        TMaterial const ** materials) const
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        MaterialColorKey previousColorKey = colorKeys[0];
+        TMaterial const * previousMaterial = Find(previousColorKey);
+        materials[0] = previousMaterial;
+
+        for (size_t i = 1; i < count; ++i)
+        {
+            if (colorKeys[i] != previousColorKey)
+            {
+                previousColorKey = colorKeys[i];
+                previousMaterial = Find(previousColorKey);
+            }
+
+            materials[i] = previousMaterial;
+        }
+    }
+
+private:
+
+    // Not a valid packed 24-bit key
+    static std::uint32_t constexpr EmptySlotKey = 0xffffffffu;
+
+    static inline std::uint32_t PackKey(MaterialColorKey const & colorKey)
+    {
+        return (static_cast<std::uint32_t>(colorKey.r) << 16)
+            | (static_cast<std::uint32_t>(colorKey.g) << 8)
+            | static_cast<std::uint32_t>(colorKey.b);
+    }
+
+    inline size_t GetHomeSlot(std::uint32_t key) const
+    {
+        // Fibonacci hashing: the top bits of the product are well-mixed
+        return static_cast<size_t>((key * 2654435769u) >> mHashShift);
+    }
+
+    static size_t CalculateCapacity(size_t entryCount)
+    {
+        // Keep load factor at or below 0.5
+        size_t capacity = 16;
+        while (capacity < entryCount * 2)
+        {
+            capacity *= 2;
+        }
+
+        return capacity;
+    }
+
+    static int CalculateHashShift(size_t capacity)
+    {
+        int shift = 32;
+        while (capacity > 1)
+        {
+            capacity >>= 1;
+            --shift;
+        }
+
+        return shift;
+    }
+
+    static std::vector<std::pair<MaterialColorKey, TMaterial const *>> MakeEntries(std::map<MaterialColorKey, TMaterial> const & materialMap)
+    {
+        std::vector<std::pair<MaterialColorKey, TMaterial const *>> entries;
+        entries.reserve(materialMap.size());
+        for (auto const & entry : materialMap)
+        {
+            entries.emplace_back(entry.first, &(entry.second));
+        }
+
+        return entries;
+    }
+
+private:
+
+    size_t mCapacityMask;
+    int mHashShift;
+
+    std::unique_ptr<std::uint32_t[]> mKeys;
+    std::unique_ptr<TMaterial const *[]> mMaterials;
+    size_t mSize;
+};
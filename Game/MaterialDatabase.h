@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "MaterialColorKeyTable.h"
 #include "Materials.h"
 #include "ResourceLocator.h"
 
@@ -122,22 +123,35 @@ public:
 
     StructuralMaterial const * FindStructuralMaterial(MaterialColorKey const & colorKey) const
     {
-        if (auto srchIt = mStructuralMaterialMap.find(colorKey);
-            srchIt != mStructuralMaterialMap.end())
+        if (StructuralMaterial const * const material = mStructuralMaterialTable.Find(colorKey);
+            material != nullptr)
         {
             // Found color key verbatim!
-            return &(srchIt->second);
+            return material;
         }
 
         // Check whether it's a rope endpoint
-        if (colorKey.r == mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first.r
-            && ((colorKey.g & 0xF0) == (mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first.g & 0xF0)))
+        return FindRopeEndpointStructuralMaterial(colorKey);
+    }
+
+    /*
+     * Batch version of FindStructuralMaterial, e.g. for a whole row of an image.
+     */
+    void FindStructuralMaterials(
+        MaterialColorKey const * colorKeys,
+        size_t count,
+        StructuralMaterial const ** structuralMaterials) const
+    {
+        mStructuralMaterialTable.Find(colorKeys, count, structuralMaterials);
+
+        for (size_t i = 0; i < count; ++i)
         {
-            return mUniqueStructuralMaterials[RopeUniqueMaterialIndex].second;
+            if (structuralMaterials[i] == nullptr)
+            {
+                // Check whether it's a rope endpoint
+                structuralMaterials[i] = FindRopeEndpointStructuralMaterial(colorKeys[i]);
+            }
         }
-
-        // No luck
-        return nullptr;
     }
 
     MaterialMap<StructuralMaterial> const & GetStructuralMaterialMap() const
@@ -145,6 +159,11 @@ public:
         return mStructuralMaterialMap;
     }
 
+    MaterialColorKeyTable<StructuralMaterial> const & GetStructuralMaterialTable() const
+    {
+        return mStructuralMaterialTable;
+    }
+
     Palette<StructuralMaterial> const & GetStructuralMaterialPalette() const
     {
         return mStructuralMaterialPalette;
@@ -159,15 +178,7 @@ public:
 
     ElectricalMaterial const * FindElectricalMaterial(MaterialColorKey const & colorKey) const
     {
-        if (auto srchIt = mElectricalMaterialMap.find(colorKey);
-            srchIt != mElectricalMaterialMap.end())
-        {
-            // Found color key verbatim!
-            return &(srchIt->second);
-        }
-
-        // No luck
-        return nullptr;
+        return mElectricalMaterialTable.Find(colorKey);
     }
 
     ElectricalMaterial const * FindElectricalMaterialLegacy(MaterialColorKey const & colorKey) const
@@ -181,14 +192,7 @@ public:
         }
 
         // Try just instanced now (i.e. matching on r and g only)
-        if (auto srchIt = mInstancedElectricalMaterialMap.find(colorKey);
-            srchIt != mInstancedElectricalMaterialMap.end())
-        {
-            return srchIt->second;
-        }
-
-        // No luck
-        return nullptr;
+        return mInstancedElectricalMaterialTable.Find(MakeInstancedColorKey(colorKey));
     }
 
     MaterialMap<ElectricalMaterial> const & GetElectricalMaterialMap() const
@@ -196,6 +200,11 @@ public:
         return mElectricalMaterialMap;
     }
 
+    MaterialColorKeyTable<ElectricalMaterial> const & GetElectricalMaterialTable() const
+    {
+        return mElectricalMaterialTable;
+    }
+
     Palette<ElectricalMaterial> const & GetElectricalMaterialPalette() const
     {
         return mElectricalMaterialPalette;
@@ -248,6 +257,37 @@ private:
         }
     };
 
+    StructuralMaterial const * FindRopeEndpointStructuralMaterial(MaterialColorKey const & colorKey) const
+    {
+        if (colorKey.r == mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first.r
+            && ((colorKey.g & 0xF0) == (mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first.g & 0xF0)))
+        {
+            return mUniqueStructuralMaterials[RopeUniqueMaterialIndex].second;
+        }
+
+        // No luck
+        return nullptr;
+    }
+
+    static MaterialColorKey MakeInstancedColorKey(MaterialColorKey const & colorKey)
+    {
+        // Instanced materials are matched on r and g only
+        return MaterialColorKey(colorKey.r, colorKey.g, 0);
+    }
+
+    static MaterialColorKeyTable<ElectricalMaterial> MakeInstancedElectricalMaterialTable(
+        std::map<MaterialColorKey, ElectricalMaterial const *, InstancedColorKeyComparer> const & instancedElectricalMaterialMap)
+    {
+        std::vector<std::pair<MaterialColorKey, ElectricalMaterial const *>> entries;
+        entries.reserve(instancedElectricalMaterialMap.size());
+        for (auto const & entry : instancedElectricalMaterialMap)
+        {
+            entries.emplace_back(MakeInstancedColorKey(entry.first), entry.second);
+        }
+
+        return MaterialColorKeyTable<ElectricalMaterial>(entries);
+    }
+
 private:
 
     MaterialDatabase(
@@ -269,6 +309,9 @@ private:
         , mUniqueStructuralMaterials(uniqueStructuralMaterials)
         , mLargestMass(largestMass)
         , mLargestStrength(largestStrength)
+        , mStructuralMaterialTable(mStructuralMaterialMap)
+        , mElectricalMaterialTable(mElectricalMaterialMap)
+        , mInstancedElectricalMaterialTable(MakeInstancedElectricalMaterialTable(mInstancedElectricalMaterialMap))
     {
     }
 
@@ -287,4 +330,9 @@ private:
     UniqueStructuralMaterialsArray mUniqueStructuralMaterials;
     float mLargestMass;
     float mLargestStrength;
+
+    // Lookup tables, pointing into the maps above - whose nodes survive moves
+    MaterialColorKeyTable<StructuralMaterial> mStructuralMaterialTable;
+    MaterialColorKeyTable<ElectricalMaterial> mElectricalMaterialTable;
+    MaterialColorKeyTable<ElectricalMaterial> mInstancedElectricalMaterialTable;
 };
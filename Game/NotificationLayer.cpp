@@ -71,6 +71,7 @@ void NotificationLayer::SetStatusTexts(
     PerfStats const & totalPerfStats,
     std::chrono::duration<float> elapsedGameSeconds,
     bool isPaused,
+    std::optional<float> fastForwardSimulationSpeed,
     float zoom,
     vec2f const & camera,
     Render::RenderStatistics renderStats)
@@ -95,6 +96,8 @@ void NotificationLayer::SetStatusTexts(
 
         if (isPaused)
             ss << " (PAUSED)";
+        else if (fastForwardSimulationSpeed.has_value())
+            ss << " (FF x" << *fastForwardSimulationSpeed << ")";
 
 		mStatusTextLines[0] = ss.str();
 
@@ -119,7 +122,8 @@ void NotificationLayer::SetStatusTexts(
 				<< "UPD:" << totalPerfStats.TotalUpdateDuration.ToRatio<std::chrono::milliseconds>() << "MS"
 				<< " (W=" << lastDeltaPerfStats.TotalWaitForRenderUploadDuration.ToRatio<std::chrono::milliseconds>() << "MS +"
 				<< " " << totalNetUpdate << "MS"
-				<< " (S=" << shipsSpringsUpdatePercent << "%))"
+				<< " (S=" << shipsSpringsUpdatePercent << "%"
+				<< " IT=" << lastDeltaPerfStats.ShipsMechanicalDynamicsIterations.ToAverage() << "))"
 				<< " UPL:(W=" << lastDeltaPerfStats.TotalWaitForRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << "MS +"
 				<< " " << lastDeltaPerfStats.TotalNetRenderUploadDuration.ToRatio<std::chrono::milliseconds>() << "MS)"
 				;
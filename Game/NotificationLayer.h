@@ -43,6 +43,7 @@ public:
         PerfStats const & totalPerfStats,
         std::chrono::duration<float> elapsedGameSeconds,
         bool isPaused,
+        std::optional<float> fastForwardSimulationSpeed, // Simulated seconds per real second, when fast-forwarding
         float zoom,
         vec2f const & camera,
         Render::RenderStatistics renderStats);
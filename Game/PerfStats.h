@@ -73,6 +73,15 @@ struct PerfStats
                 / static_cast<float>(ratio.Denominator);
         }
 
+        template<typename TDuration>
+        inline float ToDuration() const
+        {
+            _Ratio const ratio = mRatio.load();
+
+            auto fs = std::chrono::duration_cast<std::chrono::duration<float>>(ratio.Duration);
+            return fs.count() * static_cast<float>(TDuration::period::den) / static_cast<float>(TDuration::period::num);
+        }
+
         inline void Reset()
         {
             mRatio.store(_Ratio());
@@ -92,6 +101,84 @@ struct PerfStats
         }
     };
 
+    struct Average
+    {
+    private:
+
+        struct _Average
+        {
+            size_t Sum;
+            size_t Count;
+
+            _Average() noexcept
+                : Sum(0)
+                , Count(0)
+            {}
+
+            _Average(
+                size_t sum,
+                size_t count)
+                : Sum(sum)
+                , Count(count)
+            {}
+        };
+
+        std::atomic<_Average> mAverage;
+
+    public:
+
+        Average()
+            : mAverage()
+        {}
+
+        Average(Average const & other)
+        {
+            mAverage.store(other.mAverage.load());
+        }
+
+        Average const & operator=(Average const & other)
+        {
+            mAverage.store(other.mAverage.load());
+            return *this;
+        }
+
+        inline void Update(size_t value)
+        {
+            auto average = mAverage.load();
+            average.Sum += value;
+            average.Count += 1;
+            mAverage.store(average);
+        }
+
+        inline float ToAverage() const
+        {
+            _Average const average = mAverage.load();
+
+            if (average.Count == 0)
+                return 0.0f;
+
+            return static_cast<float>(average.Sum) / static_cast<float>(average.Count);
+        }
+
+        inline void Reset()
+        {
+            mAverage.store(_Average());
+        }
+
+        friend Average operator-(Average const & lhs, Average const & rhs)
+        {
+            auto const lAverage = lhs.mAverage.load();
+            auto const rAverage = rhs.mAverage.load();
+            _Average result(
+                lAverage.Sum - rAverage.Sum,
+                lAverage.Count - rAverage.Count);
+
+            Average res;
+            res.mAverage.store(result);
+            return res;
+        }
+    };
+
     // Update
     Ratio TotalUpdateDuration;
     Ratio TotalFishUpdateDuration;
@@ -100,6 +187,7 @@ struct PerfStats
     Ratio TotalShipsSpringsUpdateDuration;
     Ratio TotalWaitForRenderUploadDuration;
     Ratio TotalNetUpdateDuration; // = TotalUpdateDuration - TotalWaitForRenderUploadDuration
+    Average ShipsMechanicalDynamicsIterations; // Per ship, per update
 
     // Render-Upload
     Ratio TotalWaitForRenderDrawDuration;
@@ -124,6 +212,7 @@ struct PerfStats
         TotalShipsSpringsUpdateDuration.Reset();
         TotalWaitForRenderUploadDuration.Reset();
         TotalNetUpdateDuration.Reset();
+        ShipsMechanicalDynamicsIterations.Reset();
 
         TotalWaitForRenderDrawDuration.Reset();
         TotalNetRenderUploadDuration.Reset();
@@ -147,6 +236,7 @@ inline PerfStats operator-(PerfStats const & lhs, PerfStats const & rhs)
     perfStats.TotalShipsSpringsUpdateDuration = lhs.TotalShipsSpringsUpdateDuration - rhs.TotalShipsSpringsUpdateDuration;
     perfStats.TotalWaitForRenderUploadDuration = lhs.TotalWaitForRenderUploadDuration - rhs.TotalWaitForRenderUploadDuration;
     perfStats.TotalNetUpdateDuration = lhs.TotalNetUpdateDuration - rhs.TotalNetUpdateDuration;
+    perfStats.ShipsMechanicalDynamicsIterations = lhs.ShipsMechanicalDynamicsIterations - rhs.ShipsMechanicalDynamicsIterations;
 
     perfStats.TotalWaitForRenderDrawDuration = lhs.TotalWaitForRenderDrawDuration - rhs.TotalWaitForRenderDrawDuration;
     perfStats.TotalNetRenderUploadDuration = lhs.TotalNetRenderUploadDuration - rhs.TotalNetRenderUploadDuration;
@@ -0,0 +1,139 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-20
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/*
+ * The neighbors of each point - one per connected spring - laid out contiguously in
+ * compressed sparse row form, together with the per-spring quantities that the diffusion
+ * kernels (water, heat, and internal pressure) need and that only change when the
+ * structure changes.
+ *
+ * Points are added in index order; the neighbors of a point are in the same order as the
+ * point's connected springs, so that the kernels visit them in the same order as when they
+ * walk the connected springs.
+ */
+class PointNeighborStencil
+{
+public:
+
+    PointNeighborStencil()
+        : mPointOffsets(1, 0)
+        , mNeighborPointIndices()
+        , mSpringIndices()
+        , mWaterPermeabilities()
+        , mRestLengthReciprocals()
+        , mThermalConductances()
+    {}
+
+    void Clear()
+    {
+        mPointOffsets.clear();
+        mPointOffsets.push_back(0);
+
+        mNeighborPointIndices.clear();
+        mSpringIndices.clear();
+        mWaterPermeabilities.clear();
+        mRestLengthReciprocals.clear();
+        mThermalConductances.clear();
+    }
+
+    void Reserve(
+        ElementCount pointCount,
+        size_t neighborCount)
+    {
+        mPointOffsets.reserve(static_cast<size_t>(pointCount) + 1);
+
+        mNeighborPointIndices.reserve(neighborCount);
+        mSpringIndices.reserve(neighborCount);
+        mWaterPermeabilities.reserve(neighborCount);
+        mRestLengthReciprocals.reserve(neighborCount);
+        mThermalConductances.reserve(neighborCount);
+    }
+
+    /*
+     * Adds a neighbor to the point currently being added.
+     *
+     * The thermal conductance is the spring's thermal conductivity divided by its rest length.
+     */
+    inline void AddNeighbor(
+        ElementIndex neighborPointIndex,
+        ElementIndex springIndex,
+        float waterPermeability,
+        float restLengthReciprocal,
+        float thermalConductance)
+    {
+        mNeighborPointIndices.push_back(neighborPointIndex);
+        mSpringIndices.push_back(springIndex);
+        mWaterPermeabilities.push_back(waterPermeability);
+        mRestLengthReciprocals.push_back(restLengthReciprocal);
+        mThermalConductances.push_back(thermalConductance);
+    }
+
+    /*
+     * Completes the point currently being added; the next neighbors belong to the next point.
+     */
+    inline void EndPoint()
+    {
+        mPointOffsets.push_back(static_cast<ElementIndex>(mNeighborPointIndices.size()));
+    }
+
+    ElementCount GetPointCount() const
+    {
+        return static_cast<ElementCount>(mPointOffsets.size() - 1);
+    }
+
+    size_t GetNeighborCount() const
+    {
+        return mNeighborPointIndices.size();
+    }
+
+    // The neighbors of point p are at [offsets[p], offsets[p + 1])
+    ElementIndex const * GetPointOffsets() const
+    {
+        return mPointOffsets.data();
+    }
+
+    ElementIndex const * GetNeighborPointIndices() const
+    {
+        return mNeighborPointIndices.data();
+    }
+
+    ElementIndex const * GetSpringIndices() const
+    {
+        return mSpringIndices.data();
+    }
+
+    float const * GetWaterPermeabilities() const
+    {
+        return mWaterPermeabilities.data();
+    }
+
+    float const * GetRestLengthReciprocals() const
+    {
+        return mRestLengthReciprocals.data();
+    }
+
+    float const * GetThermalConductances() const
+    {
+        return mThermalConductances.data();
+    }
+
+private:
+
+    std::vector<ElementIndex> mPointOffsets;
+
+    std::vector<ElementIndex> mNeighborPointIndices;
+    std::vector<ElementIndex> mSpringIndices;
+    std::vector<float> mWaterPermeabilities;
+    std::vector<float> mRestLengthReciprocals;
+    std::vector<float> mThermalConductances;
+};
@@ -34,7 +34,7 @@ void Points::Add(
     mMaterialsBuffer.emplace_back(&structuralMaterial, electricalMaterial);
     mIsRopeBuffer.emplace_back(isRope);
 
-    mPositionBuffer.emplace_back(position);
+    mPositionBuffer.emplace_back(position - mPositionOrigin);
     mFactoryPositionBuffer.emplace_back(position);
     mVelocityBuffer.emplace_back(vec2f::zero());
     // First buffer implicitly
@@ -151,7 +151,7 @@ void Points::CreateEphemeralParticleAirBubble(
 
     assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&airStructuralMaterial, nullptr);
-    mPositionBuffer[pointIndex] = position;
+    mPositionBuffer[pointIndex] = position - mPositionOrigin;
     mVelocityBuffer[pointIndex] = vec2f::zero();
     assert(mDynamicForceBuffers[0][pointIndex] == vec2f::zero()); // Ephemeral points never participate in dynamic forces (springs + surface pressure)
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -230,7 +230,7 @@ void Points::CreateEphemeralParticleDebris(
 
     assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&structuralMaterial, nullptr);
-    mPositionBuffer[pointIndex] = position;
+    mPositionBuffer[pointIndex] = position - mPositionOrigin;
     mVelocityBuffer[pointIndex] = velocity;
     assert(mDynamicForceBuffers[0][pointIndex] == vec2f::zero()); // Ephemeral points never participate in springs + surface pressure
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -317,7 +317,7 @@ void Points::CreateEphemeralParticleSmoke(
 
     assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&airStructuralMaterial, nullptr);
-    mPositionBuffer[pointIndex] = position;
+    mPositionBuffer[pointIndex] = position - mPositionOrigin;
     mVelocityBuffer[pointIndex] = vec2f::zero();
     assert(mDynamicForceBuffers[0][pointIndex] == vec2f::zero()); // Ephemeral points never participate in springs nor surface pressure
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -396,7 +396,7 @@ void Points::CreateEphemeralParticleSparkle(
 
     assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&structuralMaterial, nullptr);
-    mPositionBuffer[pointIndex] = position;
+    mPositionBuffer[pointIndex] = position - mPositionOrigin;
     mVelocityBuffer[pointIndex] = velocity;
     assert(mDynamicForceBuffers[0][pointIndex] == vec2f::zero()); // Ephemeral points never participate in springs + surface pressure
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -469,7 +469,7 @@ void Points::CreateEphemeralParticleWakeBubble(
 
     assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&waterStructuralMaterial, nullptr);
-    mPositionBuffer[pointIndex] = position;
+    mPositionBuffer[pointIndex] = position - mPositionOrigin;
     mVelocityBuffer[pointIndex] = velocity;
     assert(mDynamicForceBuffers[0][pointIndex] == vec2f::zero()); // Ephemeral points never participate in springs + surface pressure
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -1705,7 +1705,7 @@ void Points::UpdateHighlights(GameWallClock::float_time currentWallClockTime)
 void Points::Query(ElementIndex pointElementIndex) const
 {
     LogMessage("PointIndex: ", pointElementIndex, (nullptr != mMaterialsBuffer[pointElementIndex].Structural) ? (" (" + mMaterialsBuffer[pointElementIndex].Structural->Name) + ")" : "");
-    LogMessage("P=", mPositionBuffer[pointElementIndex].toString(), " V=", mVelocityBuffer[pointElementIndex].toString());
+    LogMessage("P=", GetPosition(pointElementIndex).toString(), " V=", mVelocityBuffer[pointElementIndex].toString());
     LogMessage("M=", mMassBuffer[pointElementIndex], " IP=", mInternalPressureBuffer[pointElementIndex], " W=", mWaterBuffer[pointElementIndex], " L=", mLightBuffer[pointElementIndex], " T=", mTemperatureBuffer[pointElementIndex], " Decay=", mDecayBuffer[pointElementIndex]);
     LogMessage("PlaneID: ", mPlaneIdBuffer[pointElementIndex], " ConnectedComponentID: ", mConnectedComponentIdBuffer[pointElementIndex]);
 }
@@ -1764,6 +1764,7 @@ void Points::UploadAttributes(
 
     shipRenderContext.UploadPointMutableAttributes(
         mPositionBuffer.data(),
+        mPositionOrigin,
         mLightBuffer.data(),
         mWaterBuffer.data());
 
@@ -2223,6 +2224,54 @@ void Points::UpdateMasses(GameParameters const & gameParameters)
     }
 }
 
+void Points::UpdatePositionOrigin()
+{
+    if constexpr (!GameParameters::DoUseShipRelativePointPositions)
+    {
+        return;
+    }
+
+    if (mRawShipPointCount == 0)
+    {
+        return;
+    }
+
+    //
+    // Find the center of the ship, relative to the current origin
+    //
+
+    vec2f const * restrict const positionBuffer = mPositionBuffer.data();
+
+    vec2f sum = vec2f::zero();
+    for (ElementIndex p = 0; p < mRawShipPointCount; ++p)
+    {
+        sum += positionBuffer[p];
+    }
+
+    vec2f const center = sum / static_cast<float>(mRawShipPointCount);
+    if (std::abs(center.x) <= GameParameters::MaxShipPointPositionOriginDrift
+        && std::abs(center.y) <= GameParameters::MaxShipPointPositionOriginDrift)
+    {
+        // Still close enough
+        return;
+    }
+
+    //
+    // Move the origin to the center, rounded to whole meters so that
+    // the origin itself is exact
+    //
+
+    vec2f const delta(std::round(center.x), std::round(center.y));
+
+    vec2f * restrict const mutablePositionBuffer = mPositionBuffer.data();
+    for (ElementIndex p : BufferElements())
+    {
+        mutablePositionBuffer[p] -= delta;
+    }
+
+    mPositionOrigin += delta;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Points::CalculateCombustionDecayParameters(
@@ -2333,6 +2382,10 @@ ElementIndex Points::FindFreeEphemeralParticle(
             if (mFreeEphemeralParticleSearchStartIndex >= mAllPointCount)
                 mFreeEphemeralParticleSearchStartIndex = mAlignedShipPointCount;
 
+            // The caller is going to make it alive; stolen particles, on the other hand,
+            // were alive already
+            ++mEphemeralParticleCount;
+
             return p;
         }
 
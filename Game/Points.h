@@ -21,6 +21,7 @@
 #include <GameCore/GameRandomEngine.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/GameWallClock.h>
+#include <GameCore/ThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <algorithm>
@@ -571,9 +572,10 @@ public:
         , mMaterialsBuffer(mBufferElementCount, shipPointCount, Materials(nullptr, nullptr))
         , mIsRopeBuffer(mBufferElementCount, shipPointCount, false)
         // Mechanical dynamics
-        , mPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
+        , mPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero(), BufferAllocationPolicy::HugePages) // Gathered at random by spring relaxation
+        , mPositionOrigin(vec2f::zero())
         , mFactoryPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
-        , mVelocityBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
+        , mVelocityBuffer(mBufferElementCount, shipPointCount, vec2f::zero(), BufferAllocationPolicy::HugePages) // Gathered at random by spring relaxation
         , mDynamicForceBuffers() // We'll start later with at least one
         , mDynamicForceRawBuffers()
         , mStaticForceBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
@@ -672,13 +674,14 @@ public:
         , mBurningPoints()
         , mStoppedBurningPoints()
         , mFreeEphemeralParticleSearchStartIndex(mAlignedShipPointCount)
+        , mEphemeralParticleCount(0)
         , mAreEphemeralPointElementsDirtyForRendering(false)
 #ifdef _DEBUG
         , mDiagnostic_ArePositionsDirty(false)
 #endif
     {
         // Add first (implicit) buffer
-        mDynamicForceBuffers.emplace_back(mBufferElementCount, shipPointCount, vec2f::zero());
+        mDynamicForceBuffers.emplace_back(mBufferElementCount, shipPointCount, vec2f::zero(), BufferAllocationPolicy::HugePages);
         mDynamicForceRawBuffers.emplace_back(reinterpret_cast<float *>(mDynamicForceBuffers[0].data()));
 
         CalculateCombustionDecayParameters(mCurrentCombustionSpeedAdjustment, GameParameters::ParticleUpdateLowFrequencyStepTimeDuration<float>);
@@ -720,6 +723,14 @@ public:
         return ElementIndexRangeIterable(mAlignedShipPointCount, mAllPointCount);
     }
 
+    /*
+     * Returns the number of ephemeral particles currently alive.
+     */
+    ElementCount GetEphemeralParticleCount() const
+    {
+        return mEphemeralParticleCount;
+    }
+
     /*
      * Returns a flag indicating whether the point is active in the world.
      *
@@ -963,11 +974,32 @@ public:
     // Dynamics
     //
 
-    vec2f const & GetPosition(ElementIndex pointElementIndex) const noexcept
+    /*
+     * Positions are stored relative to an origin that follows the ship, so that
+     * they keep their precision also far away from the center of the world; the
+     * position buffer holds these relative positions, while the position getters
+     * and setters deal with world positions.
+     *
+     * Relative positions are only to be compared with other relative positions,
+     * e.g. for calculating spring lengths; world positions may be moved into the
+     * relative space by subtracting the position origin.
+     */
+
+    vec2f GetPosition(ElementIndex pointElementIndex) const noexcept
+    {
+        return mPositionOrigin + mPositionBuffer[pointElementIndex];
+    }
+
+    vec2f const & GetRelativePosition(ElementIndex pointElementIndex) const noexcept
     {
         return mPositionBuffer[pointElementIndex];
     }
 
+    vec2f const & GetPositionOrigin() const noexcept
+    {
+        return mPositionOrigin;
+    }
+
     vec2f * GetPositionBufferAsVec2()
     {
         return mPositionBuffer.data();
@@ -978,10 +1010,14 @@ public:
         return reinterpret_cast<float *>(mPositionBuffer.data());
     }
 
+    // World positions
     std::shared_ptr<Buffer<vec2f>> MakePositionBufferCopy()
     {
         auto positionBufferCopy = mVec2fBufferAllocator.Allocate();
-        positionBufferCopy->copy_from(mPositionBuffer);
+        for (ElementIndex p : BufferElements())
+        {
+            (*positionBufferCopy)[p] = mPositionOrigin + mPositionBuffer[p];
+        }
 
         return positionBufferCopy;
     }
@@ -990,7 +1026,7 @@ public:
         ElementIndex pointElementIndex,
         vec2f const & position) noexcept
     {
-        mPositionBuffer[pointElementIndex] = position;
+        mPositionBuffer[pointElementIndex] = position - mPositionOrigin;
 
 #ifdef _DEBUG
         mDiagnostic_ArePositionsDirty = true;
@@ -1095,7 +1131,15 @@ public:
         mDynamicForceBuffers[0].fill(vec2f::zero());
     }
 
-    void SetDynamicForceParallelism(size_t parallelism)
+    /*
+     * The dynamic force buffers beyond the first one are first touched via the thread pool,
+     * each by the task with the buffer's index - as the spring relaxation tasks do; as
+     * the pool does not pin tasks to threads, this only makes it likely - on NUMA systems -
+     * for the buffers to be spread across the nodes of the threads using them.
+     */
+    void SetDynamicForceParallelism(
+        size_t parallelism,
+        ThreadPool & threadPool)
     {
         assert(parallelism >= 1);
 
@@ -1110,11 +1154,34 @@ public:
         }
         else if (parallelism > mDynamicForceBuffers.size())
         {
-            for (size_t b = mDynamicForceBuffers.size(); b < parallelism; ++b)
+            size_t const firstNewBuffer = mDynamicForceBuffers.size();
+
+            for (size_t b = firstNewBuffer; b < parallelism; ++b)
             {
-                mDynamicForceBuffers.emplace_back(mBufferElementCount, vec2f::zero());
+                // Left untouched, for the pool to first-touch it
+                mDynamicForceBuffers.emplace_back(mBufferElementCount, BufferAllocationPolicy::HugePages);
                 mDynamicForceRawBuffers.emplace_back(reinterpret_cast<float *>(mDynamicForceBuffers.back().data()));
             }
+
+            std::vector<ThreadPool::Task> firstTouchTasks;
+            for (size_t b = 0; b < parallelism; ++b)
+            {
+                if (b < firstNewBuffer)
+                {
+                    firstTouchTasks.emplace_back([]() {});
+                }
+                else
+                {
+                    Buffer<vec2f> * const buffer = &(mDynamicForceBuffers[b]);
+                    firstTouchTasks.emplace_back(
+                        [buffer]()
+                        {
+                            buffer->fill(0, buffer->GetSize(), vec2f::zero());
+                        });
+                }
+            }
+
+            threadPool.Run(firstTouchTasks);
         }
     }
 
@@ -1174,8 +1241,19 @@ public:
         return mMassBuffer[pointElementIndex];
     }
 
+    float const * GetMassBufferAsFloat() const noexcept
+    {
+        return mMassBuffer.data();
+    }
+
     void UpdateMasses(GameParameters const & gameParameters);
 
+    /*
+     * Moves the position origin to the center of the ship, when the ship has
+     * drifted away from it.
+     */
+    void UpdatePositionOrigin();
+
     float GetStrength(ElementIndex pointElementIndex) const
     {
         return mStrengthBuffer[pointElementIndex];
@@ -1210,6 +1288,11 @@ public:
         mDecayBuffer[pointElementIndex] = value;
     }
 
+    float const * GetDecayBufferAsFloat() const
+    {
+        return mDecayBuffer.data();
+    }
+
     void MarkDecayBufferAsDirty()
     {
         mIsDecayBufferDirty = true;
@@ -1555,6 +1638,11 @@ public:
         return mMaterialHeatCapacityReciprocalBuffer[pointElementIndex];
     }
 
+    float const * GetMaterialHeatCapacityReciprocalBufferAsFloat() const
+    {
+        return mMaterialHeatCapacityReciprocalBuffer.data();
+    }
+
     /*
      * Checks whether a point is eligible for being extinguished by smothering.
      */
@@ -2078,6 +2166,9 @@ private:
         // - Being updated
         // ...and it will allow its slot to be chosen for a new ephemeral particle
         mEphemeralParticleAttributes1Buffer[pointElementIndex].Type = EphemeralType::None;
+
+        assert(mEphemeralParticleCount > 0);
+        --mEphemeralParticleCount;
     }
 
 private:
@@ -2099,7 +2190,8 @@ private:
     // Dynamics
     //
 
-    Buffer<vec2f> mPositionBuffer;
+    Buffer<vec2f> mPositionBuffer; // Relative to mPositionOrigin
+    vec2f mPositionOrigin; // World; always at whole meters
     Buffer<vec2f> mFactoryPositionBuffer;
     Buffer<vec2f> mVelocityBuffer;
     std::vector<Buffer<vec2f>> mDynamicForceBuffers; // Forces that vary across the multiple mechanical iterations (i.e. spring, hydrostatic surface pressure) for each thread; always at least one.
@@ -2304,6 +2396,9 @@ private:
     // (just an optimization over restarting from zero each time)
     ElementIndex mFreeEphemeralParticleSearchStartIndex;
 
+    // The number of ephemeral particles currently alive
+    ElementCount mEphemeralParticleCount;
+
     // Flag remembering whether the set of ephemeral point *elements* is dirty
     // (i.e. whether there are more or less points than previously
     // reported to the rendering engine); only tracks dirtyness
@@ -87,6 +87,7 @@ RenderContext::RenderContext(
     , mRenderParameters(
         renderDeviceProperties.InitialCanvasSize,
         renderDeviceProperties.LogicalToPhysicalDisplayFactor)
+    , mDrawRenderParameters(mRenderParameters)
     // State
     , mWindSpeedMagnitudeRunningAverage(0.0f)
     , mCurrentWindSpeedMagnitude(0.0f)
@@ -472,10 +473,15 @@ void RenderContext::Draw()
     // Render asynchronously; we will wait for this render to complete
     // when we want to touch GPU buffers again.
     //
-    // Take a copy of the current render parameters and clean its dirtyness
+    // Take a copy of the current render parameters and clean its dirtyness;
+    // the copy is safe from us until the render completes
+    mDrawRenderParameters = mRenderParameters.TakeSnapshotAndClear();
+
     mLastRenderDrawCompletionIndicator = mRenderThread.QueueTask(
-        [this, renderParameters = mRenderParameters.TakeSnapshotAndClear()]() mutable
+        [this]()
         {
+            RenderParameters const & renderParameters = mDrawRenderParameters;
+
             auto const startTime = GameChronometer::now();
 
             RenderStatistics renderStats;
@@ -852,8 +852,8 @@ public:
     {
         if (mWorldRenderContext->IsCloudShadowsRenderingEnabled(mRenderParameters))
         {
-            // Run upload asynchronously
-            mRenderThread.QueueTask(
+            // Run upload asynchronously, with the other uploads of this frame
+            mRenderThread.QueueBatchedTask(
                 [=]()
                 {
                     mWorldRenderContext->UploadCloudShadows(
@@ -1015,8 +1015,8 @@ public:
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
-        // Run upload asynchronously
-        mRenderThread.QueueTask(
+        // Run upload asynchronously, with the other uploads of this frame
+        mRenderThread.QueueBatchedTask(
             [=]()
             {
                 mShips[shipId]->UploadPointColors(
@@ -1036,8 +1036,8 @@ public:
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
-        // Run upload asynchronously
-        mRenderThread.QueueTask(
+        // Run upload asynchronously, with the other uploads of this frame
+        mRenderThread.QueueBatchedTask(
             [=]()
             {
                 mShips[shipId]->UploadPointTemperature(
@@ -1057,8 +1057,8 @@ public:
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
-        // Run upload asynchronously
-        mRenderThread.QueueTask(
+        // Run upload asynchronously, with the other uploads of this frame
+        mRenderThread.QueueBatchedTask(
             [=]()
             {
                 mShips[shipId]->UploadPointStress(
@@ -1078,8 +1078,8 @@ public:
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
-        // Run upload asynchronously
-        mRenderThread.QueueTask(
+        // Run upload asynchronously, with the other uploads of this frame
+        mRenderThread.QueueBatchedTask(
             [=]()
             {
                 mShips[shipId]->UploadPointAuxiliaryData(
@@ -1097,8 +1097,8 @@ public:
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
-        // Run upload asynchronously
-        mRenderThread.QueueTask(
+        // Run upload asynchronously, with the other uploads of this frame
+        mRenderThread.QueueBatchedTask(
             [=]()
             {
                 mShips[shipId]->UploadPointFrontierColors(colors);
@@ -1202,6 +1202,10 @@ private:
 
     RenderParameters mRenderParameters;
 
+    // The snapshot of the render parameters that the render thread is drawing with;
+    // only touched by the main thread between draws
+    RenderParameters mDrawRenderParameters;
+
     //
     // State
     //
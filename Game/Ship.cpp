@@ -37,6 +37,7 @@
 // SpringDecayAndTemperature x 4
 // UpdateSinking x 1
 
+static int constexpr PositionOriginStep = 1; // At the very first step
 static int constexpr CombustionStateMachineSlowStep1 = 2;
 static int constexpr SpringDecayAndTemperatureStep1 = 5;
 static int constexpr RotPointsStep1 = 8;
@@ -120,14 +121,28 @@ Ship::Ship(
     , mRepairGracePeriodMultiplier(1.0f)
     , mLastQueriedPointIndex(NoneElementIndex)
     , mWindField()
+    , mForceFields()
     , mAirBubblesCreatedCount(0)
     , mCurrentSimulationParallelism(0) // We'll detect a difference on first run
+    , mCurrentDoFuseSpringRelaxation(false)
+    , mUpdateTaskGraph()
+    // Spring relaxation
+    , mMechanicalGameParameters()
+    , mMechanicalDynamicsIterationsFraction(1.0f)
+    , mMechanicalDynamicsIterationsCalmStepsCount(0)
+    , mMechanicalDynamicsResidualVelocityBuffer(mPoints.GetAlignedShipPointCount())
+    // Diffusion
+    , mPointNeighborStencil()
+    , mIsPointNeighborStencilDirty(true)
     // Static pressure
     , mStaticPressureBuffer(mPoints.GetAlignedShipPointCount())
     , mStaticPressureNetForceMagnitudeSum(0.0f)
     , mStaticPressureNetForceMagnitudeCount(0.0f)
     , mStaticPressureIterationsPercentagesSum(0.0f)
     , mStaticPressureIterationsCount(0.0f)
+    // Light diffusion
+    , mLightDiffusionTasks()
+    , mIsLightDiffusionRequired(false)
     // Render
     , mLastUploadedDebugShipRenderMode()
     , mPlaneTriangleIndicesToRender()
@@ -187,6 +202,16 @@ void Ship::SetEventRecorder(EventRecorder * eventRecorder)
     mEventRecorder = eventRecorder;
 }
 
+void Ship::AccumulateTelemetry(TelemetryFrame & frame) const
+{
+    frame.PointCount += static_cast<std::uint32_t>(mPoints.GetRawShipPointCount());
+    frame.SpringCount += static_cast<std::uint32_t>(mSprings.GetElementCount());
+    frame.BrokenSpringCount += static_cast<std::uint32_t>(mBrokenSpringsCount);
+    frame.TriangleCount += static_cast<std::uint32_t>(mTriangles.GetElementCount());
+    frame.BrokenTriangleCount += static_cast<std::uint32_t>(mBrokenTrianglesCount);
+    frame.EphemeralParticleCount += static_cast<std::uint32_t>(mPoints.GetEphemeralParticleCount());
+}
+
 bool Ship::ReplayRecordedEvent(
     RecordedEvent const & event,
     GameParameters const & gameParameters)
@@ -218,8 +243,6 @@ void Ship::Update(
     //         This is where most of the magic happens             //
     /////////////////////////////////////////////////////////////////
 
-    std::vector<ThreadPool::Task> parallelTasks;
-
     /////////////////////////////////////////////////////////////////
     // At this moment:
     //  - Particle positions are within world boundaries
@@ -241,18 +264,24 @@ void Ship::Update(
     // Process eventual parameter changes
     ///////////////////////////////////////////////////////////////////
 
+    // Everything that depends on the number of mechanical iterations
+    // uses the mechanical game parameters
+    UpdateMechanicalGameParameters(gameParameters);
+
+    perfStats.ShipsMechanicalDynamicsIterations.Update(mMechanicalGameParameters.NumMechanicalDynamicsIterations<size_t>());
+
     mPoints.UpdateForGameParameters(
-        gameParameters);
+        mMechanicalGameParameters);
 
     mSprings.UpdateForGameParameters(
-        gameParameters,
+        mMechanicalGameParameters,
         mPoints);
 
     mElectricalElements.UpdateForGameParameters(
         gameParameters);
 
     UpdateForSimulationParallelism(
-        gameParameters,
+        mMechanicalGameParameters,
         threadManager);
 
     ///////////////////////////////////////////////////////////////////
@@ -283,7 +312,7 @@ void Ship::Update(
     {
         auto const springsStartTime = std::chrono::steady_clock::now();
 
-        RunSpringRelaxationAndDynamicForcesIntegration(gameParameters, threadManager);
+        RunSpringRelaxationAndDynamicForcesIntegration(mMechanicalGameParameters, threadManager);
 
         perfStats.TotalShipsSpringsUpdateDuration.Update(std::chrono::steady_clock::now() - springsStartTime);
     }
@@ -296,6 +325,17 @@ void Ship::Update(
     // - Outputs: Position, Velocity
     TrimForWorldBounds(gameParameters);
 
+    ///////////////////////////////////////////////////////////////////
+    // Follow the ship with the origin of point positions
+    ///////////////////////////////////////////////////////////////////
+
+    if (mCurrentSimulationSequenceNumber.IsStepOf(PositionOriginStep, GameParameters::ParticleUpdateLowFrequencyPeriod))
+    {
+        // - Inputs: Position
+        // - Outputs: Position (relative)
+        mPoints.UpdatePositionOrigin();
+    }
+
     // We're done with changing positions for the rest of the Update() loop
 #ifdef _DEBUG
     mPoints.Diagnostic_ClearDirtyPositions();
@@ -325,6 +365,17 @@ void Ship::Update(
         mPoints,
         stressRenderMode);
 
+    ///////////////////////////////////////////////////////////////////
+    // Compact frontiers - resolving in one pass all the frontier merges
+    // of the steps and of the interactions since the last compaction -
+    // once enough of them have accumulated
+    ///////////////////////////////////////////////////////////////////
+
+    if (mFrontiers.IsCompactionWorthwhile())
+    {
+        mFrontiers.Compact();
+    }
+
     ///////////////////////////////////////////////////////////////////
     // Reset static forces, now that we have integrated them
     ///////////////////////////////////////////////////////////////////
@@ -354,305 +405,25 @@ void Ship::Update(
     // Cached depths are valid from now on --------------------------->
 
     ///////////////////////////////////////////////////////////////////
-    // Rot points
-    ///////////////////////////////////////////////////////////////////
-
-    // - Inputs: Position, Water, IsLeaking
-    // - Output: Decay
-
-    if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        RotPoints(
-            0, 4,
-            currentSimulationTime,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        RotPoints(
-            1, 4,
-            currentSimulationTime,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        RotPoints(
-            2, 4,
-            currentSimulationTime,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        RotPoints(
-            3, 4,
-            currentSimulationTime,
-            gameParameters);
-    }
-
-    /////////////////////////////////////////////////////////////////
-    // Update gadgets
-    /////////////////////////////////////////////////////////////////
-
-    // Might cause explosions; might cause elements to be detached/destroyed
-    // (which would flag our structure as dirty)
-    mGadgets.Update(
-        currentWallClockTime,
-        currentSimulationTime,
-        stormParameters,
-        gameParameters);
-
-    ///////////////////////////////////////////////////////////////////
-    // Update state machines
-    ///////////////////////////////////////////////////////////////////
-
-    // - Outputs:   Non-spring forces, temperature
-    //              Point Detach, Debris generation
-    UpdateStateMachines(currentSimulationTime, gameParameters);
-
-    /////////////////////////////////////////////////////////////////
-    // Update water dynamics - may generate ephemeral particles
-    /////////////////////////////////////////////////////////////////
-
-    //
-    // Update intake of pressure and water
-    //
-
-    {
-        float waterTakenInStep = 0.f;
-
-        // - Inputs: P.Position, P.Water, P.IsLeaking, P.Temperature, P.PlaneId
-        // - Outputs: P.InternalPressure, P.Water, P.CumulatedIntakenWater
-        // - Creates ephemeral particles
-        UpdatePressureAndWaterInflow(
-            effectiveAirDensity,
-            effectiveWaterDensity,
-            currentSimulationTime,
-            stormParameters,
-            gameParameters,
-            waterTakenInStep);
-
-        // Notify intaken water
-        mGameEventHandler->OnWaterTaken(waterTakenInStep);
-    }
-
-    ///////////////////////////////
-    // Parallel run 1 START
-    ///////////////////////////////
-
-    assert(parallelTasks.empty()); // We want the first task to run on the main thread
-
-    parallelTasks.emplace_back(
-        [&]()
-        {
-            //
-            // Diffuse water (Cost: 14)
-            //
-
-            float waterSplashedInStep = 0.f;
-
-            // - Inputs: Position, Water, WaterVelocity, WaterMomentum, ConnectedSprings
-            // - Outpus: Water, WaterVelocity, WaterMomentum
-            UpdateWaterVelocities(gameParameters, waterSplashedInStep);
-
-            // Notify
-            mGameEventHandler->OnWaterSplashed(waterSplashedInStep);
-        });
-
-    parallelTasks.emplace_back(
-        [&]()
-        {
-            //
-            // Equalize internal pressure (Cost: 1.5)
-            //
-
-            // - Inputs: InternalPressure, ConnectedSprings
-            // - Outpus: InternalPressure
-            EqualizeInternalPressure(gameParameters);
-
-            //
-            // Apply static pressure forces (Cost: 10)
-            //
-
-            if (gameParameters.StaticPressureForceAdjustment > 0.0f)
-            {
-                // - Inputs: frontiers, P.Position, P.InternalPressure
-                // - Outputs: P.DynamicForces
-                ApplyStaticPressureForces(
-                    effectiveAirDensity,
-                    effectiveWaterDensity,
-                    gameParameters);
-            }
-
-            //
-            // Propagate heat (Cost: 4)
-            //
-
-            // - Inputs: P.Position, P.Temperature, P.ConnectedSprings, P.Water
-            // - Outputs: P.Temperature
-            PropagateHeat(
-                currentSimulationTime,
-                GameParameters::SimulationStepTimeDuration<float>,
-                stormParameters,
-                gameParameters);
-        });
-
-    threadManager.GetSimulationThreadPool().RunAndClear(parallelTasks);
-
-    // Publish static pressure stats
-    mGameEventHandler->OnStaticPressureUpdated(
-        mStaticPressureNetForceMagnitudeCount != 0.0f ? mStaticPressureNetForceMagnitudeSum / mStaticPressureNetForceMagnitudeCount : 0.0f,
-        mStaticPressureIterationsCount != 0.0f ? mStaticPressureIterationsPercentagesSum / mStaticPressureIterationsCount : 0.0f);
-
-    ///////////////////////////////
-    // Parallel run 1 END
-    ///////////////////////////////
-
-    //
-    // Run sinking/unsinking detection
-    //
-
-    if (mCurrentSimulationSequenceNumber.IsStepOf(UpdateSinkingStep, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        UpdateSinking();
-    }
-
-#ifdef _DEBUG
-    Verify(!mPoints.Diagnostic_ArePositionsDirty());
-#endif
-
-    //
-    // Update electrical dynamics
-    //
-
-    // Generate a new visit sequence number
-    ++mCurrentElectricalVisitSequenceNumber;
-
-    mElectricalElements.Update(
-        currentWallClockTime,
-        currentSimulationTime,
-        mCurrentElectricalVisitSequenceNumber,
-        mPoints,
-        mSprings,
-        effectiveAirDensity,
-        effectiveWaterDensity,
-        stormParameters,
-        gameParameters);
-
-    //
-    // Diffuse light
-    //
-
-    // - Inputs: P.Position, P.PlaneId, EL.AvailableLight
-    //      - EL.AvailableLight depends on electricals which depend on water
-    // - Outputs: P.Light
-    DiffuseLight(
-        gameParameters, 
-        threadManager);
-
-    //
-    // Update slow combustion state machine
+    // Run all the phases that only work with forces and with the
+    // other particle attributes - rotting, gadgets, state machines,
+    // force fields, water, pressure, heat, electricals, light,
+    // combustion, spring decay, and ephemeral particles
     //
+    // See BuildUpdateTaskGraph() for the phases and for what each of
+    // them reads and writes; independent phases run in parallel
+    ///////////////////////////////////////////////////////////////////
 
-    if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mPoints.UpdateCombustionLowFrequency(
-            0,
-            4,
+    mUpdateTaskGraph.Run(
+        threadManager.GetSimulationThreadPool(),
+        UpdateTaskContext(
+            currentWallClockTime,
             currentWallClockTimeFloat,
             currentSimulationTime,
             stormParameters,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mPoints.UpdateCombustionLowFrequency(
-            1,
-            4,
-            currentWallClockTimeFloat,
-            currentSimulationTime,
-            stormParameters,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mPoints.UpdateCombustionLowFrequency(
-            2,
-            4,
-            currentWallClockTimeFloat,
-            currentSimulationTime,
-            stormParameters,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mPoints.UpdateCombustionLowFrequency(
-            3,
-            4,
-            currentWallClockTimeFloat,
-            currentSimulationTime,
-            stormParameters,
-            gameParameters);
-    }
-
-    //
-    // Update fast combustion state machine
-    //
-
-    mPoints.UpdateCombustionHighFrequency(
-        currentSimulationTime,
-        GameParameters::SimulationStepTimeDuration<float>,
-        mParentWorld.GetCurrentWindSpeed(),
-        mWindField,
-        gameParameters);
-
-    //
-    // Update highlights
-    //
-
-    mPoints.UpdateHighlights(currentWallClockTimeFloat);
-
-    //
-    // Update electric sparks
-    //
-
-    mElectricSparks.Update();
-
-    ///////////////////////////////////////////////////////////////////
-    // Update spring parameters
-    ///////////////////////////////////////////////////////////////////
-
-    if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mSprings.UpdateForDecayAndTemperature(
-            0, 4,
-            mPoints);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mSprings.UpdateForDecayAndTemperature(
-            1, 4,
-            mPoints);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mSprings.UpdateForDecayAndTemperature(
-            2, 4,
-            mPoints);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mSprings.UpdateForDecayAndTemperature(
-            3, 4,
-            mPoints);
-    }
-
-    ///////////////////////////////////////////////////////////////////
-    // Update ephemeral particles
-    ///////////////////////////////////////////////////////////////////
-
-    mPoints.UpdateEphemeralParticles(
-        currentSimulationTime,
-        gameParameters);
+            gameParameters,
+            effectiveAirDensity,
+            effectiveWaterDensity));
 
     ///////////////////////////////////////////////////////////////////
     // Diagnostics
@@ -1766,7 +1537,7 @@ void Ship::HandleCollisionsWithSeaFloor(
 
     for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
-        auto const & position = mPoints.GetPosition(pointIndex);
+        vec2f const position = mPoints.GetPosition(pointIndex);
 
         // Check if point is below the sea floor
         //
@@ -1829,9 +1600,7 @@ void Ship::HandleCollisionsWithSeaFloor(
                 vec2f deltaPosition = pointVelocity * dt * siltingCoeff;
                 float const deltaPositionLength = deltaPosition.length();
                 deltaPosition = deltaPosition.normalise_approx(deltaPositionLength) * std::min(deltaPositionLength, 0.01f); // Magic number, empirical
-                mPoints.SetPosition(
-                    pointIndex,
-                    mPoints.GetPosition(pointIndex) - deltaPosition);
+                mPoints.GetPositionBufferAsVec2()[pointIndex] -= deltaPosition; // Relative, to keep precision
 
                 // Set velocity to resultant collision velocity
                 mPoints.SetVelocity(
@@ -1858,17 +1627,18 @@ void Ship::TrimForWorldBounds(GameParameters const & gameParameters)
     static constexpr float MaxBounceVelocity = 150.0f; // Magic number
 
     // Visit all points
+    vec2f const positionOrigin = mPoints.GetPositionOrigin();
     vec2f * const restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
     vec2f * const restrict velocityBuffer = mPoints.GetVelocityBufferAsVec2();
     size_t const count = mPoints.GetBufferElementCount();
     for (size_t p = 0; p < count; ++p)
     {
-        auto const & pos = positionBuffer[p];
+        vec2f const pos = positionOrigin + positionBuffer[p];
 
         if (pos.x < MaxWorldLeft)
         {
             // Simulate bounce, bounded
-            positionBuffer[p].x = std::min(MaxWorldLeft + elasticity * (MaxWorldLeft - pos.x), 0.0f);
+            positionBuffer[p].x = std::min(MaxWorldLeft + elasticity * (MaxWorldLeft - pos.x), 0.0f) - positionOrigin.x;
 
             // Bounce bounded
             velocityBuffer[p].x = std::min(-velocityBuffer[p].x, MaxBounceVelocity);
@@ -1876,7 +1646,7 @@ void Ship::TrimForWorldBounds(GameParameters const & gameParameters)
         else if (pos.x > MaxWorldRight)
         {
             // Simulate bounce, bounded
-            positionBuffer[p].x = std::max(MaxWorldRight - elasticity * (pos.x - MaxWorldRight), 0.0f);
+            positionBuffer[p].x = std::max(MaxWorldRight - elasticity * (pos.x - MaxWorldRight), 0.0f) - positionOrigin.x;
 
             // Bounce bounded
             velocityBuffer[p].x = std::max(-velocityBuffer[p].x, -MaxBounceVelocity);
@@ -1885,7 +1655,7 @@ void Ship::TrimForWorldBounds(GameParameters const & gameParameters)
         if (pos.y > MaxWorldTop)
         {
             // Simulate bounce, bounded
-            positionBuffer[p].y = std::max(MaxWorldTop - elasticity * (pos.y - MaxWorldTop), 0.0f);
+            positionBuffer[p].y = std::max(MaxWorldTop - elasticity * (pos.y - MaxWorldTop), 0.0f) - positionOrigin.y;
 
             // Bounce bounded
             velocityBuffer[p].y = std::max(-velocityBuffer[p].y, -MaxBounceVelocity);
@@ -1893,16 +1663,16 @@ void Ship::TrimForWorldBounds(GameParameters const & gameParameters)
         else if (pos.y < MaxWorldBottom)
         {
             // Simulate bounce, bounded
-            positionBuffer[p].y = std::min(MaxWorldBottom + elasticity * (MaxWorldBottom - pos.y), 0.0f);
+            positionBuffer[p].y = std::min(MaxWorldBottom + elasticity * (MaxWorldBottom - pos.y), 0.0f) - positionOrigin.y;
 
             // Bounce bounded
             velocityBuffer[p].y = std::min(-velocityBuffer[p].y, MaxBounceVelocity);
         }
 
-        assert(positionBuffer[p].x >= MaxWorldLeft);
-        assert(positionBuffer[p].x <= MaxWorldRight);
-        assert(positionBuffer[p].y >= MaxWorldBottom);
-        assert(positionBuffer[p].y <= MaxWorldTop);
+        assert(positionOrigin.x + positionBuffer[p].x >= MaxWorldLeft);
+        assert(positionOrigin.x + positionBuffer[p].x <= MaxWorldRight);
+        assert(positionOrigin.y + positionBuffer[p].y >= MaxWorldBottom);
+        assert(positionOrigin.y + positionBuffer[p].y <= MaxWorldTop);
     }
 
 #ifdef _DEBUG
@@ -2146,10 +1916,48 @@ void Ship::UpdatePressureAndWaterInflow(
     }
 }
 
+void Ship::UpdatePointNeighborStencil()
+{
+    if (!mIsPointNeighborStencilDirty)
+    {
+        return;
+    }
+
+    //
+    // Rebuild the neighbors of each (non-ephemeral) point, in the order of its connected springs
+    //
+
+    mPointNeighborStencil.Clear();
+    mPointNeighborStencil.Reserve(
+        mPoints.GetRawShipPointCount(),
+        static_cast<size_t>(mSprings.GetElementCount()) * 2);
+
+    for (auto pointIndex : mPoints.RawShipPoints())
+    {
+        for (auto const & cs : mPoints.GetConnectedSprings(pointIndex).ConnectedSprings)
+        {
+            float const restLengthReciprocal = 1.0f / mSprings.GetFactoryRestLength(cs.SpringIndex);
+
+            mPointNeighborStencil.AddNeighbor(
+                cs.OtherEndpointIndex,
+                cs.SpringIndex,
+                mSprings.GetWaterPermeability(cs.SpringIndex),
+                restLengthReciprocal,
+                mSprings.GetMaterialThermalConductivity(cs.SpringIndex) * restLengthReciprocal);
+        }
+
+        mPointNeighborStencil.EndPoint();
+    }
+
+    assert(mPointNeighborStencil.GetPointCount() == mPoints.GetRawShipPointCount());
+
+    mIsPointNeighborStencilDirty = false;
+}
+
 void Ship::EqualizeInternalPressure(GameParameters const & /*gameParameters*/)
 {
-    // Local cache of indices of other endpoints
-    FixedSizeVector<ElementIndex, GameParameters::MaxSpringsPerPoint> otherEndpoints;
+    // Rebuilt by the caller, as we run in parallel with other users of the stencil
+    assert(!mIsPointNeighborStencilDirty);
 
     //
     // For each (non-ephemeral) point, equalize its internal pressure with its
@@ -2159,8 +1967,14 @@ void Ship::EqualizeInternalPressure(GameParameters const & /*gameParameters*/)
     float * restrict internalPressureBufferData = mPoints.GetInternalPressureBufferAsFloat();
     bool const * restrict isHullBufferData = mPoints.GetIsHullBuffer();
 
+    ElementIndex const * restrict const neighborOffsets = mPointNeighborStencil.GetPointOffsets();
+    ElementIndex const * restrict const neighborPointIndices = mPointNeighborStencil.GetNeighborPointIndices();
+
     for (auto pointIndex : mPoints.RawShipPoints()) // No need to visit ephemeral points as they have no springs
     {
+        ElementIndex const neighborsStart = neighborOffsets[pointIndex];
+        ElementIndex const neighborsEnd = neighborOffsets[pointIndex + 1];
+
         if (!isHullBufferData[pointIndex])
         {
             //
@@ -2177,9 +1991,9 @@ void Ship::EqualizeInternalPressure(GameParameters const & /*gameParameters*/)
             float averageInternalPressure = internalPressure;
             float targetEndpointsCount = 1.0f;
 
-            for (auto const & cs : mPoints.GetConnectedSprings(pointIndex).ConnectedSprings)
+            for (ElementIndex n = neighborsStart; n < neighborsEnd; ++n)
             {
-                ElementIndex const otherEndpointIndex = cs.OtherEndpointIndex;
+                ElementIndex const otherEndpointIndex = neighborPointIndices[n];
 
                 // We only consider outgoing pressure, not towards hull points
                 float const otherEndpointInternalPressure = internalPressureBufferData[otherEndpointIndex];
@@ -2188,8 +2002,6 @@ void Ship::EqualizeInternalPressure(GameParameters const & /*gameParameters*/)
                 {
                     averageInternalPressure += otherEndpointInternalPressure;
                     targetEndpointsCount += 1.0f;
-
-                    otherEndpoints.emplace_back(otherEndpointIndex);
                 }
             }
 
@@ -2198,15 +2010,22 @@ void Ship::EqualizeInternalPressure(GameParameters const & /*gameParameters*/)
             //
             // 2. Distribute surplus pressure
             //
+            // We re-visit the same neighbors; each neighbor's pressure is only changed
+            // after it has been tested, hence we select the same ones as above
+            //
 
             internalPressureBufferData[pointIndex] = averageInternalPressure;
 
-            for (auto const & otherEndpointIndex : otherEndpoints)
+            for (ElementIndex n = neighborsStart; n < neighborsEnd; ++n)
             {
-                internalPressureBufferData[otherEndpointIndex] = averageInternalPressure;
-            }
+                ElementIndex const otherEndpointIndex = neighborPointIndices[n];
 
-            otherEndpoints.clear();
+                if (internalPressure > internalPressureBufferData[otherEndpointIndex]
+                    && !isHullBufferData[otherEndpointIndex])
+                {
+                    internalPressureBufferData[otherEndpointIndex] = averageInternalPressure;
+                }
+            }
         }
         else
         {
@@ -2218,9 +2037,9 @@ void Ship::EqualizeInternalPressure(GameParameters const & /*gameParameters*/)
             float averageInternalPressure = 0.0f;
             float neighborsCount = 0.0f;
 
-            for (auto const & cs : mPoints.GetConnectedSprings(pointIndex).ConnectedSprings)
+            for (ElementIndex n = neighborsStart; n < neighborsEnd; ++n)
             {
-                ElementIndex const otherEndpointIndex = cs.OtherEndpointIndex;
+                ElementIndex const otherEndpointIndex = neighborPointIndices[n];
                 if (!isHullBufferData[otherEndpointIndex])
                 {
                     averageInternalPressure += internalPressureBufferData[otherEndpointIndex];
@@ -2247,6 +2066,8 @@ void Ship::UpdateWaterVelocities(
     // Implementation of https://gabrielegiuseppini.wordpress.com/2018/09/08/momentum-based-simulation-of-water-flooding-2d-spaces/
     //
 
+    assert(!mIsPointNeighborStencilDirty);
+
     // Calculate water momenta
     mPoints.UpdateWaterMomentaFromVelocities();
 
@@ -2256,6 +2077,13 @@ void Ship::UpdateWaterVelocities(
     float * restrict newPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
     vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
     vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
+    vec2f const * restrict const positionBufferData = mPoints.GetPositionBufferAsVec2(); // Relative positions suffice, as we only take differences
+
+    // Neighbors
+    ElementIndex const * restrict const neighborOffsets = mPointNeighborStencil.GetPointOffsets();
+    ElementIndex const * restrict const neighborPointIndices = mPointNeighborStencil.GetNeighborPointIndices();
+    float const * restrict const neighborWaterPermeabilities = mPointNeighborStencil.GetWaterPermeabilities();
+    float const * restrict const neighborRestLengthReciprocals = mPointNeighborStencil.GetRestLengthReciprocals();
 
     // Weights of outbound water flows along each spring, including impermeable ones;
     // set to zero for springs whose resultant scalar water velocities are
@@ -2268,6 +2096,9 @@ void Ship::UpdateWaterVelocities(
     // Resultant water velocities along each spring
     std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
 
+    // Normalized vectors of each spring, oriented point -> other endpoint
+    std::array<vec2f, GameParameters::MaxSpringsPerPoint> springNormalizedVectors;
+
     //
     // Precalculate point "freeness factors", i.e. how much each point's
     // quantity of water "suppresses" splashes from adjacent kinetic energy losses:
@@ -2314,13 +2145,17 @@ void Ship::UpdateWaterVelocities(
 
         totalOutboundWaterFlowWeight = 0.0f;
 
-        size_t const connectedSpringCount = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size();
+        ElementIndex const neighborsStart = neighborOffsets[pointIndex];
+        size_t const connectedSpringCount = neighborOffsets[pointIndex + 1] - neighborsStart;
+        assert(connectedSpringCount <= GameParameters::MaxSpringsPerPoint);
+
         for (size_t s = 0; s < connectedSpringCount; ++s)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            ElementIndex const otherEndpointIndex = neighborPointIndices[neighborsStart + s];
 
             // Normalized spring vector, oriented point -> other endpoint
-            vec2f const springNormalizedVector = (mPoints.GetPosition(cs.OtherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise_approx();
+            vec2f const springNormalizedVector = (positionBufferData[otherEndpointIndex] - positionBufferData[pointIndex]).normalise_approx();
+            springNormalizedVectors[s] = springNormalizedVector;
 
             // Component of the point's own water velocity along the spring
             float const pointWaterVelocityAlongSpring =
@@ -2333,10 +2168,10 @@ void Ship::UpdateWaterVelocities(
             //
 
             // Pressure difference (positive implies point -> other endpoint flow)
-            float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[cs.OtherEndpointIndex];
+            float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[otherEndpointIndex];
 
             // Gravity potential difference (positive implies point -> other endpoint flow)
-            float const dy = mPoints.GetPosition(pointIndex).y - mPoints.GetPosition(cs.OtherEndpointIndex).y;
+            float const dy = positionBufferData[pointIndex].y - positionBufferData[otherEndpointIndex].y;
 
             // Calculate gained water velocity along this spring, from point to other endpoint
             // (Bernoulli, 1738)
@@ -2366,7 +2201,7 @@ void Ship::UpdateWaterVelocities(
             // diagonal springs
             springOutboundWaterFlowWeights[s] =
                 springOutboundScalarWaterVelocity
-                / mSprings.GetFactoryRestLength(cs.SpringIndex);
+                * neighborRestLengthReciprocals[neighborsStart + s];
 
             // Resultant outbound velocity along spring
             springOutboundWaterVelocities[s] =
@@ -2380,11 +2215,13 @@ void Ship::UpdateWaterVelocities(
             // Update splash neighbors counts
             //
 
+            float const springWaterPermeability = neighborWaterPermeabilities[neighborsStart + s];
+
             pointSplashFreeNeighbors +=
-                mSprings.GetWaterPermeability(cs.SpringIndex)
-                * pointFreenessFactorBufferData[cs.OtherEndpointIndex];
+                springWaterPermeability
+                * pointFreenessFactorBufferData[otherEndpointIndex];
 
-            pointSplashNeighbors += mSprings.GetWaterPermeability(cs.SpringIndex);
+            pointSplashNeighbors += springWaterPermeability;
         }
 
         //
@@ -2415,7 +2252,7 @@ void Ship::UpdateWaterVelocities(
 
         for (size_t s = 0; s < connectedSpringCount; ++s)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            ElementIndex const otherEndpointIndex = neighborPointIndices[neighborsStart + s];
 
             // Calculate quantity of water directed outwards
             float const springOutboundQuantityOfWater =
@@ -2424,7 +2261,7 @@ void Ship::UpdateWaterVelocities(
 
             assert(springOutboundQuantityOfWater >= 0.0f);
 
-            if (mSprings.GetWaterPermeability(cs.SpringIndex) != 0.0f)
+            if (neighborWaterPermeabilities[neighborsStart + s] != 0.0f)
             {
                 //
                 // Water - and momentum - move from point to endpoint
@@ -2432,7 +2269,7 @@ void Ship::UpdateWaterVelocities(
 
                 // Move water quantity
                 newPointWaterBufferData[pointIndex] -= springOutboundQuantityOfWater;
-                newPointWaterBufferData[cs.OtherEndpointIndex] += springOutboundQuantityOfWater;
+                newPointWaterBufferData[otherEndpointIndex] += springOutboundQuantityOfWater;
 
                 // Remove "old momentum" (old velocity) from point
                 newPointWaterMomentumBufferData[pointIndex] -=
@@ -2440,7 +2277,7 @@ void Ship::UpdateWaterVelocities(
                     * springOutboundQuantityOfWater;
 
                 // Add "new momentum" (old velocity + velocity gained) to other endpoint
-                newPointWaterMomentumBufferData[cs.OtherEndpointIndex] +=
+                newPointWaterMomentumBufferData[otherEndpointIndex] +=
                     springOutboundWaterVelocities[s]
                     * springOutboundQuantityOfWater;
 
@@ -2450,13 +2287,10 @@ void Ship::UpdateWaterVelocities(
                 // splintered water colliding with whole other endpoint
                 //
 
-                // FUTURE: get rid of this re-calculation once we pre-calculate all spring normalized vectors
-                vec2f const springNormalizedVector = (mPoints.GetPosition(cs.OtherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise_approx();
-
                 float ma = springOutboundQuantityOfWater;
                 float va = springOutboundWaterVelocities[s].length();
-                float mb = oldPointWaterBufferData[cs.OtherEndpointIndex];
-                float vb = oldPointWaterVelocityBufferData[cs.OtherEndpointIndex].dot(springNormalizedVector);
+                float mb = oldPointWaterBufferData[otherEndpointIndex];
+                float vb = oldPointWaterVelocityBufferData[otherEndpointIndex].dot(springNormalizedVectors[s]);
 
                 float vf = 0.0f;
                 if (ma + mb != 0.0f)
@@ -2477,7 +2311,7 @@ void Ship::UpdateWaterVelocities(
                 // Wall hit
 
                 // Deleted springs are removed from points' connected springs
-                assert(!mSprings.IsDeleted(cs.SpringIndex));
+                assert(!mSprings.IsDeleted(mPointNeighborStencil.GetSpringIndices()[neighborsStart + s]));
 
                 //
                 // New momentum (old velocity + velocity gained) bounces back
@@ -2635,19 +2469,19 @@ void Ship::RecalculateLightDiffusionParallelism(size_t simulationParallelism)
     }
 }
 
-void Ship::DiffuseLight(
-    GameParameters const & gameParameters,
-    ThreadManager & threadManager)
+void Ship::PrepareLightDiffusion(GameParameters const & gameParameters)
 {
     //
-    // Diffuse light from each lamp to all points on the same or lower plane ID,
-    // inverse-proportionally to the lamp-point distance
+    // Light is diffused from each lamp to all points on the same or lower plane ID,
+    // inverse-proportionally to the lamp-point distance, by the light diffusion tasks;
+    // here we decide whether they have to run, and prepare their lamp data
     //
 
     // Shortcut
     if (mElectricalElements.Lamps().empty()
         || (gameParameters.LuminiscenceAdjustment == 0.0f && mLastLuminiscenceAdjustmentDiffused == 0.0f))
     {
+        mIsLightDiffusionRequired = false;
         return;
     }
 
@@ -2665,7 +2499,7 @@ void Ship::DiffuseLight(
         auto const lampElectricalElementIndex = mElectricalElements.Lamps()[l];
         auto const lampPointIndex = mElectricalElements.GetPointIndex(lampElectricalElementIndex);
 
-        lampPositions[l] = mPoints.GetPosition(lampPointIndex);
+        lampPositions[l] = mPoints.GetRelativePosition(lampPointIndex); // Diffusion works on relative positions
         lampPlaneIds[l] = mPoints.GetPlaneId(lampPointIndex);
         lampDistanceCoeffs[l] =
             mElectricalElements.GetLampRawDistanceCoefficient(l)
@@ -2673,10 +2507,10 @@ void Ship::DiffuseLight(
     }
 
     //
-    // 2. Diffuse light
+    // 2. Let the light diffusion tasks run
     //
 
-    threadManager.GetSimulationThreadPool().Run(mLightDiffusionTasks);
+    mIsLightDiffusionRequired = true;
 
     // Remember that we've diffused light with this luminiscence adjustment
     mLastLuminiscenceAdjustmentDiffused = gameParameters.LuminiscenceAdjustment;
@@ -2696,10 +2530,21 @@ void Ship::PropagateHeat(
     // Propagate temperature (via heat), and dissipate temperature
     //
 
+    assert(!mIsPointNeighborStencilDirty);
+
     // Source and result temperature buffers
     auto oldPointTemperatureBuffer = mPoints.MakeTemperatureBufferCopy();
     float const * restrict const oldPointTemperatureBufferData = oldPointTemperatureBuffer->data();
     float * restrict const newPointTemperatureBufferData = mPoints.GetTemperatureBufferAsFloat();
+    float const * restrict const heatCapacityReciprocalBufferData = mPoints.GetMaterialHeatCapacityReciprocalBufferAsFloat();
+
+    // Neighbors
+    ElementIndex const * restrict const neighborOffsets = mPointNeighborStencil.GetPointOffsets();
+    ElementIndex const * restrict const neighborPointIndices = mPointNeighborStencil.GetNeighborPointIndices();
+    float const * restrict const neighborThermalConductances = mPointNeighborStencil.GetThermalConductances();
+
+    // Constant part of the heat flows
+    float const heatFlowFactor = gameParameters.ThermalConductivityAdjustment * dt;
 
     // Outbound heat flows along each spring
     std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundHeatFlows;
@@ -2723,19 +2568,19 @@ void Ship::PropagateHeat(
         float totalOutgoingHeat = 0.0f;
 
         // Visit all springs
-        size_t const connectedSpringCount = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size();
+        ElementIndex const neighborsStart = neighborOffsets[pointIndex];
+        size_t const connectedSpringCount = neighborOffsets[pointIndex + 1] - neighborsStart;
+        assert(connectedSpringCount <= GameParameters::MaxSpringsPerPoint);
+
         for (size_t s = 0; s < connectedSpringCount; ++s)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
-
             // Calculate outgoing heat flow per unit of time
             //
             // q = Ki * (Tp - Tpi) * dt / Li
             float const outgoingHeatFlow =
-                mSprings.GetMaterialThermalConductivity(cs.SpringIndex) * gameParameters.ThermalConductivityAdjustment
-                * std::max(pointTemperature - oldPointTemperatureBufferData[cs.OtherEndpointIndex], 0.0f) // DeltaT, positive if going out
-                * dt
-                / mSprings.GetFactoryRestLength(cs.SpringIndex);
+                neighborThermalConductances[neighborsStart + s] // Ki / Li
+                * std::max(pointTemperature - oldPointTemperatureBufferData[neighborPointIndices[neighborsStart + s]], 0.0f) // DeltaT, positive if going out
+                * heatFlowFactor;
 
             // Store flow
             springOutboundHeatFlows[s] = outgoingHeatFlow;
@@ -2755,7 +2600,7 @@ void Ship::PropagateHeat(
             // Q = Kp * Tp
             float const pointHeat =
                 pointTemperature
-                / mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+                / heatCapacityReciprocalBufferData[pointIndex];
 
             normalizationFactor = std::min(
                 pointHeat / totalOutgoingHeat,
@@ -2773,18 +2618,18 @@ void Ship::PropagateHeat(
 
         for (size_t s = 0; s < connectedSpringCount; ++s)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            ElementIndex const otherEndpointIndex = neighborPointIndices[neighborsStart + s];
 
             // Raise target temperature due to this flow
-            newPointTemperatureBufferData[cs.OtherEndpointIndex] +=
+            newPointTemperatureBufferData[otherEndpointIndex] +=
                 springOutboundHeatFlows[s] * normalizationFactor
-                * mPoints.GetMaterialHeatCapacityReciprocal(cs.OtherEndpointIndex);
+                * heatCapacityReciprocalBufferData[otherEndpointIndex];
         }
 
         // Update point's temperature due to total flow
         newPointTemperatureBufferData[pointIndex] -=
             totalOutgoingHeat * normalizationFactor
-            * mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+            * heatCapacityReciprocalBufferData[pointIndex];
     }
 
     //
@@ -2953,19 +2798,510 @@ void Ship::UpdateForSimulationParallelism(
     ThreadManager & threadManager)
 {
     size_t const simulationParallelism = threadManager.GetSimulationParallelism();
-    if (simulationParallelism != mCurrentSimulationParallelism)
+    if (simulationParallelism != mCurrentSimulationParallelism
+        || gameParameters.DoFuseSpringRelaxation != mCurrentDoFuseSpringRelaxation)
     {
         // Re-calculate spring relaxation parallelism
-        RecalculateSpringRelaxationParallelism(simulationParallelism, gameParameters);
+        RecalculateSpringRelaxationParallelism(simulationParallelism, threadManager.GetSimulationThreadPool(), gameParameters);
 
         // Re-calculate light diffusion parallelism
         RecalculateLightDiffusionParallelism(simulationParallelism);
 
-        // Remember new value
+        // Re-build the update tasks, which include the light diffusion tasks
+        BuildUpdateTaskGraph();
+
+        // Remember new values
         mCurrentSimulationParallelism = simulationParallelism;
+        mCurrentDoFuseSpringRelaxation = gameParameters.DoFuseSpringRelaxation;
     }
 }
 
+void Ship::BuildUpdateTaskGraph()
+{
+    //
+    // The phases of the update that only work with forces and with the other particle
+    // attributes, in the order in which they would run serially; each phase declares what
+    // it reads and writes, and the graph lets independent phases run in parallel
+    //
+
+    mUpdateTaskGraph.Clear();
+
+    // The tasks firing events run on the thread updating the ship, as the event
+    // handler's sinks expect
+    auto constexpr CallingThread = TaskGraph<UpdateTaskContext, UpdateResources>::TaskAffinity::CallingThread;
+
+    //
+    // Rot points
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "RotPoints",
+        UpdateResources::Water | UpdateResources::Structure,
+        UpdateResources::Decay,
+        [this](UpdateTaskContext const & context)
+        {
+            // - Inputs: Position, Water, IsLeaking
+            // - Output: Decay
+
+            if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                RotPoints(
+                    0, 4,
+                    context.CurrentSimulationTime,
+                    context.GameParams);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                RotPoints(
+                    1, 4,
+                    context.CurrentSimulationTime,
+                    context.GameParams);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                RotPoints(
+                    2, 4,
+                    context.CurrentSimulationTime,
+                    context.GameParams);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                RotPoints(
+                    3, 4,
+                    context.CurrentSimulationTime,
+                    context.GameParams);
+            }
+        });
+
+    //
+    // Update gadgets
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "Gadgets",
+        UpdateResources::Temperature | UpdateResources::InternalPressure | UpdateResources::Structure,
+        UpdateResources::Gadgets | UpdateResources::StateMachines | UpdateResources::ForceFields | UpdateResources::EphemeralParticles | UpdateResources::Events | UpdateResources::Random,
+        CallingThread,
+        [this](UpdateTaskContext const & context)
+        {
+            // Might start explosions, and queue force fields
+            mGadgets.Update(
+                context.CurrentWallClockTime,
+                context.CurrentSimulationTime,
+                context.StormParams,
+                context.GameParams);
+        });
+
+    //
+    // Update state machines
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "StateMachines",
+        UpdateResources::None,
+        UpdateResources::StateMachines | UpdateResources::ForceFields,
+        [this](UpdateTaskContext const & context)
+        {
+            // - Outputs:   Force fields
+            UpdateStateMachines(context.CurrentSimulationTime, context.GameParams);
+        });
+
+    //
+    // Apply force fields queued by gadgets and state machines
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "ForceFields",
+        UpdateResources::None,
+        UpdateResources::ForceFields | UpdateResources::Forces | UpdateResources::Temperature | UpdateResources::Water | UpdateResources::Structure | UpdateResources::EphemeralParticles | UpdateResources::Events | UpdateResources::Random,
+        CallingThread,
+        [this](UpdateTaskContext const & context)
+        {
+            // - Outputs:   Non-spring forces, temperature, water velocity
+            //              Point Detach, Debris generation
+            ApplyForceFields(context.CurrentSimulationTime, context.GameParams);
+        });
+
+    //
+    // Update intake of pressure and water
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "PressureAndWaterInflow",
+        UpdateResources::Temperature | UpdateResources::Structure,
+        UpdateResources::Water | UpdateResources::InternalPressure | UpdateResources::EphemeralParticles | UpdateResources::Events | UpdateResources::Random,
+        CallingThread,
+        [this](UpdateTaskContext const & context)
+        {
+            float waterTakenInStep = 0.f;
+
+            // - Inputs: P.Position, P.Water, P.IsLeaking, P.Temperature, P.PlaneId
+            // - Outputs: P.InternalPressure, P.Water, P.CumulatedIntakenWater
+            // - Creates ephemeral particles
+            UpdatePressureAndWaterInflow(
+                context.EffectiveAirDensity,
+                context.EffectiveWaterDensity,
+                context.CurrentSimulationTime,
+                context.StormParams,
+                context.GameParams,
+                waterTakenInStep);
+
+            // Notify intaken water
+            mGameEventHandler->OnWaterTaken(waterTakenInStep);
+        });
+
+    //
+    // Rebuild the neighbors of each point, if the structure has changed; the diffusion
+    // phases that follow share them
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "PointNeighborStencil",
+        UpdateResources::Structure,
+        UpdateResources::PointNeighborStencil,
+        [this](UpdateTaskContext const & /*context*/)
+        {
+            UpdatePointNeighborStencil();
+        });
+
+    //
+    // Diffuse water (Cost: 14)
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "WaterVelocities",
+        UpdateResources::Structure | UpdateResources::PointNeighborStencil,
+        UpdateResources::Water | UpdateResources::Events,
+        CallingThread,
+        [this](UpdateTaskContext const & context)
+        {
+            float waterSplashedInStep = 0.f;
+
+            // - Inputs: Position, Water, WaterVelocity, WaterMomentum, ConnectedSprings
+            // - Outpus: Water, WaterVelocity, WaterMomentum
+            UpdateWaterVelocities(context.GameParams, waterSplashedInStep);
+
+            // Notify
+            mGameEventHandler->OnWaterSplashed(waterSplashedInStep);
+        });
+
+    //
+    // Equalize internal pressure, apply static pressure forces, and propagate heat
+    //
+    // Note: heat dissipation also looks at P.Water, but only against a threshold; it
+    // has always run alongside water diffusion, hence we don't declare it
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "PressureAndHeat",
+        UpdateResources::Structure | UpdateResources::PointNeighborStencil | UpdateResources::EphemeralParticles,
+        UpdateResources::InternalPressure | UpdateResources::Forces | UpdateResources::Temperature,
+        [this](UpdateTaskContext const & context)
+        {
+            //
+            // Equalize internal pressure (Cost: 1.5)
+            //
+
+            // - Inputs: InternalPressure, ConnectedSprings
+            // - Outpus: InternalPressure
+            EqualizeInternalPressure(context.GameParams);
+
+            //
+            // Apply static pressure forces (Cost: 10)
+            //
+
+            if (context.GameParams.StaticPressureForceAdjustment > 0.0f)
+            {
+                // - Inputs: frontiers, P.Position, P.InternalPressure
+                // - Outputs: P.DynamicForces
+                ApplyStaticPressureForces(
+                    context.EffectiveAirDensity,
+                    context.EffectiveWaterDensity,
+                    context.GameParams);
+            }
+
+            //
+            // Propagate heat (Cost: 4)
+            //
+
+            // - Inputs: P.Position, P.Temperature, P.ConnectedSprings, P.Water
+            // - Outputs: P.Temperature
+            PropagateHeat(
+                context.CurrentSimulationTime,
+                GameParameters::SimulationStepTimeDuration<float>,
+                context.StormParams,
+                context.GameParams);
+        });
+
+    //
+    // Publish static pressure stats
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "StaticPressureStats",
+        UpdateResources::InternalPressure,
+        UpdateResources::Events,
+        CallingThread,
+        [this](UpdateTaskContext const & /*context*/)
+        {
+            mGameEventHandler->OnStaticPressureUpdated(
+                mStaticPressureNetForceMagnitudeCount != 0.0f ? mStaticPressureNetForceMagnitudeSum / mStaticPressureNetForceMagnitudeCount : 0.0f,
+                mStaticPressureIterationsCount != 0.0f ? mStaticPressureIterationsPercentagesSum / mStaticPressureIterationsCount : 0.0f);
+        });
+
+    //
+    // Run sinking/unsinking detection
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "Sinking",
+        UpdateResources::Water,
+        UpdateResources::Sinking | UpdateResources::Events,
+        CallingThread,
+        [this](UpdateTaskContext const & /*context*/)
+        {
+            if (mCurrentSimulationSequenceNumber.IsStepOf(UpdateSinkingStep, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                UpdateSinking();
+            }
+        });
+
+    //
+    // Update electrical dynamics
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "Electricals",
+        UpdateResources::None,
+        // Engines apply forces, elements generate heat, water pumps and watertight doors change leaks
+        UpdateResources::Electricals | UpdateResources::Forces | UpdateResources::Temperature | UpdateResources::Water | UpdateResources::Structure | UpdateResources::Events | UpdateResources::Random,
+        CallingThread,
+        [this](UpdateTaskContext const & context)
+        {
+            // Generate a new visit sequence number
+            ++mCurrentElectricalVisitSequenceNumber;
+
+            mElectricalElements.Update(
+                context.CurrentWallClockTime,
+                context.CurrentSimulationTime,
+                mCurrentElectricalVisitSequenceNumber,
+                mPoints,
+                mSprings,
+                context.EffectiveAirDensity,
+                context.EffectiveWaterDensity,
+                context.StormParams,
+                context.GameParams);
+        });
+
+    //
+    // Diffuse light
+    //
+    // - Inputs: P.Position, P.PlaneId, EL.AvailableLight
+    //      - EL.AvailableLight depends on electricals which depend on water
+    // - Outputs: P.Light
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "PrepareLightDiffusion",
+        UpdateResources::Electricals,
+        UpdateResources::Light,
+        [this](UpdateTaskContext const & context)
+        {
+            PrepareLightDiffusion(context.GameParams);
+        });
+
+    // Each task diffuses light onto its own range of points
+    mUpdateTaskGraph.BeginPartition();
+
+    for (size_t t = 0; t < mLightDiffusionTasks.size(); ++t)
+    {
+        mUpdateTaskGraph.AddTask(
+            "DiffuseLight",
+            UpdateResources::Electricals,
+            UpdateResources::Light,
+            [this, t](UpdateTaskContext const & /*context*/)
+            {
+                if (mIsLightDiffusionRequired)
+                {
+                    mLightDiffusionTasks[t]();
+                }
+            });
+    }
+
+    mUpdateTaskGraph.EndPartition();
+
+    //
+    // Update slow combustion state machine
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "CombustionLowFrequency",
+        UpdateResources::Water | UpdateResources::Structure,
+        UpdateResources::Combustion | UpdateResources::Decay | UpdateResources::Temperature | UpdateResources::StateMachines | UpdateResources::Events | UpdateResources::Random,
+        CallingThread,
+        [this](UpdateTaskContext const & context)
+        {
+            if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                mPoints.UpdateCombustionLowFrequency(
+                    0,
+                    4,
+                    context.CurrentWallClockTimeFloat,
+                    context.CurrentSimulationTime,
+                    context.StormParams,
+                    context.GameParams);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                mPoints.UpdateCombustionLowFrequency(
+                    1,
+                    4,
+                    context.CurrentWallClockTimeFloat,
+                    context.CurrentSimulationTime,
+                    context.StormParams,
+                    context.GameParams);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                mPoints.UpdateCombustionLowFrequency(
+                    2,
+                    4,
+                    context.CurrentWallClockTimeFloat,
+                    context.CurrentSimulationTime,
+                    context.StormParams,
+                    context.GameParams);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                mPoints.UpdateCombustionLowFrequency(
+                    3,
+                    4,
+                    context.CurrentWallClockTimeFloat,
+                    context.CurrentSimulationTime,
+                    context.StormParams,
+                    context.GameParams);
+            }
+        });
+
+    //
+    // Update fast combustion state machine
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "CombustionHighFrequency",
+        UpdateResources::Water | UpdateResources::Decay | UpdateResources::Structure,
+        UpdateResources::Combustion | UpdateResources::Temperature | UpdateResources::Events,
+        CallingThread,
+        [this](UpdateTaskContext const & context)
+        {
+            mPoints.UpdateCombustionHighFrequency(
+                context.CurrentSimulationTime,
+                GameParameters::SimulationStepTimeDuration<float>,
+                mParentWorld.GetCurrentWindSpeed(),
+                mWindField,
+                context.GameParams);
+        });
+
+    //
+    // Update highlights
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "Highlights",
+        UpdateResources::None,
+        UpdateResources::Highlights,
+        [this](UpdateTaskContext const & context)
+        {
+            mPoints.UpdateHighlights(context.CurrentWallClockTimeFloat);
+        });
+
+    //
+    // Update electric sparks
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "ElectricSparks",
+        UpdateResources::None,
+        UpdateResources::ElectricSparks,
+        [this](UpdateTaskContext const & /*context*/)
+        {
+            mElectricSparks.Update();
+        });
+
+    //
+    // Update spring parameters
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "SpringDecayAndTemperature",
+        UpdateResources::Decay | UpdateResources::Temperature,
+        UpdateResources::SpringMaterial,
+        [this](UpdateTaskContext const & /*context*/)
+        {
+            if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                mSprings.UpdateForDecayAndTemperature(
+                    0, 4,
+                    mPoints);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                mSprings.UpdateForDecayAndTemperature(
+                    1, 4,
+                    mPoints);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                mSprings.UpdateForDecayAndTemperature(
+                    2, 4,
+                    mPoints);
+            }
+            else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
+            {
+                mSprings.UpdateForDecayAndTemperature(
+                    3, 4,
+                    mPoints);
+            }
+        });
+
+    //
+    // Update ephemeral particles
+    //
+
+    mUpdateTaskGraph.AddTask(
+        "EphemeralParticles",
+        UpdateResources::Water,
+        UpdateResources::EphemeralParticles | UpdateResources::Events | UpdateResources::Random,
+        CallingThread,
+        [this](UpdateTaskContext const & context)
+        {
+            mPoints.UpdateEphemeralParticles(
+                context.CurrentSimulationTime,
+                context.GameParams);
+        });
+
+    //
+    // Register the buffers of the ship points, so that debug builds may verify that
+    // each task only changes what it declares to write (ephemeral particles' attributes
+    // change with ephemeral particles, hence we leave them out)
+    //
+
+    size_t const shipPointsFloatByteSize = mPoints.GetRawShipPointCount() * sizeof(float);
+    size_t const shipPointsVec2ByteSize = mPoints.GetRawShipPointCount() * sizeof(vec2f);
+
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::Water, mPoints.GetWaterBufferAsFloat(), shipPointsFloatByteSize);
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::Water, mPoints.GetWaterVelocityBufferAsVec2(), shipPointsVec2ByteSize);
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::Water, mPoints.GetWaterMomentumBufferAsVec2f(), shipPointsVec2ByteSize);
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::InternalPressure, mPoints.GetInternalPressureBufferAsFloat(), shipPointsFloatByteSize);
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::Forces, mPoints.GetStaticForceBufferAsVec2(), shipPointsVec2ByteSize);
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::Forces, mPoints.GetDynamicForceBufferAsVec2(), shipPointsVec2ByteSize);
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::Temperature, mPoints.GetTemperatureBufferAsFloat(), shipPointsFloatByteSize);
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::Decay, mPoints.GetDecayBufferAsFloat(), shipPointsFloatByteSize);
+    mUpdateTaskGraph.RegisterResourceBuffer(UpdateResources::Light, mPoints.GetLightBufferAsFloat(), shipPointsFloatByteSize);
+
+    LogMessage("Ship::BuildUpdateTaskGraph: tasks=", mUpdateTaskGraph.GetTaskCount(), " levels=", mUpdateTaskGraph.GetLevelCount());
+}
+
 //#define RENDER_FLOOD_DISTANCE
 
 void Ship::RunConnectivityVisit()
@@ -3134,6 +3470,9 @@ void Ship::SetAndPropagateResultantPointHullness(
             cs.SpringIndex,
             (isHull || mPoints.GetIsHull(cs.OtherEndpointIndex)) ? 0.0f : 1.0f);
     }
+
+    // Remember the diffusion neighbors are now stale
+    mIsPointNeighborStencilDirty = true;
 }
 
 void Ship::DestroyConnectedTriangles(ElementIndex pointElementIndex)
@@ -3587,6 +3926,7 @@ void Ship::HandleSpringDestroy(
 
     // Remember our structure is now dirty
     mIsStructureDirty = true;
+    mIsPointNeighborStencilDirty = true;
 
     // Update count of broken springs
     ++mBrokenSpringsCount;
@@ -3650,6 +3990,7 @@ void Ship::HandleSpringRestore(
 
     // Remember our structure is now dirty
     mIsStructureDirty = true;
+    mIsPointNeighborStencilDirty = true;
 
     // Update count of broken springs
     assert(mBrokenSpringsCount > 0);
@@ -3898,8 +4239,8 @@ void Ship::DoAntiMatterBombPreimplosion(
         130000.0f // Magic number
         * (gameParameters.IsUltraViolentMode ? 5.0f : 1.0f);
 
-    // Apply the force field
-    ApplyRadialSpaceWarpForceField(
+    // Queue the force field
+    AddRadialSpaceWarpForceField(
         centerPosition,
         radius,
         10.0f, // Thickness of radius, magic number
@@ -3923,8 +4264,8 @@ void Ship::DoAntiMatterBombImplosion(
         * 10000.0f
         * (gameParameters.IsUltraViolentMode ? 50.0f : 1.0f);
 
-    // Apply the force field
-    ApplyImplosionForceField(
+    // Queue the force field
+    AddImplosionForceField(
         centerPosition,
         strength);
 }
@@ -3940,11 +4281,11 @@ void Ship::DoAntiMatterBombExplosion(
 
     if (0.0f == sequenceProgress)
     {
-        // Apply the force field
+        // Queue the force field
         float const strength =
             30000.0f
             * (gameParameters.IsUltraViolentMode ? 50.0f : 1.0f);
-        ApplyRadialExplosionForceField(
+        AddRadialExplosionForceField(
             centerPosition,
             strength);
 
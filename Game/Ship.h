@@ -11,18 +11,24 @@
 #include "MaterialDatabase.h"
 #include "Physics.h"
 #include "PerfStats.h"
+#include "PointNeighborStencil.h"
 #include "RenderContext.h"
 #include "ShipDefinition.h"
 #include "ShipElectricSparks.h"
 #include "ShipOverlays.h"
+#include "SpringRelaxationBlockSchedule.h"
+#include "TelemetrySink.h"
 
 #include <GameCore/AABBSet.h>
 #include <GameCore/Buffer.h>
 #include <GameCore/GameTypes.h>
+#include <GameCore/GameWallClock.h>
 #include <GameCore/RunningAverage.h>
+#include <GameCore/TaskGraph.h>
 #include <GameCore/ThreadManager.h>
 #include <GameCore/Vectors.h>
 
+#include <limits>
 #include <list>
 #include <memory>
 #include <optional>
@@ -67,6 +73,11 @@ public:
 
     void SetEventRecorder(EventRecorder * eventRecorder);
 
+    /*
+     * Adds this ship's element counts to the frame's.
+     */
+    void AccumulateTelemetry(TelemetryFrame & frame) const;
+
     bool ReplayRecordedEvent(
         RecordedEvent const & event,
         GameParameters const & gameParameters);
@@ -507,14 +518,26 @@ private:
         float effectiveWaterDensity,
         GameParameters const & gameParameters);
 
-    void RecalculateSpringRelaxationParallelism(size_t simulationParallelism, GameParameters const & gameParameters);
-    void RecalculateSpringRelaxationSpringForcesParallelism(size_t simulationParallelism);
+    void RecalculateSpringRelaxationParallelism(size_t simulationParallelism, ThreadPool & threadPool, GameParameters const & gameParameters);
+    void RecalculateSpringRelaxationSpringForcesParallelism(size_t simulationParallelism, ThreadPool & threadPool);
     void RecalculateSpringRelaxationIntegrationAndSeaFloorCollisionParallelism(size_t simulationParallelism, GameParameters const & gameParameters);
 
+    void UpdateMechanicalGameParameters(GameParameters const & gameParameters);
+
     void RunSpringRelaxationAndDynamicForcesIntegration(
         GameParameters const & gameParameters,
         ThreadManager & threadManager);
 
+    void BeginMechanicalDynamicsResidualSample();
+
+    float EndMechanicalDynamicsResidualSample(GameParameters const & gameParameters);
+
+    void UpdateMechanicalDynamicsIterationsFraction(float residual);
+
+    void RunFusedSpringRelaxationIteration(
+        bool doHandleCollisionsWithSeaFloor,
+        GameParameters const & gameParameters);
+
     void ApplySpringsForces(
         ElementIndex startSpringIndex,
         ElementIndex endSpringIndex,
@@ -549,6 +572,8 @@ private:
         GameParameters const & gameParameters,
         float & waterTakenInStep);
 
+    void UpdatePointNeighborStencil();
+
     void EqualizeInternalPressure(GameParameters const & gameParameters);
 
     void UpdateWaterVelocities(
@@ -561,9 +586,7 @@ private:
 
     void RecalculateLightDiffusionParallelism(size_t simulationParallelism);
 
-    void DiffuseLight(
-        GameParameters const & gameParameters,
-        ThreadManager & threadManager);
+    void PrepareLightDiffusion(GameParameters const & gameParameters);
 
     // Heat
 
@@ -591,22 +614,116 @@ private:
 
     /////////////////////////////////////////////////////////////////////////
     // Force Fields
+    //
+    // Force fields are gathered during the step, and then applied all
+    // together in a single pass over the points
     /////////////////////////////////////////////////////////////////////////
 
-    void ApplyRadialSpaceWarpForceField(
+    struct ForceField
+    {
+        enum class ForceFieldType
+        {
+            RadialSpaceWarp,
+            Implosion,
+            RadialExplosion,
+            Blast
+        };
+
+        ForceFieldType Type;
+        vec2f CenterPosition; // World; relative to the points' position origin while being applied
+        float Strength;
+        float Radius; // RadialSpaceWarp, Blast
+        float RadiusThickness; // RadialSpaceWarp
+        float Heat; // Blast; J
+        bool DoDetachClosestPoint; // Blast
+
+        // Result: the point closest to the center, within the radius (Blast)
+        ElementIndex ClosestPointIndex;
+        float ClosestPointSquareDistance;
+
+        ForceField(
+            ForceFieldType type,
+            vec2f const & centerPosition,
+            float strength,
+            float radius,
+            float radiusThickness,
+            float heat,
+            bool doDetachClosestPoint)
+            : Type(type)
+            , CenterPosition(centerPosition)
+            , Strength(strength)
+            , Radius(radius)
+            , RadiusThickness(radiusThickness)
+            , Heat(heat)
+            , DoDetachClosestPoint(doDetachClosestPoint)
+            , ClosestPointIndex(NoneElementIndex)
+            , ClosestPointSquareDistance(std::numeric_limits<float>::max())
+        {}
+
+        // Max distance from the center at which the field has an effect
+        float GetMaxRadius() const
+        {
+            switch (Type)
+            {
+                case ForceFieldType::RadialSpaceWarp:
+                    return Radius + RadiusThickness;
+
+                case ForceFieldType::Blast:
+                    return Radius;
+
+                case ForceFieldType::Implosion:
+                case ForceFieldType::RadialExplosion:
+                default:
+                    return std::numeric_limits<float>::max();
+            }
+        }
+    };
+
+    void AddRadialSpaceWarpForceField(
         vec2f const & centerPosition,
         float radius,
         float radiusThickness,
         float strength);
 
-    void ApplyImplosionForceField(
+    void AddImplosionForceField(
         vec2f const & centerPosition,
         float strength);
 
-    void ApplyRadialExplosionForceField(
+    void AddRadialExplosionForceField(
         vec2f const & centerPosition,
         float strength);
 
+    void AddBlastForceField(
+        vec2f const & centerPosition,
+        float radius,
+        float strength,
+        float heat,
+        bool doDetachClosestPoint);
+
+    void ApplyForceFields(
+        float currentSimulationTime,
+        GameParameters const & gameParameters);
+
+    void ApplyRadialSpaceWarpForceField(
+        ForceField const & forceField,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex);
+
+    void ApplyImplosionForceField(
+        ForceField const & forceField,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex);
+
+    void ApplyRadialExplosionForceField(
+        ForceField const & forceField,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex);
+
+    void ApplyBlastForceField(
+        ForceField & forceField,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex);
+
 private:
 
     /////////////////////////////////////////////////////////////////////////
@@ -617,6 +734,65 @@ private:
         GameParameters const & gameParameters,
         ThreadManager & threadManager);
 
+    // The inputs of the update tasks that change at each step
+    struct UpdateTaskContext
+    {
+        GameWallClock::time_point CurrentWallClockTime;
+        GameWallClock::float_time CurrentWallClockTimeFloat;
+        float CurrentSimulationTime;
+        Storm::Parameters const & StormParams;
+        GameParameters const & GameParams;
+        float EffectiveAirDensity;
+        float EffectiveWaterDensity;
+
+        UpdateTaskContext(
+            GameWallClock::time_point currentWallClockTime,
+            GameWallClock::float_time currentWallClockTimeFloat,
+            float currentSimulationTime,
+            Storm::Parameters const & stormParams,
+            GameParameters const & gameParams,
+            float effectiveAirDensity,
+            float effectiveWaterDensity)
+            : CurrentWallClockTime(currentWallClockTime)
+            , CurrentWallClockTimeFloat(currentWallClockTimeFloat)
+            , CurrentSimulationTime(currentSimulationTime)
+            , StormParams(stormParams)
+            , GameParams(gameParams)
+            , EffectiveAirDensity(effectiveAirDensity)
+            , EffectiveWaterDensity(effectiveWaterDensity)
+        {}
+    };
+
+    // What the update tasks read and write; the dependencies among
+    // the tasks derive from these
+    enum class UpdateResources : std::uint32_t
+    {
+        None = 0,
+
+        Structure = 1 << 0,             // Springs, triangles, frontiers, leaks, point detachment
+        Water = 1 << 1,                 // P.Water, P.WaterVelocity, P.WaterMomentum
+        InternalPressure = 1 << 2,      // P.InternalPressure, static pressure stats
+        Forces = 1 << 3,                // P.StaticForce, P.DynamicForce
+        Temperature = 1 << 4,           // P.Temperature
+        Decay = 1 << 5,                 // P.Decay
+        Combustion = 1 << 6,            // Combustion state, burning points
+        Light = 1 << 7,                 // Lamp work buffers, P.Light
+        Electricals = 1 << 8,
+        SpringMaterial = 1 << 9,        // Spring strength and stiffness from decay and temperature
+        Highlights = 1 << 10,
+        ElectricSparks = 1 << 11,
+        EphemeralParticles = 1 << 12,   // Including all the point attributes of ephemeral particles
+        Gadgets = 1 << 13,
+        StateMachines = 1 << 14,        // Including explosions started by anyone
+        ForceFields = 1 << 15,
+        Sinking = 1 << 16,
+        Events = 1 << 17,               // The game event handler, which is not thread-safe
+        Random = 1 << 18,               // The game random engine, which is not thread-safe
+        PointNeighborStencil = 1 << 19  // The neighbors shared by the diffusion phases
+    };
+
+    void BuildUpdateTaskGraph();
+
     void RunConnectivityVisit();
 
     inline void SetAndPropagateResultantPointHullness(
@@ -901,12 +1077,20 @@ private:
     // Last-applied (interactive) wind field
     std::optional<WindField> mWindField;
 
+    // Force fields queued for this step, applied all at once
+    std::vector<ForceField> mForceFields;
+
     // Counter of created bubble ephemeral particles
     std::uint64_t mAirBubblesCreatedCount;
 
-    // The last thread pool simulation parallelism we've seen; used to
-    // detect changes
+    // The last thread pool simulation parallelism and spring relaxation
+    // fusion setting we've seen; used to detect changes
     size_t mCurrentSimulationParallelism;
+    bool mCurrentDoFuseSpringRelaxation;
+
+    // The tasks that make up most of each update; re-built only when
+    // the simulation parallelism changes
+    TaskGraph<UpdateTaskContext, UpdateResources> mUpdateTaskGraph;
 
     //
     // Spring relaxation
@@ -917,6 +1101,33 @@ private:
     std::vector<typename ThreadPool::Task> mSpringRelaxationIntegrationTasks;
     std::vector<typename ThreadPool::Task> mSpringRelaxationIntegrationAndSeaFloorCollisionTasks;
 
+    // The schedule for running each iteration of spring relaxation as a single, cache-blocked
+    // pass; empty when we run the two phases separately
+    SpringRelaxationBlockSchedule mSpringRelaxationBlockSchedule;
+
+    // The game parameters we run spring relaxation with: the global ones, but with our own
+    // number of mechanical iterations. The spring relaxation tasks store a reference to
+    // these, hence they're never re-created
+    GameParameters mMechanicalGameParameters;
+
+    // Adaptive mechanical iterations: the fraction of the configured number of iterations
+    // we're currently running, and for how many consecutive steps we've been calm at it
+    float mMechanicalDynamicsIterationsFraction;
+    int mMechanicalDynamicsIterationsCalmStepsCount;
+
+    // The ship point velocities before the iteration at which we sample the residual
+    Buffer<vec2f> mMechanicalDynamicsResidualVelocityBuffer;
+
+    //
+    // Diffusion
+    //
+
+    // The neighbors of each ship point, as visited by the water, heat, and internal pressure
+    // diffusion kernels; rebuilt when springs are destroyed or restored, or when hullness
+    // - and thus water permeability - changes
+    PointNeighborStencil mPointNeighborStencil;
+    bool mIsPointNeighborStencilDirty;
+
     //
     // Static pressure
     //
@@ -957,6 +1168,9 @@ private:
     // The light diffusion tasks
     std::vector<typename ThreadPool::Task> mLightDiffusionTasks;
 
+    // Whether the light diffusion tasks have to run in the current step
+    bool mIsLightDiffusionRequired;
+
     //
     // Render members
     //
@@ -970,4 +1184,6 @@ private:
     std::vector<size_t> mPlaneTriangleIndicesToRender;
 };
 
-}
\ No newline at end of file
+}
+
+template <> struct is_flag<Physics::Ship::UpdateResources> : std::true_type {};
\ No newline at end of file
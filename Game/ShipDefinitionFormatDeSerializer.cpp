@@ -96,7 +96,7 @@ ShipDefinition ShipDefinitionFormatDeSerializer::Load(
                     ReadStructuralLayer(
                         buffer,
                         *shipAttributes,
-                        materialDatabase.GetStructuralMaterialMap(),
+                        materialDatabase.GetStructuralMaterialTable(),
                         structuralLayer);
 
                     break;
@@ -114,7 +114,7 @@ ShipDefinition ShipDefinitionFormatDeSerializer::Load(
                     ReadElectricalLayer(
                         buffer,
                         *shipAttributes,
-                        materialDatabase.GetElectricalMaterialMap(),
+                        materialDatabase.GetElectricalMaterialTable(),
                         electricalLayer);
 
                     break;
@@ -132,7 +132,7 @@ ShipDefinition ShipDefinitionFormatDeSerializer::Load(
                     ReadRopesLayer(
                         buffer,
                         *shipAttributes,
-                        materialDatabase.GetStructuralMaterialMap(),
+                        materialDatabase.GetStructuralMaterialTable(),
                         ropesLayer);
 
                     break;
@@ -1802,7 +1802,7 @@ ShipAutoTexturizationSettings ShipDefinitionFormatDeSerializer::ReadAutoTexturiz
 void ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
     DeSerializationBuffer<BigEndianess> const & buffer,
     ShipAttributes const & shipAttributes,
-    MaterialDatabase::MaterialMap<StructuralMaterial> const & materialMap,
+    MaterialColorKeyTable<StructuralMaterial> const & materialTable,
     std::unique_ptr<StructuralLayerData> & structuralLayer)
 {
     size_t readOffset = 0;
@@ -1841,13 +1841,11 @@ void ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
                     }
                     else
                     {
-                        auto const materialIt = materialMap.find(colorKey);
-                        if (materialIt == materialMap.cend())
+                        material = materialTable.Find(colorKey);
+                        if (material == nullptr)
                         {
                             ThrowMaterialNotFound(shipAttributes);
                         }
-
-                        material = &(materialIt->second);
                     }
 
                     // Fill material
@@ -1892,7 +1890,7 @@ void ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
 void ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
     DeSerializationBuffer<BigEndianess> const & buffer,
     ShipAttributes const & shipAttributes,
-    MaterialDatabase::MaterialMap<ElectricalMaterial> const & materialMap,
+    MaterialColorKeyTable<ElectricalMaterial> const & materialTable,
     std::unique_ptr<ElectricalLayerData> & electricalLayer)
 {
     size_t readOffset = 0;
@@ -1931,13 +1929,11 @@ void ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
                     }
                     else
                     {
-                        auto const materialIt = materialMap.find(colorKey);
-                        if (materialIt == materialMap.cend())
+                        material = materialTable.Find(colorKey);
+                        if (material == nullptr)
                         {
                             ThrowMaterialNotFound(shipAttributes);
                         }
-
-                        material = &(materialIt->second);
                     }
 
                     // Deserialize instanceID - only if instanced
@@ -2054,7 +2050,7 @@ void ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
 void ShipDefinitionFormatDeSerializer::ReadRopesLayer(
     DeSerializationBuffer<BigEndianess> const & buffer,
     ShipAttributes const & shipAttributes,
-    MaterialDatabase::MaterialMap<StructuralMaterial> const & materialMap,
+    MaterialColorKeyTable<StructuralMaterial> const & materialTable,
     std::unique_ptr<RopesLayerData> & ropesLayer)
 {
     size_t readOffset = 0;
@@ -2098,8 +2094,8 @@ void ShipDefinitionFormatDeSerializer::ReadRopesLayer(
                     bufferReadOffset += buffer.ReadAt(bufferReadOffset, reinterpret_cast<unsigned char *>(&colorKey), sizeof(colorKey));
 
                     // Lookup material
-                    auto const materialIt = materialMap.find(colorKey);
-                    if (materialIt == materialMap.cend())
+                    StructuralMaterial const * const material = materialTable.Find(colorKey);
+                    if (material == nullptr)
                     {
                         ThrowMaterialNotFound(shipAttributes);
                     }
@@ -2111,7 +2107,7 @@ void ShipDefinitionFormatDeSerializer::ReadRopesLayer(
                     ropesLayer->Buffer.EmplaceBack(
                         ShipSpaceCoordinates(startX, startY),
                         ShipSpaceCoordinates(endX, endY),
-                        &(materialIt->second),
+                        material,
                         renderColor);
                 }
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "ElectricalPanel.h"
+#include "MaterialColorKeyTable.h"
 #include "MaterialDatabase.h"
 #include "ShipDefinition.h"
 #include "ShipPreviewData.h"
@@ -341,19 +342,19 @@ private:
     static void ReadStructuralLayer(
         DeSerializationBuffer<BigEndianess> const & buffer,
         ShipAttributes const & shipAttributes,
-        MaterialDatabase::MaterialMap<StructuralMaterial> const & materialMap,
+        MaterialColorKeyTable<StructuralMaterial> const & materialTable,
         std::unique_ptr<StructuralLayerData> & structuralLayer);
 
     static void ReadElectricalLayer(
         DeSerializationBuffer<BigEndianess> const & buffer,
         ShipAttributes const & shipAttributes,
-        MaterialDatabase::MaterialMap<ElectricalMaterial> const & materialMap,
+        MaterialColorKeyTable<ElectricalMaterial> const & materialTable,
         std::unique_ptr<ElectricalLayerData> & electricalLayer);
 
     static void ReadRopesLayer(
         DeSerializationBuffer<BigEndianess> const & buffer,
         ShipAttributes const & shipAttributes,
-        MaterialDatabase::MaterialMap<StructuralMaterial> const & materialMap,
+        MaterialColorKeyTable<StructuralMaterial> const & materialTable,
         std::unique_ptr<RopesLayerData> & ropesLayer);
 
 private:
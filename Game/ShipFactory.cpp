@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <future>
 #include <set>
 #include <sstream>
 #include <unordered_map>
@@ -48,12 +49,16 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
     ShipLoadOptions const & shipLoadOptions,
     MaterialDatabase const & materialDatabase,
     ShipTexturizer const & shipTexturizer,
+    ThreadPool & texturizationThreadPool,
     ShipStrengthRandomizer const & shipStrengthRandomizer,
     std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
-    GameParameters const & gameParameters)
+    GameParameters const & gameParameters,
+    ProgressCallback const & progressCallback)
 {
     auto const totalStartTime = std::chrono::steady_clock::now();
 
+    progressCallback(0.3f, ProgressMessageType::BuildingShip);
+
     //
     // Process load options
     //
@@ -76,6 +81,30 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
         shipDefinition.Layers.Rotate90(RotationDirectionType::Clockwise);
     }
 
+    //
+    // Start auto-texturization - if needed - in the background, as it doesn't depend on the
+    // physics we're about to build; from now on the layers are only read
+    //
+    // Note: should we bail out, the future's destructor waits for the texturizer to complete
+    // before the definition goes away
+    //
+
+    std::future<RgbaImageData> autoTextureImage;
+    if (!shipDefinition.Layers.TextureLayer)
+    {
+        autoTextureImage = std::async(
+            std::launch::async,
+            [&shipTexturizer, &texturizationThreadPool, &shipDefinition]()
+            {
+                ThreadManager::InitializeThisThread();
+
+                return shipTexturizer.MakeAutoTexture(
+                    *shipDefinition.Layers.StructuralLayer,
+                    shipDefinition.AutoTexturizationSettings,
+                    texturizationThreadPool);
+            });
+    }
+
     //
     // Process structural ship layer and:
     // - Create ShipFactoryPoint's for each particle, including ropes' endpoints
@@ -249,6 +278,8 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
     //  - Do tessellation and create ShipFactoryTriangle's
     //
 
+    progressCallback(0.5f, ProgressMessageType::BuildingShip);
+
     std::vector<ShipFactoryTriangle> triangleInfos;
 
     size_t leakingPointsCount;
@@ -283,6 +314,8 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
     // relaxation algorithm - and hopefully to improve cache hits
     //
 
+    progressCallback(0.7f, ProgressMessageType::BuildingShip);
+
     float originalSpringACMR = CalculateACMR(springInfos1);
 
     auto [pointInfos2, pointIndexRemap, springInfos2, springIndexRemap, perfectSquareCount] = OptimizeLayout(
@@ -341,6 +374,8 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
     // Visit all ShipFactoryPoint's and create Points, i.e. the entire set of points
     //
 
+    progressCallback(0.9f, ProgressMessageType::BuildingShip);
+
     std::vector<ElectricalElementInstanceIndex> electricalElementInstanceIndices;
     Physics::Points points = CreatePoints(
         pointInfos2,
@@ -400,14 +435,18 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
         springs);
 
     //
-    // Create texture, if needed
+    // Get texture
     //
 
+    progressCallback(1.0f, ProgressMessageType::TexturizingShip);
+
+    auto const textureWaitStartTime = std::chrono::steady_clock::now();
+
     RgbaImageData textureImage = shipDefinition.Layers.TextureLayer
         ? std::move(shipDefinition.Layers.TextureLayer->Buffer) // Use provided texture
-        : shipTexturizer.MakeAutoTexture(
-            *shipDefinition.Layers.StructuralLayer,
-            shipDefinition.AutoTexturizationSettings); // Auto-texturize
+        : autoTextureImage.get(); // Wait for auto-texturization; re-throws its errors
+
+    auto const textureWaitEndTime = std::chrono::steady_clock::now();
 
     //
     // We're done!
@@ -440,7 +479,8 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
 
     LogMessage("ShipFactory: Create() took ",
         std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - totalStartTime).count(),
-        " us (frontiers: ", std::chrono::duration_cast<std::chrono::microseconds>(frontiersEndTime - frontiersStartTime).count(), " us)");
+        " us (frontiers: ", std::chrono::duration_cast<std::chrono::microseconds>(frontiersEndTime - frontiersStartTime).count(), " us",
+        ", waiting for texture: ", std::chrono::duration_cast<std::chrono::microseconds>(textureWaitEndTime - textureWaitStartTime).count(), " us)");
 
     return std::make_tuple(
         std::move(ship),
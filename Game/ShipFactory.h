@@ -17,6 +17,8 @@
 
 #include <GameCore/GameTypes.h>
 #include <GameCore/IndexRemap.h>
+#include <GameCore/ProgressCallback.h>
+#include <GameCore/ThreadPool.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -36,6 +38,11 @@ class ShipFactory
 {
 public:
 
+    /*
+     * If the ship needs to be auto-texturized, the texture is made concurrently with the
+     * physics, on the specified thread pool - which must not be used by anyone else until
+     * this method returns.
+     */
     static std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> Create(
         ShipId shipId,
         Physics::World & parentWorld,
@@ -43,9 +50,11 @@ public:
         ShipLoadOptions const & shipLoadOptions,
         MaterialDatabase const & materialDatabase,
         ShipTexturizer const & shipTexturizer,
+        ThreadPool & texturizationThreadPool,
         ShipStrengthRandomizer const & shipStrengthRandomizer,
         std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
-        GameParameters const & gameParameters);
+        GameParameters const & gameParameters,
+        ProgressCallback const & progressCallback);
 
 private:
 
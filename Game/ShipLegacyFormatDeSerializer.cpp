@@ -10,7 +10,11 @@
 #include <GameCore/ImageTools.h>
 #include <GameCore/Utils.h>
 
+#include <algorithm>
+#include <future>
+#include <map>
 #include <memory>
+#include <vector>
 
 ShipDefinition ShipLegacyFormatDeSerializer::LoadShipFromImageDefinition(
     std::filesystem::path const & shipFilePath,
@@ -301,129 +305,164 @@ ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImageFilePaths(
     MaterialDatabase const & materialDatabase)
 {
     //
-    // Load images
+    // Load and convert images - each on its own thread, while we do the structural
+    // layer on this thread.
+    //
+    // Note: the futures' destructors wait for their tasks, hence the references
+    // captured by the tasks outlive them also when we throw.
     //
 
-    RgbImageData structuralLayerImage = ImageFileTools::LoadImageRgb(structuralLayerImageFilePath);
-
-    std::optional<RgbImageData> electricalLayerImage;
+    std::optional<std::future<ConvertedElectricalLayerImage>> electricalLayerImageFuture;
     if (electricalLayerImageFilePath.has_value())
     {
-        try
-        {
-            electricalLayerImage.emplace(
-                ImageFileTools::LoadImageRgb(*electricalLayerImageFilePath));
-        }
-        catch (GameException const & gex)
-        {
-            throw GameException("Error loading electrical layer image: " + std::string(gex.what()));
-        }
+        electricalLayerImageFuture.emplace(
+            std::async(
+                std::launch::async,
+                [&electricalLayerImageFilePath, &materialDatabase]()
+                {
+                    try
+                    {
+                        std::optional<ConvertedElectricalLayerImage> result;
+                        ImageFileTools::VisitImageRgb(
+                            *electricalLayerImageFilePath,
+                            [&](ImageFileTools::DecodedImageView<rgbColor> const & image)
+                            {
+                                result.emplace(ConvertElectricalLayerImage(image, materialDatabase));
+                            });
+
+                        return std::move(*result);
+                    }
+                    catch (GameException const & gex)
+                    {
+                        throw GameException("Error loading electrical layer image: " + std::string(gex.what()));
+                    }
+                }));
     }
 
-    std::optional<RgbImageData> ropesLayerImage;
+    std::optional<std::future<ConvertedRopesLayerImage>> ropesLayerImageFuture;
     if (ropesLayerImageFilePath.has_value())
     {
-        try
-        {
-            ropesLayerImage.emplace(
-                ImageFileTools::LoadImageRgb(*ropesLayerImageFilePath));
-        }
-        catch (GameException const & gex)
-        {
-            throw GameException("Error loading rope layer image: " + std::string(gex.what()));
-        }
+        ropesLayerImageFuture.emplace(
+            std::async(
+                std::launch::async,
+                [&ropesLayerImageFilePath, &materialDatabase]()
+                {
+                    try
+                    {
+                        std::optional<ConvertedRopesLayerImage> result;
+                        ImageFileTools::VisitImageRgb(
+                            *ropesLayerImageFilePath,
+                            [&](ImageFileTools::DecodedImageView<rgbColor> const & image)
+                            {
+                                result.emplace(ConvertRopesLayerImage(image, materialDatabase));
+                            });
+
+                        return std::move(*result);
+                    }
+                    catch (GameException const & gex)
+                    {
+                        throw GameException("Error loading rope layer image: " + std::string(gex.what()));
+                    }
+                }));
     }
 
-    std::optional<RgbaImageData> textureLayerImage;
+    std::optional<std::future<RgbaImageData>> textureLayerImageFuture;
     if (textureLayerImageFilePath.has_value())
     {
-        try
-        {
-            textureLayerImage.emplace(
-                ImageFileTools::LoadImageRgba(*textureLayerImageFilePath));
-        }
-        catch (GameException const & gex)
+        textureLayerImageFuture.emplace(
+            std::async(
+                std::launch::async,
+                [&textureLayerImageFilePath]()
+                {
+                    try
+                    {
+                        return ImageFileTools::LoadImageRgba(*textureLayerImageFilePath);
+                    }
+                    catch (GameException const & gex)
+                    {
+                        throw GameException("Error loading texture layer image: " + std::string(gex.what()));
+                    }
+                }));
+    }
+
+    std::optional<ConvertedStructuralLayerImage> structuralLayerImage;
+    ImageFileTools::VisitImageRgb(
+        structuralLayerImageFilePath,
+        [&](ImageFileTools::DecodedImageView<rgbColor> const & image)
         {
-            throw GameException("Error loading texture layer image: " + std::string(gex.what()));
-        }
+            structuralLayerImage.emplace(ConvertStructuralLayerImage(image, materialDatabase));
+        });
+
+    assert(structuralLayerImage.has_value());
+
+    // Collect results in the same order as we used to load images
+
+    std::optional<ConvertedElectricalLayerImage> electricalLayerImage;
+    if (electricalLayerImageFuture.has_value())
+    {
+        electricalLayerImage.emplace(electricalLayerImageFuture->get());
+    }
+
+    std::optional<ConvertedRopesLayerImage> ropesLayerImage;
+    if (ropesLayerImageFuture.has_value())
+    {
+        ropesLayerImage.emplace(ropesLayerImageFuture->get());
+    }
+
+    std::optional<RgbaImageData> textureLayerImage;
+    if (textureLayerImageFuture.has_value())
+    {
+        textureLayerImage.emplace(textureLayerImageFuture->get());
     }
 
     //
     // Materialize ship
     //
 
-    return LoadFromDefinitionImages(
-        std::move(structuralLayerImage),
+    return MakeShipDefinition(
+        std::move(*structuralLayerImage),
         std::move(electricalLayerImage),
         std::move(electricalPanel),
         std::move(ropesLayerImage),
         std::move(textureLayerImage),
         metadata,
         physicsData,
-        autoTexturizationSettings,
-        materialDatabase);
+        autoTexturizationSettings);
 }
 
-ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImages(
-    RgbImageData && structuralLayerImage,
-    std::optional<RgbImageData> && electricalLayerImage,
-    ElectricalPanel && electricalPanel,
-    std::optional<RgbImageData> && ropesLayerImage,
-    std::optional<RgbaImageData> && textureLayerImage,
-    ShipMetadata const & metadata,
-    ShipPhysicsData const & physicsData,
-    std::optional<ShipAutoTexturizationSettings> const & autoTexturizationSettings,
+ShipLegacyFormatDeSerializer::ConvertedStructuralLayerImage ShipLegacyFormatDeSerializer::ConvertStructuralLayerImage(
+    ImageFileTools::DecodedImageView<rgbColor> const & structuralLayerImage,
     MaterialDatabase const & materialDatabase)
 {
     ShipSpaceSize const shipSize(
         structuralLayerImage.Size.width,
         structuralLayerImage.Size.height);
 
-    // Create layers in any case - even though we might not need some
-
-    StructuralLayerData structuralLayer(shipSize);
-    bool hasStructuralElements = false;
-
-    ElectricalLayerData electricalLayer(shipSize, std::move(electricalPanel));
-    bool hasElectricalElements = false;
-
-    RopesLayerData ropesLayer(shipSize);
-    bool hasRopeElements = false;
-
-    std::unique_ptr<TextureLayerData> textureLayer = textureLayerImage.has_value()
-        ? std::make_unique<TextureLayerData>(std::move(*textureLayerImage))
-        : nullptr;
+    ConvertedStructuralLayerImage result(shipSize);
 
-    // Table remembering rope endpoints - three values:
-    // - Entry not in map: haven't seen color key
-    // - Entry in map: have seen first endpoint, corods is value
-    // - Entry in map without value: have seen second endpoint
-    std::map<MaterialColorKey, std::optional<ShipSpaceCoordinates>> ropeFirstEndpointCoordsByColorKey;
+    // Materials of the row being visited
+    std::vector<StructuralMaterial const *> rowStructuralMaterials(static_cast<size_t>(shipSize.width));
 
-    //////////////////////////////////////////////////////////////////////////////////////////////////
-    // 1. Process structural layer, eventually creating electrical and rope elements from legacy
-    //    specifications
-    //////////////////////////////////////////////////////////////////////////////////////////////////
+    // Visit all rows, from bottom to top
+    for (int y = 0; y < shipSize.height; ++y)
+    {
+        rgbColor const * const imageRow = structuralLayerImage.GetRow(y);
+        StructuralElement * const layerRow = result.Layer.Buffer.Data.get() + static_cast<size_t>(y) * static_cast<size_t>(shipSize.width);
 
-    ropeFirstEndpointCoordsByColorKey.clear();
+        // Lookup structural materials for the whole row at once
+        materialDatabase.FindStructuralMaterials(
+            imageRow,
+            static_cast<size_t>(shipSize.width),
+            rowStructuralMaterials.data());
 
-    // Visit all columns
-    for (int x = 0; x < shipSize.width; ++x)
-    {
-        // From bottom to top
-        for (int y = 0; y < shipSize.height; ++y)
+        for (int x = 0; x < shipSize.width; ++x)
         {
-            ImageCoordinates const imageCoords(x, y);
-
-            // Lookup structural material
-            MaterialColorKey const colorKey = structuralLayerImage[imageCoords];
-            StructuralMaterial const * structuralMaterial = materialDatabase.FindStructuralMaterial(colorKey);
+            MaterialColorKey const colorKey = imageRow[x];
+            StructuralMaterial const * const structuralMaterial = rowStructuralMaterials[x];
             if (nullptr != structuralMaterial)
             {
-                ShipSpaceCoordinates const coords = ShipSpaceCoordinates(x, y);
-
                 // Store structural element
-                structuralLayer.Buffer[coords] = StructuralElement(structuralMaterial);
+                layerRow[x] = StructuralElement(structuralMaterial);
 
                 //
                 // Check if it's also a legacy electrical element
@@ -435,13 +474,9 @@ ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImages(
                     // Cannot have instanced elements in legacy mode
                     assert(!electricalMaterial->IsInstanced);
 
-                    // Store electrical element
-                    electricalLayer.Buffer[coords] = ElectricalElement(
-                        electricalMaterial,
-                        NoneElectricalElementInstanceIndex);
-
-                    // Remember we have seen at least one electrical element
-                    hasElectricalElements = true;
+                    result.LegacyElectricalElements.emplace_back(
+                        ShipSpaceCoordinates(x, y),
+                        electricalMaterial);
                 }
 
                 //
@@ -451,170 +486,165 @@ ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImages(
                 if (structuralMaterial->IsUniqueType(StructuralMaterial::MaterialUniqueType::Rope)
                     && !materialDatabase.IsUniqueStructuralMaterialColorKey(StructuralMaterial::MaterialUniqueType::Rope, colorKey))
                 {
-                    // Check if it's the first or the second endpoint for the rope
-                    auto searchIt = ropeFirstEndpointCoordsByColorKey.find(colorKey);
-                    if (searchIt == ropeFirstEndpointCoordsByColorKey.end())
-                    {
-                        // First time we see the rope color key
-                        ropeFirstEndpointCoordsByColorKey[colorKey] = coords;
-                    }
-                    else if (searchIt->second.has_value())
-                    {
-                        // Second time we see the rope color key
-
-                        // Store rope element
-                        rgbaColor const ropeColor = rgbaColor(colorKey, 255);
-                        ropesLayer.Buffer.EmplaceBack(
-                            *(searchIt->second),
-                            coords,
-                            structuralMaterial,
-                            ropeColor);
-
-                        // Remember we have seen at least one rope element
-                        hasRopeElements = true;
-
-                        // Mark as "complete"
-                        searchIt->second.reset();
-                    }
-                    else
-                    {
-                        // Too many rope endpoints for this color key
-                        throw GameException(
-                            "More than two rope endpoints for rope color \"" + colorKey.toString() + "\", detected at "
-                            + imageCoords.FlipY(shipSize.height).ToString());
-                    }
+                    result.LegacyRopeEndpoints.emplace_back(
+                        ShipSpaceCoordinates(x, y),
+                        colorKey,
+                        structuralMaterial);
                 }
 
                 // Remember we have seen at least one structural element
-                hasStructuralElements = true;
+                result.HasStructuralElements = true;
             }
         }
     }
 
-    // Make sure all rope endpoints are matched
-    {
-        auto const unmatchedSrchIt = std::find_if(
-            ropeFirstEndpointCoordsByColorKey.cbegin(),
-            ropeFirstEndpointCoordsByColorKey.cend(),
-            [](auto const & entry)
-            {
-                return entry.second.has_value();
-            });
+    return result;
+}
 
-        if (unmatchedSrchIt != ropeFirstEndpointCoordsByColorKey.cend())
-        {
-            throw GameException("Rope endpoint with color key \"" + unmatchedSrchIt->first.toString() + "\" is unmatched");
-        }
-    }
+ShipLegacyFormatDeSerializer::ConvertedRopesLayerImage ShipLegacyFormatDeSerializer::ConvertRopesLayerImage(
+    ImageFileTools::DecodedImageView<rgbColor> const & ropesLayerImage,
+    MaterialDatabase const & materialDatabase)
+{
+    ConvertedRopesLayerImage result(
+        ShipSpaceSize(
+            ropesLayerImage.Size.width,
+            ropesLayerImage.Size.height));
 
-    //////////////////////////////////////////////////////////////////////////////////////////////////
-    // 2. Process ropes layer - if any - creating rope elements
-    //////////////////////////////////////////////////////////////////////////////////////////////////
+    StructuralMaterial const & standardRopeMaterial = materialDatabase.GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType::Rope);
 
-    if (ropesLayerImage.has_value())
+    // Visit all rows, from bottom to top
+    for (int y = 0; y < result.Size.height; ++y)
     {
-        // Make sure dimensions match
-        if (ropesLayerImage->Size != structuralLayerImage.Size)
+        rgbColor const * const imageRow = ropesLayerImage.GetRow(y);
+
+        for (int x = 0; x < result.Size.width; ++x)
         {
-            throw GameException("The size of the image used for the ropes layer must match the size of the image used for the structural layer");
+            // Check if it's a rope endpoint: iff different than background
+            MaterialColorKey const colorKey = imageRow[x];
+            if (colorKey != EmptyMaterialColorKey)
+            {
+                result.RopeEndpoints.emplace_back(
+                    ShipSpaceCoordinates(x, y),
+                    colorKey,
+                    &standardRopeMaterial);
+            }
         }
+    }
 
-        StructuralMaterial const & standardRopeMaterial = materialDatabase.GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType::Rope);
+    return result;
+}
 
-        ropeFirstEndpointCoordsByColorKey.clear();
+ShipLegacyFormatDeSerializer::ConvertedElectricalLayerImage ShipLegacyFormatDeSerializer::ConvertElectricalLayerImage(
+    ImageFileTools::DecodedImageView<rgbColor> const & electricalLayerImage,
+    MaterialDatabase const & materialDatabase)
+{
+    ConvertedElectricalLayerImage result(
+        ShipSpaceSize(
+            electricalLayerImage.Size.width,
+            electricalLayerImage.Size.height));
 
-        // Visit all columns
-        for (int x = 0; x < shipSize.width; ++x)
+    // Visit all rows, from bottom to top
+    for (int y = 0; y < result.Buffer.Size.height; ++y)
+    {
+        rgbColor const * const imageRow = electricalLayerImage.GetRow(y);
+        ElectricalElement * const layerRow = result.Buffer.Data.get() + static_cast<size_t>(y) * static_cast<size_t>(result.Buffer.Size.width);
+
+        for (int x = 0; x < result.Buffer.Size.width; ++x)
         {
-            // From bottom to top
-            for (int y = 0; y < shipSize.height; ++y)
+            // Check if it's an electrical material: iff different than background
+            MaterialColorKey const colorKey = imageRow[x];
+            if (colorKey != EmptyMaterialColorKey)
             {
-                // Check if it's a rope endpoint: iff different than background
-                ImageCoordinates const imageCoords(x, y);
-                MaterialColorKey colorKey = (*ropesLayerImage)[imageCoords];
-                if (colorKey != EmptyMaterialColorKey)
+                // Get material (matching instanced elements on r and g only)
+                ElectricalMaterial const * const electricalMaterial = materialDatabase.FindElectricalMaterialLegacy(colorKey);
+                if (electricalMaterial == nullptr)
                 {
-                    //
-                    // It's a rope endpoint
-                    //
-
-                    ShipSpaceCoordinates const coords = ShipSpaceCoordinates(x, y);
-
-                    rgbaColor const ropeColor = rgbaColor(colorKey, 255);
-
-                    // Make sure we don't have a rope already with an endpoint here
-                    if (std::find_if(
-                            ropesLayer.Buffer.cbegin(),
-                            ropesLayer.Buffer.cend(),
-                            [&coords](RopeElement const & e)
-                            {
-                                return e.StartCoords == coords
-                                    || e.EndCoords == coords;
-                            }) != ropesLayer.Buffer.cend())
+                    // Remember it, as errors are reported in column-major order
+                    if (!result.FirstUnrecognizedPixel.has_value()
+                        || x < result.FirstUnrecognizedPixel->first.x)
                     {
-                        throw GameException("There is already a rope endpoint at " + imageCoords.FlipY(shipSize.height).ToString());
+                        result.FirstUnrecognizedPixel.emplace(ShipSpaceCoordinates(x, y), colorKey);
                     }
 
-                    // Check if it's the first or the second endpoint for the rope
-                    auto searchIt = ropeFirstEndpointCoordsByColorKey.find(colorKey);
-                    if (searchIt == ropeFirstEndpointCoordsByColorKey.end())
-                    {
-                        // First time we see the rope color key
-                        ropeFirstEndpointCoordsByColorKey[colorKey] = coords;
-                    }
-                    else if (searchIt->second.has_value())
-                    {
-                        // Second time we see the rope color key
-
-                        // Store rope element
-                        ropesLayer.Buffer.EmplaceBack(
-                            *(searchIt->second),
-                            coords,
-                            &standardRopeMaterial,
-                            ropeColor);
+                    continue;
+                }
 
-                        // Remember we have seen at least one rope element
-                        hasRopeElements = true;
+                // Extract instance index, if material requires one
+                ElectricalElementInstanceIndex const instanceIndex = electricalMaterial->IsInstanced
+                    ? MaterialDatabase::ExtractElectricalElementInstanceIndex(colorKey)
+                    : NoneElectricalElementInstanceIndex;
 
-                        // Mark as "complete"
-                        searchIt->second.reset();
-                    }
-                    else
-                    {
-                        // Too many rope endpoints for this color key
-                        throw GameException(
-                            "More than two rope endpoints for rope color \"" + colorKey.toString() + "\", detected at "
-                            + imageCoords.FlipY(shipSize.height).ToString());
-                    }
-                }
+                layerRow[x] = ElectricalElement(
+                    electricalMaterial,
+                    instanceIndex);
             }
         }
+    }
 
-        // Make sure all rope endpoints are matched
-        {
-            auto const unmatchedSrchIt = std::find_if(
-                ropeFirstEndpointCoordsByColorKey.cbegin(),
-                ropeFirstEndpointCoordsByColorKey.cend(),
-                [](auto const & entry)
-                {
-                    return entry.second.has_value();
-                });
+    return result;
+}
 
-            if (unmatchedSrchIt != ropeFirstEndpointCoordsByColorKey.cend())
-            {
-                throw GameException("Rope endpoint with color key \"" + unmatchedSrchIt->first.toString() + "\" is unmatched");
-            }
+ShipDefinition ShipLegacyFormatDeSerializer::MakeShipDefinition(
+    ConvertedStructuralLayerImage && structuralLayerImage,
+    std::optional<ConvertedElectricalLayerImage> && electricalLayerImage,
+    ElectricalPanel && electricalPanel,
+    std::optional<ConvertedRopesLayerImage> && ropesLayerImage,
+    std::optional<RgbaImageData> && textureLayerImage,
+    ShipMetadata const & metadata,
+    ShipPhysicsData const & physicsData,
+    std::optional<ShipAutoTexturizationSettings> const & autoTexturizationSettings)
+{
+    ShipSpaceSize const shipSize = structuralLayerImage.Layer.Buffer.Size;
+
+    StructuralLayerData structuralLayer = std::move(structuralLayerImage.Layer);
+    bool const hasStructuralElements = structuralLayerImage.HasStructuralElements;
+
+    RopesLayerData ropesLayer(shipSize);
+
+    std::unique_ptr<TextureLayerData> textureLayer = textureLayerImage.has_value()
+        ? std::make_unique<TextureLayerData>(std::move(*textureLayerImage))
+        : nullptr;
+
+    //////////////////////////////////////////////////////////////////////////////////////////////////
+    // 1. Create rope elements from legacy specifications in structural layer
+    //////////////////////////////////////////////////////////////////////////////////////////////////
+
+    MakeRopes(
+        structuralLayerImage.LegacyRopeEndpoints,
+        shipSize,
+        ropesLayer);
+
+    //////////////////////////////////////////////////////////////////////////////////////////////////
+    // 2. Process ropes layer - if any - creating rope elements
+    //////////////////////////////////////////////////////////////////////////////////////////////////
+
+    if (ropesLayerImage.has_value())
+    {
+        // Make sure dimensions match
+        if (ropesLayerImage->Size != shipSize)
+        {
+            throw GameException("The size of the image used for the ropes layer must match the size of the image used for the structural layer");
         }
+
+        MakeRopes(
+            ropesLayerImage->RopeEndpoints,
+            shipSize,
+            ropesLayer);
     }
 
+    bool const hasRopeElements = ropesLayer.Buffer.GetElementCount() > 0;
+
     //////////////////////////////////////////////////////////////////////////////////////////////////
-    // 3. Process electrical layer - if any
+    // 3. Process electrical layer - if any - and legacy electrical elements in structural layer
     //////////////////////////////////////////////////////////////////////////////////////////////////
 
+    std::unique_ptr<ElectricalLayerData> electricalLayer;
+    bool hasElectricalElements = false;
+
     if (electricalLayerImage.has_value())
     {
         // Make sure dimensions match
-        if (electricalLayerImage->Size != structuralLayerImage.Size)
+        if (electricalLayerImage->Buffer.Size != shipSize)
         {
             throw GameException("The size of the image used for the electrical layer must match the size of the image used for the structural layer");
         }
@@ -627,37 +657,24 @@ ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImages(
             // From bottom to top
             for (int y = 0; y < shipSize.height; ++y)
             {
-                // Check if it's an electrical material: iff different than background
+                ShipSpaceCoordinates const coords = ShipSpaceCoordinates(x, y);
                 ImageCoordinates const imageCoords(x, y);
-                MaterialColorKey colorKey = (*electricalLayerImage)[imageCoords];
-                if (colorKey != EmptyMaterialColorKey)
-                {
-                    //
-                    // It's an electrical material
-                    //
-
-                    ShipSpaceCoordinates const coords = ShipSpaceCoordinates(x, y);
 
-                    // Get material (matching instanced elements on r and g only)
-                    ElectricalMaterial const * const electricalMaterial = materialDatabase.FindElectricalMaterialLegacy(colorKey);
-                    if (electricalMaterial == nullptr)
-                    {
-                        throw GameException(
-                            "Color key \"" + Utils::RgbColor2Hex(colorKey)
-                            + "\" of pixel found at " + imageCoords.FlipY(shipSize.height).ToString()
-                            + " in the electrical layer image");
-                    }
+                if (electricalLayerImage->FirstUnrecognizedPixel.has_value()
+                    && electricalLayerImage->FirstUnrecognizedPixel->first == coords)
+                {
+                    throw GameException(
+                        "Color key \"" + Utils::RgbColor2Hex(electricalLayerImage->FirstUnrecognizedPixel->second)
+                        + "\" of pixel found at " + imageCoords.FlipY(shipSize.height).ToString()
+                        + " in the electrical layer image");
+                }
 
+                ElectricalElement const & electricalElement = electricalLayerImage->Buffer[coords];
+                if (electricalElement.Material != nullptr)
+                {
                     // Make sure we have a structural point here, or a rope endpoint
                     if (structuralLayer.Buffer[coords].Material == nullptr
-                        && std::find_if(
-                                ropesLayer.Buffer.cbegin(),
-                                ropesLayer.Buffer.cend(),
-                                [&coords](RopeElement const & e)
-                                {
-                                    return e.StartCoords == coords
-                                        || e.EndCoords == coords;
-                                }) == ropesLayer.Buffer.cend())
+                        && !ropesLayer.Buffer.HasEndpointAt(coords))
                     {
                         throw GameException(
                             "The electrical layer image specifies an electrical material at "
@@ -665,19 +682,15 @@ ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImages(
                             + ", but no pixel may be found at those coordinates in either the structural or the ropes layer image");
                     }
 
-                    // Extract instance index, if material requires one
-                    ElectricalElementInstanceIndex instanceIndex;
-                    if (electricalMaterial->IsInstanced)
+                    // Make sure instance ID is not dupe
+                    if (electricalElement.Material->IsInstanced)
                     {
-                        instanceIndex = MaterialDatabase::ExtractElectricalElementInstanceIndex(colorKey);
-
-                        // Make sure instance ID is not dupe
-                        auto const searchIt = seenInstanceIndicesToImageCoords.find(instanceIndex);
+                        auto const searchIt = seenInstanceIndicesToImageCoords.find(electricalElement.InstanceIndex);
                         if (searchIt != seenInstanceIndicesToImageCoords.end())
                         {
                             throw GameException(
                                 "Found two electrical elements with instance ID \""
-                                + std::to_string(instanceIndex)
+                                + std::to_string(electricalElement.InstanceIndex)
                                 + "\" in the electrical layer image, at " + searchIt->second.FlipY(shipSize.height).ToString()
                                 + " and at " + imageCoords.FlipY(shipSize.height).ToString() + "; "
                                 + " make sure that all instanced elements"
@@ -687,25 +700,40 @@ ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImages(
                         {
                             // First time we see it
                             seenInstanceIndicesToImageCoords.emplace(
-                                instanceIndex,
+                                electricalElement.InstanceIndex,
                                 imageCoords);
                         }
                     }
-                    else
-                    {
-                        instanceIndex = NoneElectricalElementInstanceIndex;
-                    }
-
-                    // Store electrical element
-                    electricalLayer.Buffer[coords] = ElectricalElement(
-                        electricalMaterial,
-                        instanceIndex);
 
                     // Remember we have seen at least one electrical element
                     hasElectricalElements = true;
                 }
             }
         }
+
+        electricalLayer = std::make_unique<ElectricalLayerData>(
+            std::move(electricalLayerImage->Buffer),
+            std::move(electricalPanel));
+    }
+    else
+    {
+        electricalLayer = std::make_unique<ElectricalLayerData>(
+            shipSize,
+            std::move(electricalPanel));
+    }
+
+    // Legacy electrical elements are overridden by the electrical layer
+    for (auto const & [coords, electricalMaterial] : structuralLayerImage.LegacyElectricalElements)
+    {
+        if (electricalLayer->Buffer[coords].Material == nullptr)
+        {
+            electricalLayer->Buffer[coords] = ElectricalElement(
+                electricalMaterial,
+                NoneElectricalElementInstanceIndex);
+        }
+
+        // Remember we have seen at least one electrical element
+        hasElectricalElements = true;
     }
 
     //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -721,10 +749,91 @@ ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImages(
         ShipLayers(
             shipSize,
             hasStructuralElements ? std::make_unique<StructuralLayerData>(std::move(structuralLayer)) : nullptr,
-            hasElectricalElements ? std::make_unique<ElectricalLayerData>(std::move(electricalLayer)) : nullptr,
+            hasElectricalElements ? std::move(electricalLayer) : nullptr,
             hasRopeElements ? std::make_unique<RopesLayerData>(std::move(ropesLayer)) : nullptr,
             std::move(textureLayer)),
         metadata,
         physicsData,
         autoTexturizationSettings);
-}
\ No newline at end of file
+}
+
+void ShipLegacyFormatDeSerializer::MakeRopes(
+    std::vector<RopeEndpoint> & ropeEndpoints,
+    ShipSpaceSize const & shipSize,
+    RopesLayerData & ropesLayer)
+{
+    // Endpoints are paired in column-major order
+    std::sort(
+        ropeEndpoints.begin(),
+        ropeEndpoints.end(),
+        [](RopeEndpoint const & lhs, RopeEndpoint const & rhs)
+        {
+            return lhs.Coords.x < rhs.Coords.x
+                || (lhs.Coords.x == rhs.Coords.x && lhs.Coords.y < rhs.Coords.y);
+        });
+
+    // Table remembering rope endpoints - three values:
+    // - Entry not in map: haven't seen color key
+    // - Entry in map: have seen first endpoint, corods is value
+    // - Entry in map without value: have seen second endpoint
+    std::map<MaterialColorKey, std::optional<ShipSpaceCoordinates>> ropeFirstEndpointCoordsByColorKey;
+
+    for (auto const & ropeEndpoint : ropeEndpoints)
+    {
+        ShipSpaceCoordinates const & coords = ropeEndpoint.Coords;
+        ImageCoordinates const imageCoords(coords.x, coords.y);
+        MaterialColorKey const & colorKey = ropeEndpoint.ColorKey;
+
+        // Make sure we don't have a rope already with an endpoint here
+        if (ropesLayer.Buffer.HasEndpointAt(coords))
+        {
+            throw GameException("There is already a rope endpoint at " + imageCoords.FlipY(shipSize.height).ToString());
+        }
+
+        // Check if it's the first or the second endpoint for the rope
+        auto searchIt = ropeFirstEndpointCoordsByColorKey.find(colorKey);
+        if (searchIt == ropeFirstEndpointCoordsByColorKey.end())
+        {
+            // First time we see the rope color key
+            ropeFirstEndpointCoordsByColorKey[colorKey] = coords;
+        }
+        else if (searchIt->second.has_value())
+        {
+            // Second time we see the rope color key
+
+            // Store rope element
+            rgbaColor const ropeColor = rgbaColor(colorKey, 255);
+            ropesLayer.Buffer.EmplaceBack(
+                *(searchIt->second),
+                coords,
+                ropeEndpoint.Material,
+                ropeColor);
+
+            // Mark as "complete"
+            searchIt->second.reset();
+        }
+        else
+        {
+            // Too many rope endpoints for this color key
+            throw GameException(
+                "More than two rope endpoints for rope color \"" + colorKey.toString() + "\", detected at "
+                + imageCoords.FlipY(shipSize.height).ToString());
+        }
+    }
+
+    // Make sure all rope endpoints are matched
+    {
+        auto const unmatchedSrchIt = std::find_if(
+            ropeFirstEndpointCoordsByColorKey.cbegin(),
+            ropeFirstEndpointCoordsByColorKey.cend(),
+            [](auto const & entry)
+            {
+                return entry.second.has_value();
+            });
+
+        if (unmatchedSrchIt != ropeFirstEndpointCoordsByColorKey.cend())
+        {
+            throw GameException("Rope endpoint with color key \"" + unmatchedSrchIt->first.toString() + "\" is unmatched");
+        }
+    }
+}
@@ -6,15 +6,20 @@
 #pragma once
 
 #include "ElectricalPanel.h"
+#include "ImageFileTools.h"
+#include "Layers.h"
 #include "MaterialDatabase.h"
 #include "ShipDefinition.h"
 #include "ShipPreviewData.h"
 
+#include <GameCore/Buffer2D.h>
 #include <GameCore/ImageData.h>
 
 #include <cstdint>
 #include <filesystem>
 #include <optional>
+#include <utility>
+#include <vector>
 
 /*
  * All the logic to load and save ships from and to legacy format files.
@@ -85,14 +90,91 @@ private:
         std::optional<ShipAutoTexturizationSettings> const & autoTexturizationSettings,
         MaterialDatabase const & materialDatabase);
 
-    static ShipDefinition LoadFromDefinitionImages(
-        RgbImageData && structuralLayerImage,
-        std::optional<RgbImageData> && electricalLayerImage,
+    //
+    // Layer images are decoded and converted into layer elements concurrently, one thread
+    // per image, straight out of the decoder's buffer; what depends on more than one
+    // layer - or on the order in which pixels are visited - is then done serially.
+    //
+
+    struct RopeEndpoint
+    {
+        ShipSpaceCoordinates Coords;
+        MaterialColorKey ColorKey;
+        StructuralMaterial const * Material;
+
+        RopeEndpoint(
+            ShipSpaceCoordinates const & coords,
+            MaterialColorKey const & colorKey,
+            StructuralMaterial const * material)
+            : Coords(coords)
+            , ColorKey(colorKey)
+            , Material(material)
+        {}
+    };
+
+    struct ConvertedStructuralLayerImage
+    {
+        StructuralLayerData Layer;
+        bool HasStructuralElements;
+        std::vector<std::pair<ShipSpaceCoordinates, ElectricalMaterial const *>> LegacyElectricalElements;
+        std::vector<RopeEndpoint> LegacyRopeEndpoints;
+
+        explicit ConvertedStructuralLayerImage(ShipSpaceSize const & shipSize)
+            : Layer(shipSize)
+            , HasStructuralElements(false)
+            , LegacyElectricalElements()
+            , LegacyRopeEndpoints()
+        {}
+    };
+
+    struct ConvertedRopesLayerImage
+    {
+        ShipSpaceSize Size;
+        std::vector<RopeEndpoint> RopeEndpoints;
+
+        explicit ConvertedRopesLayerImage(ShipSpaceSize const & size)
+            : Size(size)
+            , RopeEndpoints()
+        {}
+    };
+
+    struct ConvertedElectricalLayerImage
+    {
+        Buffer2D<ElectricalElement, struct ShipSpaceTag> Buffer;
+
+        // The first pixel - in column-major order - whose color key is not an electrical material
+        std::optional<std::pair<ShipSpaceCoordinates, MaterialColorKey>> FirstUnrecognizedPixel;
+
+        explicit ConvertedElectricalLayerImage(ShipSpaceSize const & size)
+            : Buffer(size)
+            , FirstUnrecognizedPixel()
+        {}
+    };
+
+    static ConvertedStructuralLayerImage ConvertStructuralLayerImage(
+        ImageFileTools::DecodedImageView<rgbColor> const & structuralLayerImage,
+        MaterialDatabase const & materialDatabase);
+
+    static ConvertedRopesLayerImage ConvertRopesLayerImage(
+        ImageFileTools::DecodedImageView<rgbColor> const & ropesLayerImage,
+        MaterialDatabase const & materialDatabase);
+
+    static ConvertedElectricalLayerImage ConvertElectricalLayerImage(
+        ImageFileTools::DecodedImageView<rgbColor> const & electricalLayerImage,
+        MaterialDatabase const & materialDatabase);
+
+    static ShipDefinition MakeShipDefinition(
+        ConvertedStructuralLayerImage && structuralLayerImage,
+        std::optional<ConvertedElectricalLayerImage> && electricalLayerImage,
         ElectricalPanel && electricalPanel,
-        std::optional<RgbImageData> && ropesLayerImage,
+        std::optional<ConvertedRopesLayerImage> && ropesLayerImage,
         std::optional<RgbaImageData> && textureLayerImage,
         ShipMetadata const & metadata,
         ShipPhysicsData const & physicsData,
-        std::optional<ShipAutoTexturizationSettings> const & autoTexturizationSettings,
-        MaterialDatabase const & materialDatabase);
+        std::optional<ShipAutoTexturizationSettings> const & autoTexturizationSettings);
+
+    static void MakeRopes(
+        std::vector<RopeEndpoint> & ropeEndpoints,
+        ShipSpaceSize const & shipSize,
+        RopesLayerData & ropesLayer);
 };
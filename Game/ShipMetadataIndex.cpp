@@ -0,0 +1,698 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-02-10
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipMetadataIndex.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/Log.h>
+#include <GameCore/Utils.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <limits>
+
+static std::filesystem::path const IndexFileName = ".floatingsandbox_shipindex";
+
+static std::string const IndexFileTitle = "FLOATING SANDBOX SHIP INDEX";
+static std::uint32_t constexpr IndexFileFormatVersion = 1;
+
+namespace /* anonymous */ {
+
+std::uint64_t ToPersisted(std::filesystem::file_time_type lastModified)
+{
+    return static_cast<std::uint64_t>(lastModified.time_since_epoch().count());
+}
+
+std::filesystem::file_time_type FromPersisted(std::uint64_t lastModified)
+{
+    return std::filesystem::file_time_type(
+        std::filesystem::file_time_type::duration(
+            static_cast<std::filesystem::file_time_type::rep>(lastModified)));
+}
+
+bool IsPreviewFromShipFile(
+    std::filesystem::path const & shipFilePath,
+    ShipPreviewData const & shipPreviewData)
+{
+    return shipPreviewData.PreviewFilePath == shipFilePath;
+}
+
+// Presence flags of optional metadata fields
+std::uint8_t constexpr HasAuthorFlag = 1 << 0;
+std::uint8_t constexpr HasArtCreditsFlag = 1 << 1;
+std::uint8_t constexpr HasYearBuiltFlag = 1 << 2;
+std::uint8_t constexpr HasDescriptionFlag = 1 << 3;
+std::uint8_t constexpr HasPasswordFlag = 1 << 4;
+
+/*
+ * Reads from a buffer, validating reads against the buffer's size - we can't trust
+ * the file's content.
+ */
+class BufferReader
+{
+public:
+
+    explicit BufferReader(DeSerializationBuffer<BigEndianess> const & buffer)
+        : mBuffer(buffer)
+        , mIndex(0)
+    {}
+
+    template<typename T>
+    T Read()
+    {
+        EnsureAvailable(sizeof(T));
+
+        T value;
+        mIndex += mBuffer.ReadAt(mIndex, value);
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        std::uint32_t const length = Read<std::uint32_t>();
+        EnsureAvailable(length);
+
+        std::string value(reinterpret_cast<char const *>(mBuffer.GetData()) + mIndex, length);
+        mIndex += length;
+        return value;
+    }
+
+    bool IsAtEnd() const
+    {
+        return mIndex == mBuffer.GetSize();
+    }
+
+private:
+
+    void EnsureAvailable(size_t size) const
+    {
+        if (mIndex + size > mBuffer.GetSize())
+        {
+            throw GameException("Index file is truncated");
+        }
+    }
+
+    DeSerializationBuffer<BigEndianess> const & mBuffer;
+    size_t mIndex;
+};
+
+}
+
+std::filesystem::path ShipMetadataIndex::GetIndexFilePath(std::filesystem::path const & directoryPath)
+{
+    return directoryPath / IndexFileName;
+}
+
+ShipMetadataIndex ShipMetadataIndex::Load(
+    std::filesystem::path const & directoryPath,
+    std::shared_ptr<IFileSystem> fileSystem)
+{
+    std::map<std::filesystem::path, Entry> entries;
+
+    auto const indexFilePath = GetIndexFilePath(directoryPath);
+
+    try
+    {
+        if (fileSystem->Exists(indexFilePath))
+        {
+            auto indexFileStream = fileSystem->OpenInputStream(indexFilePath);
+            if (indexFileStream)
+            {
+                // Read whole file
+                indexFileStream->seekg(0, std::ios_base::end);
+                auto const fileSize = static_cast<size_t>(indexFileStream->tellg());
+                indexFileStream->seekg(0, std::ios_base::beg);
+
+                DeSerializationBuffer<BigEndianess> buffer(fileSize);
+                indexFileStream->read(reinterpret_cast<char *>(buffer.Receive(fileSize)), fileSize);
+                if (!indexFileStream->good())
+                {
+                    throw GameException("Error reading index file");
+                }
+
+                entries = Deserialize(buffer);
+            }
+        }
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("ShipMetadataIndex::Load(): error loading index \"", indexFilePath.string(), "\": ", ex.what());
+
+        // Start from scratch
+        entries.clear();
+    }
+
+    return ShipMetadataIndex(
+        directoryPath,
+        std::move(fileSystem),
+        std::move(entries));
+}
+
+std::optional<ShipPreviewData> ShipMetadataIndex::TryGetPreviewData(
+    std::filesystem::path const & shipFilePath,
+    std::filesystem::file_time_type shipFileLastModified)
+{
+    auto const shipFilename = shipFilePath.filename();
+
+    mVisitedShipFilenames.insert(shipFilename);
+
+    auto const it = mEntries.find(shipFilename);
+    if (it != mEntries.end()
+        && it->second.ShipFileLastModified == shipFileLastModified
+        && it->second.IsPreviewFromShipFile)
+    {
+        return ShipPreviewData(
+            shipFilePath,
+            it->second.ShipSize,
+            it->second.Metadata,
+            it->second.IsHD,
+            it->second.HasElectricals,
+            it->second.LastWriteTime);
+    }
+
+    return std::nullopt;
+}
+
+void ShipMetadataIndex::Update(
+    std::filesystem::path const & shipFilePath,
+    std::filesystem::file_time_type shipFileLastModified,
+    ShipPreviewData const & shipPreviewData)
+{
+    auto const shipFilename = shipFilePath.filename();
+
+    mVisitedShipFilenames.insert(shipFilename);
+
+    mEntries.insert_or_assign(
+        shipFilename,
+        Entry(
+            shipFileLastModified,
+            shipPreviewData.ShipSize,
+            shipPreviewData.Metadata,
+            shipPreviewData.IsHD,
+            shipPreviewData.HasElectricals,
+            shipPreviewData.LastWriteTime,
+            IsPreviewFromShipFile(shipFilePath, shipPreviewData)));
+
+    mIsDirty = true;
+}
+
+void ShipMetadataIndex::Commit(bool isVisitCompleted)
+{
+    auto const indexFilePath = GetIndexFilePath(mDirectoryPath);
+
+    try
+    {
+        if (isVisitCompleted)
+        {
+            // Remove entries for ships that are gone
+            for (auto it = mEntries.begin(); it != mEntries.end(); )
+            {
+                if (mVisitedShipFilenames.count(it->first) == 0)
+                {
+                    it = mEntries.erase(it);
+                    mIsDirty = true;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        if (!mEntries.empty())
+        {
+            if (mIsDirty)
+            {
+                auto const indexTemporaryFilePath = std::filesystem::path(indexFilePath).replace_extension("tmp");
+
+                DeSerializationBuffer<BigEndianess> buffer(64 * 1024);
+                Serialize(mEntries, buffer);
+
+                {
+                    auto indexFileStream = mFileSystem->OpenOutputStream(indexTemporaryFilePath);
+                    indexFileStream->write(reinterpret_cast<char const *>(buffer.GetData()), buffer.GetSize());
+                }
+
+                // Swap temp file
+                if (mFileSystem->Exists(indexFilePath))
+                {
+                    mFileSystem->DeleteFile(indexFilePath);
+                }
+
+                mFileSystem->RenameFile(indexTemporaryFilePath, indexFilePath);
+            }
+        }
+        else if (isVisitCompleted && mFileSystem->Exists(indexFilePath))
+        {
+            // Nothing in this folder for the index
+            mFileSystem->DeleteFile(indexFilePath);
+        }
+
+        mIsDirty = false;
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("ShipMetadataIndex::Commit(): error committing index \"", indexFilePath.string(), "\": ", ex.what());
+    }
+}
+
+void ShipMetadataIndex::Serialize(
+    std::map<std::filesystem::path, Entry> const & entries,
+    DeSerializationBuffer<BigEndianess> & buffer)
+{
+    // Header
+    buffer.Append(IndexFileTitle);
+    buffer.Append(IndexFileFormatVersion);
+    buffer.Append(static_cast<std::uint32_t>(entries.size()));
+
+    // Entries
+    for (auto const & [shipFilename, entry] : entries)
+    {
+        buffer.Append(shipFilename.string());
+        buffer.Append(ToPersisted(entry.ShipFileLastModified));
+
+        buffer.Append(static_cast<std::uint32_t>(entry.ShipSize.width));
+        buffer.Append(static_cast<std::uint32_t>(entry.ShipSize.height));
+
+        ShipMetadata const & metadata = entry.Metadata;
+
+        std::uint8_t const presenceFlags =
+            (metadata.Author.has_value() ? HasAuthorFlag : 0)
+            | (metadata.ArtCredits.has_value() ? HasArtCreditsFlag : 0)
+            | (metadata.YearBuilt.has_value() ? HasYearBuiltFlag : 0)
+            | (metadata.Description.has_value() ? HasDescriptionFlag : 0)
+            | (metadata.Password.has_value() ? HasPasswordFlag : 0);
+
+        buffer.Append(presenceFlags);
+        buffer.Append(metadata.ShipName);
+        if (metadata.Author.has_value())
+            buffer.Append(*metadata.Author);
+        if (metadata.ArtCredits.has_value())
+            buffer.Append(*metadata.ArtCredits);
+        if (metadata.YearBuilt.has_value())
+            buffer.Append(*metadata.YearBuilt);
+        if (metadata.Description.has_value())
+            buffer.Append(*metadata.Description);
+        if (metadata.Password.has_value())
+            buffer.Append(static_cast<std::uint64_t>(*metadata.Password));
+        buffer.Append(metadata.Scale.inputUnits);
+        buffer.Append(metadata.Scale.outputUnits);
+        buffer.Append(metadata.DoHideElectricalsInPreview);
+        buffer.Append(metadata.DoHideHDInPreview);
+
+        buffer.Append(entry.IsHD);
+        buffer.Append(entry.HasElectricals);
+        buffer.Append(static_cast<std::uint64_t>(entry.LastWriteTime.Value()));
+        buffer.Append(entry.IsPreviewFromShipFile);
+    }
+
+    // Trailer, to detect truncated files
+    buffer.Append(IndexFileTitle);
+}
+
+std::map<std::filesystem::path, ShipMetadataIndex::Entry> ShipMetadataIndex::Deserialize(DeSerializationBuffer<BigEndianess> const & buffer)
+{
+    std::map<std::filesystem::path, Entry> entries;
+
+    BufferReader reader(buffer);
+
+    // Header
+    if (reader.ReadString() != IndexFileTitle)
+    {
+        throw GameException("Index file is not recognized");
+    }
+
+    if (reader.Read<std::uint32_t>() != IndexFileFormatVersion)
+    {
+        throw GameException("Index file has an unsupported format version");
+    }
+
+    // Entries
+    std::uint32_t const entryCount = reader.Read<std::uint32_t>();
+    for (std::uint32_t e = 0; e < entryCount; ++e)
+    {
+        std::filesystem::path const shipFilename(reader.ReadString());
+        auto const shipFileLastModified = FromPersisted(reader.Read<std::uint64_t>());
+
+        auto const width = static_cast<int>(reader.Read<std::uint32_t>());
+        auto const height = static_cast<int>(reader.Read<std::uint32_t>());
+
+        std::uint8_t const presenceFlags = reader.Read<std::uint8_t>();
+        ShipMetadata metadata(reader.ReadString());
+        if (presenceFlags & HasAuthorFlag)
+            metadata.Author = reader.ReadString();
+        if (presenceFlags & HasArtCreditsFlag)
+            metadata.ArtCredits = reader.ReadString();
+        if (presenceFlags & HasYearBuiltFlag)
+            metadata.YearBuilt = reader.ReadString();
+        if (presenceFlags & HasDescriptionFlag)
+            metadata.Description = reader.ReadString();
+        if (presenceFlags & HasPasswordFlag)
+            metadata.Password = static_cast<PasswordHash>(reader.Read<std::uint64_t>());
+        float const inputUnits = reader.Read<float>();
+        float const outputUnits = reader.Read<float>();
+        metadata.Scale = ShipSpaceToWorldSpaceCoordsRatio(inputUnits, outputUnits);
+        metadata.DoHideElectricalsInPreview = reader.Read<bool>();
+        metadata.DoHideHDInPreview = reader.Read<bool>();
+
+        bool const isHD = reader.Read<bool>();
+        bool const hasElectricals = reader.Read<bool>();
+        PortableTimepoint const lastWriteTime(static_cast<PortableTimepoint::value_type>(reader.Read<std::uint64_t>()));
+        bool const isPreviewFromShipFile = reader.Read<bool>();
+
+        entries.insert_or_assign(
+            shipFilename,
+            Entry(
+                shipFileLastModified,
+                ShipSpaceSize(width, height),
+                metadata,
+                isHD,
+                hasElectricals,
+                lastWriteTime,
+                isPreviewFromShipFile));
+    }
+
+    // Trailer
+    if (reader.ReadString() != IndexFileTitle || !reader.IsAtEnd())
+    {
+        throw GameException("Index file is corrupted");
+    }
+
+    return entries;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+ShipLibraryIndex ShipLibraryIndex::Load(
+    std::vector<std::filesystem::path> const & rootDirectoryPaths,
+    std::shared_ptr<IFileSystem> fileSystem)
+{
+    auto const startTime = std::chrono::steady_clock::now();
+
+    ShipLibraryIndex libraryIndex;
+
+    // Roots may be nested into each other; we visit each directory once
+    std::set<std::filesystem::path> visitedDirectoryPaths;
+
+    for (auto const & rootDirectoryPath : rootDirectoryPaths)
+    {
+        std::deque<std::filesystem::path> directoriesToVisit{ rootDirectoryPath };
+        while (!directoriesToVisit.empty())
+        {
+            auto const directoryPath = directoriesToVisit.front();
+            directoriesToVisit.pop_front();
+
+            if (!visitedDirectoryPaths.insert(directoryPath.lexically_normal()).second)
+            {
+                continue;
+            }
+
+            libraryIndex.Update(ShipMetadataIndex::Load(directoryPath, fileSystem));
+
+            try
+            {
+                auto subDirectoryPaths = fileSystem->ListDirectories(directoryPath);
+                std::sort(subDirectoryPaths.begin(), subDirectoryPaths.end());
+                directoriesToVisit.insert(directoriesToVisit.end(), subDirectoryPaths.begin(), subDirectoryPaths.end());
+            }
+            catch (std::exception const & ex)
+            {
+                LogMessage("ShipLibraryIndex::Load(): error listing \"", directoryPath.string(), "\": ", ex.what());
+            }
+        }
+    }
+
+    auto const endTime = std::chrono::steady_clock::now();
+
+    LogMessage("ShipLibraryIndex::Load(): loaded ", libraryIndex.GetShipCount(), " ships (",
+        std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count(), "us)");
+
+    return libraryIndex;
+}
+
+void ShipLibraryIndex::Update(ShipMetadataIndex const & directoryIndex)
+{
+    auto & directoryShips = mDirectories[directoryIndex.GetDirectoryPath().lexically_normal()];
+
+    auto const & entries = directoryIndex.GetEntries();
+
+    //
+    // Remove ships that are gone, or whose searchable strings have changed
+    //
+
+    for (auto it = directoryShips.begin(); it != directoryShips.end(); )
+    {
+        auto const entryIt = entries.find(it->first);
+        if (entryIt == entries.end()
+            || MakeSearchText(entryIt->first, entryIt->second) != mShips[it->second].SearchText)
+        {
+            RemoveShip(it->second);
+            it = directoryShips.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    //
+    // Add ships that are new, or that we have just removed
+    //
+
+    for (auto const & [shipFilename, entry] : entries)
+    {
+        if (directoryShips.count(shipFilename) == 0)
+        {
+            directoryShips[shipFilename] = AddShip(
+                directoryIndex.GetDirectoryPath() / shipFilename,
+                MakeSearchText(shipFilename, entry));
+        }
+    }
+
+    if (mRemovedShipCount > mShips.size() / 2)
+    {
+        Compact();
+    }
+}
+
+std::vector<std::filesystem::path> ShipLibraryIndex::Search(std::string const & text) const
+{
+    std::vector<std::filesystem::path> results;
+
+    std::string const query = Utils::ToLower(text);
+    if (query.empty())
+    {
+        return results;
+    }
+
+    if (query.size() <= 3)
+    {
+        // The n-gram is the query itself
+
+        auto const it = mNGrams.find(MakeNGramKey(query.data(), query.size()));
+        if (it != mNGrams.end())
+        {
+            for (std::uint32_t const s : it->second)
+            {
+                results.push_back(mShips[s].ShipFilePath);
+            }
+        }
+    }
+    else
+    {
+        // Gather posting lists of all of the query's trigrams, shortest first
+
+        std::vector<std::vector<std::uint32_t> const *> postingLists;
+        for (size_t i = 0; i + 3 <= query.size(); ++i)
+        {
+            auto const it = mNGrams.find(MakeNGramKey(query.data() + i, 3));
+            if (it == mNGrams.end())
+            {
+                // No ship has this trigram
+                return results;
+            }
+
+            postingLists.push_back(&(it->second));
+        }
+
+        std::sort(
+            postingLists.begin(),
+            postingLists.end(),
+            [](auto const * l, auto const * r)
+            {
+                return l->size() < r->size();
+            });
+
+        // Intersect
+        std::vector<std::uint32_t> candidates = *postingLists.front();
+        std::vector<std::uint32_t> intersection;
+        for (size_t l = 1; l < postingLists.size() && !candidates.empty(); ++l)
+        {
+            intersection.clear();
+            std::set_intersection(
+                candidates.cbegin(), candidates.cend(),
+                postingLists[l]->cbegin(), postingLists[l]->cend(),
+                std::back_inserter(intersection));
+
+            candidates.swap(intersection);
+        }
+
+        // Verify candidates, as trigrams do not guarantee the whole query is there
+        for (std::uint32_t const s : candidates)
+        {
+            if (mShips[s].SearchText.find(query) != std::string::npos)
+            {
+                results.push_back(mShips[s].ShipFilePath);
+            }
+        }
+    }
+
+    return results;
+}
+
+ShipLibraryIndex::NGramKey ShipLibraryIndex::MakeNGramKey(char const * str, size_t n)
+{
+    assert(n >= 1 && n <= 3);
+
+    // Length in the lowest byte, characters in the upper ones
+    NGramKey key = static_cast<NGramKey>(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        key |= static_cast<NGramKey>(static_cast<unsigned char>(str[i])) << (8 * (i + 1));
+    }
+
+    return key;
+}
+
+std::string ShipLibraryIndex::MakeSearchText(
+    std::filesystem::path const & shipFilename,
+    ShipMetadataIndex::Entry const & entry)
+{
+    std::string searchText = shipFilename.string();
+    searchText += '\n';
+    searchText += entry.Metadata.ShipName;
+    if (entry.Metadata.Author.has_value())
+    {
+        searchText += '\n';
+        searchText += *entry.Metadata.Author;
+    }
+    if (entry.Metadata.ArtCredits.has_value())
+    {
+        searchText += '\n';
+        searchText += *entry.Metadata.ArtCredits;
+    }
+    if (entry.Metadata.YearBuilt.has_value())
+    {
+        searchText += '\n';
+        searchText += *entry.Metadata.YearBuilt;
+    }
+
+    return Utils::ToLower(searchText);
+}
+
+std::uint32_t ShipLibraryIndex::AddShip(
+    std::filesystem::path const & shipFilePath,
+    std::string && searchText)
+{
+    assert(mShips.size() < std::numeric_limits<std::uint32_t>::max());
+    std::uint32_t const shipIndex = static_cast<std::uint32_t>(mShips.size());
+
+    mShips.emplace_back(shipFilePath, std::move(searchText));
+    IndexShip(shipIndex);
+
+    return shipIndex;
+}
+
+void ShipLibraryIndex::RemoveShip(std::uint32_t shipIndex)
+{
+    std::string const & searchText = mShips[shipIndex].SearchText;
+
+    for (size_t n = 1; n <= 3; ++n)
+    {
+        for (size_t i = 0; i + n <= searchText.size(); ++i)
+        {
+            auto const it = mNGrams.find(MakeNGramKey(searchText.data() + i, n));
+            if (it == mNGrams.end())
+            {
+                // Already removed, as n-gram occurs more than once in this ship
+                continue;
+            }
+
+            auto & postings = it->second;
+            auto const postingIt = std::lower_bound(postings.begin(), postings.end(), shipIndex);
+            if (postingIt != postings.end() && *postingIt == shipIndex)
+            {
+                postings.erase(postingIt);
+                if (postings.empty())
+                {
+                    mNGrams.erase(it);
+                }
+            }
+        }
+    }
+
+    // Leave a hole, so that the indices of the other ships stay valid
+    mShips[shipIndex].ShipFilePath.clear();
+    mShips[shipIndex].SearchText.clear();
+    ++mRemovedShipCount;
+}
+
+void ShipLibraryIndex::IndexShip(std::uint32_t shipIndex)
+{
+    std::string const & searchText = mShips[shipIndex].SearchText;
+
+    for (size_t n = 1; n <= 3; ++n)
+    {
+        for (size_t i = 0; i + n <= searchText.size(); ++i)
+        {
+            auto & postings = mNGrams[MakeNGramKey(searchText.data() + i, n)];
+
+            // Ships are only ever appended, hence postings stay sorted and unique
+            if (postings.empty() || postings.back() != shipIndex)
+            {
+                postings.push_back(shipIndex);
+            }
+        }
+    }
+}
+
+void ShipLibraryIndex::Compact()
+{
+    std::vector<std::uint32_t> newShipIndices(mShips.size(), std::numeric_limits<std::uint32_t>::max());
+
+    std::vector<Ship> ships;
+    ships.reserve(mShips.size() - mRemovedShipCount);
+    for (size_t s = 0; s < mShips.size(); ++s)
+    {
+        if (!mShips[s].ShipFilePath.empty())
+        {
+            newShipIndices[s] = static_cast<std::uint32_t>(ships.size());
+            ships.emplace_back(std::move(mShips[s]));
+        }
+    }
+
+    mShips = std::move(ships);
+    mRemovedShipCount = 0;
+
+    // Remapping preserves order, hence postings stay sorted
+
+    for (auto & directory : mDirectories)
+    {
+        for (auto & ship : directory.second)
+        {
+            ship.second = newShipIndices[ship.second];
+        }
+    }
+
+    for (auto & nGram : mNGrams)
+    {
+        for (auto & shipIndex : nGram.second)
+        {
+            shipIndex = newShipIndices[shipIndex];
+        }
+    }
+}
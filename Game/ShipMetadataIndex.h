@@ -0,0 +1,234 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-02-10
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "ShipMetadata.h"
+#include "ShipPreviewData.h"
+
+#include <GameCore/DeSerializationBuffer.h>
+#include <GameCore/FileSystem.h>
+#include <GameCore/GameTypes.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * A persistent index of the metadata of the ships in a directory, stored next to the
+ * directory's preview image database and kept up-to-date incrementally, based on the
+ * ship files' last-modified times.
+ *
+ * Allows to serve ship preview data - and to search for ships - without opening ship files.
+ */
+class ShipMetadataIndex final
+{
+public:
+
+    struct Entry
+    {
+        std::filesystem::file_time_type ShipFileLastModified;
+        ShipSpaceSize ShipSize;
+        ShipMetadata Metadata;
+        bool IsHD;
+        bool HasElectricals;
+        PortableTimepoint LastWriteTime;
+        bool IsPreviewFromShipFile; // When false, preview data depends on other files and cannot be served from the index
+
+        Entry(
+            std::filesystem::file_time_type shipFileLastModified,
+            ShipSpaceSize const & shipSize,
+            ShipMetadata const & metadata,
+            bool isHD,
+            bool hasElectricals,
+            PortableTimepoint lastWriteTime,
+            bool isPreviewFromShipFile)
+            : ShipFileLastModified(shipFileLastModified)
+            , ShipSize(shipSize)
+            , Metadata(metadata)
+            , IsHD(isHD)
+            , HasElectricals(hasElectricals)
+            , LastWriteTime(lastWriteTime)
+            , IsPreviewFromShipFile(isPreviewFromShipFile)
+        {}
+    };
+
+    static std::filesystem::path GetIndexFilePath(std::filesystem::path const & directoryPath);
+
+    /*
+     * Never throws; in case of errors, the index is simply empty.
+     */
+    static ShipMetadataIndex Load(
+        std::filesystem::path const & directoryPath,
+        std::shared_ptr<IFileSystem> fileSystem);
+
+    ShipMetadataIndex(ShipMetadataIndex && other) = default;
+
+    std::filesystem::path const & GetDirectoryPath() const
+    {
+        return mDirectoryPath;
+    }
+
+    // Key is ship filename
+    std::map<std::filesystem::path, Entry> const & GetEntries() const
+    {
+        return mEntries;
+    }
+
+    /*
+     * Returns the preview data of the specified ship if the index has up-to-date
+     * data for it; in any case, marks the ship as visited.
+     */
+    std::optional<ShipPreviewData> TryGetPreviewData(
+        std::filesystem::path const & shipFilePath,
+        std::filesystem::file_time_type shipFileLastModified);
+
+    /*
+     * Stores the specified preview data for the specified ship, marking the ship as visited.
+     */
+    void Update(
+        std::filesystem::path const & shipFilePath,
+        std::filesystem::file_time_type shipFileLastModified,
+        ShipPreviewData const & shipPreviewData);
+
+    /*
+     * Persists the index if anything has changed. When the visit is completed,
+     * entries for ships that have not been visited are removed.
+     */
+    void Commit(bool isVisitCompleted);
+
+private:
+
+    ShipMetadataIndex(
+        std::filesystem::path const & directoryPath,
+        std::shared_ptr<IFileSystem> && fileSystem,
+        std::map<std::filesystem::path, Entry> && entries)
+        : mDirectoryPath(directoryPath)
+        , mFileSystem(std::move(fileSystem))
+        , mEntries(std::move(entries))
+        , mVisitedShipFilenames()
+        , mIsDirty(false)
+    {}
+
+    static void Serialize(
+        std::map<std::filesystem::path, Entry> const & entries,
+        DeSerializationBuffer<BigEndianess> & buffer);
+
+    static std::map<std::filesystem::path, Entry> Deserialize(DeSerializationBuffer<BigEndianess> const & buffer);
+
+private:
+
+    std::filesystem::path const mDirectoryPath;
+
+    std::shared_ptr<IFileSystem> mFileSystem;
+
+    std::map<std::filesystem::path, Entry> mEntries;
+
+    std::set<std::filesystem::path> mVisitedShipFilenames;
+
+    bool mIsDirty;
+};
+
+/*
+ * Library-wide ship search, built out of the metadata indices of multiple directories,
+ * and thus without opening ship files.
+ *
+ * Lookups are served via an n-gram index (n=1..3) of the lowercase searchable strings
+ * of each ship, i.e. ship name, author, art credits, year built, and filename.
+ *
+ * The index is kept up-to-date incrementally, one directory at a time: only the ships
+ * that have been added, removed, or changed are re-indexed.
+ */
+class ShipLibraryIndex final
+{
+public:
+
+    ShipLibraryIndex()
+        : mShips()
+        , mRemovedShipCount(0)
+        , mDirectories()
+        , mNGrams()
+    {}
+
+    /*
+     * Loads the metadata indices of the specified directories and of all of their sub-directories.
+     */
+    static ShipLibraryIndex Load(
+        std::vector<std::filesystem::path> const & rootDirectoryPaths,
+        std::shared_ptr<IFileSystem> fileSystem);
+
+    static ShipLibraryIndex Load(
+        std::filesystem::path const & rootDirectoryPath,
+        std::shared_ptr<IFileSystem> fileSystem)
+    {
+        return Load(std::vector<std::filesystem::path>({ rootDirectoryPath }), std::move(fileSystem));
+    }
+
+    /*
+     * Brings the ships of the specified index's directory up-to-date with the index,
+     * adding the directory if it's new to the library.
+     */
+    void Update(ShipMetadataIndex const & directoryIndex);
+
+    size_t GetShipCount() const
+    {
+        return mShips.size() - mRemovedShipCount;
+    }
+
+    /*
+     * Returns the paths of the ships with a searchable string containing the specified text
+     * (case-insensitive), in the order in which they were indexed.
+     */
+    std::vector<std::filesystem::path> Search(std::string const & text) const;
+
+private:
+
+    using NGramKey = std::uint32_t;
+
+    static NGramKey MakeNGramKey(char const * str, size_t n);
+
+    static std::string MakeSearchText(
+        std::filesystem::path const & shipFilename,
+        ShipMetadataIndex::Entry const & entry);
+
+    struct Ship
+    {
+        std::filesystem::path ShipFilePath; // Empty when the ship has been removed
+        std::string SearchText; // Lowercase searchable strings, separated by newlines
+
+        Ship(
+            std::filesystem::path const & shipFilePath,
+            std::string && searchText)
+            : ShipFilePath(shipFilePath)
+            , SearchText(std::move(searchText))
+        {}
+    };
+
+    std::uint32_t AddShip(
+        std::filesystem::path const & shipFilePath,
+        std::string && searchText);
+
+    void RemoveShip(std::uint32_t shipIndex);
+
+    void IndexShip(std::uint32_t shipIndex);
+
+    void Compact();
+
+    // Removed ships leave a hole, until we compact
+    std::vector<Ship> mShips;
+    size_t mRemovedShipCount;
+
+    // Directory -> ship filename -> ship index
+    std::map<std::filesystem::path, std::map<std::filesystem::path, std::uint32_t>> mDirectories;
+
+    // N-gram -> sorted indices of ships containing it
+    std::unordered_map<NGramKey, std::vector<std::uint32_t>> mNGrams;
+};
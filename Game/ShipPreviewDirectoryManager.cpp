@@ -29,7 +29,33 @@ std::unique_ptr<ShipPreviewDirectoryManager> ShipPreviewDirectoryManager::Create
         new ShipPreviewDirectoryManager(
             directoryPath,
             fileSystem,
-            PersistedShipPreviewImageDatabase::Load(directoryPath / DatabaseFileName, fileSystem)));
+            PersistedShipPreviewImageDatabase::Load(directoryPath / DatabaseFileName, fileSystem),
+            ShipMetadataIndex::Load(directoryPath, fileSystem)));
+}
+
+ShipPreviewData ShipPreviewDirectoryManager::LoadPreviewData(std::filesystem::path const & shipFilePath)
+{
+    // Get last-modified of ship file
+    // (will throw if the file does not exist)
+    auto const shipFileLastModified = mFileSystem->GetLastModifiedTime(shipFilePath);
+
+    // See if this ship may be served by the index
+    auto indexPreviewData = mMetadataIndex.TryGetPreviewData(shipFilePath, shipFileLastModified);
+    if (indexPreviewData.has_value())
+    {
+        return std::move(*indexPreviewData);
+    }
+
+    // Needs to be loaded from scratch
+    ShipPreviewData previewData = ShipDeSerializer::LoadShipPreviewData(shipFilePath);
+
+    // Add to index
+    mMetadataIndex.Update(
+        shipFilePath,
+        shipFileLastModified,
+        previewData);
+
+    return previewData;
 }
 
 RgbaImageData ShipPreviewDirectoryManager::LoadPreviewImage(
@@ -125,6 +151,9 @@ void ShipPreviewDirectoryManager::Commit(bool isVisitCompleted)
         }
     }
 
+    // Commit metadata index
+    mMetadataIndex.Commit(isVisitCompleted);
+
     auto const endTime = std::chrono::steady_clock::now();
 
     LogMessage("ShipPreviewDirectoryManager::Commit(): ...completed (",
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "ShipDefinition.h"
+#include "ShipMetadataIndex.h"
 #include "ShipPreviewData.h"
 #include "ShipPreviewImageDatabase.h"
 
@@ -28,22 +29,39 @@ public:
         std::filesystem::path const & directoryPath,
         std::shared_ptr<IFileSystem> fileSystem);
 
+    /*
+     * Loads the preview data of the specified ship, serving it from the directory's
+     * metadata index when the ship file has not changed since it was last indexed.
+     */
+    ShipPreviewData LoadPreviewData(std::filesystem::path const & shipFilePath);
+
     RgbaImageData LoadPreviewImage(
         ShipPreviewData const & shipPreview,
         ImageSize const & maxImageSize);
 
     void Commit(bool isVisitCompleted);
 
+    /*
+     * Brings the specified library index up-to-date with this directory's ships,
+     * as of the last commit.
+     */
+    void UpdateLibraryIndex(ShipLibraryIndex & libraryIndex) const
+    {
+        libraryIndex.Update(mMetadataIndex);
+    }
+
 private:
 
     ShipPreviewDirectoryManager(
         std::filesystem::path const & directoryPath,
         std::shared_ptr<IFileSystem> fileSystem,
-        PersistedShipPreviewImageDatabase && oldDatabase)
+        PersistedShipPreviewImageDatabase && oldDatabase,
+        ShipMetadataIndex && metadataIndex)
         : mDirectoryPath(directoryPath)
         , mFileSystem(fileSystem)
         , mOldDatabase(std::move(oldDatabase))
         , mNewDatabase(fileSystem)
+        , mMetadataIndex(std::move(metadataIndex))
     {}
 
 private:
@@ -54,4 +72,6 @@ private:
 
     PersistedShipPreviewImageDatabase mOldDatabase;
     NewShipPreviewImageDatabase mNewDatabase;
+
+    ShipMetadataIndex mMetadataIndex;
 };
\ No newline at end of file
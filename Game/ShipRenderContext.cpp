@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 
 namespace Render {
 
@@ -109,6 +110,8 @@ ShipRenderContext::ShipRenderContext(
     , mSpringElementBuffer()
     , mRopeElementBuffer()
     , mTriangleElementBuffer()
+    , mTriangleElementBufferDirtyStart(std::numeric_limits<size_t>::max())
+    , mTriangleElementBufferDirtyEnd(0)
     , mAreElementBuffersDirty(true)
     , mElementVBO()
     , mElementVBOAllocatedIndexSize(0u)
@@ -754,12 +757,13 @@ void ShipRenderContext::UploadPointMutableAttributesStart()
 
 void ShipRenderContext::UploadPointMutableAttributes(
     vec2f const * position,
+    vec2f const & positionOrigin,
     float const * light,
     float const * water)
 {
     // Uploaded at each cycle
 
-    // Interleave positions into AttributeGroup1 buffer, and
+    // Interleave (world) positions into AttributeGroup1 buffer, and
     // light and water into AttributeGroup2 buffer
     vec2f const * const restrict pSrc1 = position;
     float const * const restrict pSrc2 = light;
@@ -768,8 +772,8 @@ void ShipRenderContext::UploadPointMutableAttributes(
     vec4f * restrict const pDst2 = mPointAttributeGroup2Buffer.get();
     for (size_t i = 0; i < mPointCount; ++i)
     {
-        pDst1[i].x = pSrc1[i].x;
-        pDst1[i].y = pSrc1[i].y;
+        pDst1[i].x = positionOrigin.x + pSrc1[i].x;
+        pDst1[i].y = positionOrigin.y + pSrc1[i].y;
 
         pDst2[i].x = pSrc2[i];
         pDst2[i].y = pSrc3[i];
@@ -930,9 +934,15 @@ void ShipRenderContext::UploadElementTrianglesStart(size_t trianglesCount)
 {
     // Client wants to upload a new set of triangles
     //
-    // No need to clear, we'll repopulate everything
+    // No need to clear, we'll repopulate everything; we keep the current
+    // triangles though, so that we only re-upload the range of those that
+    // change - which is typically small, as triangles come sorted by plane
+    // and most planes are untouched by a change in the structure
 
     mTriangleElementBuffer.resize(trianglesCount);
+
+    if (mTriangleElementBufferDirtyEnd > trianglesCount)
+        mTriangleElementBufferDirtyEnd = trianglesCount;
 }
 
 void ShipRenderContext::UploadElementTrianglesEnd()
@@ -1216,14 +1226,25 @@ void ShipRenderContext::RenderPrepare(RenderParameters const & renderParameters)
             CheckOpenGLError();
 
             mElementVBOAllocatedIndexSize = requiredIndexSize;
+
+            // We have lost all triangles
+            mTriangleElementBufferDirtyStart = 0;
+            mTriangleElementBufferDirtyEnd = mTriangleElementBuffer.size();
         }
 
-        // Upload triangles
-        glBufferSubData(
-            GL_ELEMENT_ARRAY_BUFFER,
-            mTriangleElementVBOStartIndex,
-            mTriangleElementBuffer.size() * sizeof(TriangleElement),
-            mTriangleElementBuffer.data());
+        // Upload triangles - only those that have changed, as
+        // triangles always start at the beginning of the VBO
+        if (mTriangleElementBufferDirtyStart < mTriangleElementBufferDirtyEnd)
+        {
+            glBufferSubData(
+                GL_ELEMENT_ARRAY_BUFFER,
+                mTriangleElementVBOStartIndex + mTriangleElementBufferDirtyStart * sizeof(TriangleElement),
+                (mTriangleElementBufferDirtyEnd - mTriangleElementBufferDirtyStart) * sizeof(TriangleElement),
+                mTriangleElementBuffer.data() + mTriangleElementBufferDirtyStart);
+
+            mTriangleElementBufferDirtyStart = std::numeric_limits<size_t>::max();
+            mTriangleElementBufferDirtyEnd = 0;
+        }
 
         // Upload ropes
         glBufferSubData(
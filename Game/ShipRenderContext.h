@@ -89,8 +89,10 @@ public:
 
     void UploadPointMutableAttributesStart();
 
+    // Positions are relative to the position origin
     void UploadPointMutableAttributes(
         vec2f const * position,
+        vec2f const & positionOrigin,
         float const * light,
         float const * water);
 
@@ -173,9 +175,20 @@ public:
 
         TriangleElement & triangleElement = mTriangleElementBuffer[triangleIndex];
 
-        triangleElement.pointIndex1 = pointIndex1;
-        triangleElement.pointIndex2 = pointIndex2;
-        triangleElement.pointIndex3 = pointIndex3;
+        if (triangleElement.pointIndex1 != pointIndex1
+            || triangleElement.pointIndex2 != pointIndex2
+            || triangleElement.pointIndex3 != pointIndex3)
+        {
+            triangleElement.pointIndex1 = pointIndex1;
+            triangleElement.pointIndex2 = pointIndex2;
+            triangleElement.pointIndex3 = pointIndex3;
+
+            // Extend dirty range
+            if (triangleIndex < mTriangleElementBufferDirtyStart)
+                mTriangleElementBufferDirtyStart = triangleIndex;
+            if (triangleIndex + 1 > mTriangleElementBufferDirtyEnd)
+                mTriangleElementBufferDirtyEnd = triangleIndex + 1;
+        }
     }
 
     void UploadElementTrianglesEnd();
@@ -1678,6 +1691,8 @@ private:
     std::vector<LineElement> mSpringElementBuffer;
     std::vector<LineElement> mRopeElementBuffer;
     std::vector<TriangleElement> mTriangleElementBuffer;
+    size_t mTriangleElementBufferDirtyStart; // Range of triangles changed since last upload
+    size_t mTriangleElementBufferDirtyEnd; // Empty when start >= end
     bool mAreElementBuffersDirty;
     GameOpenGLVBO mElementVBO;
     size_t mElementVBOAllocatedIndexSize;
@@ -7,6 +7,7 @@
 
 #include <GameCore/Log.h>
 
+#include <deque>
 #include <random>
 
 static vec2i const OctantDirections[8] = {
@@ -171,7 +172,7 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
     BatikDistanceMatrix distanceMatrix(
         pointIndexMatrixRegionSize.x,
         pointIndexMatrixRegionSize.y,
-        BatikDistance(0.0f));
+        0.0f);
 
     for (ShipFactoryTriangle const & t : triangleInfos1)
     {
@@ -180,7 +181,7 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
             auto const & coords = pointInfos2[pointIndexRemap.OldToNew(pointIndex1)].DefinitionCoordinates;
             if (coords.has_value())
             {
-                distanceMatrix[vec2i(coords->x + 1, coords->y + 1) - pointIndexMatrixRegionOrigin].Distance = std::numeric_limits<float>::max();
+                distanceMatrix.SetDistance(vec2i(coords->x + 1, coords->y + 1) - pointIndexMatrixRegionOrigin, std::numeric_limits<float>::max());
             }
         }
     }
@@ -193,14 +194,14 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
             auto const & coordsA = pointInfos2[pointAIndex2].DefinitionCoordinates;
             if (coordsA.has_value())
             {
-                distanceMatrix[vec2i(coordsA->x + 1, coordsA->y + 1) - pointIndexMatrixRegionOrigin].Distance = 0.0f;
+                distanceMatrix.SetDistance(vec2i(coordsA->x + 1, coordsA->y + 1) - pointIndexMatrixRegionOrigin, 0.0f);
             }
 
             auto const pointBIndex2 = springInfos2[springIndex2].PointBIndex;
             auto const & coordsB = pointInfos2[pointBIndex2].DefinitionCoordinates;
             if (coordsB.has_value())
             {
-                distanceMatrix[vec2i(coordsB->x + 1, coordsB->y + 1) - pointIndexMatrixRegionOrigin].Distance = 0.0f;
+                distanceMatrix.SetDistance(vec2i(coordsB->x + 1, coordsB->y + 1) - pointIndexMatrixRegionOrigin, 0.0f);
             }
         }
     }
@@ -233,93 +234,19 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
         if (!pointInfos2[startingPointIndex2].DefinitionCoordinates.has_value())
             continue;
 
-        vec2i startingPointCoords =
+        vec2i const startingPointCoords =
             vec2i(pointInfos2[startingPointIndex2].DefinitionCoordinates->x + 1, pointInfos2[startingPointIndex2].DefinitionCoordinates->y + 1)
             - pointIndexMatrixRegionOrigin;
         assert(startingPointCoords.IsInSize(distanceMatrix));
 
-        // Navigate in distance map to find local maximum
-        while (true)
-        {
-            std::optional<vec2i> bestPointCoords;
-            float maxDistance = distanceMatrix[startingPointCoords].Distance;
-            for (int octant = 0; octant < 8; ++octant)
-            {
-                vec2i const candidateCoords = startingPointCoords + OctantDirections[octant];
-                if (candidateCoords.IsInSize(distanceMatrix)
-                    && distanceMatrix[candidateCoords].Distance > maxDistance)
-                {
-                    maxDistance = distanceMatrix[candidateCoords].Distance;
-                    bestPointCoords = candidateCoords;
-                }
-            }
-
-            if (!bestPointCoords.has_value())
-            {
-                // We're done, startingPointCoords is the maximum
-                break;
-            }
-
-            // Advance
-            startingPointCoords = *bestPointCoords;
-        }
-
         //
-        // Find initial direction == direction of steepest descent
+        // Generate crack
         //
 
-        std::optional<Octant> bestNextPointOctant;
-        float maxDelta = std::numeric_limits<float>::lowest();
-        for (Octant octant = 0; octant < 8; ++octant)
-        {
-            vec2i const candidateCoords = startingPointCoords + OctantDirections[octant];
-            if (candidateCoords.IsInSize(distanceMatrix))
-            {
-                float const delta = distanceMatrix[startingPointCoords].Distance - distanceMatrix[candidateCoords].Distance;
-                if (delta >= maxDelta)
-                {
-                    maxDelta = delta;
-                    bestNextPointOctant = octant;
-                }
-            }
-        }
-
-        if (bestNextPointOctant.has_value())
-        {
-            //
-            // Propagate crack along this direction
-            //
-
-            PropagateBatikCrack(
-                startingPointCoords + OctantDirections[*bestNextPointOctant],
-                distanceMatrix,
-                randomEngine);
-
-            //
-            // Find (closest point to) opposite direction
-            //
-
-            auto const oppositeOctant = FindClosestOctant(
-                *bestNextPointOctant + 4,
-                2,
-                [&](Octant candidateOctant)
-                {
-                    vec2i const candidateCoords = startingPointCoords + OctantDirections[candidateOctant];
-                    return candidateCoords.IsInSize(distanceMatrix);
-                });
-
-            if (oppositeOctant.has_value())
-            {
-                PropagateBatikCrack(
-                    startingPointCoords + OctantDirections[*oppositeOctant],
-                    distanceMatrix,
-                    randomEngine);
-            }
-        }
-
-        // Set crack at starting point
-        distanceMatrix[startingPointCoords].Distance = 0.0f;
-        distanceMatrix[startingPointCoords].IsCrack = true;
+        GenerateBatikCrack(
+            startingPointCoords,
+            distanceMatrix,
+            randomEngine);
     }
 
     //
@@ -340,7 +267,7 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
                 pointIndex1.has_value()
                 && !pointInfos2[pointIndexRemap.OldToNew(*pointIndex1)].ConnectedTriangles1.empty())
             {
-                if (distanceMatrix[pointCoords].IsCrack)
+                if (distanceMatrix.IsCrack(pointCoords))
                 {
                     // Weaken
                     float const weakening = pointInfos2[pointIndexRemap.OldToNew(*pointIndex1)].Strength * mRandomizationExtent / 2.0f;
@@ -372,7 +299,7 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
                 pointIndex1.has_value()
                 && !pointInfos2[pointIndexRemap.OldToNew(*pointIndex1)].ConnectedTriangles1.empty())
             {
-                if (!distanceMatrix[pointCoords].IsCrack)
+                if (!distanceMatrix.IsCrack(pointCoords))
                 {
                     // Distribute balancing strengthening
                     pointInfos2[pointIndexRemap.OldToNew(*pointIndex1)].Strength += perParticleWeakeningToDistribute;
@@ -386,6 +313,94 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
         " time=", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count(), "us");
 }
 
+void ShipStrengthRandomizer::GenerateBatikCrack(
+    vec2i startingPointCoords,
+    BatikDistanceMatrix & distanceMatrix,
+    std::ranlux48_base & randomEngine) const
+{
+    // Navigate in distance map to find local maximum
+    while (true)
+    {
+        std::optional<vec2i> bestPointCoords;
+        float maxDistance = distanceMatrix.GetDistance(startingPointCoords);
+        for (int octant = 0; octant < 8; ++octant)
+        {
+            vec2i const candidateCoords = startingPointCoords + OctantDirections[octant];
+            if (candidateCoords.IsInSize(distanceMatrix)
+                && distanceMatrix.GetDistance(candidateCoords) > maxDistance)
+            {
+                maxDistance = distanceMatrix.GetDistance(candidateCoords);
+                bestPointCoords = candidateCoords;
+            }
+        }
+
+        if (!bestPointCoords.has_value())
+        {
+            // We're done, startingPointCoords is the maximum
+            break;
+        }
+
+        // Advance
+        startingPointCoords = *bestPointCoords;
+    }
+
+    //
+    // Find initial direction == direction of steepest descent
+    //
+
+    std::optional<Octant> bestNextPointOctant;
+    float maxDelta = std::numeric_limits<float>::lowest();
+    for (Octant octant = 0; octant < 8; ++octant)
+    {
+        vec2i const candidateCoords = startingPointCoords + OctantDirections[octant];
+        if (candidateCoords.IsInSize(distanceMatrix))
+        {
+            float const delta = distanceMatrix.GetDistance(startingPointCoords) - distanceMatrix.GetDistance(candidateCoords);
+            if (delta >= maxDelta)
+            {
+                maxDelta = delta;
+                bestNextPointOctant = octant;
+            }
+        }
+    }
+
+    if (bestNextPointOctant.has_value())
+    {
+        //
+        // Propagate crack along this direction
+        //
+
+        PropagateBatikCrack(
+            startingPointCoords + OctantDirections[*bestNextPointOctant],
+            distanceMatrix,
+            randomEngine);
+
+        //
+        // Find (closest point to) opposite direction
+        //
+
+        auto const oppositeOctant = FindClosestOctant(
+            *bestNextPointOctant + 4,
+            2,
+            [&](Octant candidateOctant)
+            {
+                vec2i const candidateCoords = startingPointCoords + OctantDirections[candidateOctant];
+                return candidateCoords.IsInSize(distanceMatrix);
+            });
+
+        if (oppositeOctant.has_value())
+        {
+            PropagateBatikCrack(
+                startingPointCoords + OctantDirections[*oppositeOctant],
+                distanceMatrix,
+                randomEngine);
+        }
+    }
+
+    // Set crack at starting point
+    distanceMatrix.SetCrack(startingPointCoords);
+}
+
 template<typename TRandomEngine>
 void ShipStrengthRandomizer::PropagateBatikCrack(
     vec2i const & startingPoint,
@@ -409,7 +424,7 @@ void ShipStrengthRandomizer::PropagateBatikCrack(
         // Check whether we're done
         //
 
-        if (distanceMatrix[p].Distance == 0.0f)
+        if (distanceMatrix.GetDistance(p) == 0.0f)
         {
             // Reached border or another crack, done
             break;
@@ -426,7 +441,7 @@ void ShipStrengthRandomizer::PropagateBatikCrack(
             vec2i const candidateCoords = p + OctantDirections[octant];
             if (candidateCoords.IsInSize(distanceMatrix))
             {
-                float const delta = distanceMatrix[p].Distance - distanceMatrix[candidateCoords].Distance;
+                float const delta = distanceMatrix.GetDistance(p) - distanceMatrix.GetDistance(candidateCoords);
                 if (delta >= maxDelta)
                 {
                     maxDelta = delta;
@@ -467,58 +482,275 @@ void ShipStrengthRandomizer::PropagateBatikCrack(
 
     for (auto const & p : crackPointCoords)
     {
-        distanceMatrix[p].Distance = 0.0f;
-        distanceMatrix[p].IsCrack = true;
+        distanceMatrix.SetCrack(p);
     }
 }
 
 void ShipStrengthRandomizer::UpdateBatikDistances(BatikDistanceMatrix & distanceMatrix) const
 {
     //
-    // Jain's algorithm (1989, Fundamentals of Digital Image Processing, Chapter 2)
+    // Distances only need to be re-propagated from the cells that have changed since
+    // the last update - i.e. new cracks, and cells whose distance changed during the
+    // last update itself (the transform does not necessarily converge in one update).
+    //
+    // All other cells already satisfy the transform's constraints, hence a sweep
+    // restricted to a region enclosing all changed cells (and their neighbors) yields
+    // exactly the same distances as a full sweep - as long as no cell at the region's
+    // border changes, as otherwise the change could continue propagating outside.
+    // When that happens we restore the region, widen it, and try again.
     //
 
-    auto const updateDistanceFromOctant = [&distanceMatrix](vec2i const & idx, Octant const & octant)
+    std::vector<BatikColumnSpan> & dirtySpans = distanceMatrix.GetDirtySpans();
+    if (std::all_of(dirtySpans.cbegin(), dirtySpans.cend(), [](auto const & span) { return span.IsEmpty(); }))
     {
-        vec2i const nidx = idx + OctantDirections[octant];
-        if (nidx.IsInSize(distanceMatrix)
-            && distanceMatrix[nidx].Distance + 1.0f < distanceMatrix[idx].Distance)
+        // Nothing changed since last update
+        return;
+    }
+
+    std::vector<BatikColumnSpan> regionSpans(distanceMatrix.width, BatikColumnSpan::MakeEmpty());
+    std::vector<BatikColumnSpan> changedSpans(distanceMatrix.width, BatikColumnSpan::MakeEmpty());
+    std::vector<size_t> regionBackupOffsets(distanceMatrix.width + 1);
+    std::vector<float> regionBackup;
+
+    for (int margin = 1; ; margin *= 2)
+    {
+        //
+        // Calculate region: hull of dirty spans in [x - margin, x + margin], widened by margin
+        //
+
+        std::deque<int> beginCandidates; // Columns with increasing dirty span begin
+        std::deque<int> endCandidates; // Columns with decreasing dirty span end
+        for (int x = -margin; x < distanceMatrix.width; ++x)
         {
-            distanceMatrix[idx].Distance = distanceMatrix[nidx].Distance + 1.0f;
+            // Enter column x + margin
+            int const xIn = x + margin;
+            if (xIn < distanceMatrix.width && !dirtySpans[xIn].IsEmpty())
+            {
+                while (!beginCandidates.empty() && dirtySpans[beginCandidates.back()].Begin >= dirtySpans[xIn].Begin)
+                    beginCandidates.pop_back();
+                beginCandidates.push_back(xIn);
+
+                while (!endCandidates.empty() && dirtySpans[endCandidates.back()].End <= dirtySpans[xIn].End)
+                    endCandidates.pop_back();
+                endCandidates.push_back(xIn);
+            }
+
+            // Leave column x - margin - 1
+            if (!beginCandidates.empty() && beginCandidates.front() < x - margin)
+                beginCandidates.pop_front();
+            if (!endCandidates.empty() && endCandidates.front() < x - margin)
+                endCandidates.pop_front();
+
+            if (x >= 0)
+            {
+                regionSpans[x] = beginCandidates.empty()
+                    ? BatikColumnSpan::MakeEmpty()
+                    : BatikColumnSpan(
+                        std::max(dirtySpans[beginCandidates.front()].Begin - margin, 0),
+                        std::min(dirtySpans[endCandidates.front()].End + margin, distanceMatrix.height));
+            }
         }
-    };
 
-    // Top-Left -> Bottom-Right
-    for (int x = 0; x < distanceMatrix.width; ++x)
-    {
-        for (int y = distanceMatrix.height - 1; y >= 0; --y)
+        //
+        // Backup region
+        //
+
+        regionBackupOffsets[0] = 0;
+        for (int x = 0; x < distanceMatrix.width; ++x)
         {
-            vec2i const idx(x, y);
+            regionBackupOffsets[x + 1] = regionBackupOffsets[x]
+                + (regionSpans[x].IsEmpty() ? 0 : static_cast<size_t>(regionSpans[x].End - regionSpans[x].Begin));
+        }
 
-            // Upper left half of 8-neighborhood of (x, y)
-            for (Octant t = 4; t <= 7; ++t)
+        regionBackup.resize(regionBackupOffsets[distanceMatrix.width]);
+        for (int x = 0; x < distanceMatrix.width; ++x)
+        {
+            if (!regionSpans[x].IsEmpty())
             {
-                updateDistanceFromOctant(idx, t);
+                float const * const column = distanceMatrix.GetColumn(x);
+                std::copy(
+                    column + regionSpans[x].Begin,
+                    column + regionSpans[x].End,
+                    regionBackup.begin() + regionBackupOffsets[x]);
             }
         }
+
+        //
+        // Transform region
+        //
+
+        RunBatikDistanceTransform(distanceMatrix, regionSpans);
+
+        //
+        // Detect changes, and whether any of them is at the border of the region
+        //
+
+        auto const isInRegion = [&](int x, int y) -> bool
+        {
+            // Cells outside of the matrix count as being in the region, as they never change
+            return x < 0 || x >= distanceMatrix.width || y < 0 || y >= distanceMatrix.height
+                || (y >= regionSpans[x].Begin && y < regionSpans[x].End);
+        };
+
+        bool hasBorderChanged = false;
+        for (int x = 0; x < distanceMatrix.width; ++x)
+        {
+            changedSpans[x] = BatikColumnSpan::MakeEmpty();
+
+            if (!regionSpans[x].IsEmpty())
+            {
+                float const * const column = distanceMatrix.GetColumn(x);
+                float const * const backupColumn = regionBackup.data() + regionBackupOffsets[x] - regionSpans[x].Begin;
+
+                for (int y = regionSpans[x].Begin; y < regionSpans[x].End; ++y)
+                {
+                    if (column[y] != backupColumn[y])
+                    {
+                        changedSpans[x].Begin = std::min(changedSpans[x].Begin, y);
+                        changedSpans[x].End = std::max(changedSpans[x].End, y + 1);
+
+                        if (!hasBorderChanged)
+                        {
+                            for (int octant = 0; octant < 8; ++octant)
+                            {
+                                if (!isInRegion(x + OctantDirections[octant].x, y + OctantDirections[octant].y))
+                                {
+                                    hasBorderChanged = true;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!hasBorderChanged)
+        {
+            // Done; the cells that changed now are the ones to re-visit at the next update
+            dirtySpans.swap(changedSpans);
+            break;
+        }
+
+        //
+        // Restore region and retry with a wider one
+        //
+
+        for (int x = 0; x < distanceMatrix.width; ++x)
+        {
+            if (!regionSpans[x].IsEmpty())
+            {
+                std::copy(
+                    regionBackup.begin() + regionBackupOffsets[x],
+                    regionBackup.begin() + regionBackupOffsets[x + 1],
+                    distanceMatrix.GetColumn(x) + regionSpans[x].Begin);
+            }
+        }
+    }
+}
+
+void ShipStrengthRandomizer::RunBatikDistanceTransform(
+    BatikDistanceMatrix & distanceMatrix,
+    std::vector<BatikColumnSpan> const & regionSpans)
+{
+    //
+    // Jain's algorithm (1989, Fundamentals of Digital Image Processing, Chapter 2)
+    //
+    // Each pass visits cells column-by-column, in the order that defines the resulting
+    // distances; for each column we first take the minimum with the neighbors in the
+    // adjacent columns - which has no dependencies within the column, and vectorizes -
+    // and then propagate along the column itself - which is inherently serial.
+    //
+    // Neighbors outside of the matrix are guards at +INF, which never win the minimum.
+    //
+
+    // Top-Left -> Bottom-Right: upper left half of 8-neighborhood of (x, y)
+    for (int x = 0; x < distanceMatrix.width; ++x)
+    {
+        int const y0 = regionSpans[x].Begin;
+        int const y1 = regionSpans[x].End;
+        if (y0 >= y1)
+            continue;
+
+        float * const column = distanceMatrix.GetColumn(x);
+        float const * const prevColumn = distanceMatrix.GetColumn(x - 1); // Already visited
+        float const * const nextColumn = distanceMatrix.GetColumn(x + 1); // Not yet visited
+
+        // W, NW, NE
+        for (int y = y0; y < y1; ++y)
+        {
+            column[y] = std::min(
+                column[y],
+                std::min(std::min(prevColumn[y], prevColumn[y + 1]), nextColumn[y + 1]) + 1.0f);
+        }
+
+        // N
+        for (int y = y1 - 1; y >= y0; --y)
+        {
+            column[y] = std::min(column[y], column[y + 1] + 1.0f);
+        }
     }
 
-    // Bottom-Right -> Top-Left
+    // Bottom-Right -> Top-Left: lower right half of 8-neighborhood of (x, y)
     for (int x = distanceMatrix.width - 1; x >= 0; --x)
     {
-        for (int y = 0; y < distanceMatrix.height; ++y)
+        int const y0 = regionSpans[x].Begin;
+        int const y1 = regionSpans[x].End;
+        if (y0 >= y1)
+            continue;
+
+        float * const column = distanceMatrix.GetColumn(x);
+        float const * const prevColumn = distanceMatrix.GetColumn(x - 1); // Not yet visited
+        float const * const nextColumn = distanceMatrix.GetColumn(x + 1); // Already visited
+
+        // E, SE, SW
+        for (int y = y0; y < y1; ++y)
         {
-            vec2i const idx(x, y);
+            column[y] = std::min(
+                column[y],
+                std::min(std::min(nextColumn[y], nextColumn[y - 1]), prevColumn[y - 1]) + 1.0f);
+        }
 
-            // Lower right half of 8-neighborhood of (x, y)
-            for (int t = 0; t <= 3; ++t)
-            {
-                updateDistanceFromOctant(idx, t);
-            }
+        // S
+        for (int y = y0; y < y1; ++y)
+        {
+            column[y] = std::min(column[y], column[y - 1] + 1.0f);
         }
     }
 }
 
+ShipStrengthRandomizer::BatikDistanceMatrix::BatikDistanceMatrix(
+    int _width,
+    int _height,
+    float defaultDistance)
+    : width(_width)
+    , height(_height)
+    , mColumnStride(_height + 2)
+    , mDistances(new float[static_cast<size_t>(_width + 2) * (_height + 2)])
+    , mCracks(new bool[static_cast<size_t>(_width) * _height])
+    // Everything is dirty at the beginning
+    , mDirtySpans(_width, BatikColumnSpan(0, _height))
+{
+    // Guards
+    std::fill(
+        mDistances.get(),
+        mDistances.get() + static_cast<size_t>(_width + 2) * (_height + 2),
+        std::numeric_limits<float>::max());
+
+    for (int x = 0; x < width; ++x)
+    {
+        std::fill(
+            GetColumn(x),
+            GetColumn(x) + height,
+            defaultDistance);
+    }
+
+    std::fill(
+        mCracks.get(),
+        mCracks.get() + static_cast<size_t>(_width) * _height,
+        false);
+}
+
 template <typename TAcceptor>
 std::optional<Octant> ShipStrengthRandomizer::FindClosestOctant(
     Octant startOctant,
@@ -11,8 +11,12 @@
 #include <GameCore/Matrix.h>
 #include <GameCore/Vectors.h>
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <random>
 #include <vector>
 
 class ShipStrengthRandomizer
@@ -59,19 +63,108 @@ private:
 
     void RandomizeStrength_Perlin(std::vector<ShipFactoryPoint> & pointInfos2) const;
 
-    struct BatikDistance
+    // A [Begin, End) range of cells in a column of the distance map
+    struct BatikColumnSpan
     {
-        float Distance;
-        bool IsCrack;
+        int Begin;
+        int End;
 
-        BatikDistance(float distance)
-            : Distance(distance)
-            , IsCrack(false)
+        BatikColumnSpan(
+            int begin,
+            int end)
+            : Begin(begin)
+            , End(end)
+        {}
+
+        bool IsEmpty() const
+        {
+            return Begin >= End;
+        }
+
+        static BatikColumnSpan MakeEmpty()
         {
+            return BatikColumnSpan(std::numeric_limits<int>::max(), std::numeric_limits<int>::lowest());
         }
     };
 
-    using BatikDistanceMatrix = Matrix2<BatikDistance>;
+    //
+    // The Batik distance map.
+    //
+    // Distances are stored column-major (i.e. contiguous along y), surrounded by
+    // a one-cell guard border at +INF; this way the distance transform may read
+    // all neighbors unconditionally and run its inner loops over contiguous memory.
+    //
+    // The map also keeps track of the region that has changed since the last
+    // distance update, so that the latter may only re-propagate distances there.
+    //
+
+    class BatikDistanceMatrix
+    {
+    public:
+
+        int const width;
+        int const height;
+
+        BatikDistanceMatrix(
+            int _width,
+            int _height,
+            float defaultDistance);
+
+        float GetDistance(vec2i const & idx) const
+        {
+            assert(idx.IsInSize(*this));
+            return mDistances[(idx.x + 1) * mColumnStride + idx.y + 1];
+        }
+
+        void SetDistance(
+            vec2i const & idx,
+            float distance)
+        {
+            assert(idx.IsInSize(*this));
+            mDistances[(idx.x + 1) * mColumnStride + idx.y + 1] = distance;
+            ExtendDirtyRegion(idx);
+        }
+
+        bool IsCrack(vec2i const & idx) const
+        {
+            assert(idx.IsInSize(*this));
+            return mCracks[idx.x * height + idx.y];
+        }
+
+        void SetCrack(vec2i const & idx)
+        {
+            SetDistance(idx, 0.0f);
+            mCracks[idx.x * height + idx.y] = true;
+        }
+
+        // Valid for x in [-1, width], and indexable with y in [-1, height]
+        float * GetColumn(int x)
+        {
+            assert(x >= -1 && x <= width);
+            return mDistances.get() + (x + 1) * mColumnStride + 1;
+        }
+
+        // Per-column spans of the cells changed since the last distance update
+        std::vector<BatikColumnSpan> & GetDirtySpans()
+        {
+            return mDirtySpans;
+        }
+
+    private:
+
+        void ExtendDirtyRegion(vec2i const & idx)
+        {
+            auto & span = mDirtySpans[idx.x];
+            span.Begin = std::min(span.Begin, idx.y);
+            span.End = std::max(span.End, idx.y + 1);
+        }
+
+        int const mColumnStride;
+        std::unique_ptr<float[]> mDistances;
+        std::unique_ptr<bool[]> mCracks;
+
+        std::vector<BatikColumnSpan> mDirtySpans;
+    };
 
     void RandomizeStrength_Batik(
         ShipFactoryPointIndexMatrix const & pointIndexMatrix,
@@ -83,6 +176,11 @@ private:
         std::vector<ShipFactoryTriangle> const & triangleInfos1,
         std::vector<ShipFactoryFrontier> const & shipFactoryFrontiers) const;
 
+    void GenerateBatikCrack(
+        vec2i startingPointCoords,
+        BatikDistanceMatrix & distanceMatrix,
+        std::ranlux48_base & randomEngine) const;
+
     template<typename TRandomEngine>
     void PropagateBatikCrack(
         vec2i const & startingPoint,
@@ -91,6 +189,10 @@ private:
 
     void UpdateBatikDistances(BatikDistanceMatrix & distanceMatrix) const;
 
+    static void RunBatikDistanceTransform(
+        BatikDistanceMatrix & distanceMatrix,
+        std::vector<BatikColumnSpan> const & regionSpans);
+
     template <typename TAcceptor>
     std::optional<Octant> FindClosestOctant(
         Octant startOctant,
@@ -105,4 +207,8 @@ private:
 
     float mDensityAdjustment;
     float mRandomizationExtent;
+
+private:
+
+    friend class ShipStrengthRandomizerTests_UpdateBatikDistances_MatchesFullSweep_Test;
 };
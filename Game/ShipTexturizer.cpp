@@ -72,6 +72,96 @@ int ShipTexturizer::CalculateHighDefinitionTextureMagnificationFactor(ShipSpaceS
 RgbaImageData ShipTexturizer::MakeAutoTexture(
     StructuralLayerData const & structuralLayer,
     std::optional<ShipAutoTexturizationSettings> const & settings) const
+{
+    return InternalMakeAutoTexture(
+        structuralLayer,
+        settings,
+        nullptr);
+}
+
+RgbaImageData ShipTexturizer::MakeAutoTexture(
+    StructuralLayerData const & structuralLayer,
+    std::optional<ShipAutoTexturizationSettings> const & settings,
+    ThreadPool & threadPool) const
+{
+    return InternalMakeAutoTexture(
+        structuralLayer,
+        settings,
+        &threadPool);
+}
+
+void ShipTexturizer::AutoTexturizeInto(
+    StructuralLayerData const & structuralLayer,
+    ShipSpaceRect const & structuralLayerRegion,
+    RgbaImageData & targetTextureImage,
+    int magnificationFactor,
+    ShipAutoTexturizationSettings const & settings) const
+{
+    InternalAutoTexturizeInto(
+        structuralLayer,
+        structuralLayerRegion,
+        targetTextureImage,
+        magnificationFactor,
+        settings,
+        nullptr);
+}
+
+void ShipTexturizer::AutoTexturizeInto(
+    StructuralLayerData const & structuralLayer,
+    ShipSpaceRect const & structuralLayerRegion,
+    RgbaImageData & targetTextureImage,
+    int magnificationFactor,
+    ShipAutoTexturizationSettings const & settings,
+    ThreadPool & threadPool) const
+{
+    InternalAutoTexturizeInto(
+        structuralLayer,
+        structuralLayerRegion,
+        targetTextureImage,
+        magnificationFactor,
+        settings,
+        &threadPool);
+}
+
+void ShipTexturizer::RenderShipInto(
+    StructuralLayerData const & structuralLayer,
+    ShipSpaceRect const & structuralLayerRegion,
+    RgbaImageData const & sourceTextureImage,
+    RgbaImageData & targetTextureImage,
+    int magnificationFactor) const
+{
+    InternalRenderShipInto(
+        structuralLayer,
+        structuralLayerRegion,
+        sourceTextureImage,
+        targetTextureImage,
+        magnificationFactor,
+        nullptr);
+}
+
+void ShipTexturizer::RenderShipInto(
+    StructuralLayerData const & structuralLayer,
+    ShipSpaceRect const & structuralLayerRegion,
+    RgbaImageData const & sourceTextureImage,
+    RgbaImageData & targetTextureImage,
+    int magnificationFactor,
+    ThreadPool & threadPool) const
+{
+    InternalRenderShipInto(
+        structuralLayer,
+        structuralLayerRegion,
+        sourceTextureImage,
+        targetTextureImage,
+        magnificationFactor,
+        &threadPool);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+
+RgbaImageData ShipTexturizer::InternalMakeAutoTexture(
+    StructuralLayerData const & structuralLayer,
+    std::optional<ShipAutoTexturizationSettings> const & settings,
+    ThreadPool * threadPool) const
 {
     auto const startTime = std::chrono::steady_clock::now();
 
@@ -94,26 +184,59 @@ RgbaImageData ShipTexturizer::MakeAutoTexture(
         : *settings;
 
     // Texturize
-    AutoTexturizeInto(
+    InternalAutoTexturizeInto(
         structuralLayer,
         ShipSpaceRect({ 0, 0 }, shipSize), // Whole quad
         texture,
         magnificationFactor,
-        actualSettings);
+        actualSettings,
+        threadPool);
 
     LogMessage("ShipTexturizer: completed auto-texturization:",
         " shipSize=", shipSize, " textureSize=", textureSize,
+        " parallelism=", (threadPool != nullptr ? threadPool->GetParallelism() : 1),
         " time=", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count(), "us");
 
     return texture;
 }
 
-void ShipTexturizer::AutoTexturizeInto(
+void ShipTexturizer::InternalAutoTexturizeInto(
     StructuralLayerData const & structuralLayer,
     ShipSpaceRect const & structuralLayerRegion,
     RgbaImageData & targetTextureImage,
     int magnificationFactor,
-    ShipAutoTexturizationSettings const & settings) const
+    ShipAutoTexturizationSettings const & settings,
+    ThreadPool * threadPool) const
+{
+    // Resolve all the material textures we need now, while we're still
+    // single-threaded; from now on the cache is not touched
+    MaterialTextureMap const materialTextures = (settings.Mode == ShipAutoTexturizationModeType::MaterialTextures)
+        ? ResolveMaterialTextures(structuralLayer, structuralLayerRegion)
+        : MaterialTextureMap();
+
+    RunInBands(
+        structuralLayerRegion,
+        magnificationFactor,
+        threadPool,
+        [&](ShipSpaceRect const & band)
+        {
+            AutoTexturizeBandInto(
+                structuralLayer,
+                band,
+                targetTextureImage,
+                magnificationFactor,
+                settings,
+                materialTextures);
+        });
+}
+
+void ShipTexturizer::AutoTexturizeBandInto(
+    StructuralLayerData const & structuralLayer,
+    ShipSpaceRect const & structuralLayerRegion,
+    RgbaImageData & targetTextureImage,
+    int magnificationFactor,
+    ShipAutoTexturizationSettings const & settings,
+    MaterialTextureMap const & materialTextures) const
 {
     //
     // Prepare constants
@@ -156,6 +279,10 @@ void ShipTexturizer::AutoTexturizeInto(
     int const startX = structuralLayerRegion.origin.x;
     int const endX = structuralLayerRegion.origin.x + structuralLayerRegion.size.width;
 
+    // Materials come in runs, hence we remember the last texture we've looked up
+    StructuralMaterial const * lastStructuralMaterial = nullptr;
+    Vec2fImageData const * lastMaterialTexture = nullptr;
+
     for (int y = startY; y < endY; ++y)
     {
         for (int x = startX; x < endX; ++x)
@@ -200,7 +327,16 @@ void ShipTexturizer::AutoTexturizeInto(
 
                 // Get bump map texture
                 assert(structuralMaterial != nullptr);
-                Vec2fImageData const & materialTexture = GetMaterialTexture(structuralMaterial->MaterialTextureName);
+                if (structuralMaterial != lastStructuralMaterial)
+                {
+                    auto const it = materialTextures.find(structuralMaterial);
+                    assert(it != materialTextures.end());
+
+                    lastStructuralMaterial = structuralMaterial;
+                    lastMaterialTexture = it->second;
+                }
+
+                Vec2fImageData const & materialTexture = *lastMaterialTexture;
 
                 //
                 // Prepare bilinear interpolation along X
@@ -322,7 +458,31 @@ void ShipTexturizer::AutoTexturizeInto(
     }
 }
 
-void ShipTexturizer::RenderShipInto(
+void ShipTexturizer::InternalRenderShipInto(
+    StructuralLayerData const & structuralLayer,
+    ShipSpaceRect const & structuralLayerRegion,
+    RgbaImageData const & sourceTextureImage,
+    RgbaImageData & targetTextureImage,
+    int magnificationFactor,
+    ThreadPool * threadPool) const
+{
+    // Each band only writes the target rows of its own quads, hence bands are independent
+    RunInBands(
+        structuralLayerRegion,
+        magnificationFactor,
+        threadPool,
+        [&](ShipSpaceRect const & band)
+        {
+            RenderShipBandInto(
+                structuralLayer,
+                band,
+                sourceTextureImage,
+                targetTextureImage,
+                magnificationFactor);
+        });
+}
+
+void ShipTexturizer::RenderShipBandInto(
     StructuralLayerData const & structuralLayer,
     ShipSpaceRect const & structuralLayerRegion,
     RgbaImageData const & sourceTextureImage,
@@ -540,6 +700,141 @@ void ShipTexturizer::RenderShipInto(
     }
 }
 
+template<typename TBandWorker>
+void ShipTexturizer::RunInBands(
+    ShipSpaceRect const & structuralLayerRegion,
+    int magnificationFactor,
+    ThreadPool * threadPool,
+    TBandWorker && bandWorker)
+{
+    // Below this many target pixels a band is not worth the synchronization with the pool
+    size_t constexpr MinTargetPixelsPerBand = 64 * 1024;
+
+    // Bands per thread: rows differ wildly in cost (hull vs. empty space), hence we
+    // give threads a few of them each to even out the load
+    size_t constexpr BandsPerThread = 4;
+
+    size_t const regionHeight = static_cast<size_t>(std::max(structuralLayerRegion.size.height, 0));
+    size_t const targetPixelsPerRow =
+        static_cast<size_t>(std::max(structuralLayerRegion.size.width, 0))
+        * static_cast<size_t>(magnificationFactor)
+        * static_cast<size_t>(magnificationFactor);
+
+    size_t bandCount = 1;
+    if (threadPool != nullptr)
+    {
+        bandCount = std::max(
+            std::min({
+                threadPool->GetParallelism() * BandsPerThread,
+                regionHeight,
+                regionHeight * targetPixelsPerRow / MinTargetPixelsPerBand }),
+            size_t(1));
+    }
+
+    if (bandCount == 1)
+    {
+        bandWorker(structuralLayerRegion);
+        return;
+    }
+
+    std::vector<ThreadPool::Task> tasks;
+    tasks.reserve(bandCount);
+
+    for (size_t b = 0; b < bandCount; ++b)
+    {
+        int const bandStartY = structuralLayerRegion.origin.y + static_cast<int>(regionHeight * b / bandCount);
+        int const bandEndY = structuralLayerRegion.origin.y + static_cast<int>(regionHeight * (b + 1) / bandCount);
+
+        ShipSpaceRect const band(
+            ShipSpaceCoordinates(structuralLayerRegion.origin.x, bandStartY),
+            ShipSpaceSize(structuralLayerRegion.size.width, bandEndY - bandStartY));
+
+        tasks.emplace_back(
+            [&bandWorker, band]()
+            {
+                bandWorker(band);
+            });
+    }
+
+    threadPool->Run(tasks);
+}
+
+ShipTexturizer::MaterialTextureMap ShipTexturizer::ResolveMaterialTextures(
+    StructuralLayerData const & structuralLayer,
+    ShipSpaceRect const & structuralLayerRegion) const
+{
+    //
+    // Collect the materials - and their textures - used by the region
+    //
+
+    MaterialTextureMap materialTextures;
+    std::unordered_set<std::string> textureNames;
+
+    auto const & structuralBuffer = structuralLayer.Buffer;
+
+    StructuralMaterial const * lastStructuralMaterial = nullptr;
+
+    for (int y = structuralLayerRegion.origin.y; y < structuralLayerRegion.origin.y + structuralLayerRegion.size.height; ++y)
+    {
+        for (int x = structuralLayerRegion.origin.x; x < structuralLayerRegion.origin.x + structuralLayerRegion.size.width; ++x)
+        {
+            StructuralMaterial const * const structuralMaterial = structuralBuffer[{x, y}].Material;
+            if (structuralMaterial != nullptr
+                && structuralMaterial != lastStructuralMaterial
+                && materialTextures.count(structuralMaterial) == 0)
+            {
+                materialTextures.emplace(structuralMaterial, nullptr);
+                textureNames.insert(structuralMaterial->MaterialTextureName.value_or(MaterialTextureNameNone));
+            }
+
+            lastStructuralMaterial = structuralMaterial;
+        }
+    }
+
+    //
+    // Make room for the textures we miss, without evicting those we need
+    //
+
+    size_t const missingTextureCount = std::count_if(
+        textureNames.cbegin(),
+        textureNames.cend(),
+        [this](std::string const & textureName)
+        {
+            return mMaterialTextureCache.count(textureName) == 0;
+        });
+
+    if (missingTextureCount > 0
+        && mMaterialTextureCache.size() + missingTextureCount >= MaterialTextureCacheSizeHighWatermark)
+    {
+        PurgeMaterialTextureCache(MaterialTextureCacheSizeLowWatermark, textureNames);
+    }
+
+    //
+    // Load missing textures and resolve materials
+    //
+    // Note: we do not purge while loading, as references to cached textures are
+    // stable only as long as they are not evicted
+    //
+
+    for (auto & entry : materialTextures)
+    {
+        std::string const textureName = entry.first->MaterialTextureName.value_or(MaterialTextureNameNone);
+
+        auto it = mMaterialTextureCache.find(textureName);
+        if (it == mMaterialTextureCache.end())
+        {
+            it = mMaterialTextureCache.emplace(
+                textureName,
+                LoadMaterialTexture(textureName)).first;
+        }
+
+        ++(it->second.UseCount);
+        entry.second = &(it->second.Texture);
+    }
+
+    return materialTextures;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 
 std::unordered_map<std::string, std::filesystem::path> ShipTexturizer::MakeMaterialTextureNameToTextureFilePathMap(
@@ -683,27 +978,10 @@ ShipTexturizer::Vec2fImageData const & ShipTexturizer::GetMaterialTexture(std::o
             PurgeMaterialTextureCache(MaterialTextureCacheSizeLowWatermark);
         }
 
-        // Load texture
-        assert(mMaterialTextureNameToTextureFilePathMap.count(actualTextureName) > 0);
-        RgbImageData texture = ImageFileTools::LoadImageRgb(mMaterialTextureNameToTextureFilePathMap.at(actualTextureName));
-
-        // Convert to vec2f
-        auto const pixelCount = texture.Size.GetLinearSize();
-        std::unique_ptr<vec2f[]> vec2fTexture = std::make_unique<vec2f[]>(pixelCount);
-        for (size_t p = 0; p < pixelCount; ++p)
-        {
-            assert(texture.Data[p].r == texture.Data[p].g);
-            assert(texture.Data[p].r == texture.Data[p].b);
-
-            vec2fTexture[p] = vec2f(
-                static_cast<float>(texture.Data[p].r) / 255.0f,
-                1.0f); // Alpha: at this moment we hardcode it as opaque, we'll think whether we want to make transparent chains
-        }
-
-        // Insert texture into cache
+        // Load texture and insert it into cache
         auto const inserted = mMaterialTextureCache.emplace(
             actualTextureName,
-            Vec2fImageData(texture.Size, std::move(vec2fTexture)));
+            LoadMaterialTexture(actualTextureName));
 
         assert(inserted.second);
 
@@ -711,6 +989,28 @@ ShipTexturizer::Vec2fImageData const & ShipTexturizer::GetMaterialTexture(std::o
     }
 }
 
+ShipTexturizer::Vec2fImageData ShipTexturizer::LoadMaterialTexture(std::string const & textureName) const
+{
+    // Load texture
+    assert(mMaterialTextureNameToTextureFilePathMap.count(textureName) > 0);
+    RgbImageData texture = ImageFileTools::LoadImageRgb(mMaterialTextureNameToTextureFilePathMap.at(textureName));
+
+    // Convert to vec2f
+    auto const pixelCount = texture.Size.GetLinearSize();
+    std::unique_ptr<vec2f[]> vec2fTexture = std::make_unique<vec2f[]>(pixelCount);
+    for (size_t p = 0; p < pixelCount; ++p)
+    {
+        assert(texture.Data[p].r == texture.Data[p].g);
+        assert(texture.Data[p].r == texture.Data[p].b);
+
+        vec2fTexture[p] = vec2f(
+            static_cast<float>(texture.Data[p].r) / 255.0f,
+            1.0f); // Alpha: at this moment we hardcode it as opaque, we'll think whether we want to make transparent chains
+    }
+
+    return Vec2fImageData(texture.Size, std::move(vec2fTexture));
+}
+
 void ShipTexturizer::ResetMaterialTextureCacheUseCounts() const
 {
     std::for_each(
@@ -722,20 +1022,21 @@ void ShipTexturizer::ResetMaterialTextureCacheUseCounts() const
         });
 }
 
-void ShipTexturizer::PurgeMaterialTextureCache(size_t maxSize) const
+void ShipTexturizer::PurgeMaterialTextureCache(
+    size_t maxSize,
+    std::unordered_set<std::string> const & texturesToKeep) const
 {
     LogMessage("ShipTexturizer: purging ", maxSize, " material texture cache elements");
 
-    // Create vector with keys and usage counts
+    // Create vector with keys and usage counts of candidates
     std::vector<std::pair<std::string, size_t>> keyUsages;
-    std::transform(
-        mMaterialTextureCache.cbegin(),
-        mMaterialTextureCache.cend(),
-        std::back_inserter(keyUsages),
-        [](auto const & it) ->std::pair<std::string, size_t>
+    for (auto const & it : mMaterialTextureCache)
+    {
+        if (texturesToKeep.count(it.first) == 0)
         {
-            return std::make_pair(it.first, it.second.UseCount);
-        });
+            keyUsages.emplace_back(it.first, it.second.UseCount);
+        }
+    }
 
     // Sorty by usage count, ascending
     std::sort(
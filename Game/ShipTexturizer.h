@@ -12,12 +12,15 @@
 
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
+#include <GameCore/ThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <cassert>
 #include <filesystem>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 class ShipTexturizer
 {
@@ -33,6 +36,17 @@ public:
         StructuralLayerData const & structuralLayer,
         std::optional<ShipAutoTexturizationSettings> const & settings) const;
 
+    /*
+     * Same as above, but spreads the work across the specified thread pool.
+     *
+     * Not re-entrant: a texturizer may only be used by one thread at a time,
+     * which is also the only thread that may be running the pool.
+     */
+    RgbaImageData MakeAutoTexture(
+        StructuralLayerData const & structuralLayer,
+        std::optional<ShipAutoTexturizationSettings> const & settings,
+        ThreadPool & threadPool) const;
+
     void AutoTexturizeInto(
         StructuralLayerData const & structuralLayer,
         ShipSpaceRect const & structuralLayerRegion,
@@ -40,6 +54,14 @@ public:
         int magnificationFactor,
         ShipAutoTexturizationSettings const & settings) const;
 
+    void AutoTexturizeInto(
+        StructuralLayerData const & structuralLayer,
+        ShipSpaceRect const & structuralLayerRegion,
+        RgbaImageData & targetTextureImage,
+        int magnificationFactor,
+        ShipAutoTexturizationSettings const & settings,
+        ThreadPool & threadPool) const;
+
     void RenderShipInto(
         StructuralLayerData const & structuralLayer,
         ShipSpaceRect const & structuralLayerRegion,
@@ -47,6 +69,14 @@ public:
         RgbaImageData & targetTextureImage,
         int magnificationFactor) const;
 
+    void RenderShipInto(
+        StructuralLayerData const & structuralLayer,
+        ShipSpaceRect const & structuralLayerRegion,
+        RgbaImageData const & sourceTextureImage,
+        RgbaImageData & targetTextureImage,
+        int magnificationFactor,
+        ThreadPool & threadPool) const;
+
     template<typename TMaterial>
     RgbaImageData MakeTextureSample(
         std::optional<ShipAutoTexturizationSettings> const & settings,
@@ -93,8 +123,61 @@ private:
 
     using Vec2fImageData = ImageData<vec2f>;
 
+    // The material textures used by a region, resolved upfront so that the region
+    // may then be texturized concurrently without touching the cache
+    using MaterialTextureMap = std::unordered_map<StructuralMaterial const *, Vec2fImageData const *>;
+
 private:
 
+    RgbaImageData InternalMakeAutoTexture(
+        StructuralLayerData const & structuralLayer,
+        std::optional<ShipAutoTexturizationSettings> const & settings,
+        ThreadPool * threadPool) const;
+
+    void InternalAutoTexturizeInto(
+        StructuralLayerData const & structuralLayer,
+        ShipSpaceRect const & structuralLayerRegion,
+        RgbaImageData & targetTextureImage,
+        int magnificationFactor,
+        ShipAutoTexturizationSettings const & settings,
+        ThreadPool * threadPool) const;
+
+    void AutoTexturizeBandInto(
+        StructuralLayerData const & structuralLayer,
+        ShipSpaceRect const & structuralLayerRegion,
+        RgbaImageData & targetTextureImage,
+        int magnificationFactor,
+        ShipAutoTexturizationSettings const & settings,
+        MaterialTextureMap const & materialTextures) const;
+
+    void InternalRenderShipInto(
+        StructuralLayerData const & structuralLayer,
+        ShipSpaceRect const & structuralLayerRegion,
+        RgbaImageData const & sourceTextureImage,
+        RgbaImageData & targetTextureImage,
+        int magnificationFactor,
+        ThreadPool * threadPool) const;
+
+    void RenderShipBandInto(
+        StructuralLayerData const & structuralLayer,
+        ShipSpaceRect const & structuralLayerRegion,
+        RgbaImageData const & sourceTextureImage,
+        RgbaImageData & targetTextureImage,
+        int magnificationFactor) const;
+
+    // Runs the specified band worker over horizontal bands of the region - on the pool if
+    // there is one and if the region is large enough to be worth it, inline otherwise
+    template<typename TBandWorker>
+    static void RunInBands(
+        ShipSpaceRect const & structuralLayerRegion,
+        int magnificationFactor,
+        ThreadPool * threadPool,
+        TBandWorker && bandWorker);
+
+    MaterialTextureMap ResolveMaterialTextures(
+        StructuralLayerData const & structuralLayer,
+        ShipSpaceRect const & structuralLayerRegion) const;
+
     static std::unordered_map<std::string, std::filesystem::path> MakeMaterialTextureNameToTextureFilePathMap(
         MaterialDatabase const & materialDatabase,
         ResourceLocator const & resourceLocator);
@@ -109,9 +192,13 @@ private:
 
     inline Vec2fImageData const & GetMaterialTexture(std::optional<std::string> const & textureName) const;
 
+    Vec2fImageData LoadMaterialTexture(std::string const & textureName) const;
+
     void ResetMaterialTextureCacheUseCounts() const;
 
-    void PurgeMaterialTextureCache(size_t maxSize) const;
+    void PurgeMaterialTextureCache(
+        size_t maxSize,
+        std::unordered_set<std::string> const & texturesToKeep = {}) const;
 
     inline rgbaColor SampleTextureBilinearConstrained(
         RgbaImageData const & texture,
@@ -5,85 +5,417 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/AABB.h>
+#include <GameCore/FloatVec.h>
 #include <GameCore/GameMath.h>
+#include <GameCore/GameRandomEngine.h>
+#include <GameCore/SysSpecifics.h>
 
 #include <algorithm>
+#include <cassert>
 
 namespace Physics {
 
-void Ship::ApplyRadialSpaceWarpForceField(
+void Ship::AddRadialSpaceWarpForceField(
     vec2f const & centerPosition,
     float radius,
     float radiusThickness,
     float strength)
 {
-    for (auto pointIndex : mPoints)
+    mForceFields.emplace_back(
+        ForceField::ForceFieldType::RadialSpaceWarp,
+        centerPosition,
+        strength,
+        radius,
+        radiusThickness,
+        0.0f,
+        false);
+}
+
+void Ship::AddImplosionForceField(
+    vec2f const & centerPosition,
+    float strength)
+{
+    mForceFields.emplace_back(
+        ForceField::ForceFieldType::Implosion,
+        centerPosition,
+        strength,
+        0.0f,
+        0.0f,
+        0.0f,
+        false);
+}
+
+void Ship::AddRadialExplosionForceField(
+    vec2f const & centerPosition,
+    float strength)
+{
+    mForceFields.emplace_back(
+        ForceField::ForceFieldType::RadialExplosion,
+        centerPosition,
+        strength,
+        0.0f,
+        0.0f,
+        0.0f,
+        false);
+}
+
+void Ship::AddBlastForceField(
+    vec2f const & centerPosition,
+    float radius,
+    float strength,
+    float heat,
+    bool doDetachClosestPoint)
+{
+    mForceFields.emplace_back(
+        ForceField::ForceFieldType::Blast,
+        centerPosition,
+        strength,
+        radius,
+        0.0f,
+        heat,
+        doDetachClosestPoint);
+}
+
+void Ship::ApplyForceFields(
+    float currentSimulationTime,
+    GameParameters const & gameParameters)
+{
+    if (mForceFields.empty())
+    {
+        return;
+    }
+
+    //
+    // We visit the points in blocks small enough to stay in cache, applying
+    // to each block all and only the fields that may reach it
+    //
+
+    ElementCount constexpr PointBlockSize = 1024;
+
+    // The kernels work on relative positions
+    vec2f const positionOrigin = mPoints.GetPositionOrigin();
+    for (auto & forceField : mForceFields)
+    {
+        forceField.CenterPosition -= positionOrigin;
+    }
+
+    bool const hasBoundedFields = std::any_of(
+        mForceFields.cbegin(),
+        mForceFields.cend(),
+        [](ForceField const & forceField)
+        {
+            return forceField.GetMaxRadius() != std::numeric_limits<float>::max();
+        });
+
+    vec2f const * const positionBuffer = mPoints.GetPositionBufferAsVec2();
+
+    // Blocks are whole vectorization words, as both the aligned ship points and
+    // the ephemeral points are
+    static_assert((PointBlockSize % vectorization_float_count<ElementCount>) == 0);
+    ElementCount const pointCount = mPoints.GetElementCount();
+    assert((pointCount % vectorization_float_count<ElementCount>) == 0);
+    for (ElementIndex blockStart = 0; blockStart < pointCount; blockStart += PointBlockSize)
     {
-        vec2f const pointRadius = mPoints.GetPosition(pointIndex) - centerPosition;
-        float const pointDistanceFromRadius = pointRadius.length() - radius;
-        float const absolutePointDistanceFromRadius = std::abs(pointDistanceFromRadius);
-        if (absolutePointDistanceFromRadius <= radiusThickness)
+        ElementIndex const blockEnd = std::min(blockStart + PointBlockSize, pointCount);
+
+        Geometry::AABB blockAABB;
+        if (hasBoundedFields)
+        {
+            for (ElementIndex p = blockStart; p < blockEnd; ++p)
+            {
+                blockAABB.ExtendTo(positionBuffer[p]);
+            }
+        }
+
+        for (auto & forceField : mForceFields)
         {
-            float const forceDirection = pointDistanceFromRadius >= 0.0f ? 1.0f : -1.0f;
+            float const maxRadius = forceField.GetMaxRadius();
+            if (maxRadius != std::numeric_limits<float>::max()
+                && !blockAABB.Contains(forceField.CenterPosition, maxRadius))
+            {
+                // Out of reach
+                continue;
+            }
+
+            switch (forceField.Type)
+            {
+                case ForceField::ForceFieldType::RadialSpaceWarp:
+                {
+                    ApplyRadialSpaceWarpForceField(forceField, blockStart, blockEnd);
+                    break;
+                }
+
+                case ForceField::ForceFieldType::Implosion:
+                {
+                    ApplyImplosionForceField(forceField, blockStart, blockEnd);
+                    break;
+                }
 
-            float const forceStrength = strength * (1.0f - absolutePointDistanceFromRadius / radiusThickness);
+                case ForceField::ForceFieldType::RadialExplosion:
+                {
+                    ApplyRadialExplosionForceField(forceField, blockStart, blockEnd);
+                    break;
+                }
 
-            mPoints.AddStaticForce(
-                pointIndex,
-                pointRadius.normalise() * forceStrength * forceDirection);
+                case ForceField::ForceFieldType::Blast:
+                {
+                    ApplyBlastForceField(forceField, blockStart, blockEnd);
+                    break;
+                }
+            }
         }
     }
+
+    //
+    // Detach the closest points, now that all fields have been applied
+    //
+
+    for (auto const & forceField : mForceFields)
+    {
+        if (forceField.DoDetachClosestPoint
+            && NoneElementIndex != forceField.ClosestPointIndex)
+        {
+            // Choose a detach velocity - using the same distribution as Debris
+            vec2f const detachVelocity = GameRandomEngine::GetInstance().GenerateUniformRadialVector(
+                GameParameters::MinDebrisParticlesVelocity,
+                GameParameters::MaxDebrisParticlesVelocity);
+
+            // Detach point
+            mPoints.Detach(
+                forceField.ClosestPointIndex,
+                detachVelocity,
+                Points::DetachOptions::GenerateDebris
+                | Points::DetachOptions::FireDestroyEvent,
+                currentSimulationTime,
+                gameParameters);
+        }
+    }
+
+    mForceFields.clear();
+}
+
+void Ship::ApplyRadialSpaceWarpForceField(
+    ForceField const & forceField,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+    using fvec = float_vec<vectorization_float_count<size_t>>; // Point ranges are only aligned to the vectorization word
+
+    assert((startPointIndex % fvec::width) == 0 && (endPointIndex % fvec::width) == 0);
+
+    float const * restrict const positionBuffer = mPoints.GetPositionBufferAsFloat();
+    float * restrict const staticForceBuffer = mPoints.GetStaticForceBufferAsFloat();
+
+    fvec const zero_N = fvec::zero();
+    fvec const one_N = fvec::splat(1.0f);
+    fvec const two_N = fvec::splat(2.0f);
+    fvec const centerX_N = fvec::splat(forceField.CenterPosition.x);
+    fvec const centerY_N = fvec::splat(forceField.CenterPosition.y);
+    fvec const radius_N = fvec::splat(forceField.Radius);
+    fvec const radiusThickness_N = fvec::splat(forceField.RadiusThickness);
+    fvec const strength_N = fvec::splat(forceField.Strength);
+
+    for (size_t p = startPointIndex; p < endPointIndex; p += fvec::width)
+    {
+        fvec positionX_N, positionY_N;
+        fvec::load_xy(positionBuffer + p * 2, positionX_N, positionY_N);
+
+        fvec const pointRadiusX_N = positionX_N - centerX_N;
+        fvec const pointRadiusY_N = positionY_N - centerY_N;
+        fvec const pointRadiusLength_N = sqrt(pointRadiusX_N * pointRadiusX_N + pointRadiusY_N * pointRadiusY_N);
+
+        fvec const pointDistanceFromRadius_N = pointRadiusLength_N - radius_N;
+        fvec const absolutePointDistanceFromRadius_N = max(pointDistanceFromRadius_N, zero_N - pointDistanceFromRadius_N);
+
+        // +1 outside of the radius, -1 inside
+        fvec const forceDirection_N = (le_mask(zero_N, pointDistanceFromRadius_N) & two_N) - one_N;
+
+        fvec const forceStrength_N = strength_N * (one_N - absolutePointDistanceFromRadius_N / radiusThickness_N);
+
+        // Zero for points that are out of the thickness, or at the center
+        fvec const forceCoefficient_N =
+            (forceStrength_N * forceDirection_N / pointRadiusLength_N)
+            & le_mask(absolutePointDistanceFromRadius_N, radiusThickness_N)
+            & neq_mask(pointRadiusLength_N, zero_N);
+
+        fvec staticForceX_N, staticForceY_N;
+        fvec::load_xy(staticForceBuffer + p * 2, staticForceX_N, staticForceY_N);
+
+        fvec::store_xy(
+            staticForceX_N + pointRadiusX_N * forceCoefficient_N,
+            staticForceY_N + pointRadiusY_N * forceCoefficient_N,
+            staticForceBuffer + p * 2);
+    }
 }
 
 void Ship::ApplyImplosionForceField(
-    vec2f const & centerPosition,
-    float strength)
+    ForceField const & forceField,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
 {
-    for (auto pointIndex : mPoints)
+    using fvec = float_vec<vectorization_float_count<size_t>>;
+
+    assert((startPointIndex % fvec::width) == 0 && (endPointIndex % fvec::width) == 0);
+
+    float const * restrict const positionBuffer = mPoints.GetPositionBufferAsFloat();
+    float const * restrict const massBuffer = mPoints.GetMassBufferAsFloat();
+    float * restrict const staticForceBuffer = mPoints.GetStaticForceBufferAsFloat();
+
+    fvec const zero_N = fvec::zero();
+    fvec const centerX_N = fvec::splat(forceField.CenterPosition.x);
+    fvec const centerY_N = fvec::splat(forceField.CenterPosition.y);
+
+    // Make final acceleration somewhat independent from mass (mass / 50)
+    fvec const angularStrength_N = fvec::splat(forceField.Strength / 50.0f / 10.0f); // Magic number
+    fvec const radialStrength_N = fvec::splat(forceField.Strength / 50.0f * 10.0f); // Magic number
+
+    fvec const radialOffset_N = fvec::splat(0.2f);
+    fvec const radialFactor_N = fvec::splat(0.5f);
+
+    for (size_t p = startPointIndex; p < endPointIndex; p += fvec::width)
     {
-        vec2f displacement = (centerPosition - mPoints.GetPosition(pointIndex));
-        float const displacementLength = displacement.length();
-        vec2f normalizedDisplacement = displacement.normalise(displacementLength);
+        fvec positionX_N, positionY_N;
+        fvec::load_xy(positionBuffer + p * 2, positionX_N, positionY_N);
+
+        fvec const displacementX_N = centerX_N - positionX_N;
+        fvec const displacementY_N = centerY_N - positionY_N;
+        fvec const displacementLength_N = sqrt(displacementX_N * displacementX_N + displacementY_N * displacementY_N);
 
-        // Make final acceleration somewhat independent from mass
-        float const massNormalization = mPoints.GetMass(pointIndex) / 50.0f;
+        // Zero at the center
+        fvec const normalizer_N = (fvec::load(massBuffer + p) / displacementLength_N) & neq_mask(displacementLength_N, zero_N);
 
         // Angular (constant)
-        mPoints.AddStaticForce(
-            pointIndex,
-            vec2f(-normalizedDisplacement.y, normalizedDisplacement.x)
-                * strength
-                * massNormalization
-                / 10.0f); // Magic number
+        fvec const angularCoefficient_N = angularStrength_N * normalizer_N;
 
         // Radial (stronger when closer)
-        mPoints.AddStaticForce(
-            pointIndex,
-            normalizedDisplacement
-                * strength
-                / (0.2f + 0.5f * sqrt(displacementLength))
-                * massNormalization
-                * 10.0f); // Magic number
+        fvec const radialCoefficient_N = radialStrength_N / (radialOffset_N + radialFactor_N * sqrt(displacementLength_N)) * normalizer_N;
+
+        fvec staticForceX_N, staticForceY_N;
+        fvec::load_xy(staticForceBuffer + p * 2, staticForceX_N, staticForceY_N);
+
+        fvec::store_xy(
+            staticForceX_N - displacementY_N * angularCoefficient_N + displacementX_N * radialCoefficient_N,
+            staticForceY_N + displacementX_N * angularCoefficient_N + displacementY_N * radialCoefficient_N,
+            staticForceBuffer + p * 2);
     }
 }
 
 void Ship::ApplyRadialExplosionForceField(
-    vec2f const & centerPosition,
-    float strength)
+    ForceField const & forceField,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
 {
     //
     // F = ForceStrength/sqrt(distance), along radius
     //
 
-    for (auto pointIndex : mPoints)
+    using fvec = float_vec<vectorization_float_count<size_t>>;
+
+    assert((startPointIndex % fvec::width) == 0 && (endPointIndex % fvec::width) == 0);
+
+    float const * restrict const positionBuffer = mPoints.GetPositionBufferAsFloat();
+    float * restrict const staticForceBuffer = mPoints.GetStaticForceBufferAsFloat();
+
+    fvec const zero_N = fvec::zero();
+    fvec const centerX_N = fvec::splat(forceField.CenterPosition.x);
+    fvec const centerY_N = fvec::splat(forceField.CenterPosition.y);
+    fvec const strength_N = fvec::splat(forceField.Strength);
+    fvec const distanceOffset_N = fvec::splat(0.1f);
+
+    for (size_t p = startPointIndex; p < endPointIndex; p += fvec::width)
+    {
+        fvec positionX_N, positionY_N;
+        fvec::load_xy(positionBuffer + p * 2, positionX_N, positionY_N);
+
+        fvec const displacementX_N = positionX_N - centerX_N;
+        fvec const displacementY_N = positionY_N - centerY_N;
+        fvec const displacementLength_N = sqrt(displacementX_N * displacementX_N + displacementY_N * displacementY_N);
+
+        // Zero at the center
+        fvec const forceCoefficient_N =
+            (strength_N / sqrt(distanceOffset_N + displacementLength_N) / displacementLength_N)
+            & neq_mask(displacementLength_N, zero_N);
+
+        fvec staticForceX_N, staticForceY_N;
+        fvec::load_xy(staticForceBuffer + p * 2, staticForceX_N, staticForceY_N);
+
+        fvec::store_xy(
+            staticForceX_N + displacementX_N * forceCoefficient_N,
+            staticForceY_N + displacementY_N * forceCoefficient_N,
+            staticForceBuffer + p * 2);
+    }
+}
+
+void Ship::ApplyBlastForceField(
+    ForceField & forceField,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+    //
+    // For each point in radius:
+    //  - Apply blast force
+    //  - Apply blast heat
+    //  - Keep point that is closest to blast position
+    //
+    // This one stays scalar: blasts are small and culling leaves them just a block or two,
+    // where they only touch the few points in radius and track the closest of them
+    //
+
+    vec2f const * restrict const positionBuffer = mPoints.GetPositionBufferAsVec2();
+    vec2f * restrict const staticForceBuffer = mPoints.GetStaticForceBufferAsVec2();
+    float * restrict const temperatureBuffer = mPoints.GetTemperatureBufferAsFloat();
+    vec2f * restrict const waterVelocityBuffer = mPoints.GetWaterVelocityBufferAsVec2();
+    float const * restrict const waterBuffer = mPoints.GetWaterBufferAsFloat();
+
+    float const squareBlastRadius = forceField.Radius * forceField.Radius;
+
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
-        vec2f displacement = (mPoints.GetPosition(pointIndex) - centerPosition);
-        float forceMagnitude = strength / sqrtf(0.1f + displacement.length());
+        vec2f const pointRadius = positionBuffer[pointIndex] - forceField.CenterPosition;
+        float const squarePointDistance = pointRadius.squareLength();
+        if (squarePointDistance < squareBlastRadius)
+        {
+            float const pointRadiusLength = std::sqrt(squarePointDistance);
+
+            //
+            // Apply blast force
+            //
+            // (inversely proportional to square root of distance, not second power as one would expect though)
+            //
+
+            vec2f const blastDir = pointRadius.normalise_approx(pointRadiusLength);
+
+            staticForceBuffer[pointIndex] += blastDir * forceField.Strength / std::sqrt(std::max((pointRadiusLength * 0.3f) + 0.7f, 1.0f));
+
+            //
+            // Inject heat at this point
+            //
 
-        mPoints.AddStaticForce(
-            pointIndex,
-            displacement.normalise() * forceMagnitude);
+            // Calc temperature delta
+            // T = Q/HeatCapacity
+            float const deltaT =
+                forceField.Heat
+                / std::max(pointRadiusLength, 1.0f)
+                * mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+
+            // Increase temperature
+            temperatureBuffer[pointIndex] += deltaT;
+
+            // Update water velocity
+            waterVelocityBuffer[pointIndex] += blastDir * 100.0f * waterBuffer[pointIndex]; // Magic number
+
+            //
+            // Check whether this point is the closest point
+            //
+
+            if (squarePointDistance < forceField.ClosestPointSquareDistance)
+            {
+                forceField.ClosestPointSquareDistance = squarePointDistance;
+                forceField.ClosestPointIndex = pointIndex;
+            }
+        }
     }
 }
 
-}
\ No newline at end of file
+}
@@ -210,6 +210,9 @@ void Ship::RotateBy(
     vec2f const inertialRotX(cos(inertialAngle), sin(inertialAngle));
     vec2f const inertialRotY(-sin(inertialAngle), cos(inertialAngle));
 
+    // Positions are relative to the position origin
+    vec2f const relativeCenter = center - mPoints.GetPositionOrigin();
+
     vec2f * const restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
     vec2f * const restrict velocityBuffer = mPoints.GetVelocityBufferAsVec2();
     vec2f * const restrict waterVelocityBuffer = mPoints.GetWaterVelocityBufferAsVec2();
@@ -218,8 +221,8 @@ void Ship::RotateBy(
 
     for (auto const p : mPoints.BufferElements())
     {
-        vec2f const centeredPos = positionBuffer[p] - center;
-        vec2f const newPosition = vec2f(centeredPos.dot(rotX), centeredPos.dot(rotY)) + center;
+        vec2f const centeredPos = positionBuffer[p] - relativeCenter;
+        vec2f const newPosition = vec2f(centeredPos.dot(rotX), centeredPos.dot(rotY)) + relativeCenter;
         positionBuffer[p] = newPosition;
 
         vec2f const linearInertialVelocity = (vec2f(centeredPos.dot(inertialRotX), centeredPos.dot(inertialRotY)) - centeredPos) * inertiaMagnitude;
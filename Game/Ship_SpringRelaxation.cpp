@@ -5,19 +5,78 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/FloatVec.h>
 #include <GameCore/SysSpecifics.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace Physics {
 
+void Ship::UpdateMechanicalGameParameters(GameParameters const & gameParameters)
+{
+    mMechanicalGameParameters = gameParameters;
+
+    if (!gameParameters.DoAdaptMechanicalDynamicsIterations
+        || !mQueuedInteractions.empty())
+    {
+        // Back to the configured number of iterations; queued interactions
+        // calculate their forces with it
+        mMechanicalDynamicsIterationsFraction = 1.0f;
+        mMechanicalDynamicsIterationsCalmStepsCount = 0;
+    }
+
+    if (mMechanicalDynamicsIterationsFraction != 1.0f)
+    {
+        mMechanicalGameParameters.NumMechanicalDynamicsIterationsAdjustment = std::max(
+            gameParameters.NumMechanicalDynamicsIterationsAdjustment * mMechanicalDynamicsIterationsFraction,
+            GameParameters::MinNumMechanicalDynamicsIterationsAdjustment);
+    }
+}
+
 void Ship::RecalculateSpringRelaxationParallelism(
     size_t simulationParallelism,
+    ThreadPool & threadPool,
     GameParameters const & gameParameters)
 {
-    RecalculateSpringRelaxationSpringForcesParallelism(simulationParallelism);
+    RecalculateSpringRelaxationSpringForcesParallelism(simulationParallelism, threadPool);
     RecalculateSpringRelaxationIntegrationAndSeaFloorCollisionParallelism(simulationParallelism, gameParameters);
+
+    //
+    // When both phases run on one thread anyway, and the ship is too large to stay in
+    // cache across the two phases, we may fuse them into a single, cache-blocked pass.
+    //
+    // Off by default: on the hardware we've measured, the spring pass is bound by computation
+    // rather than by memory, and the fused pass is not faster (see Benchmarks/SpringRelaxation.cpp)
+    //
+
+    // Springs per block: with spring and point data, ~500KB
+    ElementCount constexpr FusedBlockSize = 16384;
+    static_assert((FusedBlockSize % vectorization_float_count<ElementCount>) == 0);
+
+    if (gameParameters.DoFuseSpringRelaxation
+        && mSpringRelaxationSpringForcesTasks.size() == 1
+        && mSpringRelaxationIntegrationTasks.size() == 1
+        && mSprings.GetElementCount() >= 4 * FusedBlockSize)
+    {
+        mSpringRelaxationBlockSchedule = SpringRelaxationBlockSchedule::Make(
+            mSprings.GetEndpointsBuffer(),
+            mSprings.GetElementCount(),
+            mPoints.GetBufferElementCount(),
+            FusedBlockSize);
+
+        LogMessage("Ship::RecalculateSpringRelaxationParallelism: fused; blocks=", mSpringRelaxationBlockSchedule.GetBlocks().size(),
+            " pointRuns=", mSpringRelaxationBlockSchedule.GetPointRuns().size());
+    }
+    else
+    {
+        mSpringRelaxationBlockSchedule = SpringRelaxationBlockSchedule();
+    }
 }
 
-void Ship::RecalculateSpringRelaxationSpringForcesParallelism(size_t simulationParallelism)
+void Ship::RecalculateSpringRelaxationSpringForcesParallelism(
+    size_t simulationParallelism,
+    ThreadPool & threadPool)
 {
     // Clear threading state
     mSpringRelaxationSpringForcesTasks.clear();
@@ -53,7 +112,7 @@ void Ship::RecalculateSpringRelaxationSpringForcesParallelism(size_t simulationP
     // Prepare dynamic force buffers
     //
 
-    mPoints.SetDynamicForceParallelism(springRelaxationParallelism);
+    mPoints.SetDynamicForceParallelism(springRelaxationParallelism, threadPool);
 
     //
     // Prepare tasks
@@ -169,36 +228,69 @@ void Ship::RunSpringRelaxationAndDynamicForcesIntegration(
     auto & threadPool = threadManager.GetSimulationThreadPool();
 
     int const numMechanicalDynamicsIterations = gameParameters.NumMechanicalDynamicsIterations<int>();
-    for (int iter = 0; iter < numMechanicalDynamicsIterations; ++iter)
-    {
-        // - DynamicForces = 0 | others at first iteration only
-
-        // Apply spring forces
-        threadPool.Run(mSpringRelaxationSpringForcesTasks);
 
-        // - DynamicForces = sf | sf + others at first iteration only
+    // When adapting the number of iterations, we sample the residual at the last iteration
+    // that doesn't handle sea floor collisions, as those would make it spike
+    bool const doSampleResidual = gameParameters.DoAdaptMechanicalDynamicsIterations;
+    int const residualSampleIteration = std::max(
+        ((numMechanicalDynamicsIterations - 2) / SeaFloorCollisionPeriod) * SeaFloorCollisionPeriod,
+        0);
+    float residual = 0.0f;
 
-        if ((iter % SeaFloorCollisionPeriod) < SeaFloorCollisionPeriod - 1)
+    for (int iter = 0; iter < numMechanicalDynamicsIterations; ++iter)
+    {
+        if (doSampleResidual && iter == residualSampleIteration)
         {
-            // Integrate dynamic and static forces,
-            // and reset dynamic forces
+            BeginMechanicalDynamicsResidualSample();
+        }
 
-            threadPool.Run(mSpringRelaxationIntegrationTasks);
+        if (!mSpringRelaxationBlockSchedule.IsEmpty())
+        {
+            RunFusedSpringRelaxationIteration(
+                (iter % SeaFloorCollisionPeriod) == SeaFloorCollisionPeriod - 1,
+                gameParameters);
         }
         else
         {
-            assert((iter % SeaFloorCollisionPeriod) == SeaFloorCollisionPeriod - 1);
+            // - DynamicForces = 0 | others at first iteration only
 
-            // Integrate dynamic and static forces,
-            // and reset dynamic forces
+            // Apply spring forces
+            threadPool.Run(mSpringRelaxationSpringForcesTasks);
+
+            // - DynamicForces = sf | sf + others at first iteration only
+
+            if ((iter % SeaFloorCollisionPeriod) < SeaFloorCollisionPeriod - 1)
+            {
+                // Integrate dynamic and static forces,
+                // and reset dynamic forces
+
+                threadPool.Run(mSpringRelaxationIntegrationTasks);
+            }
+            else
+            {
+                assert((iter % SeaFloorCollisionPeriod) == SeaFloorCollisionPeriod - 1);
+
+                // Integrate dynamic and static forces,
+                // and reset dynamic forces
+
+                // Handle collisions with sea floor
+                //  - Changes position and velocity
 
-            // Handle collisions with sea floor
-            //  - Changes position and velocity
+                threadPool.Run(mSpringRelaxationIntegrationAndSeaFloorCollisionTasks);
+            }
 
-            threadPool.Run(mSpringRelaxationIntegrationAndSeaFloorCollisionTasks);
+            // - DynamicForces = 0
         }
 
-        // - DynamicForces = 0
+        if (doSampleResidual && iter == residualSampleIteration)
+        {
+            residual = EndMechanicalDynamicsResidualSample(gameParameters);
+        }
+    }
+
+    if (doSampleResidual)
+    {
+        UpdateMechanicalDynamicsIterationsFraction(residual);
     }
 
 #ifdef _DEBUG
@@ -206,6 +298,127 @@ void Ship::RunSpringRelaxationAndDynamicForcesIntegration(
 #endif
 }
 
+void Ship::BeginMechanicalDynamicsResidualSample()
+{
+    std::copy_n(
+        mPoints.GetVelocityBufferAsVec2(),
+        mPoints.GetRawShipPointCount(),
+        mMechanicalDynamicsResidualVelocityBuffer.data());
+}
+
+float Ship::EndMechanicalDynamicsResidualSample(GameParameters const & gameParameters)
+{
+    //
+    // The residual is the RMS of the deviations of the particle accelerations from
+    // their mean: a ship at rest, or translating uniformly (e.g. falling), has all of
+    // its particles accelerating alike, while springs still relaxing make them diverge
+    //
+
+    ElementCount const pointCount = mPoints.GetRawShipPointCount();
+    if (pointCount == 0)
+    {
+        return 0.0f;
+    }
+
+    vec2f const * restrict const oldVelocityBuffer = mMechanicalDynamicsResidualVelocityBuffer.data();
+    vec2f const * restrict const newVelocityBuffer = mPoints.GetVelocityBufferAsVec2();
+
+    // Double-precision accumulators, as the mean acceleration may dominate the deviations
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumSquaredLength = 0.0;
+    for (ElementIndex p = 0; p < pointCount; ++p)
+    {
+        vec2f const deltaV = newVelocityBuffer[p] - oldVelocityBuffer[p];
+        sumX += deltaV.x;
+        sumY += deltaV.y;
+        sumSquaredLength += deltaV.squareLength();
+    }
+
+    double const meanX = sumX / pointCount;
+    double const meanY = sumY / pointCount;
+    double const variance = std::max(sumSquaredLength / pointCount - meanX * meanX - meanY * meanY, 0.0);
+
+    return static_cast<float>(std::sqrt(variance)) / gameParameters.MechanicalSimulationStepTimeDuration<float>();
+}
+
+void Ship::UpdateMechanicalDynamicsIterationsFraction(float residual)
+{
+    if (residual > GameParameters::AdaptiveMechanicalDynamicsIterationsAgitatedResidual)
+    {
+        // Back to the configured number of iterations right away
+        mMechanicalDynamicsIterationsFraction = 1.0f;
+        mMechanicalDynamicsIterationsCalmStepsCount = 0;
+    }
+    else if (residual < GameParameters::AdaptiveMechanicalDynamicsIterationsCalmResidual)
+    {
+        // Lower the number of iterations by one step after a while
+        ++mMechanicalDynamicsIterationsCalmStepsCount;
+        if (mMechanicalDynamicsIterationsCalmStepsCount >= GameParameters::AdaptiveMechanicalDynamicsIterationsCalmSteps)
+        {
+            mMechanicalDynamicsIterationsFraction = std::max(
+                mMechanicalDynamicsIterationsFraction - GameParameters::AdaptiveMechanicalDynamicsIterationsFractionStep,
+                GameParameters::MinAdaptiveMechanicalDynamicsIterationsFraction);
+
+            mMechanicalDynamicsIterationsCalmStepsCount = 0;
+        }
+    }
+    else
+    {
+        // In-between: stay where we are
+        mMechanicalDynamicsIterationsCalmStepsCount = 0;
+    }
+}
+
+void Ship::RunFusedSpringRelaxationIteration(
+    bool doHandleCollisionsWithSeaFloor,
+    GameParameters const & gameParameters)
+{
+    assert(mSpringRelaxationSpringForcesTasks.size() == 1);
+
+    vec2f * restrict const dynamicForceBuffer = mPoints.GetParallelDynamicForceBuffer(0);
+
+    auto const & pointRuns = mSpringRelaxationBlockSchedule.GetPointRuns();
+
+    for (auto const & block : mSpringRelaxationBlockSchedule.GetBlocks())
+    {
+        // - DynamicForces = 0 | others at first iteration only
+
+        // Apply spring forces
+        ApplySpringsForces(
+            block.StartSpringIndex,
+            block.EndSpringIndex,
+            dynamicForceBuffer);
+
+        // Integrate the points that no further spring is going to touch; their
+        // spring forces are now complete
+
+        for (size_t r = block.StartPointRunIndex; r < block.EndPointRunIndex; ++r)
+        {
+            // Integrate dynamic and static forces,
+            // and reset dynamic forces
+
+            IntegrateAndResetDynamicForces_1(
+                pointRuns[r].StartPointIndex,
+                pointRuns[r].EndPointIndex,
+                gameParameters);
+
+            if (doHandleCollisionsWithSeaFloor)
+            {
+                // Handle collisions with sea floor
+                //  - Changes position and velocity
+
+                HandleCollisionsWithSeaFloor(
+                    pointRuns[r].StartPointIndex,
+                    pointRuns[r].EndPointIndex,
+                    gameParameters);
+            }
+        }
+
+        // - DynamicForces = 0 for the integrated points
+    }
+}
+
 void Ship::IntegrateAndResetDynamicForces(
     ElementIndex startPointIndex,
     ElementIndex endPointIndex,
@@ -246,610 +459,249 @@ void Ship::IntegrateAndResetDynamicForces(
 }
 
 ///////////////////////////////////////////////////////////////
-// SSE
+// Vectorized
 ///////////////////////////////////////////////////////////////
 
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-
-void Ship::ApplySpringsForces(
-    ElementIndex startSpringIndex,
-    ElementIndex endSpringIndex, // Excluded
-    vec2f * restrict dynamicForceBuffer)
+/*
+ * Calculates the total (Hooke + damping) forces on the A endpoints of N springs, given
+ * their B - A displacements and relative velocities, and the springs' coefficients; the
+ * forces on the B endpoints are just the opposite.
+ */
+template<size_t N>
+static inline void CalculateSpringForces_SIMD(
+    float_vec<N> const & displacementX,
+    float_vec<N> const & displacementY,
+    float_vec<N> const & relativeVelocityX,
+    float_vec<N> const & relativeVelocityY,
+    float const * restrict restLengths,
+    float const * restrict stiffnessCoefficients,
+    float const * restrict dampingCoefficients,
+    float_vec<N> & outForceAX,
+    float_vec<N> & outForceAY)
 {
-    // This implementation is for 4-float SSE
-    static_assert(vectorization_float_count<int> >= 4);
-
-    vec2f const * restrict const positionBuffer = mPoints.GetPositionBufferAsVec2();
-    vec2f const * restrict const velocityBuffer = mPoints.GetVelocityBufferAsVec2();
-
-    Springs::Endpoints const * restrict const endpointsBuffer = mSprings.GetEndpointsBuffer();
-    float const * restrict const restLengthBuffer = mSprings.GetRestLengthBuffer();
-    float const * restrict const stiffnessCoefficientBuffer = mSprings.GetStiffnessCoefficientBuffer();
-    float const * restrict const dampingCoefficientBuffer = mSprings.GetDampingCoefficientBuffer();
-
-    __m128 const Zero = _mm_setzero_ps();
-    aligned_to_vword vec2f tmpSpringForces[4];
-
-    ElementIndex s = startSpringIndex;
+    using fvec = float_vec<N>;
 
+    // Calculate spring lengths: sqrt( x*x + y*y )
     //
-    // 1. Perfect squares
+    // Note: the kung-fu below (reciprocal square, then reciprocal, etc.) should be faster:
     //
+    //  Standard: sqrt 12, (div 11, and 1), (div 11, and 1) = 5instrs/36cycles
+    //  This one: rsqrt 4, and 1, (mul 4), (mul 4), rec 4, and 1 = 6instrs/18cycles
 
-    ElementCount const endSpringIndexPerfectSquare = std::min(endSpringIndex, mSprings.GetPerfectSquareCount() * 4);
-
-    for (; s < endSpringIndexPerfectSquare; s += 4)
-    {
-        // XMM register notation:
-        //   low (left, or top) -> height (right, or bottom)
-
-        //
-        //    J          M   ---  a
-        //    |\        /|
-        //    | \s0  s1/ |
-        //    |  \    /  |
-        //  s2|   \  /   |s3
-        //    |    \/    |
-        //    |    /\    |
-        //    |   /  \   |
-        //    |  /    \  |
-        //    | /      \ |
-        //    |/        \|
-        //    K          L  ---  b
-        //
-
-        //
-        // Calculate displacements, string lengths, and spring directions
-        //
-        // Steps:
-        // 
-        // l_pos_x   -   j_pos_x   =  s0_dis_x
-        // l_pos_y   -   j_pos_y   =  s0_dis_y
-        // k_pos_x   -   m_pos_x   =  s1_dis_x
-        // k_pos_y   -   m_pos_y   =  s1_dis_y
-        // 
-        // Swap 2H with 2L in first register, then:
-        // 
-        // k_pos_x   -   j_pos_x   =  s2_dis_x
-        // k_pos_y   -   j_pos_y   =  s2_dis_y
-        // l_pos_x   -   m_pos_x   =  s3_dis_x
-        // l_pos_y   -   m_pos_y   =  s3_dis_y
-        // 
-
-        ElementIndex const pointJIndex = endpointsBuffer[s + 0].PointAIndex;
-        ElementIndex const pointKIndex = endpointsBuffer[s + 1].PointBIndex;
-        ElementIndex const pointLIndex = endpointsBuffer[s + 0].PointBIndex;
-        ElementIndex const pointMIndex = endpointsBuffer[s + 1].PointAIndex;
-        
-        assert(pointJIndex == endpointsBuffer[s + 2].PointAIndex);
-        assert(pointKIndex == endpointsBuffer[s + 2].PointBIndex);
-        assert(pointLIndex == endpointsBuffer[s + 3].PointBIndex);
-        assert(pointMIndex == endpointsBuffer[s + 3].PointAIndex);
-
-        // ?_pos_x
-        // ?_pos_y
-        // *
-        // *
-        __m128 const j_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + pointJIndex)));
-        __m128 const k_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + pointKIndex)));
-        __m128 const l_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + pointLIndex)));
-        __m128 const m_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + pointMIndex)));
-
-        __m128 const jm_pos_xy = _mm_movelh_ps(j_pos_xy, m_pos_xy); // First argument goes low
-        __m128 lk_pos_xy = _mm_movelh_ps(l_pos_xy, k_pos_xy); // First argument goes low
-        __m128 const s0s1_dis_xy = _mm_sub_ps(lk_pos_xy, jm_pos_xy);
-        lk_pos_xy = _mm_shuffle_ps(lk_pos_xy, lk_pos_xy, _MM_SHUFFLE(1, 0, 3, 2));
-        __m128 const s2s3_dis_xy = _mm_sub_ps(lk_pos_xy, jm_pos_xy);
-
-        // Shuffle:
-        //
-        // s0_dis_x     s0_dis_y
-        // s1_dis_x     s1_dis_y
-        // s2_dis_x     s2_dis_y
-        // s3_dis_x     s3_dis_y
-        __m128 const s0s1s2s3_dis_x = _mm_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0x88);
-        __m128 const s0s1s2s3_dis_y = _mm_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0xDD);
-
-        // Calculate spring lengths: sqrt( x*x + y*y )
-        //
-        // Note: the kung-fu below (reciprocal square, then reciprocal, etc.) should be faster:
-        //
-        //  Standard: sqrt 12, (div 11, and 1), (div 11, and 1) = 5instrs/36cycles
-        //  This one: rsqrt 4, and 1, (mul 4), (mul 4), rec 4, and 1 = 6instrs/18cycles
-
-        __m128 const sq_len =
-            _mm_add_ps(
-                _mm_mul_ps(s0s1s2s3_dis_x, s0s1s2s3_dis_x),
-                _mm_mul_ps(s0s1s2s3_dis_y, s0s1s2s3_dis_y));
-
-        __m128 const validMask = _mm_cmpneq_ps(sq_len, Zero); // SL==0 => 1/SL==0, to maintain "normalized == (0, 0)", as in vec2f        
-
-        __m128 const s0s1s2s3_springLength_inv =
-            _mm_and_ps(
-                _mm_rsqrt_ps(sq_len),
-                validMask);
-
-        __m128 const s0s1s2s3_springLength =
-            _mm_and_ps(
-                _mm_rcp_ps(s0s1s2s3_springLength_inv),
-                validMask);
-
-        // Calculate spring directions        
-        __m128 const s0s1s2s3_sdir_x = _mm_mul_ps(s0s1s2s3_dis_x, s0s1s2s3_springLength_inv);
-        __m128 const s0s1s2s3_sdir_y = _mm_mul_ps(s0s1s2s3_dis_y, s0s1s2s3_springLength_inv);
-
-        //////////////////////////////////////////////////////////////////////////////////////////////
-
-        //
-        // 1. Hooke's law
-        //
-
-        // Calculate springs' forces' moduli - for endpoint A:
-        //    (displacementLength[s] - restLength[s]) * stiffness[s]
-        //
-        // Strategy:
-        //
-        // ( springLength[s0] - restLength[s0] ) * stiffness[s0]
-        // ( springLength[s1] - restLength[s1] ) * stiffness[s1]
-        // ( springLength[s2] - restLength[s2] ) * stiffness[s2]
-        // ( springLength[s3] - restLength[s3] ) * stiffness[s3]
-        //
-
-        __m128 const s0s1s2s3_hooke_forceModuli =
-            _mm_mul_ps(
-                _mm_sub_ps(
-                    s0s1s2s3_springLength,
-                    _mm_load_ps(restLengthBuffer + s)),
-                _mm_load_ps(stiffnessCoefficientBuffer + s));
-
-        //
-        // 2. Damper forces
-        //
-        // Damp the velocities of each endpoint pair, as if the points were also connected by a damper
-        // along the same direction as the spring, for endpoint A:
-        //      relVelocity.dot(springDir) * dampingCoeff[s]
-        //
-        // Strategy: 
-        // 
-        // (s0_relv_x * s0_sdir_x  +  s0_relv_y * s0_sdir_y) * dampCoeff[s0]
-        // (s1_relv_x * s1_sdir_x  +  s1_relv_y * s1_sdir_y) * dampCoeff[s1]
-        // (s2_relv_x * s2_sdir_x  +  s2_relv_y * s2_sdir_y) * dampCoeff[s2]
-        // (s3_relv_x * s3_sdir_x  +  s3_relv_y * s3_sdir_y) * dampCoeff[s3]
-        //
-
-        // ?_vel_x
-        // ?_vel_y
-        // *
-        // *
-        __m128 const j_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + pointJIndex)));
-        __m128 const k_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + pointKIndex)));
-        __m128 const l_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + pointLIndex)));
-        __m128 const m_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + pointMIndex)));
-
-        __m128 const jm_vel_xy = _mm_movelh_ps(j_vel_xy, m_vel_xy); // First argument goes low
-        __m128 lk_vel_xy = _mm_movelh_ps(l_vel_xy, k_vel_xy); // First argument goes low
-        __m128 const s0s1_rvel_xy = _mm_sub_ps(lk_vel_xy, jm_vel_xy);
-        lk_vel_xy = _mm_shuffle_ps(lk_vel_xy, lk_vel_xy, _MM_SHUFFLE(1, 0, 3, 2));
-        __m128 const s2s3_rvel_xy = _mm_sub_ps(lk_vel_xy, jm_vel_xy);
-
-        __m128 s0s1s2s3_rvel_x = _mm_shuffle_ps(s0s1_rvel_xy, s2s3_rvel_xy, 0x88);
-        __m128 s0s1s2s3_rvel_y = _mm_shuffle_ps(s0s1_rvel_xy, s2s3_rvel_xy, 0xDD);
-
-        __m128 const s0s1s2s3_damping_forceModuli =
-            _mm_mul_ps(
-                _mm_add_ps( // Dot product
-                    _mm_mul_ps(s0s1s2s3_rvel_x, s0s1s2s3_sdir_x),
-                    _mm_mul_ps(s0s1s2s3_rvel_y, s0s1s2s3_sdir_y)),
-                _mm_load_ps(dampingCoefficientBuffer + s));
-
-        //
-        // 3. Apply forces: 
-        //      force A = springDir * (hookeForce + dampingForce)
-        //      force B = - forceA
-        //
-        // Strategy:
-        //
-        //  s0_tforce_a_x  =   s0_sdir_x  *  (  hookeForce[s0] + dampingForce[s0] ) 
-        //  s1_tforce_a_x  =   s1_sdir_x  *  (  hookeForce[s1] + dampingForce[s1] )
-        //  s2_tforce_a_x  =   s2_sdir_x  *  (  hookeForce[s2] + dampingForce[s2] )
-        //  s3_tforce_a_x  =   s3_sdir_x  *  (  hookeForce[s3] + dampingForce[s3] )
-        //
-        //  s0_tforce_a_y  =   s0_sdir_y  *  (  hookeForce[s0] + dampingForce[s0] ) 
-        //  s1_tforce_a_y  =   s1_sdir_y  *  (  hookeForce[s1] + dampingForce[s1] )
-        //  s2_tforce_a_y  =   s2_sdir_y  *  (  hookeForce[s2] + dampingForce[s2] )
-        //  s3_tforce_a_y  =   s3_sdir_y  *  (  hookeForce[s3] + dampingForce[s3] )
-        //
-
-        __m128 const tForceModuli = _mm_add_ps(s0s1s2s3_hooke_forceModuli, s0s1s2s3_damping_forceModuli);
-
-        __m128 const s0s1s2s3_tforceA_x =
-            _mm_mul_ps(
-                s0s1s2s3_sdir_x,
-                tForceModuli);
-
-        __m128 const s0s1s2s3_tforceA_y =
-            _mm_mul_ps(
-                s0s1s2s3_sdir_y,
-                tForceModuli);
-
-        //
-        // Unpack and add forces:
-        //      dynamicForceBuffer[pointAIndex] += total_forceA;
-        //      dynamicForceBuffer[pointBIndex] -= total_forceA;
-        //
-        // j_sforce += s0_a_tforce + s2_a_tforce
-        // m_sforce += s1_a_tforce + s3_a_tforce
-        // 
-        // l_sforce -= s0_a_tforce + s3_a_tforce
-        // k_sforce -= s1_a_tforce + s2_a_tforce
-
+    fvec const squareSpringLength = displacementX * displacementX + displacementY * displacementY;
 
-        __m128 s0s1_tforceA_xy = _mm_unpacklo_ps(s0s1s2s3_tforceA_x, s0s1s2s3_tforceA_y); // a[0], b[0], a[1], b[1]
-        __m128 s2s3_tforceA_xy = _mm_unpackhi_ps(s0s1s2s3_tforceA_x, s0s1s2s3_tforceA_y); // a[2], b[2], a[3], b[3]
+    fvec const validMask = neq_mask(squareSpringLength, fvec::zero()); // SL==0 => 1/SL==0, to maintain "normalized == (0, 0)", as in vec2f
 
-        __m128 const jm_sforce_xy = _mm_add_ps(s0s1_tforceA_xy, s2s3_tforceA_xy);
-        s2s3_tforceA_xy = _mm_shuffle_ps(s2s3_tforceA_xy, s2s3_tforceA_xy, _MM_SHUFFLE(1, 0, 3, 2));
-        __m128 const lk_sforce_xy = _mm_add_ps(s0s1_tforceA_xy, s2s3_tforceA_xy);
+    fvec const springLengthInv = rsqrt_approx(squareSpringLength) & validMask;
+    fvec const springLength = rcp_approx(springLengthInv) & validMask;
 
-        _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[0])), jm_sforce_xy);
-        _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[2])), lk_sforce_xy);
-
-        dynamicForceBuffer[pointJIndex] += tmpSpringForces[0];
-        dynamicForceBuffer[pointMIndex] += tmpSpringForces[1];
-        dynamicForceBuffer[pointLIndex] -= tmpSpringForces[2];
-        dynamicForceBuffer[pointKIndex] -= tmpSpringForces[3];
-    }
+    // Calculate spring directions
+    fvec const springDirX = displacementX * springLengthInv;
+    fvec const springDirY = displacementY * springLengthInv;
 
     //
-    // 2. Remaining four-by-four's
+    // 1. Hooke's law
+    //
+    // Calculate springs' forces' moduli - for endpoint A:
+    //    (displacementLength[s] - restLength[s]) * stiffness[s]
     //
 
-    ElementCount const endSpringIndexVectorized = endSpringIndex - (endSpringIndex % 4);
-
-    for (; s < endSpringIndexVectorized; s += 4)
-    {
-        // Spring 0 displacement (s0_position.x, s0_position.y, *, *)
-        __m128 const s0pa_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + endpointsBuffer[s + 0].PointAIndex)));
-        __m128 const s0pb_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + endpointsBuffer[s + 0].PointBIndex)));
-        // s0_displacement.x, s0_displacement.y, *, *
-        __m128 const s0_displacement_xy = _mm_sub_ps(s0pb_pos_xy, s0pa_pos_xy);
-
-        // Spring 1 displacement (s1_position.x, s1_position.y, *, *)
-        __m128 const s1pa_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + endpointsBuffer[s + 1].PointAIndex)));
-        __m128 const s1pb_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + endpointsBuffer[s + 1].PointBIndex)));
-        // s1_displacement.x, s1_displacement.y
-        __m128 const s1_displacement_xy = _mm_sub_ps(s1pb_pos_xy, s1pa_pos_xy);
-
-        // s0_displacement.x, s0_displacement.y, s1_displacement.x, s1_displacement.y
-        __m128 const s0s1_displacement_xy = _mm_movelh_ps(s0_displacement_xy, s1_displacement_xy); // First argument goes low
-
-        // Spring 2 displacement (s2_position.x, s2_position.y, *, *)
-        __m128 const s2pa_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + endpointsBuffer[s + 2].PointAIndex)));
-        __m128 const s2pb_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + endpointsBuffer[s + 2].PointBIndex)));
-        // s2_displacement.x, s2_displacement.y
-        __m128 const s2_displacement_xy = _mm_sub_ps(s2pb_pos_xy, s2pa_pos_xy);
-
-        // Spring 3 displacement (s3_position.x, s3_position.y, *, *)
-        __m128 const s3pa_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + endpointsBuffer[s + 3].PointAIndex)));
-        __m128 const s3pb_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(positionBuffer + endpointsBuffer[s + 3].PointBIndex)));
-        // s3_displacement.x, s3_displacement.y
-        __m128 const s3_displacement_xy = _mm_sub_ps(s3pb_pos_xy, s3pa_pos_xy);
-
-        // s2_displacement.x, s2_displacement.y, s3_displacement.x, s3_displacement.y
-        __m128 const s2s3_displacement_xy = _mm_movelh_ps(s2_displacement_xy, s3_displacement_xy); // First argument goes low
-
-        // Shuffle displacements:
-        // s0_displacement.x, s1_displacement.x, s2_displacement.x, s3_displacement.x
-        __m128 s0s1s2s3_displacement_x = _mm_shuffle_ps(s0s1_displacement_xy, s2s3_displacement_xy, 0x88);
-        // s0_displacement.y, s1_displacement.y, s2_displacement.y, s3_displacement.y
-        __m128 s0s1s2s3_displacement_y = _mm_shuffle_ps(s0s1_displacement_xy, s2s3_displacement_xy, 0xDD);
-
-        // Calculate spring lengths
-
-        // s0_displacement.x^2, s1_displacement.x^2, s2_displacement.x^2, s3_displacement.x^2
-        __m128 const s0s1s2s3_displacement_x2 = _mm_mul_ps(s0s1s2s3_displacement_x, s0s1s2s3_displacement_x);
-        // s0_displacement.y^2, s1_displacement.y^2, s2_displacement.y^2, s3_displacement.y^2
-        __m128 const s0s1s2s3_displacement_y2 = _mm_mul_ps(s0s1s2s3_displacement_y, s0s1s2s3_displacement_y);
-
-        // s0_displacement.x^2 + s0_displacement.y^2, s1_displacement.x^2 + s1_displacement.y^2, s2_displacement..., s3_displacement...
-        __m128 const s0s1s2s3_displacement_x2_p_y2 = _mm_add_ps(s0s1s2s3_displacement_x2, s0s1s2s3_displacement_y2);
-
-        __m128 const validMask = _mm_cmpneq_ps(s0s1s2s3_displacement_x2_p_y2, Zero);
-
-        __m128 const s0s1s2s3_springLength_inv =
-            _mm_and_ps(
-                _mm_rsqrt_ps(s0s1s2s3_displacement_x2_p_y2),
-                validMask);
-
-        __m128 const s0s1s2s3_springLength =
-            _mm_and_ps(
-                _mm_rcp_ps(s0s1s2s3_springLength_inv),
-                validMask);
-
-        // Calculate spring directions
-        __m128 const s0s1s2s3_sdir_x = _mm_mul_ps(s0s1s2s3_displacement_x, s0s1s2s3_springLength_inv);
-        __m128 const s0s1s2s3_sdir_y = _mm_mul_ps(s0s1s2s3_displacement_y, s0s1s2s3_springLength_inv);
-        
-        //////////////////////////////////////////////////////////////////////////////////////////////
-
-        //
-        // 1. Hooke's law
-        //
-
-        // Calculate springs' forces' moduli - for endpoint A:
-        //    (displacementLength[s] - restLength[s]) * stiffness[s]
-        //
-        // Strategy:
-        //
-        // ( springLength[s0] - restLength[s0] ) * stiffness[s0]
-        // ( springLength[s1] - restLength[s1] ) * stiffness[s1]
-        // ( springLength[s2] - restLength[s2] ) * stiffness[s2]
-        // ( springLength[s3] - restLength[s3] ) * stiffness[s3]
-        //
-
-        __m128 const s0s1s2s3_restLength = _mm_load_ps(restLengthBuffer + s);
-        __m128 const s0s1s2s3_stiffness = _mm_load_ps(stiffnessCoefficientBuffer + s);
-
-        __m128 const s0s1s2s3_hooke_forceModuli = _mm_mul_ps(
-            _mm_sub_ps(s0s1s2s3_springLength, s0s1s2s3_restLength),
-            s0s1s2s3_stiffness);
+    fvec const hookeForceModuli =
+        (springLength - fvec::load(restLengths))
+        * fvec::load(stiffnessCoefficients);
 
-        //
-        // 2. Damper forces
-        //
-        // Damp the velocities of each endpoint pair, as if the points were also connected by a damper
-        // along the same direction as the spring, for endpoint A:
-        //      relVelocity.dot(springDir) * dampingCoeff[s]
-        //
-        // Strategy: 
-        //
-        // ( relV[s0].x * sprDir[s0].x  +  relV[s0].y * sprDir[s0].y )  *  dampCoeff[s0]
-        // ( relV[s1].x * sprDir[s1].x  +  relV[s1].y * sprDir[s1].y )  *  dampCoeff[s1]
-        // ( relV[s2].x * sprDir[s2].x  +  relV[s2].y * sprDir[s2].y )  *  dampCoeff[s2]
-        // ( relV[s3].x * sprDir[s3].x  +  relV[s3].y * sprDir[s3].y )  *  dampCoeff[s3]
-        //
+    //
+    // 2. Damper forces
+    //
+    // Damp the velocities of each endpoint pair, as if the points were also connected by a damper
+    // along the same direction as the spring, for endpoint A:
+    //      relVelocity.dot(springDir) * dampingCoeff[s]
+    //
 
-        // Spring 0 rel vel (s0_vel.x, s0_vel.y, *, *)
-        __m128 const s0pa_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + endpointsBuffer[s + 0].PointAIndex)));
-        __m128 const s0pb_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + endpointsBuffer[s + 0].PointBIndex)));
-        // s0_relvel_x, s0_relvel_y, *, *
-        __m128 const s0_relvel_xy = _mm_sub_ps(s0pb_vel_xy, s0pa_vel_xy);
-
-        // Spring 1 rel vel (s1_vel.x, s1_vel.y, *, *)
-        __m128 const s1pa_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + endpointsBuffer[s + 1].PointAIndex)));
-        __m128 const s1pb_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + endpointsBuffer[s + 1].PointBIndex)));
-        // s1_relvel_x, s1_relvel_y, *, *
-        __m128 const s1_relvel_xy = _mm_sub_ps(s1pb_vel_xy, s1pa_vel_xy);
-
-        // s0_relvel.x, s0_relvel.y, s1_relvel.x, s1_relvel.y
-        __m128 const s0s1_relvel_xy = _mm_movelh_ps(s0_relvel_xy, s1_relvel_xy); // First argument goes low
-
-        // Spring 2 rel vel (s2_vel.x, s2_vel.y, *, *)
-        __m128 const s2pa_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + endpointsBuffer[s + 2].PointAIndex)));
-        __m128 const s2pb_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + endpointsBuffer[s + 2].PointBIndex)));
-        // s2_relvel_x, s2_relvel_y, *, *
-        __m128 const s2_relvel_xy = _mm_sub_ps(s2pb_vel_xy, s2pa_vel_xy);
-
-        // Spring 3 rel vel (s3_vel.x, s3_vel.y, *, *)
-        __m128 const s3pa_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + endpointsBuffer[s + 3].PointAIndex)));
-        __m128 const s3pb_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(velocityBuffer + endpointsBuffer[s + 3].PointBIndex)));
-        // s3_relvel_x, s3_relvel_y, *, *
-        __m128 const s3_relvel_xy = _mm_sub_ps(s3pb_vel_xy, s3pa_vel_xy);
-
-        // s2_relvel.x, s2_relvel.y, s3_relvel.x, s3_relvel.y
-        __m128 const s2s3_relvel_xy = _mm_movelh_ps(s2_relvel_xy, s3_relvel_xy); // First argument goes low
-
-        // Shuffle rel vals:
-        // s0_relvel.x, s1_relvel.x, s2_relvel.x, s3_relvel.x
-        __m128 s0s1s2s3_relvel_x = _mm_shuffle_ps(s0s1_relvel_xy, s2s3_relvel_xy, 0x88);
-        // s0_relvel.y, s1_relvel.y, s2_relvel.y, s3_relvel.y
-        __m128 s0s1s2s3_relvel_y = _mm_shuffle_ps(s0s1_relvel_xy, s2s3_relvel_xy, 0xDD);
-
-        // Damping coeffs
-        __m128 const s0s1s2s3_dampingCoeff = _mm_load_ps(dampingCoefficientBuffer + s);
-
-        __m128 const s0s1s2s3_damping_forceModuli =
-            _mm_mul_ps(
-                _mm_add_ps( // Dot product
-                    _mm_mul_ps(s0s1s2s3_relvel_x, s0s1s2s3_sdir_x),
-                    _mm_mul_ps(s0s1s2s3_relvel_y, s0s1s2s3_sdir_y)),
-                s0s1s2s3_dampingCoeff);
+    fvec const dampingForceModuli =
+        (relativeVelocityX * springDirX + relativeVelocityY * springDirY) // Dot product
+        * fvec::load(dampingCoefficients);
 
-        //
-        // 3. Apply forces: 
-        //      force A = springDir * (hookeForce + dampingForce)
-        //      force B = - forceA
-        //
-        // Strategy:
-        //
-        //  total_forceA[s0].x  =   springDir[s0].x  *  (  hookeForce[s0] + dampingForce[s0] ) 
-        //  total_forceA[s1].x  =   springDir[s1].x  *  (  hookeForce[s1] + dampingForce[s1] )
-        //  total_forceA[s2].x  =   springDir[s2].x  *  (  hookeForce[s2] + dampingForce[s2] )
-        //  total_forceA[s3].x  =   springDir[s3].x  *  (  hookeForce[s3] + dampingForce[s3] )
-        //
-        //  total_forceA[s0].y  =   springDir[s0].y  *  (  hookeForce[s0] + dampingForce[s0] ) 
-        //  total_forceA[s1].y  =   springDir[s1].y  *  (  hookeForce[s1] + dampingForce[s1] )
-        //  total_forceA[s2].y  =   springDir[s2].y  *  (  hookeForce[s2] + dampingForce[s2] )
-        //  total_forceA[s3].y  =   springDir[s3].y  *  (  hookeForce[s3] + dampingForce[s3] )
-        //
+    //
+    // 3. Total force on A:
+    //      force A = springDir * (hookeForce + dampingForce)
+    //
 
-        __m128 const tForceModuli = _mm_add_ps(s0s1s2s3_hooke_forceModuli, s0s1s2s3_damping_forceModuli);
+    fvec const totalForceModuli = hookeForceModuli + dampingForceModuli;
 
-        __m128 const s0s1s2s3_tforceA_x =
-            _mm_mul_ps(
-                s0s1s2s3_sdir_x,
-                tForceModuli);
+    outForceAX = springDirX * totalForceModuli;
+    outForceAY = springDirY * totalForceModuli;
+}
 
-        __m128 const s0s1s2s3_tforceA_y =
-            _mm_mul_ps(
-                s0s1s2s3_sdir_y,
-                tForceModuli);
+/*
+ * Gathers the J, M, L, K points - in this order, in each group of four lanes - of N/4
+ * perfect squares, and calculates the B - A differences of their springs:
+ *  s0 = L - J, s1 = K - M, s2 = K - J, s3 = L - M
+ */
+template<size_t N>
+static inline void GatherSquareSpringDeltas_SIMD(
+    float const * restrict xy,
+    ElementIndex const * squarePointIndices,
+    float_vec<N> & outX,
+    float_vec<N> & outY)
+{
+    using fvec = float_vec<N>;
 
-        //
-        // Unpack and add forces:
-        //      pointSpringForceBuffer[pointAIndex] += total_forceA;
-        //      pointSpringForceBuffer[pointBIndex] -= total_forceA;
-        //
+    fvec x, y;
+    fvec::gather_xy(xy, squarePointIndices, x, y);
 
-        __m128 s0s1_tforceA_xy = _mm_unpacklo_ps(s0s1s2s3_tforceA_x, s0s1s2s3_tforceA_y); // a[0], b[0], a[1], b[1]
-        __m128 s2s3_tforceA_xy = _mm_unpackhi_ps(s0s1s2s3_tforceA_x, s0s1s2s3_tforceA_y); // a[2], b[2], a[3], b[3]
+    outX = fvec::template shuffle4<2, 3, 3, 2>(x) - fvec::template shuffle4<0, 1, 0, 1>(x);
+    outY = fvec::template shuffle4<2, 3, 3, 2>(y) - fvec::template shuffle4<0, 1, 0, 1>(y);
+}
 
-        _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[0])), s0s1_tforceA_xy);
-        _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[2])), s2s3_tforceA_xy);
+/*
+ * Gathers the A and B points of N springs, and calculates their B - A differences.
+ */
+template<size_t N>
+static inline void GatherSpringDeltas_SIMD(
+    float const * restrict xy,
+    ElementIndex const * pointAIndices,
+    ElementIndex const * pointBIndices,
+    float_vec<N> & outX,
+    float_vec<N> & outY)
+{
+    using fvec = float_vec<N>;
 
-        dynamicForceBuffer[endpointsBuffer[s + 0].PointAIndex] += tmpSpringForces[0];
-        dynamicForceBuffer[endpointsBuffer[s + 0].PointBIndex] -= tmpSpringForces[0];
-        dynamicForceBuffer[endpointsBuffer[s + 1].PointAIndex] += tmpSpringForces[1];
-        dynamicForceBuffer[endpointsBuffer[s + 1].PointBIndex] -= tmpSpringForces[1];
-        dynamicForceBuffer[endpointsBuffer[s + 2].PointAIndex] += tmpSpringForces[2];
-        dynamicForceBuffer[endpointsBuffer[s + 2].PointBIndex] -= tmpSpringForces[2];
-        dynamicForceBuffer[endpointsBuffer[s + 3].PointAIndex] += tmpSpringForces[3];
-        dynamicForceBuffer[endpointsBuffer[s + 3].PointBIndex] -= tmpSpringForces[3];
-    }
+    fvec pointAX, pointAY;
+    fvec::gather_xy(xy, pointAIndices, pointAX, pointAY);
+    fvec pointBX, pointBY;
+    fvec::gather_xy(xy, pointBIndices, pointBX, pointBY);
 
-    //
-    // 3. One-by-one
-    //
+    outX = pointBX - pointAX;
+    outY = pointBY - pointAY;
+}
 
-    for (; s < endSpringIndex; ++s)
-    {
-        auto const pointAIndex = endpointsBuffer[s].PointAIndex;
-        auto const pointBIndex = endpointsBuffer[s].PointBIndex;
+/*
+ * Sums the forces on the J, M, L, K points of N/4 perfect squares, given the forces on the
+ * A endpoints of their springs, and stores them as (x, y) pairs in the same order:
+ *  J: s0 + s2, M: s1 + s3, L: s0 + s3, K: s1 + s2
+ * The forces on L and K are then to be subtracted, as they're B endpoints.
+ */
+template<size_t N>
+static inline void StoreSquarePointForces_SIMD(
+    float_vec<N> const & forceAX,
+    float_vec<N> const & forceAY,
+    float * restrict xy)
+{
+    using fvec = float_vec<N>;
 
-        vec2f const displacement = positionBuffer[pointBIndex] - positionBuffer[pointAIndex];
-        float const displacementLength = displacement.length();
-        vec2f const springDir = displacement.normalise(displacementLength);
+    fvec::store_xy(
+        fvec::template shuffle4<0, 1, 0, 1>(forceAX) + fvec::template shuffle4<2, 3, 3, 2>(forceAX),
+        fvec::template shuffle4<0, 1, 0, 1>(forceAY) + fvec::template shuffle4<2, 3, 3, 2>(forceAY),
+        xy);
+}
 
-        //
-        // 1. Hooke's law
-        //
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
 
-        // Calculate spring force on point A
-        float const fSpring =
-            (displacementLength - restLengthBuffer[s])
-            * stiffnessCoefficientBuffer[s];
+//
+// At 4-wide we subtract and sum while points are still (x, y) pairs, and transpose only
+// once, saving the shuffles that the generic versions need - this is the hottest loop
+// of the simulation
+//
+
+template<>
+inline void GatherSquareSpringDeltas_SIMD<4>(
+    float const * restrict xy,
+    ElementIndex const * squarePointIndices,
+    float_vec<4> & outX,
+    float_vec<4> & outY)
+{
+    // XMM register notation:
+    //   low (left, or top) -> height (right, or bottom)
 
-        //
-        // 2. Damper forces
-        //
-        // Damp the velocities of each endpoint pair, as if the points were also connected by a damper
-        // along the same direction as the spring
-        //
+    __m128 const jm_xy = _mm_movelh_ps( // First argument goes low
+        float_vec<4>::load_pair(xy, squarePointIndices[0]),
+        float_vec<4>::load_pair(xy, squarePointIndices[1]));
+    __m128 lk_xy = _mm_movelh_ps( // First argument goes low
+        float_vec<4>::load_pair(xy, squarePointIndices[2]),
+        float_vec<4>::load_pair(xy, squarePointIndices[3]));
 
-        // Calculate damp force on point A
-        vec2f const relVelocity = velocityBuffer[pointBIndex] - velocityBuffer[pointAIndex];
-        float const fDamp =
-            relVelocity.dot(springDir)
-            * dampingCoefficientBuffer[s];
+    // s0_x, s0_y, s1_x, s1_y
+    __m128 const s0s1_xy = _mm_sub_ps(lk_xy, jm_xy);
 
-        //
-        // 3. Apply forces
-        //
+    // Swap 2H with 2L: s2_x, s2_y, s3_x, s3_y
+    lk_xy = _mm_shuffle_ps(lk_xy, lk_xy, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128 const s2s3_xy = _mm_sub_ps(lk_xy, jm_xy);
 
-        vec2f const forceA = springDir * (fSpring + fDamp);
-        dynamicForceBuffer[pointAIndex] += forceA;
-        dynamicForceBuffer[pointBIndex] -= forceA;
-    }
+    outX.v = _mm_shuffle_ps(s0s1_xy, s2s3_xy, _MM_SHUFFLE(2, 0, 2, 0));
+    outY.v = _mm_shuffle_ps(s0s1_xy, s2s3_xy, _MM_SHUFFLE(3, 1, 3, 1));
 }
 
-void Ship::IntegrateAndResetDynamicForces_N(
-    size_t parallelism,
-    ElementIndex startPointIndex,
-    ElementIndex endPointIndex,
-    GameParameters const & gameParameters)
+template<>
+inline void GatherSpringDeltas_SIMD<4>(
+    float const * restrict xy,
+    ElementIndex const * pointAIndices,
+    ElementIndex const * pointBIndices,
+    float_vec<4> & outX,
+    float_vec<4> & outY)
 {
-    // This implementation is for 4-float SSE
-    static_assert(vectorization_float_count<int> >= 4);
+    // s_x, s_y, *, *
+    __m128 const s0_xy = _mm_sub_ps(float_vec<4>::load_pair(xy, pointBIndices[0]), float_vec<4>::load_pair(xy, pointAIndices[0]));
+    __m128 const s1_xy = _mm_sub_ps(float_vec<4>::load_pair(xy, pointBIndices[1]), float_vec<4>::load_pair(xy, pointAIndices[1]));
+    __m128 const s2_xy = _mm_sub_ps(float_vec<4>::load_pair(xy, pointBIndices[2]), float_vec<4>::load_pair(xy, pointAIndices[2]));
+    __m128 const s3_xy = _mm_sub_ps(float_vec<4>::load_pair(xy, pointBIndices[3]), float_vec<4>::load_pair(xy, pointAIndices[3]));
 
-    float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
-    float const velocityFactor = CalculateIntegrationVelocityFactor(dt, gameParameters);
+    __m128 const s0s1_xy = _mm_movelh_ps(s0_xy, s1_xy); // First argument goes low
+    __m128 const s2s3_xy = _mm_movelh_ps(s2_xy, s3_xy); // First argument goes low
 
-    float * restrict const positionBuffer = mPoints.GetPositionBufferAsFloat();
-    float * restrict const velocityBuffer = mPoints.GetVelocityBufferAsFloat();
-    float const * const restrict staticForceBuffer = mPoints.GetStaticForceBufferAsFloat();
-    float const * const restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
-
-    float * const restrict * restrict const dynamicForceBufferOfBuffers = mPoints.GetDynamicForceBuffersAsFloat();
-
-    __m128 const zero_4 = _mm_setzero_ps();
-    __m128 const dt_4 = _mm_load1_ps(&dt);
-    __m128 const velocityFactor_4 = _mm_load1_ps(&velocityFactor);
-
-    for (size_t i = startPointIndex * 2; i < endPointIndex * 2; i += 4) // Two components per vector
-    {
-        __m128 springForce_2 = zero_4;
-        for (size_t b = 0; b < parallelism; ++b)
-        {
-            springForce_2 =
-                _mm_add_ps(
-                    springForce_2,
-                    _mm_load_ps(dynamicForceBufferOfBuffers[b] + i));
-        }
-
-        // vec2f const deltaPos =
-        //    velocityBuffer[i] * dt
-        //    + (springForceBuffer[i] + externalForceBuffer[i]) * integrationFactorBuffer[i];
-        __m128 const deltaPos_2 =
-            _mm_add_ps(
-                _mm_mul_ps(
-                    _mm_load_ps(velocityBuffer + i),
-                    dt_4),
-                _mm_mul_ps(
-                    _mm_add_ps(
-                        springForce_2,
-                        _mm_load_ps(staticForceBuffer + i)),
-                    _mm_load_ps(integrationFactorBuffer + i)));
+    outX.v = _mm_shuffle_ps(s0s1_xy, s2s3_xy, _MM_SHUFFLE(2, 0, 2, 0));
+    outY.v = _mm_shuffle_ps(s0s1_xy, s2s3_xy, _MM_SHUFFLE(3, 1, 3, 1));
+}
 
-        // positionBuffer[i] += deltaPos;
-        __m128 pos_2 = _mm_load_ps(positionBuffer + i);
-        pos_2 = _mm_add_ps(pos_2, deltaPos_2);
-        _mm_store_ps(positionBuffer + i, pos_2);
+template<>
+inline void StoreSquarePointForces_SIMD<4>(
+    float_vec<4> const & forceAX,
+    float_vec<4> const & forceAY,
+    float * restrict xy)
+{
+    __m128 const s0s1_xy = _mm_unpacklo_ps(forceAX.v, forceAY.v); // s0_x, s0_y, s1_x, s1_y
+    __m128 s2s3_xy = _mm_unpackhi_ps(forceAX.v, forceAY.v); // s2_x, s2_y, s3_x, s3_y
 
-        // velocityBuffer[i] = deltaPos * velocityFactor;
-        __m128 const vel_2 =
-            _mm_mul_ps(
-                deltaPos_2,
-                velocityFactor_4);
-        _mm_store_ps(velocityBuffer + i, vel_2);
+    __m128 const jm_xy = _mm_add_ps(s0s1_xy, s2s3_xy);
+    s2s3_xy = _mm_shuffle_ps(s2s3_xy, s2s3_xy, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128 const lk_xy = _mm_add_ps(s0s1_xy, s2s3_xy);
 
-        // Zero out spring forces now that we've integrated them
-        for (size_t b = 0; b < parallelism; ++b)
-        {
-            _mm_store_ps(dynamicForceBufferOfBuffers[b] + i, zero_4);
-        }
-    }
+    _mm_store_ps(xy, jm_xy);
+    _mm_store_ps(xy + 4, lk_xy);
 }
 
-#else
-
-///////////////////////////////////////////////////////////////
-// Architecture-agnostic
-///////////////////////////////////////////////////////////////
+#endif
 
-void Ship::ApplySpringsForces(
+/*
+ * Applies spring forces N springs at a time, leaving what's left to half the width
+ * and eventually to scalar code.
+ */
+template<size_t N>
+static void ApplySpringsForces_SIMD(
     ElementIndex startSpringIndex,
-    ElementIndex endSpringIndex,
+    ElementIndex endSpringIndex, // Excluded
+    ElementIndex endSpringIndexPerfectSquare, // Excluded
+    vec2f const * restrict positionBuffer,
+    vec2f const * restrict velocityBuffer,
+    Springs::Endpoints const * restrict endpointsBuffer,
+    float const * restrict restLengthBuffer,
+    float const * restrict stiffnessCoefficientBuffer,
+    float const * restrict dampingCoefficientBuffer,
     vec2f * restrict dynamicForceBuffer)
 {
-    static_assert(vectorization_float_count<int> >= 4);
+    using fvec = float_vec<N>;
 
-    vec2f const * restrict const positionBuffer = mPoints.GetPositionBufferAsVec2();
-    vec2f const * restrict const velocityBuffer = mPoints.GetVelocityBufferAsVec2();
+    static_assert((N % 4) == 0);
 
-    Springs::Endpoints const * restrict const endpointsBuffer = mSprings.GetEndpointsBuffer();
-    float const * restrict const restLengthBuffer = mSprings.GetRestLengthBuffer();
-    float const * restrict const stiffnessCoefficientBuffer = mSprings.GetStiffnessCoefficientBuffer();
-    float const * restrict const dampingCoefficientBuffer = mSprings.GetDampingCoefficientBuffer();
+    aligned_to_vword vec2f tmpSpringForces[N];
 
     ElementIndex s = startSpringIndex;
 
     //
-    // 1. Perfect squares
+    // 1. Perfect squares, N/4 at a time
     //
 
-    ElementCount const endSpringIndexPerfectSquare = std::min(endSpringIndex, mSprings.GetPerfectSquareCount() * 4);
-
-    for (; s < endSpringIndexPerfectSquare; s += 4)
+    for (; s + N <= endSpringIndexPerfectSquare; s += N)
     {
         //
         //    J          M   ---  a
@@ -865,197 +717,257 @@ void Ship::ApplySpringsForces(
         //    |/        \|
         //    K          L  ---  b
         //
-
+        // Each point is loaded once, as J, M, L, K in each group of four lanes; then:
         //
-        // Calculate displacements, string lengths, and spring directions
+        //  s0 = L - J
+        //  s1 = K - M
+        //  s2 = K - J
+        //  s3 = L - M
         //
 
-        ElementIndex const pointJIndex = endpointsBuffer[s + 0].PointAIndex;
-        ElementIndex const pointKIndex = endpointsBuffer[s + 1].PointBIndex;
-        ElementIndex const pointLIndex = endpointsBuffer[s + 0].PointBIndex;
-        ElementIndex const pointMIndex = endpointsBuffer[s + 1].PointAIndex;
-
-        assert(pointJIndex == endpointsBuffer[s + 2].PointAIndex);
-        assert(pointKIndex == endpointsBuffer[s + 2].PointBIndex);
-        assert(pointLIndex == endpointsBuffer[s + 3].PointBIndex);
-        assert(pointMIndex == endpointsBuffer[s + 3].PointAIndex);
-
-        vec2f const pointJPos = positionBuffer[pointJIndex];
-        vec2f const pointKPos = positionBuffer[pointKIndex];
-        vec2f const pointLPos = positionBuffer[pointLIndex];
-        vec2f const pointMPos = positionBuffer[pointMIndex];
-
-        vec2f const s0_dis = pointLPos - pointJPos;
-        vec2f const s1_dis = pointKPos - pointMPos;
-        vec2f const s2_dis = pointKPos - pointJPos;
-        vec2f const s3_dis = pointLPos - pointMPos;
-
-        float const s0_len = s0_dis.length();
-        float const s1_len = s1_dis.length();
-        float const s2_len = s2_dis.length();
-        float const s3_len = s3_dis.length();
-
-        vec2f const s0_dir = s0_dis.normalise(s0_len);
-        vec2f const s1_dir = s1_dis.normalise(s1_len);
-        vec2f const s2_dir = s2_dis.normalise(s2_len);
-        vec2f const s3_dir = s3_dis.normalise(s3_len);
-
-        //////////////////////////////////////////////////////////////////////////////////////////////
-
-        //
-        // 1. Hooke's law
-        //
+        ElementIndex squarePointIndices[N];
+        for (size_t q = 0; q < N; q += 4)
+        {
+            squarePointIndices[q + 0] = endpointsBuffer[s + q + 0].PointAIndex; // J
+            squarePointIndices[q + 1] = endpointsBuffer[s + q + 1].PointAIndex; // M
+            squarePointIndices[q + 2] = endpointsBuffer[s + q + 0].PointBIndex; // L
+            squarePointIndices[q + 3] = endpointsBuffer[s + q + 1].PointBIndex; // K
+
+            assert(squarePointIndices[q + 0] == endpointsBuffer[s + q + 2].PointAIndex);
+            assert(squarePointIndices[q + 1] == endpointsBuffer[s + q + 3].PointAIndex);
+            assert(squarePointIndices[q + 2] == endpointsBuffer[s + q + 3].PointBIndex);
+            assert(squarePointIndices[q + 3] == endpointsBuffer[s + q + 2].PointBIndex);
+        }
 
-        // Calculate springs' forces' moduli - for endpoint A:
-        //    (displacementLength[s] - restLength[s]) * stiffness[s]
-        //
-        // Strategy:
-        //
-        // ( springLength[s0] - restLength[s0] ) * stiffness[s0]
-        // ( springLength[s1] - restLength[s1] ) * stiffness[s1]
-        // ( springLength[s2] - restLength[s2] ) * stiffness[s2]
-        // ( springLength[s3] - restLength[s3] ) * stiffness[s3]
-        //
+        fvec displacementX, displacementY;
+        GatherSquareSpringDeltas_SIMD<N>(reinterpret_cast<float const *>(positionBuffer), squarePointIndices, displacementX, displacementY);
+        fvec relativeVelocityX, relativeVelocityY;
+        GatherSquareSpringDeltas_SIMD<N>(reinterpret_cast<float const *>(velocityBuffer), squarePointIndices, relativeVelocityX, relativeVelocityY);
 
-        float const s0_hookForceMag = (s0_len - restLengthBuffer[s]) * stiffnessCoefficientBuffer[s];
-        float const s1_hookForceMag = (s1_len - restLengthBuffer[s + 1]) * stiffnessCoefficientBuffer[s + 1];
-        float const s2_hookForceMag = (s2_len - restLengthBuffer[s + 2]) * stiffnessCoefficientBuffer[s + 2];
-        float const s3_hookForceMag = (s3_len - restLengthBuffer[s + 3]) * stiffnessCoefficientBuffer[s + 3];
+        fvec forceAX, forceAY;
+        CalculateSpringForces_SIMD<N>(
+            displacementX,
+            displacementY,
+            relativeVelocityX,
+            relativeVelocityY,
+            restLengthBuffer + s,
+            stiffnessCoefficientBuffer + s,
+            dampingCoefficientBuffer + s,
+            forceAX,
+            forceAY);
 
         //
-        // 2. Damper forces
-        //
-        // Damp the velocities of each endpoint pair, as if the points were also connected by a damper
-        // along the same direction as the spring, for endpoint A:
-        //      relVelocity.dot(springDir) * dampingCoeff[s]
+        // Sum forces by point, in the same J, M, L, K order:
         //
-
-        vec2f const pointJVel = velocityBuffer[pointJIndex];
-        vec2f const pointKVel = velocityBuffer[pointKIndex];
-        vec2f const pointLVel = velocityBuffer[pointLIndex];
-        vec2f const pointMVel = velocityBuffer[pointMIndex];
-
-        vec2f const s0_relVel = pointLVel - pointJVel;
-        vec2f const s1_relVel = pointKVel - pointMVel;
-        vec2f const s2_relVel = pointKVel - pointJVel;
-        vec2f const s3_relVel = pointLVel - pointMVel;
-
-        float const s0_dampForceMag = s0_relVel.dot(s0_dir) * dampingCoefficientBuffer[s];
-        float const s1_dampForceMag = s1_relVel.dot(s1_dir) * dampingCoefficientBuffer[s + 1];
-        float const s2_dampForceMag = s2_relVel.dot(s2_dir) * dampingCoefficientBuffer[s + 2];
-        float const s3_dampForceMag = s3_relVel.dot(s3_dir) * dampingCoefficientBuffer[s + 3];
-
-        //
-        // 3. Apply forces: 
-        //      force A = springDir * (hookeForce + dampingForce)
-        //      force B = - forceA
+        // j_sforce += s0_a_tforce + s2_a_tforce
+        // m_sforce += s1_a_tforce + s3_a_tforce
+        // l_sforce -= s0_a_tforce + s3_a_tforce
+        // k_sforce -= s1_a_tforce + s2_a_tforce
         //
 
-        vec2f const s0_forceA = s0_dir * (s0_hookForceMag + s0_dampForceMag);
-        vec2f const s1_forceA = s1_dir * (s1_hookForceMag + s1_dampForceMag);
-        vec2f const s2_forceA = s2_dir * (s2_hookForceMag + s2_dampForceMag);
-        vec2f const s3_forceA = s3_dir * (s3_hookForceMag + s3_dampForceMag);
+        StoreSquarePointForces_SIMD<N>(forceAX, forceAY, reinterpret_cast<float *>(tmpSpringForces));
 
-        dynamicForceBuffer[pointJIndex] += (s0_forceA + s2_forceA);
-        dynamicForceBuffer[pointLIndex] -= (s0_forceA + s3_forceA);
-        dynamicForceBuffer[pointMIndex] += (s1_forceA + s3_forceA);
-        dynamicForceBuffer[pointKIndex] -= (s1_forceA + s2_forceA);
+        for (size_t q = 0; q < N; q += 4)
+        {
+            dynamicForceBuffer[squarePointIndices[q + 0]] += tmpSpringForces[q + 0];
+            dynamicForceBuffer[squarePointIndices[q + 1]] += tmpSpringForces[q + 1];
+            dynamicForceBuffer[squarePointIndices[q + 2]] -= tmpSpringForces[q + 2];
+            dynamicForceBuffer[squarePointIndices[q + 3]] -= tmpSpringForces[q + 3];
+        }
     }
 
     //
-    // 2. Remaining one-by-one's
+    // 2. Remaining N-by-N's
     //
 
-    for (; s < endSpringIndex; ++s)
+    for (; s + N <= endSpringIndex; s += N)
     {
-        auto const pointAIndex = endpointsBuffer[s].PointAIndex;
-        auto const pointBIndex = endpointsBuffer[s].PointBIndex;
+        ElementIndex pointAIndices[N];
+        ElementIndex pointBIndices[N];
+        for (size_t i = 0; i < N; ++i)
+        {
+            pointAIndices[i] = endpointsBuffer[s + i].PointAIndex;
+            pointBIndices[i] = endpointsBuffer[s + i].PointBIndex;
+        }
 
-        vec2f const displacement = positionBuffer[pointBIndex] - positionBuffer[pointAIndex];
-        float const displacementLength = displacement.length();
-        vec2f const springDir = displacement.normalise(displacementLength);
+        fvec displacementX, displacementY;
+        GatherSpringDeltas_SIMD<N>(reinterpret_cast<float const *>(positionBuffer), pointAIndices, pointBIndices, displacementX, displacementY);
+        fvec relativeVelocityX, relativeVelocityY;
+        GatherSpringDeltas_SIMD<N>(reinterpret_cast<float const *>(velocityBuffer), pointAIndices, pointBIndices, relativeVelocityX, relativeVelocityY);
+
+        fvec forceAX, forceAY;
+        CalculateSpringForces_SIMD<N>(
+            displacementX,
+            displacementY,
+            relativeVelocityX,
+            relativeVelocityY,
+            restLengthBuffer + s,
+            stiffnessCoefficientBuffer + s,
+            dampingCoefficientBuffer + s,
+            forceAX,
+            forceAY);
+
+        fvec::store_xy(forceAX, forceAY, reinterpret_cast<float *>(tmpSpringForces));
 
         //
-        // 1. Hooke's law
+        // Add forces:
+        //      dynamicForceBuffer[pointAIndex] += total_forceA;
+        //      dynamicForceBuffer[pointBIndex] -= total_forceA;
         //
 
-        // Calculate spring force on point A
-        float const fSpring =
-            (displacementLength - restLengthBuffer[s])
-            * stiffnessCoefficientBuffer[s];
+        for (size_t i = 0; i < N; ++i)
+        {
+            dynamicForceBuffer[pointAIndices[i]] += tmpSpringForces[i];
+            dynamicForceBuffer[pointBIndices[i]] -= tmpSpringForces[i];
+        }
+    }
 
+    if constexpr (N > vectorization_float_count<size_t>)
+    {
         //
-        // 2. Damper forces
-        //
-        // Damp the velocities of each endpoint pair, as if the points were also connected by a damper
-        // along the same direction as the spring
+        // 3. Remainder at half the width
         //
 
-        // Calculate damp force on point A
-        vec2f const relVelocity = velocityBuffer[pointBIndex] - velocityBuffer[pointAIndex];
-        float const fDamp =
-            relVelocity.dot(springDir)
-            * dampingCoefficientBuffer[s];
-
+        if (s < endSpringIndex)
+        {
+            ApplySpringsForces_SIMD<N / 2>(
+                s,
+                endSpringIndex,
+                endSpringIndexPerfectSquare,
+                positionBuffer,
+                velocityBuffer,
+                endpointsBuffer,
+                restLengthBuffer,
+                stiffnessCoefficientBuffer,
+                dampingCoefficientBuffer,
+                dynamicForceBuffer);
+        }
+    }
+    else
+    {
         //
-        // 3. Apply forces
+        // 3. One-by-one
         //
 
-        vec2f const forceA = springDir * (fSpring + fDamp);
-        dynamicForceBuffer[pointAIndex] += forceA;
-        dynamicForceBuffer[pointBIndex] -= forceA;
+        for (; s < endSpringIndex; ++s)
+        {
+            auto const pointAIndex = endpointsBuffer[s].PointAIndex;
+            auto const pointBIndex = endpointsBuffer[s].PointBIndex;
+
+            vec2f const displacement = positionBuffer[pointBIndex] - positionBuffer[pointAIndex];
+            float const displacementLength = displacement.length();
+            vec2f const springDir = displacement.normalise(displacementLength);
+
+            //
+            // 1. Hooke's law
+            //
+
+            // Calculate spring force on point A
+            float const fSpring =
+                (displacementLength - restLengthBuffer[s])
+                * stiffnessCoefficientBuffer[s];
+
+            //
+            // 2. Damper forces
+            //
+            // Damp the velocities of each endpoint pair, as if the points were also connected by a damper
+            // along the same direction as the spring
+            //
+
+            // Calculate damp force on point A
+            vec2f const relVelocity = velocityBuffer[pointBIndex] - velocityBuffer[pointAIndex];
+            float const fDamp =
+                relVelocity.dot(springDir)
+                * dampingCoefficientBuffer[s];
+
+            //
+            // 3. Apply forces
+            //
+
+            vec2f const forceA = springDir * (fSpring + fDamp);
+            dynamicForceBuffer[pointAIndex] += forceA;
+            dynamicForceBuffer[pointBIndex] -= forceA;
+        }
     }
 }
 
+void Ship::ApplySpringsForces(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex, // Excluded
+    vec2f * restrict dynamicForceBuffer)
+{
+    ApplySpringsForces_SIMD<float_vec_native_width<size_t>>(
+        startSpringIndex,
+        endSpringIndex,
+        std::min(endSpringIndex, mSprings.GetPerfectSquareCount() * 4),
+        mPoints.GetPositionBufferAsVec2(),
+        mPoints.GetVelocityBufferAsVec2(),
+        mSprings.GetEndpointsBuffer(),
+        mSprings.GetRestLengthBuffer(),
+        mSprings.GetStiffnessCoefficientBuffer(),
+        mSprings.GetDampingCoefficientBuffer(),
+        dynamicForceBuffer);
+}
+
 void Ship::IntegrateAndResetDynamicForces_N(
     size_t parallelism,
     ElementIndex startPointIndex,
     ElementIndex endPointIndex,
     GameParameters const & gameParameters)
 {
-    // This non-SSE implementation works on a vec2f at a time
+    using fvec = float_vec<float_vec_native_width<size_t>>;
+
+    // Point ranges are multiples of the vectorization word, hence their components
+    // are multiples of twice that
+    static_assert(((2 * vectorization_float_count<size_t>) % fvec::width) == 0);
 
     float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
     float const velocityFactor = CalculateIntegrationVelocityFactor(dt, gameParameters);
 
-    vec2f * const restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
-    vec2f * const restrict velocityBuffer = mPoints.GetVelocityBufferAsVec2();
-    vec2f const * const restrict externalForceBuffer = mPoints.GetStaticForceBufferAsVec2();
-    vec2f const * const restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsVec2();
+    float * restrict const positionBuffer = mPoints.GetPositionBufferAsFloat();
+    float * restrict const velocityBuffer = mPoints.GetVelocityBufferAsFloat();
+    float const * const restrict staticForceBuffer = mPoints.GetStaticForceBufferAsFloat();
+    float const * const restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
 
-    vec2f * const restrict * restrict const dynamicForceBufferOfBuffers = mPoints.GetDynamicForceBuffersAsVec2();
+    float * const restrict * restrict const dynamicForceBufferOfBuffers = mPoints.GetDynamicForceBuffersAsFloat();
 
-    ///////////////////////
+    fvec const zero_N = fvec::zero();
+    fvec const dt_N = fvec::splat(dt);
+    fvec const velocityFactor_N = fvec::splat(velocityFactor);
 
-    for (size_t p = startPointIndex; p < endPointIndex; ++p)
+    for (size_t i = startPointIndex * 2; i < endPointIndex * 2; i += fvec::width) // Two components per vector
     {
-        vec2f springForce = vec2f::zero();
+        fvec springForce_N = zero_N;
         for (size_t b = 0; b < parallelism; ++b)
         {
-            springForce += dynamicForceBufferOfBuffers[b][p];
+            springForce_N = springForce_N + fvec::load(dynamicForceBufferOfBuffers[b] + i);
         }
 
         //
         // Verlet integration (fourth order, with velocity being first order)
         //
 
-        vec2f const deltaPos =
-            velocityBuffer[p] * dt
-            + (springForce + externalForceBuffer[p]) * integrationFactorBuffer[p];
+        // vec2f const deltaPos =
+        //    velocityBuffer[i] * dt
+        //    + (springForceBuffer[i] + externalForceBuffer[i]) * integrationFactorBuffer[i];
+        fvec const deltaPos_N =
+            fvec::load(velocityBuffer + i) * dt_N
+            + (springForce_N + fvec::load(staticForceBuffer + i)) * fvec::load(integrationFactorBuffer + i);
+
+        // positionBuffer[i] += deltaPos;
+        (fvec::load(positionBuffer + i) + deltaPos_N).store(positionBuffer + i);
 
-        positionBuffer[p] += deltaPos;
-        velocityBuffer[p] = deltaPos * velocityFactor;
+        // velocityBuffer[i] = deltaPos * velocityFactor;
+        (deltaPos_N * velocityFactor_N).store(velocityBuffer + i);
 
         // Zero out spring forces now that we've integrated them
         for (size_t b = 0; b < parallelism; ++b)
         {
-            dynamicForceBufferOfBuffers[b][p] = vec2f::zero();
+            zero_N.store(dynamicForceBufferOfBuffers[b] + i);
         }
     }
 }
 
-#endif
-
 float Ship::CalculateIntegrationVelocityFactor(
     float dt, 
     GameParameters const & gameParameters) const
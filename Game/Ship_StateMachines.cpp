@@ -7,8 +7,6 @@
 
 #include "Ship_StateMachines.h"
 
-#include <GameCore/GameRandomEngine.h>
-
 #include <cassert>
 
 namespace Physics {
@@ -55,98 +53,24 @@ bool Ship::UpdateExplosionStateMachine(
         //
         // Blast force and heat
         //
-        // Go through all points and, for each point in radius:
-        //  - Apply blast force
-        //  - Apply blast heat
-        // - Keep non-ephemeral point that is closest to blast position; we'll Detach() it later
-        //   (if this is the fist frame of the blast sequence)
+        // Queue a blast force field, which for each point in radius:
+        //  - Applies blast force
+        //  - Applies blast heat
+        //  - Keeps the point that is closest to blast position, which is
+        //    detached if this is the first frame of the blast sequence
         //
 
-        float const squareBlastRadius = blastRadius * blastRadius;
-
         // Q = q*dt
         float const blastHeat =
             explosionStateMachine.BlastHeat * 1000.0f // KJoule->Joule
             * GameParameters::SimulationStepTimeDuration<float>;
 
-        float closestPointSquareDistance = std::numeric_limits<float>::max();
-        ElementIndex closestPointIndex = NoneElementIndex;
-
-        // Visit all points
-        for (auto const pointIndex : mPoints)
-        {
-            vec2f const pointRadius = mPoints.GetPosition(pointIndex) - centerPosition;
-            float const squarePointDistance = pointRadius.squareLength();
-            if (squarePointDistance < squareBlastRadius)
-            {
-                float const pointRadiusLength = std::sqrt(squarePointDistance);
-
-                //
-                // Apply blast force
-                //
-                // (inversely proportional to square root of distance, not second power as one would expect though)
-                //
-
-                vec2f const blastDir = pointRadius.normalise_approx(pointRadiusLength);
-
-                mPoints.AddStaticForce(
-                    pointIndex,
-                    blastDir * explosionStateMachine.BlastForce / std::sqrt(std::max((pointRadiusLength * 0.3f) + 0.7f, 1.0f)));
-
-                //
-                // Inject heat at this point
-                //
-
-                // Calc temperature delta
-                // T = Q/HeatCapacity
-                float const deltaT =
-                    blastHeat
-                    / std::max(pointRadiusLength, 1.0f)
-                    * mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
-
-                // Increase temperature
-                mPoints.SetTemperature(
-                    pointIndex,
-                    mPoints.GetTemperature(pointIndex) + deltaT);
-
-                // Update water velocity
-                mPoints.SetWaterVelocity(
-                    pointIndex,
-                    mPoints.GetWaterVelocity(pointIndex) + blastDir * 100.0f * mPoints.GetWater(pointIndex)); // Magic number
-
-                //
-                // Check whether this point is the closest point
-                //
-
-                if (squarePointDistance < closestPointSquareDistance)
-                {
-                    closestPointSquareDistance = squarePointDistance;
-                    closestPointIndex = pointIndex;
-                }
-            }
-        }
-
-        //
-        // Eventually detach the closest point
-        //
-
-        if (blastProgress == 0.0f // First frame
-            && NoneElementIndex != closestPointIndex)
-        {
-            // Choose a detach velocity - using the same distribution as Debris
-            vec2f const detachVelocity = GameRandomEngine::GetInstance().GenerateUniformRadialVector(
-                GameParameters::MinDebrisParticlesVelocity,
-                GameParameters::MaxDebrisParticlesVelocity);
-
-            // Detach point
-            mPoints.Detach(
-                closestPointIndex,
-                detachVelocity,
-                Points::DetachOptions::GenerateDebris
-                | Points::DetachOptions::FireDestroyEvent,
-                currentSimulationTime,
-                gameParameters);
-        }
+        AddBlastForceField(
+            centerPosition,
+            blastRadius,
+            explosionStateMachine.BlastForce,
+            blastHeat,
+            blastProgress == 0.0f); // First frame
 
         //
         // Blast ocean surface displacement
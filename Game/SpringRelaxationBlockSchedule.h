@@ -0,0 +1,177 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-06
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*
+ * Schedule for running a spring relaxation iteration in a single, fused pass: springs
+ * are visited in blocks small enough to stay in cache, and after each block we integrate
+ * the points whose last spring has just been visited - i.e. the points that no later
+ * spring is going to touch - while their data is still in cache.
+ *
+ * Points are handed out as runs of contiguous indices, so that the integration kernels
+ * may still work on ranges; since springs and points are both laid out in spatial order,
+ * the runs are few and long.
+ *
+ * Points without springs (e.g. ephemeral particles) are integrated with the first block.
+ */
+class SpringRelaxationBlockSchedule
+{
+public:
+
+    struct PointRun
+    {
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex; // Excluded
+
+        PointRun(
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex)
+            : StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+        {}
+    };
+
+    struct Block
+    {
+        ElementIndex StartSpringIndex;
+        ElementIndex EndSpringIndex; // Excluded
+        size_t StartPointRunIndex;
+        size_t EndPointRunIndex; // Excluded
+
+        Block(
+            ElementIndex startSpringIndex,
+            ElementIndex endSpringIndex,
+            size_t startPointRunIndex,
+            size_t endPointRunIndex)
+            : StartSpringIndex(startSpringIndex)
+            , EndSpringIndex(endSpringIndex)
+            , StartPointRunIndex(startPointRunIndex)
+            , EndPointRunIndex(endPointRunIndex)
+        {}
+    };
+
+public:
+
+    SpringRelaxationBlockSchedule()
+        : mBlocks()
+        , mPointRuns()
+    {}
+
+    /*
+     * Block size is in springs; block boundaries are at multiples of the block size, so
+     * the block size should be a multiple of the vectorization word size.
+     */
+    template<typename TEndpoints>
+    static SpringRelaxationBlockSchedule Make(
+        TEndpoints const * springEndpoints,
+        ElementCount springCount,
+        ElementCount pointCount,
+        ElementCount blockSize)
+    {
+        assert(blockSize > 0);
+
+        SpringRelaxationBlockSchedule schedule;
+
+        if (springCount == 0 && pointCount == 0)
+        {
+            return schedule;
+        }
+
+        ElementCount const blockCount = std::max((springCount + blockSize - 1) / blockSize, ElementCount(1));
+
+        //
+        // Find the block of each point, i.e. the block of its last spring
+        //
+
+        std::vector<ElementCount> pointBlocks(pointCount, 0);
+        for (ElementIndex s = 0; s < springCount; ++s)
+        {
+            ElementCount const b = s / blockSize;
+
+            assert(springEndpoints[s].PointAIndex < pointCount);
+            pointBlocks[springEndpoints[s].PointAIndex] = b; // Springs are visited in order, hence the last one wins
+
+            assert(springEndpoints[s].PointBIndex < pointCount);
+            pointBlocks[springEndpoints[s].PointBIndex] = b;
+        }
+
+        //
+        // Make runs of contiguous points in the same block, and group them by block
+        //
+
+        std::vector<std::pair<ElementCount, PointRun>> runs;
+        for (ElementIndex p = 0; p < pointCount; ++p)
+        {
+            if (!runs.empty() && runs.back().first == pointBlocks[p] && runs.back().second.EndPointIndex == p)
+            {
+                ++(runs.back().second.EndPointIndex);
+            }
+            else
+            {
+                runs.emplace_back(pointBlocks[p], PointRun(p, p + 1));
+            }
+        }
+
+        std::stable_sort(
+            runs.begin(),
+            runs.end(),
+            [](auto const & l, auto const & r)
+            {
+                return l.first < r.first;
+            });
+
+        schedule.mPointRuns.reserve(runs.size());
+        schedule.mBlocks.reserve(blockCount);
+
+        auto runIt = runs.cbegin();
+        for (ElementCount b = 0; b < blockCount; ++b)
+        {
+            size_t const startPointRunIndex = schedule.mPointRuns.size();
+            for (; runIt != runs.cend() && runIt->first == b; ++runIt)
+            {
+                schedule.mPointRuns.emplace_back(runIt->second);
+            }
+
+            schedule.mBlocks.emplace_back(
+                b * blockSize,
+                std::min((b + 1) * blockSize, springCount),
+                startPointRunIndex,
+                schedule.mPointRuns.size());
+        }
+
+        assert(runIt == runs.cend());
+
+        return schedule;
+    }
+
+    bool IsEmpty() const
+    {
+        return mBlocks.empty();
+    }
+
+    std::vector<Block> const & GetBlocks() const
+    {
+        return mBlocks;
+    }
+
+    std::vector<PointRun> const & GetPointRuns() const
+    {
+        return mPointRuns;
+    }
+
+private:
+
+    std::vector<Block> mBlocks;
+    std::vector<PointRun> mPointRuns;
+};
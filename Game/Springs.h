@@ -313,14 +313,14 @@ public:
             return -1.0f;
     }
 
-    vec2f const & GetEndpointAPosition(
+    vec2f GetEndpointAPosition(
         ElementIndex springElementIndex,
         Points const & points) const
     {
         return points.GetPosition(mEndpointsBuffer[springElementIndex].PointAIndex);
     }
 
-    vec2f const & GetEndpointBPosition(
+    vec2f GetEndpointBPosition(
         ElementIndex springElementIndex,
         Points const & points) const
     {
@@ -0,0 +1,230 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2024-03-30
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TelemetrySink.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/Log.h>
+
+#include <cassert>
+#include <cinttypes>
+#include <cstdio>
+
+namespace /* anonymous */ {
+
+    // Increment when changing TelemetryFrame
+    std::uint32_t constexpr BinaryFormatVersion = 2;
+
+    size_t constexpr BinaryFrameByteSize =
+        2 * sizeof(std::uint64_t) // StepIndex, Timestamp
+        + 7 * sizeof(float) // SimulationTime, durations
+        + 7 * sizeof(std::uint32_t) // Counts
+        + 2 * sizeof(std::uint64_t); // Byte counts
+}
+
+TelemetrySink::TelemetrySink(
+    std::filesystem::path const & outputFilePath,
+    FormatType format,
+    std::chrono::milliseconds writeInterval)
+    : mFrames()
+    , mFormat(format)
+    , mWriteInterval(writeInterval)
+    , mStartTime(GameChronometer::now())
+    , mOutputFile()
+    , mBinaryBuffer(FrameRingCapacity * BinaryFrameByteSize)
+    , mCsvBuffer()
+    , mWriterThread()
+    , mWriterThreadLock()
+    , mWriterThreadSignal()
+    , mIsWriterThreadStop(false)
+{
+    mOutputFile.open(
+        outputFilePath,
+        std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    if (!mOutputFile.is_open())
+    {
+        throw GameException("Cannot open telemetry file \"" + outputFilePath.string() + "\"");
+    }
+
+    WriteHeader();
+
+    LogMessage("TelemetrySink: streaming to \"", outputFilePath.string(), "\"");
+
+    // Start writer thread
+    mWriterThread = std::thread(&TelemetrySink::WriterThreadLoop, this);
+}
+
+TelemetrySink::~TelemetrySink()
+{
+    // Tell writer thread to stop
+    {
+        std::lock_guard const lock{ mWriterThreadLock };
+
+        mIsWriterThreadStop = true;
+    }
+
+    mWriterThreadSignal.notify_one();
+
+    // Wait for writer thread to write the last frames and exit
+    mWriterThread.join();
+
+    if (mFrames.dropped_count() > 0)
+    {
+        LogMessage("TelemetrySink: dropped ", mFrames.dropped_count(), " frames");
+    }
+}
+
+void TelemetrySink::WriterThreadLoop()
+{
+    LogMessage("TelemetrySink::WriterThreadLoop(): started");
+
+    while (true)
+    {
+        bool isStop;
+
+        {
+            std::unique_lock lock{ mWriterThreadLock };
+
+            mWriterThreadSignal.wait_for(
+                lock,
+                mWriteInterval,
+                [this]()
+                {
+                    return mIsWriterThreadStop;
+                });
+
+            isStop = mIsWriterThreadStop;
+        }
+
+        //
+        // Write all the frames pushed since the last write
+        //
+
+        mBinaryBuffer.Reset();
+        mCsvBuffer.clear();
+
+        size_t const frameCount = mFrames.drain(
+            [this](TelemetryFrame const & frame)
+            {
+                WriteFrame(frame);
+            });
+
+        if (frameCount > 0)
+        {
+            if (mFormat == FormatType::Binary)
+            {
+                mOutputFile.write(reinterpret_cast<char const *>(mBinaryBuffer.GetData()), mBinaryBuffer.GetSize());
+            }
+            else
+            {
+                mOutputFile.write(mCsvBuffer.data(), mCsvBuffer.size());
+            }
+
+            mOutputFile.flush();
+
+            if (!mOutputFile.good())
+            {
+                // Most likely the reader of our pipe went away, or the disk is full;
+                // nothing we can do about it, and no reason to bring the game down
+                LogMessage("TelemetrySink::WriterThreadLoop(): error writing frames; stopping");
+                break;
+            }
+        }
+
+        if (isStop)
+        {
+            break;
+        }
+    }
+
+    LogMessage("TelemetrySink::WriterThreadLoop(): exiting");
+}
+
+void TelemetrySink::WriteHeader()
+{
+    if (mFormat == FormatType::Binary)
+    {
+        mBinaryBuffer.Reset();
+
+        mBinaryBuffer.Append(reinterpret_cast<unsigned char const *>("FSTM"), 4);
+        mBinaryBuffer.Append(BinaryFormatVersion);
+        mBinaryBuffer.Append(static_cast<std::uint32_t>(BinaryFrameByteSize));
+
+        mOutputFile.write(reinterpret_cast<char const *>(mBinaryBuffer.GetData()), mBinaryBuffer.GetSize());
+    }
+    else
+    {
+        mOutputFile << "StepIndex,Timestamp,SimulationTime,"
+            << "StepDuration,OceanSurfaceDuration,ShipsDuration,ShipsSpringsDuration,FishDuration,ThreadPoolIdleDuration,"
+            << "ShipCount,PointCount,SpringCount,BrokenSpringCount,TriangleCount,BrokenTriangleCount,EphemeralParticleCount,"
+            << "HeapBufferByteCount,HugePagesBufferByteCount"
+            << "\n";
+    }
+
+    mOutputFile.flush();
+}
+
+void TelemetrySink::WriteFrame(TelemetryFrame const & frame)
+{
+    if (mFormat == FormatType::Binary)
+    {
+        [[maybe_unused]] size_t const startSize = mBinaryBuffer.GetSize();
+
+        mBinaryBuffer.Append(frame.StepIndex);
+        mBinaryBuffer.Append(frame.Timestamp);
+        mBinaryBuffer.Append(frame.SimulationTime);
+
+        mBinaryBuffer.Append(frame.StepDuration);
+        mBinaryBuffer.Append(frame.OceanSurfaceDuration);
+        mBinaryBuffer.Append(frame.ShipsDuration);
+        mBinaryBuffer.Append(frame.ShipsSpringsDuration);
+        mBinaryBuffer.Append(frame.FishDuration);
+        mBinaryBuffer.Append(frame.ThreadPoolIdleDuration);
+
+        mBinaryBuffer.Append(frame.ShipCount);
+        mBinaryBuffer.Append(frame.PointCount);
+        mBinaryBuffer.Append(frame.SpringCount);
+        mBinaryBuffer.Append(frame.BrokenSpringCount);
+        mBinaryBuffer.Append(frame.TriangleCount);
+        mBinaryBuffer.Append(frame.BrokenTriangleCount);
+        mBinaryBuffer.Append(frame.EphemeralParticleCount);
+
+        mBinaryBuffer.Append(frame.HeapBufferByteCount);
+        mBinaryBuffer.Append(frame.HugePagesBufferByteCount);
+
+        assert(mBinaryBuffer.GetSize() - startSize == BinaryFrameByteSize);
+    }
+    else
+    {
+        char line[512];
+        int const lineLength = std::snprintf(
+            line,
+            sizeof(line),
+            "%" PRIu64 ",%" PRIu64 ",%.4f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu64 ",%" PRIu64 "\n",
+            frame.StepIndex,
+            frame.Timestamp,
+            frame.SimulationTime,
+            frame.StepDuration,
+            frame.OceanSurfaceDuration,
+            frame.ShipsDuration,
+            frame.ShipsSpringsDuration,
+            frame.FishDuration,
+            frame.ThreadPoolIdleDuration,
+            frame.ShipCount,
+            frame.PointCount,
+            frame.SpringCount,
+            frame.BrokenSpringCount,
+            frame.TriangleCount,
+            frame.BrokenTriangleCount,
+            frame.EphemeralParticleCount,
+            frame.HeapBufferByteCount,
+            frame.HugePagesBufferByteCount);
+
+        assert(lineLength > 0 && static_cast<size_t>(lineLength) < sizeof(line));
+
+        mCsvBuffer.append(line, static_cast<size_t>(lineLength));
+    }
+}
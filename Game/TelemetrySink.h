@@ -0,0 +1,132 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2024-03-30
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/DeSerializationBuffer.h>
+#include <GameCore/GameChronometer.h>
+#include <GameCore/SpscRingBuffer.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/*
+ * The counters sampled at each simulation step.
+ */
+struct TelemetryFrame
+{
+    std::uint64_t StepIndex;
+    std::uint64_t Timestamp; // Microseconds since telemetry started
+    float SimulationTime;
+
+    // Durations, in microseconds
+    float StepDuration;
+    float OceanSurfaceDuration;
+    float ShipsDuration; // Springs included
+    float ShipsSpringsDuration;
+    float FishDuration;
+    float ThreadPoolIdleDuration; // Summed over all threads of the pool
+
+    // Elements, over all ships
+    std::uint32_t ShipCount;
+    std::uint32_t PointCount;
+    std::uint32_t SpringCount;
+    std::uint32_t BrokenSpringCount;
+    std::uint32_t TriangleCount;
+    std::uint32_t BrokenTriangleCount;
+    std::uint32_t EphemeralParticleCount;
+
+    // Bytes held by buffers
+    std::uint64_t HeapBufferByteCount;
+    std::uint64_t HugePagesBufferByteCount;
+};
+
+/*
+ * Streams telemetry frames to a file, for monitoring long-running sessions
+ * without a profiler.
+ *
+ * Frames are pushed - lock-free - by the simulation at each step, and are written
+ * in batches by a thread of the sink, at regular intervals. On Unix the file may
+ * also be a named pipe, in which case constructing the sink waits for a reader
+ * to open the pipe.
+ */
+class TelemetrySink final
+{
+public:
+
+    enum class FormatType
+    {
+        // A header row with the names of the counters, then one row per frame
+        Csv,
+
+        // A header (magic, version, frame byte size), then frames of little-endian
+        // fields, in the order in which they appear in TelemetryFrame
+        Binary
+    };
+
+    TelemetrySink(
+        std::filesystem::path const & outputFilePath,
+        FormatType format,
+        std::chrono::milliseconds writeInterval = std::chrono::milliseconds(1000));
+
+    ~TelemetrySink();
+
+    /*
+     * Never blocks; the frame is dropped when the writer thread has fallen behind by more
+     * than the capacity of the ring.
+     */
+    inline void Push(TelemetryFrame const & frame)
+    {
+        mFrames.try_push(frame);
+    }
+
+    /*
+     * Gets the time from which frame timestamps are measured.
+     */
+    GameChronometer::time_point GetStartTime() const
+    {
+        return mStartTime;
+    }
+
+private:
+
+    void WriterThreadLoop();
+
+    void WriteHeader();
+
+    void WriteFrame(TelemetryFrame const & frame);
+
+private:
+
+    // About one minute of steps
+    static size_t constexpr FrameRingCapacity = 4096;
+
+    SpscRingBuffer<TelemetryFrame, FrameRingCapacity> mFrames;
+
+    FormatType const mFormat;
+    std::chrono::milliseconds const mWriteInterval;
+    GameChronometer::time_point const mStartTime;
+
+    std::ofstream mOutputFile;
+
+    // Members only to save allocations at each write
+    DeSerializationBuffer<LittleEndianess> mBinaryBuffer;
+    std::string mCsvBuffer;
+
+    //
+    // Writer thread
+    //
+
+    std::thread mWriterThread;
+    std::mutex mWriterThreadLock;
+    std::condition_variable mWriterThreadSignal;
+    bool mIsWriterThreadStop;
+};
@@ -109,6 +109,22 @@ size_t World::GetShipPointCount(ShipId shipId) const
     return mAllShips[shipId]->GetPointCount();
 }
 
+void World::PopulateTelemetryFrame(TelemetryFrame & frame) const
+{
+    frame.ShipCount = static_cast<std::uint32_t>(mAllShips.size());
+    frame.PointCount = 0;
+    frame.SpringCount = 0;
+    frame.BrokenSpringCount = 0;
+    frame.TriangleCount = 0;
+    frame.BrokenTriangleCount = 0;
+    frame.EphemeralParticleCount = 0;
+
+    for (auto const & ship : mAllShips)
+    {
+        ship->AccumulateTelemetry(frame);
+    }
+}
+
 bool World::IsUnderwater(ElementId elementId) const
 {
     auto const shipId = elementId.GetShipId();
@@ -1016,20 +1032,32 @@ void World::Update(
 
     mClouds.Update(mCurrentSimulationTime, mWind.GetBaseAndStormSpeedMagnitude(), mStorm.GetParameters(), gameParameters);
 
-    mOceanSurface.Update(mCurrentSimulationTime, mWind, gameParameters);
+    {
+        auto const startTime = std::chrono::steady_clock::now();
+
+        mOceanSurface.Update(mCurrentSimulationTime, mWind, gameParameters);
+
+        perfStats.TotalOceanSurfaceUpdateDuration.Update(std::chrono::steady_clock::now() - startTime);
+    }
 
     mOceanFloor.Update(gameParameters);
 
-    for (auto & ship : mAllShips)
     {
-        ship->Update(
-            mCurrentSimulationTime,
-            mStorm.GetParameters(),
-            gameParameters,
-            stressRenderMode,
-            mAllAABBs,
-            threadManager,
-            perfStats);
+        auto const startTime = std::chrono::steady_clock::now();
+
+        for (auto & ship : mAllShips)
+        {
+            ship->Update(
+                mCurrentSimulationTime,
+                mStorm.GetParameters(),
+                gameParameters,
+                stressRenderMode,
+                mAllAABBs,
+                threadManager,
+                perfStats);
+        }
+
+        perfStats.TotalShipsUpdateDuration.Update(std::chrono::steady_clock::now() - startTime);
     }
 
     {
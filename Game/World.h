@@ -15,6 +15,7 @@
 #include "RenderContext.h"
 #include "ResourceLocator.h"
 #include "ShipDefinition.h"
+#include "TelemetrySink.h"
 #include "VisibleWorld.h"
 
 #include <GameCore/AABBSet.h>
@@ -67,6 +68,11 @@ public:
 
     size_t GetShipPointCount(ShipId shipId) const;
 
+    /*
+     * Populates the element counts of the frame, over all ships.
+     */
+    void PopulateTelemetryFrame(TelemetryFrame & frame) const;
+
     Geometry::AABBSet GetAllAABBs() const
     {
         return mAllAABBs;
@@ -5,12 +5,14 @@
  ***************************************************************************************/
 #pragma once
 
+#include "FloatVec.h"
 #include "GameTypes.h"
 #include "SysSpecifics.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iterator>
 
 namespace Algorithms {
@@ -64,68 +66,72 @@ inline TVector NormalizeVector2_SSE(TVector const & v, float length) noexcept
 }
 #endif
 
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-template<typename EndpointStruct, typename TVector>
-inline void CalculateVectorDirsAndReciprocalLengths_SSE(
+/*
+ * Calculates the directions and the reciprocal lengths of the vectors between the
+ * endpoints of each element, N elements at a time.
+ */
+template<size_t N = float_vec_native_width<size_t>, typename EndpointStruct, typename TVector>
+inline void CalculateVectorDirsAndReciprocalLengths_SIMD(
     TVector const * pointPositions,
     EndpointStruct const * endpoints,
     TVector * restrict outDirs,
     float * restrict outReciprocalLengths,
     size_t const elementCount)
 {
-    assert((elementCount % 4) == 0); // Element counts are aligned
-
-    __m128 const Zero = _mm_setzero_ps();
-
-    for (size_t s = 0; s < elementCount; s += 4)
-    {
-        __m128 const vecA0 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositions + endpoints[s + 0].PointAIndex)));
-        __m128 const vecB0 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositions + endpoints[s + 0].PointBIndex)));
-        __m128 const vecD0 = _mm_sub_ps(vecB0, vecA0);
-
-        __m128 const vecA1 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositions + endpoints[s + 1].PointAIndex)));
-        __m128 const vecB1 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositions + endpoints[s + 1].PointBIndex)));
-        __m128 const vecD1 = _mm_sub_ps(vecB1, vecA1);
+    using fvec = float_vec<N>;
+    using TIndex = decltype(EndpointStruct::PointAIndex);
 
-        __m128 const vecD01 = _mm_movelh_ps(vecD0, vecD1); //x0,y0,x1,y1
-
-        __m128 const vecA2 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositions + endpoints[s + 2].PointAIndex)));
-        __m128 const vecB2 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositions + endpoints[s + 2].PointBIndex)));
-        __m128 const vecD2 = _mm_sub_ps(vecB2, vecA2);
-
-        __m128 const vecA3 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositions + endpoints[s + 3].PointAIndex)));
-        __m128 const vecB3 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositions + endpoints[s + 3].PointBIndex)));
-        __m128 const vecD3 = _mm_sub_ps(vecB3, vecA3);
+    assert((elementCount % 4) == 0); // Element counts are aligned
 
-        __m128 const vecD23 = _mm_movelh_ps(vecD2, vecD3); //x2,y2,x3,y3
+    fvec const zero = fvec::zero();
 
-        __m128 displacementX = _mm_shuffle_ps(vecD01, vecD23, 0x88); // x0,x1,x2,x3
-        __m128 displacementY = _mm_shuffle_ps(vecD01, vecD23, 0xDD); // y0,y1,y2,y3
+    size_t const vectorizedElementCount = elementCount - (elementCount % N);
 
-        __m128 const displacementX2 = _mm_mul_ps(displacementX, displacementX);
-        __m128 const displacementY2 = _mm_mul_ps(displacementY, displacementY);
+    for (size_t s = 0; s < vectorizedElementCount; s += N)
+    {
+        TIndex pointAIndices[N];
+        TIndex pointBIndices[N];
+        for (size_t i = 0; i < N; ++i)
+        {
+            pointAIndices[i] = endpoints[s + i].PointAIndex;
+            pointBIndices[i] = endpoints[s + i].PointBIndex;
+        }
 
-        __m128 const displacementXY = _mm_add_ps(displacementX2, displacementY2); // x^2 + y^2
+        fvec pointAPosX, pointAPosY;
+        fvec::gather_xy(reinterpret_cast<float const *>(pointPositions), pointAIndices, pointAPosX, pointAPosY);
+        fvec pointBPosX, pointBPosY;
+        fvec::gather_xy(reinterpret_cast<float const *>(pointPositions), pointBIndices, pointBPosX, pointBPosY);
 
-        __m128 const validMask = _mm_cmpneq_ps(displacementXY, Zero);
-        __m128 rspringLength = _mm_rsqrt_ps(displacementXY);
+        fvec const displacementX = pointBPosX - pointAPosX;
+        fvec const displacementY = pointBPosY - pointAPosY;
 
-        // L==0 => 1/L == 0, to maintain normal == (0, 0) from vec2f
-        rspringLength = _mm_and_ps(rspringLength, validMask);
+        fvec const displacementXY = displacementX * displacementX + displacementY * displacementY; // x^2 + y^2
 
-        displacementX = _mm_mul_ps(displacementX, rspringLength);
-        displacementY = _mm_mul_ps(displacementY, rspringLength);
+        // Zero-length vectors get zero reciprocal lengths, hence zero directions
+        fvec const rspringLength = rsqrt_approx(displacementXY) & neq_mask(displacementXY, zero);
 
-        _mm_store_ps(outReciprocalLengths + s, rspringLength);
+        rspringLength.store(outReciprocalLengths + s);
 
-        __m128 s01 = _mm_unpacklo_ps(displacementX, displacementY);
-        __m128 s23 = _mm_unpackhi_ps(displacementX, displacementY);
+        fvec::store_xy(
+            displacementX * rspringLength,
+            displacementY * rspringLength,
+            reinterpret_cast<float *>(outDirs + s));
+    }
 
-        _mm_store_ps(reinterpret_cast<float * restrict>(outDirs + s), s01);
-        _mm_store_ps(reinterpret_cast<float * restrict>(outDirs + s + 2), s23);
+    if constexpr (N > vectorization_float_count<size_t>)
+    {
+        // Remainder at half the width
+        if (vectorizedElementCount < elementCount)
+        {
+            CalculateVectorDirsAndReciprocalLengths_SIMD<N / 2>(
+                pointPositions,
+                endpoints + vectorizedElementCount,
+                outDirs + vectorizedElementCount,
+                outReciprocalLengths + vectorizedElementCount,
+                elementCount - vectorizedElementCount);
+        }
     }
 }
-#endif
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 // DiffuseLight
@@ -261,9 +267,8 @@ inline void DiffuseLight_Vectorized(
     }
 }
 
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-template<typename TVector>
-inline void DiffuseLight_SSEVectorized(
+template<size_t N = float_vec_native_width<size_t>, typename TVector>
+inline void DiffuseLight_SIMD(
     ElementIndex const pointStart,
     ElementIndex const pointEnd,
     TVector const * restrict pointPositions,
@@ -275,201 +280,81 @@ inline void DiffuseLight_SSEVectorized(
     ElementIndex const lampCount,
     float * restrict outLightBuffer) noexcept
 {
-    // This code is vectorized for SSE = 4 floats
-    static_assert(vectorization_float_count<size_t> >= 4);
+    using fvec = float_vec<N>;
+    using ivec = int_vec<N>;
+
     assert(is_aligned_to_float_element_count(pointStart));
     assert(is_aligned_to_float_element_count(pointEnd));
-    assert(is_aligned_to_float_element_count(lampCount));
     assert(is_aligned_to_vectorization_word(pointPositions));
     assert(is_aligned_to_vectorization_word(pointPlaneIds));
-    assert(is_aligned_to_vectorization_word(lampPositions));
-    assert(is_aligned_to_vectorization_word(lampPlaneIds));
-    assert(is_aligned_to_vectorization_word(lampDistanceCoeffs));
-    assert(is_aligned_to_vectorization_word(lampSpreadMaxDistances));
     assert(is_aligned_to_vectorization_word(outLightBuffer));
 
     // Caller is assumed to have skipped this when there are no lamps
     assert(lampCount > 0);
 
+    ElementIndex const vectorizedPointEnd = pointEnd - ((pointEnd - pointStart) % static_cast<ElementIndex>(N));
+
     //
-    // Visit all points in groups of 4
+    // Visit all points in groups of N
     //
 
-    for (ElementIndex p = pointStart; p < pointEnd; p += 4)
+    for (ElementIndex p = pointStart; p < vectorizedPointEnd; p += static_cast<ElementIndex>(N))
     {
-        //
-        // Prepare point data at slots 0,1,2,3
-        //
-
-        // Point positions
-        __m128 const pointPos01_4 = _mm_load_ps(reinterpret_cast<float const *>(pointPositions + p)); // x0,y0,x1,y1
-        __m128 const pointPos23_4 = _mm_load_ps(reinterpret_cast<float const *>(pointPositions + p + 2)); // x2,y2,x3,y3
-        __m128 pointPosX_4 = _mm_shuffle_ps(pointPos01_4, pointPos23_4, _MM_SHUFFLE(2, 0, 2, 0)); // x0,x1,x2,x3
-        __m128 pointPosY_4 = _mm_shuffle_ps(pointPos01_4, pointPos23_4, _MM_SHUFFLE(3, 1, 3, 1)); // y0,y1,y2,y3
+        fvec pointPosX, pointPosY;
+        fvec::load_xy(reinterpret_cast<float const *>(pointPositions + p), pointPosX, pointPosY);
 
-        // Point planes
-        __m128i pointPlaneId_4 = _mm_load_si128(reinterpret_cast<__m128i const *>(pointPlaneIds + p)); // 0,1,2,3
+        ivec const pointPlaneId = ivec::load(reinterpret_cast<std::int32_t const *>(pointPlaneIds + p));
 
-        // Resultant point light
-        __m128 pointLight_4 = _mm_setzero_ps();
+        fvec pointLight = fvec::zero();
 
         //
-        // Go through all lamps, 4 by 4;
+        // Go through all lamps, one at a time against all points of the group;
         // can safely visit deleted lamps as their current will always be zero
         //
 
-        for (ElementIndex l = 0; l < lampCount; l += 4)
+        for (ElementIndex l = 0; l < lampCount; ++l)
         {
-            // Lamp positions
-            __m128 const lampPos01_4 = _mm_load_ps(reinterpret_cast<float const *>(lampPositions + l)); // x0,y0,x1,y1
-            __m128 const lampPos23_4 = _mm_load_ps(reinterpret_cast<float const *>(lampPositions + l + 2)); // x2,y2,x3,y3
-            __m128 const lampPosX_4 = _mm_shuffle_ps(lampPos01_4, lampPos23_4, _MM_SHUFFLE(2, 0, 2, 0)); // x0,x1,x2,x3
-            __m128 const lampPosY_4 = _mm_shuffle_ps(lampPos01_4, lampPos23_4, _MM_SHUFFLE(3, 1, 3, 1)); // y0,y1,y2,y3
-
-            // Lamp planes
-            __m128i lampPlaneId_4 = _mm_load_si128(reinterpret_cast<__m128i const *>(lampPlaneIds + l)); // 0,1,2,3
-
-            // Coeffs
-            __m128 const lampDistanceCoeff_4 = _mm_load_ps(lampDistanceCoeffs + l);
-            __m128 const lampSpreadMaxDistance_4 = _mm_load_ps(lampSpreadMaxDistances + l);
-
-            //
-            // We now perform the following four times, each time rotating the 4 points around the four slots
-            // of their registers:
-            //  distance = pointPosition - lampPosition
-            //  newLight = lampDistanceCoeff * (lampSpreadMaxDistance - distance)
-            //  pointLight = max(newLight, pointLight) // Just max, to avoid having to normalize everything to 1.0
-
-            //
-            // 1 - 0,1,2,3
-            //
-
-            // Calculate distance
-            __m128 displacementX_4 = _mm_sub_ps(pointPosX_4, lampPosX_4);
-            __m128 displacementY_4 = _mm_sub_ps(pointPosY_4, lampPosY_4);
-            __m128 distanceSquare_4 = _mm_add_ps(
-                _mm_mul_ps(displacementX_4, displacementX_4),
-                _mm_mul_ps(displacementY_4, displacementY_4));
-            __m128 distance_4 = _mm_sqrt_ps(distanceSquare_4);
-
-            // Calculate new light
-            __m128 newLight_4 = _mm_mul_ps(
-                lampDistanceCoeff_4,
-                _mm_sub_ps(lampSpreadMaxDistance_4, distance_4));
-
-            // Mask with plane ID
-            __m128i invalidMask = _mm_cmpgt_epi32(pointPlaneId_4, lampPlaneId_4);
-            newLight_4 = _mm_andnot_ps(_mm_castsi128_ps(invalidMask), newLight_4);
-
-            // Point light
-            pointLight_4 = _mm_max_ps(pointLight_4, newLight_4);
-
-            // Rotate -> 1,2,3,0
-            pointPosX_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointPosX_4), _MM_SHUFFLE(0, 3, 2, 1)));
-            pointPosY_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointPosY_4), _MM_SHUFFLE(0, 3, 2, 1)));
-            pointPlaneId_4 = _mm_shuffle_epi32(pointPlaneId_4, _MM_SHUFFLE(0, 3, 2, 1));
-            pointLight_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointLight_4), _MM_SHUFFLE(0, 3, 2, 1)));
-
-            //
-            // 2 - 1,2,3,0
-            //
-
-            // Calculate distance
-            displacementX_4 = _mm_sub_ps(pointPosX_4, lampPosX_4);
-            displacementY_4 = _mm_sub_ps(pointPosY_4, lampPosY_4);
-            distanceSquare_4 = _mm_add_ps(
-                _mm_mul_ps(displacementX_4, displacementX_4),
-                _mm_mul_ps(displacementY_4, displacementY_4));
-            distance_4 = _mm_sqrt_ps(distanceSquare_4);
-
-            // Calculate new light
-            newLight_4 = _mm_mul_ps(
-                lampDistanceCoeff_4,
-                _mm_sub_ps(lampSpreadMaxDistance_4, distance_4));
-
-            // Mask with plane ID
-            invalidMask = _mm_cmpgt_epi32(pointPlaneId_4, lampPlaneId_4);
-            newLight_4 = _mm_andnot_ps(_mm_castsi128_ps(invalidMask), newLight_4);
-
-            // Point light
-            pointLight_4 = _mm_max_ps(pointLight_4, newLight_4);
-
-            // Rotate -> 2,3,0,1
-            pointPosX_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointPosX_4), _MM_SHUFFLE(0, 3, 2, 1)));
-            pointPosY_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointPosY_4), _MM_SHUFFLE(0, 3, 2, 1)));
-            pointPlaneId_4 = _mm_shuffle_epi32(pointPlaneId_4, _MM_SHUFFLE(0, 3, 2, 1));
-            pointLight_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointLight_4), _MM_SHUFFLE(0, 3, 2, 1)));
-
-            //
-            // 3 - 2,3,0,1
-            //
-
-            // Calculate distance
-            displacementX_4 = _mm_sub_ps(pointPosX_4, lampPosX_4);
-            displacementY_4 = _mm_sub_ps(pointPosY_4, lampPosY_4);
-            distanceSquare_4 = _mm_add_ps(
-                _mm_mul_ps(displacementX_4, displacementX_4),
-                _mm_mul_ps(displacementY_4, displacementY_4));
-            distance_4 = _mm_sqrt_ps(distanceSquare_4);
-
-            // Calculate new light
-            newLight_4 = _mm_mul_ps(
-                lampDistanceCoeff_4,
-                _mm_sub_ps(lampSpreadMaxDistance_4, distance_4));
-
-            // Mask with plane ID
-            invalidMask = _mm_cmpgt_epi32(pointPlaneId_4, lampPlaneId_4);
-            newLight_4 = _mm_andnot_ps(_mm_castsi128_ps(invalidMask), newLight_4);
-
-            // Point light
-            pointLight_4 = _mm_max_ps(pointLight_4, newLight_4);
-
-            // Rotate -> 3,0,1,2
-            pointPosX_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointPosX_4), _MM_SHUFFLE(0, 3, 2, 1)));
-            pointPosY_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointPosY_4), _MM_SHUFFLE(0, 3, 2, 1)));
-            pointPlaneId_4 = _mm_shuffle_epi32(pointPlaneId_4, _MM_SHUFFLE(0, 3, 2, 1));
-            pointLight_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointLight_4), _MM_SHUFFLE(0, 3, 2, 1)));
-
-            //
-            // 4 - 3,0,1,2
-            //
-
-            // Calculate distance
-            displacementX_4 = _mm_sub_ps(pointPosX_4, lampPosX_4);
-            displacementY_4 = _mm_sub_ps(pointPosY_4, lampPosY_4);
-            distanceSquare_4 = _mm_add_ps(
-                _mm_mul_ps(displacementX_4, displacementX_4),
-                _mm_mul_ps(displacementY_4, displacementY_4));
-            distance_4 = _mm_sqrt_ps(distanceSquare_4);
-
-            // Calculate new light
-            newLight_4 = _mm_mul_ps(
-                lampDistanceCoeff_4,
-                _mm_sub_ps(lampSpreadMaxDistance_4, distance_4));
-
-            // Mask with plane ID
-            invalidMask = _mm_cmpgt_epi32(pointPlaneId_4, lampPlaneId_4);
-            newLight_4 = _mm_andnot_ps(_mm_castsi128_ps(invalidMask), newLight_4);
-
-            // Point light
-            pointLight_4 = _mm_max_ps(pointLight_4, newLight_4);
-
-            // Rotate -> 0,1,2,3
-            pointPosX_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointPosX_4), _MM_SHUFFLE(0, 3, 2, 1)));
-            pointPosY_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointPosY_4), _MM_SHUFFLE(0, 3, 2, 1)));
-            pointPlaneId_4 = _mm_shuffle_epi32(pointPlaneId_4, _MM_SHUFFLE(0, 3, 2, 1));
-            pointLight_4 = _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(pointLight_4), _MM_SHUFFLE(0, 3, 2, 1)));
+            fvec const displacementX = pointPosX - fvec::splat(lampPositions[l].x);
+            fvec const displacementY = pointPosY - fvec::splat(lampPositions[l].y);
+            fvec const distance = sqrt(displacementX * displacementX + displacementY * displacementY);
+
+            // Light from this lamp = max(0.0, lum*(spread-distance)/spread)
+            fvec newLight =
+                fvec::splat(lampDistanceCoeffs[l])
+                * (fvec::splat(lampSpreadMaxDistances[l]) - distance); // If negative, max(.) below will clamp down to 0.0
+
+            // Obey plane ID constraints
+            newLight = andnot(
+                greater_mask(pointPlaneId, ivec::splat(static_cast<std::int32_t>(lampPlaneIds[l]))),
+                newLight);
+
+            // Point's light is just max, to avoid having to normalize everything to 1.0
+            pointLight = max(pointLight, newLight);
         }
 
-        //
-        // Store the 4 point lights, capping them to 1.0
-        //
+        // Cap light to 1.0
+        min(pointLight, fvec::splat(1.0f)).store(outLightBuffer + p);
+    }
 
-        pointLight_4 = _mm_min_ps(pointLight_4, _mm_set1_ps(1.0f));
-        _mm_store_ps(outLightBuffer + p, pointLight_4);
+    if constexpr (N > vectorization_float_count<size_t>)
+    {
+        // Remainder at half the width
+        if (vectorizedPointEnd < pointEnd)
+        {
+            DiffuseLight_SIMD<N / 2>(
+                vectorizedPointEnd,
+                pointEnd,
+                pointPositions,
+                pointPlaneIds,
+                lampPositions,
+                lampPlaneIds,
+                lampDistanceCoeffs,
+                lampSpreadMaxDistances,
+                lampCount,
+                outLightBuffer);
+        }
     }
 }
-#endif
 
 /*
  * Diffuse light from each lamp to all points on the same or lower plane ID,
@@ -488,8 +373,7 @@ inline void DiffuseLight(
     ElementIndex const lampCount,
     float * restrict outLightBuffer) noexcept
 {
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-    DiffuseLight_SSEVectorized(
+    DiffuseLight_SIMD(
         pointStart,
         pointEnd,
         pointPositions,
@@ -500,19 +384,6 @@ inline void DiffuseLight(
         lampSpreadMaxDistances,
         lampCount,
         outLightBuffer);
-#else
-    DiffuseLight_Vectorized(
-        pointStart,
-        pointEnd,
-        pointPositions,
-        pointPlaneIds,
-        lampPositions,
-        lampPlaneIds,
-        lampDistanceCoeffs,
-        lampSpreadMaxDistances,
-        lampCount,
-        outLightBuffer);
-#endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -549,56 +420,42 @@ inline void SmoothBufferAndAdd_Naive(
     }
 }
 
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-template<size_t BufferSize, size_t SmoothingSize>
-inline void SmoothBufferAndAdd_SSEVectorized(
+template<size_t BufferSize, size_t SmoothingSize, size_t N = float_vec_native_width<size_t>>
+inline void SmoothBufferAndAdd_SIMD(
     float const * restrict inBuffer,
     float * restrict outBuffer) noexcept
 {
-    // This code is vectorized for SSE = 4 floats
-    static_assert(vectorization_float_count<size_t> >= 4);
-    static_assert(is_aligned_to_float_element_count(BufferSize));
+    using fvec = float_vec<N>;
+
+    static_assert((BufferSize % N) == 0);
     static_assert((SmoothingSize % 2) == 1);
     assert(is_aligned_to_vectorization_word(inBuffer));
     assert(is_aligned_to_vectorization_word(outBuffer));
 
-    __m128 const centralWeight = _mm_set_ps1(static_cast<float>((SmoothingSize / 2) + 1));
-    __m128 const scaling = _mm_set_ps1(
+    fvec const centralWeight = fvec::splat(static_cast<float>((SmoothingSize / 2) + 1));
+    fvec const scaling = fvec::splat(
         (1.0f / static_cast<float>(SmoothingSize))
         * (1.0f / static_cast<float>(SmoothingSize)));
 
-    for (size_t i = 0; i < BufferSize; i += 4)
+    for (size_t i = 0; i < BufferSize; i += N)
     {
         // Central sample
-        __m128 accumulatedHeight = _mm_mul_ps(
-            _mm_load_ps(inBuffer + i),
-            centralWeight);
+        fvec accumulatedHeight = fvec::load(inBuffer + i) * centralWeight;
 
         // Lateral samples; l is offset from central
         for (size_t l = 1; l <= SmoothingSize / 2; ++l)
         {
-            __m128 const lateralWeight = _mm_set_ps1(static_cast<float>((SmoothingSize / 2) + 1 - l));
-
-            accumulatedHeight = _mm_add_ps(
-                accumulatedHeight,
-                _mm_mul_ps(
-                    _mm_add_ps(
-                        _mm_loadu_ps(inBuffer + i - l),
-                        _mm_loadu_ps(inBuffer + i + l)),
-                    lateralWeight));
+            fvec const lateralWeight = fvec::splat(static_cast<float>((SmoothingSize / 2) + 1 - l));
+
+            accumulatedHeight =
+                accumulatedHeight
+                + (fvec::loadu(inBuffer + i - l) + fvec::loadu(inBuffer + i + l)) * lateralWeight;
         }
 
         // Update output
-        _mm_store_ps(
-            outBuffer + i,
-            _mm_add_ps(
-                _mm_load_ps(outBuffer + i),
-                _mm_mul_ps(
-                    accumulatedHeight,
-                    scaling)));
+        (fvec::load(outBuffer + i) + accumulatedHeight * scaling).store(outBuffer + i);
     }
 }
-#endif
 
 /*
  * Calculates a two-pass average on a window of width SmoothingSize,
@@ -611,11 +468,14 @@ inline void SmoothBufferAndAdd(
     float const * restrict inBuffer,
     float * restrict outBuffer) noexcept
 {
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-    SmoothBufferAndAdd_SSEVectorized<BufferSize, SmoothingSize>(inBuffer, outBuffer);
-#else
-    SmoothBufferAndAdd_Naive<BufferSize, SmoothingSize>(inBuffer, outBuffer);
-#endif
+    static_assert(is_aligned_to_float_element_count(BufferSize));
+
+    // Go as wide as the buffer allows
+    constexpr size_t Width = (BufferSize % float_vec_native_width<size_t>) == 0
+        ? float_vec_native_width<size_t>
+        : vectorization_float_count<size_t>;
+
+    SmoothBufferAndAdd_SIMD<BufferSize, SmoothingSize, Width>(inBuffer, outBuffer);
 }
 
 }
\ No newline at end of file
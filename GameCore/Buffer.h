@@ -22,6 +22,10 @@
  *
  * The buffer is mem-aligned so that if TElement is float,
  * then the buffer is aligned to the vectorization number of floats.
+ *
+ * Each buffer may be allocated with its own allocation policy; note that
+ * a buffer constructed without a fill value is left untouched, so that
+ * its pages may be first touched by the threads that will work on them.
  */
 template <typename TElement>
 class Buffer final
@@ -36,7 +40,14 @@ public:
 public:
 
     explicit Buffer(size_t size)
-        : mBuffer(make_unique_buffer_aligned_to_vectorization_word<TElement>(size))
+        : Buffer(size, BufferAllocationPolicy::Default)
+    {
+    }
+
+    Buffer(
+        size_t size,
+        BufferAllocationPolicy allocationPolicy)
+        : mBuffer(make_unique_buffer_aligned_to_vectorization_word<TElement>(size, allocationPolicy))
         , mSize(size)
         , mCurrentPopulatedSize(0)
     {
@@ -45,8 +56,9 @@ public:
     Buffer(
         size_t size,
         size_t fillStart,
-        TElement fillValue)
-        : Buffer(size)
+        TElement fillValue,
+        BufferAllocationPolicy allocationPolicy = BufferAllocationPolicy::Default)
+        : Buffer(size, allocationPolicy)
     {
         assert(fillStart <= mSize);
 
@@ -71,8 +83,9 @@ public:
 
     Buffer(
         size_t size,
-        TElement fillValue)
-        : Buffer(size)
+        TElement fillValue,
+        BufferAllocationPolicy allocationPolicy = BufferAllocationPolicy::Default)
+        : Buffer(size, allocationPolicy)
     {
         // Fill-in values
         fill(fillValue);
@@ -133,6 +146,23 @@ public:
         mCurrentPopulatedSize = mSize;
     }
 
+    /*
+     * Fills a range of the buffer with a value, without changing the
+     * currently-populated size; useful to first-touch the pages of each
+     * partition of the buffer from the thread that works on it.
+     */
+    inline void fill(
+        size_t start,
+        size_t end,
+        TElement value)
+    {
+        assert(start <= end && end <= mSize);
+
+        TElement * restrict const ptr = mBuffer.get();
+        for (size_t i = start; i < end; ++i)
+            ptr[i] = value;
+    }
+
     /*
      * Fills the buffer with a value.
      * This overload is when the caller has the buffer size at compile time;
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "GameTypes.h"
+#include "SysSpecifics.h"
 
 #include <algorithm>
 #include <memory>
@@ -332,22 +333,33 @@ private:
     template<bool H, bool V>
     void Flip()
     {
-        int const xMax = (H && !V) ? Size.width / 2 : Size.width;
-        int const yMax = V ? Size.height / 2 : Size.height;
+        TElement * const data = Data.get();
+        size_t const width = static_cast<size_t>(Size.width);
+        size_t const height = static_cast<size_t>(Size.height);
 
-        for (int y = 0; y < yMax; ++y)
+        if constexpr (H && V)
         {
-            for (int x = 0; x < xMax; ++x)
+            // Flipping both ways is the same as reversing the whole buffer
+            std::reverse(data, data + mLinearSize);
+        }
+        else if constexpr (H)
+        {
+            for (size_t y = 0; y < height; ++y)
             {
-                auto const srcCoords = coordinates_type(x, y);
-
-                auto dstCoords = srcCoords;
-                if constexpr (H)
-                    dstCoords = dstCoords.FlipX(Size.width);
-                if constexpr (V)
-                    dstCoords = dstCoords.FlipY(Size.height);
+                std::reverse(data + y * width, data + (y + 1) * width);
+            }
+        }
+        else
+        {
+            static_assert(V);
 
-                std::swap(this->operator[](srcCoords), this->operator[](dstCoords));
+            // Swap whole rows
+            for (size_t y = 0; y < height / 2; ++y)
+            {
+                std::swap_ranges(
+                    data + y * width,
+                    data + (y + 1) * width,
+                    data + (height - 1 - y) * width);
             }
         }
     }
@@ -359,13 +371,48 @@ private:
 
         auto newData = std::make_unique<TElement[]>(mLinearSize);
 
-        for (int srcY = 0; srcY < Size.height; ++srcY)
+        //
+        // Rotate in square blocks, so that both the source columns being read
+        // and the target rows being written stay in cache
+        //
+
+        int constexpr BlockSize = 32;
+
+        TElement const * const restrict srcData = Data.get();
+        TElement * const restrict dstData = newData.get();
+
+        for (int srcYBlock = 0; srcYBlock < Size.height; srcYBlock += BlockSize)
         {
-            int const srcYOffset = srcY * Size.width;
-            for (int srcX = 0; srcX < Size.width; ++srcX)
+            int const srcYBlockEnd = std::min(srcYBlock + BlockSize, Size.height);
+
+            for (int srcXBlock = 0; srcXBlock < Size.width; srcXBlock += BlockSize)
             {
-                auto const dstCoords = coordinates_type(srcX, srcY).template Rotate90<TDirection>(Size);
-                newData[dstCoords.y * newSize.width + dstCoords.x] = Data[srcYOffset + srcX];
+                int const srcXBlockEnd = std::min(srcXBlock + BlockSize, Size.width);
+
+                // Each source column becomes a target row
+                for (int srcX = srcXBlock; srcX < srcXBlockEnd; ++srcX)
+                {
+                    if constexpr (TDirection == RotationDirectionType::Clockwise)
+                    {
+                        // (x, y) -> (y, width - 1 - x)
+                        TElement * const dstRow = dstData + static_cast<size_t>(Size.width - 1 - srcX) * newSize.width;
+                        for (int srcY = srcYBlock; srcY < srcYBlockEnd; ++srcY)
+                        {
+                            dstRow[srcY] = srcData[static_cast<size_t>(srcY) * Size.width + srcX];
+                        }
+                    }
+                    else
+                    {
+                        static_assert(TDirection == RotationDirectionType::CounterClockwise);
+
+                        // (x, y) -> (height - 1 - y, x)
+                        TElement * const dstRow = dstData + static_cast<size_t>(srcX) * newSize.width + (Size.height - 1);
+                        for (int srcY = srcYBlock; srcY < srcYBlockEnd; ++srcY)
+                        {
+                            *(dstRow - srcY) = srcData[static_cast<size_t>(srcY) * Size.width + srcX];
+                        }
+                    }
+                }
             }
         }
 
@@ -7,6 +7,7 @@
 
 #include "Buffer.h"
 
+#include <array>
 #include <cassert>
 #include <memory>
 #include <mutex>
@@ -19,53 +20,69 @@ public:
 
     BufferAllocator(size_t bufferSize)
         : mBufferSize(bufferSize)
-        , mPool()
+        , mPools()
         , mLock()
     {
     }
 
     BufferAllocator(BufferAllocator && other) noexcept
         : mBufferSize(other.mBufferSize)
-        , mPool(std::move(other.mPool))
+        , mPools(std::move(other.mPools))
         , mLock() // We make our own, new lock - assuming we're not moving synchronization state here
     {
     }
 
-    std::shared_ptr<Buffer<TElement>> Allocate()
+    /*
+     * Buffers are only reused for allocations with the same policy.
+     */
+    std::shared_ptr<Buffer<TElement>> Allocate(BufferAllocationPolicy allocationPolicy = BufferAllocationPolicy::Default)
     {
         Buffer<TElement> * buffer;
 
-        if (std::lock_guard lock{ mLock }; !mPool.empty())
+        if (std::lock_guard lock{ mLock }; !GetPool(allocationPolicy).empty())
         {
-            buffer = mPool.back().release();
-            mPool.pop_back();
+            auto & pool = GetPool(allocationPolicy);
+            buffer = pool.back().release();
+            pool.pop_back();
         }
         else
         {
-            buffer = new Buffer<TElement>(mBufferSize);
+            buffer = new Buffer<TElement>(mBufferSize, allocationPolicy);
         }
 
         assert(nullptr != buffer);
 
         return std::shared_ptr<Buffer<TElement>>(
             buffer,
-            [this](auto p)
+            [this, allocationPolicy](auto p)
             {
-                this->Release(p);
+                this->Release(p, allocationPolicy);
             });
     }
 
 private:
 
-    void Release(Buffer<TElement> * buffer)
+    using Pool = std::vector<std::unique_ptr<Buffer<TElement>>>;
+
+    Pool & GetPool(BufferAllocationPolicy allocationPolicy)
+    {
+        assert(static_cast<size_t>(allocationPolicy) < mPools.size());
+        return mPools[static_cast<size_t>(allocationPolicy)];
+    }
+
+    void Release(
+        Buffer<TElement> * buffer,
+        BufferAllocationPolicy allocationPolicy)
     {
         std::lock_guard lock{ mLock };
 
-        mPool.push_back(std::unique_ptr<Buffer<TElement>>(buffer));
+        GetPool(allocationPolicy).push_back(std::unique_ptr<Buffer<TElement>>(buffer));
     }
 
     size_t const mBufferSize;
-    std::vector<std::unique_ptr<Buffer<TElement>>> mPool;
+
+    // One pool per allocation policy
+    std::array<Pool, static_cast<size_t>(BufferAllocationPolicy::HugePages) + 1> mPools;
 
     // The mutex guarding concurrency-sensitive operations
     std::mutex mLock;
@@ -52,6 +52,11 @@ struct IFileSystem
      */
     virtual std::vector<std::filesystem::path> ListFiles(std::filesystem::path const & directoryPath) = 0;
 
+    /*
+     * Returns paths of all sub-directories in the specified directory.
+     */
+    virtual std::vector<std::filesystem::path> ListDirectories(std::filesystem::path const & directoryPath) = 0;
+
     /*
      * Deletes a file.
      */
@@ -159,6 +164,45 @@ public:
         return filePaths;
     }
 
+    virtual std::vector<std::filesystem::path> ListDirectories(std::filesystem::path const & directoryPath) override
+    {
+        std::vector<std::filesystem::path> directoryPaths;
+
+        // Be robust to users messing up
+        if (std::filesystem::exists(directoryPath)
+            && std::filesystem::is_directory(directoryPath))
+        {
+            auto directoryIterator = std::filesystem::directory_iterator(
+                directoryPath,
+                std::filesystem::directory_options::skip_permission_denied);
+
+            for (auto const & entryIt : directoryIterator)
+            {
+                try
+                {
+                    auto const entryPath = entryIt.path();
+
+                    if (std::filesystem::is_directory(entryPath))
+                    {
+                        // Make sure the name may be converted to the local codepage
+                        std::string _ = entryPath.filename().string();
+                        (void)_;
+
+                        directoryPaths.push_back(entryPath);
+                    }
+                }
+                catch (std::exception const & ex)
+                {
+                    LogMessage("Ignoring a directory entry due to error: ", ex.what());
+
+                    // Ignore this entry
+                }
+            }
+        }
+
+        return directoryPaths;
+    }
+
     virtual void DeleteFile(std::filesystem::path const & filePath) override
     {
         std::filesystem::remove(filePath);
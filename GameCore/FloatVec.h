@@ -0,0 +1,570 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-29
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "SysSpecifics.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * A pack of N floats, operated upon lane-wise, so that a vectorized kernel may be
+ * written once and compiled to any width.
+ *
+ * Backends:
+ *  - float_vec<4>: SSE, on x86
+ *  - float_vec<8>: AVX2, when the compiler targets it
+ *  - Everything else: plain arrays of floats, which the compiler is then free to
+ *    vectorize as it sees fit
+ *
+ * Masks - as returned by comparisons - are packs whose lanes have either all bits set
+ * or all bits cleared, and are applied with bitwise and's.
+ *
+ * Aligned loads and stores only require pointers to be aligned to the vectorization word,
+ * regardless of N; wider backends thus use unaligned instructions, which cost nothing
+ * extra on aligned addresses.
+ */
+template<size_t N>
+struct float_vec;
+
+/*
+ * A pack of N 32-bit integers - just as much as it takes to compare integers
+ * in float_vec kernels.
+ */
+template<size_t N>
+struct int_vec;
+
+/*
+ * The width of the widest float_vec with a native backend; kernels
+ * default to this width.
+ */
+template<typename T>
+static constexpr T float_vec_native_width = FS_IS_INSTRUCTION_SET_AVX2() ? 8 : 4;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Scalar
+////////////////////////////////////////////////////////////////////////////////////////
+
+namespace float_vec_detail {
+
+inline float bitwise_and(float a, float b) noexcept
+{
+    std::uint32_t ai, bi;
+    std::memcpy(&ai, &a, sizeof(float));
+    std::memcpy(&bi, &b, sizeof(float));
+    std::uint32_t const ri = ai & bi;
+    float r;
+    std::memcpy(&r, &ri, sizeof(float));
+    return r;
+}
+
+inline float bitwise_andnot(float a, float b) noexcept
+{
+    std::uint32_t ai, bi;
+    std::memcpy(&ai, &a, sizeof(float));
+    std::memcpy(&bi, &b, sizeof(float));
+    std::uint32_t const ri = ~ai & bi;
+    float r;
+    std::memcpy(&r, &ri, sizeof(float));
+    return r;
+}
+
+inline float mask(bool value) noexcept
+{
+    std::uint32_t const ri = value ? 0xffffffffu : 0u;
+    float r;
+    std::memcpy(&r, &ri, sizeof(float));
+    return r;
+}
+
+}
+
+template<size_t N>
+struct float_vec
+{
+    static_assert(N > 0);
+
+    static constexpr size_t width = N;
+
+    float lanes[N];
+
+    static float_vec zero() noexcept
+    {
+        return splat(0.0f);
+    }
+
+    static float_vec splat(float value) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = value;
+        return r;
+    }
+
+    static float_vec load(float const * ptr) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        return loadu(ptr);
+    }
+
+    static float_vec loadu(float const * ptr) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = ptr[i];
+        return r;
+    }
+
+    void store(float * ptr) const noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        for (size_t i = 0; i < N; ++i)
+            ptr[i] = lanes[i];
+    }
+
+    // Loads N consecutive (x, y) pairs, de-interleaving them
+    static void load_xy(float const * xy, float_vec & x, float_vec & y) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(xy));
+        for (size_t i = 0; i < N; ++i)
+        {
+            x.lanes[i] = xy[i * 2];
+            y.lanes[i] = xy[i * 2 + 1];
+        }
+    }
+
+    // Loads the N (x, y) pairs at the specified pair indices, de-interleaving them
+    template<typename TIndex>
+    static void gather_xy(float const * xy, TIndex const * indices, float_vec & x, float_vec & y) noexcept
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            x.lanes[i] = xy[static_cast<size_t>(indices[i]) * 2];
+            y.lanes[i] = xy[static_cast<size_t>(indices[i]) * 2 + 1];
+        }
+    }
+
+    // Stores N (x, y) pairs, interleaving them
+    static void store_xy(float_vec const & x, float_vec const & y, float * xy) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(xy));
+        for (size_t i = 0; i < N; ++i)
+        {
+            xy[i * 2] = x.lanes[i];
+            xy[i * 2 + 1] = y.lanes[i];
+        }
+    }
+
+    // Rearranges the lanes of each group of four lanes: lane k of each group
+    // gets lane Ik of the same group
+    template<size_t I0, size_t I1, size_t I2, size_t I3>
+    static float_vec shuffle4(float_vec const & a) noexcept
+    {
+        static_assert((N % 4) == 0);
+        static_assert(I0 < 4 && I1 < 4 && I2 < 4 && I3 < 4);
+
+        float_vec r;
+        for (size_t g = 0; g < N; g += 4)
+        {
+            r.lanes[g + 0] = a.lanes[g + I0];
+            r.lanes[g + 1] = a.lanes[g + I1];
+            r.lanes[g + 2] = a.lanes[g + I2];
+            r.lanes[g + 3] = a.lanes[g + I3];
+        }
+        return r;
+    }
+
+    friend float_vec operator+(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = a.lanes[i] + b.lanes[i];
+        return r;
+    }
+
+    friend float_vec operator-(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = a.lanes[i] - b.lanes[i];
+        return r;
+    }
+
+    friend float_vec operator*(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = a.lanes[i] * b.lanes[i];
+        return r;
+    }
+
+    friend float_vec operator/(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = a.lanes[i] / b.lanes[i];
+        return r;
+    }
+
+    friend float_vec operator&(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = float_vec_detail::bitwise_and(a.lanes[i], b.lanes[i]);
+        return r;
+    }
+
+    // ~mask & b
+    friend float_vec andnot(float_vec const & mask, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = float_vec_detail::bitwise_andnot(mask.lanes[i], b.lanes[i]);
+        return r;
+    }
+
+    friend float_vec neq_mask(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = float_vec_detail::mask(a.lanes[i] != b.lanes[i]);
+        return r;
+    }
+
+    friend float_vec le_mask(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = float_vec_detail::mask(a.lanes[i] <= b.lanes[i]);
+        return r;
+    }
+
+    friend float_vec min(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = a.lanes[i] < b.lanes[i] ? a.lanes[i] : b.lanes[i];
+        return r;
+    }
+
+    friend float_vec max(float_vec const & a, float_vec const & b) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = a.lanes[i] > b.lanes[i] ? a.lanes[i] : b.lanes[i];
+        return r;
+    }
+
+    friend float_vec sqrt(float_vec const & a) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = std::sqrt(a.lanes[i]);
+        return r;
+    }
+
+    // Exact here; other backends only guarantee ~12 bits of precision
+    friend float_vec rsqrt_approx(float_vec const & a) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = 1.0f / std::sqrt(a.lanes[i]);
+        return r;
+    }
+
+    // Exact here; other backends only guarantee ~12 bits of precision
+    friend float_vec rcp_approx(float_vec const & a) noexcept
+    {
+        float_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = 1.0f / a.lanes[i];
+        return r;
+    }
+};
+
+template<size_t N>
+struct int_vec
+{
+    static_assert(N > 0);
+
+    std::int32_t lanes[N];
+
+    static int_vec splat(std::int32_t value) noexcept
+    {
+        int_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = value;
+        return r;
+    }
+
+    static int_vec load(std::int32_t const * ptr) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        int_vec r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = ptr[i];
+        return r;
+    }
+
+    friend float_vec<N> greater_mask(int_vec const & a, int_vec const & b) noexcept
+    {
+        float_vec<N> r;
+        for (size_t i = 0; i < N; ++i)
+            r.lanes[i] = float_vec_detail::mask(a.lanes[i] > b.lanes[i]);
+        return r;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// SSE
+////////////////////////////////////////////////////////////////////////////////////////
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+template<>
+struct float_vec<4>
+{
+    static constexpr size_t width = 4;
+
+    __m128 v;
+
+    static float_vec zero() noexcept
+    {
+        return { _mm_setzero_ps() };
+    }
+
+    static float_vec splat(float value) noexcept
+    {
+        return { _mm_set1_ps(value) };
+    }
+
+    static float_vec load(float const * ptr) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        return { _mm_load_ps(ptr) };
+    }
+
+    static float_vec loadu(float const * ptr) noexcept
+    {
+        return { _mm_loadu_ps(ptr) };
+    }
+
+    void store(float * ptr) const noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        _mm_store_ps(ptr, v);
+    }
+
+    static void load_xy(float const * xy, float_vec & x, float_vec & y) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(xy));
+        __m128 const xy01 = _mm_load_ps(xy); // x0,y0,x1,y1
+        __m128 const xy23 = _mm_load_ps(xy + 4); // x2,y2,x3,y3
+        x.v = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(2, 0, 2, 0)); // x0,x1,x2,x3
+        y.v = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 1, 3, 1)); // y0,y1,y2,y3
+    }
+
+    template<typename TIndex>
+    static void gather_xy(float const * xy, TIndex const * indices, float_vec & x, float_vec & y) noexcept
+    {
+        __m128 const xy01 = _mm_movelh_ps(load_pair(xy, indices[0]), load_pair(xy, indices[1])); // x0,y0,x1,y1
+        __m128 const xy23 = _mm_movelh_ps(load_pair(xy, indices[2]), load_pair(xy, indices[3])); // x2,y2,x3,y3
+        x.v = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(2, 0, 2, 0)); // x0,x1,x2,x3
+        y.v = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 1, 3, 1)); // y0,y1,y2,y3
+    }
+
+    static void store_xy(float_vec const & x, float_vec const & y, float * xy) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(xy));
+        _mm_store_ps(xy, _mm_unpacklo_ps(x.v, y.v)); // x0,y0,x1,y1
+        _mm_store_ps(xy + 4, _mm_unpackhi_ps(x.v, y.v)); // x2,y2,x3,y3
+    }
+
+    template<size_t I0, size_t I1, size_t I2, size_t I3>
+    static float_vec shuffle4(float_vec const & a) noexcept
+    {
+        static_assert(I0 < 4 && I1 < 4 && I2 < 4 && I3 < 4);
+        return { _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(I3, I2, I1, I0)) };
+    }
+
+    // x,y,*,*
+    template<typename TIndex>
+    static __m128 load_pair(float const * xy, TIndex index) noexcept
+    {
+        return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const *>(xy + static_cast<size_t>(index) * 2)));
+    }
+
+    friend float_vec operator+(float_vec const & a, float_vec const & b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+    friend float_vec operator-(float_vec const & a, float_vec const & b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+    friend float_vec operator*(float_vec const & a, float_vec const & b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+    friend float_vec operator/(float_vec const & a, float_vec const & b) noexcept { return { _mm_div_ps(a.v, b.v) }; }
+    friend float_vec operator&(float_vec const & a, float_vec const & b) noexcept { return { _mm_and_ps(a.v, b.v) }; }
+    friend float_vec andnot(float_vec const & mask, float_vec const & b) noexcept { return { _mm_andnot_ps(mask.v, b.v) }; }
+    friend float_vec neq_mask(float_vec const & a, float_vec const & b) noexcept { return { _mm_cmpneq_ps(a.v, b.v) }; }
+    friend float_vec le_mask(float_vec const & a, float_vec const & b) noexcept { return { _mm_cmple_ps(a.v, b.v) }; }
+    friend float_vec min(float_vec const & a, float_vec const & b) noexcept { return { _mm_min_ps(a.v, b.v) }; }
+    friend float_vec max(float_vec const & a, float_vec const & b) noexcept { return { _mm_max_ps(a.v, b.v) }; }
+    friend float_vec sqrt(float_vec const & a) noexcept { return { _mm_sqrt_ps(a.v) }; }
+    friend float_vec rsqrt_approx(float_vec const & a) noexcept { return { _mm_rsqrt_ps(a.v) }; }
+    friend float_vec rcp_approx(float_vec const & a) noexcept { return { _mm_rcp_ps(a.v) }; }
+};
+
+template<>
+struct int_vec<4>
+{
+    __m128i v;
+
+    static int_vec splat(std::int32_t value) noexcept
+    {
+        return { _mm_set1_epi32(value) };
+    }
+
+    static int_vec load(std::int32_t const * ptr) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        return { _mm_load_si128(reinterpret_cast<__m128i const *>(ptr)) };
+    }
+
+    friend float_vec<4> greater_mask(int_vec const & a, int_vec const & b) noexcept
+    {
+        return { _mm_castsi128_ps(_mm_cmpgt_epi32(a.v, b.v)) };
+    }
+};
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// AVX2
+////////////////////////////////////////////////////////////////////////////////////////
+
+#if FS_IS_INSTRUCTION_SET_AVX2()
+
+template<>
+struct float_vec<8>
+{
+    static constexpr size_t width = 8;
+
+    __m256 v;
+
+    static float_vec zero() noexcept
+    {
+        return { _mm256_setzero_ps() };
+    }
+
+    static float_vec splat(float value) noexcept
+    {
+        return { _mm256_set1_ps(value) };
+    }
+
+    static float_vec load(float const * ptr) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        return { _mm256_loadu_ps(ptr) };
+    }
+
+    static float_vec loadu(float const * ptr) noexcept
+    {
+        return { _mm256_loadu_ps(ptr) };
+    }
+
+    void store(float * ptr) const noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        _mm256_storeu_ps(ptr, v);
+    }
+
+    static void load_xy(float const * xy, float_vec & x, float_vec & y) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(xy));
+        __m256 const xy0123 = _mm256_loadu_ps(xy);
+        __m256 const xy4567 = _mm256_loadu_ps(xy + 8);
+        deinterleave(
+            _mm256_permute2f128_ps(xy0123, xy4567, 0x20), // xy0,xy1 | xy4,xy5
+            _mm256_permute2f128_ps(xy0123, xy4567, 0x31), // xy2,xy3 | xy6,xy7
+            x,
+            y);
+    }
+
+    template<typename TIndex>
+    static void gather_xy(float const * xy, TIndex const * indices, float_vec & x, float_vec & y) noexcept
+    {
+        __m128 const xy01 = _mm_movelh_ps(float_vec<4>::load_pair(xy, indices[0]), float_vec<4>::load_pair(xy, indices[1]));
+        __m128 const xy23 = _mm_movelh_ps(float_vec<4>::load_pair(xy, indices[2]), float_vec<4>::load_pair(xy, indices[3]));
+        __m128 const xy45 = _mm_movelh_ps(float_vec<4>::load_pair(xy, indices[4]), float_vec<4>::load_pair(xy, indices[5]));
+        __m128 const xy67 = _mm_movelh_ps(float_vec<4>::load_pair(xy, indices[6]), float_vec<4>::load_pair(xy, indices[7]));
+        deinterleave(
+            _mm256_insertf128_ps(_mm256_castps128_ps256(xy01), xy45, 1),
+            _mm256_insertf128_ps(_mm256_castps128_ps256(xy23), xy67, 1),
+            x,
+            y);
+    }
+
+    static void store_xy(float_vec const & x, float_vec const & y, float * xy) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(xy));
+        __m256 const xy01_45 = _mm256_unpacklo_ps(x.v, y.v);
+        __m256 const xy23_67 = _mm256_unpackhi_ps(x.v, y.v);
+        _mm256_storeu_ps(xy, _mm256_permute2f128_ps(xy01_45, xy23_67, 0x20));
+        _mm256_storeu_ps(xy + 8, _mm256_permute2f128_ps(xy01_45, xy23_67, 0x31));
+    }
+
+    template<size_t I0, size_t I1, size_t I2, size_t I3>
+    static float_vec shuffle4(float_vec const & a) noexcept
+    {
+        static_assert(I0 < 4 && I1 < 4 && I2 < 4 && I3 < 4);
+        return { _mm256_permute_ps(a.v, _MM_SHUFFLE(I3, I2, I1, I0)) }; // Within each 128-bit lane
+    }
+
+    friend float_vec operator+(float_vec const & a, float_vec const & b) noexcept { return { _mm256_add_ps(a.v, b.v) }; }
+    friend float_vec operator-(float_vec const & a, float_vec const & b) noexcept { return { _mm256_sub_ps(a.v, b.v) }; }
+    friend float_vec operator*(float_vec const & a, float_vec const & b) noexcept { return { _mm256_mul_ps(a.v, b.v) }; }
+    friend float_vec operator/(float_vec const & a, float_vec const & b) noexcept { return { _mm256_div_ps(a.v, b.v) }; }
+    friend float_vec operator&(float_vec const & a, float_vec const & b) noexcept { return { _mm256_and_ps(a.v, b.v) }; }
+    friend float_vec andnot(float_vec const & mask, float_vec const & b) noexcept { return { _mm256_andnot_ps(mask.v, b.v) }; }
+    friend float_vec neq_mask(float_vec const & a, float_vec const & b) noexcept { return { _mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ) }; }
+    friend float_vec le_mask(float_vec const & a, float_vec const & b) noexcept { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+    friend float_vec min(float_vec const & a, float_vec const & b) noexcept { return { _mm256_min_ps(a.v, b.v) }; }
+    friend float_vec max(float_vec const & a, float_vec const & b) noexcept { return { _mm256_max_ps(a.v, b.v) }; }
+    friend float_vec sqrt(float_vec const & a) noexcept { return { _mm256_sqrt_ps(a.v) }; }
+    friend float_vec rsqrt_approx(float_vec const & a) noexcept { return { _mm256_rsqrt_ps(a.v) }; }
+    friend float_vec rcp_approx(float_vec const & a) noexcept { return { _mm256_rcp_ps(a.v) }; }
+
+private:
+
+    // Lane-wise: (xy0,xy1 | xy4,xy5), (xy2,xy3 | xy6,xy7) -> (x0..x7), (y0..y7)
+    static void deinterleave(__m256 xy01_45, __m256 xy23_67, float_vec & x, float_vec & y) noexcept
+    {
+        x.v = _mm256_shuffle_ps(xy01_45, xy23_67, _MM_SHUFFLE(2, 0, 2, 0));
+        y.v = _mm256_shuffle_ps(xy01_45, xy23_67, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+};
+
+template<>
+struct int_vec<8>
+{
+    __m256i v;
+
+    static int_vec splat(std::int32_t value) noexcept
+    {
+        return { _mm256_set1_epi32(value) };
+    }
+
+    static int_vec load(std::int32_t const * ptr) noexcept
+    {
+        assert(is_aligned_to_vectorization_word(ptr));
+        return { _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr)) };
+    }
+
+    friend float_vec<8> greater_mask(int_vec const & a, int_vec const & b) noexcept
+    {
+        return { _mm256_castsi256_ps(_mm256_cmpgt_epi32(a.v, b.v)) };
+    }
+};
+
+#endif
@@ -8,6 +8,9 @@
 #include "GameMath.h"
 #include "Vectors.h"
 
+#include <cassert>
+#include <cstdint>
+#include <limits>
 #include <random>
 
 /*
@@ -16,19 +19,44 @@
  * Not so random - always uses the same seed. On purpose! We want two instances
  * of the game to be identical to each other.
  *
- * Singleton.
+ * Singleton, shared by all threads - hence its consumers must not run concurrently.
+ * A thread working apart from the simulation - e.g. loading a ship in the background -
+ * may instead use an engine of its own, via a ThreadEngine, so that it neither races
+ * with the simulation nor perturbs its sequence.
  */
 class GameRandomEngine
 {
+public:
+
+    /*
+     * Makes the thread constructing it use an engine of its own, with the specified
+     * seed, for as long as it lives; to be destroyed on the same thread.
+     */
+    class ThreadEngine;
+
 public:
 
     static GameRandomEngine & GetInstance()
     {
+        GameRandomEngine * const threadEngine = GetThreadEngine();
+        if (threadEngine != nullptr)
+        {
+            return *threadEngine;
+        }
+
         static GameRandomEngine * instance = new GameRandomEngine();
 
         return *instance;
     }
 
+    /*
+     * Returns a seed for a ThreadEngine.
+     */
+    inline std::uint32_t GenerateSeed()
+    {
+        return GenerateUniformInteger<std::uint32_t>(0, std::numeric_limits<std::uint32_t>::max());
+    }
+
     /*
      * Returns a value between 0 and count - 1, included.
      */
@@ -166,7 +194,49 @@ private:
         mNormalDistribution = std::normal_distribution<float>(0.0f, 1.0f);
     }
 
+    explicit GameRandomEngine(std::uint32_t seed)
+    {
+        std::seed_seq seed_seq({ std::uint32_t(1), std::uint32_t(242), std::uint32_t(19730528), seed });
+        mRandomEngine = std::ranlux48_base(seed_seq);
+        mRandomUniformDistribution = std::uniform_real_distribution<float>(0.0f, 1.0f);
+        mNormalDistribution = std::normal_distribution<float>(0.0f, 1.0f);
+    }
+
+    // The engine of the calling thread, if it has one of its own
+    static GameRandomEngine *& GetThreadEngine()
+    {
+        static thread_local GameRandomEngine * threadEngine = nullptr;
+
+        return threadEngine;
+    }
+
     std::ranlux48_base mRandomEngine;
     std::uniform_real_distribution<float> mRandomUniformDistribution;
     std::normal_distribution<float> mNormalDistribution;
 };
+
+class GameRandomEngine::ThreadEngine final
+{
+public:
+
+    explicit ThreadEngine(std::uint32_t seed)
+        : mEngine(seed)
+        , mPreviousThreadEngine(GetThreadEngine())
+    {
+        GetThreadEngine() = &mEngine;
+    }
+
+    ~ThreadEngine()
+    {
+        assert(GetThreadEngine() == &mEngine);
+        GetThreadEngine() = mPreviousThreadEngine;
+    }
+
+    ThreadEngine(ThreadEngine const & other) = delete;
+    ThreadEngine & operator=(ThreadEngine const & other) = delete;
+
+private:
+
+    GameRandomEngine mEngine;
+    GameRandomEngine * const mPreviousThreadEngine;
+};
@@ -5,15 +5,270 @@
 ***************************************************************************************/
 #include "ImageTools.h"
 
+#include "SysSpecifics.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace /*anonymous*/ {
+
+    //
+    // Exact division by 255 of x in [0, 65535], with no overflow in 16 bits for x <= 65280
+    //
+
+    inline std::uint32_t Div255(std::uint32_t x)
+    {
+        return (x + 1 + (x >> 8)) >> 8;
+    }
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+    inline __m128i Div255_Epu16(__m128i x)
+    {
+        return _mm_srli_epi16(
+            _mm_add_epi16(
+                _mm_add_epi16(x, _mm_set1_epi16(1)),
+                _mm_srli_epi16(x, 8)),
+            8);
+    }
+
+    // Broadcasts the alpha of each of the two pixels in the 16-bit lanes onto all of the pixel's lanes
+    inline __m128i BroadcastAlpha_Epu16(__m128i x)
+    {
+        return _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    inline __m128i Select(
+        __m128i mask,
+        __m128i a,
+        __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+#endif
+
+    //
+    // Bilinear resampling
+    //
+
+    struct BilinearSample
+    {
+        int Index0;
+        int Index1;
+        int Weight1; // In 1/256ths; the weight of Index0 is the complement to 256
+    };
+
+    // Samples each target pixel at its center, in fixed point so that results do not depend
+    // on floating point code generation
+    std::vector<BilinearSample> MakeBilinearSamples(
+        int sourceSize,
+        int targetSize)
+    {
+        assert(sourceSize > 0 && targetSize > 0);
+
+        std::vector<BilinearSample> samples;
+        samples.reserve(targetSize);
+
+        for (int t = 0; t < targetSize; ++t)
+        {
+            // Center of the target pixel in source space, in 1/256ths of source pixels
+            std::int64_t const s =
+                (static_cast<std::int64_t>(2 * t + 1) * sourceSize * 256) / (2 * static_cast<std::int64_t>(targetSize))
+                - 128;
+
+            int index0 = 0;
+            int weight1 = 0;
+            if (s > 0)
+            {
+                index0 = static_cast<int>(s >> 8);
+                weight1 = static_cast<int>(s & 0xff);
+                if (index0 >= sourceSize - 1)
+                {
+                    index0 = sourceSize - 1;
+                    weight1 = 0;
+                }
+            }
+
+            samples.push_back({
+                index0,
+                std::min(index0 + 1, sourceSize - 1),
+                weight1 });
+        }
+
+        return samples;
+    }
+
+    // Blends two rows of bytes
+    void LerpRows(
+        std::uint8_t const * restrict row0,
+        std::uint8_t const * restrict row1,
+        int weight1,
+        std::uint8_t * restrict outRow,
+        size_t byteCount)
+    {
+        if (weight1 == 0)
+        {
+            std::memcpy(outRow, row0, byteCount);
+            return;
+        }
+
+        size_t i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+        __m128i const w0 = _mm_set1_epi16(static_cast<short>(256 - weight1));
+        __m128i const w1 = _mm_set1_epi16(static_cast<short>(weight1));
+        __m128i const half = _mm_set1_epi16(128);
+        __m128i const zero = _mm_setzero_si128();
+
+        for (; i + 16 <= byteCount; i += 16)
+        {
+            __m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row0 + i));
+            __m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row1 + i));
+
+            // At most 255 * 256 + 128, hence no 16-bit overflow
+            __m128i const lo = _mm_srli_epi16(
+                _mm_add_epi16(
+                    _mm_add_epi16(
+                        _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), w0),
+                        _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), w1)),
+                    half),
+                8);
+
+            __m128i const hi = _mm_srli_epi16(
+                _mm_add_epi16(
+                    _mm_add_epi16(
+                        _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), w0),
+                        _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), w1)),
+                    half),
+                8);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(outRow + i), _mm_packus_epi16(lo, hi));
+        }
+
+#endif
+
+        for (; i < byteCount; ++i)
+        {
+            outRow[i] = static_cast<std::uint8_t>(
+                (static_cast<std::uint32_t>(row0[i]) * (256 - weight1) + static_cast<std::uint32_t>(row1[i]) * weight1 + 128) >> 8);
+        }
+    }
+
+    // Resamples a row horizontally
+    void LerpColumns(
+        rgbaColor const * restrict row,
+        std::vector<BilinearSample> const & samples,
+        rgbaColor * restrict outRow)
+    {
+        size_t const targetWidth = samples.size();
+
+        size_t x = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+        static_assert(sizeof(rgbaColor) == sizeof(std::uint32_t));
+
+        auto const loadPixel = [](rgbaColor const & c) -> int
+        {
+            std::uint32_t p;
+            std::memcpy(&p, &c, sizeof(p));
+            return static_cast<int>(p);
+        };
+
+        __m128i const half = _mm_set1_epi16(128);
+        __m128i const zero = _mm_setzero_si128();
+
+        // Two target pixels at a time
+        for (; x + 2 <= targetWidth; x += 2)
+        {
+            BilinearSample const & sA = samples[x];
+            BilinearSample const & sB = samples[x + 1];
+
+            __m128i const p0 = _mm_unpacklo_epi8(
+                _mm_unpacklo_epi32(
+                    _mm_cvtsi32_si128(loadPixel(row[sA.Index0])),
+                    _mm_cvtsi32_si128(loadPixel(row[sB.Index0]))),
+                zero);
+
+            __m128i const p1 = _mm_unpacklo_epi8(
+                _mm_unpacklo_epi32(
+                    _mm_cvtsi32_si128(loadPixel(row[sA.Index1])),
+                    _mm_cvtsi32_si128(loadPixel(row[sB.Index1]))),
+                zero);
+
+            __m128i const w1 = _mm_set_epi16(
+                static_cast<short>(sB.Weight1), static_cast<short>(sB.Weight1), static_cast<short>(sB.Weight1), static_cast<short>(sB.Weight1),
+                static_cast<short>(sA.Weight1), static_cast<short>(sA.Weight1), static_cast<short>(sA.Weight1), static_cast<short>(sA.Weight1));
+            __m128i const w0 = _mm_sub_epi16(_mm_set1_epi16(256), w1);
+
+            __m128i const result = _mm_srli_epi16(
+                _mm_add_epi16(
+                    _mm_add_epi16(
+                        _mm_mullo_epi16(p0, w0),
+                        _mm_mullo_epi16(p1, w1)),
+                    half),
+                8);
+
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(outRow + x), _mm_packus_epi16(result, result));
+        }
+
+#endif
+
+        for (; x < targetWidth; ++x)
+        {
+            rgbaColor const & c0 = row[samples[x].Index0];
+            rgbaColor const & c1 = row[samples[x].Index1];
+            std::uint32_t const w1 = static_cast<std::uint32_t>(samples[x].Weight1);
+            std::uint32_t const w0 = 256 - w1;
+
+            outRow[x] = rgbaColor(
+                static_cast<std::uint8_t>((c0.r * w0 + c1.r * w1 + 128) >> 8),
+                static_cast<std::uint8_t>((c0.g * w0 + c1.g * w1 + 128) >> 8),
+                static_cast<std::uint8_t>((c0.b * w0 + c1.b * w1 + 128) >> 8),
+                static_cast<std::uint8_t>((c0.a * w0 + c1.a * w1 + 128) >> 8));
+        }
+    }
+}
+
 void ImageTools::BlendWithColor(
     RgbaImageData & imageData,
     rgbColor const & color,
     float alpha)
 {
+    //
+    // Each channel of the result only depends on the same channel of the source,
+    // hence we pre-calculate - with the very same math - the results for all
+    // possible channel values
+    //
+
+    std::uint8_t lookupTable[3][256];
+    for (int v = 0; v < 256; ++v)
+    {
+        rgbaColor const result = rgbaColor(
+            static_cast<std::uint8_t>(v),
+            static_cast<std::uint8_t>(v),
+            static_cast<std::uint8_t>(v),
+            0).mix(color, alpha);
+
+        lookupTable[0][v] = result.r;
+        lookupTable[1][v] = result.g;
+        lookupTable[2][v] = result.b;
+    }
+
+    rgbaColor * const restrict buffer = imageData.Data.get();
     size_t const pixelCount = imageData.Size.GetLinearSize();
     for (size_t i = 0; i < pixelCount; ++i)
     {
-        imageData.Data[i] = imageData.Data[i].mix(color, alpha);
+        buffer[i] = rgbaColor(
+            lookupTable[0][buffer[i].r],
+            lookupTable[1][buffer[i].g],
+            lookupTable[2][buffer[i].b],
+            buffer[i].a);
     }
 }
 
@@ -29,25 +284,316 @@ void ImageTools::Overlay(
     rgbaColor * const restrict baseBuffer = baseImageData.Data.get();
     rgbaColor const * const restrict overlayBuffer = overlayImageData.Data.get();
 
-    for (int baseR = y, overlayR = 0; baseR < baseSize.height && overlayR < overlaySize.width; ++baseR, ++overlayR)
+    //
+    // We calculate rgbaColor::blend() in integer math, which - as the exact result
+    // is never halfway between two integers - yields the very same results:
+    //  rgb = (base * (255 - overlayA) + overlay * overlayA) / 255
+    //  a = (overlayA * (255 - baseA) + 255 * baseA) / 255
+    //
+
+    int const overlayWidth = std::min(overlaySize.width, baseSize.width - x);
+
+    for (int baseR = y, overlayR = 0; baseR < baseSize.height && overlayR < overlaySize.height; ++baseR, ++overlayR)
     {
-        auto const baseRowStartIndex = baseR * baseSize.width;
-        auto const overlayRowStartIndex = overlayR * overlaySize.width;
+        rgbaColor * const restrict baseRow = baseBuffer + baseR * baseSize.width + x;
+        rgbaColor const * const restrict overlayRow = overlayBuffer + overlayR * overlaySize.width;
+
+        int c = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
 
-        for (int baseC = x, overlayC = 0; baseC < baseSize.width && overlayC < overlaySize.width; ++baseC, ++overlayC)
+        __m128i const alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        __m128i const max = _mm_set1_epi16(255);
+        __m128i const half = _mm_set1_epi16(127);
+        __m128i const zero = _mm_setzero_si128();
+
+        auto const blendTwoPixels = [&](__m128i base, __m128i overlay) -> __m128i
         {
-            baseBuffer[baseRowStartIndex + baseC] =
-                baseBuffer[baseRowStartIndex + baseC].blend(overlayBuffer[overlayRowStartIndex + overlayC]);
+            __m128i const baseAlpha = BroadcastAlpha_Epu16(base);
+            __m128i const overlayAlpha = BroadcastAlpha_Epu16(overlay);
+
+            // Result = (X * (255 - W) + Y * W) / 255
+            __m128i const x = Select(alphaMask, overlayAlpha, base);
+            __m128i const w = Select(alphaMask, baseAlpha, overlayAlpha);
+            __m128i const y = Select(alphaMask, max, overlay);
+
+            return Div255_Epu16(
+                _mm_add_epi16(
+                    _mm_add_epi16(
+                        _mm_mullo_epi16(x, _mm_sub_epi16(max, w)),
+                        _mm_mullo_epi16(y, w)),
+                    half));
+        };
+
+        // Four pixels at a time
+        for (; c + 4 <= overlayWidth; c += 4)
+        {
+            __m128i const base = _mm_loadu_si128(reinterpret_cast<__m128i const *>(baseRow + c));
+            __m128i const overlay = _mm_loadu_si128(reinterpret_cast<__m128i const *>(overlayRow + c));
+
+            __m128i const lo = blendTwoPixels(_mm_unpacklo_epi8(base, zero), _mm_unpacklo_epi8(overlay, zero));
+            __m128i const hi = blendTwoPixels(_mm_unpackhi_epi8(base, zero), _mm_unpackhi_epi8(overlay, zero));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(baseRow + c), _mm_packus_epi16(lo, hi));
+        }
+
+#endif
+
+        for (; c < overlayWidth; ++c)
+        {
+            rgbaColor const & base = baseRow[c];
+            rgbaColor const & overlay = overlayRow[c];
+
+            std::uint32_t const overlayA = overlay.a;
+            std::uint32_t const baseA = base.a;
+
+            baseRow[c] = rgbaColor(
+                static_cast<std::uint8_t>(Div255(base.r * (255 - overlayA) + overlay.r * overlayA + 127)),
+                static_cast<std::uint8_t>(Div255(base.g * (255 - overlayA) + overlay.g * overlayA + 127)),
+                static_cast<std::uint8_t>(Div255(base.b * (255 - overlayA) + overlay.b * overlayA + 127)),
+                static_cast<std::uint8_t>(Div255(overlayA * (255 - baseA) + 255 * baseA + 127)));
         }
     }
 }
 
 void ImageTools::AlphaPreMultiply(RgbaImageData & imageData)
 {
+    //
+    // We calculate rgbaColor::alpha_multiply() in integer math, which - as the exact
+    // result is never halfway between two integers - yields the very same results
+    //
+
+    rgbaColor * const restrict buffer = imageData.Data.get();
     size_t const pixelCount = imageData.Size.GetLinearSize();
-    for (size_t i = 0; i < pixelCount; ++i)
+
+    size_t i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+    __m128i const alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i const half = _mm_set1_epi16(127);
+    __m128i const zero = _mm_setzero_si128();
+
+    auto const multiplyTwoPixels = [&](__m128i pixels) -> __m128i
     {
-        imageData.Data[i].alpha_multiply();
+        __m128i const multiplied = Div255_Epu16(
+            _mm_add_epi16(
+                _mm_mullo_epi16(pixels, BroadcastAlpha_Epu16(pixels)),
+                half));
+
+        // Keep alpha
+        return Select(alphaMask, pixels, multiplied);
+    };
+
+    // Four pixels at a time
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i const pixels = _mm_loadu_si128(reinterpret_cast<__m128i const *>(buffer + i));
+
+        __m128i const lo = multiplyTwoPixels(_mm_unpacklo_epi8(pixels, zero));
+        __m128i const hi = multiplyTwoPixels(_mm_unpackhi_epi8(pixels, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + i), _mm_packus_epi16(lo, hi));
+    }
+
+#endif
+
+    for (; i < pixelCount; ++i)
+    {
+        std::uint32_t const a = buffer[i].a;
+        buffer[i].r = static_cast<std::uint8_t>(Div255(buffer[i].r * a + 127));
+        buffer[i].g = static_cast<std::uint8_t>(Div255(buffer[i].g * a + 127));
+        buffer[i].b = static_cast<std::uint8_t>(Div255(buffer[i].b * a + 127));
+    }
+}
+
+RgbaImageData ImageTools::DownscaleBox2x(RgbaImageData const & imageData)
+{
+    ImageSize const readSize = imageData.Size;
+    ImageSize const newSize(
+        std::max(1, readSize.width / 2),
+        std::max(1, readSize.height / 2));
+
+    auto newData = std::make_unique<rgbaColor[]>(newSize.GetLinearSize());
+
+    rgbaColor const * const restrict readBuffer = imageData.Data.get();
+    rgbaColor * const restrict writeBuffer = newData.get();
+
+    for (int y = 0; y < newSize.height; ++y)
+    {
+        rgbaColor const * const readRow = readBuffer + static_cast<size_t>(y * 2) * readSize.width;
+        rgbaColor const * const readNextRow = readRow + readSize.width; // Only valid when height > 1
+        rgbaColor * const writeRow = writeBuffer + static_cast<size_t>(y) * newSize.width;
+
+        int x = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+        if (readSize.width > 1 && readSize.height > 1)
+        {
+            __m128i const zero = _mm_setzero_si128();
+
+            // Sums two horizontally-adjacent pairs of vertical sums
+            auto const sumPairs = [](__m128i verticalSums) -> __m128i
+            {
+                return _mm_add_epi16(verticalSums, _mm_srli_si128(verticalSums, 8));
+            };
+
+            // Four target pixels at a time, out of eight pixels in each of the two source rows
+            for (; x + 4 <= newSize.width; x += 4)
+            {
+                __m128i const r0a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(readRow + x * 2));
+                __m128i const r0b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(readRow + x * 2 + 4));
+                __m128i const r1a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(readNextRow + x * 2));
+                __m128i const r1b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(readNextRow + x * 2 + 4));
+
+                __m128i const s0 = sumPairs(_mm_add_epi16(_mm_unpacklo_epi8(r0a, zero), _mm_unpacklo_epi8(r1a, zero)));
+                __m128i const s1 = sumPairs(_mm_add_epi16(_mm_unpackhi_epi8(r0a, zero), _mm_unpackhi_epi8(r1a, zero)));
+                __m128i const s2 = sumPairs(_mm_add_epi16(_mm_unpacklo_epi8(r0b, zero), _mm_unpacklo_epi8(r1b, zero)));
+                __m128i const s3 = sumPairs(_mm_add_epi16(_mm_unpackhi_epi8(r0b, zero), _mm_unpackhi_epi8(r1b, zero)));
+
+                // Average, truncating as rgbaColorAccumulation does
+                __m128i const a01 = _mm_srli_epi16(_mm_unpacklo_epi64(s0, s1), 2);
+                __m128i const a23 = _mm_srli_epi16(_mm_unpacklo_epi64(s2, s3), 2);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(writeRow + x), _mm_packus_epi16(a01, a23));
+            }
+        }
+
+#endif
+
+        for (; x < newSize.width; ++x)
+        {
+            int const rIndex = x * 2;
+
+            rgbaColorAccumulation sum(readRow[rIndex]);
+
+            if (readSize.width > 1)
+                sum += readRow[rIndex + 1];
+
+            if (readSize.height > 1)
+            {
+                sum += readNextRow[rIndex];
+
+                if (readSize.width > 1)
+                    sum += readNextRow[rIndex + 1];
+            }
+
+            writeRow[x] = sum.toRgbaColor();
+        }
+    }
+
+    return RgbaImageData(newSize, std::move(newData));
+}
+
+RgbaImageData ImageTools::Resize(
+    RgbaImageData imageData,
+    ImageSize const & newSize)
+{
+    if (newSize.width <= 0 || newSize.height <= 0
+        || imageData.Size.width <= 0 || imageData.Size.height <= 0)
+    {
+        return RgbaImageData(ImageSize(std::max(newSize.width, 0), std::max(newSize.height, 0)));
+    }
+
+    // Box-halve while we're at least twice the target size
+    while (imageData.Size.width >= newSize.width * 2 && imageData.Size.height >= newSize.height * 2)
+    {
+        imageData = DownscaleBox2x(imageData);
+    }
+
+    if (imageData.Size == newSize)
+    {
+        return imageData;
+    }
+
+    return ResampleBilinear(imageData, newSize);
+}
+
+void ImageTools::MatchColorWithinTolerance(
+    rgbaColor const * pixels,
+    size_t pixelCount,
+    rgbaColor const & seedColor,
+    unsigned int tolerance,
+    std::uint8_t * outMatches)
+{
+    assert(tolerance <= 100);
+
+    // Max distance (included), in 0-255 units
+    int const maxDistance = static_cast<int>(tolerance) * 255 / 100;
+
+    size_t i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+    //
+    // Four pixels at a time; each pixel is one 32-bit lane, with r in the lowest byte
+    //
+
+    static_assert(sizeof(rgbaColor) == sizeof(std::uint32_t));
+
+    __m128i const seed = _mm_set1_epi32(
+        static_cast<int>(
+            static_cast<std::uint32_t>(seedColor.r)
+            | (static_cast<std::uint32_t>(seedColor.g) << 8)
+            | (static_cast<std::uint32_t>(seedColor.b) << 16)));
+    __m128i const rgbMask = _mm_set1_epi32(0x00ffffff);
+    __m128i const lowByteMask = _mm_set1_epi32(0x000000ff);
+    __m128i const maxDistance4 = _mm_set1_epi32(maxDistance);
+    __m128i const zero = _mm_setzero_si128();
+
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i const px = _mm_loadu_si128(reinterpret_cast<__m128i const *>(pixels + i));
+        __m128i const rgb = _mm_and_si128(px, rgbMask);
+
+        // |dr|, |dg|, |db|, 0
+        __m128i const d = _mm_or_si128(_mm_subs_epu8(rgb, seed), _mm_subs_epu8(seed, rgb));
+
+        // |dg|, |db|, |dr|, 0
+        __m128i const dRot = _mm_and_si128(
+            _mm_or_si128(_mm_srli_epi32(d, 8), _mm_slli_epi32(d, 16)),
+            rgbMask);
+
+        // ||dr|-|dg||, ||dg|-|db||, ||db|-|dr||, 0
+        __m128i const dd = _mm_or_si128(_mm_subs_epu8(d, dRot), _mm_subs_epu8(dRot, d));
+
+        // Max among the three channels, in lowest byte
+        __m128i m = _mm_max_epu8(d, dd);
+        m = _mm_max_epu8(m, _mm_srli_epi32(m, 8));
+        m = _mm_max_epu8(m, _mm_srli_epi32(m, 8));
+        m = _mm_and_si128(m, lowByteMask);
+
+        // Match: distance <= max && alpha != 0
+        __m128i const isTooFar = _mm_cmpgt_epi32(m, maxDistance4);
+        __m128i const isTransparent = _mm_cmpeq_epi32(_mm_srli_epi32(px, 24), zero);
+        int const noMatchMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(isTooFar, isTransparent)));
+
+        outMatches[i + 0] = (noMatchMask & 0x1) ? 0 : 1;
+        outMatches[i + 1] = (noMatchMask & 0x2) ? 0 : 1;
+        outMatches[i + 2] = (noMatchMask & 0x4) ? 0 : 1;
+        outMatches[i + 3] = (noMatchMask & 0x8) ? 0 : 1;
+    }
+
+#endif
+
+    for (; i < pixelCount; ++i)
+    {
+        rgbaColor const & px = pixels[i];
+
+        int const dr = std::abs(static_cast<int>(px.r) - static_cast<int>(seedColor.r));
+        int const dg = std::abs(static_cast<int>(px.g) - static_cast<int>(seedColor.g));
+        int const db = std::abs(static_cast<int>(px.b) - static_cast<int>(seedColor.b));
+
+        int const distance = std::max({
+            dr,
+            dg,
+            db,
+            std::abs(dr - dg),
+            std::abs(dg - db),
+            std::abs(db - dr) });
+
+        outMatches[i] = (px.a != 0 && distance <= maxDistance) ? 1 : 0;
     }
 }
 
@@ -61,12 +607,10 @@ RgbaImageData ImageTools::Truncate(
 
     for (int r = 0; r < finalImageSize.height; ++r)
     {
-        auto const readRowStartIndex = r * imageData.Size.width;
-        auto const writeRowStartIndex = r * finalImageSize.width;
-        for (int c = 0; c < finalImageSize.width; ++c)
-        {
-            newImageData[writeRowStartIndex + c] = imageData.Data[readRowStartIndex + c];
-        }
+        std::memcpy(
+            static_cast<void *>(newImageData.get() + static_cast<size_t>(r) * finalImageSize.width),
+            static_cast<void const *>(imageData.Data.get() + static_cast<size_t>(r) * imageData.Size.width),
+            static_cast<size_t>(finalImageSize.width) * sizeof(rgbaColor));
     }
 
     return RgbaImageData(finalImageSize, std::move(newImageData));
@@ -74,15 +618,46 @@ RgbaImageData ImageTools::Truncate(
 
 RgbImageData ImageTools::ToRgb(RgbaImageData const & imageData)
 {
-    std::unique_ptr<rgbColor[]> newImageData = std::make_unique<rgbColor[]>(imageData.Size.GetLinearSize());
+    size_t const pixelCount = imageData.Size.GetLinearSize();
+
+    std::unique_ptr<rgbColor[]> newImageData = std::make_unique<rgbColor[]>(pixelCount);
+
+    rgbaColor const * const restrict readBuffer = imageData.Data.get();
+    rgbColor * const restrict writeBuffer = newImageData.get();
 
-    for (int r = 0; r < imageData.Size.height; ++r)
+    size_t i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+    //
+    // Four pixels at a time, within 64-bit words (little-endian): drop the alpha bytes
+    // and pack the remaining twelve
+    //
+
+    static_assert(sizeof(rgbaColor) == 4 && sizeof(rgbColor) == 3);
+
+    for (; i + 4 <= pixelCount; i += 4)
     {
-        auto const rowStartIndex = r * imageData.Size.width;
-        for (int c = 0; c < imageData.Size.width; ++c)
-        {
-            newImageData[rowStartIndex + c] = imageData.Data[rowStartIndex + c].toRgbColor();
-        }
+        std::uint64_t p01, p23;
+        std::memcpy(&p01, readBuffer + i, sizeof(p01));
+        std::memcpy(&p23, readBuffer + i + 2, sizeof(p23));
+
+        std::uint64_t const rgb01 = (p01 & 0x0000000000ffffffull) | ((p01 >> 8) & 0x0000ffffff000000ull);
+        std::uint64_t const rgb23 = (p23 & 0x0000000000ffffffull) | ((p23 >> 8) & 0x0000ffffff000000ull);
+
+        std::uint64_t const out0 = rgb01 | (rgb23 << 48);
+        std::uint32_t const out1 = static_cast<std::uint32_t>(rgb23 >> 16);
+
+        std::uint8_t * const out = reinterpret_cast<std::uint8_t *>(writeBuffer + i);
+        std::memcpy(out, &out0, sizeof(out0));
+        std::memcpy(out + sizeof(out0), &out1, sizeof(out1));
+    }
+
+#endif
+
+    for (; i < pixelCount; ++i)
+    {
+        writeBuffer[i] = readBuffer[i].toRgbColor();
     }
 
     return RgbImageData(imageData.Size, std::move(newImageData));
@@ -90,18 +665,83 @@ RgbImageData ImageTools::ToRgb(RgbaImageData const & imageData)
 
 RgbImageData ImageTools::ToAlpha(RgbaImageData const & imageData)
 {
-    std::unique_ptr<rgbColor[]> newImageData = std::make_unique<rgbColor[]>(imageData.Size.GetLinearSize());
+    size_t const pixelCount = imageData.Size.GetLinearSize();
 
-    for (int r = 0; r < imageData.Size.height; ++r)
+    std::unique_ptr<rgbColor[]> newImageData = std::make_unique<rgbColor[]>(pixelCount);
+
+    rgbaColor const * const restrict readBuffer = imageData.Data.get();
+    rgbColor * const restrict writeBuffer = newImageData.get();
+
+    size_t i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+    //
+    // Four pixels at a time, within 64-bit words (little-endian): replicate each alpha
+    // byte three times, and pack the resulting twelve bytes
+    //
+
+    static_assert(sizeof(rgbaColor) == 4 && sizeof(rgbColor) == 3);
+
+    for (; i + 4 <= pixelCount; i += 4)
     {
-        auto const rowStartIndex = r * imageData.Size.width;
-        for (int c = 0; c < imageData.Size.width; ++c)
-        {
-            auto const a = imageData.Data[rowStartIndex + c].a;
-            rgbColor c2(a, a, a);
-            newImageData[rowStartIndex + c] = c2;
-        }
+        std::uint64_t p01, p23;
+        std::memcpy(&p01, readBuffer + i, sizeof(p01));
+        std::memcpy(&p23, readBuffer + i + 2, sizeof(p23));
+
+        std::uint64_t const aaa01 = ((p01 >> 24) & 0xff) * 0x010101ull | ((p01 >> 56) * 0x010101ull) << 24;
+        std::uint64_t const aaa23 = ((p23 >> 24) & 0xff) * 0x010101ull | ((p23 >> 56) * 0x010101ull) << 24;
+
+        std::uint64_t const out0 = aaa01 | (aaa23 << 48);
+        std::uint32_t const out1 = static_cast<std::uint32_t>(aaa23 >> 16);
+
+        std::uint8_t * const out = reinterpret_cast<std::uint8_t *>(writeBuffer + i);
+        std::memcpy(out, &out0, sizeof(out0));
+        std::memcpy(out + sizeof(out0), &out1, sizeof(out1));
+    }
+
+#endif
+
+    for (; i < pixelCount; ++i)
+    {
+        auto const a = readBuffer[i].a;
+        writeBuffer[i] = rgbColor(a, a, a);
     }
 
     return RgbImageData(imageData.Size, std::move(newImageData));
 }
+
+RgbaImageData ImageTools::ResampleBilinear(
+    RgbaImageData const & imageData,
+    ImageSize const & newSize)
+{
+    ImageSize const readSize = imageData.Size;
+
+    std::vector<BilinearSample> const xSamples = MakeBilinearSamples(readSize.width, newSize.width);
+    std::vector<BilinearSample> const ySamples = MakeBilinearSamples(readSize.height, newSize.height);
+
+    auto newData = std::make_unique<rgbaColor[]>(newSize.GetLinearSize());
+
+    rgbaColor const * const readBuffer = imageData.Data.get();
+    rgbaColor * const writeBuffer = newData.get();
+
+    // Vertically-resampled source row
+    std::unique_ptr<rgbaColor[]> lerpedRow = std::make_unique<rgbaColor[]>(readSize.width);
+
+    for (int y = 0; y < newSize.height; ++y)
+    {
+        LerpRows(
+            reinterpret_cast<std::uint8_t const *>(readBuffer + static_cast<size_t>(ySamples[y].Index0) * readSize.width),
+            reinterpret_cast<std::uint8_t const *>(readBuffer + static_cast<size_t>(ySamples[y].Index1) * readSize.width),
+            ySamples[y].Weight1,
+            reinterpret_cast<std::uint8_t *>(lerpedRow.get()),
+            static_cast<size_t>(readSize.width) * sizeof(rgbaColor));
+
+        LerpColumns(
+            lerpedRow.get(),
+            xSamples,
+            writeBuffer + static_cast<size_t>(y) * newSize.width);
+    }
+
+    return RgbaImageData(newSize, std::move(newData));
+}
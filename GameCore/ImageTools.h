@@ -12,8 +12,15 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <functional>
 
+/*
+ * Image operations.
+ *
+ * The per-pixel operations are vectorized on x86 (SSE2), with a scalar fallback that
+ * produces the very same results.
+ */
 class ImageTools
 {
 public:
@@ -34,6 +41,34 @@ public:
      */
     static void AlphaPreMultiply(RgbaImageData & imageData);
 
+    /*
+     * Halves the image in both dimensions with a 2x2 box filter - the same filter we use for
+     * texture mipmaps; the last row and column of odd-sized images are dropped.
+     */
+    static RgbaImageData DownscaleBox2x(RgbaImageData const & imageData);
+
+    /*
+     * Resizes the image to the specified size, either up or down. When shrinking, the image
+     * is first box-halved for as long as it is at least twice the target size, so that all
+     * source pixels contribute to the result; the remainder is done via bilinear resampling.
+     */
+    static RgbaImageData Resize(
+        RgbaImageData imageData,
+        ImageSize const & newSize);
+
+    /*
+     * For each pixel, stores whether it exists (alpha is not zero) and its color is within
+     * the specified tolerance (0-100) of the seed color. Alpha is not considered in the
+     * color distance, which is the largest among the per-channel distances and their
+     * mutual differences.
+     */
+    static void MatchColorWithinTolerance(
+        rgbaColor const * pixels,
+        size_t pixelCount,
+        rgbaColor const & seedColor,
+        unsigned int tolerance,
+        std::uint8_t * outMatches);
+
     static inline vec4f SamplePixel(
         RgbaImageData const & imageData,
         float x,
@@ -99,6 +134,10 @@ public:
 
 private:
 
+    static RgbaImageData ResampleBilinear(
+        RgbaImageData const & imageData,
+        ImageSize const & newSize);
+
     template<typename TColor>
     static inline ImageData<TColor> InternalTrim(
         ImageData<TColor> imageData,
@@ -0,0 +1,152 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-24
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename TSignature, size_t Capacity>
+class InplaceFunction;
+
+/*
+ * A move-only, type-erased callable - like std::function - that stores its target in
+ * an inline buffer of the specified capacity, and thus never allocates.
+ *
+ * Targets that don't fit are rejected at compile time; such targets may instead be
+ * captured by reference or by pointer.
+ */
+template<typename TReturn, typename... TArgs, size_t Capacity>
+class InplaceFunction<TReturn(TArgs...), Capacity> final
+{
+public:
+
+    InplaceFunction() noexcept
+        : mOperations(nullptr)
+    {}
+
+    InplaceFunction(std::nullptr_t) noexcept
+        : mOperations(nullptr)
+    {}
+
+    template<
+        typename TCallable,
+        typename = std::enable_if_t<!std::is_same_v<std::decay_t<TCallable>, InplaceFunction>>>
+    InplaceFunction(TCallable && callable)
+    {
+        using TTarget = std::decay_t<TCallable>;
+
+        static_assert(sizeof(TTarget) <= Capacity, "The callable does not fit the inline buffer: capture less, or by reference");
+        static_assert(alignof(TTarget) <= alignof(std::max_align_t), "The callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<TTarget>, "The callable must be nothrow-movable");
+
+        new (&mStorage) TTarget(std::forward<TCallable>(callable));
+        mOperations = &TargetOperations<TTarget>::Table;
+    }
+
+    InplaceFunction(InplaceFunction && other) noexcept
+        : mOperations(other.mOperations)
+    {
+        if (mOperations != nullptr)
+        {
+            mOperations->MoveAndDestroy(&other.mStorage, &mStorage);
+            other.mOperations = nullptr;
+        }
+    }
+
+    InplaceFunction(InplaceFunction const & other) = delete;
+
+    ~InplaceFunction()
+    {
+        Reset();
+    }
+
+    InplaceFunction & operator=(InplaceFunction && other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+
+            mOperations = other.mOperations;
+            if (mOperations != nullptr)
+            {
+                mOperations->MoveAndDestroy(&other.mStorage, &mStorage);
+                other.mOperations = nullptr;
+            }
+        }
+
+        return *this;
+    }
+
+    InplaceFunction & operator=(InplaceFunction const & other) = delete;
+
+    InplaceFunction & operator=(std::nullptr_t) noexcept
+    {
+        Reset();
+        return *this;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return mOperations != nullptr;
+    }
+
+    // Like std::function, the target is invoked as non-const, so that mutable lambdas may be used
+    TReturn operator()(TArgs... args) const
+    {
+        assert(mOperations != nullptr);
+        return mOperations->Invoke(const_cast<Storage *>(&mStorage), std::forward<TArgs>(args)...);
+    }
+
+private:
+
+    using Storage = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+
+    struct Operations
+    {
+        TReturn(*Invoke)(void * target, TArgs... args);
+        void(*MoveAndDestroy)(void * source, void * destination);
+        void(*Destroy)(void * target);
+    };
+
+    template<typename TTarget>
+    struct TargetOperations
+    {
+        static TReturn Invoke(void * target, TArgs... args)
+        {
+            return (*static_cast<TTarget *>(target))(std::forward<TArgs>(args)...);
+        }
+
+        static void MoveAndDestroy(void * source, void * destination)
+        {
+            new (destination) TTarget(std::move(*static_cast<TTarget *>(source)));
+            static_cast<TTarget *>(source)->~TTarget();
+        }
+
+        static void Destroy(void * target)
+        {
+            static_cast<TTarget *>(target)->~TTarget();
+        }
+
+        static constexpr Operations Table = { &Invoke, &MoveAndDestroy, &Destroy };
+    };
+
+    void Reset() noexcept
+    {
+        if (mOperations != nullptr)
+        {
+            mOperations->Destroy(&mStorage);
+            mOperations = nullptr;
+        }
+    }
+
+private:
+
+    Storage mStorage;
+    Operations const * mOperations;
+};
@@ -28,6 +28,9 @@ enum class ProgressMessageType : std::size_t
 	LoadingShipBuilder,				// "Loading ShipBuilder..."
 	LoadingMaterialPalette,			// "Loading materials palette..."
 	Calibrating,					// "Calibrating game on the computer..."
+	LoadingShip,					// "Loading ship..."
+	BuildingShip,					// "Building ship..."
+	TexturizingShip,				// "Texturizing ship..."
 	Ready,							// "Ready!"
 
 	_Last = Ready
@@ -0,0 +1,299 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-02-17
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/*
+ * A 2D mask with one bit per element, laid out like Buffer2D (row-major).
+ */
+template<typename TIntegralTag>
+class Buffer2DMask
+{
+public:
+
+    using coordinates_type = _IntegralCoordinates<TIntegralTag>;
+    using size_type = _IntegralSize<TIntegralTag>;
+
+public:
+
+    explicit Buffer2DMask(size_type size)
+        : Size(size)
+        , mWords(new std::uint64_t[GetWordCount(size)]())
+    {}
+
+    size_type const Size;
+
+    inline bool Get(int x, int y) const
+    {
+        assert(coordinates_type(x, y).IsInSize(Size));
+
+        size_t const linearIndex = static_cast<size_t>(y) * Size.width + x;
+        return (mWords[linearIndex / 64] & (std::uint64_t(1) << (linearIndex % 64))) != 0;
+    }
+
+    inline bool Get(coordinates_type const & coords) const
+    {
+        return Get(coords.x, coords.y);
+    }
+
+    inline void Set(int x, int y)
+    {
+        assert(coordinates_type(x, y).IsInSize(Size));
+
+        size_t const linearIndex = static_cast<size_t>(y) * Size.width + x;
+        mWords[linearIndex / 64] |= (std::uint64_t(1) << (linearIndex % 64));
+    }
+
+    inline void Set(coordinates_type const & coords)
+    {
+        Set(coords.x, coords.y);
+    }
+
+    /*
+     * Sets all bits in [xStart, xEnd) on row y.
+     */
+    void SetSpan(int y, int xStart, int xEnd)
+    {
+        assert(xStart <= xEnd);
+
+        size_t index = static_cast<size_t>(y) * Size.width + xStart;
+        size_t const endIndex = static_cast<size_t>(y) * Size.width + xEnd;
+
+        // Leading bits, up to word boundary
+        for (; index < endIndex && (index % 64) != 0; ++index)
+        {
+            mWords[index / 64] |= (std::uint64_t(1) << (index % 64));
+        }
+
+        // Whole words
+        for (; index + 64 <= endIndex; index += 64)
+        {
+            mWords[index / 64] = ~std::uint64_t(0);
+        }
+
+        // Trailing bits
+        for (; index < endIndex; ++index)
+        {
+            mWords[index / 64] |= (std::uint64_t(1) << (index % 64));
+        }
+    }
+
+private:
+
+    static size_t GetWordCount(size_type size)
+    {
+        return (static_cast<size_t>(size.width) * static_cast<size_t>(size.height) + 63) / 64;
+    }
+
+    std::unique_ptr<std::uint64_t[]> mWords;
+};
+
+/*
+ * Span-based scanline flood fill over a 2D region laid out like Buffer2D.
+ *
+ * Whole horizontal runs are filled at once, and only seeds of runs are pushed onto the stack,
+ * rather than individual elements; a bitmask keeps track of filled elements, so that
+ * the fillable predicate is never re-evaluated for filled elements and may thus be
+ * evaluated against the original content of the buffer even while filling it.
+ */
+template<typename TIntegralTag>
+class ScanlineFill
+{
+public:
+
+    using coordinates_type = _IntegralCoordinates<TIntegralTag>;
+    using size_type = _IntegralSize<TIntegralTag>;
+    using rect_type = _IntegralRect<TIntegralTag>;
+
+    enum class ConnectivityType
+    {
+        Four,
+        Eight
+    };
+
+public:
+
+    explicit ScanlineFill(size_type size)
+        : mFilledMask(size)
+        , mSeedStack()
+    {}
+
+    Buffer2DMask<TIntegralTag> const & GetFilledMask() const
+    {
+        return mFilledMask;
+    }
+
+    /*
+     * Fills the region reachable from the start element.
+     *
+     * isFillable(x, y) -> bool: whether the element is part of the region.
+     * onSpan(y, xStart, xEnd): invoked once for each filled run [xStart, xEnd) on row y.
+     *
+     * Returns the rect affected by the fill, or none if the start element is not fillable.
+     */
+    template<typename TIsFillable, typename TOnSpan>
+    std::optional<rect_type> Fill(
+        coordinates_type const & start,
+        ConnectivityType connectivity,
+        TIsFillable && isFillable,
+        TOnSpan && onSpan)
+    {
+        size_type const size = mFilledMask.Size;
+
+        assert(start.IsInSize(size));
+
+        int const diagonalReach = (connectivity == ConnectivityType::Eight) ? 1 : 0;
+
+        std::optional<rect_type> affectedRect;
+
+        assert(mSeedStack.empty());
+        mSeedStack.emplace_back(start.x, start.y, -1, 0, 0);
+
+        while (!mSeedStack.empty())
+        {
+            auto const seed = mSeedStack.back();
+            mSeedStack.pop_back();
+
+            if (mFilledMask.Get(seed.X, seed.Y) || !isFillable(seed.X, seed.Y))
+            {
+                continue;
+            }
+
+            //
+            // Expand run
+            //
+
+            int const y = seed.Y;
+
+            int xStart = seed.X;
+            while (xStart > 0 && !mFilledMask.Get(xStart - 1, y) && isFillable(xStart - 1, y))
+            {
+                --xStart;
+            }
+
+            int xEnd = seed.X + 1;
+            while (xEnd < size.width && !mFilledMask.Get(xEnd, y) && isFillable(xEnd, y))
+            {
+                ++xEnd;
+            }
+
+            //
+            // Fill run
+            //
+
+            mFilledMask.SetSpan(y, xStart, xEnd);
+
+            onSpan(y, xStart, xEnd);
+
+            rect_type const spanRect(coordinates_type(xStart, y), size_type(xEnd - xStart, 1));
+            if (!affectedRect.has_value())
+            {
+                affectedRect = spanRect;
+            }
+            else
+            {
+                affectedRect->UnionWith(spanRect);
+            }
+
+            //
+            // Seed runs on adjacent rows; on the row of the parent run, we may skip
+            // the parent run itself, as we know it's filled
+            //
+
+            int const xScanStart = std::max(xStart - diagonalReach, 0);
+            int const xScanEnd = std::min(xEnd + diagonalReach, size.width);
+
+            for (int const yn : { y - 1, y + 1 })
+            {
+                if (yn < 0 || yn >= size.height)
+                {
+                    continue;
+                }
+
+                if (yn == seed.ParentY)
+                {
+                    SeedRow(yn, xScanStart, std::min(seed.ParentXStart, xScanEnd), y, xStart, xEnd, isFillable);
+                    SeedRow(yn, std::max(seed.ParentXEnd, xScanStart), xScanEnd, y, xStart, xEnd, isFillable);
+                }
+                else
+                {
+                    SeedRow(yn, xScanStart, xScanEnd, y, xStart, xEnd, isFillable);
+                }
+            }
+        }
+
+        return affectedRect;
+    }
+
+private:
+
+    struct Seed
+    {
+        int X;
+        int Y;
+
+        // The run that pushed this seed
+        int ParentY;
+        int ParentXStart;
+        int ParentXEnd;
+
+        Seed(
+            int x,
+            int y,
+            int parentY,
+            int parentXStart,
+            int parentXEnd)
+            : X(x)
+            , Y(y)
+            , ParentY(parentY)
+            , ParentXStart(parentXStart)
+            , ParentXEnd(parentXEnd)
+        {}
+    };
+
+    template<typename TIsFillable>
+    inline void SeedRow(
+        int y,
+        int xStart,
+        int xEnd,
+        int parentY,
+        int parentXStart,
+        int parentXEnd,
+        TIsFillable && isFillable)
+    {
+        // Push one seed per run of fillable elements
+        bool isInRun = false;
+        for (int x = xStart; x < xEnd; ++x)
+        {
+            if (!mFilledMask.Get(x, y) && isFillable(x, y))
+            {
+                if (!isInRun)
+                {
+                    mSeedStack.emplace_back(x, y, parentY, parentXStart, parentXEnd);
+                    isInRun = true;
+                }
+            }
+            else
+            {
+                isInRun = false;
+            }
+        }
+    }
+
+private:
+
+    Buffer2DMask<TIntegralTag> mFilledMask;
+
+    std::vector<Seed> mSeedStack;
+};
@@ -0,0 +1,131 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-30
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+/*
+ * This class implements a fixed-capacity, lock-free ring of elements for
+ * exactly one producer thread and exactly one consumer thread.
+ *
+ * The producer never blocks: when the ring is full, new elements are dropped
+ * (and counted), so that the producer pays the same few instructions regardless
+ * of how late the consumer is.
+ */
+template<typename TElement, size_t Capacity>
+class SpscRingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+
+    SpscRingBuffer()
+        : mElements()
+        , mHead(0)
+        , mTail(0)
+        , mDroppedCount(0)
+    {}
+
+    SpscRingBuffer(SpscRingBuffer const & other) = delete;
+    SpscRingBuffer & operator=(SpscRingBuffer const & other) = delete;
+
+    static constexpr size_t capacity()
+    {
+        return Capacity;
+    }
+
+    /*
+     * Producer side. Returns false - and drops the element - when the ring is full.
+     */
+    bool try_push(TElement const & element)
+    {
+        size_t const tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) == Capacity)
+        {
+            mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        mElements[tail & (Capacity - 1)] = element;
+
+        // Publish the element
+        mTail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /*
+     * Consumer side. Returns false when the ring is empty.
+     */
+    bool try_pop(TElement & element)
+    {
+        size_t const head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        element = mElements[head & (Capacity - 1)];
+
+        // Give the slot back to the producer
+        mHead.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /*
+     * Consumer side. Pops all the elements currently in the ring, in order,
+     * invoking the callback for each of them; returns the number of elements popped.
+     */
+    template<typename TCallback>
+    size_t drain(TCallback && callback)
+    {
+        size_t const head = mHead.load(std::memory_order_relaxed);
+        size_t const tail = mTail.load(std::memory_order_acquire);
+
+        for (size_t i = head; i != tail; ++i)
+        {
+            callback(mElements[i & (Capacity - 1)]);
+        }
+
+        mHead.store(tail, std::memory_order_release);
+
+        return tail - head;
+    }
+
+    /*
+     * Either side; approximate when the other side is running.
+     */
+    size_t size() const
+    {
+        return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+    }
+
+    /*
+     * The number of elements dropped so far because the ring was full.
+     */
+    size_t dropped_count() const
+    {
+        return mDroppedCount.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    std::array<TElement, Capacity> mElements;
+
+    // Next element to pop; only written by the consumer.
+    // Kept on its own cache line, so that the two sides don't keep
+    // invalidating each other's line
+    alignas(64) std::atomic<size_t> mHead;
+
+    // Next slot to push into; only written by the producer
+    alignas(64) std::atomic<size_t> mTail;
+
+    std::atomic<size_t> mDroppedCount;
+};
@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <memory>
@@ -15,6 +16,10 @@
 #include <cstdlib>
 #endif
 
+#if defined(__linux__) || defined(linux) || defined(__linux)
+#include <sys/mman.h>
+#endif
+
 //
 // Architecture and Width
 //
@@ -147,6 +152,16 @@ inline constexpr T ceil_square_power_of_two(T value)
 #include <pmmintrin.h>
 #endif
 
+// Whether the compiler targets AVX2 (e.g. -mavx2, /arch:AVX2); only then
+// may we use 256-bit instructions
+#define FS_IS_INSTRUCTION_SET_AVX2() 0
+
+#if (FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()) && defined(__AVX2__)
+#undef FS_IS_INSTRUCTION_SET_AVX2
+#define FS_IS_INSTRUCTION_SET_AVX2() 1
+#include <immintrin.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Alignment
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -207,6 +222,98 @@ inline constexpr bool is_aligned_to_float_element_count(T element_count) noexcep
 
 #define aligned_to_vword alignas(vectorization_byte_count<size_t>)
 
+/*
+ * How the memory of a buffer is to be allocated.
+ */
+enum class BufferAllocationPolicy
+{
+    // Plain, aligned heap memory
+    Default,
+
+    // Huge pages - explicit ones if the system has reserved any, else transparent ones - for
+    // large buffers accessed at random, so to save TLB misses; falls back to Default where
+    // not supported, and for buffers smaller than a huge page. The pages of these buffers are
+    // only backed by physical memory when first touched, hence - on NUMA systems - on the node
+    // of the thread touching them first
+    HugePages
+};
+
+inline constexpr size_t HugePageByteSize = 2 * 1024 * 1024;
+
+/*
+ * Maps huge pages for the specified byte size, returning nullptr if that's
+ * not possible; the mapped size is stored in mapped_byte_size.
+ */
+inline void * alloc_huge_pages(size_t byte_size, size_t & mapped_byte_size)
+{
+    mapped_byte_size = 0;
+
+#if FS_IS_OS_LINUX()
+
+    size_t const huge_byte_size = (byte_size + HugePageByteSize - 1) / HugePageByteSize * HugePageByteSize;
+
+#ifdef MAP_HUGETLB
+    // Explicit huge pages
+    void * ptr = mmap(nullptr, huge_byte_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED)
+    {
+        mapped_byte_size = huge_byte_size;
+        return ptr;
+    }
+#endif
+
+    // Transparent huge pages, which are only used for huge-page-aligned ranges;
+    // hence we map one more huge page and trim the excess on either side
+    size_t const over_byte_size = huge_byte_size + HugePageByteSize;
+    void * const raw_ptr = mmap(nullptr, over_byte_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw_ptr != MAP_FAILED)
+    {
+        std::uintptr_t const raw_address = reinterpret_cast<std::uintptr_t>(raw_ptr);
+        std::uintptr_t const aligned_address = (raw_address + HugePageByteSize - 1) & ~(static_cast<std::uintptr_t>(HugePageByteSize) - 1);
+
+        size_t const head_byte_size = static_cast<size_t>(aligned_address - raw_address);
+        if (head_byte_size > 0)
+        {
+            munmap(raw_ptr, head_byte_size);
+        }
+
+        size_t const tail_byte_size = over_byte_size - head_byte_size - huge_byte_size;
+        if (tail_byte_size > 0)
+        {
+            munmap(reinterpret_cast<void *>(aligned_address + huge_byte_size), tail_byte_size);
+        }
+
+#ifdef MADV_HUGEPAGE
+        // Advisory only; if THP are disabled we simply get normal pages
+        madvise(reinterpret_cast<void *>(aligned_address), huge_byte_size, MADV_HUGEPAGE);
+#endif
+
+        mapped_byte_size = huge_byte_size;
+        return reinterpret_cast<void *>(aligned_address);
+    }
+
+#else
+
+    // Windows' large pages require a privilege that users normally do not have,
+    // and macOS has no user-controlled huge pages
+    (void)byte_size;
+
+#endif
+
+    return nullptr;
+}
+
+inline void free_huge_pages(void * ptr, size_t mapped_byte_size)
+{
+#if FS_IS_OS_LINUX()
+    munmap(ptr, mapped_byte_size);
+#else
+    (void)ptr;
+    (void)mapped_byte_size;
+    assert(false);
+#endif
+}
+
 /*
  * Allocates a buffer of bytes aligned to the vectorization float
  * byte count.
@@ -238,12 +345,37 @@ inline void free_aligned(void * ptr)
 #endif
 }
 
+/*
+ * The number of bytes currently held by the buffers made with make_unique_buffer_aligned_to_vectorization_word(),
+ * by the type of memory backing them; for diagnostics.
+ */
+struct AlignedBufferStats
+{
+    static inline std::atomic<size_t> HeapByteCount{ 0 };
+    static inline std::atomic<size_t> HugePagesByteCount{ 0 };
+};
+
 template<typename TElement>
 struct aligned_buffer_deleter
 {
+    // Non-zero when the buffer consists of mapped huge pages
+    size_t MappedByteSize = 0;
+
+    // Non-zero when the buffer comes from the heap
+    size_t HeapByteSize = 0;
+
     void operator()(TElement * ptr)
     {
-        free_aligned(reinterpret_cast<void *>(ptr));
+        if (MappedByteSize != 0)
+        {
+            free_huge_pages(reinterpret_cast<void *>(ptr), MappedByteSize);
+            AlignedBufferStats::HugePagesByteCount.fetch_sub(MappedByteSize, std::memory_order_relaxed);
+        }
+        else
+        {
+            free_aligned(reinterpret_cast<void *>(ptr));
+            AlignedBufferStats::HeapByteCount.fetch_sub(HeapByteSize, std::memory_order_relaxed);
+        }
     }
 };
 
@@ -251,9 +383,37 @@ template<typename TElement>
 using unique_aligned_buffer = std::unique_ptr<TElement[], aligned_buffer_deleter<TElement>>;
 
 template<typename TElement>
-inline unique_aligned_buffer<TElement> make_unique_buffer_aligned_to_vectorization_word(size_t elementCount)
+inline unique_aligned_buffer<TElement> make_unique_buffer_aligned_to_vectorization_word(
+    size_t elementCount,
+    BufferAllocationPolicy policy = BufferAllocationPolicy::Default)
 {
+    size_t const byteSize = elementCount * sizeof(TElement);
+
+    if (policy == BufferAllocationPolicy::HugePages && byteSize >= HugePageByteSize)
+    {
+        // Huge pages are aligned to much more than the vectorization word
+        aligned_buffer_deleter<TElement> deleter;
+        void * const ptr = alloc_huge_pages(byteSize, deleter.MappedByteSize);
+        if (ptr != nullptr)
+        {
+            AlignedBufferStats::HugePagesByteCount.fetch_add(deleter.MappedByteSize, std::memory_order_relaxed);
+
+            return unique_aligned_buffer<TElement>(
+                reinterpret_cast<TElement *>(ptr),
+                deleter);
+        }
+    }
+
+    void * const ptr = alloc_aligned_to_vectorization_word(byteSize);
+
+    aligned_buffer_deleter<TElement> deleter;
+    if (ptr != nullptr)
+    {
+        deleter.HeapByteSize = byteSize;
+        AlignedBufferStats::HeapByteCount.fetch_add(byteSize, std::memory_order_relaxed);
+    }
+
     return unique_aligned_buffer<TElement>(
-        reinterpret_cast<TElement *>(alloc_aligned_to_vectorization_word(elementCount * sizeof(TElement))),
-        aligned_buffer_deleter<TElement>());
+        reinterpret_cast<TElement *>(ptr),
+        deleter);
 }
@@ -0,0 +1,467 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-03-25
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameException.h"
+#include "InplaceFunction.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * A graph of tasks and of their dependencies, built once and then run - e.g. every
+ * simulation step - on a thread pool, without allocating anything.
+ *
+ * Each task receives a context, which carries whatever changes at each run.
+ *
+ * Dependencies are either explicit, or derived from the resources - a flags enum - that
+ * each task declares to read and to write: a task depends on all the tasks added before
+ * it that write what it reads or writes, or that read what it writes. Hence the graph
+ * is acyclic by construction, and - as long as each task declares all the shared state
+ * it touches, and tasks touching state bound to a thread (e.g. sinks that may only be
+ * invoked on the thread running the graph) are added as calling-thread-only - running
+ * it yields the same results as running all tasks serially in the order in which they
+ * were added.
+ *
+ * Tasks run in levels: each level consists of the tasks whose dependencies are all in
+ * earlier levels, and the tasks of a level run in parallel - costliest first, according
+ * to their measured durations, so that the longest ones are not started last. Levels
+ * too cheap to be worth waking up the pool for run serially on the calling thread.
+ * The calling-thread-only tasks of a level run one after the other, in the order in
+ * which they were added, always on the calling thread.
+ *
+ * In debug builds, tasks run one at a time, verifying that each only changes the
+ * (registered buffers of the) resources it declares to write.
+ */
+template<typename TContext, typename TResources>
+class TaskGraph final
+{
+public:
+
+    using Task = InplaceFunction<void(TContext const &), ThreadPool::TaskCapacity>;
+
+    using TaskId = size_t;
+
+    enum class TaskAffinity
+    {
+        AnyThread,
+        CallingThread
+    };
+
+public:
+
+    TaskGraph()
+        : mNodes()
+        , mLevelTaskIds()
+        , mLevelCallingThreadTaskCounts()
+        , mLevelTasks()
+        , mPartitionStart()
+        , mCurrentContext(nullptr)
+#ifdef _DEBUG
+        , mResourceBuffers()
+#endif
+    {}
+
+    // Level tasks refer to us
+    TaskGraph(TaskGraph const & other) = delete;
+    TaskGraph(TaskGraph && other) = delete;
+    TaskGraph & operator=(TaskGraph const & other) = delete;
+    TaskGraph & operator=(TaskGraph && other) = delete;
+
+    void Clear()
+    {
+        mNodes.clear();
+        mLevelTaskIds.clear();
+        mLevelCallingThreadTaskCounts.clear();
+        mLevelTasks.clear();
+        mPartitionStart.reset();
+
+#ifdef _DEBUG
+        mResourceBuffers.clear();
+#endif
+    }
+
+    /*
+     * Adds a task that runs after the specified tasks.
+     *
+     * The task does not take part in resource-derived dependencies.
+     */
+    TaskId AddTask(
+        Task && task,
+        std::initializer_list<TaskId> dependencies = {})
+    {
+        size_t level = 0;
+        for (TaskId const dependency : dependencies)
+        {
+            assert(dependency < mNodes.size());
+            level = std::max(level, mNodes[dependency].Level + 1);
+        }
+
+        return AddNode(std::move(task), level, "", ResourceBits(0), ResourceBits(0), TaskAffinity::AnyThread);
+    }
+
+    /*
+     * Adds a task that runs after all the tasks added before it that write what it
+     * reads or writes, or that read what it writes.
+     */
+    TaskId AddTask(
+        char const * name,
+        TResources reads,
+        TResources writes,
+        Task && task)
+    {
+        return AddTask(name, reads, writes, TaskAffinity::AnyThread, std::move(task));
+    }
+
+    /*
+     * As above, but the task may also be pinned to the thread running the graph.
+     */
+    TaskId AddTask(
+        char const * name,
+        TResources reads,
+        TResources writes,
+        TaskAffinity affinity,
+        Task && task)
+    {
+        ResourceBits const readBits = static_cast<ResourceBits>(reads);
+        ResourceBits const writeBits = static_cast<ResourceBits>(writes);
+
+        size_t level = 0;
+        for (TaskId t = 0; t < mPartitionStart.value_or(mNodes.size()); ++t)
+        {
+            auto const & node = mNodes[t];
+
+            if ((node.Writes & (readBits | writeBits)) != 0
+                || (node.Reads & writeBits) != 0)
+            {
+                level = std::max(level, node.Level + 1);
+            }
+        }
+
+        return AddNode(std::move(task), level, name, readBits, writeBits, affinity);
+    }
+
+    /*
+     * The tasks added between these calls work on disjoint parts of the resources
+     * they write, and thus do not depend on each other.
+     */
+    void BeginPartition()
+    {
+        assert(!mPartitionStart.has_value());
+        mPartitionStart = mNodes.size();
+    }
+
+    void EndPartition()
+    {
+        assert(mPartitionStart.has_value());
+        mPartitionStart.reset();
+    }
+
+    /*
+     * Registers a buffer of the specified resource, for verifying - in debug builds -
+     * that tasks not declaring to write that resource leave the buffer untouched.
+     */
+    void RegisterResourceBuffer(
+        TResources resource,
+        void const * data,
+        size_t byteSize)
+    {
+#ifdef _DEBUG
+        mResourceBuffers.emplace_back(
+            static_cast<ResourceBits>(resource),
+            static_cast<unsigned char const *>(data),
+            byteSize);
+#else
+        (void)resource;
+        (void)data;
+        (void)byteSize;
+#endif
+    }
+
+    size_t GetTaskCount() const
+    {
+        return mNodes.size();
+    }
+
+    size_t GetLevelCount() const
+    {
+        return mLevelTaskIds.size();
+    }
+
+    size_t GetTaskLevel(TaskId taskId) const
+    {
+        assert(taskId < mNodes.size());
+        return mNodes[taskId].Level;
+    }
+
+    /*
+     * Runs all the tasks, and returns when they have all completed.
+     *
+     * Within each level, the calling-thread-only tasks - if any - and otherwise the
+     * first, i.e. costliest, task are guaranteed to run on the calling thread.
+     */
+    void Run(
+        ThreadPool & threadPool,
+        TContext const & context)
+    {
+        mCurrentContext = &context;
+
+#ifdef _DEBUG
+        (void)threadPool;
+#endif
+
+        for (size_t level = 0; level < mLevelTaskIds.size(); ++level)
+        {
+            auto & levelTaskIds = mLevelTaskIds[level];
+
+#ifdef _DEBUG
+            for (TaskId const taskId : levelTaskIds)
+            {
+                RunTaskAndVerify(taskId);
+            }
+#else
+            if (levelTaskIds.size() == 1)
+            {
+                RunTask(levelTaskIds.front());
+                continue;
+            }
+
+            // Sort the tasks free to run anywhere by decreasing cost; the pool hands out
+            // tasks in order
+            std::sort(
+                levelTaskIds.begin() + mLevelCallingThreadTaskCounts[level],
+                levelTaskIds.end(),
+                [this](TaskId t1, TaskId t2)
+                {
+                    return mNodes[t1].AverageDuration > mNodes[t2].AverageDuration
+                        || (mNodes[t1].AverageDuration == mNodes[t2].AverageDuration && t1 < t2);
+                });
+
+            float totalDuration = 0.0f;
+            for (TaskId const taskId : levelTaskIds)
+            {
+                totalDuration += mNodes[taskId].AverageDuration;
+            }
+
+            if (totalDuration < MinParallelLevelDuration)
+            {
+                for (TaskId const taskId : levelTaskIds)
+                {
+                    RunTask(taskId);
+                }
+            }
+            else
+            {
+                threadPool.Run(mLevelTasks[level]);
+            }
+#endif
+        }
+
+        mCurrentContext = nullptr;
+    }
+
+private:
+
+    using ResourceBits = std::underlying_type_t<TResources>;
+
+    // Below this measured duration (microseconds), a level runs serially
+    static float constexpr MinParallelLevelDuration = 50.0f;
+
+    // Weight of each new measurement in the running average of a task's duration
+    static float constexpr DurationAverageAlpha = 0.05f;
+
+    struct Node
+    {
+        Task TaskToRun;
+        size_t Level;
+        char const * Name;
+        ResourceBits Reads;
+        ResourceBits Writes;
+        float AverageDuration; // Microseconds
+
+        Node(
+            Task && taskToRun,
+            size_t level,
+            char const * name,
+            ResourceBits reads,
+            ResourceBits writes)
+            : TaskToRun(std::move(taskToRun))
+            , Level(level)
+            , Name(name)
+            , Reads(reads)
+            , Writes(writes)
+            , AverageDuration(0.0f)
+        {}
+    };
+
+    TaskId AddNode(
+        Task && task,
+        size_t level,
+        char const * name,
+        ResourceBits reads,
+        ResourceBits writes,
+        TaskAffinity affinity)
+    {
+        TaskId const taskId = mNodes.size();
+
+        mNodes.emplace_back(std::move(task), level, name, reads, writes);
+
+        if (level == mLevelTaskIds.size())
+        {
+            mLevelTaskIds.emplace_back();
+            mLevelCallingThreadTaskCounts.emplace_back(0);
+            mLevelTasks.emplace_back();
+        }
+
+        auto & levelTaskIds = mLevelTaskIds[level];
+        size_t & callingThreadTaskCount = mLevelCallingThreadTaskCounts[level];
+
+        if (affinity == TaskAffinity::CallingThread)
+        {
+            // Calling-thread-only tasks come first, in the order in which they are added,
+            // and all run in the first pool task - which the pool runs on the calling thread
+            levelTaskIds.insert(levelTaskIds.begin() + callingThreadTaskCount, taskId);
+            ++callingThreadTaskCount;
+
+            if (callingThreadTaskCount > 1)
+            {
+                // The first pool task already runs them
+                return taskId;
+            }
+        }
+        else
+        {
+            levelTaskIds.push_back(taskId);
+        }
+
+        // The pool task at each position of a level runs whichever task is at that position
+        // of the level once sorted - or all of the calling-thread-only tasks, for the
+        // first position
+        size_t const position = mLevelTasks[level].size();
+        mLevelTasks[level].emplace_back(
+            [this, level, position]()
+            {
+                RunLevelPosition(level, position);
+            });
+
+        return taskId;
+    }
+
+    void RunLevelPosition(
+        size_t level,
+        size_t position)
+    {
+        auto const & levelTaskIds = mLevelTaskIds[level];
+        size_t const callingThreadTaskCount = mLevelCallingThreadTaskCounts[level];
+
+        if (callingThreadTaskCount == 0)
+        {
+            RunTask(levelTaskIds[position]);
+        }
+        else if (position == 0)
+        {
+            for (size_t t = 0; t < callingThreadTaskCount; ++t)
+            {
+                RunTask(levelTaskIds[t]);
+            }
+        }
+        else
+        {
+            RunTask(levelTaskIds[callingThreadTaskCount + position - 1]);
+        }
+    }
+
+    void RunTask(TaskId taskId)
+    {
+        assert(mCurrentContext != nullptr);
+
+        auto & node = mNodes[taskId];
+
+        auto const startTime = std::chrono::steady_clock::now();
+
+        node.TaskToRun(*mCurrentContext);
+
+        float const duration = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+        node.AverageDuration += (duration - node.AverageDuration) * DurationAverageAlpha;
+    }
+
+#ifdef _DEBUG
+    void RunTaskAndVerify(TaskId taskId)
+    {
+        auto const & node = mNodes[taskId];
+
+        for (auto & resourceBuffer : mResourceBuffers)
+        {
+            if ((resourceBuffer.Resource & node.Writes) == 0)
+            {
+                resourceBuffer.Snapshot.assign(resourceBuffer.Data, resourceBuffer.Data + resourceBuffer.ByteSize);
+            }
+        }
+
+        RunTask(taskId);
+
+        for (auto const & resourceBuffer : mResourceBuffers)
+        {
+            if ((resourceBuffer.Resource & node.Writes) == 0
+                && std::memcmp(resourceBuffer.Snapshot.data(), resourceBuffer.Data, resourceBuffer.ByteSize) != 0)
+            {
+                throw GameException("Task \"" + std::string(node.Name) + "\" has written a resource it has not declared to write");
+            }
+        }
+    }
+#endif
+
+private:
+
+    std::vector<Node> mNodes;
+
+    // The tasks of each level, in the order in which they run: first the calling-thread-only
+    // ones, then the others
+    std::vector<std::vector<TaskId>> mLevelTaskIds;
+
+    // The number of calling-thread-only tasks of each level
+    std::vector<size_t> mLevelCallingThreadTaskCounts;
+
+    // The pool tasks of each level, running the tasks at each position
+    std::vector<std::vector<ThreadPool::Task>> mLevelTasks;
+
+    // Set when we're adding the tasks of a partition
+    std::optional<TaskId> mPartitionStart;
+
+    TContext const * mCurrentContext;
+
+#ifdef _DEBUG
+
+    struct ResourceBuffer
+    {
+        ResourceBits Resource;
+        unsigned char const * Data;
+        size_t ByteSize;
+        std::vector<unsigned char> Snapshot;
+
+        ResourceBuffer(
+            ResourceBits resource,
+            unsigned char const * data,
+            size_t byteSize)
+            : Resource(resource)
+            , Data(data)
+            , ByteSize(byteSize)
+            , Snapshot()
+        {}
+    };
+
+    std::vector<ResourceBuffer> mResourceBuffers;
+
+#endif
+};
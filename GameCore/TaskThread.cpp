@@ -8,16 +8,30 @@
 #include "Log.h"
 #include "ThreadManager.h"
 
+#include <algorithm>
 #include <cassert>
 
+static_assert((TaskThread::TaskCapacity % sizeof(void *)) == 0);
+
 TaskThread::TaskThread()
     : TaskThread(false)
 {}
 
 TaskThread::TaskThread(bool isMultithreaded)
     : mHasThread(isMultithreaded)
+    , mQueue(new QueuedTask[QueueCapacity])
+    , mQueueTail(0)
+    , mQueueHead(0)
+    , mBatchedTasks()
+    , mIsTaskThreadSleeping(false)
+    , mIsMainThreadSleeping(false)
     , mIsStop(false)
+    , mTaskExceptions()
+    , mHasTaskExceptions(false)
+    , mCurrentTaskSequenceNumber(0)
 {
+    static_assert((QueueCapacity & (QueueCapacity - 1)) == 0);
+
     if (mHasThread)
     {
         LogMessage("TaskThread::TaskThread(): starting thread...");
@@ -42,7 +56,7 @@ TaskThread::~TaskThread()
             std::unique_lock const lock{ mThreadLock };
 
             mIsStop = true;
-            mThreadSignal.notify_one();
+            mTaskThreadSignal.notify_one();
         }
 
         LogMessage("TaskThread::~TaskThread(): signaled stop; waiting for thread now...");
@@ -54,6 +68,168 @@ TaskThread::~TaskThread()
     }
 }
 
+std::uint64_t TaskThread::Enqueue(
+    Task && task,
+    std::vector<Task> * batch)
+{
+    assert(mHasThread);
+
+    std::uint64_t const queueTail = mQueueTail.load(std::memory_order_relaxed);
+
+    //
+    // Wait for the entry to be free, i.e. for the task thread
+    // to have completed the entry that was last there
+    //
+
+    if (queueTail - mQueueHead.load(std::memory_order_acquire) == QueueCapacity)
+    {
+        // Only wait for the slot - exceptions of the task that was there are
+        // for whoever waits for that task
+        WaitForQueueHead(queueTail - QueueCapacity + 1);
+    }
+
+    //
+    // Populate entry
+    //
+
+    QueuedTask & queuedTask = mQueue[queueTail & (QueueCapacity - 1)];
+
+    assert(!queuedTask.TaskToRun);
+    queuedTask.TaskToRun = std::move(task);
+
+    if (batch != nullptr)
+    {
+        // Swap vectors, so that we get back - empty - the vector of
+        // the previous batch at this entry, together with its capacity
+        assert(queuedTask.Batch.empty());
+        std::swap(queuedTask.Batch, *batch);
+    }
+
+    //
+    // Publish entry
+    //
+    // Sequentially-consistent, as we then check whether the task thread
+    // is sleeping - which it checks after telling it is
+    //
+
+    mQueueTail.store(queueTail + 1);
+
+    if (mIsTaskThreadSleeping.load())
+    {
+        std::unique_lock const lock{ mThreadLock };
+
+        mTaskThreadSignal.notify_one();
+    }
+
+    return queueTail + 1;
+}
+
+void TaskThread::WaitForCompletion(std::uint64_t taskSequenceNumber)
+{
+    WaitForQueueHead(taskSequenceNumber);
+
+    //
+    // Check if an exception was thrown
+    //
+
+    if (mHasTaskExceptions.load(std::memory_order_acquire))
+    {
+        std::string exceptionMessage;
+
+        {
+            std::unique_lock const lock{ mThreadLock };
+
+            auto it = std::find_if(
+                mTaskExceptions.begin(),
+                mTaskExceptions.end(),
+                [taskSequenceNumber](auto const & e)
+                {
+                    return e.first == taskSequenceNumber;
+                });
+
+            if (it == mTaskExceptions.end())
+            {
+                return;
+            }
+
+            exceptionMessage = std::move(it->second);
+
+            mTaskExceptions.erase(it);
+            mHasTaskExceptions = !mTaskExceptions.empty();
+        }
+
+        throw std::runtime_error(exceptionMessage);
+    }
+}
+
+void TaskThread::WaitForQueueHead(std::uint64_t taskSequenceNumber)
+{
+    if (mQueueHead.load(std::memory_order_acquire) < taskSequenceNumber)
+    {
+        std::unique_lock<std::mutex> lock(mThreadLock);
+
+        mIsMainThreadSleeping = true;
+
+        // Wait for task completion
+        mMainThreadSignal.wait(
+            lock,
+            [this, taskSequenceNumber]
+            {
+                return mQueueHead.load() >= taskSequenceNumber;
+            });
+
+        mIsMainThreadSleeping = false;
+    }
+}
+
+std::uint64_t TaskThread::RunInline(Task const & task)
+{
+    assert(!mHasThread);
+
+    std::uint64_t const taskSequenceNumber = mQueueTail.load(std::memory_order_relaxed) + 1;
+    mQueueTail.store(taskSequenceNumber, std::memory_order_relaxed);
+
+    mCurrentTaskSequenceNumber = taskSequenceNumber;
+    RunTask(task);
+
+    mQueueHead.store(taskSequenceNumber, std::memory_order_relaxed);
+
+    return taskSequenceNumber;
+}
+
+void TaskThread::RunTask(Task const & task)
+{
+    if (!task)
+    {
+        // Synchronization point
+        return;
+    }
+
+    try
+    {
+        task();
+    }
+    catch (std::runtime_error const & exc)
+    {
+        // Remember it, so whoever waits for this task gets it
+        RegisterException(exc.what());
+    }
+}
+
+void TaskThread::RegisterException(std::string const & exceptionMessage)
+{
+    std::unique_lock const lock{ mThreadLock };
+
+    if (mTaskExceptions.size() == MaxTaskExceptions)
+    {
+        // Forget the oldest one
+        mTaskExceptions.erase(mTaskExceptions.begin());
+    }
+
+    mTaskExceptions.emplace_back(mCurrentTaskSequenceNumber, exceptionMessage);
+    mHasTaskExceptions = true;
+}
+
 void TaskThread::ThreadLoop()
 {
     assert(mHasThread); // This method only runs if we're truly multi-threaded
@@ -68,72 +244,74 @@ void TaskThread::ThreadLoop()
     // Run loop
     //
 
+    std::uint64_t queueHead = mQueueHead.load(std::memory_order_relaxed);
+
     while (true)
     {
         //
-        // Extract task
+        // Wait for an entry
         //
 
-        QueuedTask queuedTask;
-
+        if (mQueueTail.load(std::memory_order_acquire) == queueHead)
         {
             std::unique_lock<std::mutex> lock(mThreadLock);
 
+            // Sequentially-consistent, as we then check the tail - which
+            // the main thread publishes before checking whether we're sleeping
+            mIsTaskThreadSleeping = true;
+
             // Wait for signal
-            mThreadSignal.wait(
+            mTaskThreadSignal.wait(
                 lock,
-                [this]
+                [this, queueHead]
                 {
-                    return mIsStop || !mTaskQueue.empty();
+                    return mIsStop || mQueueTail.load() != queueHead;
                 });
 
-            if (mIsStop)
-            {
-                // We're done!
-                break;
-            }
-            else
-            {
-                //
-                // Deque task
-                //
-
-                assert(!mTaskQueue.empty());
+            mIsTaskThreadSleeping = false;
+        }
 
-                queuedTask = std::move(mTaskQueue.front());
-                mTaskQueue.pop_front();
-            }
+        if (mIsStop)
+        {
+            // We're done!
+            break;
         }
 
         //
-        // Run task
+        // Run entry
         //
 
-        assert(!!queuedTask.TaskToRun);
+        QueuedTask & queuedTask = mQueue[queueHead & (QueueCapacity - 1)];
 
-        try
-        {
-            queuedTask.TaskToRun();
-        }
-        catch (std::runtime_error const & exc)
+        mCurrentTaskSequenceNumber = queueHead + 1;
+
+        RunTask(queuedTask.TaskToRun);
+        queuedTask.TaskToRun = nullptr;
+
+        for (auto const & batchedTask : queuedTask.Batch)
         {
-            // Store in task completion indicator
-            // (safe to do without locks, as it will only be read by
-            // main thread after it is signaled)
-            queuedTask.CompletionIndicator->RegisterException(exc.what());
+            RunTask(batchedTask);
         }
 
+        queuedTask.Batch.clear(); // Keeps capacity, for the main thread to re-use
+
         //
-        // Signal task completion
+        // Signal entry completion
         //
+        // Sequentially-consistent, as we then check whether the main thread
+        // is sleeping - which it checks after telling it is
+        //
+
+        ++queueHead;
+        mQueueHead.store(queueHead);
 
+        if (mIsMainThreadSleeping.load())
         {
             std::unique_lock const lock{ mThreadLock };
 
-            queuedTask.CompletionIndicator->MarkCompleted();
-            mThreadSignal.notify_one();
+            mMainThreadSignal.notify_one();
         }
     }
 
     LogMessage("TaskThread::ThreadLoop(): exiting");
-}
\ No newline at end of file
+}
@@ -5,14 +5,19 @@
 ***************************************************************************************/
 #pragma once
 
+#include "InplaceFunction.h"
+
+#include <atomic>
 #include <condition_variable>
-#include <deque>
-#include <functional>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 /*
  * A thread that serially runs tasks provided by the main thread. The user
@@ -23,12 +28,22 @@
  * class (the main thread), and that thread is responsible for the lifetime
  * of this class (cctor and dctor).
  *
+ * Tasks are handed over via a single-producer, single-consumer ring that the
+ * two threads only synchronize on when one of them has to sleep; tasks store
+ * their captures inline, hence queueing a task never allocates.
+ *
+ * Tasks that don't need to be waited for individually - e.g. the many uploads
+ * of a frame - may also be batched, and the batch handed over in one go.
  */
 class TaskThread
 {
 public:
 
-    using Task = std::function<void()>;
+    // Enough for a handful of pointers and sizes; larger state should
+    // be captured by reference
+    static size_t constexpr TaskCapacity = 64;
+
+    using Task = InplaceFunction<void(), TaskCapacity>;
 
     // Note: instances of this class are owned by the main thread, which is
     // also responsible for invoking the destructor of TaskThread, hence if
@@ -46,59 +61,27 @@ public:
          */
         void Wait()
         {
-            if (!mIsTaskCompleted)
-            {
-                std::unique_lock<std::mutex> lock(mThreadLock);
-
-                // Wait for task completion
-                mThreadSignal.wait(
-                    lock,
-                    [this]
-                    {
-                        return mIsTaskCompleted;
-                    });
-            }
-
-            // Check if an exception was thrown
-            if (!mExceptionMessage.empty())
-            {
-                throw std::runtime_error(mExceptionMessage);
-            }
+            mTaskThread->WaitForCompletion(mTaskSequenceNumber);
         }
 
     private:
 
         _TaskCompletionIndicatorImpl(
-            std::mutex & threadLock,
-            std::condition_variable & threadSignal)
-            : mIsTaskCompleted(false)
-            , mExceptionMessage()
-            , mThreadLock(threadLock)
-            , mThreadSignal(threadSignal)
+            TaskThread & taskThread,
+            std::uint64_t taskSequenceNumber)
+            : mTaskThread(&taskThread)
+            , mTaskSequenceNumber(taskSequenceNumber)
         {}
 
-        void MarkCompleted()
-        {
-            mIsTaskCompleted = true;
-        }
-
-        void RegisterException(std::string const & exceptionMessage)
-        {
-            mExceptionMessage = exceptionMessage;
-        }
-
     private:
 
-        bool mIsTaskCompleted; // Flag set by task thread to signal completion of the task
-        std::string mExceptionMessage; // Set by task thread upon exception
-
-        std::mutex & mThreadLock;
-        std::condition_variable & mThreadSignal;
+        TaskThread * mTaskThread;
+        std::uint64_t mTaskSequenceNumber; // The task is completed once the task thread has completed this many queue entries
 
         friend class TaskThread;
     };
 
-    using TaskCompletionIndicator = std::shared_ptr<_TaskCompletionIndicatorImpl>;
+    using TaskCompletionIndicator = std::optional<_TaskCompletionIndicatorImpl>;
 
 public:
 
@@ -118,54 +101,33 @@ public:
      */
     TaskCompletionIndicator QueueTask(Task && task)
     {
-        auto taskCompletionIndicator = std::shared_ptr<_TaskCompletionIndicatorImpl>(
-            new _TaskCompletionIndicatorImpl(
-                mThreadLock,
-                mThreadSignal));
-
         if (mHasThread)
         {
-            //
-            // Queue task
-            //
-
-            std::unique_lock<std::mutex> lock(mThreadLock);
+            // Hand over the tasks batched so far, so they run before this one
+            FlushBatchedTasks();
 
-            mTaskQueue.emplace_back(
-                std::move(task),
-                taskCompletionIndicator);
-
-            mThreadSignal.notify_one();
+            return MakeCompletionIndicator(Enqueue(std::move(task)));
         }
         else
         {
-            //
-            // Run task
-            //
-
-            try
-            {
-                task();
-            }
-            catch (std::runtime_error const & exc)
-            {
-                // Store in task completion indicator
-                taskCompletionIndicator->RegisterException(exc.what());
-            }
-
-            taskCompletionIndicator->MarkCompleted();
+            return MakeCompletionIndicator(RunInline(task));
         }
-
-        return taskCompletionIndicator;
     }
 
     /*
      * Invoked on the main thread to run a task on the task thread
      * and wait until it returns.
      */
-    void RunSynchronously(Task && task)
+    template<typename TTask>
+    void RunSynchronously(TTask && task)
     {
-        auto result = QueueTask(std::move(task));
+        // We wait for the task, hence it's safe to run it by reference - whatever its captures
+        auto result = QueueTask(
+            [&task]()
+            {
+                task();
+            });
+
         result->Wait();
     }
 
@@ -175,43 +137,130 @@ public:
      */
     TaskCompletionIndicator QueueSynchronizationPoint()
     {
-        return QueueTask([]() {});
+        if (mHasThread && !mBatchedTasks.empty())
+        {
+            // The end of the batch is our synchronization point
+            return MakeCompletionIndicator(FlushBatchedTasks());
+        }
+
+        return QueueTask(Task());
     }
 
-private:
+    /*
+     * Invoked on the main thread to add a fire-and-forget task to the current batch,
+     * which is handed over to the task thread as a whole with the next task, synchronization
+     * point, or explicit flush - preserving the order of all tasks.
+     */
+    void QueueBatchedTask(Task && task)
+    {
+        if (mHasThread)
+        {
+            mBatchedTasks.emplace_back(std::move(task));
+        }
+        else
+        {
+            RunInline(task);
+        }
+    }
 
-    void ThreadLoop();
+    /*
+     * Invoked on the main thread to hand over the current batch, if any; returns
+     * the sequence number of the batch.
+     */
+    std::uint64_t FlushBatchedTasks()
+    {
+        if (mBatchedTasks.empty())
+        {
+            return mQueueTail.load(std::memory_order_relaxed);
+        }
+
+        return Enqueue(Task(), &mBatchedTasks);
+    }
 
 private:
 
+    // Must be a power of two
+    static size_t constexpr QueueCapacity = 256;
+
     struct QueuedTask
     {
         Task TaskToRun;
-        TaskCompletionIndicator CompletionIndicator;
+        std::vector<Task> Batch;
 
         QueuedTask()
             : TaskToRun()
-            , CompletionIndicator()
-        {
-        }
-
-        QueuedTask(
-            Task && taskToRun,
-            TaskCompletionIndicator completionIndicator)
-            : TaskToRun(std::move(taskToRun))
-            , CompletionIndicator(std::move(completionIndicator))
+            , Batch()
         {}
     };
 
+private:
+
+    void ThreadLoop();
+
+    // Returns the sequence number of the new queue entry
+    std::uint64_t Enqueue(
+        Task && task,
+        std::vector<Task> * batch = nullptr);
+
+    // Throws the exception thrown by the task, if any
+    void WaitForCompletion(std::uint64_t taskSequenceNumber);
+
+    // Only waits, leaving the task's exception - if any - to whoever waits for the task
+    void WaitForQueueHead(std::uint64_t taskSequenceNumber);
+
+    TaskCompletionIndicator MakeCompletionIndicator(std::uint64_t taskSequenceNumber)
+    {
+        return TaskCompletionIndicator(_TaskCompletionIndicatorImpl(*this, taskSequenceNumber));
+    }
+
+    // Runs the task right away, when we're not multi-threaded; returns its sequence number
+    std::uint64_t RunInline(Task const & task);
+
+    void RunTask(Task const & task);
+
+    void RegisterException(std::string const & exceptionMessage);
+
 private:
 
     std::thread mThread;
     bool const mHasThread; // Invariant: mHasThread==true <=> mThread.joinable(); we only use the flag as the perf impact of checking is_joinable() is unknown
 
+    // The ring of queued tasks; the entry for sequence number N is at (N - 1) % QueueCapacity
+    std::unique_ptr<QueuedTask[]> mQueue;
+
+    // Number of entries queued so far; only written by the main thread
+    alignas(64) std::atomic<std::uint64_t> mQueueTail;
+
+    // Number of entries completed so far; only written by the task thread
+    alignas(64) std::atomic<std::uint64_t> mQueueHead;
+
+    // The tasks batched so far; only touched by the main thread
+    std::vector<Task> mBatchedTasks;
+
+    //
+    // Sleeping - the lock is only taken by a thread about to sleep,
+    // and by a thread waking it up
+    //
+
     std::mutex mThreadLock;
-    std::condition_variable mThreadSignal; // Just one, as each of {main thread, worker thread} can't be waiting and signaling at the same time
+    std::condition_variable mTaskThreadSignal;
+    std::condition_variable mMainThreadSignal;
+    std::atomic<bool> mIsTaskThreadSleeping;
+    std::atomic<bool> mIsMainThreadSleeping;
+
+    std::atomic<bool> mIsStop;
+
+    //
+    // Exceptions thrown by tasks, by sequence number; guarded by the thread lock.
+    // We only remember the most recent ones, as nobody might ever wait for them
+    //
+
+    static size_t constexpr MaxTaskExceptions = 16;
 
-    std::deque<QueuedTask> mTaskQueue;
+    std::vector<std::pair<std::uint64_t, std::string>> mTaskExceptions;
+    std::atomic<bool> mHasTaskExceptions;
 
-    bool mIsStop;
-};
\ No newline at end of file
+    // The sequence number of the task currently being run; only used by the
+    // thread running tasks
+    std::uint64_t mCurrentTaskSequenceNumber;
+};
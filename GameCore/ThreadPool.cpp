@@ -20,6 +20,9 @@ ThreadPool::ThreadPool(
     , mRemainingTasks()
     , mTasksToComplete(0)
     , mIsStop(false)
+    , mDoTrackIdleDuration(false)
+    , mTotalRunDuration(GameChronometer::duration::zero())
+    , mTotalTaskDurationTicks(0)
 {
     LogMessage("ThreadPool: creating thread pool with parallelism=", parallelism);
 
@@ -59,6 +62,8 @@ void ThreadPool::Run(std::vector<Task> const & tasks)
     assert(mRemainingTasks.empty());
     assert(0 == mTasksToComplete);
 
+    auto const startTime = mDoTrackIdleDuration ? GameChronometer::now() : GameChronometer::time_point();
+
     // Shortcut to avoid paying synchronization penalties
     // in trivial cases
     if (mThreads.empty() || tasks.size() == 1)
@@ -68,6 +73,11 @@ void ThreadPool::Run(std::vector<Task> const & tasks)
             RunTask(task);
         }
 
+        if (mDoTrackIdleDuration)
+        {
+            mTotalRunDuration += GameChronometer::now() - startTime;
+        }
+
         return;
     }
 
@@ -117,6 +127,11 @@ void ThreadPool::Run(std::vector<Task> const & tasks)
             assert(0 == mTasksToComplete);
         }
     }
+
+    if (mDoTrackIdleDuration)
+    {
+        mTotalRunDuration += GameChronometer::now() - startTime;
+    }
 }
 
 void ThreadPool::ThreadLoop(ThreadManager & threadManager)
@@ -223,6 +238,22 @@ void ThreadPool::RunRemainingTasksLoop()
 }
 
 void ThreadPool::RunTask(Task const & task)
+{
+    if (mDoTrackIdleDuration)
+    {
+        auto const startTime = GameChronometer::now();
+
+        InvokeTask(task);
+
+        mTotalTaskDurationTicks.fetch_add((GameChronometer::now() - startTime).count(), std::memory_order_relaxed);
+    }
+    else
+    {
+        InvokeTask(task);
+    }
+}
+
+void ThreadPool::InvokeTask(Task const & task)
 {
     try
     {
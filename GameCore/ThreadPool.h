@@ -5,11 +5,13 @@
 ***************************************************************************************/
 #pragma once
 
+#include "GameChronometer.h"
+#include "InplaceFunction.h"
 #include "ThreadManager.h"
 
+#include <atomic>
 #include <cassert>
 #include <condition_variable>
-#include <functional>
 #include <mutex>
 #include <deque>
 #include <thread>
@@ -23,7 +25,12 @@ class ThreadPool final
 {
 public:
 
-    using Task = std::function<void()>;
+    // Enough for a handful of pointers and sizes; larger state should
+    // be captured by reference
+    static size_t constexpr TaskCapacity = 64;
+
+    // Tasks never allocate, so that task vectors may be built cheaply - or once
+    using Task = InplaceFunction<void(), TaskCapacity>;
 
 public:
 
@@ -52,6 +59,30 @@ public:
         tasks.clear();
     }
 
+    /*
+     * Enables or disables the tracking of the idle time; when disabled, tasks run
+     * without reading the clock.
+     *
+     * Only to be invoked by the thread invoking Run().
+     */
+    void SetDoTrackIdleDuration(bool value)
+    {
+        mDoTrackIdleDuration = value;
+    }
+
+    /*
+     * Gets the cumulative time that the threads of this pool - the main thread included -
+     * have spent idle during Run()'s, either waiting for tasks or waiting for the other
+     * threads to complete theirs; only Run()'s made while tracking is enabled count.
+     *
+     * Only to be invoked by the thread invoking Run().
+     */
+    GameChronometer::duration GetTotalIdleDuration() const
+    {
+        return mTotalRunDuration * static_cast<GameChronometer::duration::rep>(GetParallelism())
+            - GameChronometer::duration(mTotalTaskDurationTicks.load(std::memory_order_relaxed));
+    }
+
 private:
 
     void ThreadLoop(ThreadManager & threadManager);
@@ -60,6 +91,8 @@ private:
 
     void RunTask(Task const & task);
 
+    static void InvokeTask(Task const & task);
+
 private:
 
     // Our thread lock
@@ -83,4 +116,9 @@ private:
 
     // Set to true when have to stop
     bool mIsStop;
+
+    // Stats: the cumulative duration of all Run()'s, and of all tasks
+    bool mDoTrackIdleDuration;
+    GameChronometer::duration mTotalRunDuration;
+    std::atomic<GameChronometer::duration::rep> mTotalTaskDurationTicks;
 };
@@ -0,0 +1,401 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-02-24
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Buffer2D.h"
+#include "GameTypes.h"
+#include "SysSpecifics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * A 2D buffer stored as a grid of square tiles, with tiles shared - copy-on-write -
+ * among clones.
+ *
+ * Cloning costs one reference per tile, regardless of the size of the buffer;
+ * only the tiles that are modified after a clone get their own copy.
+ *
+ * Meant for snapshots of large, flat Buffer2D's that change in small regions at a time,
+ * e.g. the "original" layer kept by editing tools: instead of re-cloning the whole buffer
+ * after each edit, the snapshot is re-synced with the tiles overlapping the edit.
+ */
+template<typename TElement, typename TIntegralTag, int TTileSize = 64>
+class TiledBuffer2D
+{
+public:
+
+    using element_type = TElement;
+    using coordinates_type = _IntegralCoordinates<TIntegralTag>;
+    using size_type = _IntegralSize<TIntegralTag>;
+    using rect_type = _IntegralRect<TIntegralTag>;
+    using buffer_type = Buffer2D<TElement, TIntegralTag>;
+
+    static int constexpr TileSize = TTileSize;
+
+public:
+
+    TiledBuffer2D(
+        size_type size,
+        TElement fillValue)
+        : mSize(size)
+        , mTileCountX(CalculateTileCount(size.width))
+        , mTileCountY(CalculateTileCount(size.height))
+        , mTiles()
+    {
+        // All tiles start out sharing the same content
+        auto const fillTile = MakeTile();
+        std::fill(fillTile.get(), fillTile.get() + TileSize * TileSize, fillValue);
+
+        mTiles.resize(static_cast<size_t>(mTileCountX) * mTileCountY, fillTile);
+    }
+
+    explicit TiledBuffer2D(buffer_type const & source)
+        : mSize(source.Size)
+        , mTileCountX(CalculateTileCount(source.Size.width))
+        , mTileCountY(CalculateTileCount(source.Size.height))
+        , mTiles(static_cast<size_t>(mTileCountX) * mTileCountY)
+    {
+        for (int tileY = 0; tileY < mTileCountY; ++tileY)
+        {
+            for (int tileX = 0; tileX < mTileCountX; ++tileX)
+            {
+                auto & tile = mTiles[GetTileIndex(tileX, tileY)];
+                tile = MakeTile();
+                CopyTileFrom(source, tileX, tileY, tile.get());
+            }
+        }
+    }
+
+    TiledBuffer2D(TiledBuffer2D && other) = default;
+    TiledBuffer2D & operator=(TiledBuffer2D && other) = default;
+
+    size_type const & GetSize() const
+    {
+        return mSize;
+    }
+
+    inline TElement const & operator[](coordinates_type const & index) const
+    {
+        assert(index.IsInSize(mSize));
+
+        return mTiles[GetTileIndex(index.x / TileSize, index.y / TileSize)][GetInTileIndex(index.x % TileSize, index.y % TileSize)];
+    }
+
+    void SetElement(
+        coordinates_type const & index,
+        TElement const & value)
+    {
+        assert(index.IsInSize(mSize));
+
+        TElement * const tile = MakeTileExclusive(index.x / TileSize, index.y / TileSize);
+        tile[GetInTileIndex(index.x % TileSize, index.y % TileSize)] = value;
+    }
+
+    /*
+     * Makes a clone sharing all tiles with this buffer.
+     */
+    TiledBuffer2D Clone() const
+    {
+        return TiledBuffer2D(mSize, mTileCountX, mTileCountY, mTiles);
+    }
+
+    /*
+     * Makes a flat copy of the specified region.
+     */
+    buffer_type CloneRegion(rect_type const & region) const
+    {
+        assert(region.IsContainedInRect(rect_type(mSize)));
+
+        buffer_type result(region.size);
+
+        CopyRegionTo(region, result.Data.get());
+
+        return result;
+    }
+
+    /*
+     * Makes a flat copy of the whole buffer.
+     */
+    buffer_type ToBuffer2D() const
+    {
+        return CloneRegion(rect_type(mSize));
+    }
+
+    /*
+     * Re-syncs this buffer with the specified region of a flat buffer of the same size;
+     * only tiles overlapping the region are touched, and they get their own copy
+     * if they were shared.
+     */
+    void UpdateFrom(
+        buffer_type const & source,
+        rect_type const & region)
+    {
+        assert(source.Size == mSize);
+        assert(region.IsContainedInRect(rect_type(mSize)));
+
+        if (region.IsEmpty())
+        {
+            return;
+        }
+
+        int const tileXStart = region.origin.x / TileSize;
+        int const tileXEnd = (region.origin.x + region.size.width - 1) / TileSize + 1;
+        int const tileYStart = region.origin.y / TileSize;
+        int const tileYEnd = (region.origin.y + region.size.height - 1) / TileSize + 1;
+
+        for (int tileY = tileYStart; tileY < tileYEnd; ++tileY)
+        {
+            for (int tileX = tileXStart; tileX < tileXEnd; ++tileX)
+            {
+                auto & tile = mTiles[GetTileIndex(tileX, tileY)];
+
+                // We overwrite the whole tile, hence there's no need to copy it when shared
+                if (tile.use_count() != 1)
+                {
+                    tile = MakeTile();
+                }
+
+                CopyTileFrom(source, tileX, tileY, tile.get());
+            }
+        }
+    }
+
+private:
+
+    using tile_ptr = std::shared_ptr<TElement[]>;
+
+    TiledBuffer2D(
+        size_type size,
+        int tileCountX,
+        int tileCountY,
+        std::vector<tile_ptr> const & tiles)
+        : mSize(size)
+        , mTileCountX(tileCountX)
+        , mTileCountY(tileCountY)
+        , mTiles(tiles)
+    {}
+
+    static int CalculateTileCount(int length)
+    {
+        return (length + TileSize - 1) / TileSize;
+    }
+
+    static tile_ptr MakeTile()
+    {
+        return tile_ptr(new TElement[TileSize * TileSize]);
+    }
+
+    inline size_t GetTileIndex(int tileX, int tileY) const
+    {
+        return static_cast<size_t>(tileY) * mTileCountX + tileX;
+    }
+
+    static inline size_t GetInTileIndex(int inTileX, int inTileY)
+    {
+        return static_cast<size_t>(inTileY) * TileSize + inTileX;
+    }
+
+    TElement * MakeTileExclusive(int tileX, int tileY)
+    {
+        auto & tile = mTiles[GetTileIndex(tileX, tileY)];
+        if (tile.use_count() != 1)
+        {
+            auto newTile = MakeTile();
+            std::copy(tile.get(), tile.get() + TileSize * TileSize, newTile.get());
+            tile = std::move(newTile);
+        }
+
+        return tile.get();
+    }
+
+    void CopyTileFrom(
+        buffer_type const & source,
+        int tileX,
+        int tileY,
+        TElement * restrict tile) const
+    {
+        int const x = tileX * TileSize;
+        int const width = std::min(TileSize, mSize.width - x);
+        int const y = tileY * TileSize;
+        int const height = std::min(TileSize, mSize.height - y);
+
+        for (int r = 0; r < height; ++r)
+        {
+            TElement const * const srcRow = source.Data.get() + static_cast<size_t>(y + r) * mSize.width + x;
+            std::copy(srcRow, srcRow + width, tile + GetInTileIndex(0, r));
+        }
+    }
+
+    void CopyRegionTo(
+        rect_type const & region,
+        TElement * restrict target) const
+    {
+        for (int y = region.origin.y; y < region.origin.y + region.size.height; ++y)
+        {
+            int const tileY = y / TileSize;
+            int const inTileY = y % TileSize;
+
+            // Copy the row in chunks, one per tile it crosses
+            for (int x = region.origin.x; x < region.origin.x + region.size.width; )
+            {
+                int const tileX = x / TileSize;
+                int const inTileX = x % TileSize;
+                int const chunkWidth = std::min(TileSize - inTileX, region.origin.x + region.size.width - x);
+
+                TElement const * const tileRow = mTiles[GetTileIndex(tileX, tileY)].get() + GetInTileIndex(inTileX, inTileY);
+                target = std::copy(tileRow, tileRow + chunkWidth, target);
+
+                x += chunkWidth;
+            }
+        }
+    }
+
+private:
+
+    size_type mSize;
+
+    int mTileCountX;
+    int mTileCountY;
+
+    std::vector<tile_ptr> mTiles;
+};
+
+/*
+ * Tracks which tiles of a 2D buffer have been dirtied, so that consumers may
+ * process (e.g. upload) only those, instead of the bounding box of all changes.
+ */
+template<typename TIntegralTag, int TTileSize = 64>
+class DirtyTileMap
+{
+public:
+
+    using size_type = _IntegralSize<TIntegralTag>;
+    using rect_type = _IntegralRect<TIntegralTag>;
+    using coordinates_type = _IntegralCoordinates<TIntegralTag>;
+
+    static int constexpr TileSize = TTileSize;
+
+public:
+
+    DirtyTileMap()
+        : mBufferSize(0, 0)
+        , mTileCountX(0)
+        , mTileCountY(0)
+        , mDirtyTiles()
+        , mDirtyTileCount(0)
+    {}
+
+    bool IsEmpty() const
+    {
+        return mDirtyTileCount == 0;
+    }
+
+    size_t GetDirtyTileCount() const
+    {
+        return mDirtyTileCount;
+    }
+
+    /*
+     * Marks the tiles overlapping the region as dirty; a change in the size of the
+     * buffer starts the tracking afresh.
+     */
+    void MarkDirty(
+        rect_type const & region,
+        size_type const & bufferSize)
+    {
+        if (bufferSize != mBufferSize)
+        {
+            mBufferSize = bufferSize;
+            mTileCountX = (bufferSize.width + TileSize - 1) / TileSize;
+            mTileCountY = (bufferSize.height + TileSize - 1) / TileSize;
+            mDirtyTiles.assign(static_cast<size_t>(mTileCountX) * mTileCountY, false);
+            mDirtyTileCount = 0;
+        }
+
+        auto const clippedRegion = region.MakeIntersectionWith(rect_type(bufferSize));
+        if (!clippedRegion.has_value())
+        {
+            return;
+        }
+
+        int const tileXStart = clippedRegion->origin.x / TileSize;
+        int const tileXEnd = (clippedRegion->origin.x + clippedRegion->size.width - 1) / TileSize + 1;
+        int const tileYStart = clippedRegion->origin.y / TileSize;
+        int const tileYEnd = (clippedRegion->origin.y + clippedRegion->size.height - 1) / TileSize + 1;
+
+        for (int tileY = tileYStart; tileY < tileYEnd; ++tileY)
+        {
+            for (int tileX = tileXStart; tileX < tileXEnd; ++tileX)
+            {
+                size_t const tileIndex = static_cast<size_t>(tileY) * mTileCountX + tileX;
+                if (!mDirtyTiles[tileIndex])
+                {
+                    mDirtyTiles[tileIndex] = true;
+                    ++mDirtyTileCount;
+                }
+            }
+        }
+    }
+
+    /*
+     * Invokes the visitor with one rect for each horizontal run of dirty tiles,
+     * clipped to the size of the buffer.
+     */
+    template<typename TVisitor>
+    void VisitDirtyRuns(TVisitor && visitor) const
+    {
+        if (mDirtyTileCount == 0)
+        {
+            return;
+        }
+
+        for (int tileY = 0; tileY < mTileCountY; ++tileY)
+        {
+            int const y = tileY * TileSize;
+            int const height = std::min(TileSize, mBufferSize.height - y);
+
+            for (int tileX = 0; tileX < mTileCountX; )
+            {
+                if (!mDirtyTiles[static_cast<size_t>(tileY) * mTileCountX + tileX])
+                {
+                    ++tileX;
+                    continue;
+                }
+
+                int tileXEnd = tileX + 1;
+                while (tileXEnd < mTileCountX && mDirtyTiles[static_cast<size_t>(tileY) * mTileCountX + tileXEnd])
+                {
+                    ++tileXEnd;
+                }
+
+                int const x = tileX * TileSize;
+                int const width = std::min(tileXEnd * TileSize, mBufferSize.width) - x;
+
+                visitor(rect_type(coordinates_type(x, y), size_type(width, height)));
+
+                tileX = tileXEnd;
+            }
+        }
+    }
+
+    void Clear()
+    {
+        std::fill(mDirtyTiles.begin(), mDirtyTiles.end(), false);
+        mDirtyTileCount = 0;
+    }
+
+private:
+
+    size_type mBufferSize;
+    int mTileCountX;
+    int mTileCountY;
+    std::vector<bool> mDirtyTiles;
+    size_t mDirtyTileCount;
+};
@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #include "GameOpenGL.h"
 
+#include <GameCore/ImageTools.h>
 #include <GameCore/SysSpecifics.h>
 
 #include <algorithm>
@@ -296,71 +297,19 @@ void GameOpenGL::UploadMipmappedTexture(
     // Create minified textures
     //
 
-    ImageSize readImageSize(baseTexture.Size);
+    RgbaImageData level = std::move(baseTexture);
 
-    std::unique_ptr<rgbaColor[]> readBuffer(std::move(baseTexture.Data));
-    std::unique_ptr<rgbaColor[]> writeBuffer = std::make_unique<rgbaColor[]>(
-        std::max(
-            1,
-            (readImageSize.width / 2) * (readImageSize.height / 2)));
-
-    for (GLint textureLevel = 1; ; ++textureLevel)
+    for (GLint textureLevel = 1; level.Size.width > 1 || level.Size.height > 1; ++textureLevel)
     {
-        if (readImageSize.width == 1 && readImageSize.height == 1)
-        {
-            // We're done!
-            break;
-        }
-
-        // Calculate dimensions of new write buffer
-        int width = std::max(1, readImageSize.width / 2);
-        int height = std::max(1, readImageSize.height / 2);
-
-        // Create new buffer
-        rgbaColor const * rp = readBuffer.get();
-        rgbaColor * wp = writeBuffer.get();
-        for (int h = 0; h < height; ++h)
-        {
-            int const baseWriteIndex = h * width;
-            int const baseReadIndex = (h * 2) * readImageSize.width;
-            int const baseReadIndexNextLine = (h * 2 + 1) * readImageSize.width;
-            for (int w = 0; w < width; ++w)
-            {
-                //
-                // Apply box filter
-                //
+        // Apply box filter
+        level = ImageTools::DownscaleBox2x(level);
 
-                int const rIndex = baseReadIndex + (w * 2);
-                int const rIndexNextLine = baseReadIndexNextLine + (w * 2);
-
-                rgbaColorAccumulation sum(rp[rIndex]);
-
-                if (readImageSize.width > 1)
-                    sum += rp[rIndex + 1];
-
-                if (readImageSize.height > 1)
-                {
-                    sum += rp[rIndexNextLine];
-
-                    if (readImageSize.width > 1)
-                        sum += rp[rIndexNextLine + 1];
-                }
-
-                wp[baseWriteIndex + w] = sum.toRgbaColor();
-            }
-        }
-
-        // Upload write buffer
-        glTexImage2D(GL_TEXTURE_2D, textureLevel, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, writeBuffer.get());
+        glTexImage2D(GL_TEXTURE_2D, textureLevel, internalFormat, level.Size.width, level.Size.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.Data.get());
         glError = glGetError();
         if (GL_NO_ERROR != glError)
         {
             throw GameException("Error uploading minified texture onto GPU: " + std::to_string(glError));
         }
-
-        // Swap buffers
-        readImageSize = ImageSize(width, height);
-        readBuffer.swap(writeBuffer);
     }
 }
 
@@ -394,51 +343,17 @@ void GameOpenGL::UploadMipmappedPowerOfTwoTexture(
     // Create minified textures
     //
 
-    std::unique_ptr<rgbaColor const[]> readBuffer(std::move(baseTexture.Data));
-    std::unique_ptr<rgbaColor[]> writeBuffer;
+    RgbaImageData level = std::move(baseTexture);
 
     GLint lastUploadedTextureLevel = 0;
     for (int divisor = 2; maxDimension / divisor >= 1; divisor *= 2)
     {
-        // Calculate dimensions of new write buffer
-        int newWidth = std::max(1, baseTexture.Size.width / divisor);
-        int newHeight = std::max(1, baseTexture.Size.height / divisor);
-
-        // Allocate new write buffer
-        writeBuffer.reset(new rgbaColor[newWidth * newHeight]);
-
-        // Populate write buffer
-        rgbaColor const * rp = readBuffer.get();
-        rgbaColor * wp = writeBuffer.get();
-        for (int h = 0; h < newHeight; ++h)
-        {
-            size_t frameIndexInReadBuffer = (h * 2) * (newWidth * 2);
-            size_t frameIndexInWriteBuffer = (h) * (newWidth);
-
-            for (int w = 0; w < newWidth; ++w)
-            {
-                //
-                // Calculate and store average of the four neighboring pixels whose bottom-left corner is at (w*2, h*2)
-                //
+        // Apply box filter
+        level = ImageTools::DownscaleBox2x(level);
 
-                rgbaColorAccumulation sum;
-
-                sum += rp[frameIndexInReadBuffer + w * 2];
-                sum += rp[frameIndexInReadBuffer + w * 2 + 1];
-                sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2];
-                sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2 + 1];
-
-                wp[frameIndexInWriteBuffer + w] = sum.toRgbaColor();
-            }
-        }
-
-        // Upload write buffer
         ++lastUploadedTextureLevel;
-        glTexImage2D(GL_TEXTURE_2D, lastUploadedTextureLevel, GL_RGBA, newWidth, newHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, writeBuffer.get());
+        glTexImage2D(GL_TEXTURE_2D, lastUploadedTextureLevel, GL_RGBA, level.Size.width, level.Size.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.Data.get());
         CheckOpenGLError();
-
-        // Swap buffer
-        readBuffer = std::move(writeBuffer);
     }
 
     // Set max mipmap level
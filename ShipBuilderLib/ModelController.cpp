@@ -5,8 +5,12 @@
 ***************************************************************************************/
 #include "ModelController.h"
 
+#include <GameCore/ImageTools.h>
+#include <GameCore/ScanlineFill.h>
+
 #include <cassert>
-#include <queue>
+#include <tuple>
+#include <vector>
 
 namespace ShipBuilder {
 
@@ -45,6 +49,8 @@ ModelController::ModelController(
     , mCenterOfMassSum(vec2f::zero())
     , mInstancedElectricalElementSet()
     , mElectricalParticleCount(0)
+    , mValidationCache()
+    , mThreadManager()
     /////
     , mGameVisualizationMode(GameVisualizationModeType::None)
     , mGameVisualizationAutoTexturizationTexture()
@@ -142,6 +148,8 @@ ModelValidationSession ModelController::StartValidation(Finalizer && finalizer)
 {
     return ModelValidationSession(
         mModel,
+        mValidationCache,
+        GetThreadPool(),
         std::move(finalizer));
 }
 
@@ -2381,18 +2389,32 @@ void ModelController::UpdateVisualizations(View & view)
             if (*mDirtyTextureLayerVisualizationRegion != ImageRect(mModel.GetTextureLayer().Buffer.Size))
             {
                 //
-                // For better performance, we only upload the dirty sub-texture
+                // For better performance, we only upload the dirty sub-textures, one
+                // for each run of dirty tiles - so that scattered edits don't end up
+                // uploading their whole bounding box
                 //
 
-                auto subTexture = RgbaImageData(mDirtyTextureLayerVisualizationRegion->size);
-                subTexture.BlitFromRegion(
-                    mModel.GetTextureLayer().Buffer,
-                    *mDirtyTextureLayerVisualizationRegion,
-                    { 0, 0 });
-
-                view.UpdateTextureLayerVisualization(
-                    subTexture,
-                    mDirtyTextureLayerVisualizationRegion->origin);
+                auto const uploadSubTexture = [&](ImageRect const & region)
+                {
+                    auto subTexture = RgbaImageData(region.size);
+                    subTexture.BlitFromRegion(
+                        mModel.GetTextureLayer().Buffer,
+                        region,
+                        { 0, 0 });
+
+                    view.UpdateTextureLayerVisualization(
+                        subTexture,
+                        region.origin);
+                };
+
+                if (!mDirtyTextureLayerVisualizationTiles.IsEmpty())
+                {
+                    mDirtyTextureLayerVisualizationTiles.VisitDirtyRuns(uploadSubTexture);
+                }
+                else
+                {
+                    uploadSubTexture(*mDirtyTextureLayerVisualizationRegion);
+                }
             }
             else
             {
@@ -2410,6 +2432,7 @@ void ModelController::UpdateVisualizations(View & view)
     }
 
     mDirtyTextureLayerVisualizationRegion.reset();
+    mDirtyTextureLayerVisualizationTiles.Clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2719,47 +2742,22 @@ std::optional<ShipSpaceRect> ModelController::DoFlood(
         // Flood from point
         //
 
-        //
-        // Init visit from this point
-        //
-
-        WriteParticle(start, material);
-        ShipSpaceRect affectedRect(start);
-
-        std::queue<ShipSpaceCoordinates> pointsToPropagateFrom;
-        pointsToPropagateFrom.push(start);
+        ScanlineFill<ShipSpaceTag> fill(shipSize);
 
-        //
-        // Propagate
-        //
-
-        auto const checkPropagateToNeighbor = [&](ShipSpaceCoordinates neighborCoords)
-        {
-            if (neighborCoords.IsInSize(shipSize) && layer.Buffer[neighborCoords].Material == startMaterial)
+        return fill.Fill(
+            start,
+            ScanlineFill<ShipSpaceTag>::ConnectivityType::Four,
+            [&](int x, int y) -> bool
             {
-                // Visit point
-                WriteParticle(neighborCoords, material);
-                affectedRect.UnionWith(neighborCoords);
-
-                // Propagate from point
-                pointsToPropagateFrom.push(neighborCoords);
-            }
-        };
-
-        while (!pointsToPropagateFrom.empty())
-        {
-            // Pop point that we have to propagate from
-            auto const currentPoint = pointsToPropagateFrom.front();
-            pointsToPropagateFrom.pop();
-
-            // Push neighbors
-            checkPropagateToNeighbor({ currentPoint.x - 1, currentPoint.y });
-            checkPropagateToNeighbor({ currentPoint.x + 1, currentPoint.y });
-            checkPropagateToNeighbor({ currentPoint.x, currentPoint.y - 1 });
-            checkPropagateToNeighbor({ currentPoint.x, currentPoint.y + 1 });
-        }
-
-        return affectedRect;
+                return layer.Buffer[{x, y}].Material == startMaterial;
+            },
+            [&](int y, int xStart, int xEnd)
+            {
+                for (int x = xStart; x < xEnd; ++x)
+                {
+                    WriteParticle({ x, y }, material);
+                }
+            });
     }
     else
     {
@@ -2819,40 +2817,40 @@ std::optional<ImageRect> ModelController::DoTextureMagicWandEraseBackground(
         return std::nullopt;
     }
 
-    vec3f const seedColor = seedColorRgb.toVec3f();
+    //
+    // Find pixels to erase - each one exists and is within tolerance from the seed.
+    //
+    // Matches are calculated one whole row at a time, when a row is first needed.
+    //
+
+    std::uint8_t constexpr NotCalculated = 0xff;
+    Buffer2D<std::uint8_t, ImageTag> matches(textureSize, NotCalculated); // 0: no match; 1: match
 
-    // Our distance function - from https://www.photoshopgurus.com/forum/threads/tolerance.52555/page-2
-    auto const distanceFromSeed = [seedColor](vec3f const & sampleColor) -> float
+    auto const isMatch = [&](int x, int y) -> bool
     {
-        vec3f const deltaColor = (sampleColor - seedColor).abs();
+        size_t const rowStartIndex = static_cast<size_t>(y) * textureSize.width;
+
+        if (matches.Data[rowStartIndex] == NotCalculated)
+        {
+            ImageTools::MatchColorWithinTolerance(
+                layer.Buffer.Data.get() + rowStartIndex,
+                textureSize.width,
+                seedColorRgb,
+                tolerance,
+                matches.Data.get() + rowStartIndex);
+        }
 
-        return std::max({
-            deltaColor.x,
-            deltaColor.y,
-            deltaColor.z,
-            std::abs(deltaColor.x - deltaColor.y),
-            std::abs(deltaColor.y - deltaColor.z),
-            std::abs(deltaColor.z - deltaColor.x) });
+        return matches.Data[rowStartIndex + x] != 0;
     };
 
-    // Transform tolerance into max distance (included)
-    float const maxColorDistance = static_cast<float>(tolerance) / 100.0f;
+    ScanlineFill<ImageTag> fill(textureSize);
 
-    // Save original alpha mask for neighbors
-    Buffer2D<typename rgbaColor::data_type, ImageTag> originalAlphaMask = layer.Buffer.Transform<typename rgbaColor::data_type>(
-        [](rgbaColor const & color) -> typename rgbaColor::data_type
-        {
-            return color.a;
-        });
+    // Runs of pixels to erase, as (y, xStart, xEnd)
+    std::vector<std::tuple<int, int, int>> spansToErase;
 
-    // Initialize affected region
-    ImageRect affectedRegion(start); // We're sure we'll erase the start pixel
-
-    // Anti-alias functor
-    auto const doAntiAliasNeighbor = [&](ImageCoordinates const & neighborCoordinates) -> void
+    auto const onSpan = [&](int y, int xStart, int xEnd)
     {
-        layer.Buffer[neighborCoordinates].a = originalAlphaMask[neighborCoordinates] / 3;
-        affectedRegion.UnionWith(neighborCoordinates);
+        spansToErase.emplace_back(y, xStart, xEnd);
     };
 
     if (doContiguousOnly)
@@ -2861,48 +2859,11 @@ std::optional<ImageRect> ModelController::DoTextureMagicWandEraseBackground(
         // Flood from starting point
         //
 
-        std::queue<ImageCoordinates> pixelsToPropagateFrom;
-
-        // Erase this pixel
-        layer.Buffer[start].a = 0;
-        affectedRegion.UnionWith(start);
-
-        // Visit from here
-        pixelsToPropagateFrom.push(start);
-
-        while (!pixelsToPropagateFrom.empty())
-        {
-            auto const sourceCoords = pixelsToPropagateFrom.front();
-            pixelsToPropagateFrom.pop();
-
-            // Check neighbors
-            for (int yn = sourceCoords.y - 1; yn <= sourceCoords.y + 1; ++yn)
-            {
-                for (int xn = sourceCoords.x - 1; xn <= sourceCoords.x + 1; ++xn)
-                {
-                    ImageCoordinates const neighborCoordinates{ xn, yn };
-                    if (neighborCoordinates.IsInSize(textureSize)
-                        && layer.Buffer[neighborCoordinates].a != 0)
-                    {
-                        // Check distance
-                        if (distanceFromSeed(layer.Buffer[neighborCoordinates].toVec3f()) <= maxColorDistance)
-                        {
-                            // Erase this pixel
-                            layer.Buffer[neighborCoordinates].a = 0;
-                            affectedRegion.UnionWith(neighborCoordinates);
-
-                            // Continue visit from here
-                            pixelsToPropagateFrom.push(neighborCoordinates);
-                        }
-                        else if (isAntiAlias)
-                        {
-                            // Anti-alias this neighbor
-                            doAntiAliasNeighbor(neighborCoordinates);
-                        }
-                    }
-                }
-            }
-        }
+        fill.Fill(
+            start,
+            ScanlineFill<ImageTag>::ConnectivityType::Eight,
+            isMatch,
+            onSpan);
     }
     else
     {
@@ -2914,40 +2875,68 @@ std::optional<ImageRect> ModelController::DoTextureMagicWandEraseBackground(
         {
             for (int x = 0; x < textureSize.width; ++x)
             {
-                ImageCoordinates const sampleCoordinates{ x, y };
-
-                if (layer.Buffer[sampleCoordinates].a != 0
-                    && distanceFromSeed(layer.Buffer[sampleCoordinates].toVec3f()) <= maxColorDistance)
+                if (!fill.GetFilledMask().Get(x, y) && isMatch(x, y))
                 {
-                    // Erase
-                    layer.Buffer[sampleCoordinates].a = 0;
-                    affectedRegion.UnionWith(sampleCoordinates);
+                    fill.Fill(
+                        { x, y },
+                        ScanlineFill<ImageTag>::ConnectivityType::Eight,
+                        isMatch,
+                        onSpan);
+                }
+            }
+        }
+    }
 
-                    if (isAntiAlias)
-                    {
-                        //
-                        // Do anti-aliasing on neighboring, too-distant pixels
-                        //
+    Buffer2DMask<ImageTag> const & toEraseMask = fill.GetFilledMask();
 
-                        for (int yn = y - 1; yn <= y + 1; ++yn)
-                        {
-                            for (int xn = x - 1; xn <= x + 1; ++xn)
-                            {
-                                ImageCoordinates const neighborCoordinates{ xn, yn };
-                                if (neighborCoordinates.IsInSize(textureSize)
-                                    && layer.Buffer[neighborCoordinates].a != 0
-                                    && distanceFromSeed(layer.Buffer[neighborCoordinates].toVec3f()) > maxColorDistance)
-                                {
-                                    doAntiAliasNeighbor(neighborCoordinates);
-                                }
-                            }
-                        }
+    // Initialize affected region
+    ImageRect affectedRegion(start); // We're sure we'll erase the start pixel
+
+    //
+    // Anti-alias existing neighbors of erased pixels; since erased pixels are
+    // all matching pixels adjacent to each other, these neighbors do not match.
+    //
+    // Done before erasing, as it's based on original alpha.
+    //
+
+    if (isAntiAlias)
+    {
+        Buffer2DMask<ImageTag> antiAliasedMask(textureSize);
+
+        for (auto const & [y, xStart, xEnd] : spansToErase)
+        {
+            for (int yn = std::max(y - 1, 0); yn <= std::min(y + 1, textureSize.height - 1); ++yn)
+            {
+                for (int xn = std::max(xStart - 1, 0); xn < std::min(xEnd + 1, textureSize.width); ++xn)
+                {
+                    ImageCoordinates const neighborCoordinates{ xn, yn };
+                    if (!toEraseMask.Get(neighborCoordinates)
+                        && !antiAliasedMask.Get(neighborCoordinates)
+                        && layer.Buffer[neighborCoordinates].a != 0)
+                    {
+                        layer.Buffer[neighborCoordinates].a /= 3;
+                        antiAliasedMask.Set(neighborCoordinates);
+                        affectedRegion.UnionWith(neighborCoordinates);
                     }
                 }
             }
         }
     }
 
+    //
+    // Erase
+    //
+
+    for (auto const & [y, xStart, xEnd] : spansToErase)
+    {
+        for (int x = xStart; x < xEnd; ++x)
+        {
+            layer.Buffer[{x, y}].a = 0;
+        }
+
+        affectedRegion.UnionWith(ImageRect(ImageCoordinates(xStart, y), ImageSize(xEnd - xStart, 1)));
+    }
+
     return affectedRegion;
 }
 
@@ -3217,6 +3206,8 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
         {
             mDirtyStructuralLayerVisualizationRegion->UnionWith(region);
         }
+
+        mValidationCache.InvalidateRegion(LayerType::Structural, region);
     }
     else if constexpr (TVisualization == VisualizationType::ElectricalLayer)
     {
@@ -3228,6 +3219,8 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
         {
             mDirtyElectricalLayerVisualizationRegion->UnionWith(region);
         }
+
+        mValidationCache.InvalidateRegion(LayerType::Electrical, region);
     }
     else if constexpr (TVisualization == VisualizationType::RopesLayer)
     {
@@ -3239,6 +3232,8 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
         {
             mDirtyRopesLayerVisualizationRegion->UnionWith(region);
         }
+
+        mValidationCache.InvalidateRegion(LayerType::Ropes, region);
     }
     else
     {
@@ -3252,6 +3247,11 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
         {
             mDirtyTextureLayerVisualizationRegion->UnionWith(region);
         }
+
+        if (mModel.HasLayer(LayerType::Texture))
+        {
+            mDirtyTextureLayerVisualizationTiles.MarkDirty(region, mModel.GetTextureLayer().Buffer.Size);
+        }
     }
 }
 
@@ -3275,7 +3275,8 @@ ImageRect ModelController::UpdateGameVisualization(ShipSpaceRect const & region)
             region,
             *mGameVisualizationAutoTexturizationTexture,
             mGameVisualizationTextureMagnificationFactor,
-            settings);
+            settings,
+            GetThreadPool());
 
         sourceTexture = mGameVisualizationAutoTexturizationTexture.get();
     }
@@ -3316,7 +3317,8 @@ ImageRect ModelController::UpdateGameVisualization(ShipSpaceRect const & region)
         effectiveRegion,
         *sourceTexture,
         *mGameVisualizationTexture,
-        mGameVisualizationTextureMagnificationFactor);
+        mGameVisualizationTextureMagnificationFactor,
+        GetThreadPool());
 
     //
     // 3. Return dirty image region
@@ -3466,4 +3468,16 @@ void ModelController::UpdateTextureLayerVisualization()
     }
 }
 
+ThreadPool & ModelController::GetThreadPool() const
+{
+    if (!mThreadManager)
+    {
+        mThreadManager = std::make_unique<ThreadManager>(
+            false,
+            ThreadManager::GetNumberOfProcessors());
+    }
+
+    return mThreadManager->GetSimulationThreadPool();
+}
+
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "IModelObservable.h"
 #include "InstancedElectricalElementSet.h"
 #include "Model.h"
+#include "ModelValidationCache.h"
 #include "ModelValidationSession.h"
 #include "ShipBuilderTypes.h"
 #include "View.h"
@@ -22,6 +23,8 @@
 #include <GameCore/Finalizer.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
+#include <GameCore/ThreadManager.h>
+#include <GameCore/TiledBuffer2D.h>
 
 #include <array>
 #include <functional>
@@ -594,6 +597,10 @@ private:
 
     void UpdateTextureLayerVisualization();
 
+    // Misc
+
+    ThreadPool & GetThreadPool() const;
+
 private:
 
     Model mModel;
@@ -611,6 +618,16 @@ private:
     InstancedElectricalElementSet mInstancedElectricalElementSet;
     size_t mElectricalParticleCount;
 
+    //
+    // Validation
+    //
+
+    // Invalidated by the regions we dirty; mutable as it's updated by (const) validation sessions
+    ModelValidationCache mutable mValidationCache;
+
+    // Created on demand
+    std::unique_ptr<ThreadManager> mutable mThreadManager;
+
     //
     // Visualizations
     //
@@ -636,6 +653,7 @@ private:
     std::optional<ShipSpaceRect> mDirtyElectricalLayerVisualizationRegion;
     std::optional<ShipSpaceRect> mDirtyRopesLayerVisualizationRegion;
     std::optional<ImageRect> mDirtyTextureLayerVisualizationRegion;
+    DirtyTileMap<ImageTag> mDirtyTextureLayerVisualizationTiles; // Finer-grained than the region above
 
     //
     // Debugging
@@ -0,0 +1,672 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-02-26
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ModelValidationCache.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ShipBuilder {
+
+ModelValidationCache::ModelValidationCache()
+    : mShipSize(0, 0)
+    , mBlockCountX(0)
+    , mBlockCountY(0)
+    , mBlocks()
+    , mHasStructuralLayer(false)
+    , mHasElectricalLayer(false)
+    , mHasRopesLayer(false)
+    , mElectricalConnectivity()
+    , mElectricalConnectivityVisitBuffer()
+    , mEngineConnectivityVisitBuffer()
+{
+}
+
+void ModelValidationCache::InvalidateRegion(
+    LayerType layer,
+    ShipSpaceRect const & region)
+{
+    if (layer == LayerType::Texture)
+    {
+        // Not validated
+        return;
+    }
+
+    auto const clippedRegion = region.MakeIntersectionWith(ShipSpaceRect(mShipSize));
+    if (!clippedRegion.has_value())
+    {
+        return;
+    }
+
+    int const blockXStart = clippedRegion->origin.x / BlockSize;
+    int const blockXEnd = (clippedRegion->origin.x + clippedRegion->size.width - 1) / BlockSize + 1;
+    int const blockYStart = clippedRegion->origin.y / BlockSize;
+    int const blockYEnd = (clippedRegion->origin.y + clippedRegion->size.height - 1) / BlockSize + 1;
+
+    for (int blockY = blockYStart; blockY < blockYEnd; ++blockY)
+    {
+        for (int blockX = blockXStart; blockX < blockXEnd; ++blockX)
+        {
+            Block & block = mBlocks[static_cast<size_t>(blockY) * mBlockCountX + blockX];
+
+            switch (layer)
+            {
+                case LayerType::Structural:
+                {
+                    block.IsStructuralValid = false;
+                    block.IsElectricalValid = false; // Substratum
+                    break;
+                }
+
+                case LayerType::Electrical:
+                case LayerType::Ropes:
+                {
+                    block.IsElectricalValid = false;
+                    break;
+                }
+
+                case LayerType::Texture:
+                {
+                    assert(false);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void ModelValidationCache::InvalidateAll()
+{
+    for (auto & block : mBlocks)
+    {
+        block.IsStructuralValid = false;
+        block.IsElectricalValid = false;
+    }
+
+    mElectricalConnectivity.reset();
+}
+
+void ModelValidationCache::UpdateLayerStatistics(
+    StructuralLayerData const * structuralLayer,
+    ElectricalLayerData const * electricalLayer,
+    RopesLayerData const * ropesLayer,
+    ThreadPool & threadPool)
+{
+    assert(electricalLayer == nullptr || structuralLayer != nullptr);
+
+    //
+    // Check whether the shape of the model has changed since the last time
+    //
+
+    ShipSpaceSize const shipSize = (structuralLayer != nullptr)
+        ? structuralLayer->Buffer.Size
+        : ((electricalLayer != nullptr) ? electricalLayer->Buffer.Size : mShipSize);
+
+    if (shipSize != mShipSize)
+    {
+        Reset(shipSize);
+    }
+
+    if ((structuralLayer != nullptr) != mHasStructuralLayer
+        || (electricalLayer != nullptr) != mHasElectricalLayer
+        || (ropesLayer != nullptr) != mHasRopesLayer)
+    {
+        InvalidateAll();
+
+        mHasStructuralLayer = (structuralLayer != nullptr);
+        mHasElectricalLayer = (electricalLayer != nullptr);
+        mHasRopesLayer = (ropesLayer != nullptr);
+    }
+
+    //
+    // Collect invalid blocks
+    //
+
+    std::vector<size_t> structuralBlocksToVisit;
+    std::vector<size_t> electricalBlocksToVisit;
+
+    for (size_t b = 0; b < mBlocks.size(); ++b)
+    {
+        if (structuralLayer != nullptr && !mBlocks[b].IsStructuralValid)
+        {
+            structuralBlocksToVisit.push_back(b);
+        }
+
+        if (electricalLayer != nullptr && !mBlocks[b].IsElectricalValid)
+        {
+            electricalBlocksToVisit.push_back(b);
+        }
+    }
+
+    if (structuralBlocksToVisit.empty() && electricalBlocksToVisit.empty())
+    {
+        return;
+    }
+
+    //
+    // Visit invalid blocks; each task visits a contiguous range of blocks of one layer,
+    // and blocks are independent of each other
+    //
+
+    size_t const parallelism = threadPool.GetParallelism();
+
+    std::vector<ThreadPool::Task> tasks;
+
+    if (!structuralBlocksToVisit.empty())
+    {
+        size_t const blocksPerTask = (structuralBlocksToVisit.size() + parallelism - 1) / parallelism;
+        for (size_t start = 0; start < structuralBlocksToVisit.size(); start += blocksPerTask)
+        {
+            size_t const end = std::min(start + blocksPerTask, structuralBlocksToVisit.size());
+
+            tasks.emplace_back(
+                [this, &structuralBlocksToVisit, start, end, structuralLayer]()
+                {
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        VisitStructuralBlock(structuralBlocksToVisit[i], *structuralLayer);
+                    }
+                });
+        }
+    }
+
+    // One per electrical block to visit, so that tasks don't share them
+    std::vector<std::uint8_t> haveElectricalElementsChanged(electricalBlocksToVisit.size(), 0);
+
+    if (!electricalBlocksToVisit.empty())
+    {
+        size_t const blocksPerTask = (electricalBlocksToVisit.size() + parallelism - 1) / parallelism;
+        for (size_t start = 0; start < electricalBlocksToVisit.size(); start += blocksPerTask)
+        {
+            size_t const end = std::min(start + blocksPerTask, electricalBlocksToVisit.size());
+
+            tasks.emplace_back(
+                [this, &electricalBlocksToVisit, &haveElectricalElementsChanged, start, end, structuralLayer, electricalLayer, ropesLayer]()
+                {
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        haveElectricalElementsChanged[i] = VisitElectricalBlock(electricalBlocksToVisit[i], *structuralLayer, *electricalLayer, ropesLayer)
+                            ? 1 : 0;
+                    }
+                });
+        }
+    }
+
+    threadPool.Run(tasks);
+
+    // Connectivity only depends on electrical elements; blocks invalidated by changes to
+    // the structure or ropes, or re-painted with the same materials, don't affect it
+    if (std::find(haveElectricalElementsChanged.cbegin(), haveElectricalElementsChanged.cend(), 1) != haveElectricalElementsChanged.cend())
+    {
+        mElectricalConnectivity.reset();
+    }
+}
+
+ModelValidationCache::StructuralStatistics ModelValidationCache::CalculateStructuralStatistics() const
+{
+    assert(mHasStructuralLayer);
+
+    StructuralStatistics statistics;
+
+    for (auto const & block : mBlocks)
+    {
+        assert(block.IsStructuralValid);
+        statistics.StructuralParticlesCount += block.StructuralParticlesCount;
+    }
+
+    return statistics;
+}
+
+ModelValidationCache::ElectricalStatistics ModelValidationCache::CalculateElectricalStatistics(ElectricalPanel const & electricalPanel) const
+{
+    assert(mHasElectricalLayer);
+
+    ElectricalStatistics statistics;
+
+    for (auto const & block : mBlocks)
+    {
+        assert(block.IsElectricalValid);
+
+        statistics.ElectricalParticlesWithNoStructuralSubstratumCount += block.ElectricalParticlesWithNoStructuralSubstratumCount;
+        statistics.LightEmittingParticlesCount += block.LightEmittingParticlesCount;
+
+        // Panel is not tracked by dirty regions, hence we check visibility now
+        for (auto const instanceIndex : block.InstancedElements)
+        {
+            if (auto const searchIt = electricalPanel.Find(instanceIndex);
+                searchIt == electricalPanel.end() || !searchIt->second.IsHidden)
+            {
+                ++statistics.VisibleElectricalPanelElementsCount;
+            }
+        }
+    }
+
+    return statistics;
+}
+
+ModelValidationCache::ElectricalConnectivity const & ModelValidationCache::UpdateElectricalConnectivity(ThreadPool & threadPool)
+{
+    assert(mHasElectricalLayer);
+
+    if (mElectricalConnectivity.has_value())
+    {
+        // Nothing has changed in the electrical layer
+        return *mElectricalConnectivity;
+    }
+
+    if (!mElectricalConnectivityVisitBuffer)
+    {
+        mElectricalConnectivityVisitBuffer = std::make_unique<ConnectivityVisitBuffer>(mShipSize, std::uint8_t(0));
+        mEngineConnectivityVisitBuffer = std::make_unique<ConnectivityVisitBuffer>(mShipSize, std::uint8_t(0));
+    }
+
+    ConnectivityVisitBuffer & electricalConnectivityVisitBuffer = *mElectricalConnectivityVisitBuffer;
+    ConnectivityVisitBuffer & engineConnectivityVisitBuffer = *mEngineConnectivityVisitBuffer;
+
+    ElectricalConnectivity connectivity;
+
+    //
+    // Pass 1: create collections of categories, and prepare connectivity visit buffers
+    //
+
+    std::vector<ShipSpaceCoordinates> electricalSources;
+    std::vector<ShipSpaceCoordinates> electricalComponents; // Anything that needs to be connected to a source; includes all consumers
+    std::vector<ShipSpaceCoordinates> electricalConsumers;
+    std::vector<ShipSpaceCoordinates> engineSources;
+    std::vector<ShipSpaceCoordinates> engineComponents; // Anything that needs to be connected to a source; incldues all consumers
+    std::vector<ShipSpaceCoordinates> engineConsumers;
+
+    auto const setConductive = [](ConnectivityVisitBuffer & buffer, ShipSpaceCoordinates const & coords, bool isConductive)
+    {
+        assert(buffer[coords] == 0); // Buffers are kept clear
+        buffer[coords] = isConductive ? IsConductiveFlag : 0;
+    };
+
+    for (auto const & block : mBlocks)
+    {
+        assert(block.IsElectricalValid);
+
+        for (auto const & element : block.ElectricalElements)
+        {
+            auto const & coords = element.Coords;
+            auto const electricalMaterial = element.Material;
+
+            switch (electricalMaterial->ElectricalType)
+            {
+                case ElectricalMaterial::ElectricalElementType::Cable:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, electricalMaterial->ConductsElectricity);
+                    setConductive(engineConnectivityVisitBuffer, coords, false);
+                    electricalComponents.push_back(coords);
+
+                    connectivity.HasElectricals = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::Engine:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, true); // Engines may be electrically conductive when they're working
+                    setConductive(engineConnectivityVisitBuffer, coords, true);
+                    engineComponents.push_back(coords);
+                    engineConsumers.push_back(coords);
+
+                    connectivity.HasEngines = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::EngineController:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, electricalMaterial->ConductsElectricity);
+                    setConductive(engineConnectivityVisitBuffer, coords, true);
+                    electricalComponents.push_back(coords);
+                    electricalConsumers.push_back(coords); // Controllers need electricity
+                    engineSources.push_back(coords);
+
+                    connectivity.HasElectricals = true;
+                    connectivity.HasEngines = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::EngineTransmission:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, electricalMaterial->ConductsElectricity);
+                    setConductive(engineConnectivityVisitBuffer, coords, true);
+                    engineComponents.push_back(coords);
+
+                    connectivity.HasEngines = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::Generator:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, electricalMaterial->ConductsElectricity);
+                    setConductive(engineConnectivityVisitBuffer, coords, false);
+                    electricalSources.push_back(coords);
+
+                    connectivity.HasElectricals = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::InteractiveSwitch:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, true);
+                    setConductive(engineConnectivityVisitBuffer, coords, false);
+                    electricalComponents.push_back(coords);
+
+                    connectivity.HasElectricals = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::Lamp:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, electricalMaterial->ConductsElectricity);
+                    setConductive(engineConnectivityVisitBuffer, coords, false);
+
+                    if (!electricalMaterial->IsSelfPowered)
+                    {
+                        electricalComponents.push_back(coords);
+                        electricalConsumers.push_back(coords);
+                    }
+
+                    connectivity.HasElectricals = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::OtherSink:
+                case ElectricalMaterial::ElectricalElementType::PowerMonitor:
+                case ElectricalMaterial::ElectricalElementType::SmokeEmitter:
+                case ElectricalMaterial::ElectricalElementType::WaterPump:
+                case ElectricalMaterial::ElectricalElementType::WatertightDoor:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, electricalMaterial->ConductsElectricity);
+                    setConductive(engineConnectivityVisitBuffer, coords, false);
+                    electricalComponents.push_back(coords);
+                    electricalConsumers.push_back(coords);
+
+                    connectivity.HasElectricals = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::ShipSound:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, true); // Acts as a switch
+                    setConductive(engineConnectivityVisitBuffer, coords, false);
+                    electricalComponents.push_back(coords);
+                    electricalConsumers.push_back(coords);
+
+                    connectivity.HasElectricals = true;
+                    break;
+                }
+
+                case ElectricalMaterial::ElectricalElementType::WaterSensingSwitch:
+                {
+                    setConductive(electricalConnectivityVisitBuffer, coords, true); // Acts as a switch
+                    setConductive(engineConnectivityVisitBuffer, coords, false);
+                    electricalComponents.push_back(coords);
+
+                    connectivity.HasElectricals = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    //
+    // Pass 2: do checks; electrical and engine networks are independent of each other,
+    // and each has its own visit buffer, hence we visit them concurrently
+    //
+
+    std::vector<ShipSpaceCoordinates> electricalVisitedCoords;
+    std::vector<ShipSpaceCoordinates> engineVisitedCoords;
+
+    std::vector<ThreadPool::Task> tasks;
+
+    if (connectivity.HasElectricals)
+    {
+        tasks.emplace_back(
+            [&]()
+            {
+                // Electrical components not connected to sources
+                connectivity.UnpoweredElectricalComponentCount = CountElectricallyUnconnected(
+                    electricalSources,
+                    electricalComponents,
+                    electricalConnectivityVisitBuffer,
+                    electricalVisitedCoords);
+
+                // Electrical sources not connected to any consumers
+                connectivity.UnconsumedElectricalSourceCount = CountElectricallyUnconnected(
+                    electricalConsumers,
+                    electricalSources,
+                    electricalConnectivityVisitBuffer,
+                    electricalVisitedCoords);
+            });
+    }
+
+    if (connectivity.HasEngines)
+    {
+        tasks.emplace_back(
+            [&]()
+            {
+                // Engine components not connected to sources
+                connectivity.UnpoweredEngineComponentCount = CountElectricallyUnconnected(
+                    engineSources,
+                    engineComponents,
+                    engineConnectivityVisitBuffer,
+                    engineVisitedCoords);
+
+                // Engine sources not connected to any consumers
+                connectivity.UnconsumedEngineSourceCount = CountElectricallyUnconnected(
+                    engineConsumers,
+                    engineSources,
+                    engineConnectivityVisitBuffer,
+                    engineVisitedCoords);
+            });
+    }
+
+    threadPool.Run(tasks);
+
+    //
+    // Pass 3: clear visit buffers; only element cells have been touched
+    //
+
+    for (auto const & block : mBlocks)
+    {
+        for (auto const & element : block.ElectricalElements)
+        {
+            electricalConnectivityVisitBuffer[element.Coords] = 0;
+            engineConnectivityVisitBuffer[element.Coords] = 0;
+        }
+    }
+
+    mElectricalConnectivity = connectivity;
+
+    return *mElectricalConnectivity;
+}
+
+///////////////////////////////////////////
+
+void ModelValidationCache::Reset(ShipSpaceSize const & shipSize)
+{
+    mShipSize = shipSize;
+    mBlockCountX = (shipSize.width + BlockSize - 1) / BlockSize;
+    mBlockCountY = (shipSize.height + BlockSize - 1) / BlockSize;
+
+    mBlocks.clear();
+    mBlocks.resize(static_cast<size_t>(mBlockCountX) * mBlockCountY);
+
+    mElectricalConnectivity.reset();
+    mElectricalConnectivityVisitBuffer.reset();
+    mEngineConnectivityVisitBuffer.reset();
+}
+
+ShipSpaceRect ModelValidationCache::GetBlockRect(size_t blockIndex) const
+{
+    int const blockX = static_cast<int>(blockIndex % mBlockCountX);
+    int const blockY = static_cast<int>(blockIndex / mBlockCountX);
+
+    ShipSpaceCoordinates const origin(blockX * BlockSize, blockY * BlockSize);
+
+    return ShipSpaceRect(
+        origin,
+        ShipSpaceSize(
+            std::min(BlockSize, mShipSize.width - origin.x),
+            std::min(BlockSize, mShipSize.height - origin.y)));
+}
+
+void ModelValidationCache::VisitStructuralBlock(
+    size_t blockIndex,
+    StructuralLayerData const & structuralLayer)
+{
+    assert(structuralLayer.Buffer.Size == mShipSize);
+
+    Block & block = mBlocks[blockIndex];
+    ShipSpaceRect const blockRect = GetBlockRect(blockIndex);
+
+    block.StructuralParticlesCount = 0;
+
+    for (int y = blockRect.origin.y; y < blockRect.origin.y + blockRect.size.height; ++y)
+    {
+        for (int x = blockRect.origin.x; x < blockRect.origin.x + blockRect.size.width; ++x)
+        {
+            if (structuralLayer.Buffer[{x, y}].Material != nullptr)
+            {
+                ++block.StructuralParticlesCount;
+            }
+        }
+    }
+
+    block.IsStructuralValid = true;
+}
+
+bool ModelValidationCache::VisitElectricalBlock(
+    size_t blockIndex,
+    StructuralLayerData const & structuralLayer,
+    ElectricalLayerData const & electricalLayer,
+    RopesLayerData const * ropesLayer)
+{
+    assert(structuralLayer.Buffer.Size == mShipSize);
+    assert(electricalLayer.Buffer.Size == mShipSize);
+
+    Block & block = mBlocks[blockIndex];
+    ShipSpaceRect const blockRect = GetBlockRect(blockIndex);
+
+    block.ElectricalParticlesWithNoStructuralSubstratumCount = 0;
+    block.LightEmittingParticlesCount = 0;
+    block.InstancedElements.clear();
+
+    std::vector<ElectricalElement> electricalElements;
+
+    for (int y = blockRect.origin.y; y < blockRect.origin.y + blockRect.size.height; ++y)
+    {
+        for (int x = blockRect.origin.x; x < blockRect.origin.x + blockRect.size.width; ++x)
+        {
+            auto const coords = ShipSpaceCoordinates(x, y);
+            auto const electricalMaterial = electricalLayer.Buffer[coords].Material;
+            if (electricalMaterial != nullptr)
+            {
+                if (structuralLayer.Buffer[coords].Material == nullptr
+                    && (ropesLayer == nullptr || !ropesLayer->Buffer.HasEndpointAt(coords)))
+                {
+                    ++block.ElectricalParticlesWithNoStructuralSubstratumCount;
+                }
+
+                if (electricalMaterial->Luminiscence != 0.0f)
+                {
+                    ++block.LightEmittingParticlesCount;
+                }
+
+                if (electricalMaterial->IsInstanced)
+                {
+                    assert(electricalLayer.Buffer[coords].InstanceIndex != NoneElectricalElementInstanceIndex);
+                    block.InstancedElements.push_back(electricalLayer.Buffer[coords].InstanceIndex);
+                }
+
+                electricalElements.emplace_back(coords, electricalMaterial);
+            }
+        }
+    }
+
+    bool const haveElectricalElementsChanged = (electricalElements != block.ElectricalElements);
+
+    block.ElectricalElements = std::move(electricalElements);
+    block.IsElectricalValid = true;
+
+    return haveElectricalElementsChanged;
+}
+
+size_t ModelValidationCache::CountElectricallyUnconnected(
+    std::vector<ShipSpaceCoordinates> const & propagationSources,
+    std::vector<ShipSpaceCoordinates> const & propagationTargets,
+    ConnectivityVisitBuffer & connectivityVisitBuffer,
+    std::vector<ShipSpaceCoordinates> & visitedCoords)
+{
+    // Clear previous visit; only the cells we've visited have the flag set
+    for (auto const & coords : visitedCoords)
+    {
+        connectivityVisitBuffer[coords] &= ~IsVisitedFlag;
+    }
+
+    visitedCoords.clear();
+
+    // Do visit; the visited coordinates double as the visit queue
+    for (auto const & sourceCoords : propagationSources)
+    {
+        // Make sure we haven't visited it already
+        if (!(connectivityVisitBuffer[sourceCoords] & IsVisitedFlag))
+        {
+            //
+            // Flood graph
+            //
+
+            // Mark starting point as visited
+            connectivityVisitBuffer[sourceCoords] |= IsVisitedFlag;
+
+            // Add source to queue
+            size_t queueHead = visitedCoords.size();
+            visitedCoords.push_back(sourceCoords);
+
+            // Visit all elements reachable from this source
+            while (queueHead < visitedCoords.size())
+            {
+                auto const coords = visitedCoords[queueHead++];
+
+                // Already marked as visited
+                assert(connectivityVisitBuffer[coords] & IsVisitedFlag);
+
+                // Visit neighbors
+                for (int yn = coords.y - 1; yn <= coords.y + 1; ++yn)
+                {
+                    for (int xn = coords.x - 1; xn <= coords.x + 1; ++xn)
+                    {
+                        ShipSpaceCoordinates const neighborCoordinates{ xn, yn };
+                        if (neighborCoordinates.IsInSize(connectivityVisitBuffer.Size)
+                            && connectivityVisitBuffer[neighborCoordinates] == IsConductiveFlag) // Conductive and not visited
+                        {
+                            // Mark it as visited
+                            connectivityVisitBuffer[neighborCoordinates] |= IsVisitedFlag;
+
+                            // Add to queue
+                            visitedCoords.push_back(neighborCoordinates);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Count unconnected
+    size_t unconnectedComponentsCount = 0;
+    for (auto const & targetCoords : propagationTargets)
+    {
+        if (!(connectivityVisitBuffer[targetCoords] & IsVisitedFlag))
+        {
+            ++unconnectedComponentsCount;
+        }
+    }
+
+    return unconnectedComponentsCount;
+}
+
+}
@@ -0,0 +1,213 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2024-02-26
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <Game/Layers.h>
+#include <Game/Materials.h>
+
+#include <GameCore/Buffer2D.h>
+#include <GameCore/GameTypes.h>
+#include <GameCore/ThreadPool.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace ShipBuilder {
+
+/*
+ * Caches the layer visits needed by model validation, so that re-validating the model
+ * after an edit only re-visits the parts of the layers that have changed since the
+ * previous validation.
+ *
+ * Layers are partitioned into square blocks, each caching its own statistics; blocks
+ * are invalidated by the ModelController for the regions it dirties, and invalid blocks
+ * are re-visited concurrently at the next validation.
+ *
+ * Electrical connectivity is global, hence it's cached as a whole and re-calculated
+ * when any part of the electrical layer changes; its cost is however proportional
+ * to the number of electrical elements, rather than to the size of the ship.
+ */
+class ModelValidationCache final
+{
+public:
+
+    struct StructuralStatistics
+    {
+        size_t StructuralParticlesCount;
+
+        StructuralStatistics()
+            : StructuralParticlesCount(0)
+        {}
+    };
+
+    struct ElectricalStatistics
+    {
+        size_t ElectricalParticlesWithNoStructuralSubstratumCount;
+        size_t LightEmittingParticlesCount;
+        size_t VisibleElectricalPanelElementsCount;
+
+        ElectricalStatistics()
+            : ElectricalParticlesWithNoStructuralSubstratumCount(0)
+            , LightEmittingParticlesCount(0)
+            , VisibleElectricalPanelElementsCount(0)
+        {}
+    };
+
+    struct ElectricalConnectivity
+    {
+        bool HasElectricals;
+        bool HasEngines;
+
+        size_t UnpoweredElectricalComponentCount;
+        size_t UnconsumedElectricalSourceCount;
+        size_t UnpoweredEngineComponentCount;
+        size_t UnconsumedEngineSourceCount;
+
+        ElectricalConnectivity()
+            : HasElectricals(false)
+            , HasEngines(false)
+            , UnpoweredElectricalComponentCount(0)
+            , UnconsumedElectricalSourceCount(0)
+            , UnpoweredEngineComponentCount(0)
+            , UnconsumedEngineSourceCount(0)
+        {}
+    };
+
+public:
+
+    ModelValidationCache();
+
+    /*
+     * Invalidates whatever has been calculated for the specified region of the specified layer.
+     */
+    void InvalidateRegion(
+        LayerType layer,
+        ShipSpaceRect const & region);
+
+    void InvalidateAll();
+
+    /*
+     * Re-visits all invalid blocks of the layers, concurrently.
+     *
+     * The structural layer is required when the electrical layer is specified.
+     */
+    void UpdateLayerStatistics(
+        StructuralLayerData const * structuralLayer,
+        ElectricalLayerData const * electricalLayer,
+        RopesLayerData const * ropesLayer,
+        ThreadPool & threadPool);
+
+    StructuralStatistics CalculateStructuralStatistics() const;
+
+    ElectricalStatistics CalculateElectricalStatistics(ElectricalPanel const & electricalPanel) const;
+
+    /*
+     * Requires electrical statistics to be up-to-date.
+     */
+    ElectricalConnectivity const & UpdateElectricalConnectivity(ThreadPool & threadPool);
+
+private:
+
+    static int constexpr BlockSize = 32;
+
+    struct ElectricalElement
+    {
+        ShipSpaceCoordinates Coords;
+        ElectricalMaterial const * Material;
+
+        ElectricalElement(
+            ShipSpaceCoordinates const & coords,
+            ElectricalMaterial const * material)
+            : Coords(coords)
+            , Material(material)
+        {}
+
+        bool operator==(ElectricalElement const & other) const
+        {
+            return Coords == other.Coords
+                && Material == other.Material;
+        }
+
+        bool operator!=(ElectricalElement const & other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    struct Block
+    {
+        // Depends on structural layer
+        bool IsStructuralValid;
+        size_t StructuralParticlesCount;
+
+        // Depends on electrical, structural, and ropes layers
+        bool IsElectricalValid;
+        size_t ElectricalParticlesWithNoStructuralSubstratumCount;
+        size_t LightEmittingParticlesCount;
+        std::vector<ElectricalElementInstanceIndex> InstancedElements;
+        std::vector<ElectricalElement> ElectricalElements;
+
+        Block()
+            : IsStructuralValid(false)
+            , StructuralParticlesCount(0)
+            , IsElectricalValid(false)
+            , ElectricalParticlesWithNoStructuralSubstratumCount(0)
+            , LightEmittingParticlesCount(0)
+            , InstancedElements()
+            , ElectricalElements()
+        {}
+    };
+
+    // Connectivity visit flags
+    static std::uint8_t constexpr IsConductiveFlag = 0x01;
+    static std::uint8_t constexpr IsVisitedFlag = 0x02;
+
+    using ConnectivityVisitBuffer = Buffer2D<std::uint8_t, ShipSpaceTag>;
+
+    void Reset(ShipSpaceSize const & shipSize);
+
+    ShipSpaceRect GetBlockRect(size_t blockIndex) const;
+
+    void VisitStructuralBlock(
+        size_t blockIndex,
+        StructuralLayerData const & structuralLayer);
+
+    // Returns whether the electrical elements in the block have changed
+    bool VisitElectricalBlock(
+        size_t blockIndex,
+        StructuralLayerData const & structuralLayer,
+        ElectricalLayerData const & electricalLayer,
+        RopesLayerData const * ropesLayer);
+
+    static size_t CountElectricallyUnconnected(
+        std::vector<ShipSpaceCoordinates> const & propagationSources,
+        std::vector<ShipSpaceCoordinates> const & propagationTargets,
+        ConnectivityVisitBuffer & connectivityVisitBuffer,
+        std::vector<ShipSpaceCoordinates> & visitedCoords);
+
+private:
+
+    ShipSpaceSize mShipSize;
+    int mBlockCountX;
+    int mBlockCountY;
+    std::vector<Block> mBlocks;
+
+    // The layers we've last visited
+    bool mHasStructuralLayer;
+    bool mHasElectricalLayer;
+    bool mHasRopesLayer;
+
+    std::optional<ElectricalConnectivity> mElectricalConnectivity;
+
+    // Allocated once and kept clear between connectivity visits, so that
+    // visits only touch the cells of electrical elements
+    std::unique_ptr<ConnectivityVisitBuffer> mElectricalConnectivityVisitBuffer;
+    std::unique_ptr<ConnectivityVisitBuffer> mEngineConnectivityVisitBuffer;
+};
+
+}
@@ -6,11 +6,11 @@
 #pragma once
 
 #include "Model.h"
+#include "ModelValidationCache.h"
 #include "ModelValidationResults.h"
 
-#include <GameCore/Buffer2D.h>
 #include <GameCore/Finalizer.h>
-#include <GameCore/GameTypes.h>
+#include <GameCore/ThreadPool.h>
 
 #include <functional>
 #include <optional>
@@ -24,6 +24,8 @@ public:
 
     ModelValidationSession(
         Model const & model,
+        ModelValidationCache & validationCache,
+        ThreadPool & threadPool,
         Finalizer && finalizer);
 
     size_t GetNumberOfSteps()
@@ -41,6 +43,8 @@ public:
 private:
 
     Model const & mModel;
+    ModelValidationCache & mValidationCache;
+    ThreadPool & mThreadPool;
     Finalizer mFinalizer;
 
     //
@@ -51,38 +55,22 @@ private:
 
     size_t mCurrentStep;
 
-    size_t mStructuralParticlesCount;
-    size_t mElectricalParticlesWithNoStructuralSubstratumCount;
-    size_t mLightEmittingParticlesCount;
-    size_t mVisibleElectricalPanelElementsCount;
+    ModelValidationCache::StructuralStatistics mStructuralStatistics;
+    ModelValidationCache::ElectricalStatistics mElectricalStatistics;
 
     ModelValidationResults mResults;
 
 private:
 
-    struct ConnectivityFlags
-    {
-        unsigned isConductive : 1;
-        unsigned isVisited : 1;
-    };
-
-    union CVElement
-    {
-        std::uint8_t wholeElement;
-        ConnectivityFlags flags;
-    };
-
     // Initialize validations (can't do in cctor)
     void InitializeValidationSteps();
 
-    void PrevisitStructuralLayer();
+    void PrevisitLayers();
 
     void CheckEmptyStructuralLayer();
 
     void CheckStructureTooLarge();
 
-    void PrevisitElectricalLayer();
-
     void CheckElectricalSubstratum();
 
     void CheckTooManyLights();
@@ -90,11 +78,6 @@ private:
     void CheckTooManyElectricalPanelElements();
 
 	void ValidateElectricalConnectivity();
-
-    static size_t CountElectricallyUnconnected(
-        std::vector<ShipSpaceCoordinates> const & propagationSources,
-        std::vector<ShipSpaceCoordinates> const & propagationTargets,
-        Buffer2D<CVElement, ShipSpaceTag> & connectivityVisitBuffer);
 };
 
 }
\ No newline at end of file
@@ -21,7 +21,7 @@ TextureEraserTool::TextureEraserTool(
     : Tool(
         ToolType::TextureEraser,
         controller)
-    , mOriginalLayerClone(mController.GetModelController().CloneExistingLayer<LayerType::Texture>())
+    , mOriginalLayerSnapshot(mController.GetModelController().GetTextureLayer().Buffer)
     , mTempVisualizationDirtyTextureRegion()
     , mEngagementData()
     , mIsShiftDown(false)
@@ -274,7 +274,7 @@ void TextureEraserTool::EndEngagement()
         // Create undo action
         //
 
-        auto clippedLayerBackup = mOriginalLayerClone.MakeRegionBackup(*mEngagementData->EditRegion);
+        auto clippedLayerBackup = TextureLayerData(mOriginalLayerSnapshot.CloneRegion(*mEngagementData->EditRegion));
         auto const clipByteSize = clippedLayerBackup.Buffer.GetByteSize();
 
         mController.StoreUndoAction(
@@ -285,6 +285,14 @@ void TextureEraserTool::EndEngagement()
             {
                 controller.RestoreTextureLayerRegionBackupForUndo(std::move(clippedLayerBackup), origin);
             });
+
+        //
+        // Re-sync original layer snapshot with the region we've changed
+        //
+
+        mOriginalLayerSnapshot.UpdateFrom(
+            mController.GetModelController().GetTextureLayer().Buffer,
+            *mEngagementData->EditRegion);
     }
 
     //
@@ -298,9 +306,6 @@ void TextureEraserTool::EndEngagement()
     //
 
     assert(!mTempVisualizationDirtyTextureRegion);
-
-    // Re-take original layer clone
-    mOriginalLayerClone = mController.GetModelController().CloneExistingLayer<LayerType::Texture>();
 }
 
 void TextureEraserTool::DoTempVisualization(ImageRect const & affectedRect)
@@ -318,9 +323,11 @@ void TextureEraserTool::MendTempVisualization()
 {
     assert(mTempVisualizationDirtyTextureRegion);
 
+    auto const originalRegion = mOriginalLayerSnapshot.CloneRegion(*mTempVisualizationDirtyTextureRegion);
+
     mController.GetModelController().RestoreTextureLayerRegionEphemeralVisualization(
-        mOriginalLayerClone.Buffer,
-        *mTempVisualizationDirtyTextureRegion,
+        originalRegion,
+        ImageRect(originalRegion.Size),
         mTempVisualizationDirtyTextureRegion->origin);
 
     mController.GetView().RemoveRectOverlay();
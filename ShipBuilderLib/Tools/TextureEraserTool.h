@@ -12,6 +12,7 @@
 #include <Game/ResourceLocator.h>
 
 #include <GameCore/GameTypes.h>
+#include <GameCore/TiledBuffer2D.h>
 
 #include <memory>
 #include <optional>
@@ -55,8 +56,8 @@ private:
 
 private:
 
-    // Original layer
-    TextureLayerData mOriginalLayerClone;
+    // Original layer; a tiled copy-on-write snapshot, re-synced incrementally after each edit
+    TiledBuffer2D<rgbaColor, ImageTag> mOriginalLayerSnapshot;
 
     // Texture region dirtied so far with temporary visualization
     std::optional<ImageRect> mTempVisualizationDirtyTextureRegion;
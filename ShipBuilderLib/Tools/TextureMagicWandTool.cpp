@@ -17,6 +17,7 @@ TextureMagicWandTool::TextureMagicWandTool(
     : Tool(
         ToolType::TextureMagicWand,
         controller)
+    , mOriginalLayerSnapshot(mController.GetModelController().GetTextureLayer().Buffer)
 {
     SetCursor(WxHelpers::LoadCursorImage("magic_wand_cursor", 8, 8, resourceLocator));
 }
@@ -26,9 +27,7 @@ void TextureMagicWandTool::OnLeftMouseDown()
     auto const mouseCoordinatesInTextureSpace = ScreenToTextureSpace(GetCurrentMouseCoordinates());
     if (mouseCoordinatesInTextureSpace.IsInRect(ImageRect({0, 0}, mController.GetModelController().GetTextureSize())))
     {
-        // Take clone of current layer
         auto layerDirtyStateClone = mController.GetModelController().GetDirtyState();
-        auto layerClone = mController.GetModelController().CloneExistingLayer<LayerType::Texture>();
 
         // Do edit
 
@@ -42,7 +41,7 @@ void TextureMagicWandTool::OnLeftMouseDown()
         {
             // Create undo action
 
-            auto clippedLayerBackup = layerClone.MakeRegionBackup(*affectedRegion);
+            auto clippedLayerBackup = TextureLayerData(mOriginalLayerSnapshot.CloneRegion(*affectedRegion));
             auto const cloneByteSize = clippedLayerBackup.Buffer.GetByteSize();
 
             mController.StoreUndoAction(
@@ -54,6 +53,11 @@ void TextureMagicWandTool::OnLeftMouseDown()
                     controller.RestoreTextureLayerRegionBackupForUndo(std::move(clippedLayerBackup), origin);
                 });
 
+            // Re-sync original layer snapshot with the region we've changed
+            mOriginalLayerSnapshot.UpdateFrom(
+                mController.GetModelController().GetTextureLayer().Buffer,
+                *affectedRegion);
+
             // Epilog
             mController.LayerChangeEpilog({ LayerType::Texture });
         }
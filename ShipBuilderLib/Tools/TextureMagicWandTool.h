@@ -9,6 +9,9 @@
 
 #include <Game/ResourceLocator.h>
 
+#include <GameCore/GameTypes.h>
+#include <GameCore/TiledBuffer2D.h>
+
 namespace ShipBuilder {
 
 class TextureMagicWandTool : public Tool
@@ -27,6 +30,11 @@ public:
     void OnShiftKeyDown() override {};
     void OnShiftKeyUp() override {};
     void OnMouseLeft() override {};
+
+private:
+
+    // Original layer; a tiled copy-on-write snapshot, re-synced incrementally after each edit
+    TiledBuffer2D<rgbaColor, ImageTag> mOriginalLayerSnapshot;
 };
 
 }
\ No newline at end of file
@@ -314,11 +314,15 @@ ShipLoadDialog<TUsageType>::ShipLoadDialog(
 
             // Preview
             {
-                mShipPreviewWindow = new ShipPreviewWindow(this, mResourceLocator);
+                mShipPreviewWindow = new ShipPreviewWindow(
+                    this,
+                    { mStandardInstalledShipFolderPath, mUserShipFolderPath },
+                    mResourceLocator);
 
                 mShipPreviewWindow->SetMinSize(wxSize(ShipPreviewWindow::CalculateMinWidthForColumns(3) + 40, -1));
                 mShipPreviewWindow->Bind(fsEVT_SHIP_FILE_SELECTED, &ShipLoadDialog::OnShipFileSelected, this);
                 mShipPreviewWindow->Bind(fsEVT_SHIP_FILE_CHOSEN, &ShipLoadDialog::OnShipFileChosen, this);
+                mShipPreviewWindow->Bind(fsEVT_SHIP_FILE_FOUND, &ShipLoadDialog::OnShipFileFound, this);
 
                 vSizer1->Add(
                     mShipPreviewWindow, 
@@ -588,6 +592,7 @@ int ShipLoadDialog<TUsageType>::ShowModal(std::vector<std::filesystem::path> con
     mSelectedShipMetadata.reset();
     mSelectedShipFilepath.reset();
     mChosenShipFilepath.reset();
+    mFoundShipFilepath.reset();
 
     // Disable controls
     mInfoButton->Enable(false);
@@ -657,6 +662,16 @@ void ShipLoadDialog<TUsageType>::OnShipFileChosen(ShipPreviewWindow::fsShipFileC
     // Do not continue processing, as OnShipFileChosen() will fire event again
 }
 
+template<ShipLoadDialogUsageType TUsageType>
+void ShipLoadDialog<TUsageType>::OnShipFileFound(ShipPreviewWindow::fsShipFileFoundEvent & event)
+{
+    // Remember the ship, so we select it once we're in its directory
+    mFoundShipFilepath = event.GetShipFilepath();
+
+    // Change dir tree
+    mDirCtrl->SetPath(mFoundShipFilepath->parent_path().string()); // Will send its own event
+}
+
 template<ShipLoadDialogUsageType TUsageType>
 void ShipLoadDialog<TUsageType>::OnRecentDirectorySelected(wxCommandEvent & /*event*/)
 {
@@ -784,12 +799,27 @@ void ShipLoadDialog<TUsageType>::OnDirectorySelected(std::filesystem::path direc
     }
     mLoadButton->Enable(false);
 
-    // Clear search
-    mShipSearchCtrl->Clear();
-    mSearchNextButton->Enable(false);
+    // Check whether we're here because a search found a ship in this directory
+    bool const isFoundShipDirectory =
+        mFoundShipFilepath.has_value()
+        && mFoundShipFilepath->parent_path().lexically_normal() == directoryPath.lexically_normal();
+
+    // Clear search, unless we're continuing it here
+    if (!isFoundShipDirectory)
+    {
+        mShipSearchCtrl->Clear();
+        mSearchNextButton->Enable(false);
+    }
 
     // Propagate to preview panel
     mShipPreviewWindow->SetDirectory(directoryPath);
+
+    if (isFoundShipDirectory)
+    {
+        mShipPreviewWindow->SelectShip(*mFoundShipFilepath);
+    }
+
+    mFoundShipFilepath.reset();
 }
 
 template<ShipLoadDialogUsageType TUsageType>
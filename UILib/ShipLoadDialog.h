@@ -72,6 +72,7 @@ private:
     void OnDirCtrlDirSelected(wxCommandEvent & event);
     void OnShipFileSelected(ShipPreviewWindow::fsShipFileSelectedEvent & event);
     void OnShipFileChosen(ShipPreviewWindow::fsShipFileChosenEvent & event);
+    void OnShipFileFound(ShipPreviewWindow::fsShipFileFoundEvent & event);
     void OnRecentDirectorySelected(wxCommandEvent & event);
     void OnShipSearchCtrlText(wxCommandEvent & event);
     void OnShipSearchCtrlSearchBtn(wxCommandEvent & event);
@@ -135,4 +136,7 @@ private:
     std::optional<ShipMetadata> mSelectedShipMetadata;
     std::optional<std::filesystem::path> mSelectedShipFilepath;
     std::optional<std::filesystem::path> mChosenShipFilepath;
+
+    // Set while we're moving to the directory of a ship found by a search
+    std::optional<std::filesystem::path> mFoundShipFilepath;
 };
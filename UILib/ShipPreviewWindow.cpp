@@ -18,12 +18,15 @@
 
 #include <algorithm>
 #include <limits>
+#include <set>
 
 wxDEFINE_EVENT(fsEVT_SHIP_FILE_SELECTED, ShipPreviewWindow::fsShipFileSelectedEvent);
 wxDEFINE_EVENT(fsEVT_SHIP_FILE_CHOSEN, ShipPreviewWindow::fsShipFileChosenEvent);
+wxDEFINE_EVENT(fsEVT_SHIP_FILE_FOUND, ShipPreviewWindow::fsShipFileFoundEvent);
 
 ShipPreviewWindow::ShipPreviewWindow(
     wxWindow* parent,
+    std::vector<std::filesystem::path> const & libraryDirectoryPaths,
     ResourceLocator const & resourceLocator)
     : wxScrolled<wxWindow>(
         parent,
@@ -52,8 +55,12 @@ ShipPreviewWindow::ShipPreviewWindow(
     , mIsSortDescending(false)
     , mSortPredicate(MakeSortPredicate(mSortMethod, mIsSortDescending))
     , mCurrentlyCompletedDirectorySnapshot()
+    , mDirectoryPath()
     //
     , mPreviewThread()
+    , mLibraryDirectoryPaths(libraryDirectoryPaths)
+    , mLibraryIndex()
+    , mLibraryIndexMutex()
     , mPanelToThreadMessage()
     , mPanelToThreadMessageMutex()
     , mPanelToThreadMessageEvent()
@@ -198,6 +205,8 @@ void ShipPreviewWindow::SetDirectory(std::filesystem::path const & directoryPath
 
         mCurrentlyCompletedDirectorySnapshot.reset();
 
+        mDirectoryPath = directoryPath;
+
         // Clear selection
         mSelectedShipFileId.reset();
 
@@ -225,45 +234,132 @@ bool ShipPreviewWindow::Search(std::string const & shipName)
     std::string const shipNameLCase = Utils::ToLower(shipName);
 
     //
-    // Find next ship that contains the requested name as a substring,
-    // doing a circular search from the currently-selected ship
+    // Find all ships in the library that contain the requested name as a substring;
+    // ships in this directory that have not made it into the index yet are matched
+    // via their info tiles
     //
 
-    std::optional<size_t> foundShipIndex;
-    size_t startInfoTileIndex = mSelectedShipFileId ? (ShipFileIdToInfoTileIndex(*mSelectedShipFileId) + 1) : 0;
-    for (size_t i = 0; i < mInfoTiles.size(); ++i)
+    std::vector<std::filesystem::path> libraryShipFilepaths;
+
     {
-        size_t const shipInfoTileIndex = (startInfoTileIndex + i) % mInfoTiles.size();
+        std::lock_guard<std::mutex> lock(mLibraryIndexMutex);
 
-        if (std::any_of(
-            mInfoTiles[shipInfoTileIndex].SearchStrings.cbegin(),
-            mInfoTiles[shipInfoTileIndex].SearchStrings.cend(),
-            [&shipNameLCase](auto const & str)
-            {
-                return str.find(shipNameLCase) != std::string::npos;
-            }))
+        if (mLibraryIndex)
         {
-            foundShipIndex = shipInfoTileIndex;
-            break;
+            libraryShipFilepaths = mLibraryIndex->Search(shipName);
         }
     }
 
-    if (foundShipIndex.has_value())
+    std::set<std::filesystem::path> libraryShipFilepathSet;
+    for (auto const & shipFilepath : libraryShipFilepaths)
     {
-        //
-        // Scroll to the item if it's not fully visible
-        //
+        libraryShipFilepathSet.insert(shipFilepath.lexically_normal());
+    }
+
+    auto const isMatch = [&](InfoTile const & infoTile) -> bool
+        {
+            return libraryShipFilepathSet.count(infoTile.ShipFilepath.lexically_normal()) > 0
+                || std::any_of(
+                    infoTile.SearchStrings.cbegin(),
+                    infoTile.SearchStrings.cend(),
+                    [&shipNameLCase](auto const & str)
+                    {
+                        return str.find(shipNameLCase) != std::string::npos;
+                    });
+        };
 
-        EnsureInfoTileIsVisible(*foundShipIndex);
+    //
+    // Find next ship in this directory, after the currently-selected ship
+    //
 
-        //
-        // Select item
-        //
+    size_t const startInfoTileIndex = mSelectedShipFileId ? (ShipFileIdToInfoTileIndex(*mSelectedShipFileId) + 1) : 0;
+    for (size_t i = startInfoTileIndex; i < mInfoTiles.size(); ++i)
+    {
+        if (isMatch(mInfoTiles[i]))
+        {
+            EnsureInfoTileIsVisible(i);
+            SelectInfoTile(i);
+            return true;
+        }
+    }
+
+    //
+    // Move on to the next directory with matches, in library order
+    //
+
+    auto const directoryPath = mDirectoryPath.lexically_normal();
+
+    // The first matching ship of each directory, with directories in order of their first match
+    std::vector<std::filesystem::path> directoryFirstShipFilepaths;
+    std::set<std::filesystem::path> visitedDirectoryPaths;
+    std::optional<size_t> currentDirectoryIndex;
+    for (auto const & shipFilepath : libraryShipFilepaths)
+    {
+        auto const shipDirectoryPath = shipFilepath.parent_path().lexically_normal();
+        if (visitedDirectoryPaths.insert(shipDirectoryPath).second)
+        {
+            if (shipDirectoryPath == directoryPath)
+            {
+                currentDirectoryIndex = directoryFirstShipFilepaths.size();
+            }
+
+            directoryFirstShipFilepaths.push_back(shipFilepath);
+        }
+    }
+
+    if (!directoryFirstShipFilepaths.empty())
+    {
+        size_t const nextDirectoryIndex = currentDirectoryIndex.has_value()
+            ? (*currentDirectoryIndex + 1) % directoryFirstShipFilepaths.size()
+            : 0;
+
+        if (nextDirectoryIndex != currentDirectoryIndex)
+        {
+            //
+            // Fire found event
+            //
+
+            auto event = fsShipFileFoundEvent(
+                fsEVT_SHIP_FILE_FOUND,
+                this->GetId(),
+                directoryFirstShipFilepaths[nextDirectoryIndex]);
+
+            ProcessWindowEvent(event);
+
+            return true;
+        }
+    }
+
+    //
+    // Wrap around in this directory
+    //
 
-        SelectInfoTile(*foundShipIndex);
+    for (size_t i = 0; i < std::min(startInfoTileIndex, mInfoTiles.size()); ++i)
+    {
+        if (isMatch(mInfoTiles[i]))
+        {
+            EnsureInfoTileIsVisible(i);
+            SelectInfoTile(i);
+            return true;
+        }
     }
 
-    return foundShipIndex.has_value();
+    return false;
+}
+
+void ShipPreviewWindow::SelectShip(std::filesystem::path const & shipFilepath)
+{
+    auto const shipFilepathNormal = shipFilepath.lexically_normal();
+
+    for (size_t i = 0; i < mInfoTiles.size(); ++i)
+    {
+        if (mInfoTiles[i].ShipFilepath.lexically_normal() == shipFilepathNormal)
+        {
+            EnsureInfoTileIsVisible(i);
+            SelectInfoTile(i);
+            break;
+        }
+    }
 }
 
 void ShipPreviewWindow::SetSortMethod(SortMethod sortMethod)
@@ -1278,13 +1374,15 @@ void ShipPreviewWindow::ScanDirectorySnapshot(DirectorySnapshot && directorySnap
             // Commit - with a partial visit
             previewDirectoryManager->Commit(false);
 
+            UpdateLibraryIndex(*previewDirectoryManager);
+
             return;
         }
 
         try
         {
             // Load preview data
-            auto shipPreviewData = ShipDeSerializer::LoadShipPreviewData(fileIt->FilePath);
+            auto shipPreviewData = previewDirectoryManager->LoadPreviewData(fileIt->FilePath);
 
             // Load preview image
             auto shipPreviewImage = previewDirectoryManager->LoadPreviewImage(shipPreviewData, PreviewImageSize);
@@ -1327,9 +1425,31 @@ void ShipPreviewWindow::ScanDirectorySnapshot(DirectorySnapshot && directorySnap
 
     previewDirectoryManager->Commit(true);
 
+    UpdateLibraryIndex(*previewDirectoryManager);
+
     LogMessage("PreviewThread::ScanDirectorySnapshot(): ...preview completed.");
 }
 
+void ShipPreviewWindow::UpdateLibraryIndex(ShipPreviewDirectoryManager const & previewDirectoryManager)
+{
+    if (!mLibraryIndex)
+    {
+        // First time: load the whole library, outside of the lock as it takes a while;
+        // we're the only ones writing the index, hence we may check it without the lock
+        auto libraryIndex = std::make_unique<ShipLibraryIndex>(
+            ShipLibraryIndex::Load(mLibraryDirectoryPaths, std::make_shared<FileSystem>()));
+
+        std::lock_guard<std::mutex> lock(mLibraryIndexMutex);
+
+        mLibraryIndex = std::move(libraryIndex);
+    }
+
+    // Bring the index up-to-date with this directory, which might also be outside of the library
+    std::lock_guard<std::mutex> lock(mLibraryIndexMutex);
+
+    previewDirectoryManager.UpdateLibraryIndex(*mLibraryIndex);
+}
+
 void ShipPreviewWindow::QueueThreadToPanelMessage(std::unique_ptr<ThreadToPanelMessage> message)
 {
     // Lock queue
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Game/ResourceLocator.h>
+#include <Game/ShipPreviewDirectoryManager.h>
 #include <Game/ShipPreviewData.h>
 
 #include <GameCore/ImageData.h>
@@ -127,6 +128,46 @@ public:
         std::filesystem::path const mShipFilepath;
     };
 
+    //
+    // Event fired when a search has found a ship file in a directory
+    // other than the current one.
+    //
+
+    class fsShipFileFoundEvent : public wxEvent
+    {
+    public:
+
+        fsShipFileFoundEvent(
+            wxEventType eventType,
+            int winid,
+            std::filesystem::path const & shipFilepath)
+            : wxEvent(winid, eventType)
+            , mShipFilepath(shipFilepath)
+        {
+            m_propagationLevel = wxEVENT_PROPAGATE_MAX;
+        }
+
+        fsShipFileFoundEvent(fsShipFileFoundEvent const & other)
+            : wxEvent(other)
+            , mShipFilepath(other.mShipFilepath)
+        {
+            m_propagationLevel = wxEVENT_PROPAGATE_MAX;
+        }
+
+        virtual wxEvent * Clone() const override
+        {
+            return new fsShipFileFoundEvent(*this);
+        }
+
+        std::filesystem::path const GetShipFilepath() const
+        {
+            return mShipFilepath;
+        }
+
+    private:
+        std::filesystem::path const mShipFilepath;
+    };
+
     //
     // Sort method
     //
@@ -203,6 +244,7 @@ public:
 
     ShipPreviewWindow(
         wxWindow* parent,
+        std::vector<std::filesystem::path> const & libraryDirectoryPaths,
         ResourceLocator const & resourceLocator);
 
     virtual ~ShipPreviewWindow();
@@ -212,8 +254,15 @@ public:
 
     void SetDirectory(std::filesystem::path const & directoryPath);
 
+    /*
+     * Searches the whole library for the next ship matching the specified text; when the
+     * next match is in a different directory, fires fsEVT_SHIP_FILE_FOUND, expecting the
+     * ship's directory to be set and the ship to be selected in response.
+     */
     bool Search(std::string const & shipName);
 
+    void SelectShip(std::filesystem::path const & shipFilepath);
+
     SortMethod GetCurrentSortMethod() const
     {
         return mSortMethod;
@@ -433,6 +482,8 @@ private:
     // When set, indicates that the preview of this directory is completed
     std::optional<DirectorySnapshot> mCurrentlyCompletedDirectorySnapshot;
 
+    std::filesystem::path mDirectoryPath;
+
     ////////////////////////////////////////////////
     // Preview Thread
     ////////////////////////////////////////////////
@@ -441,6 +492,19 @@ private:
 
     void RunPreviewThread();
     void ScanDirectorySnapshot(DirectorySnapshot && directorySnapshot);
+    void UpdateLibraryIndex(ShipPreviewDirectoryManager const & previewDirectoryManager);
+
+    //
+    // Library index
+    //
+
+    // The roots of the directory trees searched via the library index
+    std::vector<std::filesystem::path> const mLibraryDirectoryPaths;
+
+    // Loaded by the thread once, and then kept up-to-date by the thread
+    // with each directory it visits
+    std::unique_ptr<ShipLibraryIndex> mLibraryIndex;
+    std::mutex mLibraryIndexMutex;
 
     //
     // Panel-to-Thread communication
@@ -637,3 +701,4 @@ private:
 
 wxDECLARE_EVENT(fsEVT_SHIP_FILE_SELECTED, ShipPreviewWindow::fsShipFileSelectedEvent);
 wxDECLARE_EVENT(fsEVT_SHIP_FILE_CHOSEN, ShipPreviewWindow::fsShipFileChosenEvent);
+wxDECLARE_EVENT(fsEVT_SHIP_FILE_FOUND, ShipPreviewWindow::fsShipFileFoundEvent);
@@ -20,15 +20,14 @@ struct SpringEndpoints
 // Vector normalization
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-TEST(AlgorithmsTests, CalculateVectorDirsAndReciprocalLengths_SSE)
+TEST(AlgorithmsTests, CalculateVectorDirsAndReciprocalLengths_SIMD)
 {
     vec2f pointPositions[] = { { 1.0f, 2.0f}, {2.0f, 4.0f}, {10.0f, 5.0f}, {3.0f, 4.0f} };
     SpringEndpoints springs[] = { {0, 1}, {1, 2}, {0, 3}, {2, 3} };
-    vec2f outDirs[4];
-    float outReciprocalLengths[4];
+    aligned_to_vword vec2f outDirs[4];
+    aligned_to_vword float outReciprocalLengths[4];
 
-    Algorithms::CalculateVectorDirsAndReciprocalLengths_SSE(
+    Algorithms::CalculateVectorDirsAndReciprocalLengths_SIMD<4>(
         pointPositions,
         springs,
         outDirs,
@@ -53,7 +52,53 @@ TEST(AlgorithmsTests, CalculateVectorDirsAndReciprocalLengths_SSE)
     EXPECT_TRUE(ApproxEquals(-7.0f / std::sqrt(50.0f), outDirs[3].x, Tolerance));
     EXPECT_TRUE(ApproxEquals(-1.0f / std::sqrt(50.0f), outDirs[3].y, Tolerance));
 }
-#endif
+
+TEST(AlgorithmsTests, CalculateVectorDirsAndReciprocalLengths_SIMD_8Wide_WithRemainder)
+{
+    vec2f pointPositions[] = { { 1.0f, 2.0f}, {2.0f, 4.0f}, {10.0f, 5.0f}, {3.0f, 4.0f}, {3.0f, 4.0f} };
+    SpringEndpoints springs[] = {
+        {0, 1}, {1, 2}, {0, 3}, {2, 3},
+        {0, 1}, {1, 2}, {0, 3}, {2, 3},
+        {0, 1}, {1, 2}, {0, 3}, {3, 4} }; // Last is zero-length
+    aligned_to_vword vec2f outDirs[12];
+    aligned_to_vword float outReciprocalLengths[12];
+
+    Algorithms::CalculateVectorDirsAndReciprocalLengths_SIMD<8>(
+        pointPositions,
+        springs,
+        outDirs,
+        outReciprocalLengths,
+        12);
+
+    float constexpr Tolerance = 0.001f;
+
+    for (size_t b = 0; b < 12; b += 4)
+    {
+        EXPECT_TRUE(ApproxEquals(1.0f / std::sqrt(5.0f), outReciprocalLengths[b + 0], Tolerance));
+        EXPECT_TRUE(ApproxEquals(1.0f / std::sqrt(5.0f), outDirs[b + 0].x, Tolerance));
+        EXPECT_TRUE(ApproxEquals(2.0f / std::sqrt(5.0f), outDirs[b + 0].y, Tolerance));
+
+        EXPECT_TRUE(ApproxEquals(1.0f / std::sqrt(65.0f), outReciprocalLengths[b + 1], Tolerance));
+        EXPECT_TRUE(ApproxEquals(8.0f / std::sqrt(65.0f), outDirs[b + 1].x, Tolerance));
+        EXPECT_TRUE(ApproxEquals(1.0f / std::sqrt(65.0f), outDirs[b + 1].y, Tolerance));
+
+        EXPECT_TRUE(ApproxEquals(1.0f / std::sqrt(8.0f), outReciprocalLengths[b + 2], Tolerance));
+        EXPECT_TRUE(ApproxEquals(2.0f / std::sqrt(8.0f), outDirs[b + 2].x, Tolerance));
+        EXPECT_TRUE(ApproxEquals(2.0f / std::sqrt(8.0f), outDirs[b + 2].y, Tolerance));
+    }
+
+    EXPECT_TRUE(ApproxEquals(1.0f / std::sqrt(50.0f), outReciprocalLengths[3], Tolerance));
+    EXPECT_TRUE(ApproxEquals(-7.0f / std::sqrt(50.0f), outDirs[3].x, Tolerance));
+    EXPECT_TRUE(ApproxEquals(-1.0f / std::sqrt(50.0f), outDirs[3].y, Tolerance));
+
+    EXPECT_TRUE(ApproxEquals(1.0f / std::sqrt(50.0f), outReciprocalLengths[7], Tolerance));
+    EXPECT_TRUE(ApproxEquals(-7.0f / std::sqrt(50.0f), outDirs[7].x, Tolerance));
+    EXPECT_TRUE(ApproxEquals(-1.0f / std::sqrt(50.0f), outDirs[7].y, Tolerance));
+
+    EXPECT_EQ(0.0f, outReciprocalLengths[11]);
+    EXPECT_EQ(0.0f, outDirs[11].x);
+    EXPECT_EQ(0.0f, outDirs[11].y);
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 // DiffuseLight
@@ -249,8 +294,7 @@ TEST(AlgorithmsTests, DiffuseLight_Vectorized_8Lamps)
     EXPECT_FLOAT_EQ(0.17639320225f, outLightBuffer[3]);
 }
 
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-TEST(AlgorithmsTests, DiffuseLight_SSEVectorized_4Lamps)
+TEST(AlgorithmsTests, DiffuseLight_SIMD_4Lamps)
 {
     aligned_to_vword vec2f pointPositions[] = { { 1.0f, 2.0f}, {2.0f, 4.0f}, {10.0f, 5.0f}, {3.0f, 4.0f} };
     aligned_to_vword PlaneId pointPlaneIds[] = { 1, 1, 2, 3 };
@@ -262,7 +306,7 @@ TEST(AlgorithmsTests, DiffuseLight_SSEVectorized_4Lamps)
 
     aligned_to_vword float outLightBuffer[4];
 
-    Algorithms::DiffuseLight_SSEVectorized(
+    Algorithms::DiffuseLight_SIMD<4>(
         0,
         4,
         pointPositions,
@@ -299,7 +343,7 @@ TEST(AlgorithmsTests, DiffuseLight_SSEVectorized_4Lamps)
     EXPECT_FLOAT_EQ(0.17639320225f, outLightBuffer[3]);
 }
 
-TEST(AlgorithmsTests, DiffuseLight_SSEVectorized_8Lamps)
+TEST(AlgorithmsTests, DiffuseLight_SIMD_8Lamps)
 {
     aligned_to_vword vec2f pointPositions[] = { { 1.0f, 2.0f}, {2.0f, 4.0f}, {10.0f, 5.0f}, {3.0f, 4.0f} };
     aligned_to_vword PlaneId pointPlaneIds[] = { 1, 1, 2, 3 };
@@ -311,7 +355,7 @@ TEST(AlgorithmsTests, DiffuseLight_SSEVectorized_8Lamps)
 
     aligned_to_vword float outLightBuffer[4];
 
-    Algorithms::DiffuseLight_SSEVectorized(
+    Algorithms::DiffuseLight_SIMD<4>(
         0,
         4,
         pointPositions,
@@ -347,7 +391,44 @@ TEST(AlgorithmsTests, DiffuseLight_SSEVectorized_8Lamps)
 
     EXPECT_FLOAT_EQ(0.17639320225f, outLightBuffer[3]);
 }
-#endif
+
+TEST(AlgorithmsTests, DiffuseLight_SIMD_8Wide_WithRemainder)
+{
+    aligned_to_vword vec2f pointPositions[] = {
+        { 1.0f, 2.0f}, {2.0f, 4.0f}, {10.0f, 5.0f}, {3.0f, 4.0f},
+        { 1.0f, 2.0f}, {2.0f, 4.0f}, {10.0f, 5.0f}, {3.0f, 4.0f},
+        { 1.0f, 2.0f}, {2.0f, 4.0f}, {10.0f, 5.0f}, {3.0f, 4.0f} };
+    aligned_to_vword PlaneId pointPlaneIds[] = { 1, 1, 2, 3, 1, 1, 2, 3, 1, 1, 2, 3 };
+
+    aligned_to_vword vec2f lampPositions[] = { { 4.0f, 2.0f}, {1.0f, 2.0f}, {100.0f, 100.0f}, {200.0f, 200.0f} };
+    aligned_to_vword PlaneId lampPlaneIds[] = { 3, 2, 10, 10 };
+    aligned_to_vword float lampDistanceCoeffs[] = { 0.1f, 0.2f, 10.0f, 20.0f };
+    aligned_to_vword float lampSpreadMaxDistances[] = { 4.0f, 6.0f, 1.0f, 2.0f };
+
+    aligned_to_vword float outLightBuffer[12];
+
+    Algorithms::DiffuseLight_SIMD<8>(
+        0,
+        12,
+        pointPositions,
+        pointPlaneIds,
+        lampPositions,
+        lampPlaneIds,
+        lampDistanceCoeffs,
+        lampSpreadMaxDistances,
+        4,
+        outLightBuffer);
+
+    // Same as DiffuseLight_SIMD_4Lamps, three times over
+
+    for (size_t b = 0; b < 12; b += 4)
+    {
+        EXPECT_FLOAT_EQ(1.0f, outLightBuffer[b + 0]);
+        EXPECT_FLOAT_EQ(0.7527864f, outLightBuffer[b + 1]);
+        EXPECT_FLOAT_EQ(0.0f, outLightBuffer[b + 2]);
+        EXPECT_FLOAT_EQ(0.17639320225f, outLightBuffer[b + 3]);
+    }
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 // BufferSmoothing
@@ -405,9 +486,12 @@ TEST(AlgorithmsTests, SmoothBufferAndAdd_12_5_Naive)
     RunSmoothBufferAndAddTest_12_5(Algorithms::SmoothBufferAndAdd_Naive<12, 5>);
 }
 
-#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
-TEST(AlgorithmsTests, SmoothBufferAndAdd_12_5_SSEVectorized)
+TEST(AlgorithmsTests, SmoothBufferAndAdd_12_5_SIMD)
 {
-    RunSmoothBufferAndAddTest_12_5(Algorithms::SmoothBufferAndAdd_SSEVectorized<12, 5>);
+    RunSmoothBufferAndAddTest_12_5(Algorithms::SmoothBufferAndAdd_SIMD<12, 5, 4>);
 }
-#endif
\ No newline at end of file
+
+TEST(AlgorithmsTests, SmoothBufferAndAdd_12_5)
+{
+    RunSmoothBufferAndAddTest_12_5(Algorithms::SmoothBufferAndAdd<12, 5>);
+}
\ No newline at end of file
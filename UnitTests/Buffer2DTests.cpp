@@ -2659,6 +2659,32 @@ TEST(Buffer2DTests, Flip_HorizontalAndVertical)
     }
 }
 
+TEST(Buffer2DTests, Flip_HorizontalAndVertical_OddSize)
+{
+    Buffer2D<int, struct IntegralTag> buffer(5, 3);
+
+    int iVal = 100;
+    for (int y = 0; y < buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < buffer.Size.width; ++x)
+        {
+            buffer[IntegralCoordinates(x, y)] = iVal++;
+        }
+    }
+
+    buffer.Flip(DirectionType::Horizontal | DirectionType::Vertical);
+
+    iVal = 100;
+    for (int y = buffer.Size.height - 1; y >= 0; --y)
+    {
+        for (int x = buffer.Size.width - 1; x >= 0; --x)
+        {
+            EXPECT_EQ(buffer[IntegralCoordinates(x, y)], iVal);
+            ++iVal;
+        }
+    }
+}
+
 TEST(Buffer2DTests, MakeReframed_SameRect)
 {
     Buffer2D<int, struct IntegralTag> sourceBuffer(8, 8);
@@ -3001,7 +3027,9 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(2, 2),
         std::make_tuple(3, 2),
         std::make_tuple(2, 3),
-        std::make_tuple(3, 3)
+        std::make_tuple(3, 3),
+        std::make_tuple(33, 70),
+        std::make_tuple(70, 33)
     ));
 
 TEST_P(Rotate90CWTest, Rotate90CWTest)
@@ -3070,7 +3098,9 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(2, 2),
         std::make_tuple(3, 2),
         std::make_tuple(2, 3),
-        std::make_tuple(3, 3)
+        std::make_tuple(3, 3),
+        std::make_tuple(33, 70),
+        std::make_tuple(70, 33)
     ));
 
 TEST_P(Rotate90CCWTest, Rotate90CCWTest)
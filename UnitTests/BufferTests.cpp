@@ -1,4 +1,5 @@
 #include <GameCore/Buffer.h>
+#include <GameCore/BufferAllocator.h>
 
 #include <GameCore/Vectors.h>
 
@@ -122,3 +123,95 @@ TEST(BufferTests, Buffer_Swap)
     EXPECT_EQ(41, buf2[2]);
 }
 
+
+TEST(BufferTests, Buffer_HugePages_Large)
+{
+    size_t const size = 3 * HugePageByteSize / sizeof(float) + 5;
+
+    Buffer<float> buf(size, 7.0f, BufferAllocationPolicy::HugePages);
+
+    EXPECT_TRUE(is_aligned_to_vectorization_word(buf.data()));
+    EXPECT_EQ(size, buf.GetCurrentPopulatedSize());
+    EXPECT_EQ(7.0f, buf[0]);
+    EXPECT_EQ(7.0f, buf[size - 1]);
+}
+
+TEST(BufferTests, Buffer_HugePages_Small)
+{
+    // Smaller than a huge page, hence falls back to the default allocation
+    Buffer<float> buf(64, 3.0f, BufferAllocationPolicy::HugePages);
+
+    EXPECT_TRUE(is_aligned_to_vectorization_word(buf.data()));
+    EXPECT_EQ(3.0f, buf[0]);
+    EXPECT_EQ(3.0f, buf[63]);
+}
+
+TEST(BufferTests, Buffer_AlignedBufferStats)
+{
+    size_t const heapByteCount = AlignedBufferStats::HeapByteCount.load();
+    size_t const hugePagesByteCount = AlignedBufferStats::HugePagesByteCount.load();
+
+    {
+        Buffer<float> buf(64);
+
+        EXPECT_EQ(heapByteCount + 64 * sizeof(float), AlignedBufferStats::HeapByteCount.load());
+        EXPECT_EQ(hugePagesByteCount, AlignedBufferStats::HugePagesByteCount.load());
+    }
+
+    EXPECT_EQ(heapByteCount, AlignedBufferStats::HeapByteCount.load());
+    EXPECT_EQ(hugePagesByteCount, AlignedBufferStats::HugePagesByteCount.load());
+
+    {
+        Buffer<float> buf(HugePageByteSize / sizeof(float), BufferAllocationPolicy::HugePages);
+
+        // Whichever memory backs it, the whole buffer is accounted for
+        EXPECT_GE(
+            (AlignedBufferStats::HeapByteCount.load() - heapByteCount) + (AlignedBufferStats::HugePagesByteCount.load() - hugePagesByteCount),
+            HugePageByteSize);
+    }
+
+    EXPECT_EQ(heapByteCount, AlignedBufferStats::HeapByteCount.load());
+    EXPECT_EQ(hugePagesByteCount, AlignedBufferStats::HugePagesByteCount.load());
+}
+
+TEST(BufferTests, Buffer_FillRange)
+{
+    Buffer<int> buf(64, 1);
+
+    buf.fill(10, 20, 5);
+
+    EXPECT_EQ(1, buf[9]);
+    EXPECT_EQ(5, buf[10]);
+    EXPECT_EQ(5, buf[19]);
+    EXPECT_EQ(1, buf[20]);
+    EXPECT_EQ(64u, buf.GetCurrentPopulatedSize());
+}
+
+TEST(BufferTests, BufferAllocator_ReusesBuffersPerPolicy)
+{
+    BufferAllocator<float> allocator(64);
+
+    Buffer<float> * defaultBuffer;
+    Buffer<float> * hugePagesBuffer;
+    {
+        auto buf1 = allocator.Allocate();
+        auto buf2 = allocator.Allocate(BufferAllocationPolicy::HugePages);
+
+        EXPECT_NE(buf1.get(), buf2.get());
+        EXPECT_EQ(64u, buf1->GetSize());
+        EXPECT_EQ(64u, buf2->GetSize());
+
+        defaultBuffer = buf1.get();
+        hugePagesBuffer = buf2.get();
+    }
+
+    auto buf3 = allocator.Allocate(BufferAllocationPolicy::HugePages);
+    EXPECT_EQ(hugePagesBuffer, buf3.get());
+
+    auto buf4 = allocator.Allocate(BufferAllocationPolicy::HugePages);
+    EXPECT_NE(defaultBuffer, buf4.get());
+    EXPECT_NE(hugePagesBuffer, buf4.get());
+
+    auto buf5 = allocator.Allocate();
+    EXPECT_EQ(defaultBuffer, buf5.get());
+}
@@ -0,0 +1,201 @@
+#include <GameCore/FloatVec.h>
+
+#include <GameCore/SysSpecifics.h>
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+template<size_t N>
+std::uint32_t GetBits(float_vec<N> const & v, size_t lane)
+{
+    aligned_to_vword float tmp[N];
+    v.store(tmp);
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &(tmp[lane]), sizeof(float));
+    return bits;
+}
+
+template<size_t N>
+void RunArithmeticTest()
+{
+    aligned_to_vword float a[N];
+    aligned_to_vword float b[N];
+    for (size_t i = 0; i < N; ++i)
+    {
+        a[i] = static_cast<float>(i + 1);
+        b[i] = static_cast<float>(2 * i + 4);
+    }
+
+    auto const va = float_vec<N>::load(a);
+    auto const vb = float_vec<N>::load(b);
+
+    aligned_to_vword float sum[N];
+    (va + vb).store(sum);
+    aligned_to_vword float diff[N];
+    (va - vb).store(diff);
+    aligned_to_vword float prod[N];
+    (va * vb).store(prod);
+    aligned_to_vword float quot[N];
+    (vb / va).store(quot);
+    aligned_to_vword float mn[N];
+    min(va, float_vec<N>::splat(3.5f)).store(mn);
+    aligned_to_vword float mx[N];
+    max(va, float_vec<N>::splat(3.5f)).store(mx);
+    aligned_to_vword float sq[N];
+    sqrt(vb).store(sq);
+    aligned_to_vword float rsq[N];
+    rsqrt_approx(vb).store(rsq);
+    aligned_to_vword float rcp[N];
+    rcp_approx(vb).store(rcp);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT_FLOAT_EQ(a[i] + b[i], sum[i]);
+        EXPECT_FLOAT_EQ(a[i] - b[i], diff[i]);
+        EXPECT_FLOAT_EQ(a[i] * b[i], prod[i]);
+        EXPECT_FLOAT_EQ(b[i] / a[i], quot[i]);
+        EXPECT_FLOAT_EQ(std::min(a[i], 3.5f), mn[i]);
+        EXPECT_FLOAT_EQ(std::max(a[i], 3.5f), mx[i]);
+        EXPECT_FLOAT_EQ(std::sqrt(b[i]), sq[i]);
+        EXPECT_NEAR(1.0f / std::sqrt(b[i]), rsq[i], 0.001f);
+        EXPECT_NEAR(1.0f / b[i], rcp[i], 0.001f);
+    }
+}
+
+template<size_t N>
+void RunMaskTest()
+{
+    aligned_to_vword float a[N];
+    aligned_to_vword std::int32_t ia[N];
+    for (size_t i = 0; i < N; ++i)
+    {
+        a[i] = (i % 2) == 0 ? 0.0f : static_cast<float>(i);
+        ia[i] = static_cast<std::int32_t>(i) - 2;
+    }
+
+    auto const va = float_vec<N>::load(a);
+
+    auto const neqMask = neq_mask(va, float_vec<N>::zero());
+    auto const leMask = le_mask(va, float_vec<N>::splat(3.0f));
+    auto const greaterMask = greater_mask(int_vec<N>::load(ia), int_vec<N>::splat(0));
+
+    aligned_to_vword float masked[N];
+    (float_vec<N>::splat(5.0f) & neqMask).store(masked);
+    aligned_to_vword float maskedNot[N];
+    andnot(greaterMask, float_vec<N>::splat(5.0f)).store(maskedNot);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT_EQ((i % 2) == 0 ? 0u : 0xffffffffu, GetBits(neqMask, i));
+        EXPECT_EQ(a[i] <= 3.0f ? 0xffffffffu : 0u, GetBits(leMask, i));
+        EXPECT_EQ(ia[i] > 0 ? 0xffffffffu : 0u, GetBits(greaterMask, i));
+
+        EXPECT_EQ((i % 2) == 0 ? 0.0f : 5.0f, masked[i]);
+        EXPECT_EQ(ia[i] > 0 ? 0.0f : 5.0f, maskedNot[i]);
+    }
+}
+
+template<size_t N>
+void RunXYTest()
+{
+    aligned_to_vword float xy[N * 2];
+    for (size_t i = 0; i < N; ++i)
+    {
+        xy[i * 2] = static_cast<float>(i);
+        xy[i * 2 + 1] = static_cast<float>(100 + i);
+    }
+
+    // Load
+
+    float_vec<N> x, y;
+    float_vec<N>::load_xy(xy, x, y);
+
+    aligned_to_vword float xs[N];
+    x.store(xs);
+    aligned_to_vword float ys[N];
+    y.store(ys);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT_EQ(static_cast<float>(i), xs[i]);
+        EXPECT_EQ(static_cast<float>(100 + i), ys[i]);
+    }
+
+    // Gather, in reverse
+
+    std::uint32_t indices[N];
+    for (size_t i = 0; i < N; ++i)
+        indices[i] = static_cast<std::uint32_t>(N - 1 - i);
+
+    float_vec<N>::gather_xy(xy, indices, x, y);
+    x.store(xs);
+    y.store(ys);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT_EQ(static_cast<float>(N - 1 - i), xs[i]);
+        EXPECT_EQ(static_cast<float>(100 + N - 1 - i), ys[i]);
+    }
+
+    // Store
+
+    aligned_to_vword float outXY[N * 2];
+    float_vec<N>::store_xy(x, y, outXY);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT_EQ(static_cast<float>(N - 1 - i), outXY[i * 2]);
+        EXPECT_EQ(static_cast<float>(100 + N - 1 - i), outXY[i * 2 + 1]);
+    }
+}
+
+}
+
+TEST(FloatVecTests, Arithmetic_4)
+{
+    RunArithmeticTest<4>();
+}
+
+TEST(FloatVecTests, Arithmetic_8)
+{
+    RunArithmeticTest<8>();
+}
+
+TEST(FloatVecTests, Arithmetic_16)
+{
+    RunArithmeticTest<16>();
+}
+
+TEST(FloatVecTests, Masks_4)
+{
+    RunMaskTest<4>();
+}
+
+TEST(FloatVecTests, Masks_8)
+{
+    RunMaskTest<8>();
+}
+
+TEST(FloatVecTests, Masks_16)
+{
+    RunMaskTest<16>();
+}
+
+TEST(FloatVecTests, XY_4)
+{
+    RunXYTest<4>();
+}
+
+TEST(FloatVecTests, XY_8)
+{
+    RunXYTest<8>();
+}
+
+TEST(FloatVecTests, XY_16)
+{
+    RunXYTest<16>();
+}
@@ -0,0 +1,335 @@
+#include <Game/Physics.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <vector>
+
+namespace Physics {
+
+//
+// Frontiers are built here as bare rings of edges, without the points, springs,
+// and triangles they would come from; the operations under test only deal with
+// the rings themselves.
+//
+
+class FrontiersTests : public testing::Test
+{
+protected:
+
+    struct Ring
+    {
+        FrontierType Type;
+        ElementCount Size;
+        std::set<ElementIndex> EdgeIndices;
+
+        bool operator==(Ring const & other) const
+        {
+            return Type == other.Type
+                && Size == other.Size
+                && EdgeIndices == other.EdgeIndices;
+        }
+
+        bool operator<(Ring const & other) const
+        {
+            return EdgeIndices < other.EdgeIndices;
+        }
+    };
+
+    static FrontierId MakeRing(
+        Frontiers & frontiers,
+        FrontierType type,
+        std::vector<ElementIndex> const & edgeIndices)
+    {
+        FrontierId const frontierId = frontiers.CreateNewFrontier(
+            type,
+            edgeIndices.front(),
+            static_cast<ElementCount>(edgeIndices.size()));
+
+        for (size_t e = 0; e < edgeIndices.size(); ++e)
+        {
+            ElementIndex const edgeIndex = edgeIndices[e];
+            frontiers.mEdges[edgeIndex].FrontierIndex = frontierId;
+            frontiers.mFrontierEdges[edgeIndex].PointAIndex = edgeIndex;
+            frontiers.mFrontierEdges[edgeIndex].NextEdgeIndex = edgeIndices[(e + 1) % edgeIndices.size()];
+            frontiers.mFrontierEdges[edgeIndex].PrevEdgeIndex = edgeIndices[(e + edgeIndices.size() - 1) % edgeIndices.size()];
+        }
+
+        return frontierId;
+    }
+
+    // Joins the old frontier into the new one, between edgeIn and the edge that follows it
+    static void Join(
+        Frontiers & frontiers,
+        ElementIndex edgeIn,
+        ElementIndex edgeInOpposite,
+        FrontierId oldFrontierId,
+        FrontierId newFrontierId)
+    {
+        frontiers.ReplaceAndJoinFrontier(
+            edgeIn,
+            edgeInOpposite,
+            frontiers.mFrontierEdges[edgeInOpposite].PrevEdgeIndex,
+            frontiers.mFrontierEdges[edgeIn].NextEdgeIndex,
+            oldFrontierId,
+            newFrontierId);
+    }
+
+    static FrontierId SplitShorter(
+        Frontiers & frontiers,
+        ElementIndex regionStartEdgeIndex,
+        ElementIndex regionEndEdgeIndex,
+        FrontierId oldFrontierId)
+    {
+        return frontiers.SplitShorterIntoNewFrontier(
+            regionStartEdgeIndex,
+            regionEndEdgeIndex,
+            oldFrontierId,
+            FrontierType::Internal,
+            frontiers.mFrontierEdges[regionStartEdgeIndex].PrevEdgeIndex,
+            frontiers.mFrontierEdges[regionEndEdgeIndex].NextEdgeIndex);
+    }
+
+    // The original, non-batched split: the region always becomes the new frontier
+    static FrontierId Split(
+        Frontiers & frontiers,
+        ElementIndex regionStartEdgeIndex,
+        ElementIndex regionEndEdgeIndex,
+        FrontierId oldFrontierId)
+    {
+        return frontiers.SplitIntoNewFrontier(
+            regionStartEdgeIndex,
+            regionEndEdgeIndex,
+            oldFrontierId,
+            FrontierType::Internal,
+            frontiers.mFrontierEdges[regionStartEdgeIndex].PrevEdgeIndex,
+            frontiers.mFrontierEdges[regionEndEdgeIndex].NextEdgeIndex);
+    }
+
+    // The frontier of each edge, resolving merges - i.e. what eager relabeling would have given
+    static FrontierId GetResolvedEdgeFrontierId(
+        Frontiers const & frontiers,
+        ElementIndex edgeIndex)
+    {
+        return frontiers.ResolveFrontierId(frontiers.mEdges[edgeIndex].FrontierIndex);
+    }
+
+    static FrontierId GetRawEdgeFrontierId(
+        Frontiers const & frontiers,
+        ElementIndex edgeIndex)
+    {
+        return frontiers.mEdges[edgeIndex].FrontierIndex;
+    }
+
+    static size_t GetSlotCount(Frontiers const & frontiers)
+    {
+        return frontiers.mFrontiers.size();
+    }
+
+    // Walks the rings of all live frontiers, verifying that each edge resolves to the frontier it's in
+    static std::map<FrontierId, Ring> GetRings(Frontiers const & frontiers)
+    {
+        std::map<FrontierId, Ring> rings;
+
+        for (FrontierId const frontierId : frontiers.GetFrontierIds())
+        {
+            auto const & frontier = frontiers.GetFrontier(frontierId);
+
+            Ring ring{ frontier.Type, frontier.Size, {} };
+
+            ElementIndex edgeIndex = frontier.StartingEdgeIndex;
+            do
+            {
+                EXPECT_EQ(frontierId, GetResolvedEdgeFrontierId(frontiers, edgeIndex));
+                EXPECT_EQ(edgeIndex, frontiers.mFrontierEdges[frontiers.mFrontierEdges[edgeIndex].NextEdgeIndex].PrevEdgeIndex);
+
+                ring.EdgeIndices.insert(edgeIndex);
+                edgeIndex = frontiers.mFrontierEdges[edgeIndex].NextEdgeIndex;
+            } while (edgeIndex != frontier.StartingEdgeIndex);
+
+            EXPECT_EQ(static_cast<size_t>(frontier.Size), ring.EdgeIndices.size());
+
+            rings.emplace(frontierId, ring);
+        }
+
+        return rings;
+    }
+
+    static std::set<Ring> GetRingSet(Frontiers const & frontiers)
+    {
+        std::set<Ring> ringSet;
+        for (auto const & [_, ring] : GetRings(frontiers))
+        {
+            ringSet.insert(ring);
+        }
+
+        return ringSet;
+    }
+
+    static std::vector<ElementIndex> MakeEdges(ElementIndex first, ElementIndex count)
+    {
+        std::vector<ElementIndex> edgeIndices(count);
+        std::iota(edgeIndices.begin(), edgeIndices.end(), first);
+        return edgeIndices;
+    }
+};
+
+}
+
+using Physics::FrontiersTests;
+using Physics::Frontiers;
+
+TEST_F(FrontiersTests, Merge_ForwardsMergedFrontierId)
+{
+    Frontiers frontiers(16, 16);
+
+    FrontierId const a = MakeRing(frontiers, FrontierType::External, MakeEdges(0, 4));
+    FrontierId const b = MakeRing(frontiers, FrontierType::Internal, MakeEdges(4, 4));
+
+    Join(frontiers, 1, 4, b, a);
+
+    ASSERT_EQ(1u, frontiers.GetElementCount());
+    EXPECT_EQ(a, frontiers.GetFrontierIds()[0]);
+
+    auto const rings = GetRings(frontiers);
+    ASSERT_EQ(1u, rings.size());
+    EXPECT_EQ(8, rings.at(a).Size);
+    EXPECT_EQ(FrontierType::External, rings.at(a).Type);
+
+    // Not relabeled yet
+    for (ElementIndex e = 4; e < 8; ++e)
+    {
+        EXPECT_EQ(b, GetRawEdgeFrontierId(frontiers, e));
+    }
+}
+
+TEST_F(FrontiersTests, Merge_ForwardsChainsOfMergedFrontierIds)
+{
+    Frontiers frontiers(16, 16);
+
+    FrontierId const a = MakeRing(frontiers, FrontierType::External, MakeEdges(0, 4));
+    FrontierId const b = MakeRing(frontiers, FrontierType::Internal, MakeEdges(4, 4));
+    FrontierId const c = MakeRing(frontiers, FrontierType::Internal, MakeEdges(8, 4));
+
+    Join(frontiers, 9, 4, b, c); // b -> c
+    Join(frontiers, 2, 8, c, a); // c -> a
+
+    ASSERT_EQ(1u, frontiers.GetElementCount());
+
+    auto const rings = GetRings(frontiers);
+    ASSERT_EQ(1u, rings.size());
+    EXPECT_EQ(12, rings.at(a).Size);
+    EXPECT_EQ(std::set<ElementIndex>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }), rings.at(a).EdgeIndices);
+}
+
+TEST_F(FrontiersTests, SplitShorterIntoNewFrontier_RegionIsShorter)
+{
+    Frontiers frontiers(16, 16);
+    Frontiers referenceFrontiers(16, 16);
+
+    FrontierId const a = MakeRing(frontiers, FrontierType::External, MakeEdges(0, 10));
+    FrontierId const referenceA = MakeRing(referenceFrontiers, FrontierType::External, MakeEdges(0, 10));
+
+    FrontierId const newFrontierId = SplitShorter(frontiers, 2, 4, a);
+    FrontierId const referenceNewFrontierId = Split(referenceFrontiers, 2, 4, referenceA);
+
+    auto const rings = GetRings(frontiers);
+    auto const referenceRings = GetRings(referenceFrontiers);
+
+    EXPECT_EQ(referenceRings.at(referenceA), rings.at(a));
+    EXPECT_EQ(referenceRings.at(referenceNewFrontierId), rings.at(newFrontierId));
+    EXPECT_EQ(std::set<ElementIndex>({ 2, 3, 4 }), rings.at(newFrontierId).EdgeIndices);
+}
+
+TEST_F(FrontiersTests, SplitShorterIntoNewFrontier_RestIsShorter)
+{
+    Frontiers frontiers(16, 16);
+    Frontiers referenceFrontiers(16, 16);
+
+    FrontierId const a = MakeRing(frontiers, FrontierType::Internal, MakeEdges(0, 10));
+    FrontierId const referenceA = MakeRing(referenceFrontiers, FrontierType::Internal, MakeEdges(0, 10));
+
+    FrontierId const newFrontierId = SplitShorter(frontiers, 1, 7, a);
+    Split(referenceFrontiers, 1, 7, referenceA);
+
+    // Same two rings, but the new frontier is the shorter one
+    EXPECT_EQ(GetRingSet(referenceFrontiers), GetRingSet(frontiers));
+
+    auto const rings = GetRings(frontiers);
+    EXPECT_EQ(std::set<ElementIndex>({ 8, 9, 0 }), rings.at(newFrontierId).EdgeIndices);
+    EXPECT_EQ(std::set<ElementIndex>({ 1, 2, 3, 4, 5, 6, 7 }), rings.at(a).EdgeIndices);
+}
+
+TEST_F(FrontiersTests, Compact_KeepsFrontiersAndTheirOrder)
+{
+    Frontiers frontiers(64, 64);
+
+    std::vector<FrontierId> frontierIds;
+    for (ElementIndex r = 0; r < 8; ++r)
+    {
+        frontierIds.push_back(
+            MakeRing(frontiers, (r % 2) ? FrontierType::Internal : FrontierType::External, MakeEdges(r * 4, 4)));
+    }
+
+    // Merge some frontiers - including chains - and split some others
+    Join(frontiers, 4 * 1, 4 * 2, frontierIds[2], frontierIds[1]);
+    Join(frontiers, 4 * 1 + 1, 4 * 3, frontierIds[3], frontierIds[1]);
+    Join(frontiers, 4 * 5, 4 * 6, frontierIds[6], frontierIds[5]);
+    Join(frontiers, 4 * 0, 4 * 5, frontierIds[5], frontierIds[0]);
+    SplitShorter(frontiers, 4 * 7, 4 * 7 + 1, frontierIds[7]);
+
+    auto const ringsBefore = GetRings(frontiers);
+    ASSERT_LT(static_cast<size_t>(frontiers.GetElementCount()), GetSlotCount(frontiers));
+
+    frontiers.Compact();
+
+    // Slots are contiguous
+    ASSERT_EQ(static_cast<size_t>(frontiers.GetElementCount()), GetSlotCount(frontiers));
+    for (FrontierId f = 0; f < static_cast<FrontierId>(frontiers.GetElementCount()); ++f)
+    {
+        EXPECT_NE(frontiers.GetFrontierIds().cend(), std::find(frontiers.GetFrontierIds().cbegin(), frontiers.GetFrontierIds().cend(), f));
+    }
+
+    auto const ringsAfter = GetRings(frontiers);
+
+    // All edges carry the ID of their frontier
+    for (auto const & [frontierId, ring] : ringsAfter)
+    {
+        for (ElementIndex const edgeIndex : ring.EdgeIndices)
+        {
+            EXPECT_EQ(frontierId, GetRawEdgeFrontierId(frontiers, edgeIndex));
+        }
+    }
+
+    // Same frontiers, in the same order
+    ASSERT_EQ(ringsBefore.size(), ringsAfter.size());
+    auto itBefore = ringsBefore.cbegin();
+    auto itAfter = ringsAfter.cbegin();
+    for (; itBefore != ringsBefore.cend(); ++itBefore, ++itAfter)
+    {
+        EXPECT_EQ(itBefore->second, itAfter->second);
+    }
+}
+
+TEST_F(FrontiersTests, IsCompactionWorthwhile)
+{
+    Frontiers frontiers(1024, 1024);
+
+    FrontierId const a = MakeRing(frontiers, FrontierType::External, MakeEdges(0, 4));
+    for (ElementIndex r = 1; r < 128; ++r)
+    {
+        FrontierId const b = MakeRing(frontiers, FrontierType::Internal, MakeEdges(r * 4, 4));
+        Join(frontiers, 0, r * 4, b, a);
+
+        // A few free slots are not worth a compaction
+        EXPECT_EQ(r >= 64, frontiers.IsCompactionWorthwhile());
+    }
+
+    frontiers.Compact();
+
+    EXPECT_FALSE(frontiers.IsCompactionWorthwhile());
+    EXPECT_EQ(1u, frontiers.GetElementCount());
+}
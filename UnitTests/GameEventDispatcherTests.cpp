@@ -4,6 +4,8 @@
 
 #include "gmock/gmock.h"
 
+#include <thread>
+
 class _MockGameEventHandler
     : public IStructuralGameEventHandler
     , public ILifecycleGameEventHandler
@@ -106,6 +108,42 @@ TEST(GameEventDispatcherTests, OnSinkingBegin_MultipleShips)
     Mock::VerifyAndClear(&handler);
 }
 
+TEST(GameEventDispatcherTests, DefersEventsFiredOffDispatchingThread)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterLifecycleEventHandler(&handler);
+
+    dispatcher.SetDispatchingThread(std::this_thread::get_id());
+
+    EXPECT_CALL(handler, OnSinkingBegin(_)).Times(0);
+
+    // Fired by any other thread: deferred
+    std::thread([&dispatcher]() { dispatcher.OnSinkingBegin(7); }).join();
+    std::thread([&dispatcher]() { dispatcher.OnSinkingBegin(3); }).join();
+
+    Mock::VerifyAndClear(&handler);
+
+    {
+        InSequence s;
+
+        EXPECT_CALL(handler, OnSinkingBegin(7)).Times(1);
+        EXPECT_CALL(handler, OnSinkingBegin(3)).Times(1);
+    }
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+
+    // Fired by the dispatching thread: right away
+    EXPECT_CALL(handler, OnSinkingBegin(5)).Times(1);
+
+    dispatcher.OnSinkingBegin(5);
+
+    Mock::VerifyAndClear(&handler);
+}
+
 TEST(GameEventDispatcherTests, ClearsStateAtUpdate)
 {
     MockHandler handler;
@@ -0,0 +1,279 @@
+#include <GameCore/ImageTools.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(ImageToolsTests, MatchColorWithinTolerance_MatchesReference)
+{
+    std::mt19937 randomEngine(42);
+
+    // Not a multiple of the vector width, to exercise the scalar tail as well
+    size_t const pixelCount = 1027;
+
+    std::vector<rgbaColor> pixels;
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        pixels.emplace_back(
+            static_cast<std::uint8_t>(randomEngine() % 256),
+            static_cast<std::uint8_t>(randomEngine() % 256),
+            static_cast<std::uint8_t>(randomEngine() % 256),
+            static_cast<std::uint8_t>((i % 5 == 0) ? 0 : randomEngine() % 256));
+    }
+
+    rgbaColor const seedColor(120, 60, 200, 255);
+
+    for (unsigned int tolerance : { 0u, 1u, 20u, 37u, 50u, 99u, 100u })
+    {
+        std::vector<std::uint8_t> matches(pixelCount);
+        ImageTools::MatchColorWithinTolerance(pixels.data(), pixelCount, seedColor, tolerance, matches.data());
+
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            int const dr = std::abs(pixels[i].r - seedColor.r);
+            int const dg = std::abs(pixels[i].g - seedColor.g);
+            int const db = std::abs(pixels[i].b - seedColor.b);
+            int const distance = std::max({ dr, dg, db, std::abs(dr - dg), std::abs(dg - db), std::abs(db - dr) });
+
+            bool const expectedMatch = pixels[i].a != 0 && distance * 100 <= static_cast<int>(tolerance) * 255;
+
+            EXPECT_EQ(expectedMatch ? 1 : 0, matches[i]) << "tolerance=" << tolerance << " i=" << i;
+        }
+    }
+}
+
+TEST(ImageToolsTests, MatchColorWithinTolerance_SeedColorAlwaysMatches)
+{
+    rgbaColor const seedColor(10, 20, 30, 40);
+    std::vector<rgbaColor> pixels(9, seedColor);
+    pixels[4].a = 0;
+
+    std::vector<std::uint8_t> matches(pixels.size());
+    ImageTools::MatchColorWithinTolerance(pixels.data(), pixels.size(), seedColor, 0, matches.data());
+
+    EXPECT_EQ(std::vector<std::uint8_t>({ 1, 1, 1, 1, 0, 1, 1, 1, 1 }), matches);
+}
+
+namespace {
+
+    RgbaImageData MakeRandomImage(
+        ImageSize const & size,
+        unsigned int seed)
+    {
+        std::mt19937 randomEngine(seed);
+
+        RgbaImageData image(size);
+        for (size_t i = 0; i < size.GetLinearSize(); ++i)
+        {
+            image.Data[i] = rgbaColor(
+                static_cast<std::uint8_t>(randomEngine() % 256),
+                static_cast<std::uint8_t>(randomEngine() % 256),
+                static_cast<std::uint8_t>(randomEngine() % 256),
+                // Make sure we get the extremes
+                static_cast<std::uint8_t>((i % 7 == 0) ? 0 : ((i % 7 == 1) ? 255 : randomEngine() % 256)));
+        }
+
+        return image;
+    }
+
+    // The documented box filter
+    RgbaImageData ReferenceDownscaleBox2x(RgbaImageData const & image)
+    {
+        ImageSize const newSize(std::max(1, image.Size.width / 2), std::max(1, image.Size.height / 2));
+        RgbaImageData result(newSize);
+        for (int y = 0; y < newSize.height; ++y)
+        {
+            for (int x = 0; x < newSize.width; ++x)
+            {
+                rgbaColorAccumulation sum(image[{x * 2, y * 2}]);
+                if (image.Size.width > 1)
+                    sum += image[{x * 2 + 1, y * 2}];
+                if (image.Size.height > 1)
+                {
+                    sum += image[{x * 2, y * 2 + 1}];
+                    if (image.Size.width > 1)
+                        sum += image[{x * 2 + 1, y * 2 + 1}];
+                }
+
+                result[{x, y}] = sum.toRgbaColor();
+            }
+        }
+
+        return result;
+    }
+
+    // The documented bilinear resampling: at target pixel centers, in 1/256ths of a pixel,
+    // vertically first and then horizontally, rounding at each step
+    RgbaImageData ReferenceResampleBilinear(
+        RgbaImageData const & image,
+        ImageSize const & newSize)
+    {
+        auto const sample = [](int t, int sourceSize, int targetSize, int & i0, int & i1, int & w1)
+        {
+            std::int64_t const s = (static_cast<std::int64_t>(2 * t + 1) * sourceSize * 256) / (2 * static_cast<std::int64_t>(targetSize)) - 128;
+            i0 = (s > 0) ? static_cast<int>(s / 256) : 0;
+            w1 = (s > 0) ? static_cast<int>(s % 256) : 0;
+            if (i0 >= sourceSize - 1)
+            {
+                i0 = sourceSize - 1;
+                w1 = 0;
+            }
+
+            i1 = std::min(i0 + 1, sourceSize - 1);
+        };
+
+        auto const lerp = [](int v0, int v1, int w1)
+        {
+            return (v0 * (256 - w1) + v1 * w1 + 128) / 256;
+        };
+
+        RgbaImageData result(newSize);
+        for (int y = 0; y < newSize.height; ++y)
+        {
+            int y0, y1, wy;
+            sample(y, image.Size.height, newSize.height, y0, y1, wy);
+
+            for (int x = 0; x < newSize.width; ++x)
+            {
+                int x0, x1, wx;
+                sample(x, image.Size.width, newSize.width, x0, x1, wx);
+
+                auto const channel = [&](std::uint8_t rgbaColor::* c) -> std::uint8_t
+                {
+                    int const top = lerp(image[{x0, y0}].*c, image[{x0, y1}].*c, wy);
+                    int const bottom = lerp(image[{x1, y0}].*c, image[{x1, y1}].*c, wy);
+                    return static_cast<std::uint8_t>(lerp(top, bottom, wx));
+                };
+
+                result[{x, y}] = rgbaColor(
+                    channel(&rgbaColor::r),
+                    channel(&rgbaColor::g),
+                    channel(&rgbaColor::b),
+                    channel(&rgbaColor::a));
+            }
+        }
+
+        return result;
+    }
+
+    void ExpectSameImage(
+        RgbaImageData const & expected,
+        RgbaImageData const & actual)
+    {
+        ASSERT_EQ(expected.Size, actual.Size);
+        for (size_t i = 0; i < expected.Size.GetLinearSize(); ++i)
+        {
+            ASSERT_EQ(expected.Data[i], actual.Data[i]) << "i=" << i;
+        }
+    }
+}
+
+TEST(ImageToolsTests, AlphaPreMultiply_MatchesColorMath)
+{
+    // Not a multiple of the vector width, to exercise the scalar tail as well
+    RgbaImageData image = MakeRandomImage(ImageSize(37, 29), 1);
+    RgbaImageData expected = image.Clone();
+    for (size_t i = 0; i < expected.Size.GetLinearSize(); ++i)
+    {
+        expected.Data[i].alpha_multiply();
+    }
+
+    ImageTools::AlphaPreMultiply(image);
+
+    ExpectSameImage(expected, image);
+}
+
+TEST(ImageToolsTests, Overlay_MatchesColorMath)
+{
+    RgbaImageData const originalBase = MakeRandomImage(ImageSize(31, 23), 2);
+    RgbaImageData const overlay = MakeRandomImage(ImageSize(17, 13), 3);
+
+    // Fully inside, and spilling over the right and top edges
+    for (auto const & origin : { ImageCoordinates(5, 4), ImageCoordinates(22, 16) })
+    {
+        RgbaImageData base = originalBase.Clone();
+        ImageTools::Overlay(base, overlay, origin.x, origin.y);
+
+        for (int y = 0; y < base.Size.height; ++y)
+        {
+            for (int x = 0; x < base.Size.width; ++x)
+            {
+                ImageCoordinates const overlayCoords(x - origin.x, y - origin.y);
+                rgbaColor const expected = overlayCoords.IsInSize(overlay.Size)
+                    ? originalBase[{x, y}].blend(overlay[overlayCoords])
+                    : originalBase[{x, y}];
+
+                ASSERT_EQ(expected, (base[{x, y}])) << "x=" << x << " y=" << y;
+            }
+        }
+    }
+}
+
+TEST(ImageToolsTests, BlendWithColor_MatchesColorMath)
+{
+    for (float alpha : { 0.0f, 0.1f, 0.5f, 0.77f, 1.0f })
+    {
+        RgbaImageData image = MakeRandomImage(ImageSize(19, 7), 4);
+        RgbaImageData expected = image.Clone();
+        for (size_t i = 0; i < expected.Size.GetLinearSize(); ++i)
+        {
+            expected.Data[i] = expected.Data[i].mix(rgbColor(12, 200, 99), alpha);
+        }
+
+        ImageTools::BlendWithColor(image, rgbColor(12, 200, 99), alpha);
+
+        ExpectSameImage(expected, image);
+    }
+}
+
+TEST(ImageToolsTests, ToRgbAndToAlpha_ExtractChannels)
+{
+    RgbaImageData const image = MakeRandomImage(ImageSize(11, 3), 5);
+
+    RgbImageData const rgb = ImageTools::ToRgb(image);
+    RgbImageData const alpha = ImageTools::ToAlpha(image);
+
+    ASSERT_EQ(image.Size, rgb.Size);
+    ASSERT_EQ(image.Size, alpha.Size);
+    for (size_t i = 0; i < image.Size.GetLinearSize(); ++i)
+    {
+        EXPECT_EQ(image.Data[i].toRgbColor(), rgb.Data[i]) << "i=" << i;
+        EXPECT_EQ(rgbColor(image.Data[i].a, image.Data[i].a, image.Data[i].a), alpha.Data[i]) << "i=" << i;
+    }
+}
+
+TEST(ImageToolsTests, DownscaleBox2x_MatchesBoxFilter)
+{
+    for (auto const & size : { ImageSize(1, 1), ImageSize(1, 9), ImageSize(9, 1), ImageSize(2, 2), ImageSize(16, 8), ImageSize(37, 21) })
+    {
+        RgbaImageData const image = MakeRandomImage(size, 6);
+
+        ExpectSameImage(
+            ReferenceDownscaleBox2x(image),
+            ImageTools::DownscaleBox2x(image));
+    }
+}
+
+TEST(ImageToolsTests, Resize_Bilinear_MatchesReference)
+{
+    RgbaImageData const image = MakeRandomImage(ImageSize(23, 17), 7);
+
+    // Not shrinking to half or below, hence no box filtering
+    for (auto const & newSize : { ImageSize(23, 17), ImageSize(40, 33), ImageSize(13, 10), ImageSize(12, 9), ImageSize(23, 40) })
+    {
+        ExpectSameImage(
+            ReferenceResampleBilinear(image, newSize),
+            ImageTools::Resize(image.Clone(), newSize));
+    }
+}
+
+TEST(ImageToolsTests, Resize_Shrink_BoxFiltersFirst)
+{
+    RgbaImageData const image = MakeRandomImage(ImageSize(101, 67), 8);
+
+    ExpectSameImage(
+        ReferenceResampleBilinear(ReferenceDownscaleBox2x(ReferenceDownscaleBox2x(image)), ImageSize(20, 15)),
+        ImageTools::Resize(image.Clone(), ImageSize(20, 15)));
+}
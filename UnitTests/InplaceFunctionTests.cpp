@@ -0,0 +1,149 @@
+#include <GameCore/InplaceFunction.h>
+
+#include <array>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    struct InstanceCounter
+    {
+        static int Instances;
+
+        InstanceCounter()
+        {
+            ++Instances;
+        }
+
+        InstanceCounter(InstanceCounter const &)
+        {
+            ++Instances;
+        }
+
+        InstanceCounter(InstanceCounter &&) noexcept
+        {
+            ++Instances;
+        }
+
+        ~InstanceCounter()
+        {
+            --Instances;
+        }
+    };
+
+    int InstanceCounter::Instances = 0;
+}
+
+TEST(InplaceFunctionTests, Empty)
+{
+    InplaceFunction<void(), 32> f;
+    EXPECT_FALSE(f);
+
+    InplaceFunction<void(), 32> g(nullptr);
+    EXPECT_FALSE(g);
+}
+
+TEST(InplaceFunctionTests, Invoke)
+{
+    int const base = 10;
+    InplaceFunction<int(int, int), 32> f(
+        [base](int a, int b)
+        {
+            return base + a * b;
+        });
+
+    ASSERT_TRUE(f);
+    EXPECT_EQ(16, f(2, 3));
+}
+
+TEST(InplaceFunctionTests, Invoke_Mutable)
+{
+    InplaceFunction<int(), 32> f(
+        [counter = 0]() mutable
+        {
+            return ++counter;
+        });
+
+    EXPECT_EQ(1, f());
+    EXPECT_EQ(2, f());
+}
+
+TEST(InplaceFunctionTests, Invoke_MoveOnlyCapture)
+{
+    InplaceFunction<int(), 32> f(
+        [p = std::make_unique<int>(7)]()
+        {
+            return *p;
+        });
+
+    EXPECT_EQ(7, f());
+}
+
+TEST(InplaceFunctionTests, Invoke_FillsCapacity)
+{
+    std::array<int, 8> values{ 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    InplaceFunction<int(), sizeof(values)> f(
+        [values]()
+        {
+            int sum = 0;
+            for (int v : values)
+                sum += v;
+            return sum;
+        });
+
+    EXPECT_EQ(36, f());
+}
+
+TEST(InplaceFunctionTests, Move)
+{
+    InplaceFunction<int(), 32> f(
+        []()
+        {
+            return 5;
+        });
+
+    InplaceFunction<int(), 32> g(std::move(f));
+    EXPECT_FALSE(f);
+    ASSERT_TRUE(g);
+    EXPECT_EQ(5, g());
+
+    InplaceFunction<int(), 32> h;
+    h = std::move(g);
+    EXPECT_FALSE(g);
+    ASSERT_TRUE(h);
+    EXPECT_EQ(5, h());
+}
+
+TEST(InplaceFunctionTests, DestroysTarget)
+{
+    ASSERT_EQ(0, InstanceCounter::Instances);
+
+    {
+        InplaceFunction<void(), 32> f(
+            [c = InstanceCounter()]()
+            {
+            });
+
+        EXPECT_EQ(1, InstanceCounter::Instances);
+
+        InplaceFunction<void(), 32> g(std::move(f));
+
+        EXPECT_EQ(1, InstanceCounter::Instances);
+
+        g = nullptr;
+
+        EXPECT_EQ(0, InstanceCounter::Instances);
+        EXPECT_FALSE(g);
+
+        g = InplaceFunction<void(), 32>(
+            [c = InstanceCounter()]()
+            {
+            });
+
+        EXPECT_EQ(1, InstanceCounter::Instances);
+    }
+
+    EXPECT_EQ(0, InstanceCounter::Instances);
+}
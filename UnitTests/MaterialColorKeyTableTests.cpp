@@ -0,0 +1,109 @@
+#include <Game/MaterialColorKeyTable.h>
+#include <Game/Materials.h>
+
+#include "Utils.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(MaterialColorKeyTableTests, Empty)
+{
+    MaterialColorKeyTable<StructuralMaterial> table;
+
+    EXPECT_EQ(0u, table.GetSize());
+    EXPECT_EQ(nullptr, table.Find(MaterialColorKey(0, 0, 0)));
+    EXPECT_EQ(nullptr, table.Find(MaterialColorKey(255, 255, 255)));
+}
+
+TEST(MaterialColorKeyTableTests, FromMap_MatchesMap)
+{
+    std::mt19937 randomEngine(42);
+    std::uniform_int_distribution<int> componentDistribution(0, 255);
+
+    auto const makeRandomColorKey = [&]()
+    {
+        return MaterialColorKey(
+            static_cast<rgbColor::data_type>(componentDistribution(randomEngine)),
+            static_cast<rgbColor::data_type>(componentDistribution(randomEngine)),
+            static_cast<rgbColor::data_type>(componentDistribution(randomEngine)));
+    };
+
+    std::map<MaterialColorKey, StructuralMaterial> materialMap;
+    for (int i = 0; i < 500; ++i)
+    {
+        MaterialColorKey const colorKey = makeRandomColorKey();
+        materialMap.emplace(colorKey, MakeTestStructuralMaterial("m" + std::to_string(i), colorKey));
+    }
+
+    MaterialColorKeyTable<StructuralMaterial> const table(materialMap);
+
+    EXPECT_EQ(materialMap.size(), table.GetSize());
+
+    // All present keys
+    for (auto const & entry : materialMap)
+    {
+        EXPECT_EQ(&(entry.second), table.Find(entry.first));
+    }
+
+    // Random keys, mostly absent
+    for (int i = 0; i < 10000; ++i)
+    {
+        MaterialColorKey const colorKey = makeRandomColorKey();
+        auto const it = materialMap.find(colorKey);
+        EXPECT_EQ(it != materialMap.end() ? &(it->second) : nullptr, table.Find(colorKey));
+    }
+}
+
+TEST(MaterialColorKeyTableTests, FromEntries_FirstDuplicateWins)
+{
+    StructuralMaterial const material1 = MakeTestStructuralMaterial("m1", rgbColor(1, 2, 3));
+    StructuralMaterial const material2 = MakeTestStructuralMaterial("m2", rgbColor(1, 2, 3));
+    StructuralMaterial const material3 = MakeTestStructuralMaterial("m3", rgbColor(0, 0, 0));
+
+    MaterialColorKeyTable<StructuralMaterial> const table(
+        std::vector<std::pair<MaterialColorKey, StructuralMaterial const *>>{
+            { rgbColor(1, 2, 3), &material1 },
+            { rgbColor(1, 2, 3), &material2 },
+            { rgbColor(0, 0, 0), &material3 } });
+
+    EXPECT_EQ(2u, table.GetSize());
+    EXPECT_EQ(&material1, table.Find(rgbColor(1, 2, 3)));
+    EXPECT_EQ(&material3, table.Find(rgbColor(0, 0, 0)));
+    EXPECT_EQ(nullptr, table.Find(rgbColor(3, 2, 1)));
+}
+
+TEST(MaterialColorKeyTableTests, BatchFind_MatchesSingleFind)
+{
+    std::map<MaterialColorKey, StructuralMaterial> materialMap;
+    materialMap.emplace(rgbColor(10, 0, 0), MakeTestStructuralMaterial("a", rgbColor(10, 0, 0)));
+    materialMap.emplace(rgbColor(0, 10, 0), MakeTestStructuralMaterial("b", rgbColor(0, 10, 0)));
+    materialMap.emplace(rgbColor(0, 0, 10), MakeTestStructuralMaterial("c", rgbColor(0, 0, 10)));
+
+    MaterialColorKeyTable<StructuralMaterial> const table(materialMap);
+
+    std::vector<MaterialColorKey> const colorKeys{
+        rgbColor(255, 255, 255),
+        rgbColor(10, 0, 0),
+        rgbColor(10, 0, 0),
+        rgbColor(10, 0, 0),
+        rgbColor(0, 10, 0),
+        rgbColor(255, 255, 255),
+        rgbColor(255, 255, 255),
+        rgbColor(0, 0, 10),
+        rgbColor(10, 0, 0) };
+
+    std::vector<StructuralMaterial const *> materials(colorKeys.size(), nullptr);
+    table.Find(colorKeys.data(), colorKeys.size(), materials.data());
+
+    for (size_t i = 0; i < colorKeys.size(); ++i)
+    {
+        EXPECT_EQ(table.Find(colorKeys[i]), materials[i]);
+    }
+
+    EXPECT_EQ(nullptr, materials[0]);
+    EXPECT_EQ(&(materialMap.at(rgbColor(10, 0, 0))), materials[3]);
+    EXPECT_EQ(&(materialMap.at(rgbColor(0, 0, 10))), materials[7]);
+}
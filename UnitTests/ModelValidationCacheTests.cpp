@@ -0,0 +1,161 @@
+#include <ShipBuilderLib/ModelValidationCache.h>
+
+#include "Utils.h"
+
+#include "gtest/gtest.h"
+
+namespace ShipBuilder {
+
+class ModelValidationCacheTests : public testing::Test
+{
+protected:
+
+    ModelValidationCacheTests()
+        : mThreadManager(false, 4)
+        , mThreadPool(4, mThreadManager)
+        , mStructuralMaterial(MakeTestStructuralMaterial("s", rgbColor(1, 2, 3)))
+        , mCableMaterial(MakeTestElectricalMaterial("cable", rgbColor(1, 2, 3)))
+        , mGeneratorMaterial(MakeTestElectricalMaterial("generator", rgbColor(4, 5, 6)))
+        , mLampMaterial(MakeTestElectricalMaterial("lamp", rgbColor(7, 8, 9), true))
+    {
+        mCableMaterial.Luminiscence = 0.0f;
+
+        mGeneratorMaterial.ElectricalType = ElectricalMaterial::ElectricalElementType::Generator;
+        mGeneratorMaterial.Luminiscence = 0.0f;
+
+        mLampMaterial.ElectricalType = ElectricalMaterial::ElectricalElementType::Lamp;
+        mLampMaterial.IsSelfPowered = false;
+        mLampMaterial.Luminiscence = 1.0f;
+    }
+
+    // Generator -> cable across block boundary -> lamp, all on structure
+    void MakeCircuit(
+        StructuralLayerData & structuralLayer,
+        ElectricalLayerData & electricalLayer,
+        int y)
+    {
+        for (int x = 28; x <= 36; ++x)
+        {
+            structuralLayer.Buffer[{x, y}] = StructuralElement(&mStructuralMaterial);
+        }
+
+        electricalLayer.Buffer[{28, y}] = ElectricalElement(&mGeneratorMaterial, NoneElectricalElementInstanceIndex);
+        for (int x = 29; x < 36; ++x)
+        {
+            electricalLayer.Buffer[{x, y}] = ElectricalElement(&mCableMaterial, NoneElectricalElementInstanceIndex);
+        }
+        electricalLayer.Buffer[{36, y}] = ElectricalElement(&mLampMaterial, ElectricalElementInstanceIndex(y));
+    }
+
+    void Update(
+        ModelValidationCache & cache,
+        StructuralLayerData const & structuralLayer,
+        ElectricalLayerData const & electricalLayer)
+    {
+        cache.UpdateLayerStatistics(&structuralLayer, &electricalLayer, nullptr, mThreadPool);
+    }
+
+    void ExpectSameConnectivity(
+        ModelValidationCache::ElectricalConnectivity const & expected,
+        ModelValidationCache::ElectricalConnectivity const & actual)
+    {
+        EXPECT_EQ(expected.HasElectricals, actual.HasElectricals);
+        EXPECT_EQ(expected.HasEngines, actual.HasEngines);
+        EXPECT_EQ(expected.UnpoweredElectricalComponentCount, actual.UnpoweredElectricalComponentCount);
+        EXPECT_EQ(expected.UnconsumedElectricalSourceCount, actual.UnconsumedElectricalSourceCount);
+        EXPECT_EQ(expected.UnpoweredEngineComponentCount, actual.UnpoweredEngineComponentCount);
+        EXPECT_EQ(expected.UnconsumedEngineSourceCount, actual.UnconsumedEngineSourceCount);
+    }
+
+    ThreadManager mThreadManager;
+    ThreadPool mThreadPool;
+
+    StructuralMaterial mStructuralMaterial;
+    ElectricalMaterial mCableMaterial;
+    ElectricalMaterial mGeneratorMaterial;
+    ElectricalMaterial mLampMaterial;
+};
+
+TEST_F(ModelValidationCacheTests, Statistics)
+{
+    ShipSpaceSize const shipSize(80, 70);
+    StructuralLayerData structuralLayer(shipSize);
+    ElectricalLayerData electricalLayer(shipSize);
+
+    MakeCircuit(structuralLayer, electricalLayer, 10);
+    MakeCircuit(structuralLayer, electricalLayer, 40);
+
+    // Electrical element without substratum
+    electricalLayer.Buffer[{70, 65}] = ElectricalElement(&mCableMaterial, NoneElectricalElementInstanceIndex);
+
+    ModelValidationCache cache;
+    Update(cache, structuralLayer, electricalLayer);
+
+    EXPECT_EQ(18u, cache.CalculateStructuralStatistics().StructuralParticlesCount);
+
+    auto const electricalStatistics = cache.CalculateElectricalStatistics(electricalLayer.Panel);
+    EXPECT_EQ(1u, electricalStatistics.ElectricalParticlesWithNoStructuralSubstratumCount);
+    EXPECT_EQ(2u, electricalStatistics.LightEmittingParticlesCount);
+    EXPECT_EQ(2u, electricalStatistics.VisibleElectricalPanelElementsCount);
+
+    auto const & connectivity = cache.UpdateElectricalConnectivity(mThreadPool);
+    EXPECT_TRUE(connectivity.HasElectricals);
+    EXPECT_FALSE(connectivity.HasEngines);
+    EXPECT_EQ(1u, connectivity.UnpoweredElectricalComponentCount); // The stray cable
+    EXPECT_EQ(0u, connectivity.UnconsumedElectricalSourceCount);
+}
+
+TEST_F(ModelValidationCacheTests, Incremental_MatchesFresh)
+{
+    ShipSpaceSize const shipSize(80, 70);
+    StructuralLayerData structuralLayer(shipSize);
+    ElectricalLayerData electricalLayer(shipSize);
+
+    MakeCircuit(structuralLayer, electricalLayer, 10);
+    MakeCircuit(structuralLayer, electricalLayer, 40);
+
+    ModelValidationCache cache;
+    Update(cache, structuralLayer, electricalLayer);
+    cache.UpdateElectricalConnectivity(mThreadPool);
+
+    // Break first circuit right at the block boundary
+    electricalLayer.Buffer[{32, 10}] = ElectricalElement();
+    cache.InvalidateRegion(LayerType::Electrical, ShipSpaceRect(ShipSpaceCoordinates(32, 10)));
+
+    // Remove structure under second circuit's lamp
+    structuralLayer.Buffer[{36, 40}] = StructuralElement(nullptr);
+    cache.InvalidateRegion(LayerType::Structural, ShipSpaceRect(ShipSpaceCoordinates(36, 40)));
+
+    Update(cache, structuralLayer, electricalLayer);
+
+    ModelValidationCache freshCache;
+    Update(freshCache, structuralLayer, electricalLayer);
+
+    EXPECT_EQ(
+        freshCache.CalculateStructuralStatistics().StructuralParticlesCount,
+        cache.CalculateStructuralStatistics().StructuralParticlesCount);
+    EXPECT_EQ(17u, cache.CalculateStructuralStatistics().StructuralParticlesCount);
+
+    auto const freshElectricalStatistics = freshCache.CalculateElectricalStatistics(electricalLayer.Panel);
+    auto const electricalStatistics = cache.CalculateElectricalStatistics(electricalLayer.Panel);
+    EXPECT_EQ(freshElectricalStatistics.ElectricalParticlesWithNoStructuralSubstratumCount, electricalStatistics.ElectricalParticlesWithNoStructuralSubstratumCount);
+    EXPECT_EQ(1u, electricalStatistics.ElectricalParticlesWithNoStructuralSubstratumCount);
+    EXPECT_EQ(freshElectricalStatistics.LightEmittingParticlesCount, electricalStatistics.LightEmittingParticlesCount);
+
+    auto const & connectivity = cache.UpdateElectricalConnectivity(mThreadPool);
+    ExpectSameConnectivity(freshCache.UpdateElectricalConnectivity(mThreadPool), connectivity);
+    EXPECT_EQ(4u, connectivity.UnpoweredElectricalComponentCount); // Three cables and the lamp
+    EXPECT_EQ(1u, connectivity.UnconsumedElectricalSourceCount);
+
+    // Repair and re-validate
+    electricalLayer.Buffer[{32, 10}] = ElectricalElement(&mCableMaterial, NoneElectricalElementInstanceIndex);
+    cache.InvalidateRegion(LayerType::Electrical, ShipSpaceRect(ShipSpaceCoordinates(32, 10)));
+
+    Update(cache, structuralLayer, electricalLayer);
+
+    auto const & repairedConnectivity = cache.UpdateElectricalConnectivity(mThreadPool);
+    EXPECT_EQ(0u, repairedConnectivity.UnpoweredElectricalComponentCount);
+    EXPECT_EQ(0u, repairedConnectivity.UnconsumedElectricalSourceCount);
+}
+
+}
@@ -0,0 +1,77 @@
+#include <Game/PointNeighborStencil.h>
+
+#include "gtest/gtest.h"
+
+TEST(PointNeighborStencilTests, Empty)
+{
+    PointNeighborStencil stencil;
+
+    EXPECT_EQ(0u, stencil.GetPointCount());
+    EXPECT_EQ(0u, stencil.GetNeighborCount());
+    EXPECT_EQ(0u, stencil.GetPointOffsets()[0]);
+}
+
+TEST(PointNeighborStencilTests, Neighbors)
+{
+    PointNeighborStencil stencil;
+
+    // Point 0: two neighbors
+    stencil.AddNeighbor(1, 10, 1.0f, 0.5f, 2.0f);
+    stencil.AddNeighbor(2, 11, 0.0f, 0.25f, 3.0f);
+    stencil.EndPoint();
+
+    // Point 1: no neighbors
+    stencil.EndPoint();
+
+    // Point 2: one neighbor
+    stencil.AddNeighbor(0, 11, 0.0f, 0.25f, 3.0f);
+    stencil.EndPoint();
+
+    ASSERT_EQ(3u, stencil.GetPointCount());
+    ASSERT_EQ(3u, stencil.GetNeighborCount());
+
+    EXPECT_EQ(0u, stencil.GetPointOffsets()[0]);
+    EXPECT_EQ(2u, stencil.GetPointOffsets()[1]);
+    EXPECT_EQ(2u, stencil.GetPointOffsets()[2]);
+    EXPECT_EQ(3u, stencil.GetPointOffsets()[3]);
+
+    EXPECT_EQ(1u, stencil.GetNeighborPointIndices()[0]);
+    EXPECT_EQ(2u, stencil.GetNeighborPointIndices()[1]);
+    EXPECT_EQ(0u, stencil.GetNeighborPointIndices()[2]);
+
+    EXPECT_EQ(10u, stencil.GetSpringIndices()[0]);
+    EXPECT_EQ(11u, stencil.GetSpringIndices()[1]);
+    EXPECT_EQ(11u, stencil.GetSpringIndices()[2]);
+
+    EXPECT_EQ(1.0f, stencil.GetWaterPermeabilities()[0]);
+    EXPECT_EQ(0.0f, stencil.GetWaterPermeabilities()[1]);
+
+    EXPECT_EQ(0.5f, stencil.GetRestLengthReciprocals()[0]);
+    EXPECT_EQ(0.25f, stencil.GetRestLengthReciprocals()[2]);
+
+    EXPECT_EQ(2.0f, stencil.GetThermalConductances()[0]);
+    EXPECT_EQ(3.0f, stencil.GetThermalConductances()[1]);
+}
+
+TEST(PointNeighborStencilTests, Clear)
+{
+    PointNeighborStencil stencil;
+
+    stencil.AddNeighbor(1, 0, 1.0f, 1.0f, 1.0f);
+    stencil.EndPoint();
+    stencil.AddNeighbor(0, 0, 1.0f, 1.0f, 1.0f);
+    stencil.EndPoint();
+
+    stencil.Clear();
+
+    EXPECT_EQ(0u, stencil.GetPointCount());
+    EXPECT_EQ(0u, stencil.GetNeighborCount());
+
+    stencil.AddNeighbor(4, 7, 1.0f, 1.0f, 1.0f);
+    stencil.EndPoint();
+
+    ASSERT_EQ(1u, stencil.GetPointCount());
+    EXPECT_EQ(1u, stencil.GetPointOffsets()[1]);
+    EXPECT_EQ(4u, stencil.GetNeighborPointIndices()[0]);
+    EXPECT_EQ(7u, stencil.GetSpringIndices()[0]);
+}
@@ -0,0 +1,214 @@
+#include <GameCore/Buffer2D.h>
+#include <GameCore/ScanlineFill.h>
+
+#include <queue>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    using TestBuffer = Buffer2D<int, struct IntegralTag>;
+    using TestFill = ScanlineFill<struct IntegralTag>;
+
+    // Reference: per-element BFS
+    Buffer2D<bool, struct IntegralTag> ReferenceFill(
+        TestBuffer const & buffer,
+        IntegralCoordinates const & start,
+        TestFill::ConnectivityType connectivity)
+    {
+        Buffer2D<bool, struct IntegralTag> filled(buffer.Size, false);
+
+        int const value = buffer[start];
+
+        std::queue<IntegralCoordinates> toVisit;
+        filled[start] = true;
+        toVisit.push(start);
+
+        while (!toVisit.empty())
+        {
+            auto const coords = toVisit.front();
+            toVisit.pop();
+
+            for (int yn = coords.y - 1; yn <= coords.y + 1; ++yn)
+            {
+                for (int xn = coords.x - 1; xn <= coords.x + 1; ++xn)
+                {
+                    if (connectivity == TestFill::ConnectivityType::Four
+                        && xn != coords.x && yn != coords.y)
+                    {
+                        continue;
+                    }
+
+                    IntegralCoordinates const neighbor(xn, yn);
+                    if (neighbor.IsInSize(buffer.Size)
+                        && !filled[neighbor]
+                        && buffer[neighbor] == value)
+                    {
+                        filled[neighbor] = true;
+                        toVisit.push(neighbor);
+                    }
+                }
+            }
+        }
+
+        return filled;
+    }
+}
+
+TEST(Buffer2DMaskTests, SetSpan)
+{
+    Buffer2DMask<struct IntegralTag> mask(IntegralRectSize(150, 3));
+
+    mask.SetSpan(1, 3, 140);
+
+    for (int y = 0; y < 3; ++y)
+    {
+        for (int x = 0; x < 150; ++x)
+        {
+            EXPECT_EQ(y == 1 && x >= 3 && x < 140, mask.Get(x, y));
+        }
+    }
+}
+
+TEST(ScanlineFillTests, Fill_NotFillableStart)
+{
+    TestBuffer buffer(4, 4, 0);
+
+    TestFill fill(buffer.Size);
+
+    auto const result = fill.Fill(
+        IntegralCoordinates(1, 1),
+        TestFill::ConnectivityType::Four,
+        [&](int x, int y) { return buffer[{x, y}] == 1; },
+        [](int, int, int) {});
+
+    EXPECT_FALSE(result.has_value());
+}
+
+TEST(ScanlineFillTests, Fill_FourConnectivity_DoesNotCrossDiagonals)
+{
+    // Row 0: X . . .
+    // Row 1: . X . .
+    // Row 2: . . X .
+    TestBuffer buffer(4, 3, 0);
+    buffer[{2, 2}] = 1;
+    buffer[{1, 1}] = 1;
+    buffer[{0, 0}] = 1;
+
+    TestFill fill(buffer.Size);
+
+    std::vector<std::tuple<int, int, int>> spans;
+    auto const result = fill.Fill(
+        IntegralCoordinates(0, 1),
+        TestFill::ConnectivityType::Four,
+        [&](int x, int y) { return buffer[{x, y}] == 0; },
+        [&](int y, int xStart, int xEnd) { spans.emplace_back(y, xStart, xEnd); });
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(IntegralRect(IntegralCoordinates(0, 1), IntegralRectSize(2, 2)), *result);
+    EXPECT_EQ(2u, spans.size());
+
+    EXPECT_TRUE(fill.GetFilledMask().Get(0, 1));
+    EXPECT_TRUE(fill.GetFilledMask().Get(0, 2));
+    EXPECT_TRUE(fill.GetFilledMask().Get(1, 2));
+    EXPECT_FALSE(fill.GetFilledMask().Get(1, 0));
+    EXPECT_FALSE(fill.GetFilledMask().Get(2, 1));
+}
+
+TEST(ScanlineFillTests, Fill_EightConnectivity_CrossesDiagonals)
+{
+    TestBuffer buffer(4, 3, 0);
+    buffer[{2, 2}] = 1;
+    buffer[{1, 1}] = 1;
+    buffer[{0, 0}] = 1;
+
+    TestFill fill(buffer.Size);
+
+    auto const result = fill.Fill(
+        IntegralCoordinates(1, 1),
+        TestFill::ConnectivityType::Eight,
+        [&](int x, int y) { return buffer[{x, y}] == 1; },
+        [](int, int, int) {});
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(IntegralRect(IntegralCoordinates(0, 0), IntegralRectSize(3, 3)), *result);
+}
+
+class ScanlineFillTests_Random : public testing::TestWithParam<TestFill::ConnectivityType>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ScanlineFillTests,
+    ScanlineFillTests_Random,
+    ::testing::Values(
+        TestFill::ConnectivityType::Four,
+        TestFill::ConnectivityType::Eight
+    ));
+
+TEST_P(ScanlineFillTests_Random, MatchesReference)
+{
+    auto const connectivity = GetParam();
+
+    std::mt19937 randomEngine(42);
+
+    for (int iter = 0; iter < 200; ++iter)
+    {
+        int const width = 1 + static_cast<int>(randomEngine() % 50);
+        int const height = 1 + static_cast<int>(randomEngine() % 50);
+
+        TestBuffer buffer(width, height);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                buffer[{x, y}] = static_cast<int>(randomEngine() % 3);
+            }
+        }
+
+        IntegralCoordinates const start(
+            static_cast<int>(randomEngine() % width),
+            static_cast<int>(randomEngine() % height));
+
+        int const startValue = buffer[start];
+
+        TestFill fill(buffer.Size);
+
+        int spanElementCount = 0;
+        auto const result = fill.Fill(
+            start,
+            connectivity,
+            [&](int x, int y) { return buffer[{x, y}] == startValue; },
+            [&](int, int xStart, int xEnd) { spanElementCount += xEnd - xStart; });
+
+        auto const reference = ReferenceFill(buffer, start, connectivity);
+
+        ASSERT_TRUE(result.has_value());
+
+        int referenceElementCount = 0;
+        std::optional<IntegralRect> referenceRect;
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                ASSERT_EQ(reference[IntegralCoordinates(x, y)], fill.GetFilledMask().Get(x, y));
+
+                if (reference[{x, y}])
+                {
+                    ++referenceElementCount;
+
+                    if (!referenceRect.has_value())
+                        referenceRect = IntegralRect(IntegralCoordinates(x, y));
+                    else
+                        referenceRect->UnionWith(IntegralCoordinates(x, y));
+                }
+            }
+        }
+
+        EXPECT_EQ(referenceElementCount, spanElementCount);
+        EXPECT_EQ(*referenceRect, *result);
+    }
+}
@@ -207,7 +207,7 @@ protected:
         ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<StructuralMaterial>(TestMaterialMap),
             targetStructuralLayer);
 
         EXPECT_EQ(targetStructuralLayer->Buffer.Size, sourceStructuralLayer.Buffer.Size);
@@ -459,7 +459,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_StructuralLayerTests, UnrecognizedMateri
         ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<StructuralMaterial>(TestMaterialMap),
             targetStructuralLayer);
 
         FAIL();
@@ -504,7 +504,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_StructuralLayerTests, UnrecognizedMateri
         ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<StructuralMaterial>(TestMaterialMap),
             targetStructuralLayer);
 
         FAIL();
@@ -554,7 +554,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_StructuralLayerTests, UnrecognizedMateri
         ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<StructuralMaterial>(TestMaterialMap),
             targetStructuralLayer);
 
         FAIL();
@@ -599,7 +599,7 @@ protected:
         ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<ElectricalMaterial>(TestMaterialMap),
             targetElectricalLayer);
 
         // Buffer
@@ -904,7 +904,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_ElectricalLayerTests, UnrecognizedMateri
         ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<ElectricalMaterial>(TestMaterialMap),
             targetElectricalLayer);
 
         FAIL();
@@ -949,7 +949,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_ElectricalLayerTests, UnrecognizedMateri
         ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<ElectricalMaterial>(TestMaterialMap),
             targetElectricalLayer);
 
         FAIL();
@@ -999,7 +999,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_ElectricalLayerTests, UnrecognizedMateri
         ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<ElectricalMaterial>(TestMaterialMap),
             targetElectricalLayer);
 
         FAIL();
@@ -1043,7 +1043,7 @@ protected:
         ShipDefinitionFormatDeSerializer::ReadRopesLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<StructuralMaterial>(TestMaterialMap),
             targetRopesLayer);
 
         EXPECT_EQ(targetRopesLayer->Buffer.GetSize(), sourceRopesLayer.Buffer.GetSize());
@@ -1127,7 +1127,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_RopesLayerTests, UnrecognizedMaterial_Sa
         ShipDefinitionFormatDeSerializer::ReadRopesLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<StructuralMaterial>(TestMaterialMap),
             targetRopesLayer);
 
         FAIL();
@@ -1172,7 +1172,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_RopesLayerTests, UnrecognizedMaterial_La
         ShipDefinitionFormatDeSerializer::ReadRopesLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<StructuralMaterial>(TestMaterialMap),
             targetRopesLayer);
 
         FAIL();
@@ -1222,7 +1222,7 @@ TEST_F(ShipDefinitionFormatDeSerializer_RopesLayerTests, UnrecognizedMaterial_La
         ShipDefinitionFormatDeSerializer::ReadRopesLayer(
             buffer,
             shipAttributes,
-            TestMaterialMap,
+            MaterialColorKeyTable<StructuralMaterial>(TestMaterialMap),
             targetRopesLayer);
 
         FAIL();
@@ -0,0 +1,422 @@
+#include <Game/ShipMetadataIndex.h>
+
+#include "Utils.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    std::filesystem::path const TestRootDirectory = std::filesystem::path("Ships");
+
+    std::filesystem::file_time_type MakeLastModified(int seconds)
+    {
+        return std::filesystem::file_time_type::min() + std::chrono::seconds(seconds);
+    }
+
+    ShipPreviewData MakePreviewData(
+        std::filesystem::path const & shipFilePath,
+        std::string const & shipName,
+        std::optional<std::string> author = std::nullopt,
+        std::optional<std::string> yearBuilt = std::nullopt)
+    {
+        ShipMetadata metadata(shipName);
+        metadata.Author = author;
+        metadata.YearBuilt = yearBuilt;
+
+        return ShipPreviewData(
+            shipFilePath,
+            ShipSpaceSize(120, 40),
+            metadata,
+            true,
+            false,
+            PortableTimepoint(42));
+    }
+
+    struct TestShip
+    {
+        std::string ShipFilename;
+        std::string ShipName;
+        std::optional<std::string> Author;
+        std::optional<std::string> YearBuilt;
+    };
+
+    void PopulateIndex(
+        std::filesystem::path const & directoryPath,
+        std::vector<TestShip> const & ships,
+        std::shared_ptr<TestFileSystem> testFileSystem)
+    {
+        auto index = ShipMetadataIndex::Load(directoryPath, testFileSystem);
+        for (auto const & ship : ships)
+        {
+            auto const shipFilePath = directoryPath / ship.ShipFilename;
+
+            index.Update(
+                shipFilePath,
+                MakeLastModified(10),
+                MakePreviewData(shipFilePath, ship.ShipName, ship.Author, ship.YearBuilt));
+        }
+
+        index.Commit(true);
+    }
+}
+
+TEST(ShipMetadataIndexTests, Load_NoFile)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+
+    EXPECT_TRUE(index.GetEntries().empty());
+}
+
+TEST(ShipMetadataIndexTests, Load_CorruptedFile)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+    testFileSystem->PrepareTestFile(ShipMetadataIndex::GetIndexFilePath(TestRootDirectory), "Not an index at all");
+
+    auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+
+    EXPECT_TRUE(index.GetEntries().empty());
+}
+
+TEST(ShipMetadataIndexTests, Commit_Load_Roundtrip)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    auto const shipFilePath = TestRootDirectory / "Titanic.shp2";
+
+    {
+        auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+
+        auto previewData = MakePreviewData(shipFilePath, "R.M.S. Titanic", "Gabriele", "1912");
+        previewData.Metadata.ArtCredits = "Somebody";
+        previewData.Metadata.Description = "Unsinkable";
+        previewData.Metadata.Scale = ShipSpaceToWorldSpaceCoordsRatio(2.0f, 3.0f);
+        previewData.Metadata.DoHideHDInPreview = true;
+        previewData.Metadata.Password = 0x1234567890abcdefULL;
+
+        index.Update(shipFilePath, MakeLastModified(10), previewData);
+        index.Commit(true);
+    }
+
+    ASSERT_TRUE(testFileSystem->Exists(ShipMetadataIndex::GetIndexFilePath(TestRootDirectory)));
+
+    auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+
+    ASSERT_EQ(1u, index.GetEntries().size());
+
+    auto const previewData = index.TryGetPreviewData(shipFilePath, MakeLastModified(10));
+    ASSERT_TRUE(previewData.has_value());
+
+    EXPECT_EQ(shipFilePath, previewData->PreviewFilePath);
+    EXPECT_EQ(ShipSpaceSize(120, 40), previewData->ShipSize);
+    EXPECT_EQ("R.M.S. Titanic", previewData->Metadata.ShipName);
+    EXPECT_EQ(std::optional<std::string>("Gabriele"), previewData->Metadata.Author);
+    EXPECT_EQ(std::optional<std::string>("Somebody"), previewData->Metadata.ArtCredits);
+    EXPECT_EQ(std::optional<std::string>("1912"), previewData->Metadata.YearBuilt);
+    EXPECT_EQ(std::optional<std::string>("Unsinkable"), previewData->Metadata.Description);
+    EXPECT_EQ(2.0f, previewData->Metadata.Scale.inputUnits);
+    EXPECT_EQ(3.0f, previewData->Metadata.Scale.outputUnits);
+    EXPECT_FALSE(previewData->Metadata.DoHideElectricalsInPreview);
+    EXPECT_TRUE(previewData->Metadata.DoHideHDInPreview);
+    EXPECT_EQ(std::optional<PasswordHash>(0x1234567890abcdefULL), previewData->Metadata.Password);
+    EXPECT_TRUE(previewData->IsHD);
+    EXPECT_FALSE(previewData->HasElectricals);
+    EXPECT_EQ(42u, previewData->LastWriteTime.Value());
+}
+
+TEST(ShipMetadataIndexTests, TryGetPreviewData_ModifiedShipFile)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    auto const shipFilePath = TestRootDirectory / "Titanic.shp2";
+
+    PopulateIndex(TestRootDirectory, { { "Titanic.shp2", "Titanic" } }, testFileSystem);
+
+    auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+
+    EXPECT_FALSE(index.TryGetPreviewData(shipFilePath, MakeLastModified(11)).has_value());
+}
+
+TEST(ShipMetadataIndexTests, TryGetPreviewData_PreviewFromOtherFile)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    auto const shipFilePath = TestRootDirectory / "Titanic.shp";
+
+    // Legacy ship, with preview image being a different file
+    {
+        auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+        index.Update(shipFilePath, MakeLastModified(10), MakePreviewData(TestRootDirectory / "Titanic.png", "Titanic"));
+        index.Commit(true);
+    }
+
+    auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+
+    ASSERT_EQ(1u, index.GetEntries().size());
+    EXPECT_FALSE(index.TryGetPreviewData(shipFilePath, MakeLastModified(10)).has_value());
+}
+
+TEST(ShipMetadataIndexTests, Commit_CompleteVisit_RemovesUnvisited)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    PopulateIndex(
+        TestRootDirectory,
+        {
+            { "Ship1.shp2", "Ship1" },
+            { "Ship2.shp2", "Ship2" }
+        },
+        testFileSystem);
+
+    {
+        auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+        ASSERT_EQ(2u, index.GetEntries().size());
+        EXPECT_TRUE(index.TryGetPreviewData(TestRootDirectory / "Ship2.shp2", MakeLastModified(10)).has_value());
+        index.Commit(true);
+    }
+
+    auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+    ASSERT_EQ(1u, index.GetEntries().size());
+    EXPECT_EQ(std::filesystem::path("Ship2.shp2"), index.GetEntries().begin()->first);
+}
+
+TEST(ShipMetadataIndexTests, Commit_IncompleteVisit_KeepsUnvisited)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    PopulateIndex(
+        TestRootDirectory,
+        {
+            { "Ship1.shp2", "Ship1" },
+            { "Ship2.shp2", "Ship2" }
+        },
+        testFileSystem);
+
+    {
+        auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+        index.Update(TestRootDirectory / "Ship2.shp2", MakeLastModified(20), MakePreviewData(TestRootDirectory / "Ship2.shp2", "Ship2"));
+        index.Commit(false);
+    }
+
+    auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+    ASSERT_EQ(2u, index.GetEntries().size());
+    EXPECT_TRUE(index.TryGetPreviewData(TestRootDirectory / "Ship2.shp2", MakeLastModified(20)).has_value());
+}
+
+TEST(ShipMetadataIndexTests, Commit_CompleteVisit_NoShips_DeletesFile)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    PopulateIndex(TestRootDirectory, { { "Ship1.shp2", "Ship1" } }, testFileSystem);
+    ASSERT_TRUE(testFileSystem->Exists(ShipMetadataIndex::GetIndexFilePath(TestRootDirectory)));
+
+    auto index = ShipMetadataIndex::Load(TestRootDirectory, testFileSystem);
+    index.Commit(true);
+
+    EXPECT_FALSE(testFileSystem->Exists(ShipMetadataIndex::GetIndexFilePath(TestRootDirectory)));
+}
+
+class ShipLibraryIndexTests : public testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        mTestFileSystem = std::make_shared<TestFileSystem>();
+
+        PopulateIndex(
+            TestRootDirectory,
+            {
+                { "Titanic.shp2", "R.M.S. Titanic", "Gabriele", "1912" },
+                { "Lusitania.shp2", "Lusitania", "Pac0master", "1906" }
+            },
+            mTestFileSystem);
+
+        PopulateIndex(
+            TestRootDirectory / "Subs",
+            {
+                { "U-Boat.png", "U-Boot Type VII", "Gabriele" }
+            },
+            mTestFileSystem);
+    }
+
+    std::shared_ptr<TestFileSystem> mTestFileSystem;
+};
+
+TEST_F(ShipLibraryIndexTests, Load_VisitsSubDirectories)
+{
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory, mTestFileSystem);
+
+    EXPECT_EQ(3u, libraryIndex.GetShipCount());
+}
+
+TEST_F(ShipLibraryIndexTests, Search_Short)
+{
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory, mTestFileSystem);
+
+    auto const results = libraryIndex.Search("Z");
+    EXPECT_TRUE(results.empty());
+
+    auto const results2 = libraryIndex.Search("U-");
+    ASSERT_EQ(1u, results2.size());
+    EXPECT_EQ(TestRootDirectory / "Subs" / "U-Boat.png", results2[0]);
+}
+
+TEST_F(ShipLibraryIndexTests, Search_CaseInsensitive_MultipleFields)
+{
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory, mTestFileSystem);
+
+    auto const results = libraryIndex.Search("gABRIELE");
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(TestRootDirectory / "Titanic.shp2", results[0]);
+    EXPECT_EQ(TestRootDirectory / "Subs" / "U-Boat.png", results[1]);
+
+    auto const results2 = libraryIndex.Search("1906");
+    ASSERT_EQ(1u, results2.size());
+    EXPECT_EQ(TestRootDirectory / "Lusitania.shp2", results2[0]);
+}
+
+TEST_F(ShipLibraryIndexTests, Search_NoMatch)
+{
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory, mTestFileSystem);
+
+    EXPECT_TRUE(libraryIndex.Search("titanicx").empty());
+}
+
+TEST_F(ShipLibraryIndexTests, Update_ReplacesDirectoryShips)
+{
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory, mTestFileSystem);
+
+    // Replace root directory's ships
+    auto directoryIndex = ShipMetadataIndex::Load(TestRootDirectory, mTestFileSystem);
+    directoryIndex.Update(
+        TestRootDirectory / "Britannic.shp2",
+        MakeLastModified(10),
+        MakePreviewData(TestRootDirectory / "Britannic.shp2", "H.M.H.S. Britannic", "Gabriele", "1914"));
+    directoryIndex.Commit(true);
+
+    libraryIndex.Update(directoryIndex);
+
+    EXPECT_EQ(2u, libraryIndex.GetShipCount());
+
+    EXPECT_TRUE(libraryIndex.Search("titanic").empty());
+
+    // New ships come after the ones already indexed
+    auto const results = libraryIndex.Search("gabriele");
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(TestRootDirectory / "Subs" / "U-Boat.png", results[0]);
+    EXPECT_EQ(TestRootDirectory / "Britannic.shp2", results[1]);
+}
+
+TEST_F(ShipLibraryIndexTests, Update_ReindexesChangedShipsOnly)
+{
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory, mTestFileSystem);
+
+    // Change Lusitania's author, leave Titanic as-is
+    auto directoryIndex = ShipMetadataIndex::Load(TestRootDirectory, mTestFileSystem);
+    directoryIndex.Update(
+        TestRootDirectory / "Lusitania.shp2",
+        MakeLastModified(20),
+        MakePreviewData(TestRootDirectory / "Lusitania.shp2", "Lusitania", "Gabriele", "1906"));
+    directoryIndex.Update(
+        TestRootDirectory / "Titanic.shp2",
+        MakeLastModified(10),
+        MakePreviewData(TestRootDirectory / "Titanic.shp2", "R.M.S. Titanic", "Gabriele", "1912"));
+    directoryIndex.Commit(true);
+
+    libraryIndex.Update(directoryIndex);
+
+    EXPECT_EQ(3u, libraryIndex.GetShipCount());
+
+    EXPECT_TRUE(libraryIndex.Search("pac0master").empty());
+
+    // Titanic stays in its place, Lusitania moves to the end
+    auto const results = libraryIndex.Search("gabriele");
+    ASSERT_EQ(3u, results.size());
+    EXPECT_EQ(TestRootDirectory / "Titanic.shp2", results[0]);
+    EXPECT_EQ(TestRootDirectory / "Subs" / "U-Boat.png", results[1]);
+    EXPECT_EQ(TestRootDirectory / "Lusitania.shp2", results[2]);
+}
+
+TEST_F(ShipLibraryIndexTests, Update_RepeatedChanges)
+{
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory, mTestFileSystem);
+
+    // Churn through enough removals to compact the index a few times
+    for (int i = 0; i < 10; ++i)
+    {
+        auto directoryIndex = ShipMetadataIndex::Load(TestRootDirectory, mTestFileSystem);
+        directoryIndex.Update(
+            TestRootDirectory / "Lusitania.shp2",
+            MakeLastModified(20 + i),
+            MakePreviewData(TestRootDirectory / "Lusitania.shp2", "Lusitania", "Author" + std::to_string(i), "1906"));
+        directoryIndex.Commit(false);
+
+        libraryIndex.Update(directoryIndex);
+
+        EXPECT_EQ(3u, libraryIndex.GetShipCount());
+
+        auto const results = libraryIndex.Search("author" + std::to_string(i));
+        ASSERT_EQ(1u, results.size());
+        EXPECT_EQ(TestRootDirectory / "Lusitania.shp2", results[0]);
+
+        if (i > 0)
+        {
+            EXPECT_TRUE(libraryIndex.Search("author" + std::to_string(i - 1)).empty());
+        }
+    }
+
+    auto const results = libraryIndex.Search("gabriele");
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(TestRootDirectory / "Titanic.shp2", results[0]);
+    EXPECT_EQ(TestRootDirectory / "Subs" / "U-Boat.png", results[1]);
+}
+
+TEST_F(ShipLibraryIndexTests, Update_NewDirectory)
+{
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory / "Subs", mTestFileSystem);
+
+    EXPECT_EQ(1u, libraryIndex.GetShipCount());
+
+    libraryIndex.Update(ShipMetadataIndex::Load(TestRootDirectory, mTestFileSystem));
+
+    EXPECT_EQ(3u, libraryIndex.GetShipCount());
+    EXPECT_EQ(1u, libraryIndex.Search("titanic").size());
+}
+
+TEST_F(ShipLibraryIndexTests, Load_MultipleRoots)
+{
+    PopulateIndex(
+        "UserShips",
+        {
+            { "Carpathia.shp2", "R.M.S. Carpathia", "Gabriele", "1902" }
+        },
+        mTestFileSystem);
+
+    // Nested roots are visited once
+    auto libraryIndex = ShipLibraryIndex::Load(
+        { TestRootDirectory, TestRootDirectory / "Subs", "UserShips" },
+        mTestFileSystem);
+
+    EXPECT_EQ(4u, libraryIndex.GetShipCount());
+
+    auto const results = libraryIndex.Search("gabriele");
+    ASSERT_EQ(3u, results.size());
+    EXPECT_EQ(TestRootDirectory / "Titanic.shp2", results[0]);
+    EXPECT_EQ(TestRootDirectory / "Subs" / "U-Boat.png", results[1]);
+    EXPECT_EQ(std::filesystem::path("UserShips") / "Carpathia.shp2", results[2]);
+}
+
+TEST(ShipLibraryIndexSearchTests, Search_AllTrigramsPresent_NoMatch)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    PopulateIndex(TestRootDirectory, { { "Ship.shp2", "abcd bcde" } }, testFileSystem);
+
+    auto libraryIndex = ShipLibraryIndex::Load(TestRootDirectory, testFileSystem);
+
+    // All of "abc", "bcd", and "cde" are there, but not "abcde"
+    EXPECT_TRUE(libraryIndex.Search("abcde").empty());
+    EXPECT_EQ(1u, libraryIndex.Search("abcd").size());
+}
@@ -0,0 +1,100 @@
+#include <Game/ShipStrengthRandomizer.h>
+
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST(ShipStrengthRandomizerTests, UpdateBatikDistances_MatchesFullSweep)
+{
+    using BatikDistanceMatrix = ShipStrengthRandomizer::BatikDistanceMatrix;
+    using BatikColumnSpan = ShipStrengthRandomizer::BatikColumnSpan;
+
+    ShipStrengthRandomizer randomizer;
+
+    for (vec2i const size : { vec2i(1, 1), vec2i(7, 3), vec2i(16, 16), vec2i(41, 23), vec2i(19, 64) })
+    {
+        for (unsigned int seed = 1; seed <= 4; ++seed)
+        {
+            //
+            // Make a random ship: a blob of viable cells, with holes at distance zero
+            // (i.e. frontiers); the same ship goes into both matrices
+            //
+
+            BatikDistanceMatrix incrementalMatrix(size.x, size.y, 0.0f);
+            BatikDistanceMatrix fullSweepMatrix(size.x, size.y, 0.0f);
+
+            std::mt19937 shipRandomEngine(seed);
+            std::uniform_int_distribution<int> holeDistribution(0, 9);
+
+            std::vector<vec2i> viableCoords;
+            for (int x = 0; x < size.x; ++x)
+            {
+                for (int y = 0; y < size.y; ++y)
+                {
+                    vec2i const coords(x, y);
+                    if (holeDistribution(shipRandomEngine) != 0)
+                    {
+                        incrementalMatrix.SetDistance(coords, std::numeric_limits<float>::max());
+                        fullSweepMatrix.SetDistance(coords, std::numeric_limits<float>::max());
+                        viableCoords.push_back(coords);
+                    }
+                }
+            }
+
+            if (viableCoords.empty())
+            {
+                continue;
+            }
+
+            //
+            // Generate cracks, updating one matrix incrementally and the other one with full sweeps
+            //
+
+            std::ranlux48_base incrementalRandomEngine(seed);
+            std::ranlux48_base fullSweepRandomEngine(seed);
+
+            std::vector<BatikColumnSpan> const fullSpans(size.x, BatikColumnSpan(0, size.y));
+
+            std::uniform_int_distribution<size_t> startingPointDistribution(0, viableCoords.size() - 1);
+
+            int const numberOfCracks = std::max(size.x, size.y);
+            for (int iCrack = 0; iCrack <= numberOfCracks; ++iCrack)
+            {
+                randomizer.UpdateBatikDistances(incrementalMatrix);
+                ShipStrengthRandomizer::RunBatikDistanceTransform(fullSweepMatrix, fullSpans);
+
+                for (int x = 0; x < size.x; ++x)
+                {
+                    for (int y = 0; y < size.y; ++y)
+                    {
+                        vec2i const coords(x, y);
+                        ASSERT_EQ(fullSweepMatrix.GetDistance(coords), incrementalMatrix.GetDistance(coords))
+                            << "size=" << size.toString() << " seed=" << seed << " crack=" << iCrack << " coords=" << coords.toString();
+                    }
+                }
+
+                if (iCrack == numberOfCracks)
+                {
+                    break;
+                }
+
+                vec2i const startingPointCoords = viableCoords[startingPointDistribution(shipRandomEngine)];
+
+                randomizer.GenerateBatikCrack(startingPointCoords, incrementalMatrix, incrementalRandomEngine);
+                randomizer.GenerateBatikCrack(startingPointCoords, fullSweepMatrix, fullSweepRandomEngine);
+
+                for (int x = 0; x < size.x; ++x)
+                {
+                    for (int y = 0; y < size.y; ++y)
+                    {
+                        vec2i const coords(x, y);
+                        ASSERT_EQ(fullSweepMatrix.IsCrack(coords), incrementalMatrix.IsCrack(coords))
+                            << "size=" << size.toString() << " seed=" << seed << " crack=" << iCrack << " coords=" << coords.toString();
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#include <Game/SpringRelaxationBlockSchedule.h>
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    struct TestEndpoints
+    {
+        ElementIndex PointAIndex;
+        ElementIndex PointBIndex;
+    };
+
+    // Verifies that each point is integrated exactly once, and not before its last spring
+    void VerifySchedule(
+        SpringRelaxationBlockSchedule const & schedule,
+        std::vector<TestEndpoints> const & springs,
+        ElementCount pointCount)
+    {
+        std::vector<int> pointIntegrationCounts(pointCount, 0);
+
+        ElementIndex expectedStartSpringIndex = 0;
+        for (auto const & block : schedule.GetBlocks())
+        {
+            ASSERT_EQ(expectedStartSpringIndex, block.StartSpringIndex);
+            expectedStartSpringIndex = block.EndSpringIndex;
+
+            for (size_t r = block.StartPointRunIndex; r < block.EndPointRunIndex; ++r)
+            {
+                auto const & run = schedule.GetPointRuns()[r];
+                ASSERT_LT(run.StartPointIndex, run.EndPointIndex);
+
+                for (ElementIndex p = run.StartPointIndex; p < run.EndPointIndex; ++p)
+                {
+                    ++pointIntegrationCounts[p];
+
+                    // No later spring touches this point
+                    for (ElementIndex s = block.EndSpringIndex; s < springs.size(); ++s)
+                    {
+                        ASSERT_NE(p, springs[s].PointAIndex) << "s=" << s;
+                        ASSERT_NE(p, springs[s].PointBIndex) << "s=" << s;
+                    }
+                }
+            }
+        }
+
+        EXPECT_EQ(static_cast<ElementIndex>(springs.size()), expectedStartSpringIndex);
+
+        for (ElementIndex p = 0; p < pointCount; ++p)
+        {
+            EXPECT_EQ(1, pointIntegrationCounts[p]) << "p=" << p;
+        }
+    }
+}
+
+TEST(SpringRelaxationBlockScheduleTests, Empty)
+{
+    auto const schedule = SpringRelaxationBlockSchedule::Make<TestEndpoints>(nullptr, 0, 0, 8);
+
+    EXPECT_TRUE(schedule.IsEmpty());
+    EXPECT_TRUE(schedule.GetPointRuns().empty());
+}
+
+TEST(SpringRelaxationBlockScheduleTests, PointsWithoutSprings_GoToFirstBlock)
+{
+    auto const schedule = SpringRelaxationBlockSchedule::Make<TestEndpoints>(nullptr, 0, 10, 8);
+
+    ASSERT_EQ(1u, schedule.GetBlocks().size());
+    EXPECT_EQ(0u, schedule.GetBlocks()[0].StartSpringIndex);
+    EXPECT_EQ(0u, schedule.GetBlocks()[0].EndSpringIndex);
+
+    ASSERT_EQ(1u, schedule.GetPointRuns().size());
+    EXPECT_EQ(0u, schedule.GetPointRuns()[0].StartPointIndex);
+    EXPECT_EQ(10u, schedule.GetPointRuns()[0].EndPointIndex);
+}
+
+TEST(SpringRelaxationBlockScheduleTests, Chain)
+{
+    // 0-1, 1-2, 2-3, ..., 8-9
+    std::vector<TestEndpoints> springs;
+    for (ElementIndex s = 0; s < 9; ++s)
+    {
+        springs.push_back({ s, s + 1 });
+    }
+
+    auto const schedule = SpringRelaxationBlockSchedule::Make(springs.data(), 9, 10, 4);
+
+    ASSERT_EQ(3u, schedule.GetBlocks().size());
+
+    // Springs 0..3: point 4 is also touched by spring 4
+    auto const & block0 = schedule.GetBlocks()[0];
+    EXPECT_EQ(0u, block0.StartSpringIndex);
+    EXPECT_EQ(4u, block0.EndSpringIndex);
+    ASSERT_EQ(1u, block0.EndPointRunIndex - block0.StartPointRunIndex);
+    EXPECT_EQ(0u, schedule.GetPointRuns()[block0.StartPointRunIndex].StartPointIndex);
+    EXPECT_EQ(4u, schedule.GetPointRuns()[block0.StartPointRunIndex].EndPointIndex);
+
+    // Last block: spring 8
+    auto const & block2 = schedule.GetBlocks()[2];
+    EXPECT_EQ(8u, block2.StartSpringIndex);
+    EXPECT_EQ(9u, block2.EndSpringIndex);
+    ASSERT_EQ(1u, block2.EndPointRunIndex - block2.StartPointRunIndex);
+    EXPECT_EQ(8u, schedule.GetPointRuns()[block2.StartPointRunIndex].StartPointIndex);
+    EXPECT_EQ(10u, schedule.GetPointRuns()[block2.StartPointRunIndex].EndPointIndex);
+
+    VerifySchedule(schedule, springs, 10);
+}
+
+TEST(SpringRelaxationBlockScheduleTests, Random)
+{
+    std::mt19937 randomEngine(7);
+
+    ElementCount constexpr PointCount = 300;
+    std::uniform_int_distribution<ElementIndex> pointDistribution(0, PointCount - 1);
+
+    std::vector<TestEndpoints> springs;
+    for (int s = 0; s < 1000; ++s)
+    {
+        springs.push_back({ pointDistribution(randomEngine), pointDistribution(randomEngine) });
+    }
+
+    // Extra points without springs
+    auto const schedule = SpringRelaxationBlockSchedule::Make(springs.data(), static_cast<ElementCount>(springs.size()), PointCount + 12, 64);
+
+    EXPECT_EQ(16u, schedule.GetBlocks().size());
+
+    VerifySchedule(schedule, springs, PointCount + 12);
+}
@@ -0,0 +1,122 @@
+#include <GameCore/SpscRingBuffer.h>
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+TEST(SpscRingBufferTests, PushPop)
+{
+    SpscRingBuffer<int, 4> rb;
+
+    EXPECT_EQ(0u, rb.size());
+
+    int value = 0;
+    EXPECT_FALSE(rb.try_pop(value));
+
+    EXPECT_TRUE(rb.try_push(1));
+    EXPECT_TRUE(rb.try_push(2));
+
+    EXPECT_EQ(2u, rb.size());
+
+    EXPECT_TRUE(rb.try_pop(value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(rb.try_pop(value));
+    EXPECT_EQ(2, value);
+
+    EXPECT_FALSE(rb.try_pop(value));
+    EXPECT_EQ(0u, rb.size());
+}
+
+TEST(SpscRingBufferTests, Push_WhenFull_Drops)
+{
+    SpscRingBuffer<int, 4> rb;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(rb.try_push(i));
+    }
+
+    EXPECT_FALSE(rb.try_push(4));
+    EXPECT_FALSE(rb.try_push(5));
+
+    EXPECT_EQ(4u, rb.size());
+    EXPECT_EQ(2u, rb.dropped_count());
+
+    // Oldest elements are preserved
+    int value = -1;
+    EXPECT_TRUE(rb.try_pop(value));
+    EXPECT_EQ(0, value);
+
+    // There's room again
+    EXPECT_TRUE(rb.try_push(6));
+    EXPECT_EQ(2u, rb.dropped_count());
+}
+
+TEST(SpscRingBufferTests, Drain_WrapsAround)
+{
+    SpscRingBuffer<int, 4> rb;
+
+    std::vector<int> drained;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        rb.try_push(i);
+    }
+
+    EXPECT_EQ(3u, rb.drain([&drained](int v) { drained.push_back(v); }));
+
+    // Now push across the end of the ring
+    for (int i = 3; i < 7; ++i)
+    {
+        EXPECT_TRUE(rb.try_push(i));
+    }
+
+    EXPECT_EQ(4u, rb.drain([&drained](int v) { drained.push_back(v); }));
+
+    EXPECT_EQ(0u, rb.drain([&drained](int v) { drained.push_back(v); }));
+
+    ASSERT_EQ(7u, drained.size());
+    for (int i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ(i, drained[i]);
+    }
+}
+
+TEST(SpscRingBufferTests, ProducerConsumer_PreservesOrder)
+{
+    SpscRingBuffer<size_t, 64> rb;
+
+    size_t constexpr ElementCount = 100000;
+
+    std::thread producer(
+        [&rb]()
+        {
+            for (size_t i = 0; i < ElementCount; )
+            {
+                if (rb.try_push(i))
+                    ++i;
+                else
+                    std::this_thread::yield();
+            }
+        });
+
+    size_t expected = 0;
+    while (expected < ElementCount)
+    {
+        size_t value;
+        if (rb.try_pop(value))
+        {
+            ASSERT_EQ(expected, value);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    EXPECT_EQ(0u, rb.size());
+}
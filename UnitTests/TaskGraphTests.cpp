@@ -0,0 +1,370 @@
+#include <GameCore/TaskGraph.h>
+
+#include <GameCore/EnumFlags.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    struct TestContext
+    {
+        int Value;
+    };
+
+    enum class TestResources : std::uint32_t
+    {
+        None = 0,
+        A = 1,
+        B = 2,
+        C = 4
+    };
+}
+
+template <> struct is_flag<TestResources> : std::true_type {};
+
+class TaskGraphTests : public testing::Test
+{
+protected:
+
+    ThreadManager mThreadManager{ false, 16 };
+};
+
+TEST_F(TaskGraphTests, Empty)
+{
+    ThreadPool threadPool(4, mThreadManager);
+
+    TaskGraph<TestContext, TestResources> graph;
+
+    EXPECT_EQ(0u, graph.GetTaskCount());
+    EXPECT_EQ(0u, graph.GetLevelCount());
+
+    graph.Run(threadPool, TestContext{ 1 });
+}
+
+TEST_F(TaskGraphTests, IndependentTasks_RunInOneLevel)
+{
+    ThreadPool threadPool(4, mThreadManager);
+
+    std::vector<int> results(10, 0);
+
+    TaskGraph<TestContext, TestResources> graph;
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        graph.AddTask(
+            [&results, t](TestContext const & context)
+            {
+                results[t] = context.Value;
+            });
+    }
+
+    EXPECT_EQ(10u, graph.GetTaskCount());
+    EXPECT_EQ(1u, graph.GetLevelCount());
+
+    graph.Run(threadPool, TestContext{ 7 });
+
+    for (int r : results)
+    {
+        EXPECT_EQ(7, r);
+    }
+
+    // Re-run, with a different context
+    graph.Run(threadPool, TestContext{ 8 });
+
+    for (int r : results)
+    {
+        EXPECT_EQ(8, r);
+    }
+}
+
+TEST_F(TaskGraphTests, Dependencies_AreHonored)
+{
+    ThreadPool threadPool(4, mThreadManager);
+
+    //
+    // a   b
+    // | \ |
+    // c   d
+    //  \ /
+    //   e
+    //
+
+    std::atomic<int> counter = 0;
+    std::vector<int> completionOrder(5, -1);
+
+    auto const makeTask = [&counter, &completionOrder](size_t idx)
+    {
+        return [&counter, &completionOrder, idx](TestContext const &)
+        {
+            // Give the others a chance to run too early
+            std::this_thread::yield();
+
+            completionOrder[idx] = counter++;
+        };
+    };
+
+    TaskGraph<TestContext, TestResources> graph;
+
+    auto const a = graph.AddTask(makeTask(0));
+    auto const b = graph.AddTask(makeTask(1));
+    auto const c = graph.AddTask(makeTask(2), { a });
+    auto const d = graph.AddTask(makeTask(3), { a, b });
+    graph.AddTask(makeTask(4), { c, d });
+
+    EXPECT_EQ(3u, graph.GetLevelCount());
+
+    for (int run = 0; run < 20; ++run)
+    {
+        counter = 0;
+
+        graph.Run(threadPool, TestContext{ run });
+
+        EXPECT_LT(completionOrder[0], completionOrder[2]);
+        EXPECT_LT(completionOrder[0], completionOrder[3]);
+        EXPECT_LT(completionOrder[1], completionOrder[3]);
+        EXPECT_LT(completionOrder[2], completionOrder[4]);
+        EXPECT_LT(completionOrder[3], completionOrder[4]);
+        EXPECT_EQ(4, completionOrder[4]);
+    }
+}
+
+TEST_F(TaskGraphTests, Clear)
+{
+    ThreadPool threadPool(2, mThreadManager);
+
+    int result = 0;
+
+    TaskGraph<TestContext, TestResources> graph;
+    auto const a = graph.AddTask([&result](TestContext const &) { result += 1; });
+    graph.AddTask([&result](TestContext const &) { result += 10; }, { a });
+
+    graph.Clear();
+
+    EXPECT_EQ(0u, graph.GetTaskCount());
+    EXPECT_EQ(0u, graph.GetLevelCount());
+
+    graph.AddTask([&result](TestContext const & context) { result += context.Value; });
+
+    graph.Run(threadPool, TestContext{ 100 });
+
+    EXPECT_EQ(100, result);
+}
+
+TEST_F(TaskGraphTests, Resources_DeriveDependencies)
+{
+    TaskGraph<TestContext, TestResources> graph;
+
+    auto const noop = [](TestContext const &) {};
+
+    auto const w_a = graph.AddTask("W(A)", TestResources::None, TestResources::A, noop);
+    auto const w_b = graph.AddTask("W(B)", TestResources::None, TestResources::B, noop);
+    auto const r_a = graph.AddTask("R(A)", TestResources::A, TestResources::None, noop);
+    auto const r_a_2 = graph.AddTask("R(A)", TestResources::A, TestResources::None, noop);
+    auto const r_ab_w_c = graph.AddTask("R(A,B) W(C)", TestResources::A | TestResources::B, TestResources::C, noop);
+    auto const w_a_2 = graph.AddTask("W(A)", TestResources::None, TestResources::A, noop);
+    auto const w_c = graph.AddTask("W(C)", TestResources::None, TestResources::C, noop);
+
+    EXPECT_EQ(0u, graph.GetTaskLevel(w_a));
+    EXPECT_EQ(0u, graph.GetTaskLevel(w_b)); // Independent
+    EXPECT_EQ(1u, graph.GetTaskLevel(r_a)); // Read after write
+    EXPECT_EQ(1u, graph.GetTaskLevel(r_a_2)); // Reads don't depend on each other
+    EXPECT_EQ(1u, graph.GetTaskLevel(r_ab_w_c));
+    EXPECT_EQ(2u, graph.GetTaskLevel(w_a_2)); // Write after read
+    EXPECT_EQ(2u, graph.GetTaskLevel(w_c)); // Write after write
+
+    EXPECT_EQ(3u, graph.GetLevelCount());
+}
+
+TEST_F(TaskGraphTests, Resources_Partition)
+{
+    ThreadPool threadPool(4, mThreadManager);
+
+    std::vector<int> buffer(8, 0);
+    int sum = 0;
+
+    TaskGraph<TestContext, TestResources> graph;
+
+    graph.BeginPartition();
+
+    for (size_t p = 0; p < 4; ++p)
+    {
+        graph.AddTask(
+            "Fill",
+            TestResources::None,
+            TestResources::A,
+            [&buffer, p](TestContext const & context)
+            {
+                buffer[p * 2] = context.Value;
+                buffer[p * 2 + 1] = context.Value;
+            });
+    }
+
+    graph.EndPartition();
+
+    auto const sumTaskId = graph.AddTask(
+        "Sum",
+        TestResources::A,
+        TestResources::B,
+        [&buffer, &sum](TestContext const &)
+        {
+            for (int v : buffer)
+            {
+                sum += v;
+            }
+        });
+
+    EXPECT_EQ(2u, graph.GetLevelCount());
+    EXPECT_EQ(1u, graph.GetTaskLevel(sumTaskId));
+
+    graph.Run(threadPool, TestContext{ 3 });
+
+    EXPECT_EQ(24, sum);
+}
+
+TEST_F(TaskGraphTests, CostliestTaskRunsOnCallingThread)
+{
+    ThreadPool threadPool(4, mThreadManager);
+
+    std::thread::id cheapTaskThreadId;
+    std::thread::id costlyTaskThreadId;
+
+    TaskGraph<TestContext, TestResources> graph;
+
+    graph.AddTask(
+        "Cheap",
+        TestResources::None,
+        TestResources::A,
+        [&cheapTaskThreadId](TestContext const &)
+        {
+            cheapTaskThreadId = std::this_thread::get_id();
+        });
+
+    graph.AddTask(
+        "Costly",
+        TestResources::None,
+        TestResources::B,
+        [&costlyTaskThreadId](TestContext const &)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            costlyTaskThreadId = std::this_thread::get_id();
+        });
+
+    EXPECT_EQ(1u, graph.GetLevelCount());
+
+    // Let it measure
+    graph.Run(threadPool, TestContext{ 0 });
+
+    for (int run = 0; run < 5; ++run)
+    {
+        graph.Run(threadPool, TestContext{ run });
+
+        EXPECT_EQ(std::this_thread::get_id(), costlyTaskThreadId);
+    }
+}
+
+TEST_F(TaskGraphTests, CallingThreadTasks_RunOnCallingThread_InOrder)
+{
+    ThreadPool threadPool(4, mThreadManager);
+
+    using TaskAffinity = TaskGraph<TestContext, TestResources>::TaskAffinity;
+
+    std::vector<std::thread::id> pinnedTaskThreadIds(2);
+    std::vector<int> pinnedTaskOrder;
+    std::vector<int> freeTaskResults(3, 0);
+
+    TaskGraph<TestContext, TestResources> graph;
+
+    // Costly tasks free to run anywhere, interleaved with calling-thread-only ones
+    for (size_t t = 0; t < freeTaskResults.size(); ++t)
+    {
+        graph.AddTask(
+            "Free",
+            TestResources::None,
+            TestResources::None,
+            [&freeTaskResults, t](TestContext const & context)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                freeTaskResults[t] = context.Value;
+            });
+
+        if (t < pinnedTaskThreadIds.size())
+        {
+            graph.AddTask(
+                "Pinned",
+                TestResources::None,
+                TestResources::None,
+                TaskAffinity::CallingThread,
+                [&pinnedTaskThreadIds, &pinnedTaskOrder, t](TestContext const &)
+                {
+                    pinnedTaskThreadIds[t] = std::this_thread::get_id();
+                    pinnedTaskOrder.push_back(static_cast<int>(t));
+                });
+        }
+    }
+
+    EXPECT_EQ(5u, graph.GetTaskCount());
+    EXPECT_EQ(1u, graph.GetLevelCount());
+
+    for (int run = 0; run < 10; ++run)
+    {
+        pinnedTaskOrder.clear();
+
+        graph.Run(threadPool, TestContext{ run });
+
+        ASSERT_EQ(2u, pinnedTaskOrder.size());
+        EXPECT_EQ(0, pinnedTaskOrder[0]);
+        EXPECT_EQ(1, pinnedTaskOrder[1]);
+
+        EXPECT_EQ(std::this_thread::get_id(), pinnedTaskThreadIds[0]);
+        EXPECT_EQ(std::this_thread::get_id(), pinnedTaskThreadIds[1]);
+
+        for (int r : freeTaskResults)
+        {
+            EXPECT_EQ(run, r);
+        }
+    }
+}
+
+#ifdef _DEBUG
+
+TEST_F(TaskGraphTests, UndeclaredWrite_Throws)
+{
+    ThreadPool threadPool(2, mThreadManager);
+
+    std::vector<int> bufferA(4, 0);
+    std::vector<int> bufferB(4, 0);
+
+    TaskGraph<TestContext, TestResources> graph;
+
+    graph.RegisterResourceBuffer(TestResources::A, bufferA.data(), bufferA.size() * sizeof(int));
+    graph.RegisterResourceBuffer(TestResources::B, bufferB.data(), bufferB.size() * sizeof(int));
+
+    graph.AddTask(
+        "Honest",
+        TestResources::B,
+        TestResources::A,
+        [&bufferA, &bufferB](TestContext const & context)
+        {
+            bufferA[0] = bufferB[0] + context.Value;
+        });
+
+    EXPECT_NO_THROW(graph.Run(threadPool, TestContext{ 1 }));
+
+    graph.AddTask(
+        "Dishonest",
+        TestResources::A,
+        TestResources::None,
+        [&bufferB](TestContext const & context)
+        {
+            bufferB[1] = context.Value;
+        });
+
+    EXPECT_THROW(graph.Run(threadPool, TestContext{ 2 }), GameException);
+}
+
+#endif
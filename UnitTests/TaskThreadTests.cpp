@@ -1,6 +1,11 @@
 #include <GameCore/TaskThread.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -68,4 +73,200 @@ TEST(TaskThreadTests, QueueSynchronizationPoint)
     tc->Wait();
 
     EXPECT_TRUE(isDone);
-}
\ No newline at end of file
+}
+
+TEST(TaskThreadTests, Exception)
+{
+    TaskThread t;
+
+    auto tc = t.QueueTask(
+        []()
+        {
+            throw std::runtime_error("Test exception");
+        });
+
+    EXPECT_THROW(tc->Wait(), std::runtime_error);
+}
+
+TEST(TaskThreadTests, Multithreaded_RunSynchronously)
+{
+    TaskThread t(true);
+
+    // Larger than a task may store inline
+    std::array<int, 100> values{};
+    t.RunSynchronously(
+        [&values, localValues = values]() mutable
+        {
+            localValues[99] = 42;
+            values = localValues;
+        });
+
+    EXPECT_EQ(42, values[99]);
+}
+
+TEST(TaskThreadTests, Multithreaded_QueueTask_RunsInOrder)
+{
+    TaskThread t(true);
+
+    // More than the queue may hold at any time
+    std::vector<int> values;
+    for (int i = 0; i < 10000; ++i)
+    {
+        t.QueueTask(
+            [&values, i]()
+            {
+                values.push_back(i);
+            });
+    }
+
+    auto tc = t.QueueSynchronizationPoint();
+    tc->Wait();
+
+    ASSERT_EQ(10000u, values.size());
+    for (int i = 0; i < 10000; ++i)
+    {
+        EXPECT_EQ(i, values[i]);
+    }
+}
+
+TEST(TaskThreadTests, Multithreaded_Wait_EarlierTask)
+{
+    TaskThread t(true);
+
+    std::atomic<int> counter = 0;
+
+    auto tc1 = t.QueueTask(
+        [&counter]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            ++counter;
+        });
+
+    auto tc2 = t.QueueTask(
+        [&counter]()
+        {
+            ++counter;
+        });
+
+    tc1->Wait();
+    EXPECT_GE(counter.load(), 1);
+
+    tc2->Wait();
+    EXPECT_EQ(2, counter.load());
+}
+
+TEST(TaskThreadTests, Multithreaded_Exception)
+{
+    TaskThread t(true);
+
+    auto tc1 = t.QueueTask(
+        []()
+        {
+            throw std::runtime_error("Test exception");
+        });
+
+    auto tc2 = t.QueueSynchronizationPoint();
+
+    EXPECT_NO_THROW(tc2->Wait());
+    EXPECT_THROW(tc1->Wait(), std::runtime_error);
+
+    // Still alive
+    bool isDone = false;
+    t.RunSynchronously(
+        [&isDone]()
+        {
+            isDone = true;
+        });
+
+    EXPECT_TRUE(isDone);
+}
+
+TEST(TaskThreadTests, Multithreaded_Exception_NotThrownByLaterTasksWhenQueueIsFull)
+{
+    TaskThread t(true);
+
+    // Fire-and-forget, and slow enough for the queue to fill up behind it
+    t.QueueTask(
+        []()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            throw std::runtime_error("Test exception");
+        });
+
+    std::atomic<int> counter = 0;
+    TaskThread::TaskCompletionIndicator tc;
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_NO_THROW(
+            tc = t.QueueTask(
+                [&counter]()
+                {
+                    ++counter;
+                }));
+    }
+
+    EXPECT_NO_THROW(tc->Wait());
+    EXPECT_EQ(1000, counter.load());
+}
+
+TEST(TaskThreadTests, BatchedTasks)
+{
+    TaskThread t;
+
+    std::vector<int> values;
+    for (int i = 0; i < 10; ++i)
+    {
+        t.QueueBatchedTask(
+            [&values, i]()
+            {
+                values.push_back(i);
+            });
+    }
+
+    auto tc = t.QueueSynchronizationPoint();
+    tc->Wait();
+
+    ASSERT_EQ(10u, values.size());
+    EXPECT_EQ(9, values[9]);
+}
+
+TEST(TaskThreadTests, Multithreaded_BatchedTasks_RunInOrderWithOtherTasks)
+{
+    TaskThread t(true);
+
+    std::vector<int> values;
+    for (int frame = 0; frame < 500; ++frame)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            t.QueueBatchedTask(
+                [&values]()
+                {
+                    values.push_back(static_cast<int>(values.size()));
+                });
+        }
+
+        if ((frame % 3) == 0)
+        {
+            // Goes after the batch
+            t.QueueTask(
+                [&values]()
+                {
+                    values.push_back(static_cast<int>(values.size()));
+                });
+        }
+        else if ((frame % 3) == 1)
+        {
+            t.FlushBatchedTasks();
+        }
+    }
+
+    auto tc = t.QueueSynchronizationPoint();
+    tc->Wait();
+
+    ASSERT_EQ(500u * 10u + 167u, values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(static_cast<int>(i), values[i]);
+    }
+}
@@ -0,0 +1,96 @@
+#include <Game/TelemetrySink.h>
+
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    TelemetryFrame MakeFrame(std::uint64_t stepIndex)
+    {
+        TelemetryFrame frame{};
+        frame.StepIndex = stepIndex;
+        frame.Timestamp = stepIndex * 16000;
+        frame.SimulationTime = 0.5f;
+        frame.StepDuration = 1000.0f;
+        frame.PointCount = 100;
+        frame.BrokenSpringCount = 3;
+        frame.HeapBufferByteCount = 123456789012ull;
+        return frame;
+    }
+}
+
+TEST(TelemetrySinkTests, Csv)
+{
+    auto const filePath = std::filesystem::temp_directory_path() / "TelemetrySinkTests_Csv.csv";
+
+    {
+        TelemetrySink sink(filePath, TelemetrySink::FormatType::Csv);
+
+        sink.Push(MakeFrame(0));
+        sink.Push(MakeFrame(1));
+
+        // Destruction writes the frames pushed so far
+    }
+
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(filePath);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            lines.push_back(line);
+        }
+    }
+
+    std::filesystem::remove(filePath);
+
+    ASSERT_EQ(3u, lines.size());
+    EXPECT_EQ(0u, lines[0].find("StepIndex,Timestamp,SimulationTime,"));
+    EXPECT_EQ("0,0,0.5000,1000.0,0.0,0.0,0.0,0.0,0.0,0,100,0,3,0,0,0,123456789012,0", lines[1]);
+    EXPECT_EQ("1,16000,0.5000,1000.0,0.0,0.0,0.0,0.0,0.0,0,100,0,3,0,0,0,123456789012,0", lines[2]);
+}
+
+TEST(TelemetrySinkTests, Binary)
+{
+    auto const filePath = std::filesystem::temp_directory_path() / "TelemetrySinkTests_Binary.bin";
+
+    {
+        TelemetrySink sink(filePath, TelemetrySink::FormatType::Binary);
+
+        for (std::uint64_t s = 0; s < 5; ++s)
+        {
+            sink.Push(MakeFrame(s));
+        }
+    }
+
+    auto const fileSize = std::filesystem::file_size(filePath);
+
+    unsigned char header[12];
+    {
+        std::ifstream file(filePath, std::ios_base::in | std::ios_base::binary);
+        file.read(reinterpret_cast<char *>(header), sizeof(header));
+    }
+
+    std::filesystem::remove(filePath);
+
+    EXPECT_EQ('F', header[0]);
+    EXPECT_EQ('S', header[1]);
+    EXPECT_EQ('T', header[2]);
+    EXPECT_EQ('M', header[3]);
+
+    // Version, little-endian
+    EXPECT_EQ(2, header[4]);
+    EXPECT_EQ(0, header[5]);
+
+    std::uint32_t const frameByteSize =
+        static_cast<std::uint32_t>(header[8])
+        | (static_cast<std::uint32_t>(header[9]) << 8)
+        | (static_cast<std::uint32_t>(header[10]) << 16)
+        | (static_cast<std::uint32_t>(header[11]) << 24);
+
+    EXPECT_EQ(sizeof(header) + 5 * frameByteSize, fileSize);
+}
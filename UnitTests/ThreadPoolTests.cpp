@@ -1,7 +1,9 @@
 #include <GameCore/ThreadPool.h>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -98,4 +100,31 @@ TEST_P(ThreadPoolTests_FourRuns, Four_Runs)
     t.Run(tasks);
 
     ASSERT_TRUE(std::all_of(results.cbegin(), results.cend(), [](bool b) { return b; }));
-}
\ No newline at end of file
+}
+
+TEST(ThreadPoolTests, TotalIdleDuration)
+{
+    ThreadManager threadManager{ false, 16 };
+    ThreadPool t(4, threadManager);
+
+    // One long task: the other three threads idle throughout
+    GameChronometer::duration longTaskDuration;
+    std::vector<ThreadPool::Task> tasks;
+    tasks.emplace_back(
+        [&longTaskDuration]()
+        {
+            auto const startTime = GameChronometer::now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            longTaskDuration = GameChronometer::now() - startTime;
+        });
+    tasks.emplace_back([]() {});
+
+    // Not tracked by default
+    t.Run(tasks);
+    EXPECT_EQ(GameChronometer::duration::zero(), t.GetTotalIdleDuration());
+
+    t.SetDoTrackIdleDuration(true);
+    t.Run(tasks);
+
+    EXPECT_GE(t.GetTotalIdleDuration(), longTaskDuration * static_cast<GameChronometer::duration::rep>(t.GetParallelism() - 1));
+}
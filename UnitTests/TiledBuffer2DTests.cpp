@@ -0,0 +1,186 @@
+#include <GameCore/TiledBuffer2D.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    using TestBuffer = Buffer2D<int, struct IntegralTag>;
+    using TestTiledBuffer = TiledBuffer2D<int, struct IntegralTag, 4>;
+    using TestDirtyTileMap = DirtyTileMap<struct IntegralTag, 4>;
+
+    TestBuffer MakeTestBuffer(int width, int height, int startValue)
+    {
+        TestBuffer buffer(width, height);
+
+        int iVal = startValue;
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                buffer[{x, y}] = iVal++;
+            }
+        }
+
+        return buffer;
+    }
+}
+
+TEST(TiledBuffer2DTests, Construction_Fill)
+{
+    TestTiledBuffer buffer(IntegralRectSize(9, 5), 242);
+
+    EXPECT_EQ(IntegralRectSize(9, 5), buffer.GetSize());
+
+    for (int y = 0; y < 5; ++y)
+    {
+        for (int x = 0; x < 9; ++x)
+        {
+            EXPECT_EQ(242, buffer[IntegralCoordinates(x, y)]);
+        }
+    }
+}
+
+TEST(TiledBuffer2DTests, Construction_FromBuffer2D_Roundtrip)
+{
+    auto const source = MakeTestBuffer(9, 6, 100);
+
+    TestTiledBuffer buffer(source);
+
+    for (int y = 0; y < 6; ++y)
+    {
+        for (int x = 0; x < 9; ++x)
+        {
+            EXPECT_EQ(source[IntegralCoordinates(x, y)], buffer[IntegralCoordinates(x, y)]);
+        }
+    }
+
+    auto const target = buffer.ToBuffer2D();
+
+    ASSERT_EQ(source.Size, target.Size);
+    for (int y = 0; y < 6; ++y)
+    {
+        for (int x = 0; x < 9; ++x)
+        {
+            EXPECT_EQ(source[IntegralCoordinates(x, y)], target[IntegralCoordinates(x, y)]);
+        }
+    }
+}
+
+TEST(TiledBuffer2DTests, CloneRegion_AcrossTiles)
+{
+    auto const source = MakeTestBuffer(11, 10, 0);
+
+    TestTiledBuffer buffer(source);
+
+    IntegralRect const region(IntegralCoordinates(3, 2), IntegralRectSize(7, 6));
+
+    auto const target = buffer.CloneRegion(region);
+
+    ASSERT_EQ(region.size, target.Size);
+    for (int y = 0; y < region.size.height; ++y)
+    {
+        for (int x = 0; x < region.size.width; ++x)
+        {
+            EXPECT_EQ(source[IntegralCoordinates(region.origin.x + x, region.origin.y + y)], target[IntegralCoordinates(x, y)]);
+        }
+    }
+}
+
+TEST(TiledBuffer2DTests, Clone_SharesTiles_CopiesOnWrite)
+{
+    auto const source = MakeTestBuffer(8, 8, 0);
+
+    TestTiledBuffer buffer(source);
+    auto clone = buffer.Clone();
+
+    // Shared
+    EXPECT_EQ(&buffer[IntegralCoordinates(1, 1)], &clone[IntegralCoordinates(1, 1)]);
+    EXPECT_EQ(&buffer[IntegralCoordinates(5, 5)], &clone[IntegralCoordinates(5, 5)]);
+
+    clone.SetElement(IntegralCoordinates(5, 6), 1000);
+
+    // Only the written tile is not shared anymore
+    EXPECT_EQ(&buffer[IntegralCoordinates(1, 1)], &clone[IntegralCoordinates(1, 1)]);
+    EXPECT_NE(&buffer[IntegralCoordinates(5, 5)], &clone[IntegralCoordinates(5, 5)]);
+
+    EXPECT_EQ(1000, clone[IntegralCoordinates(5, 6)]);
+    EXPECT_EQ(source[IntegralCoordinates(5, 6)], buffer[IntegralCoordinates(5, 6)]);
+    EXPECT_EQ(source[IntegralCoordinates(5, 5)], clone[IntegralCoordinates(5, 5)]);
+}
+
+TEST(TiledBuffer2DTests, UpdateFrom_OnlyTouchesOverlappingTiles)
+{
+    auto source = MakeTestBuffer(10, 9, 0);
+
+    TestTiledBuffer buffer(source);
+    auto const clone = buffer.Clone();
+
+    // Change source
+    for (int y = 0; y < 9; ++y)
+    {
+        for (int x = 0; x < 10; ++x)
+        {
+            source[{x, y}] += 1000;
+        }
+    }
+
+    // Sync region within tiles (0,1) and (1,1)
+    buffer.UpdateFrom(source, IntegralRect(IntegralCoordinates(3, 5), IntegralRectSize(2, 1)));
+
+    for (int y = 0; y < 9; ++y)
+    {
+        for (int x = 0; x < 10; ++x)
+        {
+            bool const isInUpdatedTile = (y >= 4 && y < 8 && x < 8);
+
+            EXPECT_EQ(isInUpdatedTile ? source[IntegralCoordinates(x, y)] : source[IntegralCoordinates(x, y)] - 1000, buffer[IntegralCoordinates(x, y)]);
+
+            // Clone is unaffected
+            EXPECT_EQ(source[IntegralCoordinates(x, y)] - 1000, clone[IntegralCoordinates(x, y)]);
+        }
+    }
+}
+
+TEST(DirtyTileMapTests, MarkDirty_VisitDirtyRuns)
+{
+    TestDirtyTileMap dirtyTileMap;
+
+    EXPECT_TRUE(dirtyTileMap.IsEmpty());
+
+    IntegralRectSize const bufferSize(14, 10);
+
+    dirtyTileMap.MarkDirty(IntegralRect(IntegralCoordinates(1, 1), IntegralRectSize(1, 1)), bufferSize);
+    dirtyTileMap.MarkDirty(IntegralRect(IntegralCoordinates(6, 2), IntegralRectSize(7, 1)), bufferSize);
+    dirtyTileMap.MarkDirty(IntegralRect(IntegralCoordinates(13, 9), IntegralRectSize(5, 5)), bufferSize); // Partially outside
+
+    EXPECT_FALSE(dirtyTileMap.IsEmpty());
+    EXPECT_EQ(5u, dirtyTileMap.GetDirtyTileCount());
+
+    std::vector<IntegralRect> runs;
+    dirtyTileMap.VisitDirtyRuns(
+        [&](IntegralRect const & rect)
+        {
+            runs.push_back(rect);
+        });
+
+    ASSERT_EQ(2u, runs.size());
+    EXPECT_EQ(IntegralRect(IntegralCoordinates(0, 0), IntegralRectSize(14, 4)), runs[0]);
+    EXPECT_EQ(IntegralRect(IntegralCoordinates(12, 8), IntegralRectSize(2, 2)), runs[1]);
+
+    dirtyTileMap.Clear();
+
+    EXPECT_TRUE(dirtyTileMap.IsEmpty());
+}
+
+TEST(DirtyTileMapTests, MarkDirty_SizeChange_Resets)
+{
+    TestDirtyTileMap dirtyTileMap;
+
+    dirtyTileMap.MarkDirty(IntegralRect(IntegralCoordinates(0, 0), IntegralRectSize(8, 8)), IntegralRectSize(8, 8));
+    EXPECT_EQ(4u, dirtyTileMap.GetDirtyTileCount());
+
+    dirtyTileMap.MarkDirty(IntegralRect(IntegralCoordinates(0, 0), IntegralRectSize(1, 1)), IntegralRectSize(16, 16));
+    EXPECT_EQ(1u, dirtyTileMap.GetDirtyTileCount());
+}
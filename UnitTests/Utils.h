@@ -3,7 +3,9 @@
 #include <GameCore/FileSystem.h>
 #include <GameCore/MemoryStreams.h>
 
+#include <iterator>
 #include <map>
+#include <set>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -122,6 +124,25 @@ public:
         return filePaths;
     }
 
+    std::vector<std::filesystem::path> ListDirectories(std::filesystem::path const & directoryPath) override
+    {
+        // Directories are implied by the paths of the files in them
+        std::set<std::filesystem::path> directoryPaths;
+
+        size_t const directoryDepth = std::distance(directoryPath.begin(), directoryPath.end());
+
+        for (auto const & kv : mFileMap)
+        {
+            if (IsParentOf(directoryPath, kv.first)
+                && static_cast<size_t>(std::distance(kv.first.begin(), kv.first.end())) > directoryDepth + 1)
+            {
+                directoryPaths.insert(directoryPath / *std::next(kv.first.begin(), directoryDepth));
+            }
+        }
+
+        return std::vector<std::filesystem::path>(directoryPaths.begin(), directoryPaths.end());
+    }
+
     void DeleteFile(std::filesystem::path const & filePath) override
     {
         auto it = mFileMap.find(filePath);
@@ -178,6 +199,7 @@ public:
     MOCK_METHOD1(OpenOutputStream, std::shared_ptr<std::ostream>(std::filesystem::path const & filePath));
     MOCK_METHOD1(OpenInputStream, std::shared_ptr<std::istream>(std::filesystem::path const & filePath));
     MOCK_METHOD1(ListFiles, std::vector<std::filesystem::path>(std::filesystem::path const & directoryPath));
+    MOCK_METHOD1(ListDirectories, std::vector<std::filesystem::path>(std::filesystem::path const & directoryPath));
     MOCK_METHOD1(DeleteFile, void(std::filesystem::path const & filePath));
     MOCK_METHOD2(RenameFile, void(std::filesystem::path const & oldFilePath, std::filesystem::path const & newFilePath));
 };